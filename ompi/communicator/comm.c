@@ -46,6 +46,7 @@
 #include "opal/util/output.h"
 #include "ompi/mca/topo/topo.h"
 #include "ompi/mca/topo/base/base.h"
+#include "ompi/mca/coll/base/coll_tags.h"
 #include "ompi/dpm/dpm.h"
 
 #include "ompi/attribute/attribute.h"
@@ -1245,6 +1246,139 @@ int ompi_comm_create_group (ompi_communicator_t *comm, ompi_group_t *group, int
     return MPI_SUCCESS;
 }
 
+/**********************************************************************/
+/**********************************************************************/
+/**********************************************************************/
+
+/* calls of ompi_comm_create_from_group in progress in this process */
+struct ompi_comm_from_group_call_t {
+    struct ompi_comm_from_group_call_t *next;
+    const char *tag;
+    int pml_tag;
+};
+typedef struct ompi_comm_from_group_call_t ompi_comm_from_group_call_t;
+
+static ompi_comm_from_group_call_t *ompi_comm_from_group_calls = NULL;
+static opal_mutex_t ompi_comm_from_group_lock = OPAL_MUTEX_STATIC_INIT;
+
+/* register a call using pml_tag. fails if another call of this process
+ * uses the same tag, as the messages of the two calls could match each
+ * other. */
+static int ompi_comm_from_group_enter (ompi_comm_from_group_call_t *call)
+{
+    int rc = OMPI_SUCCESS;
+
+    OPAL_THREAD_LOCK(&ompi_comm_from_group_lock);
+    for (ompi_comm_from_group_call_t *other = ompi_comm_from_group_calls ; NULL != other ;
+         other = other->next) {
+        if (other->pml_tag == call->pml_tag) {
+            opal_output(0, "MPI_Comm_create_from_group: string tag \"%s\" %s \"%s\" which is "
+                        "in use by a concurrent call", call->tag,
+                        strcmp(call->tag, other->tag) ? "collides with" : "is the same as",
+                        other->tag);
+            rc = OMPI_ERR_BAD_PARAM;
+            break;
+        }
+    }
+    if (OMPI_SUCCESS == rc) {
+        call->next = ompi_comm_from_group_calls;
+        ompi_comm_from_group_calls = call;
+    }
+    OPAL_THREAD_UNLOCK(&ompi_comm_from_group_lock);
+
+    return rc;
+}
+
+static void ompi_comm_from_group_leave (ompi_comm_from_group_call_t *call)
+{
+    OPAL_THREAD_LOCK(&ompi_comm_from_group_lock);
+    for (ompi_comm_from_group_call_t **prev = &ompi_comm_from_group_calls ; NULL != *prev ;
+         prev = &(*prev)->next) {
+        if (*prev == call) {
+            *prev = call->next;
+            break;
+        }
+    }
+    OPAL_THREAD_UNLOCK(&ompi_comm_from_group_lock);
+}
+
+int ompi_comm_create_from_group (ompi_group_t *group, const char *tag, opal_info_t *info,
+                                 ompi_errhandler_t *errhandler, ompi_communicator_t **newcomm)
+{
+    ompi_communicator_t *newcomp = NULL, *bridge = &ompi_mpi_comm_world.comm;
+    int mode = OMPI_COMM_CID_GROUP, rc = OMPI_SUCCESS;
+    ompi_comm_from_group_call_t call;
+    uint32_t hash = 5381;
+    int pml_tag;
+
+    *newcomm = MPI_COMM_NULL;
+
+    /* There is no parent communicator: the processes of the group agree
+     * on the context id with point-to-point messages over MPI_COMM_WORLD,
+     * which every process of the job is a member of. The string tag is
+     * hashed into a reserved range so that concurrent creations with
+     * different tags do not match each other. The messages of a call are
+     * matched by source, so two calls can only mix up their messages if
+     * they run concurrently in the same process. Such calls with tags
+     * hashing to the same value are refused rather than risking a wrong
+     * context id. */
+    for (const char *c = tag ; '\0' != *c ; ++c) {
+        hash = hash * 33 + (unsigned char) *c;
+    }
+    pml_tag = MCA_COLL_BASE_TAG_FROM_GROUP_BASE -
+        (int) (hash % (MCA_COLL_BASE_TAG_FROM_GROUP_BASE - MCA_COLL_BASE_TAG_FROM_GROUP_END + 1));
+
+    call.tag = tag;
+    call.pml_tag = pml_tag;
+    rc = ompi_comm_from_group_enter (&call);
+    if (OMPI_SUCCESS != rc) {
+        return rc;
+    }
+
+    rc =  ompi_comm_set ( &newcomp,                               /* new comm */
+                          bridge,                                 /* old comm */
+                          group->grp_proc_count,                  /* local_size */
+                          NULL,                                   /* local_procs*/
+                          0,                                      /* remote_size */
+                          NULL,                                   /* remote_procs */
+                          NULL,                                   /* attrs */
+                          errhandler,                             /* error handler */
+                          false,                                  /* copy the topo */
+                          group,                                  /* local group */
+                          NULL);                                  /* remote group */
+    if ( OMPI_SUCCESS != rc) {
+        goto exit;
+    }
+
+    /* Determine context id. It is identical to f_2_c_handle */
+    rc = ompi_comm_nextcid (newcomp, bridge, NULL, &pml_tag, NULL, false, mode);
+    if ( OMPI_SUCCESS != rc ) {
+        OBJ_RELEASE(newcomp);
+        goto exit;
+    }
+
+    /* Set name for debugging purposes */
+    snprintf(newcomp->c_name, MPI_MAX_OBJECT_NAME, "MPI COMMUNICATOR %d FROM GROUP",
+             newcomp->c_contextid);
+
+    if (NULL != info) {
+        opal_infosubscribe_change_info(&newcomp->super, info);
+    }
+
+    /* activate communicator and init coll-module */
+    rc = ompi_comm_activate (&newcomp, bridge, NULL, &pml_tag, NULL, false, mode);
+    if ( OMPI_SUCCESS != rc ) {
+        OBJ_RELEASE(newcomp);
+        goto exit;
+    }
+
+    *newcomm = newcomp;
+
+ exit:
+    ompi_comm_from_group_leave (&call);
+    return rc;
+}
+
 /**********************************************************************/
 /**********************************************************************/
 /**********************************************************************/
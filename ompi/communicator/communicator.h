@@ -648,6 +648,14 @@ int ompi_comm_create (ompi_communicator_t* comm, ompi_group_t *group,
 int ompi_comm_create_group (ompi_communicator_t *comm, ompi_group_t *group, int tag,
                             ompi_communicator_t **newcomm);
 
+/**
+ * Create a communicator from a group without a parent communicator
+ * (MPI_Comm_create_from_group). The context id is agreed upon by the
+ * processes of the group, matching each other with the string tag.
+ */
+int ompi_comm_create_from_group (ompi_group_t *group, const char *tag, opal_info_t *info,
+                                 ompi_errhandler_t *errhandler, ompi_communicator_t **newcomm);
+
 /**
  * Take an almost complete communicator and reserve the CID as well
  * as activate it (initialize the collective and the topologies).
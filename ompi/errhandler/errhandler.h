@@ -83,7 +83,8 @@ enum ompi_errhandler_type_t {
     OMPI_ERRHANDLER_TYPE_PREDEFINED,
     OMPI_ERRHANDLER_TYPE_COMM,
     OMPI_ERRHANDLER_TYPE_WIN,
-    OMPI_ERRHANDLER_TYPE_FILE
+    OMPI_ERRHANDLER_TYPE_FILE,
+    OMPI_ERRHANDLER_TYPE_INSTANCE
 };
 typedef enum ompi_errhandler_type_t ompi_errhandler_type_t;
 
@@ -194,7 +195,8 @@ struct ompi_request_t;
  *
  * This macro directly invokes the ompi_mpi_errors_are_fatal_handler()
  * when an error occurs because MPI_COMM_WORLD does not exist (because
- * we're before MPI_Init() or after MPI_Finalize()).
+ * we're before MPI_Init() or after MPI_Finalize()) and no session is
+ * alive.
  *
  * NOTE: The ompi_mpi_state variable is a volatile that is set
  * atomically in ompi_mpi_init() and ompi_mpi_finalize().  The
@@ -206,8 +208,9 @@ struct ompi_request_t;
 #define OMPI_ERR_INIT_FINALIZE(name)                                    \
     {                                                                   \
         int32_t state = ompi_mpi_state;                                 \
-        if (OPAL_UNLIKELY(state < OMPI_MPI_STATE_INIT_COMPLETED ||      \
-                          state > OMPI_MPI_STATE_FINALIZE_PAST_COMM_SELF_DESTRUCT)) { \
+        if (OPAL_UNLIKELY((state < OMPI_MPI_STATE_INIT_COMPLETED ||     \
+                           state > OMPI_MPI_STATE_FINALIZE_PAST_COMM_SELF_DESTRUCT) && \
+                          0 == ompi_instance_count)) {                  \
             ompi_errhandler_invoke(NULL, NULL, -1,                       \
                                    ompi_errcode_get_mpi_code(MPI_ERR_ARG), \
                                    name);                               \
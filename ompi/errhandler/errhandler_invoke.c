@@ -28,6 +28,7 @@
 #include "ompi/communicator/communicator.h"
 #include "ompi/win/win.h"
 #include "ompi/file/file.h"
+#include "ompi/instance/instance.h"
 #include "ompi/request/request.h"
 #include "ompi/errhandler/errhandler.h"
 #include "ompi/mpi/fortran/base/fint_2_int.h"
@@ -40,6 +41,7 @@ int ompi_errhandler_invoke(ompi_errhandler_t *errhandler, void *mpi_object,
     ompi_communicator_t *comm;
     ompi_win_t *win;
     ompi_file_t *file;
+    ompi_instance_t *instance;
 
     /* If we got no errorhandler, then route the error to the appropriate
      * predefined error handler */
@@ -121,6 +123,23 @@ int ompi_errhandler_invoke(ompi_errhandler_t *errhandler, void *mpi_object,
             break;
         }
         break;
+
+    case OMPI_ERRHANDLER_TYPE_INSTANCE:
+        /* only predefined error handlers can be attached to a session,
+           they are invoked with no communicator */
+        instance = (ompi_instance_t *) mpi_object;
+        switch (errhandler->eh_lang) {
+        case OMPI_ERRHANDLER_LANG_C:
+            errhandler->eh_comm_fn(NULL, &err_code, message, NULL);
+            break;
+
+        case OMPI_ERRHANDLER_LANG_FORTRAN:
+            fortran_handle = OMPI_INT_2_FINT(instance->i_f_to_c_index);
+            errhandler->eh_fort_fn(&fortran_handle, &fortran_err_code);
+            err_code = OMPI_FINT_2_INT(fortran_err_code);
+            break;
+        }
+        break;
     }
 
     /* All done */
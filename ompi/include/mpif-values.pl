@@ -333,6 +333,7 @@ $constants->{MPI_ERR_WIN} = 53;
 $constants->{MPI_ERR_PROC_FAILED} = 75;
 $constants->{MPI_ERR_PROC_FAILED_PENDING} = 76;
 $constants->{MPI_ERR_REVOKED} = 77;
+$constants->{MPI_ERR_SESSION} = 78;
 # these error codes will never be returned by a fortran function
 # since there are no fortran bindings for MPI_T
 $constants->{MPI_T_ERR_MEMORY} = 54;
@@ -0,0 +1,239 @@
+/* -*- Mode: C; c-basic-offset:4 ; indent-tabs-mode:nil -*- */
+/*
+ * $COPYRIGHT$
+ *
+ * Additional copyrights may follow
+ *
+ * $HEADER$
+ */
+
+#include "ompi_config.h"
+
+#include <string.h>
+
+#include "opal/sys/atomic.h"
+#include "opal/mca/threads/mutex.h"
+#include "opal/util/info.h"
+#include "opal/util/show_help.h"
+#include "opal/util/string_copy.h"
+
+#include "ompi/constants.h"
+#include "ompi/instance/instance.h"
+#include "ompi/communicator/communicator.h"
+#include "ompi/group/group.h"
+#include "ompi/runtime/mpiruntime.h"
+#include "ompi/runtime/ompi_rte.h"
+
+static void ompi_instance_construct(ompi_instance_t *instance);
+static void ompi_instance_destruct(ompi_instance_t *instance);
+
+OBJ_CLASS_INSTANCE(ompi_instance_t, opal_infosubscriber_t,
+                   ompi_instance_construct, ompi_instance_destruct);
+
+ompi_predefined_instance_t ompi_mpi_instance_null = {{{{0}}}};
+opal_pointer_array_t ompi_instance_f_to_c_table = {{0}};
+
+opal_atomic_int32_t ompi_instance_count = 0;
+
+/* Serializes MPI_Init, MPI_Finalize and the session calls that bring
+   the runtime up or down */
+static opal_mutex_t instance_lock = OPAL_MUTEX_STATIC_INIT;
+/* The runtime has been torn down and cannot be brought up again */
+static bool instance_runtime_finalized = false;
+
+static const char *instance_thread_level_names[] = {
+    [MPI_THREAD_SINGLE] = "MPI_THREAD_SINGLE",
+    [MPI_THREAD_FUNNELED] = "MPI_THREAD_FUNNELED",
+    [MPI_THREAD_SERIALIZED] = "MPI_THREAD_SERIALIZED",
+    [MPI_THREAD_MULTIPLE] = "MPI_THREAD_MULTIPLE",
+};
+
+static void ompi_instance_construct(ompi_instance_t *instance)
+{
+    instance->super.s_info = NULL;
+    instance->i_thread_level = MPI_THREAD_SINGLE;
+    instance->i_f_to_c_index = opal_pointer_array_add(&ompi_instance_f_to_c_table, instance);
+    instance->error_handler = NULL;
+    instance->errhandler_type = OMPI_ERRHANDLER_TYPE_INSTANCE;
+}
+
+static void ompi_instance_destruct(ompi_instance_t *instance)
+{
+    if (MPI_UNDEFINED != instance->i_f_to_c_index &&
+        NULL != opal_pointer_array_get_item(&ompi_instance_f_to_c_table,
+                                            instance->i_f_to_c_index)) {
+        opal_pointer_array_set_item(&ompi_instance_f_to_c_table,
+                                    instance->i_f_to_c_index, NULL);
+    }
+
+    if (NULL != instance->error_handler) {
+        OBJ_RELEASE(instance->error_handler);
+        instance->error_handler = NULL;
+    }
+}
+
+int ompi_mpi_instance_retain(int *argc, char ***argv, int requested, int *provided,
+                             bool world)
+{
+    int ret = OMPI_SUCCESS;
+
+    opal_mutex_lock(&instance_lock);
+
+    if (instance_runtime_finalized) {
+        opal_mutex_unlock(&instance_lock);
+        opal_show_help("help-mpi-runtime.txt", "mpi_instance:runtime finalized", true,
+                       world ? "MPI_INIT" : "MPI_SESSION_INIT");
+        return MPI_ERR_OTHER;
+    }
+
+    if (0 == ompi_instance_count) {
+        OBJ_CONSTRUCT(&ompi_instance_f_to_c_table, opal_pointer_array_t);
+        opal_pointer_array_init(&ompi_instance_f_to_c_table, 8, OMPI_FORTRAN_HANDLE_MAX, 8);
+
+        /* MPI_SESSION_NULL is index 0 of the Fortran table */
+        OBJ_CONSTRUCT(&ompi_mpi_instance_null.instance, ompi_instance_t);
+
+        ret = ompi_mpi_init_runtime(argc, argv, requested, provided, world);
+        if (OMPI_SUCCESS != ret) {
+            OBJ_DESTRUCT(&ompi_mpi_instance_null.instance);
+            OBJ_DESTRUCT(&ompi_instance_f_to_c_table);
+            instance_runtime_finalized = true;
+        }
+    } else {
+        /* the runtime is already up with its thread level */
+        *provided = ompi_mpi_thread_provided;
+        if (world) {
+            ret = ompi_mpi_init_world_procs();
+        }
+    }
+
+    if (OMPI_SUCCESS == ret) {
+        opal_atomic_add_fetch_32(&ompi_instance_count, 1);
+    }
+
+    opal_mutex_unlock(&instance_lock);
+
+    return ret;
+}
+
+int ompi_mpi_instance_release(void)
+{
+    int ret = OMPI_SUCCESS;
+
+    opal_mutex_lock(&instance_lock);
+
+    if (0 == opal_atomic_sub_fetch_32(&ompi_instance_count, 1)) {
+        ret = ompi_mpi_finalize_runtime();
+        OBJ_DESTRUCT(&ompi_mpi_instance_null.instance);
+        OBJ_DESTRUCT(&ompi_instance_f_to_c_table);
+        instance_runtime_finalized = true;
+    }
+
+    opal_mutex_unlock(&instance_lock);
+
+    return ret;
+}
+
+int ompi_instance_init(int ts_level, opal_info_t *info, ompi_errhandler_t *errhandler,
+                       ompi_instance_t **instance)
+{
+    ompi_instance_t *new_instance;
+    int provided, ret;
+    /* a session has no command line, like MPI_Init(NULL, NULL) */
+    int argc = 0;
+    char **argv = NULL;
+
+    ret = ompi_mpi_instance_retain(&argc, &argv, ts_level, &provided, false);
+    if (OMPI_SUCCESS != ret) {
+        return ret;
+    }
+
+    new_instance = OBJ_NEW(ompi_instance_t);
+    if (OPAL_UNLIKELY(NULL == new_instance)) {
+        ompi_mpi_instance_release();
+        return OMPI_ERR_OUT_OF_RESOURCE;
+    }
+
+    /* a session never gets more than what it asked for */
+    new_instance->i_thread_level = (provided < ts_level) ? provided : ts_level;
+
+    OBJ_RETAIN(errhandler);
+    new_instance->error_handler = errhandler;
+
+    opal_infosubscribe_change_info(&new_instance->super, info);
+    opal_info_set(new_instance->super.s_info, "thread_level",
+                  instance_thread_level_names[new_instance->i_thread_level]);
+
+    *instance = new_instance;
+
+    return OMPI_SUCCESS;
+}
+
+int ompi_instance_finalize(ompi_instance_t **instance)
+{
+    OBJ_RELEASE(*instance);
+    *instance = &ompi_mpi_instance_null.instance;
+
+    return ompi_mpi_instance_release();
+}
+
+int ompi_instance_get_num_psets(ompi_instance_t *instance, int *npset_names)
+{
+    *npset_names = 2;
+    return OMPI_SUCCESS;
+}
+
+int ompi_instance_get_nth_pset(ompi_instance_t *instance, int n, int *len, char *pset_name)
+{
+    const char *name;
+
+    switch (n) {
+    case 0:
+        name = OMPI_INSTANCE_PSET_WORLD;
+        break;
+    case 1:
+        name = OMPI_INSTANCE_PSET_SELF;
+        break;
+    default:
+        return OMPI_ERR_BAD_PARAM;
+    }
+
+    /* *len == 0 only queries the length of the name */
+    if (0 != *len) {
+        opal_string_copy(pset_name, name, *len);
+    }
+    *len = (int) strlen(name) + 1;
+
+    return OMPI_SUCCESS;
+}
+
+int ompi_instance_get_pset_info(ompi_instance_t *instance, const char *pset_name,
+                                opal_info_t *info)
+{
+    char size[16];
+    int nprocs;
+
+    if (0 == strcmp(pset_name, OMPI_INSTANCE_PSET_WORLD)) {
+        nprocs = (int) ompi_process_info.num_procs;
+    } else if (0 == strcmp(pset_name, OMPI_INSTANCE_PSET_SELF)) {
+        nprocs = 1;
+    } else {
+        return OMPI_ERR_NOT_FOUND;
+    }
+
+    snprintf(size, sizeof(size), "%d", nprocs);
+    return opal_info_set(info, "mpi_size", size);
+}
+
+int ompi_group_from_pset(ompi_instance_t *instance, const char *pset_name,
+                         ompi_group_t **group)
+{
+    if (0 == strcmp(pset_name, OMPI_INSTANCE_PSET_WORLD)) {
+        return ompi_comm_group(&ompi_mpi_comm_world.comm, group);
+    }
+    if (0 == strcmp(pset_name, OMPI_INSTANCE_PSET_SELF)) {
+        return ompi_comm_group(&ompi_mpi_comm_self.comm, group);
+    }
+
+    return OMPI_ERR_NOT_FOUND;
+}
@@ -0,0 +1,134 @@
+/* -*- Mode: C; c-basic-offset:4 ; indent-tabs-mode:nil -*- */
+/*
+ * $COPYRIGHT$
+ *
+ * Additional copyrights may follow
+ *
+ * $HEADER$
+ */
+/**
+ * @file
+ *
+ * MPI sessions.
+ *
+ * The MPI runtime (RTE, frameworks, PML, handle subsystems) is shared
+ * by the world model (MPI_Init/MPI_Finalize) and by every session, and
+ * is reference counted: it is brought up by the first of them and torn
+ * down when the last one goes away.
+ *
+ * A session only pays for what it uses. Bringing up the runtime for a
+ * session does not run the modex fence, does not add the peers to the
+ * PML (endpoints are created on the first message to a peer) and does
+ * not select collective components; those are selected on the first
+ * collective call on each communicator.
+ */
+
+#ifndef OMPI_INSTANCE_H
+#define OMPI_INSTANCE_H
+
+#include "ompi_config.h"
+#include "mpi.h"
+
+#include "opal/class/opal_object.h"
+#include "opal/class/opal_pointer_array.h"
+#include "opal/util/info_subscriber.h"
+
+#include "ompi/errhandler/errhandler.h"
+
+BEGIN_C_DECLS
+
+struct ompi_group_t;
+
+/** Predefined process set names */
+#define OMPI_INSTANCE_PSET_WORLD "mpi://WORLD"
+#define OMPI_INSTANCE_PSET_SELF  "mpi://SELF"
+
+struct ompi_instance_t {
+    opal_infosubscriber_t super;
+    /** thread level provided to this session */
+    int i_thread_level;
+    /** index in Fortran <-> C translation array */
+    int i_f_to_c_index;
+    /** error handler of the session */
+    ompi_errhandler_t *error_handler;
+    /** type of the error handler */
+    ompi_errhandler_type_t errhandler_type;
+};
+typedef struct ompi_instance_t ompi_instance_t;
+OMPI_DECLSPEC OBJ_CLASS_DECLARATION(ompi_instance_t);
+
+/**
+ * Padded struct to maintain back compatibiltiy.
+ * See ompi/communicator/communicator.h comments with struct ompi_communicator_t
+ * for full explanation why we chose the following padding construct for predefines.
+ */
+#define PREDEFINED_INSTANCE_PAD 512
+
+struct ompi_predefined_instance_t {
+    struct ompi_instance_t instance;
+    char padding[PREDEFINED_INSTANCE_PAD - sizeof(ompi_instance_t)];
+};
+typedef struct ompi_predefined_instance_t ompi_predefined_instance_t;
+
+/** MPI_SESSION_NULL */
+OMPI_DECLSPEC extern ompi_predefined_instance_t ompi_mpi_instance_null;
+
+/** Table for Fortran <-> C session handle conversion */
+OMPI_DECLSPEC extern opal_pointer_array_t ompi_instance_f_to_c_table;
+
+/**
+ * Take a reference on the MPI runtime, bringing it up if needed.
+ *
+ * @param[in] argc, argv   command line (may be NULL)
+ * @param[in] requested    requested thread level
+ * @param[out] provided    thread level of the runtime
+ * @param[in] world        the reference is taken by MPI_Init
+ *
+ * The thread level is decided by the caller that brings the runtime
+ * up. Once the runtime has been torn down it cannot be brought up
+ * again.
+ */
+OMPI_DECLSPEC int ompi_mpi_instance_retain(int *argc, char ***argv, int requested,
+                                           int *provided, bool world);
+
+/**
+ * Release a reference on the MPI runtime, tearing it down when this
+ * was the last one.
+ */
+OMPI_DECLSPEC int ompi_mpi_instance_release(void);
+
+/**
+ * Create a new session (back end of MPI_Session_init).
+ */
+OMPI_DECLSPEC int ompi_instance_init(int ts_level, opal_info_t *info,
+                                     ompi_errhandler_t *errhandler,
+                                     ompi_instance_t **instance);
+
+/**
+ * Free a session (back end of MPI_Session_finalize).
+ */
+OMPI_DECLSPEC int ompi_instance_finalize(ompi_instance_t **instance);
+
+/**
+ * Process sets known to a session.
+ */
+OMPI_DECLSPEC int ompi_instance_get_num_psets(ompi_instance_t *instance, int *npset_names);
+OMPI_DECLSPEC int ompi_instance_get_nth_pset(ompi_instance_t *instance, int n, int *len,
+                                             char *pset_name);
+OMPI_DECLSPEC int ompi_instance_get_pset_info(ompi_instance_t *instance, const char *pset_name,
+                                              opal_info_t *info);
+
+/**
+ * Build the group of the processes of a process set.
+ */
+OMPI_DECLSPEC int ompi_group_from_pset(ompi_instance_t *instance, const char *pset_name,
+                                       struct ompi_group_t **group);
+
+static inline bool ompi_instance_invalid(const ompi_instance_t *instance)
+{
+    return (NULL == instance) || (&ompi_mpi_instance_null.instance == instance);
+}
+
+END_C_DECLS
+
+#endif /* OMPI_INSTANCE_H */
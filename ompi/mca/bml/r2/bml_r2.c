@@ -145,6 +145,12 @@ static void mca_bml_r2_calculate_bandwidth_latency (mca_bml_base_btl_array_t *bt
     }
 }
 
+/* footprint of a bml endpoint, including the btl arrays reserved for every btl */
+static inline size_t mca_bml_r2_endpoint_size (void)
+{
+    return sizeof (mca_bml_base_endpoint_t) + 3 * mca_bml_r2.num_btl_modules * sizeof (mca_bml_base_btl_t);
+}
+
 static mca_bml_base_endpoint_t *mca_bml_r2_allocate_endpoint (ompi_proc_t *proc) {
     mca_bml_base_endpoint_t *bml_endpoint;
 
@@ -163,9 +169,21 @@ static mca_bml_base_endpoint_t *mca_bml_r2_allocate_endpoint (ompi_proc_t *proc)
     bml_endpoint->btl_proc = proc;
 
     bml_endpoint->btl_flags_or = 0;
+
+    opal_atomic_add_fetch_size_t (&mca_bml_r2.endpoint_count, 1);
+    opal_atomic_add_fetch_size_t (&mca_bml_r2.endpoint_memory, mca_bml_r2_endpoint_size ());
+
     return bml_endpoint;
 }
 
+static void mca_bml_r2_release_endpoint (mca_bml_base_endpoint_t *bml_endpoint)
+{
+    opal_atomic_sub_fetch_size_t (&mca_bml_r2.endpoint_count, 1);
+    opal_atomic_sub_fetch_size_t (&mca_bml_r2.endpoint_memory, mca_bml_r2_endpoint_size ());
+
+    OBJ_RELEASE(bml_endpoint);
+}
+
 static void mca_bml_r2_register_progress (mca_btl_base_module_t *btl, bool hp)
 {
     if (NULL != btl->btl_component->btl_progress) {
@@ -424,7 +442,7 @@ static int mca_bml_r2_add_proc (struct ompi_proc_t *proc)
 
     if (!btl_in_use) {
         proc->proc_endpoints[OMPI_PROC_ENDPOINT_TAG_BML] = NULL;
-        OBJ_RELEASE(bml_endpoint);
+        mca_bml_r2_release_endpoint (bml_endpoint);
         /* no btl is available for this proc */
         if (mca_bml_r2.show_unreach_errors) {
             char *errhost = opal_get_proc_hostname(&proc->super);
@@ -445,6 +463,10 @@ static int mca_bml_r2_add_proc (struct ompi_proc_t *proc)
     /* compute metrics for registered btls */
     mca_bml_r2_compute_endpoint_metrics (bml_endpoint);
 
+    /* the endpoint holds a reference on the proc, as in add_procs. it is
+     * released by del_procs */
+    OBJ_RETAIN(proc);
+
     /* do it last, for the lazy initialization check in bml_base_get* */
     opal_atomic_wmb();
     proc->proc_endpoints[OMPI_PROC_ENDPOINT_TAG_BML] = bml_endpoint;
@@ -668,7 +690,7 @@ static int mca_bml_r2_del_procs(size_t nprocs,
         OBJ_RELEASE(proc);
 
         /* do any required cleanup */
-        OBJ_RELEASE(bml_endpoint);
+        mca_bml_r2_release_endpoint (bml_endpoint);
     }
 
     return OMPI_SUCCESS;
@@ -45,6 +45,10 @@ struct mca_bml_r2_module_t {
     mca_btl_base_component_progress_fn_t * btl_progress;
     bool btls_added;
     bool show_unreach_errors;
+    /** number of bml endpoints currently allocated */
+    opal_atomic_size_t endpoint_count;
+    /** memory (bytes) used by the allocated bml endpoints */
+    opal_atomic_size_t endpoint_memory;
 };
 
 typedef struct mca_bml_r2_module_t mca_bml_r2_module_t;
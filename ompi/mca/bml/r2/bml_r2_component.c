@@ -24,12 +24,14 @@
 
 #include "ompi_config.h"
 #include "opal/util/event.h"
+#include "opal/mca/base/mca_base_pvar.h"
 #include "opal/mca/btl/base/base.h"
 #include "ompi/mca/bml/bml.h"
 #include "bml_r2.h"
 #include "mpi.h"
 
 static int mca_bml_r2_component_register(void);
+static int mca_bml_r2_pvar_read(const struct mca_base_pvar_t *pvar, void *value, void *obj);
 
 mca_bml_base_component_2_0_0_t mca_bml_r2_component = {
 
@@ -64,6 +66,37 @@ static int mca_bml_r2_component_register(void)
                                            MCA_BASE_VAR_SCOPE_READONLY,
                                            &mca_bml_r2.show_unreach_errors);
 
+    (void) mca_base_component_pvar_register(&mca_bml_r2_component.bml_version,
+                                            "endpoint_count",
+                                            "Number of peers with a bml endpoint. Endpoints are "
+                                            "created on first communication with a peer above "
+                                            "mpi_add_procs_cutoff",
+                                            OPAL_INFO_LVL_4, MCA_BASE_PVAR_CLASS_LEVEL,
+                                            MCA_BASE_VAR_TYPE_UNSIGNED_LONG, NULL,
+                                            MCA_BASE_VAR_BIND_NO_OBJECT,
+                                            MCA_BASE_PVAR_FLAG_READONLY | MCA_BASE_PVAR_FLAG_CONTINUOUS,
+                                            mca_bml_r2_pvar_read, NULL, NULL,
+                                            (void *) &mca_bml_r2.endpoint_count);
+
+    (void) mca_base_component_pvar_register(&mca_bml_r2_component.bml_version,
+                                            "endpoint_memory",
+                                            "Memory (bytes) used by the bml endpoints",
+                                            OPAL_INFO_LVL_4, MCA_BASE_PVAR_CLASS_LEVEL,
+                                            MCA_BASE_VAR_TYPE_UNSIGNED_LONG, NULL,
+                                            MCA_BASE_VAR_BIND_NO_OBJECT,
+                                            MCA_BASE_PVAR_FLAG_READONLY | MCA_BASE_PVAR_FLAG_CONTINUOUS,
+                                            mca_bml_r2_pvar_read, NULL, NULL,
+                                            (void *) &mca_bml_r2.endpoint_memory);
+
+    return OMPI_SUCCESS;
+}
+
+static int mca_bml_r2_pvar_read(const struct mca_base_pvar_t *pvar, void *value, void *obj)
+{
+    (void) obj;
+
+    *(unsigned long *) value = (unsigned long) *(opal_atomic_size_t *) pvar->ctx;
+
     return OMPI_SUCCESS;
 }
 
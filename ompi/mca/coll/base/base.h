@@ -98,6 +98,23 @@ int mca_coll_base_find_available(bool enable_progress_threads,
  */
 int mca_coll_base_comm_select(struct ompi_communicator_t *comm);
 
+/**
+ * Select the coll components of a communicator right away.
+ *
+ * mca_coll_base_comm_select() only installs placeholder functions when
+ * coll_base_lazy_select is set, and the actual selection happens in
+ * this function the first time a collective is called on the
+ * communicator. Selecting components can be expensive (some of them
+ * communicate or create sub-communicators) and many communicators,
+ * starting with MPI_COMM_WORLD in a session, never see a collective.
+ */
+int mca_coll_base_comm_select_now(struct ompi_communicator_t *comm);
+
+/**
+ * Install the placeholder functions of the lazy selection
+ */
+int mca_coll_base_comm_select_lazy(struct ompi_communicator_t *comm);
+
 /**
  * Finalize a coll component on a specific communicator.
  *
@@ -125,6 +142,8 @@ int mca_coll_base_comm_unselect(struct ompi_communicator_t *comm);
  * Globals
  */
 OMPI_DECLSPEC extern mca_base_framework_t ompi_coll_base_framework;
+/** Defer the selection of the coll components (coll_base_lazy_select) */
+extern bool mca_coll_base_lazy_select;
 
 END_C_DECLS
 #endif /* MCA_BASE_COLL_H */
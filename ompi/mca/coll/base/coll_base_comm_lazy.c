@@ -0,0 +1,180 @@
+/* -*- Mode: C; c-basic-offset:4 ; indent-tabs-mode:nil -*- */
+/*
+ * $COPYRIGHT$
+ *
+ * Additional copyrights may follow
+ *
+ * $HEADER$
+ */
+
+/*
+ * Lazy selection of the coll components of a communicator.
+ *
+ * Instead of querying and enabling every component when a communicator
+ * is created, a placeholder module is installed for all the collective
+ * functions. The first collective called on the communicator removes
+ * the placeholder, runs the real selection and forwards the call to the
+ * function that was selected. reduce_local does not involve the other
+ * processes, so it is executed locally and never triggers the selection.
+ */
+
+#include "ompi_config.h"
+
+#include <stdlib.h>
+
+#include "mpi.h"
+#include "opal/util/output.h"
+#include "ompi/communicator/communicator.h"
+#include "ompi/mca/coll/coll.h"
+#include "ompi/mca/coll/base/base.h"
+#include "ompi/mca/coll/base/coll_base_functions.h"
+
+/*
+ * Replace the placeholders by the selected components. Called by all
+ * the processes of the communicator, from the first collective.
+ */
+static int lazy_select(ompi_communicator_t *comm)
+{
+    int ret;
+
+    opal_output_verbose(10, ompi_coll_base_framework.framework_output,
+                        "coll:base:comm_select: first collective on %s (cid %d)",
+                        comm->c_name, comm->c_contextid);
+
+    mca_coll_base_comm_unselect(comm);
+    ret = mca_coll_base_comm_select_now(comm);
+    if (OMPI_SUCCESS != ret && NULL == comm->c_coll) {
+        /* keep the communicator usable, the error is reported again by
+         * the next collective */
+        (void) mca_coll_base_comm_select_lazy(comm);
+    }
+    return ret;
+}
+
+#define LAZY(func, args, ...)                                           \
+    static int lazy_ ## func (args)                                     \
+    {                                                                   \
+        int ret = lazy_select(comm);                                    \
+        if (OMPI_SUCCESS != ret) {                                      \
+            return ret;                                                 \
+        }                                                               \
+        if (OPAL_UNLIKELY(NULL == comm->c_coll->coll_ ## func)) {       \
+            return OMPI_ERR_NOT_SUPPORTED;                              \
+        }                                                               \
+        return comm->c_coll->coll_ ## func (__VA_ARGS__,                \
+                                            comm->c_coll->coll_ ## func ## _module); \
+    }
+
+#define LAZY_ALL(func, FUNC)                                            \
+    LAZY(func, FUNC ## _ARGS, FUNC ## _BASE_ARG_NAMES)                  \
+    LAZY(i ## func, I ## FUNC ## _ARGS, FUNC ## _BASE_ARG_NAMES, request) \
+    LAZY(func ## _init, FUNC ## _INIT_ARGS, FUNC ## _BASE_ARG_NAMES, info, request)
+
+LAZY_ALL(allgather, ALLGATHER)
+LAZY_ALL(allgatherv, ALLGATHERV)
+LAZY_ALL(allreduce, ALLREDUCE)
+LAZY_ALL(alltoall, ALLTOALL)
+LAZY_ALL(alltoallv, ALLTOALLV)
+LAZY_ALL(alltoallw, ALLTOALLW)
+LAZY_ALL(barrier, BARRIER)
+LAZY_ALL(bcast, BCAST)
+LAZY_ALL(exscan, EXSCAN)
+LAZY_ALL(gather, GATHER)
+LAZY_ALL(gatherv, GATHERV)
+LAZY_ALL(reduce, REDUCE)
+LAZY_ALL(reduce_scatter_block, REDUCESCATTERBLOCK)
+LAZY_ALL(reduce_scatter, REDUCESCATTER)
+LAZY_ALL(scan, SCAN)
+LAZY_ALL(scatter, SCATTER)
+LAZY_ALL(scatterv, SCATTERV)
+
+LAZY_ALL(neighbor_allgather, NEIGHBOR_ALLGATHER)
+LAZY_ALL(neighbor_allgatherv, NEIGHBOR_ALLGATHERV)
+LAZY_ALL(neighbor_alltoall, NEIGHBOR_ALLTOALL)
+LAZY_ALL(neighbor_alltoallv, NEIGHBOR_ALLTOALLV)
+LAZY_ALL(neighbor_alltoallw, NEIGHBOR_ALLTOALLW)
+
+#if OPAL_ENABLE_FT_MPI
+#define AGREE_BASE_ARGS void *contrib, int dt_count, struct ompi_datatype_t *dtype, struct ompi_op_t *op, struct ompi_group_t **failedgroup, bool update_failedgroup, struct ompi_communicator_t *comm
+#define AGREE_ARGS  AGREE_BASE_ARGS, mca_coll_base_module_t *module
+#define IAGREE_ARGS AGREE_BASE_ARGS, ompi_request_t **request, mca_coll_base_module_t *module
+#define AGREE_BASE_ARG_NAMES contrib, dt_count, dtype, op, failedgroup, update_failedgroup, comm
+
+LAZY(agree, AGREE_ARGS, AGREE_BASE_ARG_NAMES)
+LAZY(iagree, IAGREE_ARGS, AGREE_BASE_ARG_NAMES, request)
+#endif
+
+#define INSTALL(module, comm, func)                                     \
+    do {                                                                \
+        (module)->coll_ ## func = lazy_ ## func;                        \
+        (comm)->c_coll->coll_ ## func = lazy_ ## func;                  \
+        (comm)->c_coll->coll_ ## func ## _module = (module);            \
+        OBJ_RETAIN(module);                                             \
+    } while (0)
+
+#define INSTALL_ALL(module, comm, func)                                 \
+    do {                                                                \
+        INSTALL(module, comm, func);                                    \
+        INSTALL(module, comm, i ## func);                               \
+        INSTALL(module, comm, func ## _init);                           \
+    } while (0)
+
+int mca_coll_base_comm_select_lazy(ompi_communicator_t *comm)
+{
+    mca_coll_base_module_t *module;
+
+    comm->c_coll = (mca_coll_base_comm_coll_t*)calloc(1, sizeof(mca_coll_base_comm_coll_t));
+    if (NULL == comm->c_coll) {
+        return OMPI_ERR_OUT_OF_RESOURCE;
+    }
+    /* the placeholder is not a selected module */
+    comm->c_coll->module_list = OBJ_NEW(opal_list_t);
+
+    module = OBJ_NEW(mca_coll_base_module_t);
+    if (NULL == module) {
+        OBJ_RELEASE(comm->c_coll->module_list);
+        free(comm->c_coll);
+        comm->c_coll = NULL;
+        return OMPI_ERR_OUT_OF_RESOURCE;
+    }
+
+    INSTALL_ALL(module, comm, allgather);
+    INSTALL_ALL(module, comm, allgatherv);
+    INSTALL_ALL(module, comm, allreduce);
+    INSTALL_ALL(module, comm, alltoall);
+    INSTALL_ALL(module, comm, alltoallv);
+    INSTALL_ALL(module, comm, alltoallw);
+    INSTALL_ALL(module, comm, barrier);
+    INSTALL_ALL(module, comm, bcast);
+    INSTALL_ALL(module, comm, exscan);
+    INSTALL_ALL(module, comm, gather);
+    INSTALL_ALL(module, comm, gatherv);
+    INSTALL_ALL(module, comm, reduce);
+    INSTALL_ALL(module, comm, reduce_scatter_block);
+    INSTALL_ALL(module, comm, reduce_scatter);
+    INSTALL_ALL(module, comm, scan);
+    INSTALL_ALL(module, comm, scatter);
+    INSTALL_ALL(module, comm, scatterv);
+
+    INSTALL_ALL(module, comm, neighbor_allgather);
+    INSTALL_ALL(module, comm, neighbor_allgatherv);
+    INSTALL_ALL(module, comm, neighbor_alltoall);
+    INSTALL_ALL(module, comm, neighbor_alltoallv);
+    INSTALL_ALL(module, comm, neighbor_alltoallw);
+
+#if OPAL_ENABLE_FT_MPI
+    INSTALL(module, comm, agree);
+    INSTALL(module, comm, iagree);
+#endif
+
+    /* local operation, no need to select anything for it */
+    module->coll_reduce_local = mca_coll_base_reduce_local;
+    comm->c_coll->coll_reduce_local = mca_coll_base_reduce_local;
+    comm->c_coll->coll_reduce_local_module = module;
+    OBJ_RETAIN(module);
+
+    /* the communicator holds all the references */
+    OBJ_RELEASE(module);
+
+    return OMPI_SUCCESS;
+}
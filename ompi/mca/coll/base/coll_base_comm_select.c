@@ -94,6 +94,14 @@ static int query_2_4_0(const mca_coll_base_component_2_4_0_t *
  * This selection logic is not for the weak.
  */
 int mca_coll_base_comm_select(ompi_communicator_t * comm)
+{
+    if (mca_coll_base_lazy_select) {
+        return mca_coll_base_comm_select_lazy(comm);
+    }
+    return mca_coll_base_comm_select_now(comm);
+}
+
+int mca_coll_base_comm_select_now(ompi_communicator_t * comm)
 {
     opal_list_t *selectable;
     opal_list_item_t *item;
@@ -130,5 +130,21 @@ ompi_request_t** ompi_coll_base_comm_get_reqs(mca_coll_base_comm_t* data, int nr
     return data->mcct_reqs;
 }
 
-MCA_BASE_FRAMEWORK_DECLARE(ompi, coll, "Collectives", NULL, NULL, NULL,
+bool mca_coll_base_lazy_select = false;
+
+static int mca_coll_base_register(mca_base_register_flag_t flags)
+{
+    mca_coll_base_lazy_select = false;
+    (void) mca_base_var_register("ompi", "coll", "base", "lazy_select",
+                                 "Defer the selection of the collective components of a "
+                                 "communicator until its first collective operation",
+                                 MCA_BASE_VAR_TYPE_BOOL, NULL, 0, 0,
+                                 OPAL_INFO_LVL_9,
+                                 MCA_BASE_VAR_SCOPE_READONLY,
+                                 &mca_coll_base_lazy_select);
+
+    return OMPI_SUCCESS;
+}
+
+MCA_BASE_FRAMEWORK_DECLARE(ompi, coll, "Collectives", mca_coll_base_register, NULL, NULL,
                            mca_coll_base_static_components, 0);
@@ -68,9 +68,16 @@
 #define MCA_COLL_BASE_TAG_NEIGHBOR_BASE  (MCA_COLL_BASE_TAG_NONBLOCKING_END - 1)
 #define MCA_COLL_BASE_TAG_NEIGHBOR_END   (MCA_COLL_BASE_TAG_NEIGHBOR_BASE - 1024)
 #define MCA_COLL_BASE_TAG_HCOLL_BASE (-1 * INT_MAX/2)
-#define MCA_COLL_BASE_TAG_HCOLL_END (-1 * INT_MAX)
+#define MCA_COLL_BASE_TAG_HCOLL_END (MCA_COLL_BASE_TAG_PART_BASE + 1)
+/* partitioned point-to-point (see ompi/mca/part) */
+#define MCA_COLL_BASE_TAG_PART_BASE      (MCA_COLL_BASE_TAG_PART_END + (1 << 20) - 1)
+#define MCA_COLL_BASE_TAG_PART_END       (MCA_COLL_BASE_TAG_FROM_GROUP_BASE + 1)
+/* context id agreement of MPI_Comm_create_from_group, the string tag
+ * of the user is hashed into this range */
+#define MCA_COLL_BASE_TAG_FROM_GROUP_BASE (MCA_COLL_BASE_TAG_FROM_GROUP_END + 65535)
+#define MCA_COLL_BASE_TAG_FROM_GROUP_END  (-1 * INT_MAX)
 
 #define MCA_COLL_BASE_TAG_BASE MCA_COLL_BASE_TAG_BLOCKING_BASE
-#define MCA_COLL_BASE_TAG_END  MCA_COLL_BASE_TAG_HCOLL_END
+#define MCA_COLL_BASE_TAG_END  MCA_COLL_BASE_TAG_FROM_GROUP_END
 
 #endif /* MCA_COLL_BASE_TAGS_H */
@@ -169,6 +169,61 @@ struct mca_coll_han_allgather_s {
 };
 typedef struct mca_coll_han_allgather_s mca_coll_han_allgather_t;
 
+struct mca_coll_han_alltoall_args_s {
+    mca_coll_task_t *cur_task;
+    ompi_communicator_t *up_comm;
+    ompi_communicator_t *low_comm;
+    /* local data, packed by destination node, starting with my node */
+    char *pack_buf;
+    /* node leader buffers */
+    char *gather_buf;
+    char *send_buf;
+    char *recv_buf;
+    char *scatter_buf;
+    /* data received from the node leader for the current segment */
+    char *stage_buf;
+    ompi_request_t **reqs;
+    void *rbuf;
+    ompi_datatype_t *rdtype;
+    int rcount;
+    size_t block_size;
+    int my_node;
+    int nodes_per_seg;
+    int num_segments;
+    int cur_seg;
+    int w_rank;
+    bool noop;
+    int *topo;
+};
+typedef struct mca_coll_han_alltoall_args_s mca_coll_han_alltoall_args_t;
+
+struct mca_coll_han_reduce_scatter_args_s {
+    mca_coll_task_t *cur_task;
+    ompi_communicator_t *up_comm;
+    ompi_communicator_t *low_comm;
+    /* local data, ordered by node */
+    void *sbuf;
+    /* node leader buffers */
+    void *acc_buf;
+    void *node_buf;
+    void *rbuf;
+    ompi_op_t *op;
+    ompi_datatype_t *dtype;
+    /* first element of the block of each node, up_size + 1 entries */
+    int *node_disps;
+    int *up_counts;
+    int *low_counts;
+    int *low_disps;
+    int seg_count;
+    int num_segments;
+    int cur_seg;
+    int last_seg_count;
+    int my_node;
+    int w_rank;
+    bool noop;
+};
+typedef struct mca_coll_han_reduce_scatter_args_s mca_coll_han_reduce_scatter_args_t;
+
 /**
  * Structure to hold the han coll component.  First it holds the
  * base coll component, and then holds a bunch of
@@ -197,6 +252,16 @@ typedef struct mca_coll_han_component_t {
     uint32_t han_reduce_low_module;
     /* segment size for allreduce */
     uint32_t han_allreduce_segsize;
+    /* segment size for alltoall */
+    uint32_t han_alltoall_segsize;
+    /* segment size for reduce_scatter */
+    uint32_t han_reduce_scatter_segsize;
+    /* largest block for the hierarchical alltoall, 0 for no limit */
+    size_t han_alltoall_max_size;
+    /* largest amount of data between two processes for the hierarchical alltoallv */
+    size_t han_alltoallv_max_size;
+    /* largest reduced buffer for the hierarchical reduce_scatter */
+    size_t han_reduce_scatter_max_size;
     /* up level module for allreduce */
     uint32_t han_allreduce_up_module;
     /* low level module for allreduce */
@@ -242,10 +307,13 @@ typedef struct mca_coll_han_single_collective_fallback_s {
         mca_coll_base_module_allgather_fn_t allgather;
         mca_coll_base_module_allgatherv_fn_t allgatherv;
         mca_coll_base_module_allreduce_fn_t allreduce;
+        mca_coll_base_module_alltoall_fn_t alltoall;
+        mca_coll_base_module_alltoallv_fn_t alltoallv;
         mca_coll_base_module_barrier_fn_t barrier;
         mca_coll_base_module_bcast_fn_t bcast;
         mca_coll_base_module_gather_fn_t gather;
         mca_coll_base_module_reduce_fn_t reduce;
+        mca_coll_base_module_reduce_scatter_fn_t reduce_scatter;
         mca_coll_base_module_scatter_fn_t scatter;
     } module_fn;
     mca_coll_base_module_t* module;
@@ -260,9 +328,12 @@ typedef struct mca_coll_han_collectives_fallback_s {
     mca_coll_han_single_collective_fallback_t allgather;
     mca_coll_han_single_collective_fallback_t allgatherv;
     mca_coll_han_single_collective_fallback_t allreduce;
+    mca_coll_han_single_collective_fallback_t alltoall;
+    mca_coll_han_single_collective_fallback_t alltoallv;
     mca_coll_han_single_collective_fallback_t barrier;
     mca_coll_han_single_collective_fallback_t bcast;
     mca_coll_han_single_collective_fallback_t reduce;
+    mca_coll_han_single_collective_fallback_t reduce_scatter;
     mca_coll_han_single_collective_fallback_t gather;
     mca_coll_han_single_collective_fallback_t scatter;
 } mca_coll_han_collectives_fallback_t;
@@ -325,6 +396,12 @@ OBJ_CLASS_DECLARATION(mca_coll_han_module_t);
 #define previous_allreduce          fallback.allreduce.module_fn.allreduce
 #define previous_allreduce_module   fallback.allreduce.module
 
+#define previous_alltoall           fallback.alltoall.module_fn.alltoall
+#define previous_alltoall_module    fallback.alltoall.module
+
+#define previous_alltoallv          fallback.alltoallv.module_fn.alltoallv
+#define previous_alltoallv_module   fallback.alltoallv.module
+
 #define previous_barrier            fallback.barrier.module_fn.barrier
 #define previous_barrier_module     fallback.barrier.module
 
@@ -334,6 +411,9 @@ OBJ_CLASS_DECLARATION(mca_coll_han_module_t);
 #define previous_reduce             fallback.reduce.module_fn.reduce
 #define previous_reduce_module      fallback.reduce.module
 
+#define previous_reduce_scatter         fallback.reduce_scatter.module_fn.reduce_scatter
+#define previous_reduce_scatter_module  fallback.reduce_scatter.module
+
 #define previous_gather             fallback.gather.module_fn.gather
 #define previous_gather_module      fallback.gather.module
 
@@ -364,6 +444,9 @@ OBJ_CLASS_DECLARATION(mca_coll_han_module_t);
         HAN_LOAD_FALLBACK_COLLECTIVE(HANM, COMM, allreduce);                 \
         HAN_LOAD_FALLBACK_COLLECTIVE(HANM, COMM, allgather);                 \
         HAN_LOAD_FALLBACK_COLLECTIVE(HANM, COMM, allgatherv);                \
+        HAN_LOAD_FALLBACK_COLLECTIVE(HANM, COMM, alltoall);                  \
+        HAN_LOAD_FALLBACK_COLLECTIVE(HANM, COMM, alltoallv);                 \
+        HAN_LOAD_FALLBACK_COLLECTIVE(HANM, COMM, reduce_scatter);            \
         han_module->enabled = false;  /* entire module set to pass-through from now on */ \
     } while(0)
 
@@ -428,6 +511,12 @@ int
 mca_coll_han_allreduce_intra_dynamic(ALLREDUCE_BASE_ARGS,
                                      mca_coll_base_module_t *module);
 int
+mca_coll_han_alltoall_intra_dynamic(ALLTOALL_BASE_ARGS,
+                                    mca_coll_base_module_t *module);
+int
+mca_coll_han_alltoallv_intra_dynamic(ALLTOALLV_BASE_ARGS,
+                                     mca_coll_base_module_t *module);
+int
 mca_coll_han_barrier_intra_dynamic(BARRIER_BASE_ARGS,
                                  mca_coll_base_module_t *module);
 int
@@ -440,6 +529,9 @@ int
 mca_coll_han_reduce_intra_dynamic(REDUCE_BASE_ARGS,
                                   mca_coll_base_module_t *module);
 int
+mca_coll_han_reduce_scatter_intra_dynamic(REDUCESCATTER_BASE_ARGS,
+                                          mca_coll_base_module_t *module);
+int
 mca_coll_han_scatter_intra_dynamic(SCATTER_BASE_ARGS,
                                    mca_coll_base_module_t *module);
 
@@ -573,4 +665,28 @@ mca_coll_han_allgather_intra_simple(const void *sbuf, int scount,
                                     struct ompi_communicator_t *comm,
                                     mca_coll_base_module_t *module);
 
+/* Alltoall */
+int
+mca_coll_han_alltoall_intra(const void *sbuf, int scount,
+                            struct ompi_datatype_t *sdtype,
+                            void *rbuf, int rcount,
+                            struct ompi_datatype_t *rdtype,
+                            struct ompi_communicator_t *comm, mca_coll_base_module_t * module);
+
+/* Alltoallv */
+int
+mca_coll_han_alltoallv_intra(const void *sbuf, const int *scounts, const int *sdispls,
+                             struct ompi_datatype_t *sdtype,
+                             void *rbuf, const int *rcounts, const int *rdispls,
+                             struct ompi_datatype_t *rdtype,
+                             struct ompi_communicator_t *comm, mca_coll_base_module_t * module);
+
+/* Reduce_scatter */
+int
+mca_coll_han_reduce_scatter_intra(const void *sbuf, void *rbuf, const int *rcounts,
+                                  struct ompi_datatype_t *dtype,
+                                  struct ompi_op_t *op,
+                                  struct ompi_communicator_t *comm,
+                                  mca_coll_base_module_t * module);
+
 #endif                          /* MCA_COLL_HAN_EXPORT_H */
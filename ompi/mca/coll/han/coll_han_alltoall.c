@@ -0,0 +1,685 @@
+/*
+ * $COPYRIGHT$
+ *
+ * Additional copyrights may follow
+ *
+ * $HEADER$
+ */
+
+/**
+ * @file
+ *
+ * This files contains the hierarchical implementations of alltoall and alltoallv.
+ * The data of all the processes of a node is aggregated on the node leader, which
+ * exchanges a single message with the leader of each other node. The received
+ * messages are then scattered to the processes of the node.
+ * Only work with regular situation (each node has equal number of processes)
+ */
+
+#include "coll_han.h"
+
+#include <limits.h>
+
+#include "ompi/mca/coll/base/coll_base_functions.h"
+#include "ompi/mca/coll/base/coll_tags.h"
+#include "ompi/mca/pml/pml.h"
+#include "coll_han_trigger.h"
+
+static int mca_coll_han_alltoall_t0_task(void *task_args);
+static int mca_coll_han_alltoall_t1_task(void *task_args);
+static int mca_coll_han_alltoall_t2_task(void *task_args);
+
+/* Outcome of the alltoallv agreement, the highest value of all the processes wins */
+#define HAN_ALLTOALLV_PROCEED  0
+#define HAN_ALLTOALLV_FALLBACK 1
+#define HAN_ALLTOALLV_NOMEM    2
+
+/*
+ * The node leaders exchange the messages of two segments at a time: while a
+ * segment is exchanged, the next one is gathered and the previous one is
+ * scattered. Returns the first node message of the buffer slot of a segment.
+ */
+static inline size_t
+mca_coll_han_alltoall_seg_slot(mca_coll_han_alltoall_args_t *t, int seg)
+{
+    return (size_t)(seg % 2) * t->nodes_per_seg;
+}
+
+/* Number of nodes handled by the segment seg */
+static inline int
+mca_coll_han_alltoall_seg_nodes(mca_coll_han_alltoall_args_t *t, int seg)
+{
+    int up_size = ompi_comm_size(t->up_comm);
+    int nodes = up_size - seg * t->nodes_per_seg;
+
+    return (nodes < t->nodes_per_seg) ? nodes : t->nodes_per_seg;
+}
+
+/*
+ * lg: lower level (shared-memory or intra-node) gather of the data sent to the
+ * nodes of segment seg. The node leader then builds one message per node.
+ */
+static void
+mca_coll_han_alltoall_lg(mca_coll_han_alltoall_args_t *t, int seg)
+{
+    int low_size = ompi_comm_size(t->low_comm);
+    int nodes = mca_coll_han_alltoall_seg_nodes(t, seg);
+    int first = seg * t->nodes_per_seg;
+    size_t slot = mca_coll_han_alltoall_seg_slot(t, seg);
+    /* data sent by one process to one node */
+    size_t node_size = (size_t)low_size * t->block_size;
+
+    t->low_comm->c_coll->coll_gather(t->pack_buf + (size_t)first * node_size,
+                                     (int)(nodes * node_size), MPI_BYTE,
+                                     t->gather_buf, (int)(nodes * node_size), MPI_BYTE,
+                                     0, t->low_comm, t->low_comm->c_coll->coll_gather_module);
+    if (t->noop) {
+        return;
+    }
+    /* gather_buf is [src local][node][dst local], each message is [src local][dst local] */
+    for (int i = 0; i < low_size; i++) {
+        for (int n = 0; n < nodes; n++) {
+            memcpy(t->send_buf + ((slot + n) * low_size + i) * node_size,
+                   t->gather_buf + ((size_t)i * nodes + n) * node_size, node_size);
+        }
+    }
+}
+
+/*
+ * ux: upper level (inter-node) exchange of the messages of segment seg.
+ * At step r, a node sends to the node r after it and receives from the node
+ * r before it.
+ */
+static void
+mca_coll_han_alltoall_ux(mca_coll_han_alltoall_args_t *t, int seg)
+{
+    int low_size = ompi_comm_size(t->low_comm);
+    int up_size = ompi_comm_size(t->up_comm);
+    int nodes = mca_coll_han_alltoall_seg_nodes(t, seg);
+    int first = seg * t->nodes_per_seg;
+    size_t slot = mca_coll_han_alltoall_seg_slot(t, seg);
+    size_t msg_size = (size_t)low_size * low_size * t->block_size;
+
+    for (int n = 0; n < nodes; n++) {
+        int r = first + n;
+        int dst = (t->my_node + r) % up_size;
+        int src = (t->my_node - r + up_size) % up_size;
+        MCA_PML_CALL(irecv(t->recv_buf + (slot + n) * msg_size, (int)msg_size, MPI_BYTE,
+                           src, MCA_COLL_BASE_TAG_ALLTOALL, t->up_comm, &t->reqs[2 * n]));
+        MCA_PML_CALL(isend(t->send_buf + (slot + n) * msg_size, (int)msg_size, MPI_BYTE,
+                           dst, MCA_COLL_BASE_TAG_ALLTOALL, MCA_PML_BASE_SEND_STANDARD,
+                           t->up_comm, &t->reqs[2 * n + 1]));
+    }
+}
+
+/*
+ * ls: lower level (shared-memory or intra-node) scatter of the messages
+ * received from the nodes of segment seg, unpacked into the user buffer.
+ */
+static void
+mca_coll_han_alltoall_ls(mca_coll_han_alltoall_args_t *t, int seg)
+{
+    int low_size = ompi_comm_size(t->low_comm);
+    int up_size = ompi_comm_size(t->up_comm);
+    int nodes = mca_coll_han_alltoall_seg_nodes(t, seg);
+    int first = seg * t->nodes_per_seg;
+    size_t slot = mca_coll_han_alltoall_seg_slot(t, seg);
+    size_t node_size = (size_t)low_size * t->block_size;
+    ptrdiff_t rlb, rext;
+
+    if (!t->noop) {
+        /* each message is [src local][dst local], scatter_buf is [dst local][node][src local] */
+        for (int j = 0; j < low_size; j++) {
+            for (int n = 0; n < nodes; n++) {
+                for (int i = 0; i < low_size; i++) {
+                    memcpy(t->scatter_buf + (((size_t)j * nodes + n) * low_size + i) * t->block_size,
+                           t->recv_buf + ((slot + n) * low_size + i) * node_size
+                           + (size_t)j * t->block_size,
+                           t->block_size);
+                }
+            }
+        }
+    }
+    t->low_comm->c_coll->coll_scatter(t->scatter_buf, (int)(nodes * node_size), MPI_BYTE,
+                                      t->stage_buf, (int)(nodes * node_size), MPI_BYTE,
+                                      0, t->low_comm, t->low_comm->c_coll->coll_scatter_module);
+
+    ompi_datatype_get_extent(t->rdtype, &rlb, &rext);
+    for (int n = 0; n < nodes; n++) {
+        int src = (t->my_node - (first + n) + up_size) % up_size;
+        for (int i = 0; i < low_size; i++) {
+            int w = t->topo[2 * (src * low_size + i) + 1];
+            ompi_datatype_sndrcv(t->stage_buf + ((size_t)n * low_size + i) * t->block_size,
+                                 (int)t->block_size, MPI_PACKED,
+                                 (char *)t->rbuf + (ptrdiff_t)w * (ptrdiff_t)t->rcount * rext,
+                                 t->rcount, t->rdtype);
+        }
+    }
+}
+
+/*
+ * Each segment of the message goes through 3 steps to perform MPI_Alltoall:
+ *     lg: lower level (shared-memory or intra-node) gather on the node leader,
+ *     ux: upper level (inter-node) exchange, one message per pair of nodes,
+ *     ls: lower level (shared-memory or intra-node) scatter from the node leader.
+ * A segment is a set of destination nodes. The number of nodes of a segment is
+ * given by the alltoall segment size and the amount of data exchanged between
+ * two nodes.
+ *        | seg 0 | seg 1 | seg 2 |
+ * iter 0 |  lg   |       |       | task: t0, contains lg
+ * iter 1 |  ux   |  lg   |       | task: t1, contains ux and lg
+ * iter 2 |  ls   |  ux   |  lg   | task: t1, contains ls, ux and lg
+ * iter 3 |       |  ls   |  ux   | task: t1, contains ls and ux
+ * iter 4 |       |       |  ls   | task: t2, contains ls
+ * The node leaders only hold the messages of two segments at a time.
+ * Blocks larger than coll_han_alltoall_max_size fall back on another component.
+ */
+int
+mca_coll_han_alltoall_intra(const void *sbuf, int scount,
+                            struct ompi_datatype_t *sdtype,
+                            void *rbuf, int rcount,
+                            struct ompi_datatype_t *rdtype,
+                            struct ompi_communicator_t *comm, mca_coll_base_module_t * module)
+{
+    mca_coll_han_module_t *han_module = (mca_coll_han_module_t *) module;
+    mca_coll_han_alltoall_args_t *t;
+    ompi_communicator_t *low_comm, *up_comm;
+    int w_rank, w_size, low_rank, low_size, up_size, seg_slots, my_node = 0;
+    int err = OMPI_SUCCESS;
+    size_t block_size, node_size, msg_size;
+    ptrdiff_t slb, sext;
+    int *topo;
+
+    /* Create the subcommunicators */
+    if( OMPI_SUCCESS != mca_coll_han_comm_create_new(comm, han_module) ) {
+        OPAL_OUTPUT_VERBOSE((30, mca_coll_han_component.han_output,
+                             "han cannot handle alltoall within this communicator. Fall back on another component\n"));
+        /* HAN cannot work with this communicator so fallback on all collectives */
+        HAN_LOAD_FALLBACK_COLLECTIVES(han_module, comm);
+        return comm->c_coll->coll_alltoall(sbuf, scount, sdtype, rbuf, rcount, rdtype,
+                                           comm, comm->c_coll->coll_alltoall_module);
+    }
+
+    /* Init topo */
+    topo = mca_coll_han_topo_init(comm, han_module, 2);
+    /* unbalanced case needs algo adaptation */
+    if (han_module->are_ppn_imbalanced) {
+        OPAL_OUTPUT_VERBOSE((30, mca_coll_han_component.han_output,
+                             "han cannot handle alltoall with this communicator (imbalance). Fall back on another component\n"));
+        HAN_LOAD_FALLBACK_COLLECTIVE(han_module, comm, alltoall);
+        return comm->c_coll->coll_alltoall(sbuf, scount, sdtype, rbuf, rcount, rdtype,
+                                           comm, comm->c_coll->coll_alltoall_module);
+    }
+
+    low_comm = han_module->sub_comm[INTRA_NODE];
+    up_comm = han_module->sub_comm[INTER_NODE];
+    w_rank = ompi_comm_rank(comm);
+    w_size = ompi_comm_size(comm);
+    low_rank = ompi_comm_rank(low_comm);
+    low_size = ompi_comm_size(low_comm);
+    up_size = w_size / low_size;
+
+    /* The block size is the same on all the processes, so is the decision */
+    ompi_datatype_type_size(rdtype, &block_size);
+    block_size *= rcount;
+    if (0 == block_size) {
+        return OMPI_SUCCESS;
+    }
+    node_size = (size_t)low_size * block_size;
+    msg_size = (size_t)low_size * node_size;
+    /* The counts of the low and up level operations are int */
+    if (msg_size > INT_MAX ||
+        (0 < mca_coll_han_component.han_alltoall_max_size &&
+         block_size > mca_coll_han_component.han_alltoall_max_size)) {
+        OPAL_OUTPUT_VERBOSE((30, mca_coll_han_component.han_output,
+                             "han does not handle alltoall of this size. Fall back on another component\n"));
+        return han_module->previous_alltoall(sbuf, scount, sdtype, rbuf, rcount, rdtype,
+                                             comm, han_module->previous_alltoall_module);
+    }
+
+    /* The send buffer is entirely packed before anything is received */
+    if (MPI_IN_PLACE == sbuf) {
+        sbuf = rbuf;
+        scount = rcount;
+        sdtype = rdtype;
+    }
+
+    for (int p = 0; p < w_size; p++) {
+        if (topo[2 * p + 1] == w_rank) {
+            my_node = p / low_size;
+            break;
+        }
+    }
+
+    t = calloc(1, sizeof(mca_coll_han_alltoall_args_t));
+    if (NULL == t) {
+        return OMPI_ERR_OUT_OF_RESOURCE;
+    }
+    t->up_comm = up_comm;
+    t->low_comm = low_comm;
+    t->rbuf = rbuf;
+    t->rcount = rcount;
+    t->rdtype = rdtype;
+    t->block_size = block_size;
+    t->my_node = my_node;
+    t->w_rank = w_rank;
+    t->noop = (0 != low_rank);
+    t->topo = topo;
+    t->cur_seg = 0;
+    t->nodes_per_seg = (int)(mca_coll_han_component.han_alltoall_segsize / msg_size);
+    if (t->nodes_per_seg < 1) {
+        t->nodes_per_seg = 1;
+    } else if (t->nodes_per_seg > up_size) {
+        t->nodes_per_seg = up_size;
+    }
+    t->num_segments = (up_size + t->nodes_per_seg - 1) / t->nodes_per_seg;
+    OPAL_OUTPUT_VERBOSE((10, mca_coll_han_component.han_output,
+                         "In HAN Alltoall seg_size %d nodes_per_seg %d num_segments %d\n",
+                         mca_coll_han_component.han_alltoall_segsize, t->nodes_per_seg,
+                         t->num_segments));
+
+    /* The node leaders only hold the messages of the segments in flight */
+    seg_slots = (t->num_segments > 1) ? 2 : 1;
+    t->pack_buf = malloc((size_t)w_size * block_size);
+    t->stage_buf = malloc((size_t)t->nodes_per_seg * node_size);
+    if (!t->noop) {
+        t->gather_buf = malloc((size_t)t->nodes_per_seg * msg_size);
+        t->scatter_buf = malloc((size_t)t->nodes_per_seg * msg_size);
+        t->send_buf = malloc((size_t)seg_slots * t->nodes_per_seg * msg_size);
+        t->recv_buf = malloc((size_t)seg_slots * t->nodes_per_seg * msg_size);
+        t->reqs = malloc(2 * t->nodes_per_seg * sizeof(ompi_request_t *));
+    }
+    if (NULL == t->pack_buf || NULL == t->stage_buf ||
+        (!t->noop && (NULL == t->gather_buf || NULL == t->scatter_buf || NULL == t->send_buf ||
+                      NULL == t->recv_buf || NULL == t->reqs))) {
+        err = OMPI_ERR_OUT_OF_RESOURCE;
+        goto exit;
+    }
+
+    /* Pack the local data by destination node, starting with my node */
+    ompi_datatype_get_extent(sdtype, &slb, &sext);
+    for (int r = 0; r < up_size; r++) {
+        int node = (my_node + r) % up_size;
+        for (int j = 0; j < low_size; j++) {
+            int w = topo[2 * (node * low_size + j) + 1];
+            ompi_datatype_sndrcv((char *)sbuf + (ptrdiff_t)w * (ptrdiff_t)scount * sext,
+                                 scount, sdtype,
+                                 t->pack_buf + ((size_t)r * low_size + j) * block_size,
+                                 (int)block_size, MPI_PACKED);
+        }
+    }
+
+    /* Create t0 task for the first segment */
+    mca_coll_task_t *t0 = OBJ_NEW(mca_coll_task_t);
+    t->cur_task = t0;
+    init_task(t0, mca_coll_han_alltoall_t0_task, (void *) t);
+    issue_task(t0);
+
+    while (t->cur_seg < t->num_segments) {
+        /* Create t1 task for the current segment */
+        mca_coll_task_t *t1 = OBJ_NEW(mca_coll_task_t);
+        t->cur_task = t1;
+        init_task(t1, mca_coll_han_alltoall_t1_task, (void *) t);
+        issue_task(t1);
+        t->cur_seg = t->cur_seg + 1;
+    }
+
+    /* Create t2 task for the last segment */
+    mca_coll_task_t *t2 = OBJ_NEW(mca_coll_task_t);
+    t->cur_task = t2;
+    t->cur_seg = t->num_segments - 1;
+    init_task(t2, mca_coll_han_alltoall_t2_task, (void *) t);
+    issue_task(t2);
+
+ exit:
+    free(t->pack_buf);
+    free(t->stage_buf);
+    free(t->gather_buf);
+    free(t->scatter_buf);
+    free(t->send_buf);
+    free(t->recv_buf);
+    free(t->reqs);
+    free(t);
+
+    return err;
+}
+
+/* t0 task that gathers the first segment on the node leader */
+int mca_coll_han_alltoall_t0_task(void *task_args)
+{
+    mca_coll_han_alltoall_args_t *t = (mca_coll_han_alltoall_args_t *) task_args;
+    OPAL_OUTPUT_VERBOSE((30, mca_coll_han_component.han_output,
+                         "[%d] HAN Alltoall:  t0 %d\n", t->w_rank, t->cur_seg));
+    OBJ_RELEASE(t->cur_task);
+    mca_coll_han_alltoall_lg(t, 0);
+    return OMPI_SUCCESS;
+}
+
+/* t1 task that exchanges cur_seg while cur_seg+1 is gathered and cur_seg-1 is scattered */
+int mca_coll_han_alltoall_t1_task(void *task_args)
+{
+    mca_coll_han_alltoall_args_t *t = (mca_coll_han_alltoall_args_t *) task_args;
+    OPAL_OUTPUT_VERBOSE((30, mca_coll_han_component.han_output,
+                         "[%d] HAN Alltoall:  t1 %d\n", t->w_rank, t->cur_seg));
+    OBJ_RELEASE(t->cur_task);
+    /* ux of cur_seg */
+    if (!t->noop) {
+        mca_coll_han_alltoall_ux(t, t->cur_seg);
+    }
+    /* lg of cur_seg+1 */
+    if (t->cur_seg + 1 < t->num_segments) {
+        mca_coll_han_alltoall_lg(t, t->cur_seg + 1);
+    }
+    /* ls of cur_seg-1 */
+    if (t->cur_seg > 0) {
+        mca_coll_han_alltoall_ls(t, t->cur_seg - 1);
+    }
+    if (!t->noop) {
+        ompi_request_wait_all(2 * mca_coll_han_alltoall_seg_nodes(t, t->cur_seg), t->reqs,
+                              MPI_STATUSES_IGNORE);
+    }
+    return OMPI_SUCCESS;
+}
+
+/* t2 task that scatters the last segment */
+int mca_coll_han_alltoall_t2_task(void *task_args)
+{
+    mca_coll_han_alltoall_args_t *t = (mca_coll_han_alltoall_args_t *) task_args;
+    OPAL_OUTPUT_VERBOSE((30, mca_coll_han_component.han_output,
+                         "[%d] HAN Alltoall:  t2 %d\n", t->w_rank, t->cur_seg));
+    OBJ_RELEASE(t->cur_task);
+    mca_coll_han_alltoall_ls(t, t->cur_seg);
+    return OMPI_SUCCESS;
+}
+
+/**
+ * Alltoallv with one message per pair of nodes, without tasks.
+ * The data is exchanged as packed bytes, ordered by topological position:
+ *     1. low gather of the byte counts on the node leaders,
+ *     2. agreement of the node leaders on whether the exchange can be done here,
+ *     3. low gatherv of the data on the node leaders,
+ *     4. up alltoallv of the node messages between the node leaders,
+ *     5. low scatterv of the received data from the node leaders.
+ * The counts differ between processes, so the fallback for large messages
+ * (coll_han_alltoallv_max_size, or node messages that do not fit the int
+ * counts of the low and up level operations) has to be agreed on.
+ */
+int
+mca_coll_han_alltoallv_intra(const void *sbuf, const int *scounts, const int *sdispls,
+                             struct ompi_datatype_t *sdtype,
+                             void *rbuf, const int *rcounts, const int *rdispls,
+                             struct ompi_datatype_t *rdtype,
+                             struct ompi_communicator_t *comm, mca_coll_base_module_t * module)
+{
+    mca_coll_han_module_t *han_module = (mca_coll_han_module_t *) module;
+    ompi_communicator_t *low_comm, *up_comm;
+    int w_size, low_rank, low_size, up_size, n_counts, status = HAN_ALLTOALLV_PROCEED;
+    size_t max_size = mca_coll_han_component.han_alltoallv_max_size;
+    size_t ssize, rsize, send_total = 0, recv_total = 0, stotal = 0, rtotal = 0, off;
+    ptrdiff_t slb, sext, rlb, rext;
+    const void *pack_sbuf = sbuf;
+    const int *pack_scounts = scounts, *pack_sdispls = sdispls;
+    struct ompi_datatype_t *pack_sdtype = sdtype;
+    char *pack_buf = NULL, *unpack_buf = NULL;
+    /* node leader buffers, the gather buffer is reused for the scatter */
+    char *gather_buf = NULL, *send_buf = NULL, *recv_buf = NULL;
+    int *all_counts = NULL, *low_counts = NULL, *low_displs = NULL;
+    int *up_counts = NULL, *up_sdispls = NULL, *up_rcounts = NULL, *up_rdispls = NULL;
+    size_t *cursors = NULL;
+    int *counts, *topo;
+
+    /* Create the subcommunicators */
+    if( OMPI_SUCCESS != mca_coll_han_comm_create_new(comm, han_module) ) {
+        OPAL_OUTPUT_VERBOSE((30, mca_coll_han_component.han_output,
+                             "han cannot handle alltoallv within this communicator. Fall back on another component\n"));
+        /* HAN cannot work with this communicator so fallback on all collectives */
+        HAN_LOAD_FALLBACK_COLLECTIVES(han_module, comm);
+        return comm->c_coll->coll_alltoallv(sbuf, scounts, sdispls, sdtype,
+                                            rbuf, rcounts, rdispls, rdtype,
+                                            comm, comm->c_coll->coll_alltoallv_module);
+    }
+
+    /* Init topo */
+    topo = mca_coll_han_topo_init(comm, han_module, 2);
+    /* unbalanced case needs algo adaptation */
+    if (han_module->are_ppn_imbalanced) {
+        OPAL_OUTPUT_VERBOSE((30, mca_coll_han_component.han_output,
+                             "han cannot handle alltoallv with this communicator (imbalance). Fall back on another component\n"));
+        HAN_LOAD_FALLBACK_COLLECTIVE(han_module, comm, alltoallv);
+        return comm->c_coll->coll_alltoallv(sbuf, scounts, sdispls, sdtype,
+                                            rbuf, rcounts, rdispls, rdtype,
+                                            comm, comm->c_coll->coll_alltoallv_module);
+    }
+
+    low_comm = han_module->sub_comm[INTRA_NODE];
+    up_comm = han_module->sub_comm[INTER_NODE];
+    w_size = ompi_comm_size(comm);
+    low_rank = ompi_comm_rank(low_comm);
+    low_size = ompi_comm_size(low_comm);
+    up_size = w_size / low_size;
+
+    /* The send buffer is entirely packed before anything is received */
+    if (MPI_IN_PLACE == sbuf) {
+        pack_sbuf = rbuf;
+        pack_scounts = rcounts;
+        pack_sdispls = rdispls;
+        pack_sdtype = rdtype;
+    }
+    ompi_datatype_type_size(pack_sdtype, &ssize);
+    ompi_datatype_type_size(rdtype, &rsize);
+    ompi_datatype_get_extent(pack_sdtype, &slb, &sext);
+    ompi_datatype_get_extent(rdtype, &rlb, &rext);
+
+    /* Bytes sent to, then received from, each topological position, followed
+     * by the status of this process */
+    n_counts = 2 * w_size + 1;
+    counts = malloc(n_counts * sizeof(int));
+    if (NULL == counts) {
+        return OMPI_ERR_OUT_OF_RESOURCE;
+    }
+    for (int p = 0; p < w_size; p++) {
+        int w = topo[2 * p + 1];
+        size_t scnt = (size_t)pack_scounts[w] * ssize;
+        size_t rcnt = (size_t)rcounts[w] * rsize;
+        if (scnt > INT_MAX || rcnt > INT_MAX ||
+            (0 < max_size && (scnt > max_size || rcnt > max_size))) {
+            status = HAN_ALLTOALLV_FALLBACK;
+            scnt = rcnt = 0;
+        }
+        counts[p] = (int)scnt;
+        counts[w_size + p] = (int)rcnt;
+        send_total += scnt;
+        recv_total += rcnt;
+    }
+    if (HAN_ALLTOALLV_PROCEED == status) {
+        pack_buf = malloc(send_total);
+        unpack_buf = malloc(recv_total);
+        if ((NULL == pack_buf && 0 < send_total) || (NULL == unpack_buf && 0 < recv_total)) {
+            status = HAN_ALLTOALLV_NOMEM;
+        }
+    }
+    counts[2 * w_size] = status;
+
+    /* 1. low gather of the counts on the node leaders */
+    if (0 == low_rank) {
+        all_counts = malloc((size_t)low_size * n_counts * sizeof(int));
+        low_counts = malloc(2 * low_size * sizeof(int));
+        cursors = malloc(low_size * sizeof(size_t));
+        up_counts = malloc(4 * up_size * sizeof(int));
+        if (NULL == all_counts || NULL == low_counts || NULL == cursors || NULL == up_counts) {
+            free(all_counts);
+            free(low_counts);
+            free(cursors);
+            free(up_counts);
+            free(pack_buf);
+            free(unpack_buf);
+            free(counts);
+            return OMPI_ERR_OUT_OF_RESOURCE;
+        }
+        low_displs = low_counts + low_size;
+        up_sdispls = up_counts + up_size;
+        up_rcounts = up_counts + 2 * up_size;
+        up_rdispls = up_counts + 3 * up_size;
+    }
+    low_comm->c_coll->coll_gather(counts, n_counts, MPI_INT,
+                                  all_counts, n_counts, MPI_INT, 0,
+                                  low_comm, low_comm->c_coll->coll_gather_module);
+#define SENT(i, p) all_counts[(size_t)(i) * n_counts + (p)]
+#define RECVD(j, p) all_counts[(size_t)(j) * n_counts + w_size + (p)]
+#define STATUS(i) all_counts[(size_t)(i) * n_counts + 2 * w_size]
+
+    /* 2. the node leaders check that the messages of their node fit and agree on the outcome */
+    if (0 == low_rank) {
+        for (int i = 0; i < low_size; i++) {
+            if (STATUS(i) > status) {
+                status = STATUS(i);
+            }
+        }
+        /* one message per pair of nodes, [src local][dst local] */
+        for (int n = 0; n < up_size && HAN_ALLTOALLV_PROCEED == status; n++) {
+            size_t scnt = 0, rcnt = 0;
+            for (int i = 0; i < low_size; i++) {
+                for (int j = 0; j < low_size; j++) {
+                    scnt += SENT(i, n * low_size + j);
+                    rcnt += RECVD(j, n * low_size + i);
+                }
+            }
+            up_sdispls[n] = (int)stotal;
+            up_rdispls[n] = (int)rtotal;
+            stotal += scnt;
+            rtotal += rcnt;
+            if (stotal > INT_MAX || rtotal > INT_MAX) {
+                status = HAN_ALLTOALLV_FALLBACK;
+            }
+            up_counts[n] = (int)scnt;
+            up_rcounts[n] = (int)rcnt;
+        }
+        if (HAN_ALLTOALLV_PROCEED == status) {
+            gather_buf = malloc((stotal > rtotal) ? stotal : rtotal);
+            send_buf = malloc(stotal);
+            recv_buf = malloc(rtotal);
+            if (((NULL == gather_buf || NULL == send_buf) && 0 < stotal) ||
+                ((NULL == gather_buf || NULL == recv_buf) && 0 < rtotal)) {
+                status = HAN_ALLTOALLV_NOMEM;
+            }
+        }
+        up_comm->c_coll->coll_allreduce(MPI_IN_PLACE, &status, 1, MPI_INT, MPI_MAX,
+                                        up_comm, up_comm->c_coll->coll_allreduce_module);
+    }
+    low_comm->c_coll->coll_bcast(&status, 1, MPI_INT, 0,
+                                 low_comm, low_comm->c_coll->coll_bcast_module);
+    if (HAN_ALLTOALLV_PROCEED != status) {
+        OPAL_OUTPUT_VERBOSE((30, mca_coll_han_component.han_output,
+                             "han does not handle alltoallv of this size. Fall back on another component\n"));
+        goto exit;
+    }
+
+    /* 3. low gatherv of the data on the node leaders */
+    off = 0;
+    for (int p = 0; p < w_size; p++) {
+        int w = topo[2 * p + 1];
+        if (0 < counts[p]) {
+            ompi_datatype_sndrcv((char *)pack_sbuf + (ptrdiff_t)pack_sdispls[w] * sext,
+                                 pack_scounts[w], pack_sdtype,
+                                 pack_buf + off, counts[p], MPI_PACKED);
+            off += counts[p];
+        }
+    }
+    if (0 == low_rank) {
+        size_t total = 0;
+        for (int i = 0; i < low_size; i++) {
+            low_counts[i] = 0;
+            for (int p = 0; p < w_size; p++) {
+                low_counts[i] += SENT(i, p);
+            }
+            low_displs[i] = (int)total;
+            total += low_counts[i];
+        }
+    }
+    low_comm->c_coll->coll_gatherv(pack_buf, (int)send_total, MPI_BYTE,
+                                   gather_buf, low_counts, low_displs, MPI_BYTE, 0,
+                                   low_comm, low_comm->c_coll->coll_gatherv_module);
+
+    /* 4. up alltoallv of one message per pair of nodes */
+    if (0 == low_rank) {
+        /* the data of a process for a node is contiguous in gather_buf */
+        for (int i = 0; i < low_size; i++) {
+            cursors[i] = low_displs[i];
+        }
+        off = 0;
+        for (int n = 0; n < up_size; n++) {
+            for (int i = 0; i < low_size; i++) {
+                size_t len = 0;
+                for (int j = 0; j < low_size; j++) {
+                    len += SENT(i, n * low_size + j);
+                }
+                memcpy(send_buf + off, gather_buf + cursors[i], len);
+                cursors[i] += len;
+                off += len;
+            }
+        }
+
+        up_comm->c_coll->coll_alltoallv(send_buf, up_counts, up_sdispls, MPI_BYTE,
+                                        recv_buf, up_rcounts, up_rdispls, MPI_BYTE,
+                                        up_comm, up_comm->c_coll->coll_alltoallv_module);
+
+        /* 5a. reorder the received messages by destination process */
+        size_t total = 0;
+        for (int j = 0; j < low_size; j++) {
+            low_counts[j] = 0;
+            for (int p = 0; p < w_size; p++) {
+                low_counts[j] += RECVD(j, p);
+            }
+            low_displs[j] = (int)total;
+            cursors[j] = total;
+            total += low_counts[j];
+        }
+        off = 0;
+        for (int m = 0; m < up_size; m++) {
+            for (int i = 0; i < low_size; i++) {
+                for (int j = 0; j < low_size; j++) {
+                    size_t len = RECVD(j, m * low_size + i);
+                    memcpy(gather_buf + cursors[j], recv_buf + off, len);
+                    cursors[j] += len;
+                    off += len;
+                }
+            }
+        }
+    }
+#undef SENT
+#undef RECVD
+#undef STATUS
+
+    /* 5b. low scatterv from the node leaders */
+    low_comm->c_coll->coll_scatterv(gather_buf, low_counts, low_displs, MPI_BYTE,
+                                    unpack_buf, (int)recv_total, MPI_BYTE, 0,
+                                    low_comm, low_comm->c_coll->coll_scatterv_module);
+    off = 0;
+    for (int p = 0; p < w_size; p++) {
+        int w = topo[2 * p + 1];
+        if (0 < counts[w_size + p]) {
+            ompi_datatype_sndrcv(unpack_buf + off, counts[w_size + p], MPI_PACKED,
+                                 (char *)rbuf + (ptrdiff_t)rdispls[w] * rext, rcounts[w], rdtype);
+            off += counts[w_size + p];
+        }
+    }
+
+ exit:
+    free(pack_buf);
+    free(unpack_buf);
+    free(counts);
+    free(gather_buf);
+    free(send_buf);
+    free(recv_buf);
+    free(all_counts);
+    free(low_counts);
+    free(cursors);
+    free(up_counts);
+
+    if (HAN_ALLTOALLV_FALLBACK == status) {
+        return han_module->previous_alltoallv(sbuf, scounts, sdispls, sdtype,
+                                              rbuf, rcounts, rdispls, rdtype,
+                                              comm, han_module->previous_alltoallv_module);
+    }
+    return (HAN_ALLTOALLV_NOMEM == status) ? OMPI_ERR_OUT_OF_RESOURCE : OMPI_SUCCESS;
+}
@@ -231,6 +231,48 @@ static int han_register(void)
                                            OPAL_INFO_LVL_9,
                                            MCA_BASE_VAR_SCOPE_READONLY, &cs->han_allreduce_low_module);
 
+    cs->han_alltoall_segsize = 65536;
+    (void) mca_base_component_var_register(c, "alltoall_segsize",
+                                           "segment size for alltoall: amount of data "
+                                           "exchanged with remote nodes per pipeline step",
+                                           MCA_BASE_VAR_TYPE_INT, NULL, 0, 0,
+                                           OPAL_INFO_LVL_9,
+                                           MCA_BASE_VAR_SCOPE_READONLY, &cs->han_alltoall_segsize);
+
+    cs->han_reduce_scatter_segsize = 65536;
+    (void) mca_base_component_var_register(c, "reduce_scatter_segsize",
+                                           "segment size for reduce_scatter",
+                                           MCA_BASE_VAR_TYPE_INT, NULL, 0, 0,
+                                           OPAL_INFO_LVL_9,
+                                           MCA_BASE_VAR_SCOPE_READONLY, &cs->han_reduce_scatter_segsize);
+
+    /* aggregating the data of a node on its leader pays off for latency bound
+     * exchanges. above these sizes the collectives fall back on the previous
+     * component. */
+    cs->han_alltoall_max_size = 8192;
+    (void) mca_base_component_var_register(c, "alltoall_max_size",
+                                           "largest amount of data sent to each process for "
+                                           "which the hierarchical alltoall is used, 0 for no limit",
+                                           MCA_BASE_VAR_TYPE_SIZE_T, NULL, 0, 0,
+                                           OPAL_INFO_LVL_9,
+                                           MCA_BASE_VAR_SCOPE_READONLY, &cs->han_alltoall_max_size);
+
+    cs->han_alltoallv_max_size = 8192;
+    (void) mca_base_component_var_register(c, "alltoallv_max_size",
+                                           "largest amount of data exchanged by a pair of processes "
+                                           "for which the hierarchical alltoallv is used, 0 for no limit",
+                                           MCA_BASE_VAR_TYPE_SIZE_T, NULL, 0, 0,
+                                           OPAL_INFO_LVL_9,
+                                           MCA_BASE_VAR_SCOPE_READONLY, &cs->han_alltoallv_max_size);
+
+    cs->han_reduce_scatter_max_size = 16 * 1024 * 1024;
+    (void) mca_base_component_var_register(c, "reduce_scatter_max_size",
+                                           "largest reduced buffer for which the hierarchical "
+                                           "reduce_scatter is used, 0 for no limit",
+                                           MCA_BASE_VAR_TYPE_SIZE_T, NULL, 0, 0,
+                                           OPAL_INFO_LVL_9,
+                                           MCA_BASE_VAR_SCOPE_READONLY, &cs->han_reduce_scatter_max_size);
+
     cs->han_allgather_up_module = 0;
     (void) mca_base_component_var_register(c, "allgather_up_module",
                                            "up level module for allgather, 0 libnbc, 1 adapt",
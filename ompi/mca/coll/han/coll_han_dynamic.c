@@ -34,10 +34,13 @@ bool mca_coll_han_is_coll_dynamic_implemented(COLLTYPE_T coll_id)
     case ALLGATHER:
     case ALLGATHERV:
     case ALLREDUCE:
+    case ALLTOALL:
+    case ALLTOALLV:
     case BARRIER:
     case BCAST:
     case GATHER:
     case REDUCE:
+    case REDUCESCATTER:
     case SCATTER:
         return true;
     default:
@@ -637,6 +640,216 @@ mca_coll_han_allreduce_intra_dynamic(const void *sbuf,
 }
 
 
+/*
+ * Alltoall selector:
+ * On a sub-communicator, checks the stored rules to find the module to use
+ * On the global communicator, calls the han collective implementation, or
+ * calls the correct module if fallback mechanism is activated
+ */
+int
+mca_coll_han_alltoall_intra_dynamic(const void *sbuf, int scount,
+                                    struct ompi_datatype_t *sdtype,
+                                    void *rbuf, int rcount,
+                                    struct ompi_datatype_t *rdtype,
+                                    struct ompi_communicator_t *comm,
+                                    mca_coll_base_module_t *module)
+{
+    mca_coll_han_module_t *han_module = (mca_coll_han_module_t*) module;
+    TOPO_LVL_T topo_lvl = han_module->topologic_level;
+    mca_coll_base_module_alltoall_fn_t alltoall;
+    mca_coll_base_module_t *sub_module;
+    size_t msg_size;
+    int rank, verbosity = 0;
+
+    /* Compute configuration information for dynamic rules */
+    if( MPI_IN_PLACE != sbuf ) {
+        ompi_datatype_type_size(sdtype, &msg_size);
+        msg_size = msg_size * scount;
+    } else {
+        ompi_datatype_type_size(rdtype, &msg_size);
+        msg_size = msg_size * rcount;
+    }
+
+    sub_module = get_module(ALLTOALL,
+                            msg_size,
+                            comm,
+                            han_module);
+
+    /* First errors are always printed by rank 0 */
+    rank = ompi_comm_rank(comm);
+    if( (0 == rank) && (han_module->dynamic_errors < mca_coll_han_component.max_dynamic_errors) ) {
+        verbosity = 30;
+    }
+
+    if(NULL == sub_module) {
+        /*
+         * No valid collective module from dynamic rules
+         * nor from mca parameter
+         */
+        han_module->dynamic_errors++;
+        opal_output_verbose(verbosity, mca_coll_han_component.han_output,
+                            "coll:han:mca_coll_han_alltoall_intra_dynamic "
+                            "HAN did not find any valid module for collective %d (%s) "
+                            "with topological level %d (%s) on communicator (%d/%s). "
+                            "Please check dynamic file/mca parameters\n",
+                            ALLTOALL, mca_coll_base_colltype_to_str(ALLTOALL),
+                            topo_lvl, mca_coll_han_topo_lvl_to_str(topo_lvl),
+                            comm->c_contextid, comm->c_name);
+        OPAL_OUTPUT_VERBOSE((30, mca_coll_han_component.han_output,
+                             "HAN/ALLTOALL: No module found for the sub-communicator. "
+                             "Falling back to another component\n"));
+        alltoall = han_module->previous_alltoall;
+        sub_module = han_module->previous_alltoall_module;
+    } else if (NULL == sub_module->coll_alltoall) {
+        /*
+         * No valid collective from dynamic rules
+         * nor from mca parameter
+         */
+        han_module->dynamic_errors++;
+        opal_output_verbose(verbosity, mca_coll_han_component.han_output,
+                            "coll:han:mca_coll_han_alltoall_intra_dynamic "
+                            "HAN found valid module for collective %d (%s) "
+                            "with topological level %d (%s) on communicator (%d/%s) "
+                            "but this module cannot handle this collective. "
+                            "Please check dynamic file/mca parameters\n",
+                            ALLTOALL, mca_coll_base_colltype_to_str(ALLTOALL),
+                            topo_lvl, mca_coll_han_topo_lvl_to_str(topo_lvl),
+                            comm->c_contextid, comm->c_name);
+        OPAL_OUTPUT_VERBOSE((30, mca_coll_han_component.han_output,
+                             "HAN/ALLTOALL: the module found for the sub-"
+                             "communicator cannot handle the ALLTOALL operation. "
+                             "Falling back to another component\n"));
+        alltoall = han_module->previous_alltoall;
+        sub_module = han_module->previous_alltoall_module;
+    } else if (GLOBAL_COMMUNICATOR == topo_lvl && sub_module == module) {
+        /*
+         * No fallback mechanism activated for this configuration
+         * sub_module is valid
+         * sub_module->coll_alltoall is valid and point to this function
+         * Call han topological collective algorithm
+         */
+        alltoall = mca_coll_han_alltoall_intra;
+    } else {
+        /*
+         * If we get here:
+         * sub_module is valid
+         * sub_module->coll_alltoall is valid
+         * They points to the collective to use, according to the dynamic rules
+         * Selector's job is done, call the collective
+         */
+        alltoall = sub_module->coll_alltoall;
+    }
+    return alltoall(sbuf, scount, sdtype,
+                    rbuf, rcount, rdtype,
+                    comm, sub_module);
+}
+
+
+/*
+ * Alltoallv selector:
+ * On a sub-communicator, checks the stored rules to find the module to use
+ * On the global communicator, calls the han collective implementation, or
+ * calls the correct module if fallback mechanism is activated
+ * The alltoallv size is the size of the biggest segment
+ */
+int
+mca_coll_han_alltoallv_intra_dynamic(const void *sbuf, const int *scounts,
+                                     const int *sdispls,
+                                     struct ompi_datatype_t *sdtype,
+                                     void *rbuf, const int *rcounts,
+                                     const int *rdispls,
+                                     struct ompi_datatype_t *rdtype,
+                                     struct ompi_communicator_t *comm,
+                                     mca_coll_base_module_t *module)
+{
+    mca_coll_han_module_t *han_module = (mca_coll_han_module_t*) module;
+    TOPO_LVL_T topo_lvl = han_module->topologic_level;
+    mca_coll_base_module_alltoallv_fn_t alltoallv;
+    mca_coll_base_module_t *sub_module;
+    size_t msg_size = 0;
+    int rank, verbosity = 0;
+
+    /*
+     * The counts differ between processes, a size computed from them could
+     * select different modules on different processes. Only the rules of the
+     * smallest size apply, large messages are handled by the han algorithm
+     * itself (coll_han_alltoallv_max_size).
+     */
+    sub_module = get_module(ALLTOALLV,
+                            msg_size,
+                            comm,
+                            han_module);
+
+    /* First errors are always printed by rank 0 */
+    rank = ompi_comm_rank(comm);
+    if( (0 == rank) && (han_module->dynamic_errors < mca_coll_han_component.max_dynamic_errors) ) {
+        verbosity = 30;
+    }
+
+    if(NULL == sub_module) {
+        /*
+         * No valid collective module from dynamic rules
+         * nor from mca parameter
+         */
+        han_module->dynamic_errors++;
+        opal_output_verbose(verbosity, mca_coll_han_component.han_output,
+                            "coll:han:mca_coll_han_alltoallv_intra_dynamic "
+                            "HAN did not find any valid module for collective %d (%s) "
+                            "with topological level %d (%s) on communicator (%d/%s). "
+                            "Please check dynamic file/mca parameters\n",
+                            ALLTOALLV, mca_coll_base_colltype_to_str(ALLTOALLV),
+                            topo_lvl, mca_coll_han_topo_lvl_to_str(topo_lvl),
+                            comm->c_contextid, comm->c_name);
+        OPAL_OUTPUT_VERBOSE((30, mca_coll_han_component.han_output,
+                             "HAN/ALLTOALLV: No module found for the sub-communicator. "
+                             "Falling back to another component\n"));
+        alltoallv = han_module->previous_alltoallv;
+        sub_module = han_module->previous_alltoallv_module;
+    } else if (NULL == sub_module->coll_alltoallv) {
+        /*
+         * No valid collective from dynamic rules
+         * nor from mca parameter
+         */
+        han_module->dynamic_errors++;
+        opal_output_verbose(verbosity, mca_coll_han_component.han_output,
+                            "coll:han:mca_coll_han_alltoallv_intra_dynamic "
+                            "HAN found valid module for collective %d (%s) "
+                            "with topological level %d (%s) on communicator (%d/%s) "
+                            "but this module cannot handle this collective. "
+                            "Please check dynamic file/mca parameters\n",
+                            ALLTOALLV, mca_coll_base_colltype_to_str(ALLTOALLV),
+                            topo_lvl, mca_coll_han_topo_lvl_to_str(topo_lvl),
+                            comm->c_contextid, comm->c_name);
+        OPAL_OUTPUT_VERBOSE((30, mca_coll_han_component.han_output,
+                             "HAN/ALLTOALLV: the module found for the sub-"
+                             "communicator cannot handle the ALLTOALLV operation. "
+                             "Falling back to another component\n"));
+        alltoallv = han_module->previous_alltoallv;
+        sub_module = han_module->previous_alltoallv_module;
+    } else if (GLOBAL_COMMUNICATOR == topo_lvl && sub_module == module) {
+        /*
+         * No fallback mechanism activated for this configuration
+         * sub_module is valid
+         * sub_module->coll_alltoallv is valid and point to this function
+         * Call han topological collective algorithm
+         */
+        alltoallv = mca_coll_han_alltoallv_intra;
+    } else {
+        /*
+         * If we get here:
+         * sub_module is valid
+         * sub_module->coll_alltoallv is valid
+         * They points to the collective to use, according to the dynamic rules
+         * Selector's job is done, call the collective
+         */
+        alltoallv = sub_module->coll_alltoallv;
+    }
+    return alltoallv(sbuf, scounts, sdispls, sdtype,
+                     rbuf, rcounts, rdispls, rdtype,
+                     comm, sub_module);
+}
+
+
 /*
  * Barrier selector:
  * On a sub-communicator, checks the stored rules to find the module to use
@@ -1053,6 +1266,117 @@ mca_coll_han_reduce_intra_dynamic(const void *sbuf,
 }
 
 
+/*
+ * Reduce_scatter selector:
+ * On a sub-communicator, checks the stored rules to find the module to use
+ * On the global communicator, calls the han collective implementation, or
+ * calls the correct module if fallback mechanism is activated
+ * The reduce_scatter size is the size of the whole reduced buffer
+ */
+int
+mca_coll_han_reduce_scatter_intra_dynamic(const void *sbuf,
+                                          void *rbuf,
+                                          const int *rcounts,
+                                          struct ompi_datatype_t *dtype,
+                                          struct ompi_op_t *op,
+                                          struct ompi_communicator_t *comm,
+                                          mca_coll_base_module_t *module)
+{
+    mca_coll_han_module_t *han_module = (mca_coll_han_module_t*) module;
+    TOPO_LVL_T topo_lvl = han_module->topologic_level;
+    mca_coll_base_module_reduce_scatter_fn_t reduce_scatter;
+    mca_coll_base_module_t *sub_module;
+    size_t dtype_size, msg_size = 0;
+    int rank, verbosity = 0, comm_size, i;
+
+    /* Compute configuration information for dynamic rules */
+    comm_size = ompi_comm_size(comm);
+    ompi_datatype_type_size(dtype, &dtype_size);
+
+    for(i = 0; i < comm_size; i++) {
+        msg_size += dtype_size * rcounts[i];
+    }
+
+    sub_module = get_module(REDUCESCATTER,
+                            msg_size,
+                            comm,
+                            han_module);
+
+    /* First errors are always printed by rank 0 */
+    rank = ompi_comm_rank(comm);
+    if( (0 == rank) && (han_module->dynamic_errors < mca_coll_han_component.max_dynamic_errors) ) {
+        verbosity = 30;
+    }
+
+    if(NULL == sub_module) {
+        /*
+         * No valid collective module from dynamic rules
+         * nor from mca parameter
+         */
+        han_module->dynamic_errors++;
+        opal_output_verbose(verbosity, mca_coll_han_component.han_output,
+                            "coll:han:mca_coll_han_reduce_scatter_intra_dynamic "
+                            "HAN did not find any valid module for collective %d (%s) "
+                            "with topological level %d (%s) on communicator (%d/%s). "
+                            "Please check dynamic file/mca parameters\n",
+                            REDUCESCATTER, mca_coll_base_colltype_to_str(REDUCESCATTER),
+                            topo_lvl, mca_coll_han_topo_lvl_to_str(topo_lvl),
+                            comm->c_contextid, comm->c_name);
+        OPAL_OUTPUT_VERBOSE((30, mca_coll_han_component.han_output,
+                             "HAN/REDUCESCATTER: No module found for the sub-communicator. "
+                             "Falling back to another component\n"));
+        reduce_scatter = han_module->previous_reduce_scatter;
+        sub_module = han_module->previous_reduce_scatter_module;
+    } else if (NULL == sub_module->coll_reduce_scatter) {
+        /*
+         * No valid collective from dynamic rules
+         * nor from mca parameter
+         */
+        han_module->dynamic_errors++;
+        opal_output_verbose(verbosity, mca_coll_han_component.han_output,
+                            "coll:han:mca_coll_han_reduce_scatter_intra_dynamic "
+                            "HAN found valid module for collective %d (%s) "
+                            "with topological level %d (%s) on communicator (%d/%s) "
+                            "but this module cannot handle this collective. "
+                            "Please check dynamic file/mca parameters\n",
+                            REDUCESCATTER, mca_coll_base_colltype_to_str(REDUCESCATTER),
+                            topo_lvl, mca_coll_han_topo_lvl_to_str(topo_lvl),
+                            comm->c_contextid, comm->c_name);
+        OPAL_OUTPUT_VERBOSE((30, mca_coll_han_component.han_output,
+                             "HAN/REDUCESCATTER: the module found for the sub-"
+                             "communicator cannot handle the REDUCESCATTER operation. "
+                             "Falling back to another component\n"));
+        reduce_scatter = han_module->previous_reduce_scatter;
+        sub_module = han_module->previous_reduce_scatter_module;
+    } else if (GLOBAL_COMMUNICATOR == topo_lvl && sub_module == module) {
+        /* Reproducibility: fallback on the previous component */
+        if (mca_coll_han_component.han_reproducible) {
+            reduce_scatter = han_module->previous_reduce_scatter;
+            sub_module = han_module->previous_reduce_scatter_module;
+        } else {
+            /*
+             * No fallback mechanism activated for this configuration
+             * sub_module is valid
+             * sub_module->coll_reduce_scatter is valid and point to this function
+             * Call han topological collective algorithm
+             */
+            reduce_scatter = mca_coll_han_reduce_scatter_intra;
+        }
+    } else {
+        /*
+         * If we get here:
+         * sub_module is valid
+         * sub_module->coll_reduce_scatter is valid
+         * They points to the collective to use, according to the dynamic rules
+         * Selector's job is done, call the collective
+         */
+        reduce_scatter = sub_module->coll_reduce_scatter;
+    }
+    return reduce_scatter(sbuf, rbuf, rcounts, dtype, op,
+                          comm, sub_module);
+}
+
+
 /*
  * Scatter selector:
  * On a sub-communicator, checks the stored rules to find the module to use
@@ -44,9 +44,12 @@ static void han_module_clear(mca_coll_han_module_t *han_module)
     CLEAN_PREV_COLL(han_module, allgather);
     CLEAN_PREV_COLL(han_module, allgatherv);
     CLEAN_PREV_COLL(han_module, allreduce);
+    CLEAN_PREV_COLL(han_module, alltoall);
+    CLEAN_PREV_COLL(han_module, alltoallv);
     CLEAN_PREV_COLL(han_module, barrier);
     CLEAN_PREV_COLL(han_module, bcast);
     CLEAN_PREV_COLL(han_module, reduce);
+    CLEAN_PREV_COLL(han_module, reduce_scatter);
     CLEAN_PREV_COLL(han_module, gather);
     CLEAN_PREV_COLL(han_module, scatter);
 
@@ -142,9 +145,12 @@ mca_coll_han_module_destruct(mca_coll_han_module_t * module)
 
     OBJ_RELEASE_IF_NOT_NULL(module->previous_allgather_module);
     OBJ_RELEASE_IF_NOT_NULL(module->previous_allreduce_module);
+    OBJ_RELEASE_IF_NOT_NULL(module->previous_alltoall_module);
+    OBJ_RELEASE_IF_NOT_NULL(module->previous_alltoallv_module);
     OBJ_RELEASE_IF_NOT_NULL(module->previous_bcast_module);
     OBJ_RELEASE_IF_NOT_NULL(module->previous_gather_module);
     OBJ_RELEASE_IF_NOT_NULL(module->previous_reduce_module);
+    OBJ_RELEASE_IF_NOT_NULL(module->previous_reduce_scatter_module);
     OBJ_RELEASE_IF_NOT_NULL(module->previous_scatter_module);
 
     han_module_clear(module);
@@ -240,12 +246,9 @@ mca_coll_han_comm_query(struct ompi_communicator_t * comm, int *priority)
     }
 
     han_module->super.coll_module_enable = han_module_enable;
-    han_module->super.coll_alltoall   = NULL;
-    han_module->super.coll_alltoallv  = NULL;
     han_module->super.coll_alltoallw  = NULL;
     han_module->super.coll_exscan     = NULL;
     han_module->super.coll_gatherv    = NULL;
-    han_module->super.coll_reduce_scatter = NULL;
     han_module->super.coll_scan       = NULL;
     han_module->super.coll_scatterv   = NULL;
     han_module->super.coll_barrier    = mca_coll_han_barrier_intra_dynamic;
@@ -255,6 +258,9 @@ mca_coll_han_comm_query(struct ompi_communicator_t * comm, int *priority)
     han_module->super.coll_bcast      = mca_coll_han_bcast_intra_dynamic;
     han_module->super.coll_allreduce  = mca_coll_han_allreduce_intra_dynamic;
     han_module->super.coll_allgather  = mca_coll_han_allgather_intra_dynamic;
+    han_module->super.coll_alltoall   = mca_coll_han_alltoall_intra_dynamic;
+    han_module->super.coll_alltoallv  = mca_coll_han_alltoallv_intra_dynamic;
+    han_module->super.coll_reduce_scatter = mca_coll_han_reduce_scatter_intra_dynamic;
 
     if (GLOBAL_COMMUNICATOR == han_module->topologic_level) {
         /* We are on the global communicator, return topological algorithms */
@@ -302,10 +308,13 @@ han_module_enable(mca_coll_base_module_t * module,
     HAN_SAVE_PREV_COLL_API(allgather);
     HAN_SAVE_PREV_COLL_API(allgatherv);
     HAN_SAVE_PREV_COLL_API(allreduce);
+    HAN_SAVE_PREV_COLL_API(alltoall);
+    HAN_SAVE_PREV_COLL_API(alltoallv);
     HAN_SAVE_PREV_COLL_API(barrier);
     HAN_SAVE_PREV_COLL_API(bcast);
     HAN_SAVE_PREV_COLL_API(gather);
     HAN_SAVE_PREV_COLL_API(reduce);
+    HAN_SAVE_PREV_COLL_API(reduce_scatter);
     HAN_SAVE_PREV_COLL_API(scatter);
 
     /* set reproducible algos */
@@ -318,9 +327,12 @@ handle_error:
     OBJ_RELEASE_IF_NOT_NULL(han_module->previous_allgather_module);
     OBJ_RELEASE_IF_NOT_NULL(han_module->previous_allgatherv_module);
     OBJ_RELEASE_IF_NOT_NULL(han_module->previous_allreduce_module);
+    OBJ_RELEASE_IF_NOT_NULL(han_module->previous_alltoall_module);
+    OBJ_RELEASE_IF_NOT_NULL(han_module->previous_alltoallv_module);
     OBJ_RELEASE_IF_NOT_NULL(han_module->previous_bcast_module);
     OBJ_RELEASE_IF_NOT_NULL(han_module->previous_gather_module);
     OBJ_RELEASE_IF_NOT_NULL(han_module->previous_reduce_module);
+    OBJ_RELEASE_IF_NOT_NULL(han_module->previous_reduce_scatter_module);
     OBJ_RELEASE_IF_NOT_NULL(han_module->previous_scatter_module);
 
     return OMPI_ERROR;
@@ -338,10 +350,13 @@ mca_coll_han_module_disable(mca_coll_base_module_t * module,
     OBJ_RELEASE_IF_NOT_NULL(han_module->previous_allgather_module);
     OBJ_RELEASE_IF_NOT_NULL(han_module->previous_allgatherv_module);
     OBJ_RELEASE_IF_NOT_NULL(han_module->previous_allreduce_module);
+    OBJ_RELEASE_IF_NOT_NULL(han_module->previous_alltoall_module);
+    OBJ_RELEASE_IF_NOT_NULL(han_module->previous_alltoallv_module);
     OBJ_RELEASE_IF_NOT_NULL(han_module->previous_barrier_module);
     OBJ_RELEASE_IF_NOT_NULL(han_module->previous_bcast_module);
     OBJ_RELEASE_IF_NOT_NULL(han_module->previous_gather_module);
     OBJ_RELEASE_IF_NOT_NULL(han_module->previous_reduce_module);
+    OBJ_RELEASE_IF_NOT_NULL(han_module->previous_reduce_scatter_module);
     OBJ_RELEASE_IF_NOT_NULL(han_module->previous_scatter_module);
 
     han_module_clear(han_module);
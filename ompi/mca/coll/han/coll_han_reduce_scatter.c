@@ -0,0 +1,343 @@
+/*
+ * $COPYRIGHT$
+ *
+ * Additional copyrights may follow
+ *
+ * $HEADER$
+ */
+
+/**
+ * @file
+ *
+ * This files contains the hierarchical implementation of reduce_scatter.
+ * The data of the processes of a node is reduced on the node leader, the node
+ * leaders then reduce_scatter the result so that each of them gets the blocks
+ * of the processes of its node, which are finally scattered on the node.
+ * Only work with regular situation (each node has equal number of processes)
+ */
+
+#include "coll_han.h"
+
+#include <limits.h>
+
+#include "ompi/mca/coll/base/coll_base_functions.h"
+#include "ompi/mca/coll/base/coll_tags.h"
+#include "ompi/op/op.h"
+#include "coll_han_trigger.h"
+
+static int mca_coll_han_reduce_scatter_t0_task(void *task_args);
+static int mca_coll_han_reduce_scatter_t1_task(void *task_args);
+static int mca_coll_han_reduce_scatter_t2_task(void *task_args);
+
+/* Number of elements of the segment seg */
+static inline int
+mca_coll_han_reduce_scatter_seg_count(mca_coll_han_reduce_scatter_args_t *t, int seg)
+{
+    return (seg == t->num_segments - 1) ? t->last_seg_count : t->seg_count;
+}
+
+/* lr: lower level (shared-memory or intra-node) reduce of the segment seg */
+static void
+mca_coll_han_reduce_scatter_lr(mca_coll_han_reduce_scatter_args_t *t, int seg)
+{
+    ptrdiff_t extent, lb;
+    ompi_datatype_get_extent(t->dtype, &lb, &extent);
+    ptrdiff_t shift = extent * (ptrdiff_t)seg * (ptrdiff_t)t->seg_count;
+
+    t->low_comm->c_coll->coll_reduce((char *) t->sbuf + shift,
+                                     t->noop ? NULL : (char *) t->acc_buf + shift,
+                                     mca_coll_han_reduce_scatter_seg_count(t, seg),
+                                     t->dtype, t->op, 0, t->low_comm,
+                                     t->low_comm->c_coll->coll_reduce_module);
+}
+
+/*
+ * Each segment of the message goes through 2 steps before the result is scattered:
+ *     lr: lower level (shared-memory or intra-node) reduce,
+ *     ur: upper level (inter-node) reduce_scatter, each node leader gets the part of
+ *         the segment that belongs to the processes of its node.
+ *        | seg 0 | seg 1 | seg 2 |
+ * iter 0 |  lr   |       |       | task: t0, contains lr
+ * iter 1 |  ur   |  lr   |       | task: t1, contains ur and lr
+ * iter 2 |       |  ur   |  lr   | task: t1, contains ur and lr
+ * iter 3 |       |       |  ur   | task: t1, contains ur
+ * Then the node leaders scatter the blocks of their node (task t2, ls).
+ * The blocks are first reordered by node if the processes are not mapped by core.
+ * Reduced buffers larger than coll_han_reduce_scatter_max_size fall back on
+ * another component.
+ */
+int
+mca_coll_han_reduce_scatter_intra(const void *sbuf, void *rbuf, const int *rcounts,
+                                  struct ompi_datatype_t *dtype,
+                                  struct ompi_op_t *op,
+                                  struct ompi_communicator_t *comm,
+                                  mca_coll_base_module_t * module)
+{
+    mca_coll_han_module_t *han_module = (mca_coll_han_module_t *) module;
+    mca_coll_han_reduce_scatter_args_t *t;
+    ompi_communicator_t *low_comm, *up_comm;
+    int w_rank, w_size, low_rank, low_size, up_size, my_node = 0, count = 0;
+    char *tmp_buf = NULL, *acc_buf = NULL, *node_buf = NULL;
+    ptrdiff_t extent, lb, span, gap = 0;
+    size_t dtype_size, total = 0;
+    int *topo, err = OMPI_SUCCESS;
+
+    /* No support for non-commutative operations */
+    if(!ompi_op_is_commute(op)) {
+        OPAL_OUTPUT_VERBOSE((30, mca_coll_han_component.han_output,
+                             "han cannot handle reduce_scatter with this operation. Fall back on another component\n"));
+        goto prev_reduce_scatter_intra;
+    }
+
+    /* The counts are the same on all the processes, so is the decision. The
+     * counts of the low and up level operations are int. */
+    w_size = ompi_comm_size(comm);
+    for (int w = 0; w < w_size; w++) {
+        total += rcounts[w];
+    }
+    ompi_datatype_type_size(dtype, &dtype_size);
+    if (total > INT_MAX ||
+        (0 < mca_coll_han_component.han_reduce_scatter_max_size &&
+         total * dtype_size > mca_coll_han_component.han_reduce_scatter_max_size)) {
+        OPAL_OUTPUT_VERBOSE((30, mca_coll_han_component.han_output,
+                             "han does not handle reduce_scatter of this size. Fall back on another component\n"));
+        goto prev_reduce_scatter_intra;
+    }
+
+    /* Create the subcommunicators */
+    if( OMPI_SUCCESS != mca_coll_han_comm_create_new(comm, han_module) ) {
+        OPAL_OUTPUT_VERBOSE((30, mca_coll_han_component.han_output,
+                             "han cannot handle reduce_scatter with this communicator. Drop HAN support in this communicator and fall back on another component\n"));
+        /* HAN cannot work with this communicator so fallback on all collectives */
+        HAN_LOAD_FALLBACK_COLLECTIVES(han_module, comm);
+        return comm->c_coll->coll_reduce_scatter(sbuf, rbuf, rcounts, dtype, op,
+                                                 comm, comm->c_coll->coll_reduce_scatter_module);
+    }
+
+    /* Init topo */
+    topo = mca_coll_han_topo_init(comm, han_module, 2);
+    /* unbalanced case needs algo adaptation */
+    if (han_module->are_ppn_imbalanced) {
+        OPAL_OUTPUT_VERBOSE((30, mca_coll_han_component.han_output,
+                             "han cannot handle reduce_scatter with this communicator (imbalance). Fall back on another component\n"));
+        HAN_LOAD_FALLBACK_COLLECTIVE(han_module, comm, reduce_scatter);
+        return comm->c_coll->coll_reduce_scatter(sbuf, rbuf, rcounts, dtype, op,
+                                                 comm, comm->c_coll->coll_reduce_scatter_module);
+    }
+
+    low_comm = han_module->sub_comm[INTRA_NODE];
+    up_comm = han_module->sub_comm[INTER_NODE];
+    if (NULL == up_comm->c_coll->coll_ireduce_scatter) {
+        OPAL_OUTPUT_VERBOSE((30, mca_coll_han_component.han_output,
+                             "han cannot handle reduce_scatter without an inter node ireduce_scatter. Fall back on another component\n"));
+        goto prev_reduce_scatter_intra;
+    }
+
+    w_rank = ompi_comm_rank(comm);
+    low_rank = ompi_comm_rank(low_comm);
+    low_size = ompi_comm_size(low_comm);
+    up_size = w_size / low_size;
+
+    t = malloc(sizeof(mca_coll_han_reduce_scatter_args_t));
+    if (NULL == t) {
+        return OMPI_ERR_OUT_OF_RESOURCE;
+    }
+    t->node_disps = malloc((up_size + 1 + up_size + 2 * low_size) * sizeof(int));
+    if (NULL == t->node_disps) {
+        free(t);
+        return OMPI_ERR_OUT_OF_RESOURCE;
+    }
+    t->up_counts = t->node_disps + up_size + 1;
+    t->low_counts = t->up_counts + up_size;
+    t->low_disps = t->low_counts + low_size;
+
+    /* Blocks of each node, in topological order */
+    for (int p = 0; p < w_size; p++) {
+        if (topo[2 * p + 1] == w_rank) {
+            my_node = p / low_size;
+            break;
+        }
+    }
+    for (int p = 0; p < w_size; p++) {
+        int w = topo[2 * p + 1];
+        if (0 == p % low_size) {
+            t->node_disps[p / low_size] = count;
+        }
+        if (p / low_size == my_node) {
+            t->low_counts[p % low_size] = rcounts[w];
+            t->low_disps[p % low_size] = count - t->node_disps[my_node];
+        }
+        count += rcounts[w];
+    }
+    t->node_disps[up_size] = count;
+
+    if (0 == count) {
+        free(t->node_disps);
+        free(t);
+        return OMPI_SUCCESS;
+    }
+
+    ompi_datatype_get_extent(dtype, &lb, &extent);
+    if (MPI_IN_PLACE == sbuf) {
+        sbuf = rbuf;
+    }
+
+    /* Reorder the blocks by node if the processes are not mapped by core */
+    if (!han_module->is_mapbycore) {
+        int *user_disps = malloc(w_size * sizeof(int));
+        span = opal_datatype_span(&dtype->super, count, &gap);
+        tmp_buf = (char *) malloc(span);
+        if (NULL == user_disps || NULL == tmp_buf) {
+            free(user_disps);
+            err = OMPI_ERR_OUT_OF_RESOURCE;
+            goto exit;
+        }
+        for (int w = 0, disp = 0; w < w_size; w++) {
+            user_disps[w] = disp;
+            disp += rcounts[w];
+        }
+        for (int p = 0, disp = 0; p < w_size; p++) {
+            int w = topo[2 * p + 1];
+            ompi_datatype_copy_content_same_ddt(dtype, rcounts[w],
+                                                tmp_buf - gap + (ptrdiff_t)disp * extent,
+                                                (char *) sbuf + (ptrdiff_t)user_disps[w] * extent);
+            disp += rcounts[w];
+        }
+        free(user_disps);
+        sbuf = tmp_buf - gap;
+    }
+
+    if (0 == low_rank) {
+        span = opal_datatype_span(&dtype->super, count, &gap);
+        acc_buf = (char *) malloc(span);
+        t->acc_buf = acc_buf - gap;
+        span = opal_datatype_span(&dtype->super,
+                                  t->node_disps[my_node + 1] - t->node_disps[my_node], &gap);
+        node_buf = (char *) malloc(span);
+        t->node_buf = node_buf - gap;
+        if (NULL == acc_buf || NULL == node_buf) {
+            err = OMPI_ERR_OUT_OF_RESOURCE;
+            goto exit;
+        }
+    } else {
+        t->acc_buf = NULL;
+        t->node_buf = NULL;
+    }
+
+    t->up_comm = up_comm;
+    t->low_comm = low_comm;
+    t->sbuf = (void *) sbuf;
+    t->rbuf = rbuf;
+    t->op = op;
+    t->dtype = dtype;
+    t->my_node = my_node;
+    t->w_rank = w_rank;
+    t->noop = (0 != low_rank);
+    t->cur_seg = 0;
+    t->seg_count = count;
+    COLL_BASE_COMPUTED_SEGCOUNT(mca_coll_han_component.han_reduce_scatter_segsize, dtype_size,
+                                t->seg_count);
+    t->num_segments = (count + t->seg_count - 1) / t->seg_count;
+    t->last_seg_count = count - (t->num_segments - 1) * t->seg_count;
+    OPAL_OUTPUT_VERBOSE((10, mca_coll_han_component.han_output,
+                         "In HAN Reduce_scatter seg_size %d seg_count %d count %d\n",
+                         mca_coll_han_component.han_reduce_scatter_segsize, t->seg_count, count));
+
+    /* Create t0 task for the first segment */
+    mca_coll_task_t *t0 = OBJ_NEW(mca_coll_task_t);
+    t->cur_task = t0;
+    init_task(t0, mca_coll_han_reduce_scatter_t0_task, (void *) t);
+    issue_task(t0);
+
+    while (t->cur_seg < t->num_segments) {
+        /* Create t1 task for the current segment */
+        mca_coll_task_t *t1 = OBJ_NEW(mca_coll_task_t);
+        t->cur_task = t1;
+        init_task(t1, mca_coll_han_reduce_scatter_t1_task, (void *) t);
+        issue_task(t1);
+        t->cur_seg = t->cur_seg + 1;
+    }
+
+    /* Create t2 task to scatter the blocks of the node */
+    mca_coll_task_t *t2 = OBJ_NEW(mca_coll_task_t);
+    t->cur_task = t2;
+    init_task(t2, mca_coll_han_reduce_scatter_t2_task, (void *) t);
+    issue_task(t2);
+
+ exit:
+    free(tmp_buf);
+    free(acc_buf);
+    free(node_buf);
+    free(t->node_disps);
+    free(t);
+
+    return err;
+
+ prev_reduce_scatter_intra:
+    return han_module->previous_reduce_scatter(sbuf, rbuf, rcounts, dtype, op,
+                                               comm, han_module->previous_reduce_scatter_module);
+}
+
+/* t0 task that performs a local reduction of the first segment */
+int mca_coll_han_reduce_scatter_t0_task(void *task_args)
+{
+    mca_coll_han_reduce_scatter_args_t *t = (mca_coll_han_reduce_scatter_args_t *) task_args;
+    OPAL_OUTPUT_VERBOSE((30, mca_coll_han_component.han_output,
+                         "[%d] HAN Reduce_scatter:  t0 %d\n", t->w_rank, t->cur_seg));
+    OBJ_RELEASE(t->cur_task);
+    mca_coll_han_reduce_scatter_lr(t, 0);
+    return OMPI_SUCCESS;
+}
+
+/* t1 task that performs a ireduce_scatter on top communicator while reducing the next segment */
+int mca_coll_han_reduce_scatter_t1_task(void *task_args)
+{
+    mca_coll_han_reduce_scatter_args_t *t = (mca_coll_han_reduce_scatter_args_t *) task_args;
+    OPAL_OUTPUT_VERBOSE((30, mca_coll_han_component.han_output,
+                         "[%d] HAN Reduce_scatter:  t1 %d\n", t->w_rank, t->cur_seg));
+    OBJ_RELEASE(t->cur_task);
+    ptrdiff_t extent, lb;
+    ompi_datatype_get_extent(t->dtype, &lb, &extent);
+    ompi_request_t *ireduce_scatter_req;
+    if (!t->noop) {
+        int up_size = ompi_comm_size(t->up_comm);
+        int first = t->cur_seg * t->seg_count;
+        int last = first + mca_coll_han_reduce_scatter_seg_count(t, t->cur_seg);
+        char *rbuf = (char *) t->node_buf;
+        /* ur of cur_seg: each node gets the part of the segment in its blocks */
+        for (int n = 0; n < up_size; n++) {
+            int lo = (first > t->node_disps[n]) ? first : t->node_disps[n];
+            int hi = (last < t->node_disps[n + 1]) ? last : t->node_disps[n + 1];
+            t->up_counts[n] = (hi > lo) ? hi - lo : 0;
+            if (n == t->my_node && hi > lo) {
+                rbuf += (ptrdiff_t)(lo - t->node_disps[n]) * extent;
+            }
+        }
+        t->up_comm->c_coll->coll_ireduce_scatter((char *) t->acc_buf + (ptrdiff_t)first * extent,
+                                                 rbuf, t->up_counts, t->dtype, t->op,
+                                                 t->up_comm, &ireduce_scatter_req,
+                                                 t->up_comm->c_coll->coll_ireduce_scatter_module);
+    }
+    /* lr of cur_seg+1 */
+    if (t->cur_seg + 1 < t->num_segments) {
+        mca_coll_han_reduce_scatter_lr(t, t->cur_seg + 1);
+    }
+    if (!t->noop) {
+        ompi_request_wait(&ireduce_scatter_req, MPI_STATUS_IGNORE);
+    }
+    return OMPI_SUCCESS;
+}
+
+/* t2 task that scatters the blocks of the node from the node leader */
+int mca_coll_han_reduce_scatter_t2_task(void *task_args)
+{
+    mca_coll_han_reduce_scatter_args_t *t = (mca_coll_han_reduce_scatter_args_t *) task_args;
+    OPAL_OUTPUT_VERBOSE((30, mca_coll_han_component.han_output,
+                         "[%d] HAN Reduce_scatter:  t2\n", t->w_rank));
+    OBJ_RELEASE(t->cur_task);
+    int low_rank = ompi_comm_rank(t->low_comm);
+    t->low_comm->c_coll->coll_scatterv(t->node_buf, t->low_counts, t->low_disps, t->dtype,
+                                       t->rbuf, t->low_counts[low_rank], t->dtype, 0,
+                                       t->low_comm, t->low_comm->c_coll->coll_scatterv_module);
+    return OMPI_SUCCESS;
+}
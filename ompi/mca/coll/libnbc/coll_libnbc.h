@@ -30,6 +30,7 @@
 #include "ompi/mca/coll/coll.h"
 #include "ompi/mca/coll/base/coll_base_util.h"
 #include "opal/sys/atomic.h"
+#include "opal/class/opal_hash_table.h"
 
 BEGIN_C_DECLS
 
@@ -38,19 +39,8 @@ BEGIN_C_DECLS
 /* the debug level */
 #define NBC_DLEVEL 0
 
-/* enable schedule caching - undef NBC_CACHE_SCHEDULE to deactivate it */
-/* TODO: this whole schedule cache stuff does not work with the tmbuf
- * :-( - first, the tmpbuf must not be freed if a schedule using it is
- * still in the cache and second, the tmpbuf used by the schedule must
- * be attached to the handle that uses this schedule !!!!
- * I.E., THIS IS EXPERIMENTAL AND MIGHT NOT WORK */
-/* It also leaks memory because the schedule is never cleaned up when
-   the communicator is destroyed, so don't use it for now */
-#ifdef NBC_CACHE_SCHEDULE
-#undef NBC_CACHE_SCHEDULE
-#endif
-#define NBC_SCHED_DICT_UPPER 1024 /* max. number of dict entries */
-#define NBC_SCHED_DICT_LOWER 512  /* nuber of dict entries after wipe, if SCHED_DICT_UPPER is reached */
+/* initial size of the schedule array, it then grows by doubling */
+#define NBC_SCHED_INITIAL_SIZE 256
 
 /********************* end of LibNBC tuning parameters ************************/
 
@@ -66,9 +56,6 @@ BEGIN_C_DECLS
 #define NBC_INVALID_PARAM 7 /* invalid parameters */
 #define NBC_INVALID_TOPOLOGY_COMM 8 /* invalid topology attached to communicator */
 
-/* number of implemented collective functions */
-#define NBC_NUM_COLL 17
-
 extern bool libnbc_ibcast_skip_dt_decision;
 extern int libnbc_iallgather_algorithm;
 extern int libnbc_iallreduce_algorithm;
@@ -77,6 +64,7 @@ extern int libnbc_ibcast_knomial_radix;
 extern int libnbc_iexscan_algorithm;
 extern int libnbc_ireduce_algorithm;
 extern int libnbc_iscan_algorithm;
+extern int libnbc_schedule_cache_size;
 
 struct ompi_coll_libnbc_component_t {
     mca_coll_base_component_2_4_0_t super;
@@ -94,14 +82,7 @@ struct ompi_coll_libnbc_module_t {
     mca_coll_base_module_t super;
     opal_mutex_t mutex;
     bool comm_registered;
-#ifdef NBC_CACHE_SCHEDULE
-  void *NBC_Dict[NBC_NUM_COLL]; /* this should point to a struct
-                                      hb_tree, but since this is a
-                                      public header-file, this would be
-                                      an include mess :-(. So let's void
-                                      it ...*/
-  int NBC_Dict_size[NBC_NUM_COLL];
-#endif
+    opal_hash_table_t schedules;  /* committed schedules, keyed by their arguments */
 };
 typedef struct ompi_coll_libnbc_module_t ompi_coll_libnbc_module_t;
 OBJ_CLASS_DECLARATION(ompi_coll_libnbc_module_t);
@@ -112,7 +93,18 @@ struct NBC_Schedule {
     opal_object_t super;
     volatile int size;
     volatile int current_round_offset;
+    int capacity;               /* allocated size of data */
     char *data;
+    /* schedule cache: the collective and the arguments the schedule was
+     * built from, the datatypes and operations they reference, and the
+     * temporary buffer the schedule owns once it is cached */
+    char *key;
+    int key_size;
+    int key_capacity;
+    opal_object_t **key_objects;
+    int key_nobjects;
+    bool cached;
+    void *tmpbuf;
 };
 
 typedef struct NBC_Schedule NBC_Schedule;
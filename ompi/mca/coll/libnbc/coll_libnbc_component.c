@@ -45,6 +45,7 @@ const char *mca_coll_libnbc_component_version_string =
 static int libnbc_priority = 10;
 static bool libnbc_in_progress = false;     /* protect from recursive calls */
 bool libnbc_ibcast_skip_dt_decision = true;
+int libnbc_schedule_cache_size = 16;         /* schedules cached per communicator */
 
 int libnbc_iallgather_algorithm = 0;             /* iallgather user forced algorithm */
 static mca_base_var_enum_value_t iallgather_algorithms[] = {
@@ -212,6 +213,15 @@ libnbc_register(void)
                                            MCA_BASE_VAR_SCOPE_READONLY,
                                            &libnbc_ibcast_skip_dt_decision);
 
+    libnbc_schedule_cache_size = 16;
+    (void) mca_base_component_var_register(&mca_coll_libnbc_component.super.collm_version,
+                                           "schedule_cache_size",
+                                           "Number of committed schedules kept per communicator and reused by collectives called again with the same arguments (0 disables the cache)",
+                                           MCA_BASE_VAR_TYPE_INT, NULL, 0, 0,
+                                           OPAL_INFO_LVL_9,
+                                           MCA_BASE_VAR_SCOPE_READONLY,
+                                           &libnbc_schedule_cache_size);
+
     libnbc_iallgather_algorithm = 0;
     (void) mca_base_var_enum_create("coll_libnbc_iallgather_algorithms", iallgather_algorithms, &new_enum);
     mca_base_component_var_register(&mca_coll_libnbc_component.super.collm_version,
@@ -479,6 +489,7 @@ static void
 libnbc_module_construct(ompi_coll_libnbc_module_t *module)
 {
     OBJ_CONSTRUCT(&module->mutex, opal_mutex_t);
+    OBJ_CONSTRUCT(&module->schedules, opal_hash_table_t);
     module->comm_registered = false;
 }
 
@@ -486,6 +497,8 @@ libnbc_module_construct(ompi_coll_libnbc_module_t *module)
 static void
 libnbc_module_destruct(ompi_coll_libnbc_module_t *module)
 {
+    NBC_Schedule_cache_wipe(module);
+    OBJ_DESTRUCT(&module->schedules);
     OBJ_DESTRUCT(&module->mutex);
 
     /* if we ever were used for a collective op, do the progress cleanup. */
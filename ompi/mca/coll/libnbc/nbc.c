@@ -50,31 +50,65 @@ static void nbc_schedule_constructor (NBC_Schedule *schedule) {
   /* initial total size of the schedule */
   schedule->size = sizeof (int);
   schedule->current_round_offset = 0;
-  schedule->data = calloc (1, schedule->size);
+  schedule->capacity = NBC_SCHED_INITIAL_SIZE;
+  schedule->data = calloc (1, schedule->capacity);
+  if (NULL == schedule->data) {
+    schedule->capacity = 0;
+  }
+  schedule->key = NULL;
+  schedule->key_size = 0;
+  schedule->key_capacity = 0;
+  schedule->key_objects = NULL;
+  schedule->key_nobjects = 0;
+  schedule->cached = false;
+  schedule->tmpbuf = NULL;
 }
 
 static void nbc_schedule_destructor (NBC_Schedule *schedule) {
   free (schedule->data);
   schedule->data = NULL;
+
+  if (schedule->cached) {
+    for (int i = 0 ; i < schedule->key_nobjects ; ++i) {
+      OBJ_RELEASE(schedule->key_objects[i]);
+    }
+  }
+  free (schedule->key_objects);
+  schedule->key_objects = NULL;
+  free (schedule->key);
+  schedule->key = NULL;
+  free (schedule->tmpbuf);
+  schedule->tmpbuf = NULL;
 }
 
 OBJ_CLASS_INSTANCE(NBC_Schedule, opal_object_t, nbc_schedule_constructor,
                    nbc_schedule_destructor);
 
+/* the schedule array grows by doubling so that building a schedule does
+ * not reallocate it on every appended operation */
 static int nbc_schedule_grow (NBC_Schedule *schedule, int additional) {
   void *tmp;
-  int size;
+  int size, capacity;
 
   /* get current size of schedule */
   size = nbc_schedule_get_size (schedule);
+  if (size + additional <= schedule->capacity) {
+    return OMPI_SUCCESS;
+  }
 
-  tmp = realloc (schedule->data, size + additional);
+  capacity = schedule->capacity ? schedule->capacity : NBC_SCHED_INITIAL_SIZE;
+  while (capacity < size + additional) {
+    capacity *= 2;
+  }
+
+  tmp = realloc (schedule->data, capacity);
   if (NULL == tmp) {
     NBC_Error ("Could not increase the size of NBC schedule");
     return OMPI_ERR_OUT_OF_RESOURCE;
   }
 
   schedule->data = tmp;
+  schedule->capacity = capacity;
   return OMPI_SUCCESS;
 }
 
@@ -298,19 +332,20 @@ int NBC_Sched_commit(NBC_Schedule *schedule) {
  * to be called *only* from the progress thread !!! */
 static inline void NBC_Free (NBC_Handle* handle) {
 
+  /* if the nbc_I<collective> attached some data, unless it belongs to a
+   * cached schedule */
+  if (NULL != handle->tmpbuf) {
+    if (NULL == handle->schedule || handle->tmpbuf != handle->schedule->tmpbuf) {
+      free((void*)handle->tmpbuf);
+    }
+    handle->tmpbuf = NULL;
+  }
+
   if (NULL != handle->schedule) {
     /* release schedule */
     OBJ_RELEASE (handle->schedule);
     handle->schedule = NULL;
   }
-
-  /* if the nbc_I<collective> attached some data */
-  /* problems with schedule cache here, see comment (TODO) in
-   * nbc_internal.h */
-  if (NULL != handle->tmpbuf) {
-    free((void*)handle->tmpbuf);
-    handle->tmpbuf = NULL;
-  }
 }
 
 /* progresses a request
@@ -609,56 +644,183 @@ void NBC_Return_handle(ompi_coll_libnbc_request_t *request) {
 }
 
 int  NBC_Init_comm(MPI_Comm comm, NBC_Comminfo *comminfo) {
-
-#ifdef NBC_CACHE_SCHEDULE
-  /* initialize the NBC_ALLTOALL SchedCache tree */
-  comminfo->NBC_Dict[NBC_ALLTOALL] = hb_tree_new((dict_cmp_func)NBC_Alltoall_args_compare, NBC_SchedCache_args_delete_key_dummy, NBC_SchedCache_args_delete);
-  if(comminfo->NBC_Dict[NBC_ALLTOALL] == NULL) { printf("Error in hb_tree_new()\n"); return OMPI_ERROR;; }
-  NBC_DEBUG(1, "added tree at address %lu\n", (unsigned long)comminfo->NBC_Dict[NBC_ALLTOALL]);
-  comminfo->NBC_Dict_size[NBC_ALLTOALL] = 0;
-  /* initialize the NBC_ALLGATHER SchedCache tree */
-  comminfo->NBC_Dict[NBC_ALLGATHER] = hb_tree_new((dict_cmp_func)NBC_Allgather_args_compare, NBC_SchedCache_args_delete_key_dummy, NBC_SchedCache_args_delete);
-  if(comminfo->NBC_Dict[NBC_ALLGATHER] == NULL) { printf("Error in hb_tree_new()\n"); return OMPI_ERROR;; }
-  NBC_DEBUG(1, "added tree at address %lu\n", (unsigned long)comminfo->NBC_Dict[NBC_ALLGATHER]);
-  comminfo->NBC_Dict_size[NBC_ALLGATHER] = 0;
-  /* initialize the NBC_ALLREDUCE SchedCache tree */
-  comminfo->NBC_Dict[NBC_ALLREDUCE] = hb_tree_new((dict_cmp_func)NBC_Allreduce_args_compare, NBC_SchedCache_args_delete_key_dummy, NBC_SchedCache_args_delete);
-  if(comminfo->NBC_Dict[NBC_ALLREDUCE] == NULL) { printf("Error in hb_tree_new()\n"); return OMPI_ERROR;; }
-  NBC_DEBUG(1, "added tree at address %lu\n", (unsigned long)comminfo->NBC_Dict[NBC_ALLREDUCE]);
-  comminfo->NBC_Dict_size[NBC_ALLREDUCE] = 0;
-  /* initialize the NBC_BARRIER SchedCache tree - is not needed -
-   * schedule is hung off directly */
-  comminfo->NBC_Dict_size[NBC_BARRIER] = 0;
-  /* initialize the NBC_BCAST SchedCache tree */
-  comminfo->NBC_Dict[NBC_BCAST] = hb_tree_new((dict_cmp_func)NBC_Bcast_args_compare, NBC_SchedCache_args_delete_key_dummy, NBC_SchedCache_args_delete);
-  if(comminfo->NBC_Dict[NBC_BCAST] == NULL) { printf("Error in hb_tree_new()\n"); return OMPI_ERROR;; }
-  NBC_DEBUG(1, "added tree at address %lu\n", (unsigned long)comminfo->NBC_Dict[NBC_BCAST]);
-  comminfo->NBC_Dict_size[NBC_BCAST] = 0;
-  /* initialize the NBC_GATHER SchedCache tree */
-  comminfo->NBC_Dict[NBC_GATHER] = hb_tree_new((dict_cmp_func)NBC_Gather_args_compare, NBC_SchedCache_args_delete_key_dummy, NBC_SchedCache_args_delete);
-  if(comminfo->NBC_Dict[NBC_GATHER] == NULL) { printf("Error in hb_tree_new()\n"); return OMPI_ERROR;; }
-  NBC_DEBUG(1, "added tree at address %lu\n", (unsigned long)comminfo->NBC_Dict[NBC_GATHER]);
-  comminfo->NBC_Dict_size[NBC_GATHER] = 0;
-  /* initialize the NBC_REDUCE SchedCache tree */
-  comminfo->NBC_Dict[NBC_REDUCE] = hb_tree_new((dict_cmp_func)NBC_Reduce_args_compare, NBC_SchedCache_args_delete_key_dummy, NBC_SchedCache_args_delete);
-  if(comminfo->NBC_Dict[NBC_REDUCE] == NULL) { printf("Error in hb_tree_new()\n"); return OMPI_ERROR;; }
-  NBC_DEBUG(1, "added tree at address %lu\n", (unsigned long)comminfo->NBC_Dict[NBC_REDUCE]);
-  comminfo->NBC_Dict_size[NBC_REDUCE] = 0;
-  /* initialize the NBC_SCAN SchedCache tree */
-  comminfo->NBC_Dict[NBC_SCAN] = hb_tree_new((dict_cmp_func)NBC_Scan_args_compare, NBC_SchedCache_args_delete_key_dummy, NBC_SchedCache_args_delete);
-  if(comminfo->NBC_Dict[NBC_SCAN] == NULL) { printf("Error in hb_tree_new()\n"); return OMPI_ERROR;; }
-  NBC_DEBUG(1, "added tree at address %lu\n", (unsigned long)comminfo->NBC_Dict[NBC_SCAN]);
-  comminfo->NBC_Dict_size[NBC_SCAN] = 0;
-  /* initialize the NBC_SCATTER SchedCache tree */
-  comminfo->NBC_Dict[NBC_SCATTER] = hb_tree_new((dict_cmp_func)NBC_Scatter_args_compare, NBC_SchedCache_args_delete_key_dummy, NBC_SchedCache_args_delete);
-  if(comminfo->NBC_Dict[NBC_SCATTER] == NULL) { printf("Error in hb_tree_new()\n"); return OMPI_ERROR;; }
-  NBC_DEBUG(1, "added tree at address %lu\n", (unsigned long)comminfo->NBC_Dict[NBC_SCATTER]);
-  comminfo->NBC_Dict_size[NBC_SCATTER] = 0;
-#endif
+  if (0 < libnbc_schedule_cache_size) {
+    return opal_hash_table_init (&comminfo->schedules, libnbc_schedule_cache_size);
+  }
 
   return OMPI_SUCCESS;
 }
 
+/* the first int of a key is reserved for the collective, it is filled by
+ * NBC_Schedule_cache_lookup(). A key whose allocation failed is marked with
+ * a negative size so that the schedule is neither looked up nor cached. */
+static bool nbc_schedule_key_grow (NBC_Schedule *schedule, size_t additional) {
+  size_t capacity;
+  void *tmp;
+
+  if (0 > schedule->key_size) {
+    return false;
+  }
+
+  if (NULL == schedule->key) {
+    schedule->key_size = sizeof (int);
+  }
+
+  if (schedule->key_size + additional <= (size_t) schedule->key_capacity) {
+    return true;
+  }
+
+  capacity = schedule->key_capacity ? schedule->key_capacity : 64;
+  while (capacity < schedule->key_size + additional) {
+    capacity *= 2;
+  }
+
+  tmp = realloc (schedule->key, capacity);
+  if (NULL == tmp) {
+    schedule->key_size = -1;
+    return false;
+  }
+
+  schedule->key = tmp;
+  schedule->key_capacity = capacity;
+  return true;
+}
+
+void NBC_Sched_key (NBC_Schedule *schedule, const void *data, size_t size) {
+  if (0 >= libnbc_schedule_cache_size || !nbc_schedule_key_grow (schedule, size)) {
+    return;
+  }
+
+  memcpy (schedule->key + schedule->key_size, data, size);
+  schedule->key_size += size;
+}
+
+/* datatypes and operations are part of the key by address, they are
+ * retained by a cached schedule so that the address can not be reused by
+ * another object while the schedule is in the cache */
+void NBC_Sched_key_object (NBC_Schedule *schedule, void *object) {
+  opal_object_t **tmp;
+  int n;
+
+  if (0 >= libnbc_schedule_cache_size || !nbc_schedule_key_grow (schedule, sizeof (object))) {
+    return;
+  }
+
+  /* the array is doubled when it is full, it is full when the number of
+   * objects is a power of two */
+  n = schedule->key_nobjects;
+  if (0 == n || (4 <= n && 0 == (n & (n - 1)))) {
+    tmp = realloc (schedule->key_objects, (n ? 2 * n : 4) * sizeof (*tmp));
+    if (NULL == tmp) {
+      schedule->key_size = -1;
+      return;
+    }
+    schedule->key_objects = tmp;
+  }
+  schedule->key_objects[schedule->key_nobjects++] = (opal_object_t *) object;
+
+  memcpy (schedule->key + schedule->key_size, &object, sizeof (object));
+  schedule->key_size += sizeof (object);
+}
+
+bool NBC_Schedule_cache_lookup (NBC_Comminfo *comminfo, int coll, NBC_Schedule **schedule,
+                                void **tmpbuf) {
+  NBC_Schedule *cached = NULL;
+  bool found = false;
+
+  if (0 >= libnbc_schedule_cache_size || 0 >= (*schedule)->key_size) {
+    return false;
+  }
+
+  memcpy ((*schedule)->key, &coll, sizeof (int));
+
+  OPAL_THREAD_LOCK(&comminfo->mutex);
+  if (OPAL_SUCCESS == opal_hash_table_get_value_ptr (&comminfo->schedules, (*schedule)->key,
+                                                     (*schedule)->key_size, (void **) &cached)) {
+    /* the schedule and its temporary buffer can only be used by one
+     * request at a time, build a new one if it is still active */
+    if (1 == cached->super.obj_reference_count) {
+      OBJ_RETAIN(cached);
+      found = true;
+    }
+  }
+  OPAL_THREAD_UNLOCK(&comminfo->mutex);
+
+  if (found) {
+    OBJ_RELEASE(*schedule);
+    *schedule = cached;
+    if (NULL != tmpbuf) {
+      free (*tmpbuf);
+      *tmpbuf = cached->tmpbuf;
+    }
+    NBC_DEBUG(10, "found schedule %p for collective %d in cache\n", (void *) cached, coll);
+  }
+
+  return found;
+}
+
+void NBC_Schedule_cache_insert (NBC_Comminfo *comminfo, NBC_Schedule *schedule, void *tmpbuf) {
+  NBC_Schedule *cached;
+  void *tmp;
+
+  if (0 >= libnbc_schedule_cache_size || 0 >= schedule->key_size) {
+    return;
+  }
+
+  OPAL_THREAD_LOCK(&comminfo->mutex);
+  if (OPAL_SUCCESS == opal_hash_table_get_value_ptr (&comminfo->schedules, schedule->key,
+                                                     schedule->key_size, (void **) &cached)) {
+    /* another request built the same schedule while the cached one was busy */
+    OPAL_THREAD_UNLOCK(&comminfo->mutex);
+    return;
+  }
+
+  if (opal_hash_table_get_size (&comminfo->schedules) >= (size_t) libnbc_schedule_cache_size) {
+    NBC_Schedule_cache_wipe (comminfo);
+  }
+
+  /* the schedule will not grow anymore */
+  tmp = realloc (schedule->data, nbc_schedule_get_size (schedule));
+  if (NULL != tmp) {
+    schedule->data = tmp;
+    schedule->capacity = nbc_schedule_get_size (schedule);
+  }
+
+  for (int i = 0 ; i < schedule->key_nobjects ; ++i) {
+    OBJ_RETAIN(schedule->key_objects[i]);
+  }
+  schedule->cached = true;
+  schedule->tmpbuf = tmpbuf;
+
+  OBJ_RETAIN(schedule);
+  if (OPAL_SUCCESS != opal_hash_table_set_value_ptr (&comminfo->schedules, schedule->key,
+                                                     schedule->key_size, schedule)) {
+    /* the request still owns the schedule and its temporary buffer */
+    OBJ_RELEASE(schedule);
+  }
+  OPAL_THREAD_UNLOCK(&comminfo->mutex);
+}
+
+/* must be called with the module lock held or when the module is not
+ * shared anymore. Schedules used by active requests are released by
+ * them. */
+void NBC_Schedule_cache_wipe (NBC_Comminfo *comminfo) {
+  NBC_Schedule *schedule;
+  size_t key_size;
+  void *key, *node;
+  int ret;
+
+  ret = opal_hash_table_get_first_key_ptr (&comminfo->schedules, &key, &key_size,
+                                           (void **) &schedule, &node);
+  while (OPAL_SUCCESS == ret) {
+    OBJ_RELEASE(schedule);
+    ret = opal_hash_table_get_next_key_ptr (&comminfo->schedules, &key, &key_size,
+                                            (void **) &schedule, node, &node);
+  }
+
+  opal_hash_table_remove_all (&comminfo->schedules);
+}
+
 int NBC_Start(NBC_Handle *handle) {
   int res;
 
@@ -700,8 +862,10 @@ int NBC_Schedule_request(NBC_Schedule *schedule, ompi_communicator_t *comm,
      * and they may update the module->tag */
     (void)ompi_coll_base_nbc_reserve_tags(comm, 1);
 
+    if (tmpbuf != schedule->tmpbuf) {
+      free(tmpbuf);
+    }
     OBJ_RELEASE(schedule);
-    free(tmpbuf);
 
     return OMPI_SUCCESS;
   }
@@ -752,15 +916,3 @@ int NBC_Schedule_request(NBC_Schedule *schedule, ompi_communicator_t *comm,
   return OMPI_SUCCESS;
 }
 
-#ifdef NBC_CACHE_SCHEDULE
-void NBC_SchedCache_args_delete_key_dummy(void *k) {
-    /* do nothing because the key and the data element are identical :-)
-     * both (the single one :) is freed in NBC_<COLLOP>_args_delete() */
-}
-
-void NBC_SchedCache_args_delete(void *entry) {
-  struct NBC_dummyarg *tmp = (struct NBC_dummyarg*)entry;
-  OBJ_RELEASE(tmp->schedule);
-  free(entry);
-}
-#endif
@@ -22,9 +22,8 @@
  */
 #include "nbc_internal.h"
 
-/* an allgatherv schedule can not be cached easily because the contents
- * ot the recvcounts array may change, so a comparison of the address
- * would not be sufficient ... we simply do not cache it */
+/* the recvcounts and displs arrays are part of the schedule cache key,
+ * not only their addresses */
 
 /* simple linear MPI_Iallgatherv
  * the algorithm uses p-1 rounds
@@ -74,40 +73,53 @@ static int nbc_allgatherv_init(const void* sendbuf, int sendcount, MPI_Datatype
 
   sbuf = (char *) recvbuf + displs[rank] * rcvext;
 
-  if (persistent && !inplace) { /* for nonblocking, data has been copied already */
-    /* copy my data to receive buffer (= send buffer of NBC_Sched_send) */
-    res = NBC_Sched_copy ((void *)sendbuf, false, sendcount, sendtype,
-                          sbuf, false, recvcounts[rank], recvtype, schedule, true);
-    if (OPAL_UNLIKELY(OMPI_SUCCESS != res)) {
-      OBJ_RELEASE(schedule);
-      return res;
+  NBC_Sched_key(schedule, &persistent, sizeof(persistent));
+  NBC_Sched_key(schedule, &sendbuf, sizeof(sendbuf));
+  NBC_Sched_key(schedule, &sendcount, sizeof(sendcount));
+  NBC_Sched_key_object(schedule, sendtype);
+  NBC_Sched_key(schedule, &recvbuf, sizeof(recvbuf));
+  NBC_Sched_key(schedule, recvcounts, p * sizeof(*recvcounts));
+  NBC_Sched_key(schedule, displs, p * sizeof(*displs));
+  NBC_Sched_key_object(schedule, recvtype);
+
+  if (!NBC_Schedule_cache_lookup(libnbc_module, NBC_ALLGATHERV, &schedule, NULL)) {
+    if (persistent && !inplace) { /* for nonblocking, data has been copied already */
+      /* copy my data to receive buffer (= send buffer of NBC_Sched_send) */
+      res = NBC_Sched_copy ((void *)sendbuf, false, sendcount, sendtype,
+                            sbuf, false, recvcounts[rank], recvtype, schedule, true);
+      if (OPAL_UNLIKELY(OMPI_SUCCESS != res)) {
+        OBJ_RELEASE(schedule);
+        return res;
+      }
     }
-  }
 
-  /* do p-1 rounds */
-  for (int r = 1 ; r < p ; ++r) {
-    speer = (rank + r) % p;
-    rpeer = (rank - r + p) % p;
-    rbuf = (char *)recvbuf + displs[rpeer] * rcvext;
+    /* do p-1 rounds */
+    for (int r = 1 ; r < p ; ++r) {
+      speer = (rank + r) % p;
+      rpeer = (rank - r + p) % p;
+      rbuf = (char *)recvbuf + displs[rpeer] * rcvext;
 
-    res = NBC_Sched_recv (rbuf, false, recvcounts[rpeer], recvtype, rpeer, schedule, false);
-    if (OPAL_UNLIKELY(OMPI_SUCCESS != res)) {
-      OBJ_RELEASE(schedule);
-      return res;
+      res = NBC_Sched_recv (rbuf, false, recvcounts[rpeer], recvtype, rpeer, schedule, false);
+      if (OPAL_UNLIKELY(OMPI_SUCCESS != res)) {
+        OBJ_RELEASE(schedule);
+        return res;
+      }
+
+      /* send to rank r - not from the sendbuf to optimize MPI_IN_PLACE */
+      res = NBC_Sched_send (sbuf, false, recvcounts[rank], recvtype, speer, schedule, false);
+      if (OPAL_UNLIKELY(OMPI_SUCCESS != res)) {
+        OBJ_RELEASE(schedule);
+        return res;
+      }
     }
 
-    /* send to rank r - not from the sendbuf to optimize MPI_IN_PLACE */
-    res = NBC_Sched_send (sbuf, false, recvcounts[rank], recvtype, speer, schedule, false);
+    res = NBC_Sched_commit (schedule);
     if (OPAL_UNLIKELY(OMPI_SUCCESS != res)) {
       OBJ_RELEASE(schedule);
       return res;
     }
-  }
 
-  res = NBC_Sched_commit (schedule);
-  if (OPAL_UNLIKELY(OMPI_SUCCESS != res)) {
-    OBJ_RELEASE(schedule);
-    return res;
+    NBC_Schedule_cache_insert(libnbc_module, schedule, NULL);
   }
 
   res = NBC_Schedule_request (schedule, comm, libnbc_module, persistent, request, NULL);
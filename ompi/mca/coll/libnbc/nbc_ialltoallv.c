@@ -36,9 +36,8 @@ static inline int a2av_sched_inplace(int rank, int p, NBC_Schedule *schedule,
                                     void *buf, const int *counts, const int *displs,
                                     MPI_Aint ext, MPI_Datatype type, ptrdiff_t gap);
 
-/* an alltoallv schedule can not be cached easily because the contents
- * ot the recvcounts array may change, so a comparison of the address
- * would not be sufficient ... we simply do not cache it */
+/* the count and displacement arrays are part of the schedule cache key,
+ * not only their addresses */
 
 /* simple linear Alltoallv */
 static int nbc_alltoallv_init(const void* sendbuf, const int *sendcounts, const int *sdispls,
@@ -104,43 +103,59 @@ static int nbc_alltoallv_init(const void* sendbuf, const int *sendcounts, const
     return OMPI_ERR_OUT_OF_RESOURCE;
   }
 
+  NBC_Sched_key(schedule, &sendbuf, sizeof(sendbuf));
+  if (!inplace) {
+    NBC_Sched_key(schedule, sendcounts, p * sizeof(*sendcounts));
+    NBC_Sched_key(schedule, sdispls, p * sizeof(*sdispls));
+    NBC_Sched_key_object(schedule, sendtype);
+  }
+  NBC_Sched_key(schedule, &recvbuf, sizeof(recvbuf));
+  NBC_Sched_key(schedule, recvcounts, p * sizeof(*recvcounts));
+  NBC_Sched_key(schedule, rdispls, p * sizeof(*rdispls));
+  NBC_Sched_key_object(schedule, recvtype);
+
+  if (!NBC_Schedule_cache_lookup(libnbc_module, NBC_ALLTOALLV, &schedule, &tmpbuf)) {
+    if (!inplace && sendcounts[rank] != 0) {
+      rbuf = (char *) recvbuf + rdispls[rank] * rcvext;
+      sbuf = (char *) sendbuf + sdispls[rank] * sndext;
+      res = NBC_Sched_copy (sbuf, false, sendcounts[rank], sendtype,
+                            rbuf, false, recvcounts[rank], recvtype, schedule, false);
+      if (OPAL_UNLIKELY(OMPI_SUCCESS != res)) {
+        OBJ_RELEASE(schedule);
+        return res;
+      }
+    }
 
-  if (!inplace && sendcounts[rank] != 0) {
-    rbuf = (char *) recvbuf + rdispls[rank] * rcvext;
-    sbuf = (char *) sendbuf + sdispls[rank] * sndext;
-    res = NBC_Sched_copy (sbuf, false, sendcounts[rank], sendtype,
-                          rbuf, false, recvcounts[rank], recvtype, schedule, false);
+    if (inplace) {
+      res = a2av_sched_inplace(rank, p, schedule, recvbuf, recvcounts,
+                                   rdispls, rcvext, recvtype, gap);
+    } else {
+      res = a2av_sched_linear(rank, p, schedule,
+                              sendbuf, sendcounts, sdispls, sndext, sendtype,
+                              recvbuf, recvcounts, rdispls, rcvext, recvtype);
+    }
     if (OPAL_UNLIKELY(OMPI_SUCCESS != res)) {
       OBJ_RELEASE(schedule);
+      free(tmpbuf);
       return res;
     }
-  }
 
-  if (inplace) {
-    res = a2av_sched_inplace(rank, p, schedule, recvbuf, recvcounts,
-                                 rdispls, rcvext, recvtype, gap);
-  } else {
-    res = a2av_sched_linear(rank, p, schedule,
-                            sendbuf, sendcounts, sdispls, sndext, sendtype,
-                            recvbuf, recvcounts, rdispls, rcvext, recvtype);
-  }
-  if (OPAL_UNLIKELY(OMPI_SUCCESS != res)) {
-    OBJ_RELEASE(schedule);
-    free(tmpbuf);
-    return res;
-  }
+    res = NBC_Sched_commit (schedule);
+    if (OPAL_UNLIKELY(OMPI_SUCCESS != res)) {
+      OBJ_RELEASE(schedule);
+      free(tmpbuf);
+      return res;
+    }
 
-  res = NBC_Sched_commit (schedule);
-  if (OPAL_UNLIKELY(OMPI_SUCCESS != res)) {
-    OBJ_RELEASE(schedule);
-    free(tmpbuf);
-    return res;
+    NBC_Schedule_cache_insert(libnbc_module, schedule, tmpbuf);
   }
 
   res = NBC_Schedule_request(schedule, comm, libnbc_module, persistent, request, tmpbuf);
   if (OPAL_UNLIKELY(OMPI_SUCCESS != res)) {
+    if (tmpbuf != schedule->tmpbuf) {
+      free(tmpbuf);
+    }
     OBJ_RELEASE(schedule);
-    free(tmpbuf);
     return res;
   }
 
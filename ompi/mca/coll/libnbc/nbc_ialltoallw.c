@@ -36,9 +36,8 @@ static inline int a2aw_sched_inplace(int rank, int p, NBC_Schedule *schedule,
                                     void *buf, const int *counts, const int *displs,
                                     struct ompi_datatype_t * const * types);
 
-/* an alltoallw schedule can not be cached easily because the contents
- * ot the recvcounts array may change, so a comparison of the address
- * would not be sufficient ... we simply do not cache it */
+/* the count, displacement and datatype arrays are part of the schedule
+ * cache key, not only their addresses */
 
 /* simple linear Alltoallw */
 static int nbc_alltoallw_init(const void* sendbuf, const int *sendcounts, const int *sdispls,
@@ -91,41 +90,62 @@ static int nbc_alltoallw_init(const void* sendbuf, const int *sendcounts, const
     return OMPI_ERR_OUT_OF_RESOURCE;
   }
 
-  if (!inplace && sendcounts[rank] != 0) {
-    rbuf = (char *) recvbuf + rdispls[rank];
-    sbuf = (char *) sendbuf + sdispls[rank];
-    res = NBC_Sched_copy(sbuf, false, sendcounts[rank], sendtypes[rank],
-                         rbuf, false, recvcounts[rank], recvtypes[rank], schedule, false);
+  NBC_Sched_key(schedule, &sendbuf, sizeof(sendbuf));
+  if (!inplace) {
+    NBC_Sched_key(schedule, sendcounts, p * sizeof(*sendcounts));
+    NBC_Sched_key(schedule, sdispls, p * sizeof(*sdispls));
+    for (int i = 0; i < p; i++) {
+      NBC_Sched_key_object(schedule, sendtypes[i]);
+    }
+  }
+  NBC_Sched_key(schedule, &recvbuf, sizeof(recvbuf));
+  NBC_Sched_key(schedule, recvcounts, p * sizeof(*recvcounts));
+  NBC_Sched_key(schedule, rdispls, p * sizeof(*rdispls));
+  for (int i = 0; i < p; i++) {
+    NBC_Sched_key_object(schedule, recvtypes[i]);
+  }
+
+  if (!NBC_Schedule_cache_lookup(libnbc_module, NBC_ALLTOALLW, &schedule, &tmpbuf)) {
+    if (!inplace && sendcounts[rank] != 0) {
+      rbuf = (char *) recvbuf + rdispls[rank];
+      sbuf = (char *) sendbuf + sdispls[rank];
+      res = NBC_Sched_copy(sbuf, false, sendcounts[rank], sendtypes[rank],
+                           rbuf, false, recvcounts[rank], recvtypes[rank], schedule, false);
+      if (OPAL_UNLIKELY(OMPI_SUCCESS != res)) {
+        return res;
+      }
+    }
+
+    if (inplace) {
+      res = a2aw_sched_inplace(rank, p, schedule, recvbuf,
+                                   recvcounts, rdispls, recvtypes);
+    } else {
+      res = a2aw_sched_linear(rank, p, schedule,
+                              sendbuf, sendcounts, sdispls, sendtypes,
+                              recvbuf, recvcounts, rdispls, recvtypes);
+    }
     if (OPAL_UNLIKELY(OMPI_SUCCESS != res)) {
+      OBJ_RELEASE(schedule);
+      free(tmpbuf);
       return res;
     }
-  }
 
-  if (inplace) {
-    res = a2aw_sched_inplace(rank, p, schedule, recvbuf,
-                                 recvcounts, rdispls, recvtypes);
-  } else {
-    res = a2aw_sched_linear(rank, p, schedule,
-                            sendbuf, sendcounts, sdispls, sendtypes,
-                            recvbuf, recvcounts, rdispls, recvtypes);
-  }
-  if (OPAL_UNLIKELY(OMPI_SUCCESS != res)) {
-    OBJ_RELEASE(schedule);
-    free(tmpbuf);
-    return res;
-  }
+    res = NBC_Sched_commit (schedule);
+    if (OPAL_UNLIKELY(OMPI_SUCCESS != res)) {
+      OBJ_RELEASE(schedule);
+      free(tmpbuf);
+      return res;
+    }
 
-  res = NBC_Sched_commit (schedule);
-  if (OPAL_UNLIKELY(OMPI_SUCCESS != res)) {
-    OBJ_RELEASE(schedule);
-    free(tmpbuf);
-    return res;
+    NBC_Schedule_cache_insert(libnbc_module, schedule, tmpbuf);
   }
 
   res = NBC_Schedule_request(schedule, comm, libnbc_module, persistent, request, tmpbuf);
   if (OPAL_UNLIKELY(OMPI_SUCCESS != res)) {
+    if (tmpbuf != schedule->tmpbuf) {
+      free(tmpbuf);
+    }
     OBJ_RELEASE(schedule);
-    free(tmpbuf);
     return res;
   }
 
@@ -32,19 +32,15 @@ static int nbc_barrier_init(struct ompi_communicator_t *comm, ompi_request_t **
   rank = ompi_comm_rank (comm);
   p = ompi_comm_size (comm);
 
-#ifdef NBC_CACHE_SCHEDULE
-  /* there only one argument set per communicator -> hang it directly at
-   * the tree-position, NBC_Dict_size[...] is 0 for not initialized and
-   * 1 for initialized. NBC_Dict[...] is a pointer to the schedule in
-   * this case */
-  if (libnbc_module->NBC_Dict_size[NBC_BARRIER] == 0) {
-    /* we did not init it yet */
-#endif
-    schedule = OBJ_NEW(NBC_Schedule);
-    if (OPAL_UNLIKELY(NULL == schedule)) {
-      return OMPI_ERR_OUT_OF_RESOURCE;
-    }
+  schedule = OBJ_NEW(NBC_Schedule);
+  if (OPAL_UNLIKELY(NULL == schedule)) {
+    return OMPI_ERR_OUT_OF_RESOURCE;
+  }
+
+  /* the schedule only depends on the communicator */
+  NBC_Sched_key(schedule, &p, sizeof(p));
 
+  if (!NBC_Schedule_cache_lookup(libnbc_module, NBC_BARRIER, &schedule, NULL)) {
     maxround = (int)ceil((log((double)p)/LOG2)-1);
 
     for (int round = 0 ; round <= maxround ; ++round) {
@@ -82,13 +78,8 @@ static int nbc_barrier_init(struct ompi_communicator_t *comm, ompi_request_t **
       return res;
     }
 
-#ifdef NBC_CACHE_SCHEDULE
-    /* add it */
-    libnbc_module->NBC_Dict[NBC_BARRIER] = (hb_tree *) schedule;
-    libnbc_module->NBC_Dict_size[NBC_BARRIER] = 1;
+    NBC_Schedule_cache_insert(libnbc_module, schedule, NULL);
   }
-  OBJ_RETAIN(schedule);
-#endif
 
   res = NBC_Schedule_request(schedule, comm, libnbc_module, persistent, request, NULL);
   if (OPAL_UNLIKELY(OMPI_SUCCESS != res)) {
@@ -24,10 +24,8 @@
  */
 #include "nbc_internal.h"
 
-/* an gatherv schedule can not be cached easily because the contents
- * ot the recvcounts array may change, so a comparison of the address
- * would not be sufficient ... we simply do not cache it */
-
+/* the recvcounts and displs arrays are part of the schedule cache key,
+ * not only their addresses */
 
 static int nbc_gatherv_init(const void* sendbuf, int sendcount, MPI_Datatype sendtype,
                             void* recvbuf, const int *recvcounts, const int *displs, MPI_Datatype recvtype,
@@ -58,42 +56,59 @@ static int nbc_gatherv_init(const void* sendbuf, int sendcount, MPI_Datatype sen
     return OMPI_ERR_OUT_OF_RESOURCE;
   }
 
-  /* send to root */
-  if (rank != root) {
-    /* send msg to root */
-    res = NBC_Sched_send (sendbuf, false, sendcount, sendtype, root, schedule, false);
-    if (OPAL_UNLIKELY(OMPI_SUCCESS != res)) {
-      OBJ_RELEASE(schedule);
-      return res;
-    }
-  } else {
-    for (int i = 0 ; i < p ; ++i) {
-      rbuf = (char *) recvbuf + displs[i] * rcvext;
-      if (i == root) {
-        if (!inplace) {
-          /* if I am the root - just copy the message */
-          res = NBC_Sched_copy ((void *)sendbuf, false, sendcount, sendtype,
-                                rbuf, false, recvcounts[i], recvtype, schedule, false);
+  NBC_Sched_key(schedule, &root, sizeof(root));
+  NBC_Sched_key(schedule, &sendbuf, sizeof(sendbuf));
+  if (!inplace) {
+    NBC_Sched_key(schedule, &sendcount, sizeof(sendcount));
+    NBC_Sched_key_object(schedule, sendtype);
+  }
+  if (rank == root) {
+    NBC_Sched_key(schedule, &recvbuf, sizeof(recvbuf));
+    NBC_Sched_key(schedule, recvcounts, p * sizeof(*recvcounts));
+    NBC_Sched_key(schedule, displs, p * sizeof(*displs));
+    NBC_Sched_key_object(schedule, recvtype);
+  }
+
+  if (!NBC_Schedule_cache_lookup(libnbc_module, NBC_GATHERV, &schedule, NULL)) {
+    /* send to root */
+    if (rank != root) {
+      /* send msg to root */
+      res = NBC_Sched_send (sendbuf, false, sendcount, sendtype, root, schedule, false);
+      if (OPAL_UNLIKELY(OMPI_SUCCESS != res)) {
+        OBJ_RELEASE(schedule);
+        return res;
+      }
+    } else {
+      for (int i = 0 ; i < p ; ++i) {
+        rbuf = (char *) recvbuf + displs[i] * rcvext;
+        if (i == root) {
+          if (!inplace) {
+            /* if I am the root - just copy the message */
+            res = NBC_Sched_copy ((void *)sendbuf, false, sendcount, sendtype,
+                                  rbuf, false, recvcounts[i], recvtype, schedule, false);
+            if (OPAL_UNLIKELY(OMPI_SUCCESS != res)) {
+              OBJ_RELEASE(schedule);
+              return res;
+            }
+          }
+        } else {
+          /* root receives message to the right buffer */
+          res = NBC_Sched_recv (rbuf, false, recvcounts[i], recvtype, i, schedule, false);
           if (OPAL_UNLIKELY(OMPI_SUCCESS != res)) {
             OBJ_RELEASE(schedule);
             return res;
           }
         }
-      } else {
-        /* root receives message to the right buffer */
-        res = NBC_Sched_recv (rbuf, false, recvcounts[i], recvtype, i, schedule, false);
-        if (OPAL_UNLIKELY(OMPI_SUCCESS != res)) {
-          OBJ_RELEASE(schedule);
-          return res;
-        }
       }
     }
-  }
 
-  res = NBC_Sched_commit (schedule);
-  if (OPAL_UNLIKELY(OMPI_SUCCESS != res)) {
-    OBJ_RELEASE(schedule);
-    return res;
+    res = NBC_Sched_commit (schedule);
+    if (OPAL_UNLIKELY(OMPI_SUCCESS != res)) {
+      OBJ_RELEASE(schedule);
+      return res;
+    }
+
+    NBC_Schedule_cache_insert(libnbc_module, schedule, NULL);
   }
 
   res = NBC_Schedule_request(schedule, comm, libnbc_module, persistent, request, NULL);
@@ -44,7 +44,6 @@
 #include <assert.h>
 #include <math.h>
 #include <string.h>
-#include "libdict/dict.h"
 
 #ifdef __cplusplus
 extern "C" {
@@ -74,7 +73,12 @@ extern "C" {
 #define NBC_SCAN 13
 #define NBC_SCATTER 14
 #define NBC_SCATTERV 15
-/* set the number of collectives in nbc.h !!!! */
+#define NBC_REDUCESCATBLOCK 16
+#define NBC_NEIGHBOR_ALLGATHER 17
+#define NBC_NEIGHBOR_ALLGATHERV 18
+#define NBC_NEIGHBOR_ALLTOALL 19
+#define NBC_NEIGHBOR_ALLTOALLV 20
+#define NBC_NEIGHBOR_ALLTOALLW 21
 
 /* several typedefs for NBC */
 
@@ -160,106 +164,17 @@ int NBC_Sched_unpack (void *inbuf, char tmpinbuf, int count, MPI_Datatype dataty
 int NBC_Sched_barrier (NBC_Schedule *schedule);
 int NBC_Sched_commit (NBC_Schedule *schedule);
 
-#ifdef NBC_CACHE_SCHEDULE
-/* this is a dummy structure which is used to get the schedule out of
- * the collop specific structure. The schedule pointer HAS to be at the
- * first position and should NOT BE REORDERED by the compiler (C
- * guarantees that */
-struct NBC_dummyarg {
-  NBC_Schedule *schedule;
-};
-
-typedef struct {
-  NBC_Schedule *schedule;
-  void *sendbuf;
-  int sendcount;
-  MPI_Datatype sendtype;
-  void* recvbuf;
-  int recvcount;
-  MPI_Datatype recvtype;
-} NBC_Alltoall_args;
-int NBC_Alltoall_args_compare(NBC_Alltoall_args *a, NBC_Alltoall_args *b, void *param);
-
-typedef struct {
-  NBC_Schedule *schedule;
-  void *sendbuf;
-  int sendcount;
-  MPI_Datatype sendtype;
-  void* recvbuf;
-  int recvcount;
-  MPI_Datatype recvtype;
-} NBC_Allgather_args;
-int NBC_Allgather_args_compare(NBC_Allgather_args *a, NBC_Allgather_args *b, void *param);
-
-typedef struct {
-  NBC_Schedule *schedule;
-  void *sendbuf;
-  void* recvbuf;
-  int count;
-  MPI_Datatype datatype;
-  MPI_Op op;
-} NBC_Allreduce_args;
-int NBC_Allreduce_args_compare(NBC_Allreduce_args *a, NBC_Allreduce_args *b, void *param);
-
-typedef struct {
-  NBC_Schedule *schedule;
-  void *buffer;
-  int count;
-  MPI_Datatype datatype;
-  int root;
-} NBC_Bcast_args;
-int NBC_Bcast_args_compare(NBC_Bcast_args *a, NBC_Bcast_args *b, void *param);
-
-typedef struct {
-  NBC_Schedule *schedule;
-  void *sendbuf;
-  int sendcount;
-  MPI_Datatype sendtype;
-  void* recvbuf;
-  int recvcount;
-  MPI_Datatype recvtype;
-  int root;
-} NBC_Gather_args;
-int NBC_Gather_args_compare(NBC_Gather_args *a, NBC_Gather_args *b, void *param);
-
-typedef struct {
-  NBC_Schedule *schedule;
-  void *sendbuf;
-  void* recvbuf;
-  int count;
-  MPI_Datatype datatype;
-  MPI_Op op;
-  int root;
-} NBC_Reduce_args;
-int NBC_Reduce_args_compare(NBC_Reduce_args *a, NBC_Reduce_args *b, void *param);
-
-typedef struct {
-  NBC_Schedule *schedule;
-  void *sendbuf;
-  void* recvbuf;
-  int count;
-  MPI_Datatype datatype;
-  MPI_Op op;
-} NBC_Scan_args;
-int NBC_Scan_args_compare(NBC_Scan_args *a, NBC_Scan_args *b, void *param);
-
-typedef struct {
-  NBC_Schedule *schedule;
-  void *sendbuf;
-  int sendcount;
-  MPI_Datatype sendtype;
-  void* recvbuf;
-  int recvcount;
-  MPI_Datatype recvtype;
-  int root;
-} NBC_Scatter_args;
-int NBC_Scatter_args_compare(NBC_Scatter_args *a, NBC_Scatter_args *b, void *param);
-
-/* Schedule cache structures/functions */
-void NBC_SchedCache_args_delete(void *entry);
-void NBC_SchedCache_args_delete_key_dummy(void *k);
-
-#endif
+/* schedule cache: a schedule is looked up with the collective and every
+ * argument it depends on. The key is built on the schedule before it is
+ * filled, NBC_Schedule_cache_lookup() then either swaps in a cached copy or
+ * lets the caller build it and NBC_Schedule_cache_insert() it. A schedule
+ * with an empty key is never cached. The temporary buffer of a cached
+ * schedule is owned by the schedule. */
+void NBC_Sched_key (NBC_Schedule *schedule, const void *data, size_t size);
+void NBC_Sched_key_object (NBC_Schedule *schedule, void *object);
+bool NBC_Schedule_cache_lookup (NBC_Comminfo *comminfo, int coll, NBC_Schedule **schedule, void **tmpbuf);
+void NBC_Schedule_cache_insert (NBC_Comminfo *comminfo, NBC_Schedule *schedule, void *tmpbuf);
+void NBC_Schedule_cache_wipe (NBC_Comminfo *comminfo);
 
 
 int NBC_Start(NBC_Handle *handle);
@@ -549,18 +464,6 @@ static inline int NBC_Unpack(void *src, int srccount, MPI_Datatype srctype, void
   return OMPI_SUCCESS;
 }
 
-/* deletes elements from dict_in until low watermark is reached */
-static inline void NBC_SchedCache_dictwipe(hb_tree *dict_in, int *size) {
-  hb_itor *itor;
-
-  itor = hb_itor_new(dict_in);
-  for (; hb_itor_valid(itor) && (*size>NBC_SCHED_DICT_LOWER); hb_itor_next(itor)) {
-    hb_tree_remove(dict_in, hb_itor_key(itor), 0);
-    *size = *size-1;
-  }
-  hb_itor_destroy(itor);
-}
-
 #define NBC_IN_PLACE(sendbuf, recvbuf, inplace) \
 { \
   inplace = 0; \
@@ -25,9 +25,8 @@
 
 #include "nbc_internal.h"
 
-/* an reduce_csttare schedule can not be cached easily because the contents
- * ot the recvcounts array may change, so a comparison of the address
- * would not be sufficient ... we simply do not cache it */
+/* the recvcounts array is part of the schedule cache key, not only its
+ * address */
 
 /* binomial reduce to rank 0 followed by a linear scatter ...
  *
@@ -100,109 +99,121 @@ static int nbc_reduce_scatter_init(const void* sendbuf, void* recvbuf, const int
     return OMPI_ERR_OUT_OF_RESOURCE;
   }
 
-  for (int r = 1, firstred = 1 ; r <= maxr ; ++r) {
-    if ((rank % (1 << r)) == 0) {
-      /* we have to receive this round */
-      peer = rank + (1 << (r - 1));
-      if (peer < p) {
-        /* we have to wait until we have the data */
-        res = NBC_Sched_recv(rbuf, true, count, datatype, peer, schedule, true);
+  NBC_Sched_key(schedule, &sendbuf, sizeof(sendbuf));
+  NBC_Sched_key(schedule, &recvbuf, sizeof(recvbuf));
+  NBC_Sched_key(schedule, recvcounts, p * sizeof(*recvcounts));
+  NBC_Sched_key_object(schedule, datatype);
+  NBC_Sched_key_object(schedule, op);
+
+  if (!NBC_Schedule_cache_lookup(libnbc_module, NBC_REDUCESCAT, &schedule, &tmpbuf)) {
+    for (int r = 1, firstred = 1 ; r <= maxr ; ++r) {
+      if ((rank % (1 << r)) == 0) {
+        /* we have to receive this round */
+        peer = rank + (1 << (r - 1));
+        if (peer < p) {
+          /* we have to wait until we have the data */
+          res = NBC_Sched_recv(rbuf, true, count, datatype, peer, schedule, true);
+          if (OPAL_UNLIKELY(OMPI_SUCCESS != res)) {
+            OBJ_RELEASE(schedule);
+            free(tmpbuf);
+            return res;
+          }
+
+          /* this cannot be done until tmpbuf is unused :-( so barrier after the op */
+          if (firstred) {
+            /* take reduce data from the sendbuf in the first round -> save copy */
+            res = NBC_Sched_op (sendbuf, false, rbuf, true, count, datatype, op, schedule, true);
+            firstred = 0;
+          } else {
+            /* perform the reduce in my local buffer */
+            res = NBC_Sched_op (lbuf, true, rbuf, true, count, datatype, op, schedule, true);
+          }
+
+          if (OPAL_UNLIKELY(OMPI_SUCCESS != res)) {
+            OBJ_RELEASE(schedule);
+            free(tmpbuf);
+            return res;
+          }
+          /* swap left and right buffers */
+          buf = rbuf; rbuf = lbuf ; lbuf = buf;
+        }
+      } else {
+        /* we have to send this round */
+        peer = rank - (1 << (r - 1));
+        if (firstred) {
+          /* we have to send the senbuf */
+          res = NBC_Sched_send (sendbuf, false, count, datatype, peer, schedule, false);
+        } else {
+          /* we send an already reduced value from lbuf */
+          res = NBC_Sched_send (lbuf, true, count, datatype, peer, schedule, false);
+        }
         if (OPAL_UNLIKELY(OMPI_SUCCESS != res)) {
           OBJ_RELEASE(schedule);
           free(tmpbuf);
           return res;
         }
 
-        /* this cannot be done until tmpbuf is unused :-( so barrier after the op */
-        if (firstred) {
-          /* take reduce data from the sendbuf in the first round -> save copy */
-          res = NBC_Sched_op (sendbuf, false, rbuf, true, count, datatype, op, schedule, true);
-          firstred = 0;
-        } else {
-          /* perform the reduce in my local buffer */
-          res = NBC_Sched_op (lbuf, true, rbuf, true, count, datatype, op, schedule, true);
-        }
+        /* leave the game */
+        break;
+      }
+    }
+
+    res = NBC_Sched_barrier(schedule);
+    if (OPAL_UNLIKELY(OMPI_SUCCESS != res)) {
+      OBJ_RELEASE(schedule);
+      free(tmpbuf);
+      return res;
+    }
 
+    /* rank 0 is root and sends - all others receive */
+    if (rank == 0) {
+      for (long int r = 1, offset = 0 ; r < p ; ++r) {
+        offset += recvcounts[r-1];
+        sbuf = lbuf + (offset*ext);
+        /* root sends the right buffer to the right receiver */
+        res = NBC_Sched_send (sbuf, true, recvcounts[r], datatype, r, schedule,
+                              false);
         if (OPAL_UNLIKELY(OMPI_SUCCESS != res)) {
           OBJ_RELEASE(schedule);
           free(tmpbuf);
           return res;
         }
-        /* swap left and right buffers */
-        buf = rbuf; rbuf = lbuf ; lbuf = buf;
       }
-    } else {
-      /* we have to send this round */
-      peer = rank - (1 << (r - 1));
-      if (firstred) {
-        /* we have to send the senbuf */
-        res = NBC_Sched_send (sendbuf, false, count, datatype, peer, schedule, false);
+
+      if (p == 1) {
+        /* single node not in_place: copy data to recvbuf */
+        res = NBC_Sched_copy ((void *)sendbuf, false, recvcounts[0], datatype,
+                              recvbuf, false, recvcounts[0], datatype, schedule, false);
       } else {
-        /* we send an already reduced value from lbuf */
-        res = NBC_Sched_send (lbuf, true, count, datatype, peer, schedule, false);
-      }
-      if (OPAL_UNLIKELY(OMPI_SUCCESS != res)) {
-        OBJ_RELEASE(schedule);
-        free(tmpbuf);
-        return res;
+        res = NBC_Sched_copy (lbuf, true, recvcounts[0], datatype, recvbuf, false,
+                              recvcounts[0], datatype, schedule, false);
       }
-
-      /* leave the game */
-      break;
+    } else {
+      res = NBC_Sched_recv (recvbuf, false, recvcounts[rank], datatype, 0, schedule, false);
     }
-  }
-
-  res = NBC_Sched_barrier(schedule);
-  if (OPAL_UNLIKELY(OMPI_SUCCESS != res)) {
-    OBJ_RELEASE(schedule);
-    free(tmpbuf);
-    return res;
-  }
 
-  /* rank 0 is root and sends - all others receive */
-  if (rank == 0) {
-    for (long int r = 1, offset = 0 ; r < p ; ++r) {
-      offset += recvcounts[r-1];
-      sbuf = lbuf + (offset*ext);
-      /* root sends the right buffer to the right receiver */
-      res = NBC_Sched_send (sbuf, true, recvcounts[r], datatype, r, schedule,
-                            false);
-      if (OPAL_UNLIKELY(OMPI_SUCCESS != res)) {
-        OBJ_RELEASE(schedule);
-        free(tmpbuf);
-        return res;
-      }
+    if (OPAL_UNLIKELY(OMPI_SUCCESS != res)) {
+      OBJ_RELEASE(schedule);
+      free(tmpbuf);
+      return res;
     }
 
-    if (p == 1) {
-      /* single node not in_place: copy data to recvbuf */
-      res = NBC_Sched_copy ((void *)sendbuf, false, recvcounts[0], datatype,
-                            recvbuf, false, recvcounts[0], datatype, schedule, false);
-    } else {
-      res = NBC_Sched_copy (lbuf, true, recvcounts[0], datatype, recvbuf, false,
-                            recvcounts[0], datatype, schedule, false);
+    res = NBC_Sched_commit (schedule);
+    if (OPAL_UNLIKELY(OMPI_SUCCESS != res)) {
+      OBJ_RELEASE(schedule);
+      free(tmpbuf);
+      return res;
     }
-  } else {
-    res = NBC_Sched_recv (recvbuf, false, recvcounts[rank], datatype, 0, schedule, false);
-  }
 
-  if (OPAL_UNLIKELY(OMPI_SUCCESS != res)) {
-    OBJ_RELEASE(schedule);
-    free(tmpbuf);
-    return res;
-  }
-
-  res = NBC_Sched_commit (schedule);
-  if (OPAL_UNLIKELY(OMPI_SUCCESS != res)) {
-    OBJ_RELEASE(schedule);
-    free(tmpbuf);
-    return res;
+    NBC_Schedule_cache_insert(libnbc_module, schedule, tmpbuf);
   }
 
   res = NBC_Schedule_request(schedule, comm, libnbc_module, persistent, request, tmpbuf);
   if (OPAL_UNLIKELY(OMPI_SUCCESS != res)) {
+    if (tmpbuf != schedule->tmpbuf) {
+      free(tmpbuf);
+    }
     OBJ_RELEASE(schedule);
-    free(tmpbuf);
     return res;
   }
 
@@ -23,10 +23,6 @@
 
 #include "nbc_internal.h"
 
-/* an reduce_csttare schedule can not be cached easily because the contents
- * ot the recvcount value may change, so a comparison of the address
- * would not be sufficient ... we simply do not cache it */
-
 /* binomial reduce to rank 0 followed by a linear scatter ...
  *
  * Algorithm:
@@ -45,7 +41,7 @@ static int nbc_reduce_scatter_block_init(const void* sendbuf, void* recvbuf, int
                                          mca_coll_base_module_t *module, bool persistent) {
   int peer, rank, maxr, p, res, count;
   MPI_Aint ext;
-  ptrdiff_t gap, span;
+  ptrdiff_t gap, span, span_align;
   char *redbuf, *sbuf, inplace;
   NBC_Schedule *schedule;
   void *tmpbuf = NULL;
@@ -62,145 +58,158 @@ static int nbc_reduce_scatter_block_init(const void* sendbuf, void* recvbuf, int
     return (MPI_SUCCESS == res) ? MPI_ERR_SIZE : res;
   }
 
-  schedule = OBJ_NEW(NBC_Schedule);
-  if (NULL == schedule) {
-    return OMPI_ERR_OUT_OF_RESOURCE;
-  }
-
   maxr = (int)ceil((log((double)p)/LOG2));
 
   count = p * recvcount;
 
   if (0 < count) {
-    char *rbuf, *lbuf, *buf;
-    ptrdiff_t span_align;
-
     span = opal_datatype_span(&datatype->super, count, &gap);
     span_align = OPAL_ALIGN(span, datatype->super.align, ptrdiff_t);
     tmpbuf = malloc (span_align + span);
     if (NULL == tmpbuf) {
-      OBJ_RELEASE(schedule);
       return OMPI_ERR_OUT_OF_RESOURCE;
     }
+  }
 
-    rbuf = (void *)(-gap);
-    lbuf = (char *)(span_align - gap);
-    redbuf = (char *) tmpbuf + span_align - gap;
+  schedule = OBJ_NEW(NBC_Schedule);
+  if (NULL == schedule) {
+    free(tmpbuf);
+    return OMPI_ERR_OUT_OF_RESOURCE;
+  }
 
-    /* copy data to redbuf if we only have a single node */
-    if ((p == 1) && !inplace) {
-      res = NBC_Sched_copy ((void *)sendbuf, false, count, datatype,
-                            redbuf, false, count, datatype, schedule, false);
-      if (OMPI_SUCCESS != res) {
-        OBJ_RELEASE(schedule);
-        free(tmpbuf);
-        return res;
+  NBC_Sched_key(schedule, &sendbuf, sizeof(sendbuf));
+  NBC_Sched_key(schedule, &recvbuf, sizeof(recvbuf));
+  NBC_Sched_key(schedule, &recvcount, sizeof(recvcount));
+  NBC_Sched_key_object(schedule, datatype);
+  NBC_Sched_key_object(schedule, op);
+
+  if (!NBC_Schedule_cache_lookup(libnbc_module, NBC_REDUCESCATBLOCK, &schedule, &tmpbuf)) {
+    if (0 < count) {
+      char *rbuf, *lbuf, *buf;
+
+      rbuf = (void *)(-gap);
+      lbuf = (char *)(span_align - gap);
+      redbuf = (char *) tmpbuf + span_align - gap;
+
+      /* copy data to redbuf if we only have a single node */
+      if ((p == 1) && !inplace) {
+        res = NBC_Sched_copy ((void *)sendbuf, false, count, datatype,
+                              redbuf, false, count, datatype, schedule, false);
+        if (OMPI_SUCCESS != res) {
+          OBJ_RELEASE(schedule);
+          free(tmpbuf);
+          return res;
+        }
       }
-    }
 
-    for (int r = 1, firstred = 1 ; r <= maxr; ++r) {
-      if ((rank % (1 << r)) == 0) {
-        /* we have to receive this round */
-        peer = rank + (1 << (r - 1));
-        if (peer < p) {
-          /* we have to wait until we have the data */
-          res = NBC_Sched_recv (rbuf, true, count, datatype, peer, schedule, true);
+      for (int r = 1, firstred = 1 ; r <= maxr; ++r) {
+        if ((rank % (1 << r)) == 0) {
+          /* we have to receive this round */
+          peer = rank + (1 << (r - 1));
+          if (peer < p) {
+            /* we have to wait until we have the data */
+            res = NBC_Sched_recv (rbuf, true, count, datatype, peer, schedule, true);
+            if (OPAL_UNLIKELY(OMPI_SUCCESS != res)) {
+              OBJ_RELEASE(schedule);
+              free(tmpbuf);
+              return res;
+            }
+
+            if (firstred) {
+              /* take reduce data from the sendbuf in the first round -> save copy */
+              res = NBC_Sched_op (sendbuf, false, rbuf, true, count, datatype, op, schedule, true);
+              firstred = 0;
+            } else {
+            /* perform the reduce in my local buffer */
+              res = NBC_Sched_op (lbuf, true, rbuf, true, count, datatype, op, schedule, true);
+            }
+
+            if (OPAL_UNLIKELY(OMPI_SUCCESS != res)) {
+              OBJ_RELEASE(schedule);
+              free(tmpbuf);
+              return res;
+            }
+            /* swap left and right buffers */
+            buf = rbuf; rbuf = lbuf ; lbuf = buf;
+          }
+        } else {
+          /* we have to send this round */
+          peer = rank - (1 << (r - 1));
+          if(firstred) {
+            /* we have to send the senbuf */
+            res = NBC_Sched_send (sendbuf, false, count, datatype, peer, schedule, false);
+          } else {
+            /* we send an already reduced value from redbuf */
+            res = NBC_Sched_send (lbuf, true, count, datatype, peer, schedule, false);
+          }
+
           if (OPAL_UNLIKELY(OMPI_SUCCESS != res)) {
             OBJ_RELEASE(schedule);
             free(tmpbuf);
             return res;
           }
 
-          if (firstred) {
-            /* take reduce data from the sendbuf in the first round -> save copy */
-            res = NBC_Sched_op (sendbuf, false, rbuf, true, count, datatype, op, schedule, true);
-            firstred = 0;
-          } else {
-          /* perform the reduce in my local buffer */
-            res = NBC_Sched_op (lbuf, true, rbuf, true, count, datatype, op, schedule, true);
-          }
+          /* leave the game */
+          break;
+        }
+      }
 
+      res = NBC_Sched_barrier(schedule);
+      if (OPAL_UNLIKELY(OMPI_SUCCESS != res)) {
+        OBJ_RELEASE(schedule);
+        free(tmpbuf);
+        return res;
+      }
+
+      /* rank 0 is root and sends - all others receive */
+      if (rank != 0) {
+        res = NBC_Sched_recv (recvbuf, false, recvcount, datatype, 0, schedule, false);
+        if (OPAL_UNLIKELY(OMPI_SUCCESS != res)) {
+          OBJ_RELEASE(schedule);
+          free(tmpbuf);
+          return res;
+        }
+      } else {
+        for (int r = 1, offset = 0 ; r < p ; ++r) {
+          offset += recvcount;
+          sbuf = lbuf + (offset*ext);
+          /* root sends the right buffer to the right receiver */
+          res = NBC_Sched_send (sbuf, true, recvcount, datatype, r, schedule, false);
           if (OPAL_UNLIKELY(OMPI_SUCCESS != res)) {
             OBJ_RELEASE(schedule);
             free(tmpbuf);
             return res;
           }
-          /* swap left and right buffers */
-          buf = rbuf; rbuf = lbuf ; lbuf = buf;
-        }
-      } else {
-        /* we have to send this round */
-        peer = rank - (1 << (r - 1));
-        if(firstred) {
-          /* we have to send the senbuf */
-          res = NBC_Sched_send (sendbuf, false, count, datatype, peer, schedule, false);
-        } else {
-          /* we send an already reduced value from redbuf */
-          res = NBC_Sched_send (lbuf, true, count, datatype, peer, schedule, false);
         }
 
+        if ((p != 1) || !inplace) {
+          res = NBC_Sched_copy (lbuf, true, recvcount, datatype, recvbuf, false, recvcount,
+                                datatype, schedule, false);
+        }
         if (OPAL_UNLIKELY(OMPI_SUCCESS != res)) {
           OBJ_RELEASE(schedule);
           free(tmpbuf);
           return res;
         }
-
-        /* leave the game */
-        break;
       }
     }
 
-    res = NBC_Sched_barrier(schedule);
+    res = NBC_Sched_commit (schedule);
     if (OPAL_UNLIKELY(OMPI_SUCCESS != res)) {
       OBJ_RELEASE(schedule);
       free(tmpbuf);
       return res;
     }
 
-    /* rank 0 is root and sends - all others receive */
-    if (rank != 0) {
-      res = NBC_Sched_recv (recvbuf, false, recvcount, datatype, 0, schedule, false);
-      if (OPAL_UNLIKELY(OMPI_SUCCESS != res)) {
-        OBJ_RELEASE(schedule);
-        free(tmpbuf);
-        return res;
-      }
-    } else {
-      for (int r = 1, offset = 0 ; r < p ; ++r) {
-        offset += recvcount;
-        sbuf = lbuf + (offset*ext);
-        /* root sends the right buffer to the right receiver */
-        res = NBC_Sched_send (sbuf, true, recvcount, datatype, r, schedule, false);
-        if (OPAL_UNLIKELY(OMPI_SUCCESS != res)) {
-          OBJ_RELEASE(schedule);
-          free(tmpbuf);
-          return res;
-        }
-      }
-
-      if ((p != 1) || !inplace) {
-        res = NBC_Sched_copy (lbuf, true, recvcount, datatype, recvbuf, false, recvcount,
-                              datatype, schedule, false);
-      }
-      if (OPAL_UNLIKELY(OMPI_SUCCESS != res)) {
-        OBJ_RELEASE(schedule);
-        free(tmpbuf);
-        return res;
-      }
-    }
-  }
-
-  res = NBC_Sched_commit (schedule);
-  if (OPAL_UNLIKELY(OMPI_SUCCESS != res)) {
-    OBJ_RELEASE(schedule);
-    free(tmpbuf);
-    return res;
+    NBC_Schedule_cache_insert(libnbc_module, schedule, tmpbuf);
   }
 
   res = NBC_Schedule_request(schedule, comm, libnbc_module, persistent, request, tmpbuf);
   if (OPAL_UNLIKELY(OMPI_SUCCESS != res)) {
+    if (tmpbuf != schedule->tmpbuf) {
+      free(tmpbuf);
+    }
     OBJ_RELEASE(schedule);
-    free(tmpbuf);
     return res;
   }
 
@@ -32,25 +32,6 @@ static inline int scan_sched_recursivedoubling(
     int count, MPI_Datatype datatype,  MPI_Op op, char inplace,
     NBC_Schedule *schedule, void *tmpbuf1, void *tmpbuf2);
 
-#ifdef NBC_CACHE_SCHEDULE
-/* tree comparison function for schedule cache */
-int NBC_Scan_args_compare(NBC_Scan_args *a, NBC_Scan_args *b, void *param) {
-  if ((a->sendbuf == b->sendbuf) &&
-      (a->recvbuf == b->recvbuf) &&
-      (a->count == b->count) &&
-      (a->datatype == b->datatype) &&
-      (a->op == b->op) ) {
-    return 0;
-  }
-
-  if (a->sendbuf < b->sendbuf) {
-    return -1;
-  }
-
-  return 1;
-}
-#endif
-
 static int nbc_scan_init(const void* sendbuf, void* recvbuf, int count, MPI_Datatype datatype, MPI_Op op,
                          struct ompi_communicator_t *comm, ompi_request_t ** request,
                          mca_coll_base_module_t *module, bool persistent) {
@@ -87,79 +68,49 @@ static int nbc_scan_init(const void* sendbuf, void* recvbuf, int count, MPI_Data
         }
     }
 
-#ifdef NBC_CACHE_SCHEDULE
-  NBC_Scan_args *args, *found, search;
-
-  /* search schedule in communicator specific tree */
-  search.sendbuf = sendbuf;
-  search.recvbuf = recvbuf;
-  search.count = count;
-  search.datatype = datatype;
-  search.op = op;
-  found = (NBC_Scan_args *) hb_tree_search ((hb_tree *) libnbc_module->NBC_Dict[NBC_SCAN], &search);
-  if (NULL == found) {
-#endif
     schedule = OBJ_NEW(NBC_Schedule);
     if (OPAL_UNLIKELY(NULL == schedule)) {
         free(tmpbuf);
         return OMPI_ERR_OUT_OF_RESOURCE;
     }
 
-    if (alg == NBC_SCAN_LINEAR) {
-        res = scan_sched_linear(rank, p, sendbuf, recvbuf, count, datatype,
-                                op, inplace, schedule, tmpbuf);
-    } else {
-        res = scan_sched_recursivedoubling(rank, p, sendbuf, recvbuf, count,
-                                           datatype, op, inplace, schedule, tmpbuf1, tmpbuf2);
-    }
-    if (OPAL_UNLIKELY(OMPI_SUCCESS != res)) {
-        OBJ_RELEASE(schedule);
-        free(tmpbuf);
-        return res;
-    }
-
-    res = NBC_Sched_commit(schedule);
-    if (OPAL_UNLIKELY(OMPI_SUCCESS != res)) {
-        OBJ_RELEASE(schedule);
-        free(tmpbuf);
-        return res;
-    }
-
-#ifdef NBC_CACHE_SCHEDULE
-    /* save schedule to tree */
-    args = (NBC_Scan_args *) malloc (sizeof (args));
-    if (NULL != args) {
-      args->sendbuf = sendbuf;
-      args->recvbuf = recvbuf;
-      args->count = count;
-      args->datatype = datatype;
-      args->op = op;
-      args->schedule = schedule;
-      res = hb_tree_insert ((hb_tree *) libnbc_module->NBC_Dict[NBC_SCAN], args, args, 0);
-      if (0 == res) {
-        OBJ_RETAIN(schedule);
+    NBC_Sched_key(schedule, &alg, sizeof(alg));
+    NBC_Sched_key(schedule, &sendbuf, sizeof(sendbuf));
+    NBC_Sched_key(schedule, &recvbuf, sizeof(recvbuf));
+    NBC_Sched_key(schedule, &count, sizeof(count));
+    NBC_Sched_key_object(schedule, datatype);
+    NBC_Sched_key_object(schedule, op);
+
+    if (!NBC_Schedule_cache_lookup(libnbc_module, NBC_SCAN, &schedule, &tmpbuf)) {
+        if (alg == NBC_SCAN_LINEAR) {
+            res = scan_sched_linear(rank, p, sendbuf, recvbuf, count, datatype,
+                                    op, inplace, schedule, tmpbuf);
+        } else {
+            res = scan_sched_recursivedoubling(rank, p, sendbuf, recvbuf, count,
+                                               datatype, op, inplace, schedule, tmpbuf1, tmpbuf2);
+        }
+        if (OPAL_UNLIKELY(OMPI_SUCCESS != res)) {
+            OBJ_RELEASE(schedule);
+            free(tmpbuf);
+            return res;
+        }
 
-        /* increase number of elements for A2A */
-        if (++libnbc_module->NBC_Dict_size[NBC_SCAN] > NBC_SCHED_DICT_UPPER) {
-          NBC_SchedCache_dictwipe ((hb_tree *) libnbc_module->NBC_Dict[NBC_SCAN],
-                                   &libnbc_module->NBC_Dict_size[NBC_SCAN]);
+        res = NBC_Sched_commit(schedule);
+        if (OPAL_UNLIKELY(OMPI_SUCCESS != res)) {
+            OBJ_RELEASE(schedule);
+            free(tmpbuf);
+            return res;
         }
-      } else {
-        NBC_Error("error in dict_insert() (%i)", res);
-        free (args);
-      }
+
+        NBC_Schedule_cache_insert(libnbc_module, schedule, tmpbuf);
     }
-  } else {
-    /* found schedule */
-    schedule = found->schedule;
-    OBJ_RETAIN(schedule);
-  }
-#endif
 
     res = NBC_Schedule_request(schedule, comm, libnbc_module, persistent, request, tmpbuf);
     if (OPAL_UNLIKELY(OMPI_SUCCESS != res)) {
+        if (tmpbuf != schedule->tmpbuf) {
+            free(tmpbuf);
+        }
         OBJ_RELEASE(schedule);
-        free(tmpbuf);
         return res;
     }
 
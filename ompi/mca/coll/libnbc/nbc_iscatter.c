@@ -23,27 +23,6 @@
  */
 #include "nbc_internal.h"
 
-#ifdef NBC_CACHE_SCHEDULE
-/* tree comparison function for schedule cache */
-int NBC_Scatter_args_compare(NBC_Scatter_args *a, NBC_Scatter_args *b, void *param) {
-    if ((a->sendbuf == b->sendbuf) &&
-        (a->sendcount == b->sendcount) &&
-        (a->sendtype == b->sendtype) &&
-        (a->recvbuf == b->recvbuf) &&
-        (a->recvcount == b->recvcount) &&
-        (a->recvtype == b->recvtype) &&
-        (a->root == b->root)) {
-        return 0;
-    }
-
-    if (a->sendbuf < b->sendbuf) {
-        return -1;
-    }
-
-    return 1;
-}
-#endif
-
 /* simple linear MPI_Iscatter */
 static int nbc_scatter_init (const void* sendbuf, int sendcount, MPI_Datatype sendtype,
                              void* recvbuf, int recvcount, MPI_Datatype recvtype, int root,
@@ -55,7 +34,6 @@ static int nbc_scatter_init (const void* sendbuf, int sendcount, MPI_Datatype se
   char *sbuf, inplace = 0;
   ompi_coll_libnbc_module_t *libnbc_module = (ompi_coll_libnbc_module_t*) module;
 
-
   rank = ompi_comm_rank (comm);
   if (root == rank) {
     NBC_IN_PLACE(sendbuf, recvbuf, inplace);
@@ -70,25 +48,24 @@ static int nbc_scatter_init (const void* sendbuf, int sendcount, MPI_Datatype se
     }
   }
 
-#ifdef NBC_CACHE_SCHEDULE
-  NBC_Scatter_args *args, *found, search;
+  schedule = OBJ_NEW(NBC_Schedule);
+  if (OPAL_UNLIKELY(NULL == schedule)) {
+    return OMPI_ERR_OUT_OF_RESOURCE;
+  }
 
-  /* search schedule in communicator specific tree */
-  search.sendbuf=sendbuf;
-  search.sendcount=sendcount;
-  search.sendtype=sendtype;
-  search.recvbuf=recvbuf;
-  search.recvcount=recvcount;
-  search.recvtype=recvtype;
-  search.root=root;
-  found = (NBC_Scatter_args *) hb_tree_search ((hb_tree *) libnbc_module->NBC_Dict[NBC_SCATTER], &search);
-  if (NULL == found) {
-#endif
-    schedule = OBJ_NEW(NBC_Schedule);
-    if (OPAL_UNLIKELY(NULL == schedule)) {
-      return OMPI_ERR_OUT_OF_RESOURCE;
-    }
+  NBC_Sched_key(schedule, &root, sizeof(root));
+  if (rank == root) {
+    NBC_Sched_key(schedule, &sendbuf, sizeof(sendbuf));
+    NBC_Sched_key(schedule, &sendcount, sizeof(sendcount));
+    NBC_Sched_key_object(schedule, sendtype);
+  }
+  NBC_Sched_key(schedule, &recvbuf, sizeof(recvbuf));
+  if (!inplace) {
+    NBC_Sched_key(schedule, &recvcount, sizeof(recvcount));
+    NBC_Sched_key_object(schedule, recvtype);
+  }
 
+  if (!NBC_Schedule_cache_lookup(libnbc_module, NBC_SCATTER, &schedule, NULL)) {
     /* receive from root */
     if (rank != root) {
       /* recv msg from root */
@@ -126,38 +103,9 @@ static int nbc_scatter_init (const void* sendbuf, int sendcount, MPI_Datatype se
       OBJ_RELEASE(schedule);
       return res;
     }
-#ifdef NBC_CACHE_SCHEDULE
-    /* save schedule to tree */
-    args = (NBC_Scatter_args *) malloc (sizeof (args));
-    if (NULL != args) {
-      args->sendbuf = sendbuf;
-      args->sendcount = sendcount;
-      args->sendtype = sendtype;
-      args->recvbuf = recvbuf;
-      args->recvcount = recvcount;
-      args->recvtype = recvtype;
-      args->root = root;
-      args->schedule = schedule;
-      res = hb_tree_insert ((hb_tree *) libnbc_module->NBC_Dict[NBC_SCATTER], args, args, 0);
-      if (0 == res) {
-        OBJ_RETAIN(schedule);
 
-        /* increase number of elements for A2A */
-        if (++libnbc_module->NBC_Dict_size[NBC_SCATTER] > NBC_SCHED_DICT_UPPER) {
-          NBC_SchedCache_dictwipe ((hb_tree *) libnbc_module->NBC_Dict[NBC_SCATTER],
-                                   &libnbc_module->NBC_Dict_size[NBC_SCATTER]);
-        }
-      } else {
-        NBC_Error("error in dict_insert() (%i)", res);
-        free (args);
-      }
-    }
-  } else {
-    /* found schedule */
-    schedule = found->schedule;
-    OBJ_RETAIN(schedule);
+    NBC_Schedule_cache_insert(libnbc_module, schedule, NULL);
   }
-#endif
 
   res = NBC_Schedule_request(schedule, comm, libnbc_module, persistent, request, NULL);
   if (OPAL_UNLIKELY(OMPI_SUCCESS != res)) {
@@ -23,9 +23,8 @@
  */
 #include "nbc_internal.h"
 
-/* a scatterv schedule can not be cached easily because the contents
- * ot the recvcounts array may change, so a comparison of the address
- * would not be sufficient ... we simply do not cache it */
+/* the sendcounts and displs arrays are part of the schedule cache key,
+ * not only their addresses */
 
 /* simple linear MPI_Iscatterv */
 static int nbc_scatterv_init(const void* sendbuf, const int *sendcounts, const int *displs, MPI_Datatype sendtype,
@@ -50,48 +49,65 @@ static int nbc_scatterv_init(const void* sendbuf, const int *sendcounts, const i
     return OMPI_ERR_OUT_OF_RESOURCE;
   }
 
-  /* receive from root */
+  NBC_Sched_key(schedule, &root, sizeof(root));
   if (rank == root) {
-    res = ompi_datatype_type_extent (sendtype, &sndext);
-    if (MPI_SUCCESS != res) {
-      NBC_Error("MPI Error in ompi_datatype_type_extent() (%i)", res);
-      OBJ_RELEASE(schedule);
-      return res;
-    }
+    NBC_Sched_key(schedule, &sendbuf, sizeof(sendbuf));
+    NBC_Sched_key(schedule, sendcounts, p * sizeof(*sendcounts));
+    NBC_Sched_key(schedule, displs, p * sizeof(*displs));
+    NBC_Sched_key_object(schedule, sendtype);
+  }
+  NBC_Sched_key(schedule, &recvbuf, sizeof(recvbuf));
+  if (!inplace) {
+    NBC_Sched_key(schedule, &recvcount, sizeof(recvcount));
+    NBC_Sched_key_object(schedule, recvtype);
+  }
+
+  if (!NBC_Schedule_cache_lookup(libnbc_module, NBC_SCATTERV, &schedule, NULL)) {
+    /* receive from root */
+    if (rank == root) {
+      res = ompi_datatype_type_extent (sendtype, &sndext);
+      if (MPI_SUCCESS != res) {
+        NBC_Error("MPI Error in ompi_datatype_type_extent() (%i)", res);
+        OBJ_RELEASE(schedule);
+        return res;
+      }
 
-    for (int i = 0 ; i < p ; ++i) {
-      sbuf = (char *) sendbuf + displs[i] * sndext;
-      if (i == root) {
-        if (!inplace) {
-          /* if I am the root - just copy the message */
-          res = NBC_Sched_copy (sbuf, false, sendcounts[i], sendtype,
-                                recvbuf, false, recvcount, recvtype, schedule, false);
+      for (int i = 0 ; i < p ; ++i) {
+        sbuf = (char *) sendbuf + displs[i] * sndext;
+        if (i == root) {
+          if (!inplace) {
+            /* if I am the root - just copy the message */
+            res = NBC_Sched_copy (sbuf, false, sendcounts[i], sendtype,
+                                  recvbuf, false, recvcount, recvtype, schedule, false);
+          } else {
+            res = OMPI_SUCCESS;
+          }
         } else {
-          res = OMPI_SUCCESS;
+          /* root sends the right buffer to the right receiver */
+          res = NBC_Sched_send (sbuf, false, sendcounts[i], sendtype, i, schedule, false);
         }
-      } else {
-        /* root sends the right buffer to the right receiver */
-        res = NBC_Sched_send (sbuf, false, sendcounts[i], sendtype, i, schedule, false);
-      }
 
+        if (OPAL_UNLIKELY(OMPI_SUCCESS != res)) {
+          OBJ_RELEASE(schedule);
+          return res;
+        }
+      }
+    } else {
+      /* recv msg from root */
+      res = NBC_Sched_recv (recvbuf, false, recvcount, recvtype, root, schedule, false);
       if (OPAL_UNLIKELY(OMPI_SUCCESS != res)) {
         OBJ_RELEASE(schedule);
         return res;
       }
     }
-  } else {
-    /* recv msg from root */
-    res = NBC_Sched_recv (recvbuf, false, recvcount, recvtype, root, schedule, false);
+
+    res = NBC_Sched_commit (schedule);
     if (OPAL_UNLIKELY(OMPI_SUCCESS != res)) {
       OBJ_RELEASE(schedule);
       return res;
     }
-  }
 
-  res = NBC_Sched_commit (schedule);
-  if (OPAL_UNLIKELY(OMPI_SUCCESS != res)) {
-    OBJ_RELEASE(schedule);
-    return res;
+    NBC_Schedule_cache_insert(libnbc_module, schedule, NULL);
   }
 
   res = NBC_Schedule_request(schedule, comm, libnbc_module, persistent, request, NULL);
@@ -22,22 +22,76 @@
 
 #include "ompi_config.h"
 
+#include <string.h>
+
+#include "opal/datatype/opal_convertor.h"
+#include "opal/sys/atomic.h"
 #include "ompi/constants.h"
 #include "ompi/communicator/communicator.h"
+#include "ompi/mca/coll/coll.h"
+#include "ompi/op/op.h"
 #include "coll_sm.h"
 
 
+/*
+ * Local functions
+ */
+static int allreduce_reduce_bcast(const void *sbuf, void *rbuf, int count,
+                                  struct ompi_datatype_t *dtype,
+                                  struct ompi_op_t *op,
+                                  struct ompi_communicator_t *comm,
+                                  mca_coll_base_module_t *module);
+static int allreduce_segmented(const void *sbuf, void *rbuf, int count,
+                               struct ompi_datatype_t *dtype,
+                               struct ompi_op_t *op,
+                               struct ompi_communicator_t *comm,
+                               mca_coll_base_module_t *module);
+
+
 /**
  * Shared memory allreduce.
  *
- * For the moment, all we're doing is a reduce to root==0 and then a
- * broadcast.  It is possible that we'll do something better someday.
+ * If the operation is commutative, the datatype is "friendly"
+ * (i.e., the packed representation is the same as the unpacked
+ * one), and each process' control buffer is large enough to hold
+ * two notification slots per peer, use the segmented reduce-scatter
+ * + allgather algorithm.  Otherwise, do a reduce to root==0 and then
+ * a broadcast.
  */
 int mca_coll_sm_allreduce_intra(const void *sbuf, void *rbuf, int count,
                                 struct ompi_datatype_t *dtype,
                                 struct ompi_op_t *op,
                                 struct ompi_communicator_t *comm,
                                 mca_coll_base_module_t *module)
+{
+    size_t ddt_size;
+    int size = ompi_comm_size(comm);
+
+    ompi_datatype_type_size(dtype, &ddt_size);
+    if (0 == count || 0 == ddt_size ||
+        !ompi_op_is_commute(op) ||
+        !ompi_datatype_is_contiguous_memory_layout(dtype, count) ||
+        ddt_size > (size_t) mca_coll_sm_component.sm_fragment_size ||
+        (size_t) (2 * size) * sizeof(size_t) >
+        (size_t) mca_coll_sm_component.sm_control_size) {
+        return allreduce_reduce_bcast(sbuf, rbuf, count, dtype, op,
+                                      comm, module);
+    }
+
+    return allreduce_segmented(sbuf, rbuf, count, dtype, op, comm, module);
+}
+
+
+/**
+ * Reduce to root==0 followed by a broadcast.  Used for
+ * non-commutative operations and datatypes that cannot be reduced
+ * directly in the shared segments.
+ */
+static int allreduce_reduce_bcast(const void *sbuf, void *rbuf, int count,
+                                  struct ompi_datatype_t *dtype,
+                                  struct ompi_op_t *op,
+                                  struct ompi_communicator_t *comm,
+                                  mca_coll_base_module_t *module)
 {
     int ret;
 
@@ -60,3 +114,224 @@ int mca_coll_sm_allreduce_intra(const void *sbuf, void *rbuf, int count,
     return (ret == OMPI_SUCCESS) ?
         mca_coll_sm_bcast_intra(rbuf, count, dtype, 0, comm, module) : ret;
 }
+
+
+/**
+ * Segmented shared memory allreduce (reduce-scatter + allgather).
+ *
+ * The user buffer is processed in fragments of at most
+ * sm_fragment_size bytes (in units of whole datatypes).  Each
+ * fragment goes through one shared segment, and all processes walk
+ * through the segments in lock step, so consecutive fragments are
+ * pipelined: a fast process can already be copying in fragment N+1
+ * while slower processes are still reducing fragment N.
+ *
+ * For each fragment:
+ *
+ * 1. Every process copies its contribution into its own data area
+ *    of the segment and tells every other process that its data is
+ *    ready (slot [peer] of the other process' control buffer).
+ *
+ * 2. The fragment is split into comm_size blocks.  Process i waits
+ *    until all contributions are available and then reduces block i
+ *    of every other process' data area into block i of its *own*
+ *    data area.  All processes reduce their block in parallel and
+ *    nobody touches a block owned by somebody else, so no locking
+ *    is required.  When done, process i tells every other process
+ *    that block i is final (slot [comm_size + i] of their control
+ *    buffers).
+ *
+ * 3. Every process waits for all the blocks to be final and copies
+ *    block j out of process j's data area into its rbuf.
+ *
+ * Notifications are consumed (i.e., reset to 0) by the receiver, as
+ * in the reduce and bcast algorithms, so the control buffers are
+ * clean when the in-use flag is released.  Process 0 acts as the
+ * owner of the in-use flags.
+ */
+static int allreduce_segmented(const void *sbuf, void *rbuf, int count,
+                               struct ompi_datatype_t *dtype,
+                               struct ompi_op_t *op,
+                               struct ompi_communicator_t *comm,
+                               mca_coll_base_module_t *module)
+{
+    struct iovec iov;
+    mca_coll_sm_module_t *sm_module = (mca_coll_sm_module_t*) module;
+    mca_coll_sm_comm_t *data;
+    int ret, rank, size, peer;
+    int flag_num, segment_num, max_segment_num;
+    size_t total_size, max_data, bytes, count_left, value;
+    size_t ddt_size, segment_ddt_count, frag_count, block_count;
+    size_t block_start, block_len;
+    mca_coll_sm_in_use_flag_t *flag;
+    mca_coll_sm_data_index_t *index;
+    opal_convertor_t sbuf_convertor, rbuf_convertor;
+    char *my_data, *peer_data;
+
+    /* Lazily enable the module the first time we invoke a collective
+       on it */
+    if (!sm_module->enabled) {
+        if (OMPI_SUCCESS != (ret = ompi_coll_sm_lazy_enable(module, comm))) {
+            return ret;
+        }
+    }
+    data = sm_module->sm_comm_data;
+
+    /* Setup some identities */
+
+    rank = ompi_comm_rank(comm);
+    size = ompi_comm_size(comm);
+
+    ompi_datatype_type_size(dtype, &ddt_size);
+    segment_ddt_count = mca_coll_sm_component.sm_fragment_size / ddt_size;
+    total_size = ddt_size * count;
+    count_left = (size_t) count;
+
+    /* The send convertor feeds my data areas; the receive convertor
+       is fed block-by-block in rank order, which is exactly the
+       order of the data in the user's buffer. */
+
+    OBJ_CONSTRUCT(&sbuf_convertor, opal_convertor_t);
+    OBJ_CONSTRUCT(&rbuf_convertor, opal_convertor_t);
+    if (OMPI_SUCCESS !=
+        (ret = opal_convertor_copy_and_prepare_for_send(ompi_mpi_local_convertor,
+                                                        &(dtype->super), count,
+                                                        (MPI_IN_PLACE == sbuf) ? rbuf : sbuf,
+                                                        0, &sbuf_convertor)) ||
+        OMPI_SUCCESS !=
+        (ret = opal_convertor_copy_and_prepare_for_recv(ompi_mpi_local_convertor,
+                                                        &(dtype->super), count,
+                                                        rbuf, 0, &rbuf_convertor))) {
+        OBJ_DESTRUCT(&sbuf_convertor);
+        OBJ_DESTRUCT(&rbuf_convertor);
+        return ret;
+    }
+
+    bytes = 0;
+    do {
+        flag_num = (data->mcb_operation_count %
+                    mca_coll_sm_component.sm_comm_num_in_use_flags);
+        FLAG_SETUP(flag_num, flag, data);
+        if (0 == rank) {
+            FLAG_WAIT_FOR_IDLE(flag, allreduce_root_flag_label);
+            FLAG_RETAIN(flag, size, data->mcb_operation_count);
+        } else {
+            FLAG_WAIT_FOR_OP(flag, data->mcb_operation_count,
+                             allreduce_nonroot_flag_label);
+        }
+        ++data->mcb_operation_count;
+
+        /* Loop over all the segments in this set */
+
+        segment_num =
+            flag_num * mca_coll_sm_component.sm_segs_per_inuse_flag;
+        max_segment_num =
+            (flag_num + 1) * mca_coll_sm_component.sm_segs_per_inuse_flag;
+        do {
+            index = &(data->mcb_data_index[segment_num]);
+            my_data = index->mcbmi_data +
+                (rank * mca_coll_sm_component.sm_fragment_size);
+
+            frag_count = (count_left < segment_ddt_count) ?
+                count_left : segment_ddt_count;
+            block_count = (frag_count + size - 1) / size;
+
+            /* Phase 1: copy my contribution in and tell everyone */
+
+            max_data = frag_count * ddt_size;
+            COPY_FRAGMENT_IN(sbuf_convertor, index, rank, iov, max_data);
+            opal_atomic_wmb();
+            for (peer = 0; peer < size; ++peer) {
+                if (peer != rank) {
+                    CHILD_NOTIFY_PARENT(rank, peer, index, max_data);
+                }
+            }
+
+            /* Phase 2: reduce my block of every peer's contribution
+               into my own data area */
+
+            block_start = (size_t) rank * block_count;
+            if (block_start > frag_count) {
+                block_start = frag_count;
+            }
+            block_len = frag_count - block_start;
+            if (block_len > block_count) {
+                block_len = block_count;
+            }
+            for (peer = 0; peer < size; ++peer) {
+                if (peer == rank) {
+                    continue;
+                }
+                PARENT_WAIT_FOR_NOTIFY_SPECIFIC(peer, rank, index, value,
+                                                allreduce_data_label);
+                if (0 < block_len) {
+                    peer_data = index->mcbmi_data +
+                        (peer * mca_coll_sm_component.sm_fragment_size);
+                    ompi_op_reduce(op, peer_data + block_start * ddt_size,
+                                   my_data + block_start * ddt_size,
+                                   block_len, dtype);
+                }
+            }
+            opal_atomic_wmb();
+            for (peer = 0; peer < size; ++peer) {
+                if (peer != rank) {
+                    /* The value only has to be nonzero */
+                    CHILD_NOTIFY_PARENT(size + rank, peer, index,
+                                        block_len + 1);
+                }
+            }
+
+            /* Phase 3: gather all the reduced blocks into rbuf, in
+               rank order */
+
+            for (peer = 0; peer < size; ++peer) {
+                block_start = (size_t) peer * block_count;
+                if (block_start >= frag_count) {
+                    break;
+                }
+                block_len = frag_count - block_start;
+                if (block_len > block_count) {
+                    block_len = block_count;
+                }
+                if (peer != rank) {
+                    PARENT_WAIT_FOR_NOTIFY_SPECIFIC(size + peer, rank, index,
+                                                    value, allreduce_block_label);
+                }
+                opal_atomic_rmb();
+                iov.iov_base = index->mcbmi_data +
+                    (peer * mca_coll_sm_component.sm_fragment_size) +
+                    block_start * ddt_size;
+                iov.iov_len = max_data = block_len * ddt_size;
+                opal_convertor_unpack(&rbuf_convertor, &iov, &mca_coll_sm_one,
+                                      &max_data);
+            }
+
+            /* Peers owning an empty block still notified us; consume
+               those notifications so that the control buffer is
+               clean for the next operation */
+            for (; peer < size; ++peer) {
+                if (peer != rank) {
+                    PARENT_WAIT_FOR_NOTIFY_SPECIFIC(size + peer, rank, index,
+                                                    value, allreduce_empty_label);
+                }
+            }
+
+            bytes += frag_count * ddt_size;
+            count_left -= frag_count;
+            ++segment_num;
+        } while (bytes < total_size && segment_num < max_segment_num);
+
+        /* We're finished with this set of segments */
+        FLAG_RELEASE(flag);
+    } while (bytes < total_size);
+
+    OBJ_DESTRUCT(&sbuf_convertor);
+    OBJ_DESTRUCT(&rbuf_convertor);
+
+    /* The notification values carry no information we need */
+    (void) value;
+
+    /* All done */
+
+    return OMPI_SUCCESS;
+}
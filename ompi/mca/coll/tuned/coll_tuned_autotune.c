@@ -0,0 +1,395 @@
+/* -*- Mode: C; c-basic-offset:4 ; indent-tabs-mode:nil -*- */
+/*
+ * $COPYRIGHT$
+ *
+ * Additional copyrights may follow
+ *
+ * $HEADER$
+ */
+
+#include "ompi_config.h"
+
+#include <stdlib.h>
+#include <stdio.h>
+
+#include "mpi.h"
+#include "opal/mca/threads/mutex.h"
+#include "ompi/constants.h"
+#include "ompi/communicator/communicator.h"
+#include "ompi/mca/coll/base/coll_base_functions.h"
+#include "ompi/runtime/ompi_rte.h"
+#include "coll_tuned.h"
+#include "coll_tuned_autotune.h"
+
+bool  ompi_coll_tuned_autotune = false;
+int   ompi_coll_tuned_autotune_samples = 4;
+char* ompi_coll_tuned_autotune_output = (char*) NULL;
+
+/* a pinned decision, kept to be written to the output rules file */
+typedef struct {
+    int type;
+    int comsize;
+    int bucket;
+    int alg;
+    int faninout;
+    int segsize;
+} coll_tuned_autotune_result_t;
+
+static coll_tuned_autotune_result_t *autotune_results = NULL;
+static int autotune_n_results = 0;
+static int autotune_max_results = 0;
+static opal_mutex_t autotune_lock = OPAL_MUTEX_STATIC_INIT;
+
+int ompi_coll_tuned_autotune_register(void)
+{
+    ompi_coll_tuned_autotune = false;
+    (void) mca_base_component_var_register(&mca_coll_tuned_component.super.collm_version,
+                                           "autotune",
+                                           "Learn the algorithm to use for each message size online, by timing all the algorithms "
+                                           "of a collective for its first calls on each communicator. Applies to allgather, "
+                                           "allreduce, alltoall, barrier, bcast, reduce and reduce_scatter_block when no forced "
+                                           "algorithm or file based rule applies. Only relevant if coll_tuned_use_dynamic_rules is true.",
+                                           MCA_BASE_VAR_TYPE_BOOL, NULL, 0, 0,
+                                           OPAL_INFO_LVL_6,
+                                           MCA_BASE_VAR_SCOPE_READONLY,
+                                           &ompi_coll_tuned_autotune);
+
+    ompi_coll_tuned_autotune_samples = 4;
+    (void) mca_base_component_var_register(&mca_coll_tuned_component.super.collm_version,
+                                           "autotune_samples",
+                                           "Number of times each algorithm is timed for a message size before the fastest one is selected",
+                                           MCA_BASE_VAR_TYPE_INT, NULL, 0, 0,
+                                           OPAL_INFO_LVL_6,
+                                           MCA_BASE_VAR_SCOPE_READONLY,
+                                           &ompi_coll_tuned_autotune_samples);
+
+    ompi_coll_tuned_autotune_output = NULL;
+    (void) mca_base_component_var_register(&mca_coll_tuned_component.super.collm_version,
+                                           "autotune_output",
+                                           "Filename where the first process writes the decisions learned by autotune at MPI_Finalize, "
+                                           "in the format of coll_tuned_dynamic_rules_filename",
+                                           MCA_BASE_VAR_TYPE_STRING, NULL, 0, 0,
+                                           OPAL_INFO_LVL_6,
+                                           MCA_BASE_VAR_SCOPE_READONLY,
+                                           &ompi_coll_tuned_autotune_output);
+
+    return OMPI_SUCCESS;
+}
+
+bool ompi_coll_tuned_autotune_enabled(int type)
+{
+    if (!ompi_coll_tuned_autotune) {
+        return false;
+    }
+    /* the collectives with the same message size on all ranks */
+    switch (type) {
+    case ALLGATHER:
+    case ALLREDUCE:
+    case ALLTOALL:
+    case BARRIER:
+    case BCAST:
+    case REDUCE:
+    case REDUCESCATTERBLOCK:
+        return ompi_coll_tuned_forced_max_algorithms[type] > 1;
+    default:
+        return false;
+    }
+}
+
+static inline int autotune_bucket(size_t msgsize)
+{
+    int bucket = 0;
+
+    while (msgsize && bucket < COLL_TUNED_AUTOTUNE_BUCKETS - 1) {
+        msgsize >>= 1;
+        bucket++;
+    }
+    return bucket;
+}
+
+static inline size_t autotune_bucket_size(int bucket)
+{
+    bucket %= COLL_TUNED_AUTOTUNE_BUCKETS;
+    return (0 == bucket) ? 0 : ((size_t) 1) << (bucket - 1);
+}
+
+static inline bool autotune_bucket_commute(int bucket)
+{
+    return bucket < COLL_TUNED_AUTOTUNE_BUCKETS;
+}
+
+/*
+ * The algorithms that can be used with a non commutative operation,
+ * matching the restrictions of the fixed decision functions.
+ */
+static bool autotune_alg_allowed(int type, int alg, bool commute)
+{
+    if (commute) {
+        return true;
+    }
+    switch (type) {
+    case ALLREDUCE:
+        /* basic_linear, nonoverlapping and recursive_doubling */
+        return alg <= 3;
+    case REDUCE:
+        /* linear and in-order_binary */
+        return 1 == alg || 6 == alg;
+    case REDUCESCATTERBLOCK:
+        /* basic_linear */
+        return 1 == alg;
+    default:
+        return true;
+    }
+}
+
+static int autotune_n_candidates(ompi_coll_tuned_autotune_t *autotune, int type, bool commute)
+{
+    int n = 0;
+
+    for (int alg = 1; alg <= autotune->n_algs; alg++) {
+        n += autotune_alg_allowed(type, alg, commute);
+    }
+    return n;
+}
+
+static int autotune_faninout(mca_coll_tuned_module_t *tuned_module, int type)
+{
+    switch (type) {
+    case BCAST:
+    case REDUCE:
+    case REDUCESCATTERBLOCK:
+        return tuned_module->user_forced[type].chain_fanout;
+    default:
+        return tuned_module->user_forced[type].tree_fanout;
+    }
+}
+
+int ompi_coll_tuned_autotune_select(mca_coll_tuned_module_t *tuned_module, int type,
+                                    size_t msgsize, bool commute, int *bucket)
+{
+    ompi_coll_tuned_autotune_t *autotune = tuned_module->autotune[type];
+    int b, k, alg, n_candidates;
+
+    if (NULL == autotune) {
+        autotune = (ompi_coll_tuned_autotune_t *) calloc(1, sizeof(ompi_coll_tuned_autotune_t));
+        if (NULL == autotune) {
+            return 0;
+        }
+        autotune->n_algs = ompi_coll_tuned_forced_max_algorithms[type] - 1;
+        autotune->elapsed = (double *) calloc(COLL_TUNED_AUTOTUNE_KEYS * autotune->n_algs,
+                                              sizeof(double));
+        if (NULL == autotune->elapsed) {
+            free(autotune);
+            return 0;
+        }
+        tuned_module->autotune[type] = autotune;
+    }
+
+    b = autotune_bucket(msgsize) + (commute ? 0 : COLL_TUNED_AUTOTUNE_BUCKETS);
+    if (0 != autotune->result_alg[b]) {
+        *bucket = -1;
+        return autotune->result_alg[b];
+    }
+
+    n_candidates = autotune_n_candidates(autotune, type, commute);
+    if (n_candidates < 2) {
+        /* nothing to choose from, leave it to the fixed rules */
+        *bucket = -1;
+        return 0;
+    }
+
+    /* interleave the algorithms so that they all see the same conditions */
+    *bucket = b;
+    for (alg = 1, k = autotune->calls[b] % n_candidates; ; alg++) {
+        if (autotune_alg_allowed(type, alg, commute) && 0 == k--) {
+            return alg;
+        }
+    }
+}
+
+static void autotune_keep_result(mca_coll_tuned_module_t *tuned_module, int type,
+                                 int comsize, int bucket, int alg)
+{
+    coll_tuned_autotune_result_t *result;
+    int i;
+
+    OPAL_THREAD_LOCK(&autotune_lock);
+    for (i = 0; i < autotune_n_results; i++) {
+        result = &autotune_results[i];
+        if (result->type == type && result->comsize == comsize && result->bucket == bucket) {
+            /* another communicator of the same size already decided */
+            OPAL_THREAD_UNLOCK(&autotune_lock);
+            return;
+        }
+    }
+    if (autotune_n_results == autotune_max_results) {
+        int max_results = autotune_max_results ? 2 * autotune_max_results : 32;
+        result = (coll_tuned_autotune_result_t *) realloc(autotune_results,
+                                                          max_results * sizeof(*result));
+        if (NULL == result) {
+            OPAL_THREAD_UNLOCK(&autotune_lock);
+            return;
+        }
+        autotune_results = result;
+        autotune_max_results = max_results;
+    }
+    result = &autotune_results[autotune_n_results++];
+    result->type = type;
+    result->comsize = comsize;
+    result->bucket = bucket;
+    result->alg = alg;
+    result->faninout = autotune_faninout(tuned_module, type);
+    result->segsize = tuned_module->user_forced[type].segsize;
+    OPAL_THREAD_UNLOCK(&autotune_lock);
+}
+
+int ompi_coll_tuned_autotune_record(mca_coll_tuned_module_t *tuned_module, int type,
+                                    int bucket, int alg, double elapsed,
+                                    struct ompi_communicator_t *comm)
+{
+    ompi_coll_tuned_autotune_t *autotune = tuned_module->autotune[type];
+    double *times = autotune->elapsed + bucket * autotune->n_algs;
+    bool commute = autotune_bucket_commute(bucket);
+    int i, best, rc;
+
+    times[alg - 1] += elapsed;
+    if (++autotune->calls[bucket] < autotune_n_candidates(autotune, type, commute)
+                                    * ompi_coll_tuned_autotune_samples) {
+        return MPI_SUCCESS;
+    }
+
+    /* all the ranks are done with this bucket: a collective is as slow as
+     * its slowest rank, so agree on the maximum time of each algorithm.
+     * Use a base algorithm directly to not go through the tuner again. */
+    rc = ompi_coll_base_allreduce_intra_recursivedoubling(MPI_IN_PLACE, times, autotune->n_algs,
+                                                          MPI_DOUBLE, MPI_MAX, comm,
+                                                          &tuned_module->super);
+    if (MPI_SUCCESS != rc) {
+        return rc;
+    }
+
+    for (best = -1, i = 0; i < autotune->n_algs; i++) {
+        if (autotune_alg_allowed(type, i + 1, commute) && (best < 0 || times[i] < times[best])) {
+            best = i;
+        }
+    }
+    autotune->result_alg[bucket] = best + 1;
+
+    OPAL_OUTPUT((ompi_coll_tuned_stream,
+                 "coll:tuned:autotune collective %d comm size %d msg size %lu%s: algorithm %d (%g s per call)",
+                 type, ompi_comm_size(comm), (unsigned long) autotune_bucket_size(bucket),
+                 commute ? "" : " (non commutative op)", best + 1,
+                 times[best] / ompi_coll_tuned_autotune_samples));
+
+    /* the rules file does not distinguish non commutative operations, only
+     * keep the decisions that hold for any operation */
+    if (NULL != ompi_coll_tuned_autotune_output && commute) {
+        autotune_keep_result(tuned_module, type, ompi_comm_size(comm), bucket, best + 1);
+    }
+    return MPI_SUCCESS;
+}
+
+void ompi_coll_tuned_autotune_free(mca_coll_tuned_module_t *tuned_module)
+{
+    for (int i = 0; i < COLLCOUNT; i++) {
+        if (NULL != tuned_module->autotune[i]) {
+            free(tuned_module->autotune[i]->elapsed);
+            free(tuned_module->autotune[i]);
+            tuned_module->autotune[i] = NULL;
+        }
+    }
+}
+
+static int autotune_result_compare(const void *a, const void *b)
+{
+    const coll_tuned_autotune_result_t *ra = (const coll_tuned_autotune_result_t *) a;
+    const coll_tuned_autotune_result_t *rb = (const coll_tuned_autotune_result_t *) b;
+
+    if (ra->type != rb->type) return ra->type - rb->type;
+    if (ra->comsize != rb->comsize) return ra->comsize - rb->comsize;
+    return ra->bucket - rb->bucket;
+}
+
+/* number of distinct values of the field between [first, last[ */
+#define AUTOTUNE_COUNT_RUNS(first, last, field, count)                  \
+    do {                                                                \
+        (count) = 0;                                                    \
+        for (int _i = (first); _i < (last); _i++) {                     \
+            if (_i == (first) || autotune_results[_i].field != autotune_results[_i - 1].field) { \
+                (count)++;                                              \
+            }                                                           \
+        }                                                               \
+    } while (0)
+
+/*
+ * Write the learned decisions in the format read by
+ * ompi_coll_tuned_read_rules_config_file. Within a communicator size,
+ * a bucket with the same decision as the previous one is merged into it.
+ */
+static int autotune_write_rules(const char *fname)
+{
+    int i, j, k, n_types, n_comsizes, n_msgs;
+    FILE *fptr;
+
+    qsort(autotune_results, autotune_n_results, sizeof(coll_tuned_autotune_result_t),
+          autotune_result_compare);
+
+    fptr = fopen(fname, "w");
+    if (NULL == fptr) {
+        opal_output(0, "coll:tuned:autotune cannot write rules file [%s]", fname);
+        return OMPI_ERROR;
+    }
+
+    AUTOTUNE_COUNT_RUNS(0, autotune_n_results, type, n_types);
+    fprintf(fptr, "# rules learned by coll_tuned_autotune\n");
+    fprintf(fptr, "%d # number of collectives\n", n_types);
+
+    for (i = 0; i < autotune_n_results; i = j) {
+        for (j = i; j < autotune_n_results && autotune_results[j].type == autotune_results[i].type; j++);
+        AUTOTUNE_COUNT_RUNS(i, j, comsize, n_comsizes);
+        fprintf(fptr, "%d # collective id\n", autotune_results[i].type);
+        fprintf(fptr, "%d # number of com sizes\n", n_comsizes);
+
+        for (k = i; k < j; ) {
+            int comsize = autotune_results[k].comsize, first = k, prev_alg = 0;
+
+            for (n_msgs = 0; k < j && autotune_results[k].comsize == comsize; k++) {
+                if (autotune_results[k].alg != prev_alg) {
+                    prev_alg = autotune_results[k].alg;
+                    n_msgs++;
+                }
+            }
+            fprintf(fptr, "%d # comm size\n", comsize);
+            fprintf(fptr, "%d # number of msg sizes\n", n_msgs);
+
+            for (prev_alg = 0; first < k; first++) {
+                coll_tuned_autotune_result_t *result = &autotune_results[first];
+
+                if (result->alg == prev_alg) {
+                    continue;
+                }
+                /* rules must start at message size zero */
+                fprintf(fptr, "%lu %d %d %d # message size, algorithm, topo faninout, segment size\n",
+                        0 == prev_alg ? 0UL : (unsigned long) autotune_bucket_size(result->bucket),
+                        result->alg, result->faninout, result->segsize);
+                prev_alg = result->alg;
+            }
+        }
+    }
+
+    fclose(fptr);
+    return OMPI_SUCCESS;
+}
+
+int ompi_coll_tuned_autotune_finalize(void)
+{
+    if (NULL != ompi_coll_tuned_autotune_output && autotune_n_results > 0 &&
+        0 == OMPI_PROC_MY_NAME->vpid) {
+        (void) autotune_write_rules(ompi_coll_tuned_autotune_output);
+    }
+
+    free(autotune_results);
+    autotune_results = NULL;
+    autotune_n_results = autotune_max_results = 0;
+    return OMPI_SUCCESS;
+}
@@ -0,0 +1,112 @@
+/* -*- Mode: C; c-basic-offset:4 ; indent-tabs-mode:nil -*- */
+/*
+ * $COPYRIGHT$
+ *
+ * Additional copyrights may follow
+ *
+ * $HEADER$
+ */
+
+#ifndef MCA_COLL_TUNED_AUTOTUNE_H_HAS_BEEN_INCLUDED
+#define MCA_COLL_TUNED_AUTOTUNE_H_HAS_BEEN_INCLUDED
+
+#include "ompi_config.h"
+
+#include <math.h>
+
+#include "coll_tuned.h"
+
+BEGIN_C_DECLS
+
+/*
+ * Online tuning of the dynamic decision functions.
+ *
+ * Messages are grouped in power of two size buckets. For the first calls
+ * of a collective in a bucket, every algorithm is tried in turn
+ * coll_tuned_autotune_samples times and timed. Once all of them have been
+ * tried, the slowest rank time of each algorithm is agreed upon with an
+ * allreduce and the fastest algorithm is pinned for the bucket for the
+ * lifetime of the communicator.
+ *
+ * Only collectives whose message size is the same on all the ranks of
+ * the communicator are tuned, as all the ranks must reach the agreement
+ * during the same call.
+ *
+ * Reductions with a non commutative operation are tuned separately, and
+ * only among the algorithms that preserve the order of the operands.
+ */
+
+#define COLL_TUNED_AUTOTUNE_BUCKETS 64
+/* one set of buckets for commutative and one for non commutative ops */
+#define COLL_TUNED_AUTOTUNE_KEYS    (2 * COLL_TUNED_AUTOTUNE_BUCKETS)
+
+struct ompi_coll_tuned_autotune_t {
+    int n_algs;                                     /* algorithms tried, 1 to n_algs */
+    int calls[COLL_TUNED_AUTOTUNE_KEYS];            /* learning calls done so far */
+    int result_alg[COLL_TUNED_AUTOTUNE_KEYS];       /* pinned algorithm, 0 while learning */
+    double *elapsed;                                /* local time spent in each algorithm */
+};
+typedef struct ompi_coll_tuned_autotune_t ompi_coll_tuned_autotune_t;
+
+extern bool  ompi_coll_tuned_autotune;
+extern int   ompi_coll_tuned_autotune_samples;
+extern char* ompi_coll_tuned_autotune_output;
+
+int ompi_coll_tuned_autotune_register(void);
+int ompi_coll_tuned_autotune_finalize(void);
+
+/* true if the collective TYPE is tuned online */
+bool ompi_coll_tuned_autotune_enabled(int type);
+
+/*
+ * Return the algorithm to use for a message of msgsize bytes, or 0 if
+ * the collective is not tuned. commute tells whether the operation of a
+ * reduction is commutative, and must be true for the other collectives.
+ * If the call is part of the learning phase, *bucket is set and the time
+ * spent in the algorithm must be given back with
+ * ompi_coll_tuned_autotune_record(), otherwise *bucket is set to -1.
+ */
+int ompi_coll_tuned_autotune_select(mca_coll_tuned_module_t *tuned_module, int type,
+                                    size_t msgsize, bool commute, int *bucket);
+
+int ompi_coll_tuned_autotune_record(mca_coll_tuned_module_t *tuned_module, int type,
+                                    int bucket, int alg, double elapsed,
+                                    struct ompi_communicator_t *comm);
+
+void ompi_coll_tuned_autotune_free(mca_coll_tuned_module_t *tuned_module);
+
+/*
+ * Run CALL with the algorithm picked by the autotuner, available to CALL
+ * as autotune_alg, and return its result from the calling function.
+ * Falls through if the collective is not tuned. An algorithm that does
+ * not support the communicator is never selected, and the fixed rules
+ * (algorithm 0) are used instead, both while learning and if such an
+ * algorithm ends up pinned.
+ */
+#define COLL_TUNED_AUTOTUNE(TMOD, TYPE, MSGSIZE, COMMUTE, COMM, CALL)         \
+    if( ompi_coll_tuned_autotune_enabled(TYPE) ) {                            \
+        int autotune_alg, autotune_tried, autotune_bucket, autotune_rc;       \
+        double autotune_elapsed;                                              \
+        autotune_alg = ompi_coll_tuned_autotune_select((TMOD), (TYPE), (MSGSIZE), \
+                                                       (COMMUTE), &autotune_bucket); \
+        if( 0 != autotune_alg ) {                                             \
+            autotune_tried = autotune_alg;                                    \
+            autotune_elapsed = MPI_Wtime();                                   \
+            autotune_rc = (CALL);                                             \
+            autotune_elapsed = MPI_Wtime() - autotune_elapsed;                \
+            if( MPI_ERR_UNSUPPORTED_OPERATION == autotune_rc ) {              \
+                autotune_elapsed = HUGE_VAL;                                  \
+                autotune_alg = 0;                                             \
+                autotune_rc = (CALL);                                         \
+            }                                                                 \
+            if( (autotune_bucket >= 0) && (MPI_SUCCESS == autotune_rc) ) {    \
+                autotune_rc = ompi_coll_tuned_autotune_record((TMOD), (TYPE), autotune_bucket, \
+                                                              autotune_tried, autotune_elapsed, \
+                                                              (COMM));        \
+            }                                                                 \
+            return autotune_rc;                                               \
+        }                                                                     \
+    }
+
+END_C_DECLS
+#endif /* MCA_COLL_TUNED_AUTOTUNE_H_HAS_BEEN_INCLUDED */
@@ -38,6 +38,7 @@
 #include "ompi/mca/coll/coll.h"
 #include "coll_tuned.h"
 #include "coll_tuned_dynamic_file.h"
+#include "coll_tuned_autotune.h"
 
 /*
  * Public string showing the coll ompi_tuned component version number
@@ -191,6 +192,8 @@ static int tuned_register(void)
                                            MCA_BASE_VAR_SCOPE_READONLY,
                                            &ompi_coll_tuned_dynamic_rules_filename);
 
+    (void) ompi_coll_tuned_autotune_register();
+
     /* register forced params */
     ompi_coll_tuned_allreduce_intra_check_forced_init(&ompi_coll_tuned_forced_params[ALLREDUCE]);
     ompi_coll_tuned_alltoall_intra_check_forced_init(&ompi_coll_tuned_forced_params[ALLTOALL]);
@@ -242,6 +245,9 @@ static int tuned_open(void)
                 mca_coll_tuned_component.all_base_rules = NULL;
             }
         }
+        if (ompi_coll_tuned_autotune_samples < 1) {
+            ompi_coll_tuned_autotune_samples = 1;
+        }
     }
 
     OPAL_OUTPUT((ompi_coll_tuned_stream, "coll:tuned:component_open: done!"));
@@ -265,6 +271,8 @@ static int tuned_close(void)
         mca_coll_tuned_component.all_base_rules = NULL;
     }
 
+    ompi_coll_tuned_autotune_finalize();
+
     return OMPI_SUCCESS;
 }
 
@@ -276,8 +284,15 @@ mca_coll_tuned_module_construct(mca_coll_tuned_module_t *module)
     for( int i = 0; i < COLLCOUNT; i++ ) {
         tuned_module->user_forced[i].algorithm = 0;
         tuned_module->com_rules[i] = NULL;
+        tuned_module->autotune[i] = NULL;
     }
 }
 
+static void
+mca_coll_tuned_module_destruct(mca_coll_tuned_module_t *module)
+{
+    ompi_coll_tuned_autotune_free(module);
+}
+
 OBJ_CLASS_INSTANCE(mca_coll_tuned_module_t, mca_coll_base_module_t,
-                   mca_coll_tuned_module_construct, NULL);
+                   mca_coll_tuned_module_construct, mca_coll_tuned_module_destruct);
@@ -27,10 +27,12 @@
 #include "ompi/constants.h"
 #include "ompi/datatype/ompi_datatype.h"
 #include "ompi/communicator/communicator.h"
+#include "ompi/op/op.h"
 #include "ompi/mca/coll/base/base.h"
 #include "ompi/mca/coll/coll.h"
 #include "ompi/mca/coll/base/coll_tags.h"
 #include "coll_tuned.h"
+#include "coll_tuned_autotune.h"
 
 /*
  * Notes on evaluation rules and ordering
@@ -40,6 +42,8 @@
  * Else
  *      use forced rules (-coll_tuned_dynamic_ALG_intra_algorithm = algorithm-number)
  * Else
+ *      learn the rule online (-coll_tuned_autotune = 1) for the collectives that support it
+ * Else
  *      use fixed (compiled) rule set (or nested ifs)
  *
  */
@@ -90,6 +94,20 @@ ompi_coll_tuned_allreduce_intra_dec_dynamic (const void *sbuf, void *rbuf, int c
         } /* found a method */
     } /*end if any com rules to check */
 
+    /* or learn one */
+    {
+        size_t dsize;
+
+        ompi_datatype_type_size (dtype, &dsize);
+        dsize *= count;
+
+        COLL_TUNED_AUTOTUNE(tuned_module, ALLREDUCE, dsize, ompi_op_is_commute(op), comm,
+                            ompi_coll_tuned_allreduce_intra_do_this (sbuf, rbuf, count, dtype, op,
+                                                                     comm, module, autotune_alg,
+                                                                     tuned_module->user_forced[ALLREDUCE].tree_fanout,
+                                                                     tuned_module->user_forced[ALLREDUCE].segsize));
+    }
+
     return ompi_coll_tuned_allreduce_intra_dec_fixed (sbuf, rbuf, count, dtype, op,
                                                       comm, module);
 }
@@ -147,6 +165,22 @@ int ompi_coll_tuned_alltoall_intra_dec_dynamic(const void *sbuf, int scount,
         } /* found a method */
     } /*end if any com rules to check */
 
+    /* or learn one, the send arguments are not significant with MPI_IN_PLACE */
+    {
+        size_t dsize;
+
+        ompi_datatype_type_size (rdtype, &dsize);
+        dsize *= (ptrdiff_t)ompi_comm_size(comm) * (ptrdiff_t)rcount;
+
+        COLL_TUNED_AUTOTUNE(tuned_module, ALLTOALL, dsize, true, comm,
+                            ompi_coll_tuned_alltoall_intra_do_this (sbuf, scount, sdtype,
+                                                                    rbuf, rcount, rdtype,
+                                                                    comm, module, autotune_alg,
+                                                                    tuned_module->user_forced[ALLTOALL].tree_fanout,
+                                                                    tuned_module->user_forced[ALLTOALL].segsize,
+                                                                    tuned_module->user_forced[ALLTOALL].max_requests));
+    }
+
     return ompi_coll_tuned_alltoall_intra_dec_fixed (sbuf, scount, sdtype,
                                                      rbuf, rcount, rdtype,
                                                      comm, module);
@@ -240,6 +274,12 @@ int ompi_coll_tuned_barrier_intra_dec_dynamic(struct ompi_communicator_t *comm,
         } /* found a method */
     } /*end if any com rules to check */
 
+    /* or learn one */
+    COLL_TUNED_AUTOTUNE(tuned_module, BARRIER, 0, true, comm,
+                        ompi_coll_tuned_barrier_intra_do_this (comm, module, autotune_alg,
+                                                               tuned_module->user_forced[BARRIER].tree_fanout,
+                                                               tuned_module->user_forced[BARRIER].segsize));
+
     return ompi_coll_tuned_barrier_intra_dec_fixed (comm, module);
 }
 
@@ -288,6 +328,19 @@ int ompi_coll_tuned_bcast_intra_dec_dynamic(void *buf, int count,
         } /* found a method */
     } /*end if any com rules to check */
 
+    /* or learn one */
+    {
+        size_t dsize;
+
+        ompi_datatype_type_size (dtype, &dsize);
+        dsize *= count;
+
+        COLL_TUNED_AUTOTUNE(tuned_module, BCAST, dsize, true, comm,
+                            ompi_coll_tuned_bcast_intra_do_this (buf, count, dtype, root,
+                                                                 comm, module, autotune_alg,
+                                                                 tuned_module->user_forced[BCAST].chain_fanout,
+                                                                 tuned_module->user_forced[BCAST].segsize));
+    }
 
     return ompi_coll_tuned_bcast_intra_dec_fixed (buf, count, dtype, root,
                                                   comm, module);
@@ -343,6 +396,21 @@ int ompi_coll_tuned_reduce_intra_dec_dynamic( const void *sbuf, void *rbuf,
         } /* found a method */
     } /*end if any com rules to check */
 
+    /* or learn one */
+    {
+        size_t dsize;
+
+        ompi_datatype_type_size(dtype, &dsize);
+        dsize *= count;
+
+        COLL_TUNED_AUTOTUNE(tuned_module, REDUCE, dsize, ompi_op_is_commute(op), comm,
+                            ompi_coll_tuned_reduce_intra_do_this (sbuf, rbuf, count, dtype,
+                                                                  op, root, comm, module, autotune_alg,
+                                                                  tuned_module->user_forced[REDUCE].chain_fanout,
+                                                                  tuned_module->user_forced[REDUCE].segsize,
+                                                                  tuned_module->user_forced[REDUCE].max_requests));
+    }
+
     return ompi_coll_tuned_reduce_intra_dec_fixed (sbuf, rbuf, count, dtype,
                                                    op, root, comm, module);
 }
@@ -452,6 +520,20 @@ int ompi_coll_tuned_reduce_scatter_block_intra_dec_dynamic(const void *sbuf, voi
         } /* found a method */
     } /* end if any com rules to check */
 
+    /* or learn one */
+    {
+        size_t dsize;
+
+        ompi_datatype_type_size (dtype, &dsize);
+        dsize *= rcount * ompi_comm_size(comm);
+
+        COLL_TUNED_AUTOTUNE(tuned_module, REDUCESCATTERBLOCK, dsize, ompi_op_is_commute(op), comm,
+                            ompi_coll_tuned_reduce_scatter_block_intra_do_this (sbuf, rbuf, rcount, dtype,
+                                                                                op, comm, module, autotune_alg,
+                                                                                tuned_module->user_forced[REDUCESCATTERBLOCK].chain_fanout,
+                                                                                tuned_module->user_forced[REDUCESCATTERBLOCK].segsize));
+    }
+
     return ompi_coll_tuned_reduce_scatter_block_intra_dec_fixed (sbuf, rbuf, rcount,
                                                                  dtype, op, comm, module);
 }
@@ -511,6 +593,21 @@ int ompi_coll_tuned_allgather_intra_dec_dynamic(const void *sbuf, int scount,
         }
     }
 
+    /* Or learn one, the send arguments are not significant with MPI_IN_PLACE */
+    {
+        size_t dsize;
+
+        ompi_datatype_type_size (rdtype, &dsize);
+        dsize *= (ptrdiff_t)ompi_comm_size(comm) * (ptrdiff_t)rcount;
+
+        COLL_TUNED_AUTOTUNE(tuned_module, ALLGATHER, dsize, true, comm,
+                            ompi_coll_tuned_allgather_intra_do_this (sbuf, scount, sdtype,
+                                                                     rbuf, rcount, rdtype,
+                                                                     comm, module, autotune_alg,
+                                                                     tuned_module->user_forced[ALLGATHER].tree_fanout,
+                                                                     tuned_module->user_forced[ALLGATHER].segsize));
+    }
+
     /* Use default decision */
     return ompi_coll_tuned_allgather_intra_dec_fixed (sbuf, scount, sdtype,
                                                       rbuf, rcount, rdtype,
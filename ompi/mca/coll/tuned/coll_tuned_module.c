@@ -33,6 +33,7 @@
 #include "coll_tuned.h"
 #include "coll_tuned_dynamic_rules.h"
 #include "coll_tuned_dynamic_file.h"
+#include "coll_tuned_autotune.h"
 
 static int tuned_module_enable(mca_coll_base_module_t *module,
                    struct ompi_communicator_t *comm);
@@ -164,6 +165,9 @@ ompi_coll_tuned_forced_getvalues( enum COLLTYPE type,
                 need_dynamic_decision = 1;                              \
             }                                                           \
         }                                                               \
+        if( ompi_coll_tuned_autotune_enabled(TYPE) ) {                  \
+            need_dynamic_decision = 1;                                  \
+        }                                                               \
         if( 1 == need_dynamic_decision ) {                              \
             OPAL_OUTPUT((ompi_coll_tuned_stream,"coll:tuned: enable dynamic selection for "#TYPE)); \
             EXECUTE;                                                    \
@@ -142,6 +142,7 @@ typedef int (*mca_common_ompio_get_mca_parameter_value_fn_t) ( char *mca_paramet
 
 
 struct mca_common_ompio_print_queue;
+struct mca_common_ompio_read_cache_t;
 
 /**
  * Back-end structure for MPI_File
@@ -178,6 +179,11 @@ struct ompio_file_t {
        Note: Neither f_sharedfp nor f_sharedfp_component seemed appropriate for this.
     */
     void                  *f_sharedfp_data;
+    /* Place for the selected fcoll module to keep state across collective
+       calls. Allocated with malloc by the fcoll module, freed on close. */
+    void                  *f_fcoll_data;
+    /* Read cache of the individual read operations, NULL if disabled */
+    struct mca_common_ompio_read_cache_t *f_read_cache;
 
 
     /* File View parameters */
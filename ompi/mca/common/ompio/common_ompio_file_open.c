@@ -40,6 +40,7 @@
 #include <unistd.h>
 #include <math.h>
 #include "common_ompio.h"
+#include "common_ompio_read_cache.h"
 #include "ompi/mca/topo/topo.h"
 
 static mca_common_ompio_generate_current_file_view_fn_t generate_current_file_view_fn;
@@ -104,6 +105,8 @@ int mca_common_ompio_file_open (ompi_communicator_t *comm,
 
     ompio_fh->f_split_coll_req    = NULL;
     ompio_fh->f_split_coll_in_use = false;
+    ompio_fh->f_fcoll_data        = NULL;
+    ompio_fh->f_read_cache        = NULL;
 
     /*Initialize the print_queues queues here!*/
     mca_common_ompio_initialize_print_queue(&ompio_fh->f_coll_write_time);
@@ -268,10 +271,20 @@ int mca_common_ompio_file_close (ompio_file_t *ompio_fh)
         delete_flag = 1;
     }
 
+    /* prefetches still in flight have to finish before the file is closed */
+    mca_common_ompio_read_cache_free (ompio_fh);
+
     /*close the sharedfp file*/
     if( NULL != ompio_fh->f_sharedfp ){
         ret = ompio_fh->f_sharedfp->sharedfp_file_close(ompio_fh);
     }
+    /* the fbtl module may hold on to the file descriptor (e.g. a file
+    ** registered with an io_uring), it has to let go before the file
+    ** is closed
+    */
+    if ( NULL != ompio_fh->f_fbtl ) {
+	mca_fbtl_base_file_unselect (ompio_fh);
+    }
     if ( NULL != ompio_fh->f_fs ) {
 	/* The pointer might not be set if file_close() is
 	** called from the file destructor in case of an error
@@ -286,13 +299,13 @@ int mca_common_ompio_file_close (ompio_file_t *ompio_fh)
     if ( NULL != ompio_fh->f_fs ) {
 	mca_fs_base_file_unselect (ompio_fh);
     }
-    if ( NULL != ompio_fh->f_fbtl ) {
-	mca_fbtl_base_file_unselect (ompio_fh);
-    }
-
     if ( NULL != ompio_fh->f_fcoll ) {
 	mca_fcoll_base_file_unselect (ompio_fh);
     }
+    if ( NULL != ompio_fh->f_fcoll_data ) {
+        free (ompio_fh->f_fcoll_data);
+        ompio_fh->f_fcoll_data = NULL;
+    }
     if ( NULL != ompio_fh->f_sharedfp)  {
 	mca_sharedfp_base_file_unselect (ompio_fh);
     }
@@ -34,6 +34,7 @@
 #include "common_ompio.h"
 #include "common_ompio_request.h"
 #include "common_ompio_buffer.h"
+#include "common_ompio_read_cache.h"
 #include <unistd.h>
 #include <math.h>
 
@@ -168,7 +169,7 @@ int mca_common_ompio_file_read (ompio_file_t *fh,
                                           &fh->f_num_of_io_entries);
 
         if (fh->f_num_of_io_entries) {
-            ret_code = fh->f_fbtl->fbtl_preadv (fh);
+            ret_code = mca_common_ompio_read_cache_preadv (fh);
             if ( 0<= ret_code ) {
                 real_bytes_read+=(size_t)ret_code;
             }
@@ -32,6 +32,7 @@
 #include "common_ompio.h"
 #include "common_ompio_request.h"
 #include "common_ompio_buffer.h"
+#include "common_ompio_read_cache.h"
 #include <unistd.h>
 #include <math.h>
 
@@ -69,6 +70,8 @@ int mca_common_ompio_file_write (ompio_file_t *fh,
         return ret;
     }
 
+    mca_common_ompio_read_cache_invalidate (fh);
+
     bool need_to_copy = false;
 
 #if OPAL_CUDA_SUPPORT
@@ -232,6 +235,8 @@ int mca_common_ompio_file_iwrite (ompio_file_t *fh,
         return OMPI_SUCCESS;
     }
 
+    mca_common_ompio_read_cache_invalidate (fh);
+
     if ( NULL != fh->f_fbtl->fbtl_ipwritev ) {
         /* This fbtl has support for non-blocking operations */
         
@@ -387,6 +392,8 @@ int mca_common_ompio_file_write_all (ompio_file_t *fh,
                                      ompi_status_public_t *status)
 {
     int ret = OMPI_SUCCESS;
+
+    mca_common_ompio_read_cache_invalidate (fh);
     
     if ( !( fh->f_flags & OMPIO_DATAREP_NATIVE ) &&
          !(datatype == &ompi_mpi_byte.dt  ||
@@ -467,6 +474,8 @@ int mca_common_ompio_file_iwrite_all (ompio_file_t *fp,
 {
     int ret = OMPI_SUCCESS;
 
+    mca_common_ompio_read_cache_invalidate (fp);
+
     if ( NULL != fp->f_fcoll->fcoll_file_iwrite_all ) {
 	ret = fp->f_fcoll->fcoll_file_iwrite_all (fp,
 						  buf,
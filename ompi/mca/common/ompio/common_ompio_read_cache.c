@@ -0,0 +1,359 @@
+/*
+ *  $COPYRIGHT$
+ *
+ *  Additional copyrights may follow
+ *
+ *  $HEADER$
+ */
+
+#include "ompi_config.h"
+
+#include "opal/util/output.h"
+#include "ompi/mca/fbtl/fbtl.h"
+
+#include "common_ompio.h"
+#include "common_ompio_request.h"
+#include "common_ompio_read_cache.h"
+
+/* upper bound on the number of file view segments walked per prefetch */
+#define OMPIO_READ_CACHE_MAX_SEGMENTS 4096
+
+static void read_cache_drop (mca_common_ompio_read_cache_t *cache,
+                             mca_common_ompio_cache_block_t *blk);
+
+/* Read one io entry with the fbtl, bypassing the current io array */
+static ssize_t read_cache_fbtl_read (ompio_file_t *fh, char *buf, OMPI_MPI_OFFSET_TYPE offset,
+                                     size_t length, ompi_request_t *req)
+{
+    mca_common_ompio_io_array_t entry, *io_array = fh->f_io_array;
+    int num_entries = fh->f_num_of_io_entries;
+    ssize_t ret;
+
+    entry.memory_address = buf;
+    entry.offset = (void *)(intptr_t) offset;
+    entry.length = length;
+
+    fh->f_io_array = &entry;
+    fh->f_num_of_io_entries = 1;
+    if ( NULL != req ) {
+        ret = fh->f_fbtl->fbtl_ipreadv (fh, req);
+    }
+    else {
+        ret = fh->f_fbtl->fbtl_preadv (fh);
+    }
+    fh->f_io_array = io_array;
+    fh->f_num_of_io_entries = num_entries;
+
+    return ret;
+}
+
+/* Least recently used block without a prefetch in flight, NULL if none */
+static mca_common_ompio_cache_block_t *read_cache_victim (mca_common_ompio_read_cache_t *cache)
+{
+    mca_common_ompio_cache_block_t *victim = NULL;
+    int i;
+
+    for ( i = 0; i < cache->num_blocks; i++ ) {
+        mca_common_ompio_cache_block_t *blk = &cache->blocks[i];
+        if ( MPI_REQUEST_NULL != blk->req ) {
+            continue;
+        }
+        if ( -1 == blk->offset ) {
+            return blk;
+        }
+        if ( NULL == victim || blk->stamp < victim->stamp ) {
+            victim = blk;
+        }
+    }
+    if ( NULL != victim ) {
+        read_cache_drop (cache, victim);
+    }
+    return victim;
+}
+
+static void read_cache_drop (mca_common_ompio_read_cache_t *cache,
+                             mca_common_ompio_cache_block_t *blk)
+{
+    if ( MPI_REQUEST_NULL != blk->req ) {
+        ompi_request_wait (&blk->req, MPI_STATUS_IGNORE);
+    }
+    if ( -1 != blk->offset ) {
+        opal_hash_table_remove_value_uint64 (&cache->index,
+                                             (uint64_t)(blk->offset / cache->block_size));
+    }
+    blk->offset = -1;
+    blk->length = 0;
+}
+
+/*
+ * Return the block holding block number bnum, reading it if it is not
+ * cached yet and waiting for it if it is being prefetched.
+ */
+static int read_cache_block (ompio_file_t *fh, mca_common_ompio_read_cache_t *cache,
+                             uint64_t bnum, mca_common_ompio_cache_block_t **pblk)
+{
+    mca_common_ompio_cache_block_t *blk = NULL;
+    ompi_status_public_t status;
+    ssize_t ret;
+
+    if ( OPAL_SUCCESS == opal_hash_table_get_value_uint64 (&cache->index, bnum, (void **) &blk) ) {
+        if ( MPI_REQUEST_NULL != blk->req ) {
+            ret = ompi_request_wait (&blk->req, &status);
+            if ( OMPI_SUCCESS != ret ) {
+                read_cache_drop (cache, blk);
+                return (int) ret;
+            }
+            blk->length = status._ucount;
+        }
+        blk->stamp = ++cache->clock;
+        *pblk = blk;
+        return OMPI_SUCCESS;
+    }
+
+    blk = read_cache_victim (cache);
+    if ( NULL == blk ) {
+        /* every block is being prefetched, recycle the oldest one */
+        blk = &cache->blocks[0];
+        read_cache_drop (cache, blk);
+    }
+
+    ret = read_cache_fbtl_read (fh, blk->buf, (OMPI_MPI_OFFSET_TYPE)(bnum * cache->block_size),
+                                cache->block_size, NULL);
+    if ( 0 > ret ) {
+        return (int) ret;
+    }
+    blk->offset = (OMPI_MPI_OFFSET_TYPE)(bnum * cache->block_size);
+    blk->length = (size_t) ret;
+    blk->stamp = ++cache->clock;
+    opal_hash_table_set_value_uint64 (&cache->index, bnum, blk);
+
+    *pblk = blk;
+    return OMPI_SUCCESS;
+}
+
+static void read_cache_prefetch_block (ompio_file_t *fh, mca_common_ompio_read_cache_t *cache,
+                                       uint64_t bnum)
+{
+    mca_common_ompio_cache_block_t *blk = NULL;
+    mca_ompio_request_t *ompio_req = NULL;
+    ssize_t ret;
+
+    if ( OPAL_SUCCESS == opal_hash_table_get_value_uint64 (&cache->index, bnum, (void **) &blk) ) {
+        return;
+    }
+    blk = read_cache_victim (cache);
+    if ( NULL == blk ) {
+        return;
+    }
+
+    mca_common_ompio_request_alloc (&ompio_req, MCA_OMPIO_REQUEST_READ);
+    ret = read_cache_fbtl_read (fh, blk->buf, (OMPI_MPI_OFFSET_TYPE)(bnum * cache->block_size),
+                                cache->block_size, (ompi_request_t *) ompio_req);
+    if ( 0 > ret ) {
+        ompio_req->req_ompi.req_status.MPI_ERROR = (int) ret;
+        ompi_request_complete (&ompio_req->req_ompi, false);
+        ompi_request_free ((ompi_request_t **) &ompio_req);
+        return;
+    }
+    mca_common_ompio_register_progress ();
+
+    blk->req = (ompi_request_t *) ompio_req;
+    blk->offset = (OMPI_MPI_OFFSET_TYPE)(bnum * cache->block_size);
+    blk->length = 0;
+    blk->stamp = ++cache->clock;
+    opal_hash_table_set_value_uint64 (&cache->index, bnum, blk);
+}
+
+/*
+ * Start reading the blocks covered by the file view after offset. The
+ * view repeats every f_view_extent bytes starting at f_disp, so the walk
+ * continues into the next copies of the filetype as needed.
+ */
+static void read_cache_prefetch (ompio_file_t *fh, mca_common_ompio_read_cache_t *cache,
+                                 OMPI_MPI_OFFSET_TYPE offset)
+{
+    OMPI_MPI_OFFSET_TYPE base, start, end;
+    uint64_t bnum, last = UINT64_MAX;
+    int i, visited, found = 0;
+
+    if ( 0 == cache->prefetch || NULL == fh->f_fbtl->fbtl_ipreadv ||
+         0 == fh->f_iov_count || 0 >= fh->f_view_extent ) {
+        return;
+    }
+
+    base = fh->f_disp;
+    if ( offset > fh->f_disp ) {
+        base += ((offset - fh->f_disp) / fh->f_view_extent) * fh->f_view_extent;
+    }
+
+    for ( i = 0, visited = 0; visited < OMPIO_READ_CACHE_MAX_SEGMENTS; visited++ ) {
+        start = base + (OMPI_MPI_OFFSET_TYPE)(intptr_t) fh->f_decoded_iov[i].iov_base;
+        end   = start + fh->f_decoded_iov[i].iov_len;
+        if ( end > offset ) {
+            if ( start < offset ) {
+                start = offset;
+            }
+            for ( bnum = start / cache->block_size; bnum <= (uint64_t)((end - 1) / cache->block_size); bnum++ ) {
+                if ( bnum == last ) {
+                    continue;
+                }
+                last = bnum;
+                read_cache_prefetch_block (fh, cache, bnum);
+                if ( ++found >= cache->prefetch ) {
+                    return;
+                }
+            }
+        }
+        if ( ++i == (int) fh->f_iov_count ) {
+            i = 0;
+            base += fh->f_view_extent;
+        }
+    }
+}
+
+static mca_common_ompio_read_cache_t *read_cache_get (ompio_file_t *fh)
+{
+    mca_common_ompio_read_cache_t *cache = fh->f_read_cache;
+    int cache_size, block_size, i;
+
+    if ( NULL != cache ) {
+        return cache;
+    }
+
+    cache_size = OMPIO_MCA_GET(fh, read_cache_size);
+    block_size = OMPIO_MCA_GET(fh, read_cache_block_size);
+    if ( 0 >= cache_size || 0 >= block_size || cache_size < block_size ) {
+        return NULL;
+    }
+
+    cache = (mca_common_ompio_read_cache_t *) calloc (1, sizeof(mca_common_ompio_read_cache_t));
+    if ( NULL == cache ) {
+        return NULL;
+    }
+    cache->block_size = (size_t) block_size;
+    cache->num_blocks = cache_size / block_size;
+    cache->prefetch   = OMPIO_MCA_GET(fh, read_cache_prefetch);
+    /* keep room for the blocks being read */
+    if ( cache->prefetch > cache->num_blocks / 2 ) {
+        cache->prefetch = cache->num_blocks / 2;
+    }
+    if ( cache->prefetch < 0 ) {
+        cache->prefetch = 0;
+    }
+
+    cache->blocks = (mca_common_ompio_cache_block_t *) calloc (cache->num_blocks,
+                                                               sizeof(mca_common_ompio_cache_block_t));
+    cache->memory = (char *) malloc ((size_t) cache->num_blocks * cache->block_size);
+    if ( NULL == cache->blocks || NULL == cache->memory ) {
+        opal_output (1, "common_ompio: could not allocate the read cache, disabling it\n");
+        free (cache->blocks);
+        free (cache->memory);
+        free (cache);
+        return NULL;
+    }
+    for ( i = 0; i < cache->num_blocks; i++ ) {
+        cache->blocks[i].offset = -1;
+        cache->blocks[i].req    = MPI_REQUEST_NULL;
+        cache->blocks[i].buf    = cache->memory + (size_t) i * cache->block_size;
+    }
+    OBJ_CONSTRUCT(&cache->index, opal_hash_table_t);
+    opal_hash_table_init (&cache->index, 2 * cache->num_blocks);
+
+    fh->f_read_cache = cache;
+    return cache;
+}
+
+ssize_t mca_common_ompio_read_cache_preadv (ompio_file_t *fh)
+{
+    mca_common_ompio_read_cache_t *cache = NULL;
+    mca_common_ompio_cache_block_t *blk = NULL;
+    mca_common_ompio_io_array_t *io_array = fh->f_io_array;
+    OMPI_MPI_OFFSET_TYPE offset = 0;
+    size_t length, boff, n;
+    ssize_t total = 0, ret;
+    char *mem;
+    int i;
+
+    if ( fh->f_atomicity ) {
+        /* reads have to see the writes of the other processes right away */
+        mca_common_ompio_read_cache_invalidate (fh);
+    }
+    else if ( !(fh->f_amode & MPI_MODE_WRONLY) ) {
+        cache = read_cache_get (fh);
+    }
+    if ( NULL == cache ) {
+        return fh->f_fbtl->fbtl_preadv (fh);
+    }
+
+    for ( i = 0; i < fh->f_num_of_io_entries; i++ ) {
+        offset = (OMPI_MPI_OFFSET_TYPE)(intptr_t) io_array[i].offset;
+        length = io_array[i].length;
+        mem    = (char *) io_array[i].memory_address;
+
+        if ( length >= cache->block_size ) {
+            /* nothing to gain by caching large pieces */
+            ret = read_cache_fbtl_read (fh, mem, offset, length, NULL);
+            if ( 0 > ret ) {
+                return ret;
+            }
+            total += ret;
+            if ( (size_t) ret < length ) {
+                return total;
+            }
+            offset += length;
+            continue;
+        }
+
+        while ( 0 < length ) {
+            ret = read_cache_block (fh, cache, (uint64_t)(offset / cache->block_size), &blk);
+            if ( OMPI_SUCCESS != ret ) {
+                return ret;
+            }
+            boff = (size_t)(offset - blk->offset);
+            if ( boff >= blk->length ) {
+                /* end of file */
+                return total;
+            }
+            n = OMPIO_MIN(length, blk->length - boff);
+            memcpy (mem, blk->buf + boff, n);
+            total  += n;
+            offset += n;
+            mem    += n;
+            length -= n;
+            if ( 0 < length && blk->length < cache->block_size ) {
+                return total;
+            }
+        }
+    }
+
+    read_cache_prefetch (fh, cache, offset);
+    return total;
+}
+
+void mca_common_ompio_read_cache_invalidate (ompio_file_t *fh)
+{
+    mca_common_ompio_read_cache_t *cache = fh->f_read_cache;
+    int i;
+
+    if ( NULL == cache ) {
+        return;
+    }
+    for ( i = 0; i < cache->num_blocks; i++ ) {
+        read_cache_drop (cache, &cache->blocks[i]);
+    }
+}
+
+void mca_common_ompio_read_cache_free (ompio_file_t *fh)
+{
+    mca_common_ompio_read_cache_t *cache = fh->f_read_cache;
+
+    if ( NULL == cache ) {
+        return;
+    }
+    mca_common_ompio_read_cache_invalidate (fh);
+    OBJ_DESTRUCT(&cache->index);
+    free (cache->blocks);
+    free (cache->memory);
+    free (cache);
+    fh->f_read_cache = NULL;
+}
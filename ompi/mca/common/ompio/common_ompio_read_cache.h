@@ -0,0 +1,56 @@
+/* -*- Mode: C; c-basic-offset:4 ; -*- */
+/*
+ * $COPYRIGHT$
+ *
+ * Additional copyrights may follow
+ *
+ * $HEADER$
+ */
+
+#ifndef MCA_COMMON_OMPIO_READ_CACHE_H
+#define MCA_COMMON_OMPIO_READ_CACHE_H
+
+#include "ompi_config.h"
+#include "opal/class/opal_hash_table.h"
+#include "ompi/request/request.h"
+#include "common_ompio.h"
+
+BEGIN_C_DECLS
+
+/*
+ * Per file read cache used by the individual read operations. The file
+ * is cached in blocks of a fixed size, replaced in LRU order. After each
+ * read the blocks touched by the next extents of the file view are
+ * prefetched through the non-blocking interface of the fbtl.
+ *
+ * The cache is enabled with the read_cache_size parameter of the ompio
+ * component. Every write, MPI_File_sync and change of the file size
+ * invalidates it, and it is bypassed while atomic mode is set.
+ */
+typedef struct mca_common_ompio_cache_block_t {
+    OMPI_MPI_OFFSET_TYPE  offset;  /* file offset of the block, -1 if unused */
+    size_t                length;  /* valid bytes, less than the block size at the end of file */
+    ompi_request_t       *req;     /* prefetch in flight, MPI_REQUEST_NULL otherwise */
+    uint64_t              stamp;   /* last access, for the LRU replacement */
+    char                 *buf;
+} mca_common_ompio_cache_block_t;
+
+struct mca_common_ompio_read_cache_t {
+    size_t                          block_size;
+    int                             num_blocks;
+    int                             prefetch;  /* number of blocks read ahead */
+    uint64_t                        clock;
+    opal_hash_table_t               index;     /* block number -> block */
+    mca_common_ompio_cache_block_t *blocks;
+    char                           *memory;
+};
+typedef struct mca_common_ompio_read_cache_t mca_common_ompio_read_cache_t;
+
+/* Replacement for fbtl_preadv going through the cache if enabled */
+OMPI_DECLSPEC ssize_t mca_common_ompio_read_cache_preadv (ompio_file_t *fh);
+OMPI_DECLSPEC void mca_common_ompio_read_cache_invalidate (ompio_file_t *fh);
+OMPI_DECLSPEC void mca_common_ompio_read_cache_free (ompio_file_t *fh);
+
+END_C_DECLS
+
+#endif /* MCA_COMMON_OMPIO_READ_CACHE_H */
@@ -0,0 +1,43 @@
+# -*- shell-script -*-
+#
+# $COPYRIGHT$
+#
+# Additional copyrights may follow
+#
+# $HEADER$
+#
+
+# MCA_fbtl_uring_CONFIG(action-if-can-compile,
+#                        [action-if-cant-compile])
+# ------------------------------------------------
+AC_DEFUN([MCA_ompi_fbtl_uring_CONFIG],[
+    OPAL_VAR_SCOPE_PUSH([fbtl_uring_happy fbtl_uring_dir])
+    AC_CONFIG_FILES([ompi/mca/fbtl/uring/Makefile])
+
+    AC_ARG_WITH([liburing], [AS_HELP_STRING([--with-liburing(=DIR)],
+                [Build the io_uring fbtl component, searching for liburing in DIR])])
+    OPAL_CHECK_WITHDIR([liburing], [$with_liburing], [include/liburing.h])
+
+    fbtl_uring_happy="no"
+
+    AS_IF([test "$with_liburing" != "no"],
+          [AS_IF([test -n "$with_liburing" && test "$with_liburing" != "yes"],
+                 [fbtl_uring_dir=$with_liburing])
+
+           # io_uring_register_files_update() is available since liburing 0.2
+           OPAL_CHECK_PACKAGE([fbtl_uring], [liburing.h], [uring], [io_uring_register_files_update], [],
+                              [$fbtl_uring_dir], [], [fbtl_uring_happy="yes"], [])
+
+           AS_IF([test "$fbtl_uring_happy" != "yes" && test -n "$with_liburing"],
+                 [AC_MSG_ERROR([liburing support requested but not found.  Aborting])])])
+
+    AS_IF([test "$fbtl_uring_happy" = "yes"],
+          [$1],
+          [$2])
+
+    # substitute in the things needed to build uring
+    AC_SUBST([fbtl_uring_CPPFLAGS])
+    AC_SUBST([fbtl_uring_LDFLAGS])
+    AC_SUBST([fbtl_uring_LIBS])
+    OPAL_VAR_SCOPE_POP
+])dnl
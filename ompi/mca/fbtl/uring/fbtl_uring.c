@@ -0,0 +1,720 @@
+/* -*- Mode: C; c-basic-offset:4 ; indent-tabs-mode:nil -*- */
+/*
+ * $COPYRIGHT$
+ *
+ * Additional copyrights may follow
+ *
+ * $HEADER$
+ */
+
+#include "ompi_config.h"
+#include "mpi.h"
+
+#include <errno.h>
+#include <limits.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include <sys/uio.h>
+#include <liburing.h>
+
+#include "opal/mca/threads/mutex.h"
+#include "opal/util/output.h"
+#include "ompi/mca/fbtl/fbtl.h"
+#include "ompi/mca/fbtl/uring/fbtl_uring.h"
+
+/*
+ * All files share a single ring per process. Completions are reaped by
+ * whoever progresses first and handed to the batch they belong to
+ * through the user data of the completion queue entry, which is why the
+ * ring, the registered file table and the per batch counters are
+ * protected by one lock. The lock is never held while blocking in the
+ * kernel or while doing fallback I/O.
+ */
+static struct io_uring mca_fbtl_uring_ring;
+/* the ring is set up by the first file the component is selected for */
+static opal_mutex_t mca_fbtl_uring_init_lock = OPAL_MUTEX_STATIC_INIT;
+static bool mca_fbtl_uring_ring_initialized = false;
+static opal_mutex_t mca_fbtl_uring_lock;
+static unsigned int mca_fbtl_uring_inflight = 0;
+/* a thread is blocked waiting for a completion. the other threads leave
+   the completion queue alone so it is guaranteed to wake up */
+static bool mca_fbtl_uring_waiting = false;
+
+/* file handle owning each slot of the registered file table */
+static ompio_file_t *mca_fbtl_uring_file_owners[FBTL_URING_MAX_FILES];
+static bool mca_fbtl_uring_files_registered = false;
+
+static char *mca_fbtl_uring_fixed_buffer = NULL;
+static bool mca_fbtl_uring_fixed_buffer_busy = false;
+
+#define MAX_ERRCOUNT 100
+/* number of completions taken off the queue at a time */
+#define MAX_REAP 32
+
+/*
+ * *******************************************************************
+ * ************************ actions structure ************************
+ * *******************************************************************
+ */
+static mca_fbtl_base_module_1_0_0_t uring =  {
+    mca_fbtl_uring_module_init,     /* initalise after being selected */
+    mca_fbtl_uring_module_finalize, /* close a module on a communicator */
+    mca_fbtl_uring_preadv,          /* blocking read */
+    mca_fbtl_uring_ipreadv,         /* non-blocking read*/
+    mca_fbtl_uring_pwritev,         /* blocking write */
+    mca_fbtl_uring_ipwritev,        /* non-blocking write */
+    mca_fbtl_uring_progress,        /* module specific progress */
+    mca_fbtl_uring_request_free,    /* free module specific data items on the request */
+    mca_fbtl_uring_check_atomicity  /* check whether atomicity is supported on this fs */
+};
+/*
+ * *******************************************************************
+ * ************************* structure ends **************************
+ * *******************************************************************
+ */
+
+int mca_fbtl_uring_component_init_query(bool enable_progress_threads,
+                                        bool enable_mpi_threads) {
+    struct io_uring probe;
+    int ret;
+
+    /* the component is only available if the kernel supports io_uring.
+       the ring and its buffer are only set up once the component has been
+       selected for a file, see mca_fbtl_uring_module_init */
+    ret = io_uring_queue_init ( 1, &probe, 0 );
+    if ( 0 > ret ) {
+        opal_output_verbose (10, 0, "mca_fbtl_uring_component_init_query: io_uring_queue_init failed: %s",
+                             strerror(-ret));
+        return OMPI_ERR_NOT_AVAILABLE;
+    }
+    io_uring_queue_exit ( &probe );
+
+    return OMPI_SUCCESS;
+}
+
+struct mca_fbtl_base_module_1_0_0_t *
+mca_fbtl_uring_component_file_query (ompio_file_t *fh, int *priority) {
+   *priority = mca_fbtl_uring_priority;
+
+   return &uring;
+}
+
+int mca_fbtl_uring_component_file_unquery (ompio_file_t *file) {
+   /* This function might be needed for some purposes later. for now it
+    * does not have anything to do since there are no steps which need
+    * to be undone if this module is not selected */
+
+   return OMPI_SUCCESS;
+}
+
+int mca_fbtl_uring_ring_init ( void )
+{
+    int i, ret;
+
+    OPAL_THREAD_LOCK(&mca_fbtl_uring_init_lock);
+    if ( mca_fbtl_uring_ring_initialized ) {
+        OPAL_THREAD_UNLOCK(&mca_fbtl_uring_init_lock);
+        return OMPI_SUCCESS;
+    }
+
+    ret = io_uring_queue_init ( mca_fbtl_uring_entries, &mca_fbtl_uring_ring, 0 );
+    if ( 0 > ret ) {
+        OPAL_THREAD_UNLOCK(&mca_fbtl_uring_init_lock);
+        opal_output_verbose (10, 0, "mca_fbtl_uring_ring_init: io_uring_queue_init failed: %s",
+                             strerror(-ret));
+        return OMPI_ERR_NOT_AVAILABLE;
+    }
+
+    if ( mca_fbtl_uring_registered_files ) {
+        int files[FBTL_URING_MAX_FILES];
+
+        /* start with an empty table, files are added on their first access */
+        for ( i=0; i < FBTL_URING_MAX_FILES; i++ ) {
+            files[i] = -1;
+            mca_fbtl_uring_file_owners[i] = NULL;
+        }
+        ret = io_uring_register_files ( &mca_fbtl_uring_ring, files, FBTL_URING_MAX_FILES );
+        mca_fbtl_uring_files_registered = ( 0 == ret );
+    }
+
+    if ( 0 < mca_fbtl_uring_fixed_buffer_size ) {
+        struct iovec iov;
+
+        if ( 0 == posix_memalign ( (void **) &mca_fbtl_uring_fixed_buffer, sysconf(_SC_PAGESIZE),
+                                   mca_fbtl_uring_fixed_buffer_size )) {
+            iov.iov_base = mca_fbtl_uring_fixed_buffer;
+            iov.iov_len  = mca_fbtl_uring_fixed_buffer_size;
+            if ( 0 != io_uring_register_buffers ( &mca_fbtl_uring_ring, &iov, 1 )) {
+                /* most likely RLIMIT_MEMLOCK. continue without the buffer */
+                free ( mca_fbtl_uring_fixed_buffer );
+                mca_fbtl_uring_fixed_buffer = NULL;
+            }
+        }
+        else {
+            mca_fbtl_uring_fixed_buffer = NULL;
+        }
+    }
+
+    OBJ_CONSTRUCT(&mca_fbtl_uring_lock, opal_mutex_t);
+    mca_fbtl_uring_inflight = 0;
+    mca_fbtl_uring_waiting = false;
+    mca_fbtl_uring_fixed_buffer_busy = false;
+    mca_fbtl_uring_ring_initialized = true;
+    OPAL_THREAD_UNLOCK(&mca_fbtl_uring_init_lock);
+
+    return OMPI_SUCCESS;
+}
+
+void mca_fbtl_uring_ring_fini ( void )
+{
+    if ( !mca_fbtl_uring_ring_initialized ) {
+        return;
+    }
+
+    /* tearing down the ring also drops the registered files and buffers */
+    io_uring_queue_exit ( &mca_fbtl_uring_ring );
+    if ( NULL != mca_fbtl_uring_fixed_buffer ) {
+        free ( mca_fbtl_uring_fixed_buffer );
+        mca_fbtl_uring_fixed_buffer = NULL;
+    }
+    mca_fbtl_uring_files_registered = false;
+
+    OBJ_DESTRUCT(&mca_fbtl_uring_lock);
+    mca_fbtl_uring_ring_initialized = false;
+}
+
+int mca_fbtl_uring_module_init (ompio_file_t *file) {
+    /* the module is selected before the file is opened. the descriptor is
+       registered with the ring on the first access of the file */
+    return mca_fbtl_uring_ring_init ();
+}
+
+
+int mca_fbtl_uring_module_finalize (ompio_file_t *file) {
+    int i, fd = -1;
+
+    if ( !mca_fbtl_uring_files_registered ) {
+        return OMPI_SUCCESS;
+    }
+
+    /* common ompio finalizes the fbtl module before the file is closed,
+       the ring must not keep a reference to it */
+    OPAL_THREAD_LOCK(&mca_fbtl_uring_lock);
+    for ( i=0; i < FBTL_URING_MAX_FILES; i++ ) {
+        if ( file == mca_fbtl_uring_file_owners[i] ) {
+            (void) io_uring_register_files_update ( &mca_fbtl_uring_ring, i, &fd, 1 );
+            mca_fbtl_uring_file_owners[i] = NULL;
+            break;
+        }
+    }
+    OPAL_THREAD_UNLOCK(&mca_fbtl_uring_lock);
+
+    return OMPI_SUCCESS;
+}
+
+/* Returns the slot of the file in the registered file table, registering
+   it if it does not have one yet. Returns -1 if the file has to be used
+   through its descriptor. Called with the ring lock held. */
+static int mca_fbtl_uring_file_index ( ompio_file_t *fh )
+{
+    int i, free_slot = -1;
+
+    if ( !mca_fbtl_uring_files_registered || 0 > fh->fd ) {
+        return -1;
+    }
+
+    for ( i=0; i < FBTL_URING_MAX_FILES; i++ ) {
+        if ( fh == mca_fbtl_uring_file_owners[i] ) {
+            return i;
+        }
+        if ( -1 == free_slot && NULL == mca_fbtl_uring_file_owners[i] ) {
+            free_slot = i;
+        }
+    }
+
+    /* if the table is full the file is simply used through its descriptor */
+    if ( -1 == free_slot ||
+         1 != io_uring_register_files_update ( &mca_fbtl_uring_ring, free_slot, &fh->fd, 1 )) {
+        return -1;
+    }
+    mca_fbtl_uring_file_owners[free_slot] = fh;
+
+    return free_slot;
+}
+
+/*
+ * The posix component locks every pwritev/preadv call separately.
+ * Here all operations of a batch are in flight at the same time, so a
+ * single lock covering the extent of the batch is held until the last
+ * operation completed.
+ */
+static int mca_fbtl_uring_lock_batch ( mca_fbtl_uring_request_data_t *data, int op )
+{
+    ompio_file_t *fh = data->fh;
+    off_t start, end;
+    int i, ret, err_count=0;
+
+    if ( !fh->f_atomicity && !(fh->f_flags & OMPIO_LOCK_ENTIRE_FILE) &&
+         ((fh->f_flags & OMPIO_LOCK_NEVER) || (fh->f_flags & OMPIO_LOCK_NOT_THIS_OP)) ) {
+        return OMPI_SUCCESS;
+    }
+
+    if ( fh->f_flags & OMPIO_LOCK_ENTIRE_FILE ) {
+        start = 0;
+        end   = 0;
+    }
+    else {
+        start = data->ops[0].offset;
+        end   = data->ops[0].offset + (off_t)data->ops[0].length;
+        for ( i=1; i < data->op_count; i++ ) {
+            if ( data->ops[i].offset < start ) {
+                start = data->ops[i].offset;
+            }
+            if ( data->ops[i].offset + (off_t)data->ops[i].length > end ) {
+                end = data->ops[i].offset + (off_t)data->ops[i].length;
+            }
+        }
+        if ( end == start ) {
+            return OMPI_SUCCESS;
+        }
+    }
+
+    data->lock.l_type   = op;
+    data->lock.l_whence = SEEK_SET;
+    data->lock.l_start  = start;
+    data->lock.l_len    = end - start;
+    data->lock.l_pid    = 0;
+
+    do {
+        errno=0;
+        ret = fcntl ( fh->fd, F_SETLKW, &data->lock);
+        if ( ret ) {
+            err_count++;
+        }
+    } while (  ret && ((errno == EINTR) || ((errno == EINPROGRESS) && err_count < MAX_ERRCOUNT )));
+
+    if ( ret ) {
+        opal_output(1, "mca_fbtl_uring_lock_batch: error in fcntl(): %s", strerror(errno));
+        return OMPI_ERROR;
+    }
+
+    data->locked = true;
+    return OMPI_SUCCESS;
+}
+
+static void mca_fbtl_uring_unlock_batch ( mca_fbtl_uring_request_data_t *data )
+{
+    if ( !data->locked ) {
+        return;
+    }
+
+    data->lock.l_type = F_UNLCK;
+    fcntl ( data->fh->fd, F_SETLK, &data->lock);
+    data->locked = false;
+}
+
+int mca_fbtl_uring_batch_create ( ompio_file_t *fh, int type, mca_fbtl_uring_request_data_t **out )
+{
+    mca_fbtl_uring_request_data_t *data;
+    mca_fbtl_uring_op_t *op;
+    size_t fixed_used = 0;
+    int i, ret;
+
+    if ( NULL == fh->f_io_array || 0 >= fh->f_num_of_io_entries ) {
+        return OMPI_ERROR;
+    }
+
+    data = (mca_fbtl_uring_request_data_t *) calloc ( 1, sizeof (mca_fbtl_uring_request_data_t));
+    if ( NULL == data ) {
+        opal_output (1,"mca_fbtl_uring_batch_create: could not allocate memory\n");
+        return OMPI_ERR_OUT_OF_RESOURCE;
+    }
+    data->ops = (mca_fbtl_uring_op_t *) malloc ( sizeof (mca_fbtl_uring_op_t) * fh->f_num_of_io_entries );
+    data->iov = (struct iovec *) malloc ( sizeof (struct iovec) * fh->f_num_of_io_entries );
+    if ( NULL == data->ops || NULL == data->iov ) {
+        opal_output (1,"mca_fbtl_uring_batch_create: could not allocate memory\n");
+        free ( data->ops );
+        free ( data->iov );
+        free ( data );
+        return OMPI_ERR_OUT_OF_RESOURCE;
+    }
+    data->type       = type;
+    data->file_index = -1;
+    data->fh         = fh;
+
+    /* one operation per run of entries that are contiguous in the file */
+    for ( i=0; i < fh->f_num_of_io_entries; i++ ) {
+        off_t offset = (off_t)(intptr_t)fh->f_io_array[i].offset;
+
+        data->iov[i].iov_base = fh->f_io_array[i].memory_address;
+        data->iov[i].iov_len  = fh->f_io_array[i].length;
+
+        if ( 0 < data->op_count ) {
+            op = &data->ops[data->op_count-1];
+            if ( op->offset + (off_t)op->length == offset && op->iov_count < IOV_MAX ) {
+                op->length += fh->f_io_array[i].length;
+                op->iov_count++;
+                continue;
+            }
+        }
+
+        op = &data->ops[data->op_count++];
+        op->data      = data;
+        op->offset    = offset;
+        op->length    = fh->f_io_array[i].length;
+        op->iov       = &data->iov[i];
+        op->iov_count = 1;
+        op->fixed     = NULL;
+    }
+
+    OPAL_THREAD_LOCK(&mca_fbtl_uring_lock);
+    data->file_index = mca_fbtl_uring_file_index ( fh );
+    if ( NULL != mca_fbtl_uring_fixed_buffer && !mca_fbtl_uring_fixed_buffer_busy ) {
+        mca_fbtl_uring_fixed_buffer_busy = true;
+        data->fixed_buffer = true;
+    }
+    OPAL_THREAD_UNLOCK(&mca_fbtl_uring_lock);
+
+    if ( data->fixed_buffer ) {
+        /* stage single buffer operations through the registered buffer as
+           long as there is room left */
+        for ( i=0; i < data->op_count; i++ ) {
+            op = &data->ops[i];
+            if ( 1 != op->iov_count || op->length > mca_fbtl_uring_fixed_buffer_size - fixed_used ) {
+                continue;
+            }
+            op->fixed = mca_fbtl_uring_fixed_buffer + fixed_used;
+            fixed_used += op->length;
+            if ( FBTL_URING_WRITE == type ) {
+                memcpy ( op->fixed, op->iov[0].iov_base, op->length );
+            }
+        }
+    }
+
+    ret = mca_fbtl_uring_lock_batch ( data, (FBTL_URING_WRITE == type) ? F_WRLCK : F_RDLCK );
+    if ( OMPI_SUCCESS != ret ) {
+        mca_fbtl_uring_batch_free ( data );
+        return ret;
+    }
+
+    *out = data;
+    return OMPI_SUCCESS;
+}
+
+/* Finish the remainder of an operation after a short transfer with
+   plain system calls. Returns the number of bytes transferred or -1. */
+static ssize_t mca_fbtl_uring_op_finish ( mca_fbtl_uring_op_t *op, size_t done )
+{
+    int fd = op->data->fh->fd;
+    off_t pos = op->offset + (off_t)done;
+    ssize_t total = 0, ret_code;
+    int i;
+
+    for ( i=0; i < op->iov_count; i++ ) {
+        char *base = (char *) op->iov[i].iov_base;
+        size_t len = op->iov[i].iov_len;
+
+        if ( done >= len ) {
+            done -= len;
+            continue;
+        }
+        base += done;
+        len  -= done;
+        done  = 0;
+
+        while ( 0 < len ) {
+            if ( FBTL_URING_WRITE == op->data->type ) {
+                ret_code = pwrite ( fd, base, len, pos );
+            }
+            else {
+                ret_code = pread ( fd, base, len, pos );
+            }
+            if ( -1 == ret_code ) {
+                if ( EINTR == errno ) {
+                    continue;
+                }
+                return -1;
+            }
+            if ( 0 == ret_code ) {
+                /* end of file */
+                return total;
+            }
+            base  += ret_code;
+            len   -= ret_code;
+            pos   += ret_code;
+            total += ret_code;
+        }
+    }
+
+    return total;
+}
+
+/* Called without the ring lock held, the fallback system calls may block.
+   The batch is updated under the lock once the operation is finished. */
+static void mca_fbtl_uring_op_complete ( mca_fbtl_uring_op_t *op, int res )
+{
+    mca_fbtl_uring_request_data_t *data = op->data;
+    bool retry = false;
+    ssize_t bytes = 0, ret_code;
+    int error = 0;
+
+    if ( 0 > res ) {
+        if ( -EAGAIN != res && -EINTR != res ) {
+            opal_output(1, "mca_fbtl_uring: error in %s: %s",
+                        (FBTL_URING_WRITE == data->type) ? "write" : "read", strerror(-res));
+            error = -res;
+            goto exit;
+        }
+        res   = 0;
+        retry = true;
+    }
+
+    if ( NULL != op->fixed && FBTL_URING_READ == data->type ) {
+        memcpy ( op->iov[0].iov_base, op->fixed, res );
+    }
+    bytes = res;
+
+    /* short reads only happen at the end of the file */
+    if ( (size_t)res < op->length && (retry || 0 < res || FBTL_URING_WRITE == data->type) ) {
+        ret_code = mca_fbtl_uring_op_finish ( op, (size_t)res );
+        if ( -1 == ret_code ) {
+            opal_output(1, "mca_fbtl_uring: error in %s: %s",
+                        (FBTL_URING_WRITE == data->type) ? "pwrite" : "pread", strerror(errno));
+            error = errno;
+            goto exit;
+        }
+        bytes += ret_code;
+    }
+
+ exit:
+    OPAL_THREAD_LOCK(&mca_fbtl_uring_lock);
+    data->total_len += bytes;
+    if ( 0 != error && 0 == data->error ) {
+        data->error = error;
+    }
+    data->open_ops--;
+    OPAL_THREAD_UNLOCK(&mca_fbtl_uring_lock);
+}
+
+int mca_fbtl_uring_batch_submit ( mca_fbtl_uring_request_data_t *data )
+{
+    struct io_uring_sqe *sqe;
+    mca_fbtl_uring_op_t *op;
+    int fd, count = 0, ret = OMPI_SUCCESS;
+
+    fd = (-1 != data->file_index) ? data->file_index : data->fh->fd;
+
+    OPAL_THREAD_LOCK(&mca_fbtl_uring_lock);
+    /* never have more operations in flight than the completion queue can hold */
+    while ( data->next_op < data->op_count && mca_fbtl_uring_inflight < mca_fbtl_uring_entries ) {
+        sqe = io_uring_get_sqe ( &mca_fbtl_uring_ring );
+        if ( NULL == sqe ) {
+            break;
+        }
+        op = &data->ops[data->next_op++];
+        if ( NULL != op->fixed ) {
+            if ( FBTL_URING_WRITE == data->type ) {
+                io_uring_prep_write_fixed ( sqe, fd, op->fixed, op->length, op->offset, 0 );
+            }
+            else {
+                io_uring_prep_read_fixed ( sqe, fd, op->fixed, op->length, op->offset, 0 );
+            }
+        }
+        else if ( FBTL_URING_WRITE == data->type ) {
+            io_uring_prep_writev ( sqe, fd, op->iov, op->iov_count, op->offset );
+        }
+        else {
+            io_uring_prep_readv ( sqe, fd, op->iov, op->iov_count, op->offset );
+        }
+        if ( -1 != data->file_index ) {
+            sqe->flags |= IOSQE_FIXED_FILE;
+        }
+        io_uring_sqe_set_data ( sqe, op );
+        op->sqe = sqe;
+        data->open_ops++;
+        mca_fbtl_uring_inflight++;
+        count++;
+    }
+
+    if ( 0 < count ) {
+        /* a single system call for the whole batch. entries that could
+           not be submitted yet stay in the queue for the next call */
+        int sret = io_uring_submit ( &mca_fbtl_uring_ring );
+        if ( 0 > sret && -EAGAIN != sret && -EBUSY != sret && -EINTR != sret ) {
+            int i;
+
+            opal_output(1, "mca_fbtl_uring_batch_submit: error in io_uring_submit(): %s", strerror(-sret));
+            /* none of the entries was consumed by the kernel, but they are
+               visible in the submission queue and would be picked up by the
+               next submit of any batch. turn them into no-ops that do not
+               refer to this batch, they complete as orphans and are still
+               accounted in the inflight count until then. */
+            for ( i = data->next_op - count; i < data->next_op; i++ ) {
+                io_uring_prep_nop ( data->ops[i].sqe );
+                io_uring_sqe_set_data ( data->ops[i].sqe, NULL );
+            }
+            data->open_ops -= count;
+            data->error = -sret;
+            ret = OMPI_ERROR;
+        }
+    }
+    OPAL_THREAD_UNLOCK(&mca_fbtl_uring_lock);
+
+    return ret;
+}
+
+/* Reap all available completions, whichever batch they belong to. If
+   wait is set block until at least one operation completed. */
+static int mca_fbtl_uring_reap ( bool wait )
+{
+    mca_fbtl_uring_op_t *ops[MAX_REAP];
+    int res[MAX_REAP];
+    struct io_uring_cqe *cqe;
+    int i, n, sret, count = 0;
+
+    OPAL_THREAD_LOCK(&mca_fbtl_uring_lock);
+    if ( mca_fbtl_uring_waiting ) {
+        /* the waiting thread reaps the completions once it wakes up */
+        OPAL_THREAD_UNLOCK(&mca_fbtl_uring_lock);
+        return 0;
+    }
+    if ( wait && 0 < mca_fbtl_uring_inflight ) {
+        /* flush entries left in the submission queue before going to sleep.
+           only wait if the kernel has all of them, otherwise nothing might
+           ever complete */
+        sret = io_uring_submit ( &mca_fbtl_uring_ring );
+        if ( 0 <= sret || -EBUSY == sret ) {
+            mca_fbtl_uring_waiting = true;
+            OPAL_THREAD_UNLOCK(&mca_fbtl_uring_lock);
+            /* does not touch the submission queue, so other threads can
+               keep on submitting in the meantime */
+            (void) io_uring_wait_cqe ( &mca_fbtl_uring_ring, &cqe );
+            OPAL_THREAD_LOCK(&mca_fbtl_uring_lock);
+            mca_fbtl_uring_waiting = false;
+        }
+    }
+    OPAL_THREAD_UNLOCK(&mca_fbtl_uring_lock);
+
+    do {
+        n = 0;
+        OPAL_THREAD_LOCK(&mca_fbtl_uring_lock);
+        while ( n < MAX_REAP && 0 == io_uring_peek_cqe ( &mca_fbtl_uring_ring, &cqe )) {
+            ops[n] = (mca_fbtl_uring_op_t *) io_uring_cqe_get_data ( cqe );
+            res[n] = cqe->res;
+            io_uring_cqe_seen ( &mca_fbtl_uring_ring, cqe );
+            mca_fbtl_uring_inflight--;
+            n++;
+        }
+        OPAL_THREAD_UNLOCK(&mca_fbtl_uring_lock);
+
+        for ( i=0; i < n; i++ ) {
+            /* no-ops left behind by a failed submit do not have an operation */
+            if ( NULL != ops[i] ) {
+                mca_fbtl_uring_op_complete ( ops[i], res[i] );
+            }
+        }
+        count += n;
+    } while ( MAX_REAP == n );
+
+    return count;
+}
+
+static bool mca_fbtl_uring_batch_done ( mca_fbtl_uring_request_data_t *data )
+{
+    bool done;
+
+    OPAL_THREAD_LOCK(&mca_fbtl_uring_lock);
+    done = ( 0 == data->open_ops && (data->next_op == data->op_count || 0 != data->error) );
+    OPAL_THREAD_UNLOCK(&mca_fbtl_uring_lock);
+
+    return done;
+}
+
+void mca_fbtl_uring_batch_free ( mca_fbtl_uring_request_data_t *data )
+{
+    mca_fbtl_uring_unlock_batch ( data );
+
+    if ( data->fixed_buffer ) {
+        OPAL_THREAD_LOCK(&mca_fbtl_uring_lock);
+        mca_fbtl_uring_fixed_buffer_busy = false;
+        OPAL_THREAD_UNLOCK(&mca_fbtl_uring_lock);
+        data->fixed_buffer = false;
+    }
+
+    free ( data->ops );
+    free ( data->iov );
+    free ( data );
+}
+
+ssize_t mca_fbtl_uring_batch_run ( ompio_file_t *fh, int type )
+{
+    mca_fbtl_uring_request_data_t *data;
+    ssize_t bytes;
+    int ret;
+
+    ret = mca_fbtl_uring_batch_create ( fh, type, &data );
+    if ( OMPI_SUCCESS != ret ) {
+        return ret;
+    }
+
+    while ( !mca_fbtl_uring_batch_done ( data )) {
+        if ( 0 == data->error ) {
+            (void) mca_fbtl_uring_batch_submit ( data );
+        }
+        (void) mca_fbtl_uring_reap ( true );
+    }
+
+    bytes = ( 0 == data->error ) ? data->total_len : OMPI_ERROR;
+    mca_fbtl_uring_batch_free ( data );
+
+    return bytes;
+}
+
+bool mca_fbtl_uring_progress ( mca_ompio_request_t *req)
+{
+    mca_fbtl_uring_request_data_t *data=(mca_fbtl_uring_request_data_t *)req->req_data;
+
+    if ( 0 == data->error ) {
+        (void) mca_fbtl_uring_batch_submit ( data );
+    }
+    (void) mca_fbtl_uring_reap ( false );
+
+    if ( !mca_fbtl_uring_batch_done ( data )) {
+        return false;
+    }
+
+    /* all pending operations are finished for this request */
+    mca_fbtl_uring_unlock_batch ( data );
+    req->req_ompi.req_status.MPI_ERROR = ( 0 == data->error ) ? OMPI_SUCCESS : OMPI_ERROR;
+    req->req_ompi.req_status._ucount = data->total_len;
+
+    return true;
+}
+
+void mca_fbtl_uring_request_free ( mca_ompio_request_t *req)
+{
+    /* Free the fbtl specific data structures */
+    mca_fbtl_uring_request_data_t *data=(mca_fbtl_uring_request_data_t *)req->req_data;
+    if (NULL != data ) {
+        mca_fbtl_uring_batch_free ( data );
+        req->req_data = NULL;
+    }
+}
+
+bool mca_fbtl_uring_check_atomicity ( ompio_file_t *file)
+{
+    struct flock lock;
+
+    lock.l_type   = F_WRLCK;
+    lock.l_whence = SEEK_SET;
+    lock.l_start  = 0;
+    lock.l_len    = 0;
+    lock.l_pid    = 0;
+
+    if (fcntl(file->fd, F_GETLK, &lock) < 0) {
+        return false;
+    }
+
+    return true;
+}
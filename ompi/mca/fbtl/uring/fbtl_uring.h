@@ -0,0 +1,112 @@
+/*
+ * $COPYRIGHT$
+ *
+ * Additional copyrights may follow
+ *
+ * $HEADER$
+ */
+
+#ifndef MCA_FBTL_URING_H
+#define MCA_FBTL_URING_H
+
+#include "ompi_config.h"
+
+#include <fcntl.h>
+#include <sys/uio.h>
+
+#include "ompi/mca/mca.h"
+#include "ompi/mca/fbtl/fbtl.h"
+#include "ompi/mca/common/ompio/common_ompio.h"
+#include "ompi/mca/common/ompio/common_ompio_request.h"
+
+extern int mca_fbtl_uring_priority;
+extern unsigned int mca_fbtl_uring_entries;
+extern bool mca_fbtl_uring_registered_files;
+extern size_t mca_fbtl_uring_fixed_buffer_size;
+
+BEGIN_C_DECLS
+
+int mca_fbtl_uring_component_init_query(bool enable_progress_threads,
+                                        bool enable_mpi_threads);
+struct mca_fbtl_base_module_1_0_0_t *
+mca_fbtl_uring_component_file_query (ompio_file_t *file, int *priority);
+int mca_fbtl_uring_component_file_unquery (ompio_file_t *file);
+
+int mca_fbtl_uring_module_init (ompio_file_t *file);
+int mca_fbtl_uring_module_finalize (ompio_file_t *file);
+
+OMPI_MODULE_DECLSPEC extern mca_fbtl_base_component_2_0_0_t mca_fbtl_uring_component;
+/*
+ * ******************************************************************
+ * ********* functions which are implemented in this module *********
+ * ******************************************************************
+ */
+
+ssize_t mca_fbtl_uring_preadv (ompio_file_t *file );
+ssize_t mca_fbtl_uring_pwritev (ompio_file_t *file );
+ssize_t mca_fbtl_uring_ipreadv (ompio_file_t *file,
+                                ompi_request_t *request);
+ssize_t mca_fbtl_uring_ipwritev (ompio_file_t *file,
+                                 ompi_request_t *request);
+
+bool mca_fbtl_uring_progress     ( mca_ompio_request_t *req);
+void mca_fbtl_uring_request_free ( mca_ompio_request_t *req);
+bool mca_fbtl_uring_check_atomicity ( ompio_file_t *file);
+
+int  mca_fbtl_uring_ring_init ( void );
+void mca_fbtl_uring_ring_fini ( void );
+
+struct mca_fbtl_uring_request_data_t;
+struct io_uring_sqe;
+
+/* A single submission queue entry: one entry of the io array, or a
+   run of entries that are contiguous in the file */
+struct mca_fbtl_uring_op_t {
+    struct mca_fbtl_uring_request_data_t *data; /* batch this operation belongs to */
+    off_t          offset;              /* file offset */
+    size_t         length;              /* total number of bytes */
+    struct iovec  *iov;                 /* memory of the operation */
+    int            iov_count;           /* number of iovec entries */
+    char          *fixed;               /* slice of the registered buffer, NULL if not used */
+    struct io_uring_sqe *sqe;           /* submission queue entry, only valid until submitted */
+};
+typedef struct mca_fbtl_uring_op_t mca_fbtl_uring_op_t;
+
+struct mca_fbtl_uring_request_data_t {
+    int                  type;          /* read or write */
+    int                  op_count;      /* total number of operations */
+    int                  next_op;       /* first operation not yet submitted */
+    int                  open_ops;      /* submitted operations not yet completed */
+    mca_fbtl_uring_op_t *ops;           /* operations of this batch */
+    struct iovec        *iov;           /* iovec entries referenced by the operations */
+    ssize_t              total_len;     /* total amount of data read/written */
+    int                  error;         /* first error encountered */
+    bool                 fixed_buffer;  /* batch owns the registered buffer */
+    struct flock         lock;          /* lock used for certain file systems */
+    bool                 locked;        /* lock is being held */
+    int                  file_index;    /* index of the registered file, -1 if not registered */
+    ompio_file_t        *fh;            /* pointer back to the file handle */
+};
+typedef struct mca_fbtl_uring_request_data_t mca_fbtl_uring_request_data_t;
+
+int  mca_fbtl_uring_batch_create ( ompio_file_t *fh, int type, mca_fbtl_uring_request_data_t **data );
+int  mca_fbtl_uring_batch_submit ( mca_fbtl_uring_request_data_t *data );
+void mca_fbtl_uring_batch_free ( mca_fbtl_uring_request_data_t *data );
+ssize_t mca_fbtl_uring_batch_run ( ompio_file_t *fh, int type );
+
+/* define constants for io_uring requests */
+#define FBTL_URING_READ 1
+#define FBTL_URING_WRITE 2
+
+/* maximum number of files registered with the ring */
+#define FBTL_URING_MAX_FILES 64
+
+/*
+ * ******************************************************************
+ * ************ functions implemented in this module end ************
+ * ******************************************************************
+ */
+
+END_C_DECLS
+
+#endif /* MCA_FBTL_URING_H */
@@ -0,0 +1,112 @@
+/* -*- Mode: C; c-basic-offset:4 ; indent-tabs-mode:nil -*- */
+/*
+ * $COPYRIGHT$
+ *
+ * Additional copyrights may follow
+ *
+ * $HEADER$
+ *
+ * These symbols are in a file by themselves to provide nice linker
+ * semantics.  Since linkers generally pull in symbols by object
+ * files, keeping these symbols as the only symbols in this file
+ * prevents utility programs such as "ompi_info" from having to import
+ * entire components just to query their version and parameters.
+ */
+
+#include "ompi_config.h"
+#include "fbtl_uring.h"
+#include "mpi.h"
+
+/*
+ * Public string showing the fbtl uring component version number
+ */
+const char *mca_fbtl_uring_component_version_string =
+  "OMPI/MPI uring FBTL MCA component version " OMPI_VERSION;
+
+int mca_fbtl_uring_priority = 5;
+unsigned int mca_fbtl_uring_entries = 256;
+bool mca_fbtl_uring_registered_files = true;
+size_t mca_fbtl_uring_fixed_buffer_size = 0;
+/*
+ * Private functions
+ */
+static int register_component(void);
+static int close_component(void);
+
+/*
+ * Instantiate the public struct with all of our public information
+ * and pointers to our public functions in it
+ */
+mca_fbtl_base_component_2_0_0_t mca_fbtl_uring_component = {
+
+    /* First, the mca_component_t struct containing meta information
+       about the component itself */
+
+    .fbtlm_version = {
+        MCA_FBTL_BASE_VERSION_2_0_0,
+
+        /* Component name and version */
+        .mca_component_name = "uring",
+        MCA_BASE_MAKE_VERSION(component, OMPI_MAJOR_VERSION, OMPI_MINOR_VERSION,
+                              OMPI_RELEASE_VERSION),
+        .mca_close_component = close_component,
+        .mca_register_component_params = register_component,
+    },
+    .fbtlm_data = {
+        /* This component is checkpointable */
+      MCA_BASE_METADATA_PARAM_CHECKPOINT
+    },
+    .fbtlm_init_query = mca_fbtl_uring_component_init_query,      /* get thread level */
+    .fbtlm_file_query = mca_fbtl_uring_component_file_query,      /* get priority and actions */
+    .fbtlm_file_unquery = mca_fbtl_uring_component_file_unquery,  /* undo what was done by previous function */
+};
+
+static int register_component(void)
+{
+    mca_fbtl_uring_priority = 5;
+    (void) mca_base_component_var_register(&mca_fbtl_uring_component.fbtlm_version,
+                                           "priority", "Priority of the fbtl uring component. The posix component "
+                                           "uses a priority of 50 on UFS file systems. Default: 5.",
+                                           MCA_BASE_VAR_TYPE_INT, NULL, 0, 0,
+                                           OPAL_INFO_LVL_9,
+                                           MCA_BASE_VAR_SCOPE_READONLY,
+                                           &mca_fbtl_uring_priority);
+
+    mca_fbtl_uring_entries = 256;
+    (void) mca_base_component_var_register(&mca_fbtl_uring_component.fbtlm_version,
+                                           "entries", "Number of submission queue entries of the io_uring instance. "
+                                           "Larger io arrays are submitted in several batches. Default: 256.",
+                                           MCA_BASE_VAR_TYPE_UNSIGNED_INT, NULL, 0, 0,
+                                           OPAL_INFO_LVL_9,
+                                           MCA_BASE_VAR_SCOPE_READONLY,
+                                           &mca_fbtl_uring_entries );
+
+    mca_fbtl_uring_registered_files = true;
+    (void) mca_base_component_var_register(&mca_fbtl_uring_component.fbtlm_version,
+                                           "registered_files", "Register open files with the io_uring instance to "
+                                           "avoid the file lookup on every operation. Default: true.",
+                                           MCA_BASE_VAR_TYPE_BOOL, NULL, 0, 0,
+                                           OPAL_INFO_LVL_9,
+                                           MCA_BASE_VAR_SCOPE_READONLY,
+                                           &mca_fbtl_uring_registered_files );
+
+    mca_fbtl_uring_fixed_buffer_size = 0;
+    (void) mca_base_component_var_register(&mca_fbtl_uring_component.fbtlm_version,
+                                           "fixed_buffer_size", "Size in bytes of a buffer registered with the io_uring "
+                                           "instance. Small operations are staged through this buffer, which avoids "
+                                           "mapping the user pages for every operation. 0 disables the registered "
+                                           "buffer. Default: 0.",
+                                           MCA_BASE_VAR_TYPE_SIZE_T, NULL, 0, 0,
+                                           OPAL_INFO_LVL_9,
+                                           MCA_BASE_VAR_SCOPE_READONLY,
+                                           &mca_fbtl_uring_fixed_buffer_size );
+
+    return OMPI_SUCCESS;
+}
+
+static int close_component(void)
+{
+    mca_fbtl_uring_ring_fini();
+
+    return OMPI_SUCCESS;
+}
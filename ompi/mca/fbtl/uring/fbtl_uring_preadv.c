@@ -0,0 +1,44 @@
+/*
+ * $COPYRIGHT$
+ *
+ * Additional copyrights may follow
+ *
+ * $HEADER$
+ */
+
+#include "ompi_config.h"
+#include "fbtl_uring.h"
+
+#include "mpi.h"
+#include "ompi/constants.h"
+#include "ompi/mca/fbtl/fbtl.h"
+
+ssize_t mca_fbtl_uring_preadv (ompio_file_t *fh )
+{
+    /* submit the whole io array at once and wait for it */
+    return mca_fbtl_uring_batch_run ( fh, FBTL_URING_READ );
+}
+
+ssize_t mca_fbtl_uring_ipreadv (ompio_file_t *fh,
+                               ompi_request_t *request)
+{
+    mca_fbtl_uring_request_data_t *data;
+    mca_ompio_request_t *req = (mca_ompio_request_t *) request;
+    int ret;
+
+    ret = mca_fbtl_uring_batch_create ( fh, FBTL_URING_READ, &data );
+    if ( OMPI_SUCCESS != ret ) {
+        return ret;
+    }
+
+    /* operations that do not fit into the ring right now are submitted
+       from the progress function. errors are reported through the
+       request once all submitted operations completed */
+    (void) mca_fbtl_uring_batch_submit ( data );
+
+    req->req_data = data;
+    req->req_progress_fn = mca_fbtl_uring_progress;
+    req->req_free_fn     = mca_fbtl_uring_request_free;
+
+    return OMPI_SUCCESS;
+}
@@ -41,6 +41,16 @@ extern int mca_fcoll_vulcan_priority;
 extern int mca_fcoll_vulcan_num_groups;
 extern int mca_fcoll_vulcan_write_chunksize;
 extern int mca_fcoll_vulcan_async_io;
+extern int mca_fcoll_vulcan_pipeline_depth;
+extern int mca_fcoll_vulcan_adaptive_cycle_size;
+
+/* Measurements of previous write_all calls on a file, used by the
+   aggregators to pick the cycle size. Hung off fh->f_fcoll_data. */
+typedef struct mca_fcoll_vulcan_cycle_stats_t {
+    MPI_Aint cycle_size[2];  /* cycle size of the last two samples */
+    double   cycle_time[2];  /* time per cycle of the slower pipeline stage */
+    int      num_samples;
+} mca_fcoll_vulcan_cycle_stats_t;
 
 OMPI_MODULE_DECLSPEC extern mca_fcoll_base_component_2_0_0_t mca_fcoll_vulcan_component;
 
@@ -44,6 +44,8 @@ int mca_fcoll_vulcan_priority = 10;
 int mca_fcoll_vulcan_num_groups = 1;
 int mca_fcoll_vulcan_write_chunksize = -1;
 int mca_fcoll_vulcan_async_io = 0;
+int mca_fcoll_vulcan_pipeline_depth = 2;
+int mca_fcoll_vulcan_adaptive_cycle_size = 1;
 
 /*
  * Local function
@@ -111,5 +113,25 @@ vulcan_register(void)
                                            OPAL_INFO_LVL_9,
                                            MCA_BASE_VAR_SCOPE_READONLY, &mca_fcoll_vulcan_async_io);
 
+    mca_fcoll_vulcan_pipeline_depth = 2;
+    (void) mca_base_component_var_register(&mca_fcoll_vulcan_component.fcollm_version,
+                                           "pipeline_depth", "Number of cycle buffers per aggregator in write_all. The "
+                                           "aggregator buffer size (bytes_per_agg) is split evenly among them. Minimum: 2",
+                                           MCA_BASE_VAR_TYPE_INT, NULL, 0, 0,
+                                           OPAL_INFO_LVL_9,
+                                           MCA_BASE_VAR_SCOPE_READONLY, &mca_fcoll_vulcan_pipeline_depth);
+    if (mca_fcoll_vulcan_pipeline_depth < 2) {
+        mca_fcoll_vulcan_pipeline_depth = 2;
+    }
+
+    mca_fcoll_vulcan_adaptive_cycle_size = 1;
+    (void) mca_base_component_var_register(&mca_fcoll_vulcan_component.fcollm_version,
+                                           "adaptive_cycle_size", "Choose the cycle size of write_all from the shuffle and "
+                                           "write times measured in previous calls on the same file. 0: fixed cycle size "
+                                           "1: adaptive (default)",
+                                           MCA_BASE_VAR_TYPE_INT, NULL, 0, 0,
+                                           OPAL_INFO_LVL_9,
+                                           MCA_BASE_VAR_SCOPE_READONLY, &mca_fcoll_vulcan_adaptive_cycle_size);
+
     return OMPI_SUCCESS;
 }
@@ -32,6 +32,7 @@
 #include "math.h"
 #include "ompi/mca/pml/pml.h"
 #include <unistd.h>
+#include <limits.h>
 
 #define DEBUG_ON 0
 #define NOT_AGGR_INDEX -1
@@ -49,8 +50,8 @@ typedef struct mca_io_ompio_aggregator_data {
     int **blocklen_per_process;
     MPI_Aint **displs_per_process, total_bytes, bytes_per_cycle, total_bytes_written;
     MPI_Comm comm;
-    char *buf, *global_buf, *prev_global_buf;
-    ompi_datatype_t **recvtype, **prev_recvtype;
+    char *buf, *global_buf, **cycle_bufs;
+    ompi_datatype_t **recvtype, ***cycle_recvtypes;
     struct iovec *global_iov_array;
     int current_index, current_position;
     int bytes_to_write_in_cycle, bytes_remaining, procs_per_group;    
@@ -68,22 +69,29 @@ typedef struct mca_io_ompio_aggregator_data {
     _r1=_r2;                     \
     _r2=_t;}
 
-#define SWAP_AGGR_POINTERS(_aggr,_num) {                        \
+/* Keep the I/O description of the cycle just shuffled for write_init */
+#define STASH_AGGR_CYCLE(_aggr,_num) {                          \
     int _i;                                                     \
-    char *_t;                                                   \
     for (_i=0; _i<_num; _i++ ) {                                \
         _aggr[_i]->prev_io_array=_aggr[_i]->io_array;             \
         _aggr[_i]->prev_num_io_entries=_aggr[_i]->num_io_entries; \
         _aggr[_i]->prev_bytes_sent=_aggr[_i]->bytes_sent;         \
-        _aggr[_i]->prev_bytes_to_write=_aggr[_i]->bytes_to_write; \
-        _t=_aggr[_i]->prev_global_buf;                            \
-        _aggr[_i]->prev_global_buf=_aggr[_i]->global_buf;         \
-        _aggr[_i]->global_buf=_t;                                 \
-        _t=(char *)_aggr[_i]->recvtype;                           \
-        _aggr[_i]->recvtype=_aggr[_i]->prev_recvtype;             \
-        _aggr[_i]->prev_recvtype=(ompi_datatype_t **)_t;          }                                                             \
+        _aggr[_i]->prev_bytes_to_write=_aggr[_i]->bytes_to_write; }  \
 }
 
+/* Shuffle the next cycle into cycle buffer _slot of the aggregators */
+#define SELECT_AGGR_SLOT(_aggr,_num,_slot) {                    \
+    int _i;                                                     \
+    for (_i=0; _i<_num; _i++ ) {                                \
+        if (NULL != _aggr[_i]->cycle_bufs) {                    \
+            _aggr[_i]->global_buf=_aggr[_i]->cycle_bufs[_slot];   \
+            _aggr[_i]->recvtype=_aggr[_i]->cycle_recvtypes[_slot]; } } \
+}
+
+/* The adaptive cycle size stays within [max/VULCAN_CYCLE_SIZE_RANGE, max] */
+#define VULCAN_CYCLE_SIZE_RANGE 16
+#define VULCAN_CYCLE_SIZE_ALIGN 4096
+
 
 
 static int shuffle_init ( int index, int cycles, int aggregator, int rank, 
@@ -115,6 +123,9 @@ int mca_fcoll_vulcan_split_iov_array ( ompio_file_t *fh, mca_common_ompio_io_arr
 static int mca_fcoll_vulcan_minmax ( ompio_file_t *fh, struct iovec *iov, int iov_count,  int num_aggregators, 
                                      long *new_stripe_size);
 
+static long vulcan_adapt_cycle_size ( ompio_file_t *fh, long max_cycle_size, MPI_Aint total_bytes );
+static void vulcan_record_cycle_time ( ompio_file_t *fh, long cycle_size, double cycle_time );
+
 
 int mca_fcoll_vulcan_file_write_all (ompio_file_t *fh,
                                       const void *buf,
@@ -131,7 +142,10 @@ int mca_fcoll_vulcan_file_write_all (ompio_file_t *fh,
     uint32_t total_fview_count = 0;
     int local_count = 0;
     ompi_request_t **reqs = NULL;
-    ompi_request_t *req_iwrite = MPI_REQUEST_NULL;
+    ompi_request_t **write_reqs = NULL;
+    int pipeline_depth = mca_fcoll_vulcan_pipeline_depth;
+    long cycle_size;
+    double start_pipeline = 0.0;
     mca_io_ompio_aggregator_data **aggr_data=NULL;
     
     int *displs = NULL;
@@ -173,9 +187,9 @@ int mca_fcoll_vulcan_file_write_all (ompio_file_t *fh,
         goto exit;
     }
 
-    /* since we want to overlap 2 iterations, define the bytes_per_cycle to be half of what
-       the user requested */
-    bytes_per_cycle =bytes_per_cycle/2;
+    /* the aggregator keeps pipeline_depth cycles in flight, split the buffer space
+       the user requested among them */
+    bytes_per_cycle = bytes_per_cycle/pipeline_depth;
     write_chunksize = bytes_per_cycle;
     
     ret =   mca_common_ompio_decode_datatype ((struct ompio_file_t *) fh,
@@ -307,6 +321,28 @@ int mca_fcoll_vulcan_file_write_all (ompio_file_t *fh,
     comm_time += (end_comm_time - start_comm_time);
 #endif
     
+    /* All processes have to agree on the cycle size, since it determines
+       the data shuffled in each cycle. Every aggregator proposes one out
+       of its past measurements and the smallest proposal is used. */
+    if ( mca_fcoll_vulcan_adaptive_cycle_size ) {
+        cycle_size = LONG_MAX;
+        if ( NOT_AGGR_INDEX != aggr_index ) {
+            cycle_size = vulcan_adapt_cycle_size (fh, bytes_per_cycle, broken_total_lengths[aggr_index]);
+        }
+        ret = fh->f_comm->c_coll->coll_allreduce (MPI_IN_PLACE,
+                                                  &cycle_size,
+                                                  1,
+                                                  MPI_LONG,
+                                                  MPI_MIN,
+                                                  fh->f_comm,
+                                                  fh->f_comm->c_coll->coll_allreduce_module);
+        if( OMPI_SUCCESS != ret){
+            goto exit;
+        }
+        bytes_per_cycle = (int) cycle_size;
+        write_chunksize = bytes_per_cycle;
+    }
+
     cycles=0;
     for ( i=0; i<fh->f_num_aggrs; i++ ) {
 #if DEBUG_ON
@@ -521,27 +557,36 @@ int mca_fcoll_vulcan_file_write_all (ompio_file_t *fh,
             }
         
             
-            aggr_data[i]->global_buf       = (char *) malloc (bytes_per_cycle);
-            aggr_data[i]->prev_global_buf  = (char *) malloc (bytes_per_cycle);
-            if (NULL == aggr_data[i]->global_buf || NULL == aggr_data[i]->prev_global_buf){
-                opal_output(1, "OUT OF MEMORY");
-                ret = OMPI_ERR_OUT_OF_RESOURCE;
-                goto exit;
-            }
-        
-            aggr_data[i]->recvtype = (ompi_datatype_t **) malloc (fh->f_procs_per_group  * 
-                                                                  sizeof(ompi_datatype_t *));
-            aggr_data[i]->prev_recvtype = (ompi_datatype_t **) malloc (fh->f_procs_per_group  * 
-                                                                       sizeof(ompi_datatype_t *));
-            if (NULL == aggr_data[i]->recvtype || NULL == aggr_data[i]->prev_recvtype) {
+            aggr_data[i]->cycle_bufs      = (char **) calloc (pipeline_depth, sizeof(char *));
+            aggr_data[i]->cycle_recvtypes = (ompi_datatype_t ***) calloc (pipeline_depth,
+                                                                           sizeof(ompi_datatype_t **));
+            if (NULL == aggr_data[i]->cycle_bufs || NULL == aggr_data[i]->cycle_recvtypes) {
                 opal_output (1, "OUT OF MEMORY\n");
                 ret = OMPI_ERR_OUT_OF_RESOURCE;
                 goto exit;
             }
-            for(l=0;l<fh->f_procs_per_group;l++){
-                aggr_data[i]->recvtype[l]      = MPI_DATATYPE_NULL;
-                aggr_data[i]->prev_recvtype[l] = MPI_DATATYPE_NULL;
+
+            for (j=0; j<pipeline_depth; j++) {
+                aggr_data[i]->cycle_recvtypes[j] = (ompi_datatype_t **) malloc (fh->f_procs_per_group  *
+                                                                                 sizeof(ompi_datatype_t *));
+                if (NULL == aggr_data[i]->cycle_recvtypes[j]) {
+                    opal_output (1, "OUT OF MEMORY\n");
+                    ret = OMPI_ERR_OUT_OF_RESOURCE;
+                    goto exit;
+                }
+                for(l=0;l<fh->f_procs_per_group;l++){
+                    aggr_data[i]->cycle_recvtypes[j][l] = MPI_DATATYPE_NULL;
+                }
+
+                aggr_data[i]->cycle_bufs[j] = (char *) malloc (bytes_per_cycle);
+                if (NULL == aggr_data[i]->cycle_bufs[j]) {
+                    opal_output (1, "OUT OF MEMORY\n");
+                    ret = OMPI_ERR_OUT_OF_RESOURCE;
+                    goto exit;
+                }
             }
+            aggr_data[i]->global_buf = aggr_data[i]->cycle_bufs[0];
+            aggr_data[i]->recvtype   = aggr_data[i]->cycle_recvtypes[0];
         }
     
 #if OMPIO_FCOLL_WANT_TIME_BREAKDOWN
@@ -571,32 +616,55 @@ int mca_fcoll_vulcan_file_write_all (ompio_file_t *fh,
         write_synch_type = 1;
     }
 
-    if ( cycles > 0 ) {
+    write_reqs = (ompi_request_t **) malloc (pipeline_depth * sizeof(ompi_request_t *));
+    if ( NULL == write_reqs ) {
+        opal_output (1, "OUT OF MEMORY\n");
+        ret = OMPI_ERR_OUT_OF_RESOURCE;
+        goto exit;
+    }
+    for ( j=0; j<pipeline_depth; j++ ) {
+        write_reqs[j] = MPI_REQUEST_NULL;
+    }
+
+    // Register progress function that should be used by ompi_request_wait
+    if ( (cycles > 0) && (NOT_AGGR_INDEX != aggr_index) ) {
+        mca_common_ompio_register_progress ();
+    }
+
+    /*************************************************************************
+     *** The shuffle of cycle index is posted before the write of cycle
+     *** index-1 is started, so that the write - even a blocking one -
+     *** overlaps with the data exchange of all aggregators. The aggregator
+     *** owns pipeline_depth cycle buffers and only waits for the write out of
+     *** a buffer when it is about to be reused.
+     *************************************************************************/
+    start_pipeline = MPI_Wtime();
+    for (index = 0; index < cycles; index++) {
+        if (NOT_AGGR_INDEX != aggr_index) {
+            ret = ompi_request_wait(&write_reqs[index % pipeline_depth], MPI_STATUS_IGNORE);
+            if (OMPI_SUCCESS != ret){
+                goto exit;
+            }
+        }
+
+        STASH_AGGR_CYCLE(aggr_data, fh->f_num_aggrs);
+        SELECT_AGGR_SLOT(aggr_data, fh->f_num_aggrs, index % pipeline_depth);
+
         for ( i=0; i<fh->f_num_aggrs; i++ ) {
-            ret = shuffle_init ( 0, cycles, fh->f_aggr_list[i], fh->f_rank, aggr_data[i],
+            ret = shuffle_init ( index, cycles, fh->f_aggr_list[i], fh->f_rank, aggr_data[i],
                                  &reqs[i*(fh->f_procs_per_group + 1)] );
             if ( OMPI_SUCCESS != ret ) {
                 goto exit;
             }
         }
-        // Register progress function that should be used by ompi_request_wait
-        if (NOT_AGGR_INDEX != aggr_index)  {
-            mca_common_ompio_register_progress ();
-        }
-    }
-
-    ret = ompi_request_wait_all ( (fh->f_procs_per_group + 1 )*fh->f_num_aggrs,
-                                  reqs, MPI_STATUS_IGNORE);
 
-    for (index = 1; index < cycles; index++) {
-        SWAP_AGGR_POINTERS(aggr_data, fh->f_num_aggrs);
-
-        if(NOT_AGGR_INDEX != aggr_index) {
+        if( (0 < index) && (NOT_AGGR_INDEX != aggr_index) ) {
 #if OMPIO_FCOLL_WANT_TIME_BREAKDOWN
             start_write_time = MPI_Wtime();
 #endif
             ret = write_init (fh, fh->f_aggr_list[aggr_index], aggr_data[aggr_index],
-                              write_chunksize, write_synch_type, &req_iwrite);
+                              write_chunksize, write_synch_type,
+                              &write_reqs[(index - 1) % pipeline_depth]);
             if (OMPI_SUCCESS != ret){
                 goto exit;
             }
@@ -606,37 +674,23 @@ int mca_fcoll_vulcan_file_write_all (ompio_file_t *fh,
 #endif
         }
 
-        for ( i=0; i<fh->f_num_aggrs; i++ ) {
-            ret = shuffle_init ( index, cycles, fh->f_aggr_list[i], fh->f_rank, aggr_data[i],
-                                 &reqs[i*(fh->f_procs_per_group + 1)] );
-            if ( OMPI_SUCCESS != ret ) {
-                goto exit;
-            }
-        }
-
         ret = ompi_request_wait_all ( (fh->f_procs_per_group + 1 )*fh->f_num_aggrs,
                                       reqs, MPI_STATUS_IGNORE);
         if (OMPI_SUCCESS != ret){
             goto exit;
         }
-
-        if(NOT_AGGR_INDEX != aggr_index) {
-            ret = ompi_request_wait(&req_iwrite, MPI_STATUS_IGNORE);
-            if (OMPI_SUCCESS != ret){
-                goto exit;
-            }
-        }
     } /* end  for (index = 0; index < cycles; index++) */
 
     if ( cycles > 0 ) {
-        SWAP_AGGR_POINTERS(aggr_data,fh->f_num_aggrs);
+        STASH_AGGR_CYCLE(aggr_data, fh->f_num_aggrs);
 
         if(NOT_AGGR_INDEX != aggr_index) {
 #if OMPIO_FCOLL_WANT_TIME_BREAKDOWN
             start_write_time = MPI_Wtime();
 #endif
             ret = write_init (fh, fh->f_aggr_list[aggr_index], aggr_data[aggr_index],
-                              write_chunksize, write_synch_type, &req_iwrite);
+                              write_chunksize, write_synch_type,
+                              &write_reqs[(cycles - 1) % pipeline_depth]);
             if (OMPI_SUCCESS != ret){
                 goto exit;
             }
@@ -646,11 +700,15 @@ int mca_fcoll_vulcan_file_write_all (ompio_file_t *fh,
 #endif
         }
 
-        if(NOT_AGGR_INDEX != aggr_index) {
-            ret = ompi_request_wait(&req_iwrite, MPI_STATUS_IGNORE);
-            if (OMPI_SUCCESS != ret){
-                goto exit;
-            }
+        ret = ompi_request_wait_all (pipeline_depth, write_reqs, MPI_STATUSES_IGNORE);
+        if (OMPI_SUCCESS != ret){
+            goto exit;
+        }
+
+        /* the pipeline runs at the speed of its slower stage, which is what
+           the time per cycle measures */
+        if ( mca_fcoll_vulcan_adaptive_cycle_size && (NOT_AGGR_INDEX != aggr_index) && (1 < cycles) ) {
+            vulcan_record_cycle_time (fh, bytes_per_cycle, (MPI_Wtime() - start_pipeline)/cycles);
         }
     }
         
@@ -675,28 +733,39 @@ int mca_fcoll_vulcan_file_write_all (ompio_file_t *fh,
     
 exit :
     
+    if ( NULL != write_reqs ) {
+        /* writes still in flight after an error must not outlive their buffers */
+        ompi_request_wait_all (pipeline_depth, write_reqs, MPI_STATUSES_IGNORE);
+        free (write_reqs);
+    }
+
     if ( NULL != aggr_data ) {
         
         for ( i=0; i< fh->f_num_aggrs; i++ ) {            
             if (fh->f_aggr_list[i] == fh->f_rank) {
-                if (NULL != aggr_data[i]->recvtype){
-                    for (j =0; j< aggr_data[i]->procs_per_group; j++) {
-                        if ( MPI_DATATYPE_NULL != aggr_data[i]->recvtype[j] ) {
-                            ompi_datatype_destroy(&aggr_data[i]->recvtype[j]);
+                if (NULL != aggr_data[i]->cycle_recvtypes){
+                    for (l=0; l<pipeline_depth; l++) {
+                        if (NULL == aggr_data[i]->cycle_recvtypes[l]) {
+                            continue;
                         }
-                        if ( MPI_DATATYPE_NULL != aggr_data[i]->prev_recvtype[j] ) {
-                            ompi_datatype_destroy(&aggr_data[i]->prev_recvtype[j]);
+                        for (j =0; j< aggr_data[i]->procs_per_group; j++) {
+                            if ( MPI_DATATYPE_NULL != aggr_data[i]->cycle_recvtypes[l][j] ) {
+                                ompi_datatype_destroy(&aggr_data[i]->cycle_recvtypes[l][j]);
+                            }
                         }
-			
+                        free(aggr_data[i]->cycle_recvtypes[l]);
                     }
-                    free(aggr_data[i]->recvtype);
-                    free(aggr_data[i]->prev_recvtype);
+                    free(aggr_data[i]->cycle_recvtypes);
+                }
+                if (NULL != aggr_data[i]->cycle_bufs){
+                    for (l=0; l<pipeline_depth; l++) {
+                        free (aggr_data[i]->cycle_bufs[l]);
+                    }
+                    free (aggr_data[i]->cycle_bufs);
                 }
                 
                 free (aggr_data[i]->disp_index);
                 free (aggr_data[i]->max_disp_index);
-                free (aggr_data[i]->global_buf);
-                free (aggr_data[i]->prev_global_buf);
                 for(l=0;l<aggr_data[i]->procs_per_group;l++){
                     free (aggr_data[i]->blocklen_per_process[l]);
                     free (aggr_data[i]->displs_per_process[l]);
@@ -1806,4 +1875,91 @@ static int local_heap_sort (mca_io_ompio_local_io_array *io_array,
     return OMPI_SUCCESS;
 }
 
+/*
+ * Cycle size proposed by an aggregator, out of the time per cycle measured
+ * in the previous write_all calls on this file. The time of a cycle is
+ * modeled as t(b) = c + b/B, c being the fixed cost of a cycle (latency of
+ * the exchange and of the write) and B the bandwidth of the slower stage.
+ * Writing N bytes then takes about (N/b)*c + N/B, plus one more cycle to
+ * fill the pipeline, which is minimal for b = sqrt(N*c*B). The two
+ * parameters are fitted from the last two measurements; as long as there
+ * are not two of them with different sizes, the size is explored by
+ * halving it.
+ */
+static long vulcan_adapt_cycle_size ( ompio_file_t *fh, long max_cycle_size, MPI_Aint total_bytes )
+{
+    mca_fcoll_vulcan_cycle_stats_t *stats = (mca_fcoll_vulcan_cycle_stats_t *) fh->f_fcoll_data;
+    long min_cycle_size = max_cycle_size / VULCAN_CYCLE_SIZE_RANGE;
+    long cycle_size = max_cycle_size;
+    double slope, overhead;
+
+    if ( NULL == stats || 0 == stats->num_samples ) {
+        return max_cycle_size;
+    }
 
+    if ( 1 == stats->num_samples ) {
+        cycle_size = stats->cycle_size[1] / 2;
+        if ( cycle_size < min_cycle_size ) {
+            cycle_size = stats->cycle_size[1] * 2;
+        }
+    }
+    else {
+        slope = (stats->cycle_time[1] - stats->cycle_time[0]) /
+            (double) (stats->cycle_size[1] - stats->cycle_size[0]);
+        overhead = stats->cycle_time[1] - slope * stats->cycle_size[1];
+        if ( slope <= 0.0 ) {
+            /* larger cycles are not slower: the fixed cost dominates */
+            cycle_size = max_cycle_size;
+        }
+        else if ( overhead <= 0.0 ) {
+            /* no fixed cost visible: only the pipeline fill matters */
+            cycle_size = min_cycle_size;
+        }
+        else {
+            cycle_size = (long) sqrt ((double) total_bytes * overhead / slope);
+        }
+    }
+
+    if ( cycle_size > VULCAN_CYCLE_SIZE_ALIGN ) {
+        cycle_size -= cycle_size % VULCAN_CYCLE_SIZE_ALIGN;
+    }
+    if ( cycle_size < min_cycle_size ) {
+        cycle_size = min_cycle_size;
+    }
+    if ( cycle_size > max_cycle_size || 0 >= cycle_size ) {
+        cycle_size = max_cycle_size;
+    }
+
+    return cycle_size;
+}
+
+/*
+ * Store the time per cycle measured by an aggregator. A measurement for
+ * the size of the last sample is averaged into it, so that the two samples
+ * used for the fit keep different sizes once the cycle size settles.
+ */
+static void vulcan_record_cycle_time ( ompio_file_t *fh, long cycle_size, double cycle_time )
+{
+    mca_fcoll_vulcan_cycle_stats_t *stats = (mca_fcoll_vulcan_cycle_stats_t *) fh->f_fcoll_data;
+
+    if ( NULL == stats ) {
+        stats = (mca_fcoll_vulcan_cycle_stats_t *) calloc (1, sizeof(mca_fcoll_vulcan_cycle_stats_t));
+        if ( NULL == stats ) {
+            return;
+        }
+        fh->f_fcoll_data = stats;
+    }
+
+    if ( 0 < stats->num_samples && cycle_size == stats->cycle_size[1] ) {
+        stats->cycle_time[1] = (stats->cycle_time[1] + cycle_time) / 2;
+        return;
+    }
+
+    stats->cycle_size[0] = stats->cycle_size[1];
+    stats->cycle_time[0] = stats->cycle_time[1];
+    stats->cycle_size[1] = cycle_size;
+    stats->cycle_time[1] = cycle_time;
+    if ( stats->num_samples < 2 ) {
+        stats->num_samples++;
+    }
+}
@@ -548,6 +548,15 @@ int mca_io_ompio_get_mca_parameter_value ( char *mca_parameter_name, int name_le
     else if ( !strncmp ( mca_parameter_name, "coll_timing_info", name_length )) {
         return mca_io_ompio_coll_timing_info;
     }
+    else if ( !strncmp ( mca_parameter_name, "read_cache_size", name_length )) {
+        return mca_io_ompio_read_cache_size;
+    }
+    else if ( !strncmp ( mca_parameter_name, "read_cache_block_size", name_length )) {
+        return mca_io_ompio_read_cache_block_size;
+    }
+    else if ( !strncmp ( mca_parameter_name, "read_cache_prefetch", name_length )) {
+        return mca_io_ompio_read_cache_prefetch;
+    }
     else {
         opal_output (1, "Error in mca_io_ompio_get_mca_parameter_value: unknown parameter name");
     }
@@ -53,6 +53,9 @@ extern int mca_io_ompio_max_aggregators_ratio;
 extern int mca_io_ompio_aggregators_cutoff_threshold;
 extern int mca_io_ompio_overwrite_amode;
 extern int mca_io_ompio_verbose_info_parsing;
+extern int mca_io_ompio_read_cache_size;
+extern int mca_io_ompio_read_cache_block_size;
+extern int mca_io_ompio_read_cache_prefetch;
 
 OMPI_DECLSPEC extern int mca_io_ompio_coll_timing_info;
 
@@ -63,6 +66,7 @@ OMPI_DECLSPEC extern int mca_io_ompio_coll_timing_info;
  */
 #define OMPIO_PREALLOC_MAX_BUF_SIZE   33554432
 #define OMPIO_DEFAULT_CYCLE_BUF_SIZE  536870912
+#define OMPIO_DEFAULT_READ_CACHE_BLOCK_SIZE 65536
 #define OMPIO_TAG_GATHER              -100
 #define OMPIO_TAG_GATHERV             -101
 #define OMPIO_TAG_BCAST               -102
@@ -50,6 +50,9 @@ int mca_io_ompio_max_aggregators_ratio=8;
 int mca_io_ompio_aggregators_cutoff_threshold=3;
 int mca_io_ompio_overwrite_amode = 1;
 int mca_io_ompio_verbose_info_parsing = 0;
+int mca_io_ompio_read_cache_size = 0;
+int mca_io_ompio_read_cache_block_size = OMPIO_DEFAULT_READ_CACHE_BLOCK_SIZE;
+int mca_io_ompio_read_cache_prefetch = 4;
 
 int mca_io_ompio_grouping_option=5;
 
@@ -260,6 +263,36 @@ static int register_component(void)
                                            MCA_BASE_VAR_SCOPE_READONLY,
                                            &mca_io_ompio_verbose_info_parsing);
 
+    mca_io_ompio_read_cache_size = 0;
+    (void) mca_base_component_var_register(&mca_io_ompio_component.io_version,
+                                           "read_cache_size",
+                                           "Size in bytes of the cache used by the individual read "
+                                           "operations of each file. 0: no caching (default)",
+                                           MCA_BASE_VAR_TYPE_INT, NULL, 0, 0,
+                                           OPAL_INFO_LVL_9,
+                                           MCA_BASE_VAR_SCOPE_READONLY,
+                                           &mca_io_ompio_read_cache_size);
+
+    mca_io_ompio_read_cache_block_size = OMPIO_DEFAULT_READ_CACHE_BLOCK_SIZE;
+    (void) mca_base_component_var_register(&mca_io_ompio_component.io_version,
+                                           "read_cache_block_size",
+                                           "Unit in bytes in which the read cache reads the file. "
+                                           "Larger requests bypass the cache",
+                                           MCA_BASE_VAR_TYPE_INT, NULL, 0, 0,
+                                           OPAL_INFO_LVL_9,
+                                           MCA_BASE_VAR_SCOPE_READONLY,
+                                           &mca_io_ompio_read_cache_block_size);
+
+    mca_io_ompio_read_cache_prefetch = 4;
+    (void) mca_base_component_var_register(&mca_io_ompio_component.io_version,
+                                           "read_cache_prefetch",
+                                           "Number of blocks along the file view read ahead "
+                                           "by the read cache. 0: no prefetching",
+                                           MCA_BASE_VAR_TYPE_INT, NULL, 0, 0,
+                                           OPAL_INFO_LVL_9,
+                                           MCA_BASE_VAR_SCOPE_READONLY,
+                                           &mca_io_ompio_read_cache_prefetch);
+
     return OMPI_SUCCESS;
 }
 
@@ -40,6 +40,7 @@
 #include <math.h>
 #include "io_ompio.h"
 #include "ompi/mca/common/ompio/common_ompio_request.h"
+#include "ompi/mca/common/ompio/common_ompio_read_cache.h"
 #include "ompi/mca/topo/topo.h"
 
 int mca_io_ompio_file_open (ompi_communicator_t *comm,
@@ -115,6 +116,7 @@ int mca_io_ompio_file_preallocate (ompi_file_t *fh,
     data = (mca_common_ompio_data_t *) fh->f_io_selected_data;
 
     OPAL_THREAD_LOCK(&fh->f_lock);
+    mca_common_ompio_read_cache_invalidate (&data->ompio_fh);
     tmp = diskspace;
 
     ret = data->ompio_fh.f_comm->c_coll->coll_bcast (&tmp,
@@ -233,6 +235,7 @@ int mca_io_ompio_file_set_size (ompi_file_t *fh,
 
     tmp = size;
     OPAL_THREAD_LOCK(&fh->f_lock);
+    mca_common_ompio_read_cache_invalidate (&data->ompio_fh);
     ret = data->ompio_fh.f_comm->c_coll->coll_bcast (&tmp,
                                                     1,
                                                     OMPI_OFFSET_DATATYPE,
@@ -375,6 +378,9 @@ int mca_io_ompio_file_sync (ompi_file_t *fh)
     data = (mca_common_ompio_data_t *) fh->f_io_selected_data;
 
     OPAL_THREAD_LOCK(&fh->f_lock);
+    /* data written by other processes becomes visible after the sync,
+       which also completes the prefetches of the read cache */
+    mca_common_ompio_read_cache_invalidate (&data->ompio_fh);
     if ( !opal_list_is_empty (&mca_common_ompio_pending_requests) ) {
         OPAL_THREAD_UNLOCK(&fh->f_lock);
         return MPI_ERR_OTHER;
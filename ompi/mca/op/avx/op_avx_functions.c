@@ -16,6 +16,7 @@
 #ifdef HAVE_SYS_TYPES_H
 #include <sys/types.h>
 #endif
+#include <limits.h>
 #include "opal/util/output.h"
 
 #include "ompi/op/op.h"
@@ -749,6 +750,479 @@ static void OP_CONCAT(ompi_op_avx_2buff_##op##_double,PREPEND)(const void *_in,
     // not defined - OP_AVX_FLOAT_FUNC(xor)
     // not defined - OP_AVX_DOUBLE_FUNC(xor)
 
+/*
+ *  This macro is for logical operations (out op in).  Both operands are
+ *  first normalized to 0/1 (zero / non-zero), and then combined with the
+ *  corresponding bitwise operation, so the result is always 0 or 1.
+ *
+ *  Support ops: land, lor, lxor for signed/unsigned 8,16,32,64
+ *
+ */
+#if defined(GENERATE_AVX512_CODE) && defined(OMPI_MCA_OP_HAVE_AVX512) && (1 == OMPI_MCA_OP_HAVE_AVX512)
+#if __AVX512F__ && __AVX512BW__
+#define OP_AVX_AVX512_LOGICAL_FUNC(name, type_size, type, op)           \
+    if( OMPI_OP_AVX_HAS_FLAGS(OMPI_OP_AVX_HAS_AVX512F_FLAG|OMPI_OP_AVX_HAS_AVX512BW_FLAG) ) { \
+        int types_per_step = (512 / 8) / sizeof(type);                  \
+        __m512i one = _mm512_set1_epi##type_size(1);                    \
+        for( ; left_over >= types_per_step; left_over -= types_per_step ) { \
+            __m512i vecA = _mm512_loadu_si512((__m512i*)in);            \
+            in += types_per_step;                                       \
+            __m512i vecB = _mm512_loadu_si512((__m512i*)out);           \
+            vecA = _mm512_maskz_mov_epi##type_size(_mm512_test_epi##type_size##_mask(vecA, vecA), one); \
+            vecB = _mm512_maskz_mov_epi##type_size(_mm512_test_epi##type_size##_mask(vecB, vecB), one); \
+            __m512i res = _mm512_##op##_si512(vecA, vecB);              \
+            _mm512_storeu_si512((__m512i*)out, res);                    \
+            out += types_per_step;                                      \
+        }                                                               \
+        if( 0 == left_over ) return;                                    \
+    }
+#else
+#error Target architecture lacks AVX512F and AVX512BW support needed for _mm512_test_epi8_mask and _mm512_maskz_mov_epi8
+#endif  /* __AVX512F__ && __AVX512BW__ */
+#else
+#define OP_AVX_AVX512_LOGICAL_FUNC(name, type_size, type, op) {}
+#endif  /* defined(OMPI_MCA_OP_HAVE_AVX512) && (1 == OMPI_MCA_OP_HAVE_AVX512) */
+
+#if defined(GENERATE_AVX2_CODE) && defined(OMPI_MCA_OP_HAVE_AVX2) && (1 == OMPI_MCA_OP_HAVE_AVX2)
+#if __AVX2__
+#define OP_AVX_AVX2_LOGICAL_FUNC(name, type_size, type, op)             \
+    if( OMPI_OP_AVX_HAS_FLAGS(OMPI_OP_AVX_HAS_AVX2_FLAG | OMPI_OP_AVX_HAS_AVX_FLAG) ) { \
+        int types_per_step = (256 / 8) / sizeof(type);                  \
+        __m256i zero = _mm256_setzero_si256();                          \
+        __m256i one = _mm256_sub_epi##type_size(zero, _mm256_cmpeq_epi##type_size(zero, zero)); \
+        for( ; left_over >= types_per_step; left_over -= types_per_step ) { \
+            __m256i vecA = _mm256_loadu_si256((__m256i*)in);            \
+            in += types_per_step;                                       \
+            __m256i vecB = _mm256_loadu_si256((__m256i*)out);           \
+            vecA = _mm256_andnot_si256(_mm256_cmpeq_epi##type_size(vecA, zero), one); \
+            vecB = _mm256_andnot_si256(_mm256_cmpeq_epi##type_size(vecB, zero), one); \
+            __m256i res = _mm256_##op##_si256(vecA, vecB);              \
+            _mm256_storeu_si256((__m256i*)out, res);                    \
+            out += types_per_step;                                      \
+        }                                                               \
+        if( 0 == left_over ) return;                                    \
+    }
+#else
+#error Target architecture lacks AVX2 support needed for _mm256_cmpeq_epi8 and _mm256_sub_epi8
+#endif  /* __AVX2__ */
+#else
+#define OP_AVX_AVX2_LOGICAL_FUNC(name, type_size, type, op) {}
+#endif  /* defined(OMPI_MCA_OP_HAVE_AVX2) && (1 == OMPI_MCA_OP_HAVE_AVX2) */
+
+#if defined(GENERATE_SSE41_CODE) && defined(OMPI_MCA_OP_HAVE_SSE41) && (1 == OMPI_MCA_OP_HAVE_SSE41) && defined(OMPI_MCA_OP_HAVE_AVX) && (1 == OMPI_MCA_OP_HAVE_AVX)
+#if __SSE4_1__ && __SSE3__
+#define OP_AVX_SSE4_1_LOGICAL_FUNC(name, type_size, type, op)           \
+    if( OMPI_OP_AVX_HAS_FLAGS(OMPI_OP_AVX_HAS_SSE3_FLAG | OMPI_OP_AVX_HAS_SSE4_1_FLAG) ) { \
+        int types_per_step = (128 / 8) / sizeof(type);                  \
+        __m128i zero = _mm_setzero_si128();                             \
+        __m128i one = _mm_sub_epi##type_size(zero, _mm_cmpeq_epi##type_size(zero, zero)); \
+        for( ; left_over >= types_per_step; left_over -= types_per_step ) { \
+            __m128i vecA = _mm_lddqu_si128((__m128i*)in);               \
+            in += types_per_step;                                       \
+            __m128i vecB = _mm_lddqu_si128((__m128i*)out);              \
+            vecA = _mm_andnot_si128(_mm_cmpeq_epi##type_size(vecA, zero), one); \
+            vecB = _mm_andnot_si128(_mm_cmpeq_epi##type_size(vecB, zero), one); \
+            __m128i res = _mm_##op##_si128(vecA, vecB);                 \
+            _mm_storeu_si128((__m128i*)out, res);                       \
+            out += types_per_step;                                      \
+        }                                                               \
+    }
+#else
+#error Target architecture lacks SSE4.1 support needed for _mm_cmpeq_epi64
+#endif  /* __SSE4_1__ && __SSE3__ */
+#else
+#define OP_AVX_SSE4_1_LOGICAL_FUNC(name, type_size, type, op) {}
+#endif  /* defined(OMPI_MCA_OP_HAVE_SSE41) && (1 == OMPI_MCA_OP_HAVE_SSE41) */
+
+#define OP_AVX_LOGICAL_FUNC(name, type_size, type, op)                  \
+static void OP_CONCAT(ompi_op_avx_2buff_##name##_##type,PREPEND)(const void *_in, void *_out, int *count, \
+                                                                 struct ompi_datatype_t **dtype, \
+                                                                 struct ompi_op_base_module_1_0_0_t *module) \
+{                                                                       \
+    int left_over = *count;                                             \
+    type *in = (type*)_in, *out = (type*)_out;                          \
+    OP_AVX_AVX512_LOGICAL_FUNC(name, type_size, type, op);              \
+    OP_AVX_AVX2_LOGICAL_FUNC(name, type_size, type, op);                \
+    OP_AVX_SSE4_1_LOGICAL_FUNC(name, type_size, type, op);              \
+    while( left_over > 0 ) {                                            \
+        int how_much = (left_over > 8) ? 8 : left_over;                 \
+        switch(how_much) {                                              \
+        case 8: out[7] = current_func(out[7], in[7]);                   \
+        case 7: out[6] = current_func(out[6], in[6]);                   \
+        case 6: out[5] = current_func(out[5], in[5]);                   \
+        case 5: out[4] = current_func(out[4], in[4]);                   \
+        case 4: out[3] = current_func(out[3], in[3]);                   \
+        case 3: out[2] = current_func(out[2], in[2]);                   \
+        case 2: out[1] = current_func(out[1], in[1]);                   \
+        case 1: out[0] = current_func(out[0], in[0]);                   \
+        }                                                               \
+        left_over -= how_much;                                          \
+        out += how_much;                                                \
+        in += how_much;                                                 \
+    }                                                                   \
+}
+
+/*************************************************************************
+ * Logical AND
+ *************************************************************************/
+#undef current_func
+#define current_func(a, b) ((a) && (b))
+    OP_AVX_LOGICAL_FUNC(land, 8,    int8_t, and)
+    OP_AVX_LOGICAL_FUNC(land, 8,   uint8_t, and)
+    OP_AVX_LOGICAL_FUNC(land, 16,  int16_t, and)
+    OP_AVX_LOGICAL_FUNC(land, 16, uint16_t, and)
+    OP_AVX_LOGICAL_FUNC(land, 32,  int32_t, and)
+    OP_AVX_LOGICAL_FUNC(land, 32, uint32_t, and)
+    OP_AVX_LOGICAL_FUNC(land, 64,  int64_t, and)
+    OP_AVX_LOGICAL_FUNC(land, 64, uint64_t, and)
+
+/*************************************************************************
+ * Logical OR
+ *************************************************************************/
+#undef current_func
+#define current_func(a, b) ((a) || (b))
+    OP_AVX_LOGICAL_FUNC(lor, 8,    int8_t, or)
+    OP_AVX_LOGICAL_FUNC(lor, 8,   uint8_t, or)
+    OP_AVX_LOGICAL_FUNC(lor, 16,  int16_t, or)
+    OP_AVX_LOGICAL_FUNC(lor, 16, uint16_t, or)
+    OP_AVX_LOGICAL_FUNC(lor, 32,  int32_t, or)
+    OP_AVX_LOGICAL_FUNC(lor, 32, uint32_t, or)
+    OP_AVX_LOGICAL_FUNC(lor, 64,  int64_t, or)
+    OP_AVX_LOGICAL_FUNC(lor, 64, uint64_t, or)
+
+/*************************************************************************
+ * Logical XOR
+ *************************************************************************/
+#undef current_func
+#define current_func(a, b) ((a ? 1 : 0) ^ (b ? 1: 0))
+    OP_AVX_LOGICAL_FUNC(lxor, 8,    int8_t, xor)
+    OP_AVX_LOGICAL_FUNC(lxor, 8,   uint8_t, xor)
+    OP_AVX_LOGICAL_FUNC(lxor, 16,  int16_t, xor)
+    OP_AVX_LOGICAL_FUNC(lxor, 16, uint16_t, xor)
+    OP_AVX_LOGICAL_FUNC(lxor, 32,  int32_t, xor)
+    OP_AVX_LOGICAL_FUNC(lxor, 32, uint32_t, xor)
+    OP_AVX_LOGICAL_FUNC(lxor, 64,  int64_t, xor)
+    OP_AVX_LOGICAL_FUNC(lxor, 64, uint64_t, xor)
+
+/*
+ *  Pair types used by MAXLOC and MINLOC.  They must have the same layout as
+ *  the ompi_op_predefined_*_t types in ompi/mca/op/base/op_base_functions.c.
+ */
+typedef struct {
+    float v;
+    int k;
+} ompi_op_avx_float_int_t;
+
+typedef struct {
+    double v;
+    int k;
+} ompi_op_avx_double_int_t;
+
+typedef struct {
+    int v;
+    int k;
+} ompi_op_avx_2int_t;
+
+#if OMPI_HAVE_FORTRAN_DOUBLE_PRECISION && (8 == OMPI_SIZEOF_FORTRAN_DOUBLE_PRECISION)
+#define OMPI_OP_AVX_HAVE_2DOUBLE_PRECISION 1
+typedef struct {
+    double v;
+    double k;
+} ompi_op_avx_2double_precision_t;
+#else
+#define OMPI_OP_AVX_HAVE_2DOUBLE_PRECISION 0
+#endif
+
+/*
+ *  Value comparisons for MAXLOC and MINLOC, returning all ones in the lanes
+ *  where the first operand is strictly better than the second one.
+ */
+#define OP_AVX_LOC_OP_maxloc >
+#define OP_AVX_LOC_OP_minloc <
+#define OP_AVX_LOC_BETTER_PD_maxloc(a, b)    _mm256_cmp_pd((a), (b), _CMP_GT_OQ)
+#define OP_AVX_LOC_BETTER_PD_minloc(a, b)    _mm256_cmp_pd((a), (b), _CMP_LT_OQ)
+#define OP_AVX_LOC_BETTER_PS_maxloc(a, b)    _mm256_cmp_ps((a), (b), _CMP_GT_OQ)
+#define OP_AVX_LOC_BETTER_PS_minloc(a, b)    _mm256_cmp_ps((a), (b), _CMP_LT_OQ)
+#define OP_AVX_LOC_BETTER_EPI32_maxloc(a, b) _mm256_cmpgt_epi32((a), (b))
+#define OP_AVX_LOC_BETTER_EPI32_minloc(a, b) _mm256_cmpgt_epi32((b), (a))
+
+/*
+ *  Select, for each pair, either vecA or vecB following the MAXLOC/MINLOC
+ *  rules: the better value wins, and on equal values the smallest index is
+ *  kept.  The per-lane value and index masks are broadcast to the whole pair
+ *  before blending, so the value and the index always move together.
+ */
+#define OP_AVX_AVX2_LOC_SELECT_double_int(name, vecA, vecB, res)        \
+    do {                                                                \
+        __m256d _va = _mm256_castsi256_pd(vecA), _vb = _mm256_castsi256_pd(vecB); \
+        __m256d _better = _mm256_permute_pd(OP_AVX_LOC_BETTER_PD_##name(_va, _vb), 0x0); \
+        __m256d _eq = _mm256_permute_pd(_mm256_cmp_pd(_va, _vb, _CMP_EQ_OQ), 0x0); \
+        __m256i _klt = _mm256_shuffle_epi32(_mm256_cmpgt_epi32(vecB, vecA), _MM_SHUFFLE(2, 2, 2, 2)); \
+        __m256d _take = _mm256_or_pd(_better, _mm256_and_pd(_eq, _mm256_castsi256_pd(_klt))); \
+        (res) = _mm256_castpd_si256(_mm256_blendv_pd(_vb, _va, _take)); \
+    } while (0)
+
+#define OP_AVX_AVX2_LOC_SELECT_2double_precision(name, vecA, vecB, res) \
+    do {                                                                \
+        __m256d _va = _mm256_castsi256_pd(vecA), _vb = _mm256_castsi256_pd(vecB); \
+        __m256d _better = _mm256_permute_pd(OP_AVX_LOC_BETTER_PD_##name(_va, _vb), 0x0); \
+        __m256d _eq = _mm256_permute_pd(_mm256_cmp_pd(_va, _vb, _CMP_EQ_OQ), 0x0); \
+        __m256d _klt = _mm256_permute_pd(_mm256_cmp_pd(_vb, _va, _CMP_GT_OQ), 0xF); \
+        __m256d _take = _mm256_or_pd(_better, _mm256_and_pd(_eq, _klt)); \
+        (res) = _mm256_castpd_si256(_mm256_blendv_pd(_vb, _va, _take)); \
+    } while (0)
+
+#define OP_AVX_AVX2_LOC_SELECT_float_int(name, vecA, vecB, res)         \
+    do {                                                                \
+        __m256 _va = _mm256_castsi256_ps(vecA), _vb = _mm256_castsi256_ps(vecB); \
+        __m256i _better = _mm256_shuffle_epi32(_mm256_castps_si256(OP_AVX_LOC_BETTER_PS_##name(_va, _vb)), \
+                                               _MM_SHUFFLE(2, 2, 0, 0)); \
+        __m256i _eq = _mm256_shuffle_epi32(_mm256_castps_si256(_mm256_cmp_ps(_va, _vb, _CMP_EQ_OQ)), \
+                                           _MM_SHUFFLE(2, 2, 0, 0));    \
+        __m256i _klt = _mm256_shuffle_epi32(_mm256_cmpgt_epi32(vecB, vecA), _MM_SHUFFLE(3, 3, 1, 1)); \
+        __m256i _take = _mm256_or_si256(_better, _mm256_and_si256(_eq, _klt)); \
+        (res) = _mm256_blendv_epi8(vecB, vecA, _take);                  \
+    } while (0)
+
+#define OP_AVX_AVX2_LOC_SELECT_2int(name, vecA, vecB, res)              \
+    do {                                                                \
+        __m256i _better = _mm256_shuffle_epi32(OP_AVX_LOC_BETTER_EPI32_##name(vecA, vecB), \
+                                               _MM_SHUFFLE(2, 2, 0, 0)); \
+        __m256i _eq = _mm256_shuffle_epi32(_mm256_cmpeq_epi32(vecA, vecB), _MM_SHUFFLE(2, 2, 0, 0)); \
+        __m256i _klt = _mm256_shuffle_epi32(_mm256_cmpgt_epi32(vecB, vecA), _MM_SHUFFLE(3, 3, 1, 1)); \
+        __m256i _take = _mm256_or_si256(_better, _mm256_and_si256(_eq, _klt)); \
+        (res) = _mm256_blendv_epi8(vecB, vecA, _take);                  \
+    } while (0)
+
+/*
+ *  This macro is for MAXLOC and MINLOC (out op in) on pair types.  Only an
+ *  AVX2 version is provided, the AVX512 builds use it as well.
+ */
+#if defined(GENERATE_AVX2_CODE) && defined(OMPI_MCA_OP_HAVE_AVX2) && (1 == OMPI_MCA_OP_HAVE_AVX2)
+#if __AVX2__
+#define OP_AVX_AVX2_LOC_FUNC(name, type_name)                           \
+    if( OMPI_OP_AVX_HAS_FLAGS(OMPI_OP_AVX_HAS_AVX2_FLAG | OMPI_OP_AVX_HAS_AVX_FLAG) ) { \
+        int types_per_step = (256 / 8) / sizeof(ompi_op_avx_##type_name##_t); \
+        for( ; left_over >= types_per_step; left_over -= types_per_step ) { \
+            __m256i vecA = _mm256_loadu_si256((__m256i*)in);            \
+            in += types_per_step;                                       \
+            __m256i vecB = _mm256_loadu_si256((__m256i*)out);           \
+            __m256i res;                                                \
+            OP_AVX_AVX2_LOC_SELECT_##type_name(name, vecA, vecB, res);  \
+            _mm256_storeu_si256((__m256i*)out, res);                    \
+            out += types_per_step;                                      \
+        }                                                               \
+        if( 0 == left_over ) return;                                    \
+    }
+#else
+#error Target architecture lacks AVX2 support needed for _mm256_cmpgt_epi32 and _mm256_shuffle_epi32
+#endif  /* __AVX2__ */
+#else
+#define OP_AVX_AVX2_LOC_FUNC(name, type_name) {}
+#endif  /* defined(OMPI_MCA_OP_HAVE_AVX2) && (1 == OMPI_MCA_OP_HAVE_AVX2) */
+
+#define OP_AVX_LOC_FUNC(name, type_name)                                \
+static void OP_CONCAT(ompi_op_avx_2buff_##name##_##type_name,PREPEND)(const void *_in, void *_out, int *count, \
+                                                                      struct ompi_datatype_t **dtype, \
+                                                                      struct ompi_op_base_module_1_0_0_t *module) \
+{                                                                       \
+    int left_over = *count;                                             \
+    ompi_op_avx_##type_name##_t *in = (ompi_op_avx_##type_name##_t*)_in; \
+    ompi_op_avx_##type_name##_t *out = (ompi_op_avx_##type_name##_t*)_out; \
+    OP_AVX_AVX2_LOC_FUNC(name, type_name);                              \
+    for( ; left_over > 0; --left_over, ++in, ++out ) {                  \
+        if( in->v OP_AVX_LOC_OP_##name out->v ) {                       \
+            out->v = in->v;                                             \
+            out->k = in->k;                                             \
+        } else if( in->v == out->v ) {                                  \
+            out->k = (out->k < in->k ? out->k : in->k);                 \
+        }                                                               \
+    }                                                                   \
+}
+
+/*************************************************************************
+ * Max location
+ *************************************************************************/
+    OP_AVX_LOC_FUNC(maxloc, float_int)
+    OP_AVX_LOC_FUNC(maxloc, double_int)
+    OP_AVX_LOC_FUNC(maxloc, 2int)
+#if OMPI_OP_AVX_HAVE_2DOUBLE_PRECISION
+    OP_AVX_LOC_FUNC(maxloc, 2double_precision)
+#endif
+
+/*************************************************************************
+ * Min location
+ *************************************************************************/
+    OP_AVX_LOC_FUNC(minloc, float_int)
+    OP_AVX_LOC_FUNC(minloc, double_int)
+    OP_AVX_LOC_FUNC(minloc, 2int)
+#if OMPI_OP_AVX_HAVE_2DOUBLE_PRECISION
+    OP_AVX_LOC_FUNC(minloc, 2double_precision)
+#endif
+
+/*
+ *  Complex multiplication of vecA by vecB, where the real and imaginary
+ *  parts are interleaved: for (a + bi) * (c + di) compute (a*c, a*d) and
+ *  (b*d, b*c), and subtract/add them lane-wise to get (ac - bd, ad + bc).
+ *  The products are rounded before the subtraction/addition, as in the
+ *  scalar code, so that all the paths give the same results. AVX512 has
+ *  no addsub, the real (even) lanes are subtracted under a mask instead.
+ *  The explicit rounding variants keep the compiler from contracting the
+ *  multiplications and the addition into fused multiply-adds.
+ */
+#define OP_AVX_AVX512_ADDSUB(ps, mask, P1, P2)                          \
+    _mm512_mask_sub_round_##ps(_mm512_add_round_##ps((P1), (P2), _MM_FROUND_CUR_DIRECTION), \
+                               (mask), (P1), (P2), _MM_FROUND_CUR_DIRECTION)
+#define OP_AVX_AVX512_CPROD_ps(vecA, vecB)                              \
+    OP_AVX_AVX512_ADDSUB(ps, 0x5555, _mm512_mul_ps(_mm512_moveldup_ps(vecA), (vecB)), \
+                         _mm512_mul_ps(_mm512_movehdup_ps(vecA), _mm512_permute_ps((vecB), 0xB1)))
+#define OP_AVX_AVX512_CPROD_pd(vecA, vecB)                              \
+    OP_AVX_AVX512_ADDSUB(pd, 0x55, _mm512_mul_pd(_mm512_movedup_pd(vecA), (vecB)), \
+                         _mm512_mul_pd(_mm512_permute_pd((vecA), 0xFF), _mm512_permute_pd((vecB), 0x55)))
+#define OP_AVX_AVX_CPROD_ps(vecA, vecB)                                 \
+    _mm256_addsub_ps(_mm256_mul_ps(_mm256_moveldup_ps(vecA), (vecB)),   \
+                     _mm256_mul_ps(_mm256_movehdup_ps(vecA), _mm256_permute_ps((vecB), 0xB1)))
+#define OP_AVX_AVX_CPROD_pd(vecA, vecB)                                 \
+    _mm256_addsub_pd(_mm256_mul_pd(_mm256_movedup_pd(vecA), (vecB)),    \
+                     _mm256_mul_pd(_mm256_permute_pd((vecA), 0xF), _mm256_permute_pd((vecB), 0x5)))
+#define OP_AVX_SSE3_CPROD_ps(vecA, vecB)                                \
+    _mm_addsub_ps(_mm_mul_ps(_mm_moveldup_ps(vecA), (vecB)),            \
+                  _mm_mul_ps(_mm_movehdup_ps(vecA), _mm_shuffle_ps((vecB), (vecB), 0xB1)))
+#define OP_AVX_SSE3_CPROD_pd(vecA, vecB)                                \
+    _mm_addsub_pd(_mm_mul_pd(_mm_movedup_pd(vecA), (vecB)),             \
+                  _mm_mul_pd(_mm_unpackhi_pd((vecA), (vecA)), _mm_shuffle_pd((vecB), (vecB), 0x1)))
+
+/*
+ *  This macro is for the product of complex numbers (out op in), vsfx is
+ *  the vector type suffix (empty for float, d for double).  The
+ *  scalar tail uses the same formula as the vector code (without the C99
+ *  Annex G recovery of infinities) so that all elements are computed
+ *  consistently.
+ *
+ *  Support types: float and double complex
+ */
+#if defined(GENERATE_AVX512_CODE) && defined(OMPI_MCA_OP_HAVE_AVX512) && (1 == OMPI_MCA_OP_HAVE_AVX512)
+#if __AVX512F__
+#define OP_AVX_AVX512_COMPLEX_PROD_FUNC(type, ps, vsfx)                 \
+    if( OMPI_OP_AVX_HAS_FLAGS(OMPI_OP_AVX_HAS_AVX512F_FLAG) ) {         \
+        types_per_step = (512 / 8) / sizeof(type);                      \
+        for (; left_over >= types_per_step; left_over -= types_per_step) { \
+            __m512##vsfx vecA = _mm512_loadu_##ps(in);                  \
+            in += types_per_step;                                       \
+            __m512##vsfx vecB = _mm512_loadu_##ps(out);                 \
+            __m512##vsfx res = OP_AVX_AVX512_CPROD_##ps(vecA, vecB);    \
+            _mm512_storeu_##ps(out, res);                               \
+            out += types_per_step;                                      \
+        }                                                               \
+        if( 0 != left_over ) {                                          \
+            /* the remainder under a mask, so the scalar code (which the \
+             * compiler may contract into fused multiply-adds) is not used */ \
+            __mmask16 mask = (__mmask16)((1U << left_over) - 1);        \
+            __m512##vsfx vecA = _mm512_maskz_loadu_##ps(mask, in);      \
+            __m512##vsfx vecB = _mm512_maskz_loadu_##ps(mask, out);     \
+            __m512##vsfx res = OP_AVX_AVX512_CPROD_##ps(vecA, vecB);    \
+            _mm512_mask_storeu_##ps(out, mask, res);                    \
+        }                                                               \
+        return;                                                         \
+    }
+#else
+#error Target architecture lacks AVX512F support needed for _mm512_mask_sub_ps and _mm512_mask_sub_pd
+#endif  /* __AVX512F__ */
+#else
+#define OP_AVX_AVX512_COMPLEX_PROD_FUNC(type, ps, vsfx) {}
+#endif  /* defined(OMPI_MCA_OP_HAVE_AVX512) && (1 == OMPI_MCA_OP_HAVE_AVX512) */
+
+#if defined(GENERATE_AVX2_CODE) && defined(OMPI_MCA_OP_HAVE_AVX2) && (1 == OMPI_MCA_OP_HAVE_AVX2)
+#if __AVX__
+#define OP_AVX_AVX_COMPLEX_PROD_FUNC(type, ps, vsfx)                    \
+    if( OMPI_OP_AVX_HAS_FLAGS(OMPI_OP_AVX_HAS_AVX_FLAG) ) {             \
+        types_per_step = (256 / 8) / sizeof(type);                      \
+        for( ; left_over >= types_per_step; left_over -= types_per_step ) { \
+            __m256##vsfx vecA = _mm256_loadu_##ps(in);                  \
+            in += types_per_step;                                       \
+            __m256##vsfx vecB = _mm256_loadu_##ps(out);                 \
+            __m256##vsfx res = OP_AVX_AVX_CPROD_##ps(vecA, vecB);       \
+            _mm256_storeu_##ps(out, res);                               \
+            out += types_per_step;                                      \
+        }                                                               \
+        if( 0 == left_over ) return;                                    \
+    }
+#else
+#error Target architecture lacks AVX support needed for _mm256_addsub_ps and _mm256_addsub_pd
+#endif  /* __AVX__ */
+#else
+#define OP_AVX_AVX_COMPLEX_PROD_FUNC(type, ps, vsfx) {}
+#endif  /* defined(OMPI_MCA_OP_HAVE_AVX2) && (1 == OMPI_MCA_OP_HAVE_AVX2) */
+
+#if defined(GENERATE_SSE3_CODE) && defined(OMPI_MCA_OP_HAVE_SSE3) && (1 == OMPI_MCA_OP_HAVE_SSE3) && defined(OMPI_MCA_OP_HAVE_AVX) && (1 == OMPI_MCA_OP_HAVE_AVX)
+#if __SSE3__
+#define OP_AVX_SSE3_COMPLEX_PROD_FUNC(type, ps, vsfx)                   \
+    if( OMPI_OP_AVX_HAS_FLAGS(OMPI_OP_AVX_HAS_SSE3_FLAG) ) {            \
+        types_per_step = (128 / 8) / sizeof(type);                      \
+        for( ; left_over >= types_per_step; left_over -= types_per_step ) { \
+            __m128##vsfx vecA = _mm_loadu_##ps(in);                     \
+            in += types_per_step;                                       \
+            __m128##vsfx vecB = _mm_loadu_##ps(out);                    \
+            __m128##vsfx res = OP_AVX_SSE3_CPROD_##ps(vecA, vecB);      \
+            _mm_storeu_##ps(out, res);                                  \
+            out += types_per_step;                                      \
+        }                                                               \
+    }
+#else
+#error Target architecture lacks SSE3 support needed for _mm_addsub_ps and _mm_addsub_pd
+#endif  /* __SSE3__ */
+#else
+#define OP_AVX_SSE3_COMPLEX_PROD_FUNC(type, ps, vsfx) {}
+#endif  /* defined(OMPI_MCA_OP_HAVE_SSE3) && (1 == OMPI_MCA_OP_HAVE_SSE3) */
+
+#define OP_AVX_COMPLEX_PROD_FUNC(type_name, type, ps, vsfx)             \
+static void OP_CONCAT(ompi_op_avx_2buff_prod_##type_name,PREPEND)(const void *_in, void *_out, int *count, \
+                                                                  struct ompi_datatype_t **dtype, \
+                                                                  struct ompi_op_base_module_1_0_0_t *module) \
+{                                                                       \
+    size_t types_per_step;                                              \
+    size_t left_over = 2 * (size_t)*count;                              \
+    type *in = (type*)_in, *out = (type*)_out;                          \
+    OP_AVX_AVX512_COMPLEX_PROD_FUNC(type, ps, vsfx);                    \
+    OP_AVX_AVX_COMPLEX_PROD_FUNC(type, ps, vsfx);                       \
+    OP_AVX_SSE3_COMPLEX_PROD_FUNC(type, ps, vsfx);                      \
+    for( ; left_over > 0; left_over -= 2, in += 2, out += 2 ) {         \
+        type re = in[0] * out[0] - in[1] * out[1];                      \
+        type im = in[0] * out[1] + in[1] * out[0];                      \
+        out[0] = re;                                                    \
+        out[1] = im;                                                    \
+    }                                                                   \
+}
+
+/*
+ *  The sum of complex numbers is the sum of the underlying reals, so
+ *  forward to the real kernels with twice as many elements.
+ */
+#define OP_AVX_COMPLEX_SUM_FUNC(type_name, type)                        \
+static void OP_CONCAT(ompi_op_avx_2buff_sum_##type_name,PREPEND)(const void *_in, void *_out, int *count, \
+                                                                 struct ompi_datatype_t **dtype, \
+                                                                 struct ompi_op_base_module_1_0_0_t *module) \
+{                                                                       \
+    int left_over = *count;                                             \
+    type *in = (type*)_in, *out = (type*)_out;                          \
+    while( left_over > 0 ) {                                            \
+        int how_much = (left_over > INT_MAX / 2) ? INT_MAX / 2 : left_over; \
+        int real_count = 2 * how_much;                                  \
+        OP_CONCAT(ompi_op_avx_2buff_add_##type,PREPEND)(in, out, &real_count, dtype, module); \
+        left_over -= how_much;                                          \
+        in += real_count;                                               \
+        out += real_count;                                              \
+    }                                                                   \
+}
+
+/*************************************************************************
+ * Complex sum and product
+ *************************************************************************/
+    OP_AVX_COMPLEX_SUM_FUNC(c_float_complex, float)
+    OP_AVX_COMPLEX_SUM_FUNC(c_double_complex, double)
+    OP_AVX_COMPLEX_PROD_FUNC(c_float_complex, float, ps, )
+    OP_AVX_COMPLEX_PROD_FUNC(c_double_complex, double, pd, d)
+
 /*
  *  This is a three buffer (2 input and 1 output) version of the reduction
  *  routines, needed for some optimizations.
@@ -1337,6 +1811,357 @@ static void OP_CONCAT(ompi_op_avx_3buff_##op##_double,PREPEND)(const void *_in1,
     // not defined - OP_AVX_FLOAT_FUNC_3(xor)
     // not defined - OP_AVX_DOUBLE_FUNC_3(xor)
 
+/*
+ *  Three buffer versions of the logical operations (out = in1 op in2).
+ */
+#if defined(GENERATE_AVX512_CODE) && defined(OMPI_MCA_OP_HAVE_AVX512) && (1 == OMPI_MCA_OP_HAVE_AVX512)
+#if __AVX512F__ && __AVX512BW__
+#define OP_AVX_AVX512_LOGICAL_FUNC_3(name, type_size, type, op)         \
+    if( OMPI_OP_AVX_HAS_FLAGS(OMPI_OP_AVX_HAS_AVX512F_FLAG|OMPI_OP_AVX_HAS_AVX512BW_FLAG) ) { \
+        int types_per_step = (512 / 8) / sizeof(type);                  \
+        __m512i one = _mm512_set1_epi##type_size(1);                    \
+        for( ; left_over >= types_per_step; left_over -= types_per_step ) { \
+            __m512i vecA = _mm512_loadu_si512((__m512i*)in1);           \
+            __m512i vecB = _mm512_loadu_si512((__m512i*)in2);           \
+            in1 += types_per_step;                                      \
+            in2 += types_per_step;                                      \
+            vecA = _mm512_maskz_mov_epi##type_size(_mm512_test_epi##type_size##_mask(vecA, vecA), one); \
+            vecB = _mm512_maskz_mov_epi##type_size(_mm512_test_epi##type_size##_mask(vecB, vecB), one); \
+            __m512i res = _mm512_##op##_si512(vecA, vecB);              \
+            _mm512_storeu_si512((__m512i*)out, res);                    \
+            out += types_per_step;                                      \
+        }                                                               \
+        if( 0 == left_over ) return;                                    \
+    }
+#else
+#error Target architecture lacks AVX512F and AVX512BW support needed for _mm512_test_epi8_mask and _mm512_maskz_mov_epi8
+#endif  /* __AVX512F__ && __AVX512BW__ */
+#else
+#define OP_AVX_AVX512_LOGICAL_FUNC_3(name, type_size, type, op) {}
+#endif  /* defined(OMPI_MCA_OP_HAVE_AVX512) && (1 == OMPI_MCA_OP_HAVE_AVX512) */
+
+#if defined(GENERATE_AVX2_CODE) && defined(OMPI_MCA_OP_HAVE_AVX2) && (1 == OMPI_MCA_OP_HAVE_AVX2)
+#if __AVX2__
+#define OP_AVX_AVX2_LOGICAL_FUNC_3(name, type_size, type, op)           \
+    if( OMPI_OP_AVX_HAS_FLAGS(OMPI_OP_AVX_HAS_AVX2_FLAG | OMPI_OP_AVX_HAS_AVX_FLAG) ) { \
+        int types_per_step = (256 / 8) / sizeof(type);                  \
+        __m256i zero = _mm256_setzero_si256();                          \
+        __m256i one = _mm256_sub_epi##type_size(zero, _mm256_cmpeq_epi##type_size(zero, zero)); \
+        for( ; left_over >= types_per_step; left_over -= types_per_step ) { \
+            __m256i vecA = _mm256_loadu_si256((__m256i*)in1);           \
+            __m256i vecB = _mm256_loadu_si256((__m256i*)in2);           \
+            in1 += types_per_step;                                      \
+            in2 += types_per_step;                                      \
+            vecA = _mm256_andnot_si256(_mm256_cmpeq_epi##type_size(vecA, zero), one); \
+            vecB = _mm256_andnot_si256(_mm256_cmpeq_epi##type_size(vecB, zero), one); \
+            __m256i res = _mm256_##op##_si256(vecA, vecB);              \
+            _mm256_storeu_si256((__m256i*)out, res);                    \
+            out += types_per_step;                                      \
+        }                                                               \
+        if( 0 == left_over ) return;                                    \
+    }
+#else
+#error Target architecture lacks AVX2 support needed for _mm256_cmpeq_epi8 and _mm256_sub_epi8
+#endif  /* __AVX2__ */
+#else
+#define OP_AVX_AVX2_LOGICAL_FUNC_3(name, type_size, type, op) {}
+#endif  /* defined(OMPI_MCA_OP_HAVE_AVX2) && (1 == OMPI_MCA_OP_HAVE_AVX2) */
+
+#if defined(GENERATE_SSE41_CODE) && defined(OMPI_MCA_OP_HAVE_SSE41) && (1 == OMPI_MCA_OP_HAVE_SSE41) && defined(OMPI_MCA_OP_HAVE_AVX) && (1 == OMPI_MCA_OP_HAVE_AVX)
+#if __SSE4_1__ && __SSE3__
+#define OP_AVX_SSE4_1_LOGICAL_FUNC_3(name, type_size, type, op)         \
+    if( OMPI_OP_AVX_HAS_FLAGS(OMPI_OP_AVX_HAS_SSE3_FLAG | OMPI_OP_AVX_HAS_SSE4_1_FLAG) ) { \
+        int types_per_step = (128 / 8) / sizeof(type);                  \
+        __m128i zero = _mm_setzero_si128();                             \
+        __m128i one = _mm_sub_epi##type_size(zero, _mm_cmpeq_epi##type_size(zero, zero)); \
+        for( ; left_over >= types_per_step; left_over -= types_per_step ) { \
+            __m128i vecA = _mm_lddqu_si128((__m128i*)in1);              \
+            __m128i vecB = _mm_lddqu_si128((__m128i*)in2);              \
+            in1 += types_per_step;                                      \
+            in2 += types_per_step;                                      \
+            vecA = _mm_andnot_si128(_mm_cmpeq_epi##type_size(vecA, zero), one); \
+            vecB = _mm_andnot_si128(_mm_cmpeq_epi##type_size(vecB, zero), one); \
+            __m128i res = _mm_##op##_si128(vecA, vecB);                 \
+            _mm_storeu_si128((__m128i*)out, res);                       \
+            out += types_per_step;                                      \
+        }                                                               \
+    }
+#else
+#error Target architecture lacks SSE4.1 support needed for _mm_cmpeq_epi64
+#endif  /* __SSE4_1__ && __SSE3__ */
+#else
+#define OP_AVX_SSE4_1_LOGICAL_FUNC_3(name, type_size, type, op) {}
+#endif  /* defined(OMPI_MCA_OP_HAVE_SSE41) && (1 == OMPI_MCA_OP_HAVE_SSE41) */
+
+#define OP_AVX_LOGICAL_FUNC_3(name, type_size, type, op)                \
+static void OP_CONCAT(ompi_op_avx_3buff_##name##_##type,PREPEND)(const void *_in1, const void *_in2, \
+                                                                 void *_out, int *count, \
+                                                                 struct ompi_datatype_t **dtype, \
+                                                                 struct ompi_op_base_module_1_0_0_t *module) \
+{                                                                       \
+    int left_over = *count;                                             \
+    type *in1 = (type*)_in1, *in2 = (type*)_in2, *out = (type*)_out;    \
+    OP_AVX_AVX512_LOGICAL_FUNC_3(name, type_size, type, op);            \
+    OP_AVX_AVX2_LOGICAL_FUNC_3(name, type_size, type, op);              \
+    OP_AVX_SSE4_1_LOGICAL_FUNC_3(name, type_size, type, op);            \
+    while( left_over > 0 ) {                                            \
+        int how_much = (left_over > 8) ? 8 : left_over;                 \
+        switch(how_much) {                                              \
+        case 8: out[7] = current_func(in1[7], in2[7]);                  \
+        case 7: out[6] = current_func(in1[6], in2[6]);                  \
+        case 6: out[5] = current_func(in1[5], in2[5]);                  \
+        case 5: out[4] = current_func(in1[4], in2[4]);                  \
+        case 4: out[3] = current_func(in1[3], in2[3]);                  \
+        case 3: out[2] = current_func(in1[2], in2[2]);                  \
+        case 2: out[1] = current_func(in1[1], in2[1]);                  \
+        case 1: out[0] = current_func(in1[0], in2[0]);                  \
+        }                                                               \
+        left_over -= how_much;                                          \
+        out += how_much;                                                \
+        in1 += how_much;                                                \
+        in2 += how_much;                                                \
+    }                                                                   \
+}
+
+/*************************************************************************
+ * Logical AND
+ *************************************************************************/
+#undef current_func
+#define current_func(a, b) ((a) && (b))
+    OP_AVX_LOGICAL_FUNC_3(land, 8,    int8_t, and)
+    OP_AVX_LOGICAL_FUNC_3(land, 8,   uint8_t, and)
+    OP_AVX_LOGICAL_FUNC_3(land, 16,  int16_t, and)
+    OP_AVX_LOGICAL_FUNC_3(land, 16, uint16_t, and)
+    OP_AVX_LOGICAL_FUNC_3(land, 32,  int32_t, and)
+    OP_AVX_LOGICAL_FUNC_3(land, 32, uint32_t, and)
+    OP_AVX_LOGICAL_FUNC_3(land, 64,  int64_t, and)
+    OP_AVX_LOGICAL_FUNC_3(land, 64, uint64_t, and)
+
+/*************************************************************************
+ * Logical OR
+ *************************************************************************/
+#undef current_func
+#define current_func(a, b) ((a) || (b))
+    OP_AVX_LOGICAL_FUNC_3(lor, 8,    int8_t, or)
+    OP_AVX_LOGICAL_FUNC_3(lor, 8,   uint8_t, or)
+    OP_AVX_LOGICAL_FUNC_3(lor, 16,  int16_t, or)
+    OP_AVX_LOGICAL_FUNC_3(lor, 16, uint16_t, or)
+    OP_AVX_LOGICAL_FUNC_3(lor, 32,  int32_t, or)
+    OP_AVX_LOGICAL_FUNC_3(lor, 32, uint32_t, or)
+    OP_AVX_LOGICAL_FUNC_3(lor, 64,  int64_t, or)
+    OP_AVX_LOGICAL_FUNC_3(lor, 64, uint64_t, or)
+
+/*************************************************************************
+ * Logical XOR
+ *************************************************************************/
+#undef current_func
+#define current_func(a, b) ((a ? 1 : 0) ^ (b ? 1: 0))
+    OP_AVX_LOGICAL_FUNC_3(lxor, 8,    int8_t, xor)
+    OP_AVX_LOGICAL_FUNC_3(lxor, 8,   uint8_t, xor)
+    OP_AVX_LOGICAL_FUNC_3(lxor, 16,  int16_t, xor)
+    OP_AVX_LOGICAL_FUNC_3(lxor, 16, uint16_t, xor)
+    OP_AVX_LOGICAL_FUNC_3(lxor, 32,  int32_t, xor)
+    OP_AVX_LOGICAL_FUNC_3(lxor, 32, uint32_t, xor)
+    OP_AVX_LOGICAL_FUNC_3(lxor, 64,  int64_t, xor)
+    OP_AVX_LOGICAL_FUNC_3(lxor, 64, uint64_t, xor)
+
+/*
+ *  Three buffer versions of MAXLOC and MINLOC (out = in1 op in2).
+ */
+#if defined(GENERATE_AVX2_CODE) && defined(OMPI_MCA_OP_HAVE_AVX2) && (1 == OMPI_MCA_OP_HAVE_AVX2)
+#if __AVX2__
+#define OP_AVX_AVX2_LOC_FUNC_3(name, type_name)                         \
+    if( OMPI_OP_AVX_HAS_FLAGS(OMPI_OP_AVX_HAS_AVX2_FLAG | OMPI_OP_AVX_HAS_AVX_FLAG) ) { \
+        int types_per_step = (256 / 8) / sizeof(ompi_op_avx_##type_name##_t); \
+        for( ; left_over >= types_per_step; left_over -= types_per_step ) { \
+            __m256i vecA = _mm256_loadu_si256((__m256i*)in1);           \
+            __m256i vecB = _mm256_loadu_si256((__m256i*)in2);           \
+            in1 += types_per_step;                                      \
+            in2 += types_per_step;                                      \
+            __m256i res;                                                \
+            OP_AVX_AVX2_LOC_SELECT_##type_name(name, vecA, vecB, res);  \
+            _mm256_storeu_si256((__m256i*)out, res);                    \
+            out += types_per_step;                                      \
+        }                                                               \
+        if( 0 == left_over ) return;                                    \
+    }
+#else
+#error Target architecture lacks AVX2 support needed for _mm256_cmpgt_epi32 and _mm256_shuffle_epi32
+#endif  /* __AVX2__ */
+#else
+#define OP_AVX_AVX2_LOC_FUNC_3(name, type_name) {}
+#endif  /* defined(OMPI_MCA_OP_HAVE_AVX2) && (1 == OMPI_MCA_OP_HAVE_AVX2) */
+
+#define OP_AVX_LOC_FUNC_3(name, type_name)                              \
+static void OP_CONCAT(ompi_op_avx_3buff_##name##_##type_name,PREPEND)(const void *_in1, const void *_in2, \
+                                                                      void *_out, int *count, \
+                                                                      struct ompi_datatype_t **dtype, \
+                                                                      struct ompi_op_base_module_1_0_0_t *module) \
+{                                                                       \
+    int left_over = *count;                                             \
+    ompi_op_avx_##type_name##_t *in1 = (ompi_op_avx_##type_name##_t*)_in1; \
+    ompi_op_avx_##type_name##_t *in2 = (ompi_op_avx_##type_name##_t*)_in2; \
+    ompi_op_avx_##type_name##_t *out = (ompi_op_avx_##type_name##_t*)_out; \
+    OP_AVX_AVX2_LOC_FUNC_3(name, type_name);                            \
+    for( ; left_over > 0; --left_over, ++in1, ++in2, ++out ) {          \
+        if( in1->v OP_AVX_LOC_OP_##name in2->v ) {                      \
+            out->v = in1->v;                                            \
+            out->k = in1->k;                                            \
+        } else if( in1->v == in2->v ) {                                 \
+            out->v = in1->v;                                            \
+            out->k = (in2->k < in1->k ? in2->k : in1->k);               \
+        } else {                                                        \
+            out->v = in2->v;                                            \
+            out->k = in2->k;                                            \
+        }                                                               \
+    }                                                                   \
+}
+
+/*************************************************************************
+ * Max location
+ *************************************************************************/
+    OP_AVX_LOC_FUNC_3(maxloc, float_int)
+    OP_AVX_LOC_FUNC_3(maxloc, double_int)
+    OP_AVX_LOC_FUNC_3(maxloc, 2int)
+#if OMPI_OP_AVX_HAVE_2DOUBLE_PRECISION
+    OP_AVX_LOC_FUNC_3(maxloc, 2double_precision)
+#endif
+
+/*************************************************************************
+ * Min location
+ *************************************************************************/
+    OP_AVX_LOC_FUNC_3(minloc, float_int)
+    OP_AVX_LOC_FUNC_3(minloc, double_int)
+    OP_AVX_LOC_FUNC_3(minloc, 2int)
+#if OMPI_OP_AVX_HAVE_2DOUBLE_PRECISION
+    OP_AVX_LOC_FUNC_3(minloc, 2double_precision)
+#endif
+
+/*
+ *  Three buffer versions of the complex sum and product (out = in1 op in2).
+ */
+#if defined(GENERATE_AVX512_CODE) && defined(OMPI_MCA_OP_HAVE_AVX512) && (1 == OMPI_MCA_OP_HAVE_AVX512)
+#if __AVX512F__
+#define OP_AVX_AVX512_COMPLEX_PROD_FUNC_3(type, ps, vsfx)               \
+    if( OMPI_OP_AVX_HAS_FLAGS(OMPI_OP_AVX_HAS_AVX512F_FLAG) ) {         \
+        types_per_step = (512 / 8) / sizeof(type);                      \
+        for (; left_over >= types_per_step; left_over -= types_per_step) { \
+            __m512##vsfx vecA = _mm512_loadu_##ps(in1);                 \
+            __m512##vsfx vecB = _mm512_loadu_##ps(in2);                 \
+            in1 += types_per_step;                                      \
+            in2 += types_per_step;                                      \
+            __m512##vsfx res = OP_AVX_AVX512_CPROD_##ps(vecA, vecB);    \
+            _mm512_storeu_##ps(out, res);                               \
+            out += types_per_step;                                      \
+        }                                                               \
+        if( 0 != left_over ) {                                          \
+            __mmask16 mask = (__mmask16)((1U << left_over) - 1);        \
+            __m512##vsfx vecA = _mm512_maskz_loadu_##ps(mask, in1);     \
+            __m512##vsfx vecB = _mm512_maskz_loadu_##ps(mask, in2);     \
+            __m512##vsfx res = OP_AVX_AVX512_CPROD_##ps(vecA, vecB);    \
+            _mm512_mask_storeu_##ps(out, mask, res);                    \
+        }                                                               \
+        return;                                                         \
+    }
+#else
+#error Target architecture lacks AVX512F support needed for _mm512_mask_sub_ps and _mm512_mask_sub_pd
+#endif  /* __AVX512F__ */
+#else
+#define OP_AVX_AVX512_COMPLEX_PROD_FUNC_3(type, ps, vsfx) {}
+#endif  /* defined(OMPI_MCA_OP_HAVE_AVX512) && (1 == OMPI_MCA_OP_HAVE_AVX512) */
+
+#if defined(GENERATE_AVX2_CODE) && defined(OMPI_MCA_OP_HAVE_AVX2) && (1 == OMPI_MCA_OP_HAVE_AVX2)
+#if __AVX__
+#define OP_AVX_AVX_COMPLEX_PROD_FUNC_3(type, ps, vsfx)                  \
+    if( OMPI_OP_AVX_HAS_FLAGS(OMPI_OP_AVX_HAS_AVX_FLAG) ) {             \
+        types_per_step = (256 / 8) / sizeof(type);                      \
+        for( ; left_over >= types_per_step; left_over -= types_per_step ) { \
+            __m256##vsfx vecA = _mm256_loadu_##ps(in1);                 \
+            __m256##vsfx vecB = _mm256_loadu_##ps(in2);                 \
+            in1 += types_per_step;                                      \
+            in2 += types_per_step;                                      \
+            __m256##vsfx res = OP_AVX_AVX_CPROD_##ps(vecA, vecB);       \
+            _mm256_storeu_##ps(out, res);                               \
+            out += types_per_step;                                      \
+        }                                                               \
+        if( 0 == left_over ) return;                                    \
+    }
+#else
+#error Target architecture lacks AVX support needed for _mm256_addsub_ps and _mm256_addsub_pd
+#endif  /* __AVX__ */
+#else
+#define OP_AVX_AVX_COMPLEX_PROD_FUNC_3(type, ps, vsfx) {}
+#endif  /* defined(OMPI_MCA_OP_HAVE_AVX2) && (1 == OMPI_MCA_OP_HAVE_AVX2) */
+
+#if defined(GENERATE_SSE3_CODE) && defined(OMPI_MCA_OP_HAVE_SSE3) && (1 == OMPI_MCA_OP_HAVE_SSE3) && defined(OMPI_MCA_OP_HAVE_AVX) && (1 == OMPI_MCA_OP_HAVE_AVX)
+#if __SSE3__
+#define OP_AVX_SSE3_COMPLEX_PROD_FUNC_3(type, ps, vsfx)                 \
+    if( OMPI_OP_AVX_HAS_FLAGS(OMPI_OP_AVX_HAS_SSE3_FLAG) ) {            \
+        types_per_step = (128 / 8) / sizeof(type);                      \
+        for( ; left_over >= types_per_step; left_over -= types_per_step ) { \
+            __m128##vsfx vecA = _mm_loadu_##ps(in1);                    \
+            __m128##vsfx vecB = _mm_loadu_##ps(in2);                    \
+            in1 += types_per_step;                                      \
+            in2 += types_per_step;                                      \
+            __m128##vsfx res = OP_AVX_SSE3_CPROD_##ps(vecA, vecB);      \
+            _mm_storeu_##ps(out, res);                                  \
+            out += types_per_step;                                      \
+        }                                                               \
+    }
+#else
+#error Target architecture lacks SSE3 support needed for _mm_addsub_ps and _mm_addsub_pd
+#endif  /* __SSE3__ */
+#else
+#define OP_AVX_SSE3_COMPLEX_PROD_FUNC_3(type, ps, vsfx) {}
+#endif  /* defined(OMPI_MCA_OP_HAVE_SSE3) && (1 == OMPI_MCA_OP_HAVE_SSE3) */
+
+#define OP_AVX_COMPLEX_PROD_FUNC_3(type_name, type, ps, vsfx)           \
+static void OP_CONCAT(ompi_op_avx_3buff_prod_##type_name,PREPEND)(const void *_in1, const void *_in2, \
+                                                                  void *_out, int *count, \
+                                                                  struct ompi_datatype_t **dtype, \
+                                                                  struct ompi_op_base_module_1_0_0_t *module) \
+{                                                                       \
+    size_t types_per_step;                                              \
+    size_t left_over = 2 * (size_t)*count;                              \
+    type *in1 = (type*)_in1, *in2 = (type*)_in2, *out = (type*)_out;    \
+    OP_AVX_AVX512_COMPLEX_PROD_FUNC_3(type, ps, vsfx);                  \
+    OP_AVX_AVX_COMPLEX_PROD_FUNC_3(type, ps, vsfx);                     \
+    OP_AVX_SSE3_COMPLEX_PROD_FUNC_3(type, ps, vsfx);                    \
+    for( ; left_over > 0; left_over -= 2, in1 += 2, in2 += 2, out += 2 ) { \
+        type re = in1[0] * in2[0] - in1[1] * in2[1];                    \
+        type im = in1[0] * in2[1] + in1[1] * in2[0];                    \
+        out[0] = re;                                                    \
+        out[1] = im;                                                    \
+    }                                                                   \
+}
+
+#define OP_AVX_COMPLEX_SUM_FUNC_3(type_name, type)                      \
+static void OP_CONCAT(ompi_op_avx_3buff_sum_##type_name,PREPEND)(const void *_in1, const void *_in2, \
+                                                                 void *_out, int *count, \
+                                                                 struct ompi_datatype_t **dtype, \
+                                                                 struct ompi_op_base_module_1_0_0_t *module) \
+{                                                                       \
+    int left_over = *count;                                             \
+    type *in1 = (type*)_in1, *in2 = (type*)_in2, *out = (type*)_out;    \
+    while( left_over > 0 ) {                                            \
+        int how_much = (left_over > INT_MAX / 2) ? INT_MAX / 2 : left_over; \
+        int real_count = 2 * how_much;                                  \
+        OP_CONCAT(ompi_op_avx_3buff_add_##type,PREPEND)(in1, in2, out, &real_count, dtype, module); \
+        left_over -= how_much;                                          \
+        in1 += real_count;                                              \
+        in2 += real_count;                                              \
+        out += real_count;                                              \
+    }                                                                   \
+}
+
+/*************************************************************************
+ * Complex sum and product
+ *************************************************************************/
+    OP_AVX_COMPLEX_SUM_FUNC_3(c_float_complex, float)
+    OP_AVX_COMPLEX_SUM_FUNC_3(c_double_complex, double)
+    OP_AVX_COMPLEX_PROD_FUNC_3(c_float_complex, float, ps, )
+    OP_AVX_COMPLEX_PROD_FUNC_3(c_double_complex, double, pd, d)
+
 /** C integer ***********************************************************/
 #define C_INTEGER_8_16_32(name, ftype)                                                         \
     [OMPI_OP_BASE_TYPE_INT8_T]   = OP_CONCAT(ompi_op_avx_##ftype##_##name##_int8_t,PREPEND),   \
@@ -1370,6 +2195,25 @@ static void OP_CONCAT(ompi_op_avx_3buff_##op##_double,PREPEND)(const void *_in1,
     [OMPI_OP_BASE_TYPE_FLOAT] = FLOAT(name, ftype),                         \
     [OMPI_OP_BASE_TYPE_DOUBLE] = DOUBLE(name, ftype)
 
+/** C complex ***********************************************************/
+#define C_COMPLEX(name, ftype)                                                                         \
+    [OMPI_OP_BASE_TYPE_C_FLOAT_COMPLEX] = OP_CONCAT(ompi_op_avx_##ftype##_##name##_c_float_complex,PREPEND), \
+    [OMPI_OP_BASE_TYPE_C_DOUBLE_COMPLEX] = OP_CONCAT(ompi_op_avx_##ftype##_##name##_c_double_complex,PREPEND)
+
+/** Fortran and C pair types for MAXLOC and MINLOC **********************/
+#if OMPI_OP_AVX_HAVE_2DOUBLE_PRECISION
+#define TWODOUBLE_PRECISION(name, ftype)                                    \
+    [OMPI_OP_BASE_TYPE_2DOUBLE_PRECISION] = OP_CONCAT(ompi_op_avx_##ftype##_##name##_2double_precision,PREPEND),
+#else
+#define TWODOUBLE_PRECISION(name, ftype)
+#endif
+
+#define LOCATION(name, ftype)                                               \
+    TWODOUBLE_PRECISION(name, ftype)                                        \
+    [OMPI_OP_BASE_TYPE_FLOAT_INT] = OP_CONCAT(ompi_op_avx_##ftype##_##name##_float_int,PREPEND),   \
+    [OMPI_OP_BASE_TYPE_DOUBLE_INT] = OP_CONCAT(ompi_op_avx_##ftype##_##name##_double_int,PREPEND), \
+    [OMPI_OP_BASE_TYPE_2INT] = OP_CONCAT(ompi_op_avx_##ftype##_##name##_2int,PREPEND)
+
 /*
  * MPI_OP_NULL
  * All types
@@ -1401,15 +2245,17 @@ ompi_op_base_handler_fn_t OP_CONCAT(ompi_op_avx_functions, PREPEND)[OMPI_OP_BASE
     [OMPI_OP_BASE_FORTRAN_SUM] = {
         C_INTEGER(sum, 2buff),
         FLOATING_POINT(add, 2buff),
+        C_COMPLEX(sum, 2buff),
     },
     /* Corresponds to MPI_PROD */
     [OMPI_OP_BASE_FORTRAN_PROD] = {
         C_INTEGER_OPTIONAL(prod, 2buff),
         FLOATING_POINT(mul, 2buff),
+        C_COMPLEX(prod, 2buff),
     },
     /* Corresponds to MPI_LAND */
     [OMPI_OP_BASE_FORTRAN_LAND] = {
-        NULL,
+        C_INTEGER(land, 2buff),
     },
     /* Corresponds to MPI_BAND */
     [OMPI_OP_BASE_FORTRAN_BAND] = {
@@ -1417,7 +2263,7 @@ ompi_op_base_handler_fn_t OP_CONCAT(ompi_op_avx_functions, PREPEND)[OMPI_OP_BASE
     },
     /* Corresponds to MPI_LOR */
     [OMPI_OP_BASE_FORTRAN_LOR] = {
-        NULL,
+        C_INTEGER(lor, 2buff),
     },
     /* Corresponds to MPI_BOR */
     [OMPI_OP_BASE_FORTRAN_BOR] = {
@@ -1425,12 +2271,20 @@ ompi_op_base_handler_fn_t OP_CONCAT(ompi_op_avx_functions, PREPEND)[OMPI_OP_BASE
     },
     /* Corresponds to MPI_LXOR */
     [OMPI_OP_BASE_FORTRAN_LXOR] = {
-        NULL,
+        C_INTEGER(lxor, 2buff),
     },
     /* Corresponds to MPI_BXOR */
     [OMPI_OP_BASE_FORTRAN_BXOR] = {
         C_INTEGER(bxor, 2buff),
     },
+    /* Corresponds to MPI_MAXLOC */
+    [OMPI_OP_BASE_FORTRAN_MAXLOC] = {
+        LOCATION(maxloc, 2buff),
+    },
+    /* Corresponds to MPI_MINLOC */
+    [OMPI_OP_BASE_FORTRAN_MINLOC] = {
+        LOCATION(minloc, 2buff),
+    },
     /* Corresponds to MPI_REPLACE */
     [OMPI_OP_BASE_FORTRAN_REPLACE] = {
         /* (MPI_ACCUMULATE is handled differently than the other
@@ -1464,15 +2318,17 @@ ompi_op_base_3buff_handler_fn_t OP_CONCAT(ompi_op_avx_3buff_functions, PREPEND)[
     [OMPI_OP_BASE_FORTRAN_SUM] = {
         C_INTEGER(sum, 3buff),
         FLOATING_POINT(add, 3buff),
+        C_COMPLEX(sum, 3buff),
     },
     /* Corresponds to MPI_PROD */
     [OMPI_OP_BASE_FORTRAN_PROD] = {
         C_INTEGER_OPTIONAL(prod, 3buff),
         FLOATING_POINT(mul, 3buff),
+        C_COMPLEX(prod, 3buff),
     },
     /* Corresponds to MPI_LAND */
-    [OMPI_OP_BASE_FORTRAN_LAND] ={
-        NULL,
+    [OMPI_OP_BASE_FORTRAN_LAND] = {
+        C_INTEGER(land, 3buff),
     },
     /* Corresponds to MPI_BAND */
     [OMPI_OP_BASE_FORTRAN_BAND] = {
@@ -1480,7 +2336,7 @@ ompi_op_base_3buff_handler_fn_t OP_CONCAT(ompi_op_avx_3buff_functions, PREPEND)[
     },
     /* Corresponds to MPI_LOR */
     [OMPI_OP_BASE_FORTRAN_LOR] = {
-        NULL,
+        C_INTEGER(lor, 3buff),
     },
     /* Corresponds to MPI_BOR */
     [OMPI_OP_BASE_FORTRAN_BOR] = {
@@ -1488,12 +2344,20 @@ ompi_op_base_3buff_handler_fn_t OP_CONCAT(ompi_op_avx_3buff_functions, PREPEND)[
     },
     /* Corresponds to MPI_LXOR */
     [OMPI_OP_BASE_FORTRAN_LXOR] = {
-        NULL,
+        C_INTEGER(lxor, 3buff),
     },
     /* Corresponds to MPI_BXOR */
     [OMPI_OP_BASE_FORTRAN_BXOR] = {
         C_INTEGER(xor, 3buff),
     },
+    /* Corresponds to MPI_MAXLOC */
+    [OMPI_OP_BASE_FORTRAN_MAXLOC] = {
+        LOCATION(maxloc, 3buff),
+    },
+    /* Corresponds to MPI_MINLOC */
+    [OMPI_OP_BASE_FORTRAN_MINLOC] = {
+        LOCATION(minloc, 3buff),
+    },
     /* Corresponds to MPI_REPLACE */
     [OMPI_OP_BASE_FORTRAN_REPLACE] = {
         /* MPI_ACCUMULATE is handled differently than the other
@@ -116,6 +116,9 @@ struct ompi_osc_rdma_component_t {
 
     /** maximum count for network AMO usage */
     unsigned long network_amo_max_count;
+
+    /** maximum number of bytes of small accumulates buffered per target (0 disables) */
+    unsigned int acc_aggregate_size;
 };
 typedef struct ompi_osc_rdma_component_t ompi_osc_rdma_component_t;
 
@@ -173,6 +176,12 @@ struct ompi_osc_rdma_module_t {
     /** maximum count for network AMO usage */
     unsigned long network_amo_max_count;
 
+    /** maximum number of bytes of small accumulates buffered per target (0 disables) */
+    unsigned int acc_aggregate_size;
+
+    /** targets with buffered accumulates (protected by the module lock) */
+    opal_list_t acc_aggregations;
+
     /** global leader */
     ompi_osc_rdma_peer_t *leader;
 
@@ -584,13 +593,30 @@ static inline void ompi_osc_rdma_sync_rdma_dec (ompi_osc_rdma_sync_t *rdma_sync)
     ompi_osc_rdma_sync_rdma_dec_always (rdma_sync);
 }
 
+/**
+ * @brief issue buffered accumulates
+ *
+ * @param[in] sync            synchronization object being completed
+ *
+ * Issues the accumulates buffered for the target of a lock synchronization
+ * object or, for the global synchronization object, for all targets. Defined
+ * in osc_rdma_accumulate.c.
+ */
+int ompi_osc_rdma_acc_aggregate_flush_sync (ompi_osc_rdma_sync_t *sync);
+
 /**
  * @brief complete all outstanding rdma operations to all peers
  *
  * @param[in] module          osc rdma module
+ *
+ * @returns OMPI_SUCCESS or the error of issuing the buffered accumulates. the
+ *          operations that were issued are complete in either case.
  */
-static inline void ompi_osc_rdma_sync_rdma_complete (ompi_osc_rdma_sync_t *sync)
+static inline int ompi_osc_rdma_sync_rdma_complete (ompi_osc_rdma_sync_t *sync)
 {
+    /* buffered accumulates are part of the outstanding operations */
+    int ret = ompi_osc_rdma_acc_aggregate_flush_sync (sync);
+
 #if !defined(BTL_VERSION) || (BTL_VERSION < 310)
     do {
         opal_progress ();
@@ -606,6 +632,8 @@ static inline void ompi_osc_rdma_sync_rdma_complete (ompi_osc_rdma_sync_t *sync)
         }
     }  while (ompi_osc_rdma_sync_get_count (sync) || (sync->module->rdma_frag && (sync->module->rdma_frag->pending > 1)));
 #endif
+
+    return ret;
 }
 
 /**
@@ -789,6 +789,379 @@ static inline int cas_rdma (ompi_osc_rdma_sync_t *sync, const void *source_addr,
 }
 
 
+/**
+ * @brief start an accumulate on a resolved target region
+ *
+ * Orders the operation with respect to other accumulates from this process,
+ * acquires the accumulate lock if needed and starts the operation. On error the
+ * accumulate state of the peer is cleaned up.
+ */
+static int ompi_osc_rdma_acc_issue (ompi_osc_rdma_sync_t *sync, ompi_osc_rdma_peer_t *peer, const void *origin_addr,
+                                    int origin_count, ompi_datatype_t *origin_datatype, void *result_addr,
+                                    int result_count, ompi_datatype_t *result_datatype, uint64_t target_address,
+                                    mca_btl_base_registration_handle_t *target_handle, int target_count,
+                                    ompi_datatype_t *target_datatype, ompi_op_t *op,
+                                    ompi_osc_rdma_request_t *rdma_request)
+{
+    ompi_osc_rdma_module_t *module = sync->module;
+    bool lock_acquired = false;
+    int ret;
+
+    /* to ensure order wait until the previous accumulate completes */
+    while (!ompi_osc_rdma_peer_test_set_flag (peer, OMPI_OSC_RDMA_PEER_ACCUMULATING)) {
+        ompi_osc_rdma_progress (module);
+    }
+
+    /* get an exclusive lock on the peer if needed */
+    if (!ompi_osc_rdma_peer_is_exclusive (peer) && !module->acc_single_intrinsic) {
+        lock_acquired = true;
+        (void) ompi_osc_rdma_lock_acquire_exclusive (module, peer, offsetof (ompi_osc_rdma_state_t, accumulate_lock));
+    }
+
+    /* could not use network atomics. acquire the lock if needed and continue. */
+    if (!lock_acquired && !ompi_osc_rdma_peer_is_exclusive (peer)) {
+        lock_acquired = true;
+        (void) ompi_osc_rdma_lock_acquire_exclusive (module, peer, offsetof (ompi_osc_rdma_state_t, accumulate_lock));
+    }
+
+    if (ompi_osc_rdma_peer_local_base (peer)) {
+        /* local/self optimization */
+        ret = ompi_osc_rdma_gacc_local (origin_addr, origin_count, origin_datatype, result_addr, result_count,
+                                        result_datatype, peer, target_address, target_handle, target_count,
+                                        target_datatype, op, module, rdma_request, lock_acquired);
+    } else {
+        /* do not need to pass the lock acquired flag to this function. the value of the flag can be obtained
+         * just by calling ompi_osc_rdma_peer_is_exclusive() in this case. */
+        ret = ompi_osc_rdma_gacc_master (sync, origin_addr, origin_count, origin_datatype, result_addr, result_count,
+                                         result_datatype, peer, target_address, target_handle, target_count,
+                                         target_datatype, op, rdma_request);
+    }
+
+    if (OPAL_UNLIKELY(OMPI_SUCCESS != ret)) {
+        ompi_osc_rdma_peer_accumulate_cleanup (module, peer, lock_acquired);
+    }
+
+    return ret;
+}
+
+/******* accumulate aggregation *******/
+
+static void ompi_osc_rdma_acc_aggregation_construct (ompi_osc_rdma_acc_aggregation_t *aggregation)
+{
+    OBJ_CONSTRUCT(&aggregation->index, opal_hash_table_t);
+    aggregation->peer = NULL;
+    aggregation->sync = NULL;
+    aggregation->op = NULL;
+    aggregation->datatype = NULL;
+    aggregation->target_handle = NULL;
+    aggregation->count = 0;
+    aggregation->capacity = 0;
+    aggregation->addresses = NULL;
+    aggregation->values = NULL;
+    aggregation->pending = false;
+}
+
+static void ompi_osc_rdma_acc_aggregation_destruct (ompi_osc_rdma_acc_aggregation_t *aggregation)
+{
+    OBJ_DESTRUCT(&aggregation->index);
+    free (aggregation->addresses);
+    free (aggregation->values);
+}
+
+OBJ_CLASS_INSTANCE(ompi_osc_rdma_acc_aggregation_t, opal_list_item_t,
+                   ompi_osc_rdma_acc_aggregation_construct,
+                   ompi_osc_rdma_acc_aggregation_destruct);
+
+struct ompi_osc_rdma_acc_aggregation_entry_t {
+    uint64_t address;
+    size_t index;
+};
+typedef struct ompi_osc_rdma_acc_aggregation_entry_t ompi_osc_rdma_acc_aggregation_entry_t;
+
+static int ompi_osc_rdma_acc_aggregation_entry_cmp (const void *a, const void *b)
+{
+    const ompi_osc_rdma_acc_aggregation_entry_t *ea = (const ompi_osc_rdma_acc_aggregation_entry_t *) a;
+    const ompi_osc_rdma_acc_aggregation_entry_t *eb = (const ompi_osc_rdma_acc_aggregation_entry_t *) b;
+
+    return (ea->address < eb->address) ? -1 : (ea->address > eb->address);
+}
+
+/**
+ * @brief check if an accumulate can be buffered
+ *
+ * Only single predefined datatype accumulates without a result are buffered. Reordering
+ * and combining them must not change the result so the operation has to be commutative
+ * and, as floating point addition is not associative, only MPI_MIN and MPI_MAX are
+ * buffered for non-integer datatypes.
+ */
+static inline bool ompi_osc_rdma_acc_can_aggregate (ompi_osc_rdma_module_t *module, int origin_count,
+                                                    ompi_datatype_t *origin_datatype, void *result_addr,
+                                                    int target_count, ompi_datatype_t *target_datatype,
+                                                    ompi_op_t *op)
+{
+    if (0 == module->acc_aggregate_size || NULL != result_addr || MPI_WIN_FLAVOR_DYNAMIC == module->flavor) {
+        return false;
+    }
+
+    if (origin_datatype != target_datatype || origin_count != target_count ||
+        !ompi_datatype_is_predefined (target_datatype)) {
+        return false;
+    }
+
+    if (&ompi_mpi_op_replace.op == op || &ompi_mpi_op_no_op.op == op || !ompi_op_is_intrinsic (op) ||
+        !ompi_op_is_commute (op)) {
+        return false;
+    }
+
+    if (!(OMPI_DATATYPE_FLAG_DATA_INT & target_datatype->super.flags) &&
+        &ompi_mpi_op_min.op != op && &ompi_mpi_op_max.op != op) {
+        return false;
+    }
+
+    /* leave room for several operations in the buffer */
+    return (size_t) target_count * target_datatype->super.size * 8 <= module->acc_aggregate_size;
+}
+
+/**
+ * @brief issue the accumulates buffered for a peer
+ *
+ * The buffered elements are sorted by target address and each run of adjacent
+ * elements is issued as a single accumulate. The origin buffer of accumulates
+ * other than MPI_REPLACE is consumed before the operation is started so the
+ * packed values can be released as soon as all runs have been issued.
+ */
+static int ompi_osc_rdma_acc_aggregation_flush (ompi_osc_rdma_acc_aggregation_t *aggregation)
+{
+    ompi_osc_rdma_peer_t *peer = aggregation->peer;
+    ompi_osc_rdma_acc_aggregation_entry_t *entries;
+    mca_btl_base_registration_handle_t *target_handle;
+    ompi_osc_rdma_module_t *module;
+    ompi_osc_rdma_sync_t *sync;
+    ompi_datatype_t *datatype;
+    size_t count, dt_size, max_run, i, j;
+    ompi_op_t *op;
+    char *values;
+    int ret = OMPI_SUCCESS;
+
+    OPAL_THREAD_LOCK(&peer->lock);
+    count = aggregation->count;
+    if (0 == count) {
+        OPAL_THREAD_UNLOCK(&peer->lock);
+        return OMPI_SUCCESS;
+    }
+
+    sync = aggregation->sync;
+    module = sync->module;
+    op = aggregation->op;
+    datatype = aggregation->datatype;
+    target_handle = aggregation->target_handle;
+    dt_size = datatype->super.size;
+
+    entries = (ompi_osc_rdma_acc_aggregation_entry_t *) malloc (count * sizeof (*entries));
+    values = (char *) malloc (count * dt_size);
+    if (OPAL_UNLIKELY(NULL == entries || NULL == values)) {
+        OPAL_THREAD_UNLOCK(&peer->lock);
+        free (entries);
+        free (values);
+        return OMPI_ERR_OUT_OF_RESOURCE;
+    }
+
+    for (i = 0 ; i < count ; ++i) {
+        entries[i].address = aggregation->addresses[i];
+        entries[i].index = i;
+    }
+
+    qsort (entries, count, sizeof (*entries), ompi_osc_rdma_acc_aggregation_entry_cmp);
+
+    for (i = 0 ; i < count ; ++i) {
+        memcpy (values + i * dt_size, aggregation->values + entries[i].index * dt_size, dt_size);
+    }
+
+    aggregation->count = 0;
+    (void) opal_hash_table_remove_all (&aggregation->index);
+
+    OPAL_THREAD_LOCK(&module->lock);
+    if (aggregation->pending) {
+        opal_list_remove_item (&module->acc_aggregations, &aggregation->super);
+        aggregation->pending = false;
+    }
+    OPAL_THREAD_UNLOCK(&module->lock);
+    OPAL_THREAD_UNLOCK(&peer->lock);
+
+    OSC_RDMA_VERBOSE(MCA_BASE_VERBOSE_TRACE, "flushing %lu buffered accumulate elements to peer %d",
+                     (unsigned long) count, peer->rank);
+
+    /* without the accumulate lock larger runs would not be atomic. keep them within the
+     * size handled by network atomics. */
+    max_run = module->acc_single_intrinsic ? module->network_amo_max_count : count;
+    if (0 == max_run) {
+        max_run = 1;
+    }
+
+    for (i = 0 ; i < count ; i = j) {
+        for (j = i + 1 ; j < count && j - i < max_run &&
+                 entries[j].address == entries[j - 1].address + dt_size ; ++j);
+
+        ret = ompi_osc_rdma_acc_issue (sync, peer, values + i * dt_size, (int) (j - i), datatype, NULL, 0, NULL,
+                                       entries[i].address, target_handle, (int) (j - i), datatype, op, NULL);
+        if (OPAL_UNLIKELY(OMPI_SUCCESS != ret)) {
+            break;
+        }
+    }
+
+    free (entries);
+    free (values);
+
+    return ret;
+}
+
+static inline int ompi_osc_rdma_acc_aggregate_flush_peer (ompi_osc_rdma_peer_t *peer)
+{
+    if (NULL == peer || NULL == peer->acc_aggregation) {
+        return OMPI_SUCCESS;
+    }
+
+    return ompi_osc_rdma_acc_aggregation_flush (peer->acc_aggregation);
+}
+
+int ompi_osc_rdma_acc_aggregate_flush_sync (ompi_osc_rdma_sync_t *sync)
+{
+    ompi_osc_rdma_module_t *module = sync->module;
+    ompi_osc_rdma_acc_aggregation_t *aggregation;
+    int ret = OMPI_SUCCESS;
+
+    if (0 == module->acc_aggregate_size) {
+        return OMPI_SUCCESS;
+    }
+
+    if (OMPI_OSC_RDMA_SYNC_TYPE_LOCK == sync->type && &module->all_sync != sync) {
+        return ompi_osc_rdma_acc_aggregate_flush_peer (sync->peer_list.peer);
+    }
+
+    /* a flush removes the aggregation from the pending list */
+    while (OMPI_SUCCESS == ret) {
+        OPAL_THREAD_LOCK(&module->lock);
+        aggregation = (ompi_osc_rdma_acc_aggregation_t *) opal_list_get_first (&module->acc_aggregations);
+        if (opal_list_get_end (&module->acc_aggregations) == &aggregation->super) {
+            aggregation = NULL;
+        }
+        OPAL_THREAD_UNLOCK(&module->lock);
+
+        if (NULL == aggregation) {
+            break;
+        }
+
+        ret = ompi_osc_rdma_acc_aggregation_flush (aggregation);
+    }
+
+    return ret;
+}
+
+/**
+ * @brief buffer a small accumulate
+ *
+ * Adds the elements of the accumulate to the buffer of the peer, combining them with
+ * already buffered elements at the same target address. The buffer is issued first if
+ * it holds elements of a different operation, datatype or epoch, and afterwards if it
+ * is full.
+ */
+static int ompi_osc_rdma_acc_aggregate (ompi_osc_rdma_sync_t *sync, ompi_osc_rdma_peer_t *peer,
+                                        const void *origin_addr, int count, ompi_datatype_t *datatype,
+                                        uint64_t target_address, mca_btl_base_registration_handle_t *target_handle,
+                                        ompi_op_t *op)
+{
+    ompi_osc_rdma_module_t *module = sync->module;
+    size_t dt_size = datatype->super.size;
+    size_t capacity = module->acc_aggregate_size / dt_size;
+    const char *source = (const char *) origin_addr + datatype->super.true_lb;
+    ompi_osc_rdma_acc_aggregation_t *aggregation;
+    bool full;
+    void *slot;
+    int ret;
+
+    for (;;) {
+        OPAL_THREAD_LOCK(&peer->lock);
+        aggregation = peer->acc_aggregation;
+        if (NULL == aggregation) {
+            aggregation = OBJ_NEW(ompi_osc_rdma_acc_aggregation_t);
+            if (OPAL_UNLIKELY(NULL == aggregation)) {
+                OPAL_THREAD_UNLOCK(&peer->lock);
+                return OMPI_ERR_OUT_OF_RESOURCE;
+            }
+
+            aggregation->peer = peer;
+            (void) opal_hash_table_init (&aggregation->index, capacity);
+            peer->acc_aggregation = aggregation;
+        }
+
+        if (aggregation->capacity < capacity) {
+            uint64_t *addresses = realloc (aggregation->addresses, capacity * sizeof (uint64_t));
+            char *values;
+
+            if (OPAL_UNLIKELY(NULL == addresses)) {
+                OPAL_THREAD_UNLOCK(&peer->lock);
+                return OMPI_ERR_OUT_OF_RESOURCE;
+            }
+            aggregation->addresses = addresses;
+
+            values = realloc (aggregation->values, capacity * dt_size);
+            if (OPAL_UNLIKELY(NULL == values)) {
+                OPAL_THREAD_UNLOCK(&peer->lock);
+                return OMPI_ERR_OUT_OF_RESOURCE;
+            }
+            aggregation->values = values;
+            aggregation->capacity = capacity;
+        }
+
+        if (0 == aggregation->count || (aggregation->sync == sync && aggregation->op == op &&
+                                        aggregation->datatype == datatype &&
+                                        aggregation->target_handle == target_handle &&
+                                        aggregation->count + count <= capacity)) {
+            break;
+        }
+
+        OPAL_THREAD_UNLOCK(&peer->lock);
+
+        ret = ompi_osc_rdma_acc_aggregation_flush (aggregation);
+        if (OPAL_UNLIKELY(OMPI_SUCCESS != ret)) {
+            return ret;
+        }
+    }
+
+    aggregation->sync = sync;
+    aggregation->op = op;
+    aggregation->datatype = datatype;
+    aggregation->target_handle = target_handle;
+
+    for (int i = 0 ; i < count ; ++i, source += dt_size, target_address += dt_size) {
+        size_t index;
+
+        if (OPAL_SUCCESS == opal_hash_table_get_value_uint64 (&aggregation->index, target_address, &slot)) {
+            /* same target element. combine locally. */
+            index = (size_t) (uintptr_t) slot - 1;
+            ompi_op_reduce (op, (void *) source, aggregation->values + index * dt_size, 1, datatype);
+            continue;
+        }
+
+        index = aggregation->count++;
+        aggregation->addresses[index] = target_address;
+        memcpy (aggregation->values + index * dt_size, source, dt_size);
+        (void) opal_hash_table_set_value_uint64 (&aggregation->index, target_address, (void *) (uintptr_t) (index + 1));
+    }
+
+    if (!aggregation->pending) {
+        OPAL_THREAD_LOCK(&module->lock);
+        opal_list_append (&module->acc_aggregations, &aggregation->super);
+        aggregation->pending = true;
+        OPAL_THREAD_UNLOCK(&module->lock);
+    }
+
+    full = aggregation->count == capacity;
+    OPAL_THREAD_UNLOCK(&peer->lock);
+
+    return full ? ompi_osc_rdma_acc_aggregation_flush (aggregation) : OMPI_SUCCESS;
+}
+
 int ompi_osc_rdma_compare_and_swap (const void *origin_addr, const void *compare_addr, void *result_addr,
                                     ompi_datatype_t *dt, int target_rank, ptrdiff_t target_disp,
                                     ompi_win_t *win)
@@ -821,6 +1194,12 @@ int ompi_osc_rdma_compare_and_swap (const void *origin_addr, const void *compare
         return ret;
     }
 
+    /* issue any buffered accumulates first to keep accumulates to this target ordered */
+    ret = ompi_osc_rdma_acc_aggregate_flush_peer (peer);
+    if (OPAL_UNLIKELY(OMPI_SUCCESS != ret)) {
+        return ret;
+    }
+
     /* to ensure order wait until the previous accumulate completes */
     while (!ompi_osc_rdma_peer_test_set_flag (peer, OMPI_OSC_RDMA_PEER_ACCUMULATING)) {
         ompi_osc_rdma_progress (module);
@@ -891,7 +1270,6 @@ int ompi_osc_rdma_rget_accumulate_internal (ompi_win_t *win, const void *origin_
     uint64_t target_address;
     ptrdiff_t target_lb, target_span;
     ompi_osc_rdma_request_t *rdma_request = NULL;
-    bool lock_acquired = false;
     ompi_osc_rdma_sync_t *sync;
     ompi_osc_rdma_peer_t *peer;
     int ret;
@@ -924,42 +1302,39 @@ int ompi_osc_rdma_rget_accumulate_internal (ompi_win_t *win, const void *origin_
         return ret;
     }
 
-    /* to ensure order wait until the previous accumulate completes */
-    while (!ompi_osc_rdma_peer_test_set_flag (peer, OMPI_OSC_RDMA_PEER_ACCUMULATING)) {
-        ompi_osc_rdma_progress (module);
-    }
-
-    /* get an exclusive lock on the peer if needed */
-    if (!ompi_osc_rdma_peer_is_exclusive (peer) && !module->acc_single_intrinsic) {
-        lock_acquired = true;
-        (void) ompi_osc_rdma_lock_acquire_exclusive (module, peer, offsetof (ompi_osc_rdma_state_t, accumulate_lock));
-    }
-
-    /* could not use network atomics. acquire the lock if needed and continue. */
-    if (!lock_acquired && !ompi_osc_rdma_peer_is_exclusive (peer)) {
-        lock_acquired = true;
-        (void) ompi_osc_rdma_lock_acquire_exclusive (module, peer, offsetof (ompi_osc_rdma_state_t, accumulate_lock));
-    }
+    if (ompi_osc_rdma_acc_can_aggregate (module, origin_count, origin_datatype, result_addr, target_count,
+                                         target_datatype, op)) {
+        ret = ompi_osc_rdma_acc_aggregate (sync, peer, origin_addr, target_count, target_datatype,
+                                           target_address, target_handle, op);
+        if (rdma_request) {
+            if (OPAL_UNLIKELY(OMPI_SUCCESS != ret)) {
+                *request_out = &ompi_request_null.request;
+                OMPI_OSC_RDMA_REQUEST_RETURN(rdma_request);
+            } else {
+                /* the origin buffer has been consumed */
+                ompi_osc_rdma_request_complete (rdma_request, MPI_SUCCESS);
+            }
+        }
 
-    if (ompi_osc_rdma_peer_local_base (peer)) {
-        /* local/self optimization */
-        ret = ompi_osc_rdma_gacc_local (origin_addr, origin_count, origin_datatype, result_addr, result_count,
-                                        result_datatype, peer, target_address, target_handle, target_count,
-                                        target_datatype, op, module, rdma_request, lock_acquired);
-    } else {
-        /* do not need to pass the lock acquired flag to this function. the value of the flag can be obtained
-         * just by calling ompi_osc_rdma_peer_is_exclusive() in this case. */
-        ret = ompi_osc_rdma_gacc_master (sync, origin_addr, origin_count, origin_datatype, result_addr, result_count,
-                                         result_datatype, peer, target_address, target_handle, target_count,
-                                         target_datatype, op, rdma_request);
+        return ret;
     }
 
+    /* keep accumulates to this target ordered */
+    ret = ompi_osc_rdma_acc_aggregate_flush_peer (peer);
     if (OPAL_UNLIKELY(OMPI_SUCCESS != ret)) {
         if (request_out) {
             *request_out = &ompi_request_null.request;
             OMPI_OSC_RDMA_REQUEST_RETURN(rdma_request);
         }
-        ompi_osc_rdma_peer_accumulate_cleanup (module, peer, lock_acquired);
+        return ret;
+    }
+
+    ret = ompi_osc_rdma_acc_issue (sync, peer, origin_addr, origin_count, origin_datatype, result_addr,
+                                   result_count, result_datatype, target_address, target_handle, target_count,
+                                   target_datatype, op, rdma_request);
+    if (OPAL_UNLIKELY(OMPI_SUCCESS != ret) && request_out) {
+        *request_out = &ompi_request_null.request;
+        OMPI_OSC_RDMA_REQUEST_RETURN(rdma_request);
     }
 
     return ret;
@@ -16,6 +16,50 @@
 
 #include "osc_rdma.h"
 
+/**
+ * @brief per-target buffer of small accumulates
+ *
+ * Small accumulates with the same intrinsic operation and predefined datatype
+ * are not issued immediately but kept here, one element per target address,
+ * until the epoch is completed, another kind of accumulate is started on the
+ * target or the buffer is full. Elements that hit the same address are reduced
+ * locally and adjacent elements are issued together as a single operation.
+ */
+struct ompi_osc_rdma_acc_aggregation_t {
+    opal_list_item_t super;
+
+    /** target of the buffered accumulates */
+    ompi_osc_rdma_peer_t *peer;
+
+    /** synchronization object the accumulates were started in */
+    ompi_osc_rdma_sync_t *sync;
+
+    /** operation and predefined datatype of all buffered elements */
+    ompi_op_t *op;
+    ompi_datatype_t *datatype;
+
+    /** registration handle of the target region */
+    mca_btl_base_registration_handle_t *target_handle;
+
+    /** target address -> element index + 1 */
+    opal_hash_table_t index;
+
+    /** number of buffered elements and allocated slots */
+    size_t count;
+    size_t capacity;
+
+    /** target address of each element */
+    uint64_t *addresses;
+
+    /** value of each element (capacity * datatype size bytes) */
+    char *values;
+
+    /** aggregation is on the module's pending list */
+    bool pending;
+};
+typedef struct ompi_osc_rdma_acc_aggregation_t ompi_osc_rdma_acc_aggregation_t;
+OBJ_CLASS_DECLARATION(ompi_osc_rdma_acc_aggregation_t);
+
 int ompi_osc_rdma_compare_and_swap (const void *origin_addr, const void *compare_addr, void *result_addr,
                                     ompi_datatype_t *dt, int target_rank, ptrdiff_t target_disp,
                                     ompi_win_t *win);
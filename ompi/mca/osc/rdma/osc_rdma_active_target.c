@@ -450,7 +450,7 @@ int ompi_osc_rdma_complete_atomic (ompi_win_t *win)
     ompi_osc_rdma_peer_t **peers;
     ompi_group_t *group;
     int group_size;
-    int ret __opal_attribute_unused__;
+    int ret __opal_attribute_unused__, complete_ret;
 
     OSC_RDMA_VERBOSE(MCA_BASE_VERBOSE_TRACE, "complete: %s", win->w_name);
 
@@ -481,7 +481,9 @@ int ompi_osc_rdma_complete_atomic (ompi_win_t *win)
 
     OPAL_THREAD_UNLOCK(&(module->lock));
 
-    ompi_osc_rdma_sync_rdma_complete (sync);
+    /* the targets are told about the completion even if an operation failed
+     * so that they do not wait forever */
+    complete_ret = ompi_osc_rdma_sync_rdma_complete (sync);
 
     /* for each process in the group increment their number of complete messages */
     for (int i = 0 ; i < group_size ; ++i) {
@@ -501,7 +503,7 @@ int ompi_osc_rdma_complete_atomic (ompi_win_t *win)
 
     OSC_RDMA_VERBOSE(MCA_BASE_VERBOSE_TRACE, "complete complete");
 
-    return OMPI_SUCCESS;
+    return complete_ret;
 }
 
 int ompi_osc_rdma_wait_atomic (ompi_win_t *win)
@@ -590,7 +592,7 @@ int ompi_osc_rdma_test_atomic (ompi_win_t *win, int *flag)
 int ompi_osc_rdma_fence_atomic (int mpi_assert, ompi_win_t *win)
 {
     ompi_osc_rdma_module_t *module = GET_MODULE(win);
-    int ret = OMPI_SUCCESS;
+    int ret = OMPI_SUCCESS, complete_ret;
 
     OSC_RDMA_VERBOSE(MCA_BASE_VERBOSE_TRACE, "fence: %d, %s", mpi_assert, win->w_name);
 
@@ -621,10 +623,13 @@ int ompi_osc_rdma_fence_atomic (int mpi_assert, ompi_win_t *win)
      * may be local stores that will not be visible as they should if we do not barrier. since that is the
      * case there is no optimization for NOPRECEDE */
 
-    ompi_osc_rdma_sync_rdma_complete (&module->all_sync);
+    complete_ret = ompi_osc_rdma_sync_rdma_complete (&module->all_sync);
 
     /* ensure all writes to my memory are complete (both local stores, and RMA operations) */
     ret = module->comm->c_coll->coll_barrier(module->comm, module->comm->c_coll->coll_barrier_module);
+    if (OMPI_SUCCESS == ret) {
+        ret = complete_ret;
+    }
 
     if (mpi_assert & MPI_MODE_NOSUCCEED) {
         /* as specified in MPI-3 p 438 3-5 the fence can end an epoch. it isn't explicitly
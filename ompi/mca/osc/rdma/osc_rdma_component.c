@@ -305,6 +305,16 @@ static int ompi_osc_rdma_component_register (void)
                                             MCA_BASE_VAR_TYPE_UNSIGNED_LONG, NULL, 0, 0, OPAL_INFO_LVL_3,
                                             MCA_BASE_VAR_SCOPE_LOCAL, &mca_osc_rdma_component.network_amo_max_count);
 
+    mca_osc_rdma_component.acc_aggregate_size = 4096;
+    (void) mca_base_component_var_register (&mca_osc_rdma_component.super.osc_version, "acc_aggregate_size",
+                                            "Maximum number of bytes of small accumulate operations buffered per "
+                                            "target. Buffered accumulates using the same operation on integer "
+                                            "datatypes (or MPI_MIN/MPI_MAX on any predefined datatype) are "
+                                            "combined locally and issued together when the epoch is completed or "
+                                            "the buffer is full. Set to 0 to disable (default: 4096)",
+                                            MCA_BASE_VAR_TYPE_UNSIGNED_INT, NULL, 0, 0, OPAL_INFO_LVL_5,
+                                            MCA_BASE_VAR_SCOPE_LOCAL, &mca_osc_rdma_component.acc_aggregate_size);
+
     /* register performance variables */
 
     (void) mca_base_component_pvar_register (&mca_osc_rdma_component.super.osc_version, "put_retry_count",
@@ -1325,6 +1335,7 @@ static int ompi_osc_rdma_component_select (struct ompi_win_t *win, void **base,
     OBJ_CONSTRUCT(&module->pending_posts, opal_list_t);
     OBJ_CONSTRUCT(&module->peer_lock, opal_mutex_t);
     OBJ_CONSTRUCT(&module->all_sync, ompi_osc_rdma_sync_t);
+    OBJ_CONSTRUCT(&module->acc_aggregations, opal_list_t);
 
     module->same_disp_unit = check_config_value_bool ("same_disp_unit", info);
     module->same_size      = check_config_value_bool ("same_size", info);
@@ -1333,6 +1344,7 @@ static int ompi_osc_rdma_component_select (struct ompi_win_t *win, void **base,
     module->acc_single_intrinsic = check_config_value_bool ("acc_single_intrinsic", info);
     module->acc_use_amo = mca_osc_rdma_component.acc_use_amo;
     module->network_amo_max_count = mca_osc_rdma_component.network_amo_max_count;
+    module->acc_aggregate_size = mca_osc_rdma_component.acc_aggregate_size;
 
     module->selected_btls_size = MCA_OSC_RDMA_BTLS_SIZE_INIT;
     module->selected_btls = calloc(module->selected_btls_size, sizeof(struct mca_btl_base_module_t *));
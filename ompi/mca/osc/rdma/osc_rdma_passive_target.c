@@ -40,6 +40,7 @@ int ompi_osc_rdma_flush (int target, struct ompi_win_t *win)
     ompi_osc_rdma_module_t *module = GET_MODULE(win);
     ompi_osc_rdma_sync_t *lock;
     ompi_osc_rdma_peer_t *peer;
+    int ret;
 
     assert (0 <= target);
 
@@ -57,11 +58,11 @@ int ompi_osc_rdma_flush (int target, struct ompi_win_t *win)
     OPAL_THREAD_UNLOCK(&module->lock);
 
     /* finish all outstanding fragments */
-    ompi_osc_rdma_sync_rdma_complete (lock);
+    ret = ompi_osc_rdma_sync_rdma_complete (lock);
 
     OSC_RDMA_VERBOSE(MCA_BASE_VERBOSE_TRACE, "flush on target %d complete", target);
 
-    return OMPI_SUCCESS;
+    return ret;
 }
 
 
@@ -69,7 +70,7 @@ int ompi_osc_rdma_flush_all (struct ompi_win_t *win)
 {
     ompi_osc_rdma_module_t *module = GET_MODULE(win);
     ompi_osc_rdma_sync_t *lock;
-    int ret = OMPI_SUCCESS;
+    int ret = OMPI_SUCCESS, flush_ret = OMPI_SUCCESS;
     uint32_t key;
     void *node;
 
@@ -82,21 +83,26 @@ int ompi_osc_rdma_flush_all (struct ompi_win_t *win)
 
     /* globally complete all outstanding rdma requests */
     if (OMPI_OSC_RDMA_SYNC_TYPE_LOCK == module->all_sync.type) {
-        ompi_osc_rdma_sync_rdma_complete (&module->all_sync);
+        flush_ret = ompi_osc_rdma_sync_rdma_complete (&module->all_sync);
     }
 
-    /* flush all locks */
+    /* flush all locks. keep going on error, report the first one */
     ret = opal_hash_table_get_first_key_uint32 (&module->outstanding_locks, &key, (void **) &lock, &node);
     while (OPAL_SUCCESS == ret) {
+        int lock_ret;
+
         OSC_RDMA_VERBOSE(MCA_BASE_VERBOSE_DEBUG, "flushing lock %p", (void *) lock);
-        ompi_osc_rdma_sync_rdma_complete (lock);
+        lock_ret = ompi_osc_rdma_sync_rdma_complete (lock);
+        if (OMPI_SUCCESS == flush_ret) {
+            flush_ret = lock_ret;
+        }
         ret = opal_hash_table_get_next_key_uint32 (&module->outstanding_locks, &key, (void **) &lock,
                                                    node, &node);
     }
 
     OSC_RDMA_VERBOSE(MCA_BASE_VERBOSE_TRACE, "flush_all complete");
 
-    return OPAL_SUCCESS;
+    return flush_ret;
 }
 
 
@@ -270,7 +276,7 @@ int ompi_osc_rdma_unlock_atomic (int target, ompi_win_t *win)
     ompi_osc_rdma_module_t *module = GET_MODULE(win);
     ompi_osc_rdma_peer_t *peer;
     ompi_osc_rdma_sync_t *lock;
-    int ret = OMPI_SUCCESS;
+    int ret = OMPI_SUCCESS, complete_ret;
 
     OPAL_THREAD_LOCK(&module->lock);
 
@@ -286,12 +292,16 @@ int ompi_osc_rdma_unlock_atomic (int target, ompi_win_t *win)
 
     ompi_osc_rdma_module_lock_remove (module, lock);
 
-    /* finish all outstanding fragments */
-    ompi_osc_rdma_sync_rdma_complete (lock);
+    /* finish all outstanding fragments. the lock is released even if an
+     * operation failed. */
+    complete_ret = ompi_osc_rdma_sync_rdma_complete (lock);
 
     if (!(lock->sync.lock.mpi_assert & MPI_MODE_NOCHECK)) {
         ret = ompi_osc_rdma_unlock_atomic_internal (module, peer, lock);
     }
+    if (OMPI_SUCCESS == ret) {
+        ret = complete_ret;
+    }
 
     /* release our reference to this peer */
     OBJ_RELEASE(peer);
@@ -382,6 +392,7 @@ int ompi_osc_rdma_unlock_all_atomic (struct ompi_win_t *win)
 {
     ompi_osc_rdma_module_t *module = GET_MODULE(win);
     ompi_osc_rdma_sync_t *lock;
+    int ret;
 
     OSC_RDMA_VERBOSE(MCA_BASE_VERBOSE_TRACE, "unlock_all: %s", win->w_name);
 
@@ -394,8 +405,9 @@ int ompi_osc_rdma_unlock_all_atomic (struct ompi_win_t *win)
         return OMPI_ERR_RMA_SYNC;
     }
 
-    /* finish all outstanding fragments */
-    ompi_osc_rdma_sync_rdma_complete (lock);
+    /* finish all outstanding fragments. the locks are released even if an
+     * operation failed. */
+    ret = ompi_osc_rdma_sync_rdma_complete (lock);
 
     if (0 == (lock->sync.lock.mpi_assert & MPI_MODE_NOCHECK)) {
         if (OMPI_OSC_RDMA_LOCKING_ON_DEMAND == module->locking_mode) {
@@ -425,5 +437,5 @@ int ompi_osc_rdma_unlock_all_atomic (struct ompi_win_t *win)
 
     OSC_RDMA_VERBOSE(MCA_BASE_VERBOSE_TRACE, "unlock_all complete");
 
-    return OMPI_SUCCESS;
+    return ret;
 }
@@ -20,6 +20,7 @@
 #endif
 
 #include "osc_rdma_comm.h"
+#include "osc_rdma_accumulate.h"
 
 #include "ompi/mca/bml/base/base.h"
 
@@ -328,6 +329,10 @@ static void ompi_osc_rdma_peer_destruct (ompi_osc_rdma_peer_t *peer)
     if (peer->state_handle && (peer->flags & OMPI_OSC_RDMA_PEER_STATE_FREE)) {
         free (peer->state_handle);
     }
+
+    if (peer->acc_aggregation) {
+        OBJ_RELEASE(peer->acc_aggregation);
+    }
 }
 
 OBJ_CLASS_INSTANCE(ompi_osc_rdma_peer_t, opal_list_item_t,
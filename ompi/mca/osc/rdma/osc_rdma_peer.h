@@ -15,6 +15,7 @@
 #include "osc_rdma_types.h"
 
 struct ompi_osc_rdma_module_t;
+struct ompi_osc_rdma_acc_aggregation_t;
 
 /**
  * @brief osc rdma peer object
@@ -50,6 +51,9 @@ struct ompi_osc_rdma_peer_t {
 
     /** index into BTL array */
     uint8_t state_btl_index;
+
+    /** small accumulates buffered for this peer (protected by the peer lock) */
+    struct ompi_osc_rdma_acc_aggregation_t *acc_aggregation;
 };
 typedef struct ompi_osc_rdma_peer_t ompi_osc_rdma_peer_t;
 
@@ -23,6 +23,15 @@ typedef opal_atomic_uint64_t osc_sm_post_atomic_type_t;
 #define OSC_SM_POST_BITS 6
 #define OSC_SM_POST_MASK 0x3f
 
+/* accumulates that do not use processor atomics serialize on a set of
+ * lock stripes per target, each covering 2^OSC_SM_ACC_LOCK_SHIFT bytes of
+ * the target window (modulo OSC_SM_ACC_LOCK_COUNT) */
+#define OSC_SM_ACC_LOCK_COUNT 16
+#define OSC_SM_ACC_LOCK_SHIFT 8
+/* set in the state of a stripe while it is locked. the other bits count
+ * the accumulates updating the stripe with processor atomics. */
+#define OSC_SM_ACC_LOCK_WRITER 0x40000000
+
 /* data shared across all peers */
 struct ompi_osc_sm_global_state_t {
     int use_barrier_for_fence;
@@ -43,10 +52,19 @@ struct ompi_osc_sm_lock_t {
 };
 typedef struct ompi_osc_sm_lock_t ompi_osc_sm_lock_t;
 
+/* keep every accumulate lock stripe on its own cache line */
+struct ompi_osc_sm_acc_lock_t {
+    opal_atomic_int32_t state;
+    char padding[64 - sizeof(opal_atomic_int32_t)];
+};
+typedef struct ompi_osc_sm_acc_lock_t ompi_osc_sm_acc_lock_t;
+
 struct ompi_osc_sm_node_state_t {
     opal_atomic_int32_t complete_count;
     ompi_osc_sm_lock_t lock;
-    opal_atomic_lock_t accumulate_lock;
+    ompi_osc_sm_acc_lock_t accumulate_locks[OSC_SM_ACC_LOCK_COUNT];
+    /* serializes the misaligned elements of accumulates using atomics */
+    opal_atomic_lock_t misaligned_lock;
 };
 typedef struct ompi_osc_sm_node_state_t ompi_osc_sm_node_state_t;
 
@@ -54,6 +72,8 @@ struct ompi_osc_sm_component_t {
     ompi_osc_base_component_t super;
 
     char *backing_directory;
+    /** largest accumulate (in bytes) done with processor atomics */
+    size_t acc_atomic_max_size;
 };
 typedef struct ompi_osc_sm_component_t ompi_osc_sm_component_t;
 OMPI_DECLSPEC extern ompi_osc_sm_component_t mca_osc_sm_component;
@@ -14,12 +14,475 @@
 
 #include "ompi_config.h"
 
+#include "opal/datatype/opal_convertor.h"
+#include "opal/datatype/opal_datatype_internal.h"
+
 #include "ompi/mca/osc/osc.h"
 #include "ompi/mca/osc/base/base.h"
 #include "ompi/mca/osc/base/osc_base_obj_convert.h"
+#include "ompi/op/op.h"
 
 #include "osc_sm.h"
 
+#define OSC_SM_DECODE_MAX 32
+
+/*
+ * Small accumulate operations are performed with processor atomics, one
+ * element at a time, whenever the primitive type of the target is a 32 or
+ * 64 bit integer or floating point type. Larger ones, and those on any
+ * other type, lock the stripes covering the target range and reduce it
+ * with a single call to the op. The atomic updates announce themselves in
+ * the stripes they touch, and a stripe is only locked once they drained,
+ * so the two paths stay atomic with respect to each other. Mixing
+ * different ops on the same location is ruled out by the accumulate_ops
+ * info key (same_op_no_op or same_op). Every operation completes before
+ * returning, which preserves any accumulate_ordering.
+ */
+
+enum {
+    OSC_SM_ATOMIC_NONE = 0,
+    OSC_SM_ATOMIC_INT,
+    OSC_SM_ATOMIC_UINT,
+    OSC_SM_ATOMIC_FLOAT,
+};
+
+static inline int ompi_osc_sm_atomic_class (ompi_datatype_t *dt)
+{
+    if (4 != dt->super.size
+#if OPAL_HAVE_ATOMIC_COMPARE_EXCHANGE_64
+        && 8 != dt->super.size
+#endif
+        ) {
+        return OSC_SM_ATOMIC_NONE;
+    }
+
+    switch (dt->super.id) {
+    case OPAL_DATATYPE_INT4:
+    case OPAL_DATATYPE_INT8:
+    case OPAL_DATATYPE_LONG:
+        return OSC_SM_ATOMIC_INT;
+    case OPAL_DATATYPE_UINT4:
+    case OPAL_DATATYPE_UINT8:
+    case OPAL_DATATYPE_UNSIGNED_LONG:
+        return OSC_SM_ATOMIC_UINT;
+    case OPAL_DATATYPE_FLOAT4:
+    case OPAL_DATATYPE_FLOAT8:
+        return OSC_SM_ATOMIC_FLOAT;
+    }
+
+    return OSC_SM_ATOMIC_NONE;
+}
+
+/* mask of the lock stripes covering len bytes at addr in the window of
+ * target. stripes are keyed on the offset in the target window as the
+ * segment is mapped at a different address in every process. */
+static inline uint32_t ompi_osc_sm_acc_lock_mask (ompi_osc_sm_module_t *module, int target,
+                                                  const void *addr, size_t len)
+{
+    ptrdiff_t offset = (ptrdiff_t) ((uintptr_t) addr - (uintptr_t) module->bases[target]);
+    size_t first, last;
+    uint32_t mask = 0;
+
+    if (0 == len) {
+        return 0;
+    }
+
+    if (offset < 0) {
+        return (uint32_t) ((1ull << OSC_SM_ACC_LOCK_COUNT) - 1);
+    }
+
+    first = (size_t) offset >> OSC_SM_ACC_LOCK_SHIFT;
+    last = ((size_t) offset + len - 1) >> OSC_SM_ACC_LOCK_SHIFT;
+    if (last - first + 1 >= OSC_SM_ACC_LOCK_COUNT) {
+        return (uint32_t) ((1ull << OSC_SM_ACC_LOCK_COUNT) - 1);
+    }
+
+    for (size_t i = first ; i <= last ; ++i) {
+        mask |= 1u << (i % OSC_SM_ACC_LOCK_COUNT);
+    }
+
+    return mask;
+}
+
+static inline uint32_t ompi_osc_sm_acc_lock_mask_dt (ompi_osc_sm_module_t *module, int target,
+                                                     const void *addr, int count,
+                                                     ompi_datatype_t *dt)
+{
+    ptrdiff_t lb, extent, true_lb, true_extent;
+
+    if (0 == count) {
+        return 0;
+    }
+
+    ompi_datatype_get_extent (dt, &lb, &extent);
+    ompi_datatype_get_true_extent (dt, &true_lb, &true_extent);
+
+    return ompi_osc_sm_acc_lock_mask (module, target, (const char *) addr + true_lb,
+                                      (size_t) ((count - 1) * extent + true_extent));
+}
+
+/* stripes are always taken in increasing order to avoid deadlocks. a
+ * stripe is held once the atomic updates on it are done. */
+static inline void ompi_osc_sm_acc_lock (ompi_osc_sm_module_t *module, int target, uint32_t mask)
+{
+    ompi_osc_sm_acc_lock_t *stripes = module->node_states[target].accumulate_locks;
+
+    for (int i = 0 ; i < OSC_SM_ACC_LOCK_COUNT ; ++i) {
+        if (mask & (1u << i)) {
+            while (opal_atomic_fetch_or_32 (&stripes[i].state, OSC_SM_ACC_LOCK_WRITER) &
+                   OSC_SM_ACC_LOCK_WRITER) {
+                while (stripes[i].state & OSC_SM_ACC_LOCK_WRITER) {
+                    opal_atomic_rmb ();
+                }
+            }
+            opal_atomic_mb ();
+            while (stripes[i].state != OSC_SM_ACC_LOCK_WRITER) {
+                opal_atomic_rmb ();
+            }
+        }
+    }
+}
+
+static inline void ompi_osc_sm_acc_unlock (ompi_osc_sm_module_t *module, int target, uint32_t mask)
+{
+    ompi_osc_sm_acc_lock_t *stripes = module->node_states[target].accumulate_locks;
+
+    opal_atomic_wmb ();
+    for (int i = OSC_SM_ACC_LOCK_COUNT - 1 ; i >= 0 ; --i) {
+        if (mask & (1u << i)) {
+            (void) opal_atomic_fetch_and_32 (&stripes[i].state, ~OSC_SM_ACC_LOCK_WRITER);
+        }
+    }
+}
+
+/* count an atomic update in every stripe of mask. a caller finding one of
+ * them locked backs off from all of them, otherwise it could hold up the
+ * lock holder waiting for the stripes it already counted itself in. */
+static inline void ompi_osc_sm_acc_atomic_start (ompi_osc_sm_module_t *module, int target,
+                                                 uint32_t mask)
+{
+    ompi_osc_sm_acc_lock_t *stripes = module->node_states[target].accumulate_locks;
+    int locked;
+
+    do {
+        locked = -1;
+        for (int i = 0 ; i < OSC_SM_ACC_LOCK_COUNT ; ++i) {
+            if ((mask & (1u << i)) &&
+                (opal_atomic_fetch_add_32 (&stripes[i].state, 1) & OSC_SM_ACC_LOCK_WRITER)) {
+                locked = i;
+                break;
+            }
+        }
+
+        if (locked >= 0) {
+            for (int i = 0 ; i <= locked ; ++i) {
+                if (mask & (1u << i)) {
+                    (void) opal_atomic_fetch_add_32 (&stripes[i].state, -1);
+                }
+            }
+            while (stripes[locked].state & OSC_SM_ACC_LOCK_WRITER) {
+                opal_atomic_rmb ();
+            }
+        }
+    } while (locked >= 0);
+
+    opal_atomic_mb ();
+}
+
+static inline void ompi_osc_sm_acc_atomic_end (ompi_osc_sm_module_t *module, int target,
+                                               uint32_t mask)
+{
+    ompi_osc_sm_acc_lock_t *stripes = module->node_states[target].accumulate_locks;
+
+    opal_atomic_wmb ();
+    for (int i = 0 ; i < OSC_SM_ACC_LOCK_COUNT ; ++i) {
+        if (mask & (1u << i)) {
+            (void) opal_atomic_fetch_add_32 (&stripes[i].state, -1);
+        }
+    }
+}
+
+static inline void ompi_osc_sm_atomic_op_32 (int cls, ompi_op_t *op, ompi_datatype_t *dt,
+                                             opal_atomic_int32_t *addr, const void *origin,
+                                             void *result)
+{
+    int32_t value = 0, oldval, newval;
+
+    if (&ompi_mpi_op_no_op.op != op) {
+        memcpy (&value, origin, sizeof (value));
+    }
+
+    if (&ompi_mpi_op_no_op.op == op) {
+        oldval = *addr;
+    } else if (&ompi_mpi_op_replace.op == op) {
+        oldval = opal_atomic_swap_32 (addr, value);
+    } else if (OSC_SM_ATOMIC_FLOAT != cls && &ompi_mpi_op_sum.op == op) {
+        oldval = opal_atomic_fetch_add_32 (addr, value);
+    } else if (OSC_SM_ATOMIC_FLOAT != cls && &ompi_mpi_op_band.op == op) {
+        oldval = opal_atomic_fetch_and_32 (addr, value);
+    } else if (OSC_SM_ATOMIC_FLOAT != cls && &ompi_mpi_op_bor.op == op) {
+        oldval = opal_atomic_fetch_or_32 (addr, value);
+    } else if (OSC_SM_ATOMIC_FLOAT != cls && &ompi_mpi_op_bxor.op == op) {
+        oldval = opal_atomic_fetch_xor_32 (addr, value);
+    } else if (OSC_SM_ATOMIC_INT == cls && &ompi_mpi_op_min.op == op) {
+        oldval = opal_atomic_fetch_min_32 (addr, value);
+    } else if (OSC_SM_ATOMIC_INT == cls && &ompi_mpi_op_max.op == op) {
+        oldval = opal_atomic_fetch_max_32 (addr, value);
+    } else {
+        /* everything else goes through a compare-and-swap loop */
+        oldval = *addr;
+        do {
+            newval = oldval;
+            ompi_op_reduce (op, (void *) origin, &newval, 1, dt);
+        } while (!opal_atomic_compare_exchange_strong_32 (addr, &oldval, newval));
+    }
+
+    if (NULL != result) {
+        memcpy (result, &oldval, sizeof (oldval));
+    }
+}
+
+#if OPAL_HAVE_ATOMIC_COMPARE_EXCHANGE_64
+static inline void ompi_osc_sm_atomic_op_64 (int cls, ompi_op_t *op, ompi_datatype_t *dt,
+                                             opal_atomic_int64_t *addr, const void *origin,
+                                             void *result)
+{
+    int64_t value = 0, oldval, newval;
+
+    if (&ompi_mpi_op_no_op.op != op) {
+        memcpy (&value, origin, sizeof (value));
+    }
+
+    if (&ompi_mpi_op_no_op.op == op) {
+        oldval = *addr;
+    } else if (&ompi_mpi_op_replace.op == op) {
+        oldval = opal_atomic_swap_64 (addr, value);
+    } else if (OSC_SM_ATOMIC_FLOAT != cls && &ompi_mpi_op_sum.op == op) {
+        oldval = opal_atomic_fetch_add_64 (addr, value);
+    } else if (OSC_SM_ATOMIC_FLOAT != cls && &ompi_mpi_op_band.op == op) {
+        oldval = opal_atomic_fetch_and_64 (addr, value);
+    } else if (OSC_SM_ATOMIC_FLOAT != cls && &ompi_mpi_op_bor.op == op) {
+        oldval = opal_atomic_fetch_or_64 (addr, value);
+    } else if (OSC_SM_ATOMIC_FLOAT != cls && &ompi_mpi_op_bxor.op == op) {
+        oldval = opal_atomic_fetch_xor_64 (addr, value);
+    } else if (OSC_SM_ATOMIC_INT == cls && &ompi_mpi_op_min.op == op) {
+        oldval = opal_atomic_fetch_min_64 (addr, value);
+    } else if (OSC_SM_ATOMIC_INT == cls && &ompi_mpi_op_max.op == op) {
+        oldval = opal_atomic_fetch_max_64 (addr, value);
+    } else {
+        oldval = *addr;
+        do {
+            newval = oldval;
+            ompi_op_reduce (op, (void *) origin, &newval, 1, dt);
+        } while (!opal_atomic_compare_exchange_strong_64 (addr, &oldval, newval));
+    }
+
+    if (NULL != result) {
+        memcpy (result, &oldval, sizeof (oldval));
+    }
+}
+#endif
+
+/* apply op to count contiguous elements of dt at addr. origin and result
+ * point to contiguous arrays of dt and are advanced past the elements. */
+static void ompi_osc_sm_atomic_range (ompi_osc_sm_module_t *module, int target, int cls,
+                                      ompi_op_t *op, ompi_datatype_t *dt, char *addr,
+                                      size_t count, const char **origin, char **result)
+{
+    size_t size = dt->super.size;
+
+    for (size_t i = 0 ; i < count ; ++i, addr += size) {
+        if (OPAL_UNLIKELY(!ompi_osc_base_is_atomic_size_supported ((uint64_t) (uintptr_t) addr, size))) {
+            /* misaligned elements are never accessed with atomics. the stripes
+             * can not be locked here as this call is counted in them. */
+            opal_atomic_lock (&module->node_states[target].misaligned_lock);
+            if (NULL != *result) {
+                memcpy (*result, addr, size);
+            }
+            if (&ompi_mpi_op_replace.op == op) {
+                memcpy (addr, *origin, size);
+            } else if (&ompi_mpi_op_no_op.op != op) {
+                ompi_op_reduce (op, (void *) *origin, addr, 1, dt);
+            }
+            opal_atomic_unlock (&module->node_states[target].misaligned_lock);
+        } else if (4 == size) {
+            ompi_osc_sm_atomic_op_32 (cls, op, dt, (opal_atomic_int32_t *) addr, *origin, *result);
+#if OPAL_HAVE_ATOMIC_COMPARE_EXCHANGE_64
+        } else {
+            ompi_osc_sm_atomic_op_64 (cls, op, dt, (opal_atomic_int64_t *) addr, *origin, *result);
+#endif
+        }
+
+        if (NULL != *origin) {
+            *origin += size;
+        }
+        if (NULL != *result) {
+            *result += size;
+        }
+    }
+}
+
+/* returns OMPI_ERR_NOT_SUPPORTED, without touching the target, if the
+ * operation can not be done with processor atomics */
+static int ompi_osc_sm_atomic_accumulate (ompi_osc_sm_module_t *module,
+                                          const void *origin_addr, int origin_count,
+                                          ompi_datatype_t *origin_dt,
+                                          void *result_addr, int result_count,
+                                          ompi_datatype_t *result_dt, int target,
+                                          void *remote_address, int target_count,
+                                          ompi_datatype_t *target_dt, ompi_op_t *op)
+{
+    ompi_datatype_t *prim;
+    char *origin_buf = NULL, *result_buf = NULL;
+    const char *origin;
+    char *result;
+    size_t count, size;
+    uint32_t mask;
+    int cls, ret = OMPI_SUCCESS;
+
+    if (!ompi_op_is_intrinsic (op) && &ompi_mpi_op_replace.op != op &&
+        &ompi_mpi_op_no_op.op != op) {
+        return OMPI_ERR_NOT_SUPPORTED;
+    }
+
+    prim = ompi_datatype_get_single_predefined_type_from_args (target_dt);
+    if (NULL == prim || OSC_SM_ATOMIC_NONE == (cls = ompi_osc_sm_atomic_class (prim))) {
+        return OMPI_ERR_NOT_SUPPORTED;
+    }
+
+    ompi_datatype_type_size (target_dt, &size);
+    if (size * (size_t) target_count > mca_osc_sm_component.acc_atomic_max_size) {
+        /* one reduction under the lock is faster than this many atomics */
+        return OMPI_ERR_NOT_SUPPORTED;
+    }
+
+    count = (size / prim->super.size) * (size_t) target_count;
+    if (0 == count) {
+        return OMPI_SUCCESS;
+    }
+
+    /* bring the origin and result buffers into contiguous arrays of the primitive */
+    origin = NULL;
+    if (&ompi_mpi_op_no_op.op != op) {
+        if (ompi_datatype_get_single_predefined_type_from_args (origin_dt) != prim) {
+            return OMPI_ERR_NOT_SUPPORTED;
+        }
+        if (origin_dt == prim) {
+            origin = origin_addr;
+        } else {
+            origin_buf = malloc (count * prim->super.size);
+            if (OPAL_UNLIKELY(NULL == origin_buf)) {
+                return OMPI_ERR_OUT_OF_RESOURCE;
+            }
+            ret = ompi_datatype_sndrcv ((void *) origin_addr, origin_count, origin_dt,
+                                        origin_buf, count, prim);
+            if (OMPI_SUCCESS != ret) {
+                goto done;
+            }
+            origin = origin_buf;
+        }
+    }
+
+    result = NULL;
+    if (NULL != result_dt) {
+        if (result_dt == prim) {
+            result = result_addr;
+        } else {
+            result_buf = malloc (count * prim->super.size);
+            if (OPAL_UNLIKELY(NULL == result_buf)) {
+                ret = OMPI_ERR_OUT_OF_RESOURCE;
+                goto done;
+            }
+            result = result_buf;
+        }
+    }
+
+    mask = ompi_osc_sm_acc_lock_mask_dt (module, target, remote_address, target_count, target_dt);
+    ompi_osc_sm_acc_atomic_start (module, target, mask);
+
+    if (target_dt == prim) {
+        ompi_osc_sm_atomic_range (module, target, cls, op, prim, remote_address, count,
+                                  &origin, &result);
+    } else {
+        opal_convertor_t convertor;
+        struct iovec iov[OSC_SM_DECODE_MAX];
+        uint32_t iov_count;
+        size_t iov_size;
+        bool complete;
+
+        OBJ_CONSTRUCT(&convertor, opal_convertor_t);
+        opal_convertor_copy_and_prepare_for_recv (ompi_mpi_local_convertor, &target_dt->super,
+                                                  target_count, remote_address, 0, &convertor);
+        do {
+            iov_count = OSC_SM_DECODE_MAX;
+            complete = opal_convertor_raw (&convertor, iov, &iov_count, &iov_size);
+
+            for (uint32_t i = 0 ; i < iov_count ; ++i) {
+                ompi_osc_sm_atomic_range (module, target, cls, op, prim, iov[i].iov_base,
+                                          iov[i].iov_len / prim->super.size, &origin, &result);
+            }
+        } while (!complete);
+
+        opal_convertor_cleanup (&convertor);
+        OBJ_DESTRUCT(&convertor);
+    }
+
+    ompi_osc_sm_acc_atomic_end (module, target, mask);
+
+    if (NULL != result_buf) {
+        ret = ompi_datatype_sndrcv (result_buf, count, prim, result_addr, result_count, result_dt);
+    }
+
+ done:
+    free (origin_buf);
+    free (result_buf);
+
+    return ret;
+}
+
+/* common code for (get_)accumulate. result_dt is NULL for accumulate. */
+static int ompi_osc_sm_accumulate_common (ompi_osc_sm_module_t *module,
+                                          const void *origin_addr, int origin_count,
+                                          ompi_datatype_t *origin_dt,
+                                          void *result_addr, int result_count,
+                                          ompi_datatype_t *result_dt, int target,
+                                          void *remote_address, int target_count,
+                                          ompi_datatype_t *target_dt, ompi_op_t *op)
+{
+    uint32_t mask;
+    int ret;
+
+    ret = ompi_osc_sm_atomic_accumulate (module, origin_addr, origin_count, origin_dt,
+                                         result_addr, result_count, result_dt, target,
+                                         remote_address, target_count, target_dt, op);
+    if (OMPI_ERR_NOT_SUPPORTED != ret) {
+        return ret;
+    }
+
+    mask = ompi_osc_sm_acc_lock_mask_dt (module, target, remote_address, target_count, target_dt);
+    ompi_osc_sm_acc_lock (module, target, mask);
+
+    if (NULL != result_dt) {
+        ret = ompi_datatype_sndrcv(remote_address, target_count, target_dt,
+                                   result_addr, result_count, result_dt);
+        if (OMPI_SUCCESS != ret || op == &ompi_mpi_op_no_op.op) goto done;
+    }
+
+    if (op == &ompi_mpi_op_replace.op) {
+        ret = ompi_datatype_sndrcv((void *)origin_addr, origin_count, origin_dt,
+                                   remote_address, target_count, target_dt);
+    } else {
+        ret = ompi_osc_base_sndrcv_op(origin_addr, origin_count, origin_dt,
+                                      remote_address, target_count, target_dt,
+                                      op);
+    }
+
+ done:
+    ompi_osc_sm_acc_unlock (module, target, mask);
+
+    return ret;
+}
+
 int
 ompi_osc_sm_rput(const void *origin_addr,
                  int origin_count,
@@ -127,16 +590,9 @@ ompi_osc_sm_raccumulate(const void *origin_addr,
 
     remote_address = ((char*) (module->bases[target])) + module->disp_units[target] * target_disp;
 
-    opal_atomic_lock(&module->node_states[target].accumulate_lock);
-    if (op == &ompi_mpi_op_replace.op) {
-        ret = ompi_datatype_sndrcv((void *)origin_addr, origin_count, origin_dt,
-                                    remote_address, target_count, target_dt);
-    } else {
-        ret = ompi_osc_base_sndrcv_op(origin_addr, origin_count, origin_dt,
-                                      remote_address, target_count, target_dt,
-                                      op);
-    }
-    opal_atomic_unlock(&module->node_states[target].accumulate_lock);
+    ret = ompi_osc_sm_accumulate_common(module, origin_addr, origin_count, origin_dt,
+                                        NULL, 0, NULL, target, remote_address,
+                                        target_count, target_dt, op);
 
     /* the only valid field of RMA request status is the MPI_ERROR field.
      * ompi_request_empty has status MPI_SUCCESS and indicates the request is
@@ -178,23 +634,9 @@ ompi_osc_sm_rget_accumulate(const void *origin_addr,
 
     remote_address = ((char*) (module->bases[target])) + module->disp_units[target] * target_disp;
 
-    opal_atomic_lock(&module->node_states[target].accumulate_lock);
-
-    ret = ompi_datatype_sndrcv(remote_address, target_count, target_dt,
-                               result_addr, result_count, result_dt);
-    if (OMPI_SUCCESS != ret || op == &ompi_mpi_op_no_op.op) goto done;
-
-    if (op == &ompi_mpi_op_replace.op) {
-        ret = ompi_datatype_sndrcv((void *)origin_addr, origin_count, origin_dt,
-                                   remote_address, target_count, target_dt);
-    } else {
-        ret = ompi_osc_base_sndrcv_op(origin_addr, origin_count, origin_dt,
-                                      remote_address, target_count, target_dt,
-                                      op);
-    }
-
- done:
-    opal_atomic_unlock(&module->node_states[target].accumulate_lock);
+    ret = ompi_osc_sm_accumulate_common(module, origin_addr, origin_count, origin_dt,
+                                        result_addr, result_count, result_dt, target,
+                                        remote_address, target_count, target_dt, op);
 
     /* the only valid field of RMA request status is the MPI_ERROR field.
      * ompi_request_empty has status MPI_SUCCESS and indicates the request is
@@ -293,16 +735,9 @@ ompi_osc_sm_accumulate(const void *origin_addr,
 
     remote_address = ((char*) (module->bases[target])) + module->disp_units[target] * target_disp;
 
-    opal_atomic_lock(&module->node_states[target].accumulate_lock);
-    if (op == &ompi_mpi_op_replace.op) {
-        ret = ompi_datatype_sndrcv((void *)origin_addr, origin_count, origin_dt,
-                                    remote_address, target_count, target_dt);
-    } else {
-        ret = ompi_osc_base_sndrcv_op(origin_addr, origin_count, origin_dt,
-                                      remote_address, target_count, target_dt,
-                                      op);
-    }
-    opal_atomic_unlock(&module->node_states[target].accumulate_lock);
+    ret = ompi_osc_sm_accumulate_common(module, origin_addr, origin_count, origin_dt,
+                                        NULL, 0, NULL, target, remote_address,
+                                        target_count, target_dt, op);
 
     return ret;
 }
@@ -337,23 +772,9 @@ ompi_osc_sm_get_accumulate(const void *origin_addr,
 
     remote_address = ((char*) (module->bases[target])) + module->disp_units[target] * target_disp;
 
-    opal_atomic_lock(&module->node_states[target].accumulate_lock);
-
-    ret = ompi_datatype_sndrcv(remote_address, target_count, target_dt,
-                               result_addr, result_count, result_dt);
-    if (OMPI_SUCCESS != ret || op == &ompi_mpi_op_no_op.op) goto done;
-
-    if (op == &ompi_mpi_op_replace.op) {
-        ret = ompi_datatype_sndrcv((void *)origin_addr, origin_count, origin_dt,
-                                   remote_address, target_count, target_dt);
-    } else {
-        ret = ompi_osc_base_sndrcv_op(origin_addr, origin_count, origin_dt,
-                                      remote_address, target_count, target_dt,
-                                      op);
-    }
-
- done:
-    opal_atomic_unlock(&module->node_states[target].accumulate_lock);
+    ret = ompi_osc_sm_accumulate_common(module, origin_addr, origin_count, origin_dt,
+                                        result_addr, result_count, result_dt, target,
+                                        remote_address, target_count, target_dt, op);
 
     return ret;
 }
@@ -371,6 +792,7 @@ ompi_osc_sm_compare_and_swap(const void *origin_addr,
     ompi_osc_sm_module_t *module =
         (ompi_osc_sm_module_t*) win->w_osc_module;
     void *remote_address;
+    uint32_t mask;
     size_t size;
 
     OPAL_OUTPUT_VERBOSE((50, ompi_osc_base_framework.framework_output,
@@ -383,7 +805,36 @@ ompi_osc_sm_compare_and_swap(const void *origin_addr,
 
     ompi_datatype_type_size(dt, &size);
 
-    opal_atomic_lock(&module->node_states[target].accumulate_lock);
+    mask = ompi_osc_sm_acc_lock_mask(module, target, remote_address, size);
+
+    if (OSC_SM_ATOMIC_NONE != ompi_osc_sm_atomic_class(dt) &&
+        ompi_osc_base_is_atomic_size_supported((uint64_t) (uintptr_t) remote_address, size)) {
+        ompi_osc_sm_acc_atomic_start(module, target, mask);
+        if (4 == size) {
+            int32_t compare, value;
+
+            memcpy(&compare, compare_addr, sizeof(compare));
+            memcpy(&value, origin_addr, sizeof(value));
+            (void) opal_atomic_compare_exchange_strong_32((opal_atomic_int32_t *) remote_address,
+                                                          &compare, value);
+            memcpy(result_addr, &compare, sizeof(compare));
+#if OPAL_HAVE_ATOMIC_COMPARE_EXCHANGE_64
+        } else {
+            int64_t compare, value;
+
+            memcpy(&compare, compare_addr, sizeof(compare));
+            memcpy(&value, origin_addr, sizeof(value));
+            (void) opal_atomic_compare_exchange_strong_64((opal_atomic_int64_t *) remote_address,
+                                                          &compare, value);
+            memcpy(result_addr, &compare, sizeof(compare));
+#endif
+        }
+        ompi_osc_sm_acc_atomic_end(module, target, mask);
+
+        return OMPI_SUCCESS;
+    }
+
+    ompi_osc_sm_acc_lock(module, target, mask);
 
     /* fetch */
     ompi_datatype_copy_content_same_ddt(dt, 1, (char*) result_addr, (char*) remote_address);
@@ -393,7 +844,7 @@ ompi_osc_sm_compare_and_swap(const void *origin_addr,
         ompi_datatype_copy_content_same_ddt(dt, 1, (char*) remote_address, (char*) origin_addr);
     }
 
-    opal_atomic_unlock(&module->node_states[target].accumulate_lock);
+    ompi_osc_sm_acc_unlock(module, target, mask);
 
     return OMPI_SUCCESS;
 }
@@ -421,21 +872,6 @@ ompi_osc_sm_fetch_and_op(const void *origin_addr,
 
     remote_address = ((char*) (module->bases[target])) + module->disp_units[target] * target_disp;
 
-    opal_atomic_lock(&module->node_states[target].accumulate_lock);
-
-    /* fetch */
-    ompi_datatype_copy_content_same_ddt(dt, 1, (char*) result_addr, (char*) remote_address);
-    if (op == &ompi_mpi_op_no_op.op) goto done;
-
-    /* op */
-    if (op == &ompi_mpi_op_replace.op) {
-        ompi_datatype_copy_content_same_ddt(dt, 1, (char*) remote_address, (char*) origin_addr);
-    } else {
-        ompi_op_reduce(op, (void *)origin_addr, remote_address, 1, dt);
-    }
-
- done:
-    opal_atomic_unlock(&module->node_states[target].accumulate_lock);
-
-    return OMPI_SUCCESS;;
+    return ompi_osc_sm_accumulate_common(module, origin_addr, 1, dt, result_addr, 1, dt,
+                                         target, remote_address, 1, dt, op);
 }
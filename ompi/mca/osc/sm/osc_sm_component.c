@@ -125,6 +125,14 @@ static int component_register (void)
                                             MCA_BASE_VAR_TYPE_STRING, NULL, 0, 0, OPAL_INFO_LVL_3,
                                             MCA_BASE_VAR_SCOPE_READONLY, &mca_osc_sm_component.backing_directory);
 
+    mca_osc_sm_component.acc_atomic_max_size = 1024;
+    (void) mca_base_component_var_register (&mca_osc_sm_component.super.osc_version, "acc_atomic_max_size",
+                                            "Largest accumulate (in bytes) to update the target with processor "
+                                            "atomics, one element at a time. Larger accumulates lock the target "
+                                            "range and reduce it in one call (default: 1024)",
+                                            MCA_BASE_VAR_TYPE_SIZE_T, NULL, 0, 0, OPAL_INFO_LVL_5,
+                                            MCA_BASE_VAR_SCOPE_READONLY, &mca_osc_sm_component.acc_atomic_max_size);
+
     return OPAL_SUCCESS;
 }
 
@@ -363,7 +371,7 @@ component_select(struct ompi_win_t *win, void **base, size_t size, int disp_unit
 
     *base = module->bases[ompi_comm_rank(module->comm)];
 
-    opal_atomic_lock_init(&module->my_node_state->accumulate_lock, OPAL_ATOMIC_LOCK_UNLOCKED);
+    opal_atomic_lock_init(&module->my_node_state->misaligned_lock, OPAL_ATOMIC_LOCK_UNLOCKED);
 
     /* share everyone's displacement units. */
     module->disp_units = malloc(sizeof(int) * comm_size);
@@ -0,0 +1,40 @@
+/* -*- Mode: C; c-basic-offset:4 ; indent-tabs-mode:nil -*- */
+/*
+ * $COPYRIGHT$
+ *
+ * Additional copyrights may follow
+ *
+ * $HEADER$
+ */
+
+#ifndef MCA_PART_BASE_H
+#define MCA_PART_BASE_H
+
+#include "ompi_config.h"
+
+#include "ompi/mca/mca.h"
+#include "opal/mca/base/mca_base_framework.h"
+#include "ompi/mca/part/part.h"
+
+/*
+ * Global functions for the PART
+ */
+
+BEGIN_C_DECLS
+
+/**
+ * Select the part component to use. When no component is available
+ * the MPI partitioned functions return MPI_ERR_UNSUPPORTED_OPERATION.
+ */
+OMPI_DECLSPEC int mca_part_base_select(bool enable_progress_threads,
+                                       bool enable_mpi_threads);
+
+/*
+ * Globals
+ */
+OMPI_DECLSPEC extern mca_part_base_component_t mca_part_base_selected_component;
+OMPI_DECLSPEC extern mca_base_framework_t ompi_part_base_framework;
+
+END_C_DECLS
+
+#endif /* MCA_PART_BASE_H */
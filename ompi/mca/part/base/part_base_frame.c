@@ -0,0 +1,34 @@
+/* -*- Mode: C; c-basic-offset:4 ; indent-tabs-mode:nil -*- */
+/*
+ * $COPYRIGHT$
+ *
+ * Additional copyrights may follow
+ *
+ * $HEADER$
+ */
+
+#include "ompi_config.h"
+
+#include "opal/mca/base/base.h"
+
+#include "ompi/mca/part/part.h"
+#include "ompi/mca/part/base/base.h"
+
+/*
+ * The following file was created by configure.  It contains extern
+ * statements and the definition of an array of pointers to each
+ * component's public mca_base_component_t struct.
+ */
+#include "ompi/mca/part/base/static-components.h"
+
+mca_part_base_module_t mca_part = {
+    NULL,                    /* part_psend_init */
+    NULL,                    /* part_precv_init */
+    NULL,                    /* part_pready */
+    NULL                     /* part_parrived */
+};
+
+mca_part_base_component_t mca_part_base_selected_component = {{0}};
+
+MCA_BASE_FRAMEWORK_DECLARE(ompi, part, "Partitioned point-to-point communication",
+                           NULL, NULL, NULL, mca_part_base_static_components, 0);
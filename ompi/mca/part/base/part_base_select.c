@@ -0,0 +1,71 @@
+/* -*- Mode: C; c-basic-offset:4 ; indent-tabs-mode:nil -*- */
+/*
+ * $COPYRIGHT$
+ *
+ * Additional copyrights may follow
+ *
+ * $HEADER$
+ */
+
+#include "ompi_config.h"
+
+#include "opal/mca/base/base.h"
+#include "opal/util/output.h"
+
+#include "ompi/constants.h"
+#include "ompi/mca/part/part.h"
+#include "ompi/mca/part/base/base.h"
+
+int mca_part_base_select(bool enable_progress_threads,
+                         bool enable_mpi_threads)
+{
+    mca_part_base_component_t *component, *best_component = NULL;
+    mca_part_base_module_t *module, *best_module = NULL;
+    int priority = 0, best_priority = -1;
+    mca_base_component_list_item_t *cli;
+
+    OPAL_LIST_FOREACH(cli, &ompi_part_base_framework.framework_components, mca_base_component_list_item_t) {
+        component = (mca_part_base_component_t *) cli->cli_component;
+        if (NULL == component->partm_init) {
+            opal_output_verbose(10, ompi_part_base_framework.framework_output,
+                                "select: no init function; ignoring component %s",
+                                component->partm_version.mca_component_name);
+            continue;
+        }
+
+        module = component->partm_init(&priority, enable_progress_threads,
+                                       enable_mpi_threads);
+        if (NULL == module) {
+            opal_output_verbose(10, ompi_part_base_framework.framework_output,
+                                "select: init returned failure for component %s",
+                                component->partm_version.mca_component_name);
+            continue;
+        }
+
+        opal_output_verbose(10, ompi_part_base_framework.framework_output,
+                            "select: init returned priority %d for component %s",
+                            priority, component->partm_version.mca_component_name);
+        if (priority > best_priority) {
+            best_priority = priority;
+            best_component = component;
+            best_module = module;
+        }
+    }
+
+    if (NULL == best_module) {
+        /* partitioned communication is optional */
+        opal_output_verbose(10, ompi_part_base_framework.framework_output,
+                            "select: no component selected");
+        return mca_base_framework_components_close(&ompi_part_base_framework, NULL);
+    }
+
+    opal_output_verbose(10, ompi_part_base_framework.framework_output,
+                        "select: component %s selected",
+                        best_component->partm_version.mca_component_name);
+
+    mca_part_base_selected_component = *best_component;
+    mca_part = *best_module;
+
+    return mca_base_framework_components_close(&ompi_part_base_framework,
+                                               (mca_base_component_t *) best_component);
+}
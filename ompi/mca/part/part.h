@@ -0,0 +1,174 @@
+/* -*- Mode: C; c-basic-offset:4 ; indent-tabs-mode:nil -*- */
+/*
+ * $COPYRIGHT$
+ *
+ * Additional copyrights may follow
+ *
+ * $HEADER$
+ */
+/**
+ * @file
+ *
+ * Partitioned point-to-point communication (PART)
+ *
+ * An MCA component type that provides the MPI-4 partitioned
+ * communication interface (MPI_Psend_init, MPI_Precv_init, MPI_Pready*
+ * and MPI_Parrived) to the MPI layer. A single component is selected
+ * at MPI_Init time.
+ *
+ * The requests returned by psend_init and precv_init are persistent
+ * requests of type OMPI_REQUEST_PART. They are started with
+ * MPI_Start/MPI_Startall and completed with the usual MPI_Wait/MPI_Test
+ * family, so the component provides the req_start and req_free
+ * functions of its requests.
+ */
+
+#ifndef MCA_PART_H
+#define MCA_PART_H
+
+#include "ompi_config.h"
+#include "ompi/mca/mca.h"
+#include "ompi/request/request.h"
+
+BEGIN_C_DECLS
+
+struct ompi_communicator_t;
+struct ompi_datatype_t;
+struct opal_info_t;
+
+/**
+ * Initialization function for the PART component.
+ *
+ * @param priority (OUT)                Relative priority or ranking used by MCA to
+ *                                      select a component.
+ * @param enable_progress_threads (IN)  Whether this component is allowed to run a
+ *                                      hidden/progress thread or not.
+ * @param enable_mpi_threads (IN)       Whether support for multiple MPI threads is
+ *                                      enabled or not.
+ * @return                              The module to use or NULL if the component
+ *                                      cannot run.
+ */
+typedef struct mca_part_base_module_1_0_0_t * (*mca_part_base_component_init_fn_t)(
+    int *priority,
+    bool enable_progress_threads,
+    bool enable_mpi_threads);
+
+/**
+ * PART component version and interface functions.
+ */
+struct mca_part_base_component_1_0_0_t {
+    mca_base_component_t partm_version;
+    mca_base_component_data_t partm_data;
+    mca_part_base_component_init_fn_t partm_init;
+};
+typedef struct mca_part_base_component_1_0_0_t mca_part_base_component_1_0_0_t;
+typedef mca_part_base_component_1_0_0_t mca_part_base_component_t;
+
+/**
+ * Initialize a partitioned send request.
+ *
+ * The send buffer is made of \c partitions consecutive partitions of
+ * \c count elements of \c datatype each.
+ *
+ * @param buf (IN)         User buffer.
+ * @param partitions (IN)  Number of partitions.
+ * @param count (IN)       Number of elements in each partition.
+ * @param datatype (IN)    User defined datatype.
+ * @param dst (IN)         Peer rank w/in communicator.
+ * @param tag (IN)         User defined tag.
+ * @param comm (IN)        Communicator.
+ * @param info (IN)        Info hints.
+ * @param request (OUT)    Request handle.
+ * @return                 OMPI_SUCCESS or failure status.
+ */
+typedef int (*mca_part_base_module_psend_init_fn_t)(
+    const void *buf,
+    size_t partitions,
+    size_t count,
+    struct ompi_datatype_t *datatype,
+    int dst,
+    int tag,
+    struct ompi_communicator_t *comm,
+    struct opal_info_t *info,
+    struct ompi_request_t **request);
+
+/**
+ * Initialize a partitioned receive request.
+ *
+ * @param buf (IN)         User buffer.
+ * @param partitions (IN)  Number of partitions.
+ * @param count (IN)       Number of elements in each partition.
+ * @param datatype (IN)    User defined datatype.
+ * @param src (IN)         Source rank w/in communicator.
+ * @param tag (IN)         User defined tag.
+ * @param comm (IN)        Communicator.
+ * @param info (IN)        Info hints.
+ * @param request (OUT)    Request handle.
+ * @return                 OMPI_SUCCESS or failure status.
+ */
+typedef int (*mca_part_base_module_precv_init_fn_t)(
+    void *buf,
+    size_t partitions,
+    size_t count,
+    struct ompi_datatype_t *datatype,
+    int src,
+    int tag,
+    struct ompi_communicator_t *comm,
+    struct opal_info_t *info,
+    struct ompi_request_t **request);
+
+/**
+ * Mark the partitions [low, high] of an active send request ready
+ * to be transferred.
+ *
+ * @param low (IN)         First partition.
+ * @param high (IN)        Last partition (inclusive).
+ * @param request (IN)     Partitioned send request.
+ * @return                 OMPI_SUCCESS or failure status.
+ */
+typedef int (*mca_part_base_module_pready_fn_t)(
+    size_t low,
+    size_t high,
+    struct ompi_request_t *request);
+
+/**
+ * Check if a partition of an active receive request has arrived.
+ *
+ * @param partition (IN)   Partition.
+ * @param flag (OUT)       True if the partition has arrived.
+ * @param request (IN)     Partitioned receive request.
+ * @return                 OMPI_SUCCESS or failure status.
+ */
+typedef int (*mca_part_base_module_parrived_fn_t)(
+    size_t partition,
+    int *flag,
+    struct ompi_request_t *request);
+
+/**
+ * PART module interface functions.
+ */
+struct mca_part_base_module_1_0_0_t {
+    mca_part_base_module_psend_init_fn_t  part_psend_init;
+    mca_part_base_module_precv_init_fn_t  part_precv_init;
+    mca_part_base_module_pready_fn_t      part_pready;
+    mca_part_base_module_parrived_fn_t    part_parrived;
+};
+typedef struct mca_part_base_module_1_0_0_t mca_part_base_module_1_0_0_t;
+typedef mca_part_base_module_1_0_0_t mca_part_base_module_t;
+
+/*
+ * Macro for use in components that are of type part
+ */
+#define MCA_PART_BASE_VERSION_1_0_0 \
+    OMPI_MCA_BASE_VERSION_2_1_0("part", 1, 0, 0)
+
+/*
+ * Macro for calling into the selected part module
+ */
+#define MCA_PART_CALL(a) mca_part.part_ ## a
+
+OMPI_DECLSPEC extern mca_part_base_module_t mca_part;
+
+END_C_DECLS
+
+#endif /* MCA_PART_H */
@@ -0,0 +1,16 @@
+# -*- shell-script -*-
+#
+# $COPYRIGHT$
+#
+# Additional copyrights may follow
+#
+# $HEADER$
+#
+
+# MCA_ompi_part_persist_CONFIG([action-if-can-compile],
+#                              [action-if-cant-compile])
+# ------------------------------------------------
+AC_DEFUN([MCA_ompi_part_persist_CONFIG],[
+    AC_CONFIG_FILES([ompi/mca/part/persist/Makefile])
+    [$1]
+])dnl
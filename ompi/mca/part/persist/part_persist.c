@@ -0,0 +1,526 @@
+/* -*- Mode: C; c-basic-offset:4 ; indent-tabs-mode:nil -*- */
+/*
+ * $COPYRIGHT$
+ *
+ * Additional copyrights may follow
+ *
+ * $HEADER$
+ */
+
+#include "ompi_config.h"
+
+#include <stdlib.h>
+
+#include "opal/runtime/opal_progress.h"
+#include "opal/sys/atomic.h"
+
+#include "ompi/communicator/communicator.h"
+#include "ompi/constants.h"
+#include "ompi/datatype/ompi_datatype.h"
+#include "ompi/mca/pml/pml.h"
+#include "ompi/mca/part/persist/part_persist.h"
+
+mca_part_base_module_t mca_part_persist_module = {
+    .part_psend_init = mca_part_persist_psend_init,
+    .part_precv_init = mca_part_persist_precv_init,
+    .part_pready = mca_part_persist_pready,
+    .part_parrived = mca_part_persist_parrived,
+};
+
+static void mca_part_persist_request_construct(mca_part_persist_request_t *req)
+{
+    req->req_parts = NULL;
+    req->req_num_parts = 0;
+    req->req_setup_req = NULL;
+    req->req_setup_done = false;
+    req->req_start_pending = false;
+    req->req_on_pending_list = false;
+    req->req_tags_allocated = false;
+    req->req_error = OMPI_SUCCESS;
+}
+
+OBJ_CLASS_INSTANCE(mca_part_persist_request_t, ompi_request_t,
+                   mca_part_persist_request_construct, NULL);
+
+/*
+ * Called when one of the PML requests of a partitioned request
+ * completes.
+ */
+static int mca_part_persist_part_complete(ompi_request_t *part)
+{
+    mca_part_persist_request_t *req = (mca_part_persist_request_t *) part->req_complete_cb_data;
+
+    if (OPAL_UNLIKELY(OMPI_SUCCESS != part->req_status.MPI_ERROR)) {
+        req->req_ompi.req_status.MPI_ERROR = part->req_status.MPI_ERROR;
+    }
+    if (0 == OPAL_THREAD_ADD_FETCH32(&req->req_pending, -1)) {
+        ompi_request_complete(&req->req_ompi, true);
+    }
+    return 0;
+}
+
+static inline int mca_part_persist_start_part(mca_part_persist_request_t *req, size_t index)
+{
+    ompi_request_t *part = req->req_parts[index];
+
+    /* the callback has to be in place before the PML can complete the request */
+    part->req_complete_cb = mca_part_persist_part_complete;
+    part->req_complete_cb_data = req;
+    return MCA_PML_CALL(start(1, req->req_parts + index));
+}
+
+static int mca_part_persist_recv_start_parts(mca_part_persist_request_t *req)
+{
+    int rc;
+
+    req->req_pending = (int32_t) req->req_num_parts;
+    if (OPAL_UNLIKELY(OMPI_SUCCESS != req->req_error || 0 == req->req_num_parts)) {
+        req->req_ompi.req_status.MPI_ERROR = req->req_error;
+        ompi_request_complete(&req->req_ompi, true);
+        return OMPI_SUCCESS;
+    }
+
+    for (size_t i = 0 ; i < req->req_num_parts ; ++i) {
+        rc = mca_part_persist_start_part(req, i);
+        if (OPAL_UNLIKELY(OMPI_SUCCESS != rc)) {
+            return rc;
+        }
+    }
+    return OMPI_SUCCESS;
+}
+
+static int mca_part_persist_start(size_t count, ompi_request_t **requests)
+{
+    int rc = OMPI_SUCCESS;
+
+    for (size_t i = 0 ; i < count ; ++i) {
+        mca_part_persist_request_t *req = (mca_part_persist_request_t *) requests[i];
+
+        if (NULL == req || OMPI_REQUEST_PART != req->req_ompi.req_type) {
+            continue;
+        }
+
+        req->req_ompi.req_state = OMPI_REQUEST_ACTIVE;
+        req->req_ompi.req_complete = REQUEST_PENDING;
+        req->req_ompi.req_status.MPI_ERROR = OMPI_SUCCESS;
+        req->req_ompi.req_status._cancelled = 0;
+
+        if (req->req_is_send) {
+            /* the partitions are started by MPI_Pready */
+            req->req_pending = (int32_t) req->req_num_parts;
+            if (0 == req->req_num_parts) {
+                ompi_request_complete(&req->req_ompi, true);
+            }
+            continue;
+        }
+
+        OPAL_THREAD_LOCK(&mca_part_persist_component.lock);
+        if (!req->req_setup_done) {
+            /* mca_part_persist_progress starts it once the setup arrives */
+            req->req_start_pending = true;
+            OPAL_THREAD_UNLOCK(&mca_part_persist_component.lock);
+            continue;
+        }
+        OPAL_THREAD_UNLOCK(&mca_part_persist_component.lock);
+
+        rc = mca_part_persist_recv_start_parts(req);
+        if (OPAL_UNLIKELY(OMPI_SUCCESS != rc)) {
+            return rc;
+        }
+    }
+
+    return rc;
+}
+
+/*
+ * Hand out a block of consecutive partition tags that no other send
+ * request of this process uses. Returns OMPI_ERR_OUT_OF_RESOURCE if no
+ * block of that size is free.
+ */
+static int mca_part_persist_alloc_tags(size_t partitions, uint32_t *first)
+{
+    mca_part_persist_component_t *component = &mca_part_persist_component;
+    uint32_t start, run = 0;
+    int rc = OMPI_SUCCESS;
+
+    OPAL_THREAD_LOCK(&component->lock);
+
+    if (0 == opal_bitmap_size(&component->tags)) {
+        rc = opal_bitmap_init(&component->tags, (int) MCA_PART_PERSIST_DATA_TAGS);
+        if (OPAL_UNLIKELY(OPAL_SUCCESS != rc)) {
+            OPAL_THREAD_UNLOCK(&component->lock);
+            return rc;
+        }
+    }
+
+    /* first fit, starting after the last block handed out. a block does not
+     * wrap around the end of the range. */
+    start = component->tag_cursor;
+    for (uint32_t i = 0 ; i < MCA_PART_PERSIST_DATA_TAGS && run < partitions ; ++i) {
+        uint32_t tag = (component->tag_cursor + i) % MCA_PART_PERSIST_DATA_TAGS;
+
+        if (0 == tag) {
+            run = 0;
+        }
+        if (opal_bitmap_is_set_bit(&component->tags, (int) tag)) {
+            run = 0;
+            continue;
+        }
+        if (0 == run++) {
+            start = tag;
+        }
+    }
+
+    if (run < partitions) {
+        rc = OMPI_ERR_OUT_OF_RESOURCE;
+    } else {
+        for (uint32_t tag = start ; tag < start + partitions ; ++tag) {
+            (void) opal_bitmap_set_bit(&component->tags, (int) tag);
+        }
+        component->tag_cursor = (uint32_t) ((start + partitions) % MCA_PART_PERSIST_DATA_TAGS);
+        *first = start;
+    }
+
+    OPAL_THREAD_UNLOCK(&component->lock);
+
+    return rc;
+}
+
+static void mca_part_persist_free_tags(uint32_t first, size_t partitions)
+{
+    OPAL_THREAD_LOCK(&mca_part_persist_component.lock);
+    for (uint32_t tag = first ; tag < first + partitions ; ++tag) {
+        (void) opal_bitmap_clear_bit(&mca_part_persist_component.tags, (int) tag);
+    }
+    OPAL_THREAD_UNLOCK(&mca_part_persist_component.lock);
+}
+
+static int mca_part_persist_free(ompi_request_t **request)
+{
+    mca_part_persist_request_t *req = (mca_part_persist_request_t *) *request;
+
+    if (req->req_on_pending_list) {
+        OPAL_THREAD_LOCK(&mca_part_persist_component.lock);
+        if (req->req_on_pending_list) {
+            opal_list_remove_item(&mca_part_persist_component.pending,
+                                  &req->req_ompi.super.super);
+            req->req_on_pending_list = false;
+        }
+        OPAL_THREAD_UNLOCK(&mca_part_persist_component.lock);
+    }
+
+    if (NULL != req->req_setup_req) {
+        if (!req->req_is_send) {
+            /* the matching send request might never have been created */
+            ompi_request_cancel(req->req_setup_req);
+        }
+        ompi_request_wait(&req->req_setup_req, MPI_STATUS_IGNORE);
+        req->req_setup_req = NULL;
+    }
+
+    for (size_t i = 0 ; i < req->req_num_parts ; ++i) {
+        if (NULL != req->req_parts[i]) {
+            ompi_request_free(req->req_parts + i);
+        }
+    }
+    free(req->req_parts);
+
+    if (req->req_tags_allocated) {
+        mca_part_persist_free_tags(req->req_first_tag, req->req_num_parts);
+        req->req_tags_allocated = false;
+    }
+
+    OMPI_DATATYPE_RELEASE(req->req_datatype);
+    OBJ_RELEASE(req->req_comm);
+
+    OMPI_REQUEST_FINI(&req->req_ompi);
+    OBJ_RELEASE(req);
+    *request = MPI_REQUEST_NULL;
+
+    return OMPI_SUCCESS;
+}
+
+static mca_part_persist_request_t *
+mca_part_persist_request_alloc(bool is_send, const void *buf, size_t partitions, size_t count,
+                               struct ompi_datatype_t *datatype, int peer, int tag,
+                               struct ompi_communicator_t *comm)
+{
+    mca_part_persist_request_t *req = OBJ_NEW(mca_part_persist_request_t);
+
+    if (OPAL_UNLIKELY(NULL == req)) {
+        return NULL;
+    }
+
+    OMPI_REQUEST_INIT(&req->req_ompi, true);
+    req->req_ompi.req_type = OMPI_REQUEST_PART;
+    req->req_ompi.req_start = mca_part_persist_start;
+    req->req_ompi.req_free = mca_part_persist_free;
+    req->req_ompi.req_mpi_object.comm = comm;
+    if (!is_send) {
+        req->req_ompi.req_status.MPI_SOURCE = peer;
+        req->req_ompi.req_status.MPI_TAG = tag;
+    }
+
+    req->req_is_send = is_send;
+    req->req_addr = (void *) buf;
+    req->req_partitions = partitions;
+    req->req_count = count;
+    req->req_datatype = datatype;
+    req->req_comm = comm;
+    req->req_peer = peer;
+    req->req_tag = tag;
+
+    OMPI_DATATYPE_RETAIN(datatype);
+    OBJ_RETAIN(comm);
+
+    return req;
+}
+
+int mca_part_persist_psend_init(const void *buf, size_t partitions, size_t count,
+                                struct ompi_datatype_t *datatype, int dst, int tag,
+                                struct ompi_communicator_t *comm, struct opal_info_t *info,
+                                struct ompi_request_t **request)
+{
+    mca_part_persist_request_t *req;
+    ptrdiff_t lb, extent;
+    uint32_t first;
+    size_t size;
+    int rc;
+
+    if (OPAL_UNLIKELY(partitions > MCA_PART_PERSIST_DATA_TAGS)) {
+        return OMPI_ERR_BAD_PARAM;
+    }
+
+    req = mca_part_persist_request_alloc(true, buf, partitions, count, datatype, dst, tag, comm);
+    if (OPAL_UNLIKELY(NULL == req)) {
+        return OMPI_ERR_OUT_OF_RESOURCE;
+    }
+
+    ompi_datatype_type_size(datatype, &size);
+    ompi_datatype_get_extent(datatype, &lb, &extent);
+
+    req->req_parts = (ompi_request_t **) calloc(partitions, sizeof(ompi_request_t *));
+    if (OPAL_UNLIKELY(NULL == req->req_parts && 0 < partitions)) {
+        rc = OMPI_ERR_OUT_OF_RESOURCE;
+        goto error;
+    }
+    req->req_num_parts = partitions;
+    req->req_part_bytes = count * size;
+
+    rc = mca_part_persist_alloc_tags(partitions, &first);
+    if (OPAL_UNLIKELY(OMPI_SUCCESS != rc)) {
+        goto error;
+    }
+    req->req_first_tag = first;
+    req->req_tags_allocated = true;
+
+    for (size_t i = 0 ; i < partitions ; ++i) {
+        rc = MCA_PML_CALL(isend_init((char *) buf + (ptrdiff_t) (i * count) * extent, count,
+                                     datatype, dst, MCA_PART_PERSIST_DATA_TAG(first + i),
+                                     MCA_PML_BASE_SEND_STANDARD, comm, req->req_parts + i));
+        if (OPAL_UNLIKELY(OMPI_SUCCESS != rc)) {
+            goto error;
+        }
+    }
+    req->req_setup_done = true;
+
+    /* let the receiver know which tags to expect */
+    req->req_setup[MCA_PART_PERSIST_SETUP_USER_TAG] = tag;
+    req->req_setup[MCA_PART_PERSIST_SETUP_FIRST_TAG] = first;
+    req->req_setup[MCA_PART_PERSIST_SETUP_PARTITIONS] = (int64_t) partitions;
+    req->req_setup[MCA_PART_PERSIST_SETUP_BYTES] = (int64_t) req->req_part_bytes;
+    rc = MCA_PML_CALL(isend(req->req_setup, MCA_PART_PERSIST_SETUP_COUNT, &ompi_mpi_int64_t.dt,
+                            dst, MCA_PART_PERSIST_SETUP_TAG(tag), MCA_PML_BASE_SEND_STANDARD,
+                            comm, &req->req_setup_req));
+    if (OPAL_UNLIKELY(OMPI_SUCCESS != rc)) {
+        goto error;
+    }
+
+    *request = &req->req_ompi;
+    return OMPI_SUCCESS;
+
+ error:
+    {
+        ompi_request_t *tmp = &req->req_ompi;
+        mca_part_persist_free(&tmp);
+    }
+    return rc;
+}
+
+int mca_part_persist_precv_init(void *buf, size_t partitions, size_t count,
+                                struct ompi_datatype_t *datatype, int src, int tag,
+                                struct ompi_communicator_t *comm, struct opal_info_t *info,
+                                struct ompi_request_t **request)
+{
+    mca_part_persist_request_t *req;
+    int rc;
+
+    req = mca_part_persist_request_alloc(false, buf, partitions, count, datatype, src, tag, comm);
+    if (OPAL_UNLIKELY(NULL == req)) {
+        return OMPI_ERR_OUT_OF_RESOURCE;
+    }
+
+    rc = MCA_PML_CALL(irecv(req->req_setup, MCA_PART_PERSIST_SETUP_COUNT, &ompi_mpi_int64_t.dt,
+                            src, MCA_PART_PERSIST_SETUP_TAG(tag), comm, &req->req_setup_req));
+    if (OPAL_UNLIKELY(OMPI_SUCCESS != rc)) {
+        ompi_request_t *tmp = &req->req_ompi;
+        mca_part_persist_free(&tmp);
+        return rc;
+    }
+
+    OPAL_THREAD_LOCK(&mca_part_persist_component.lock);
+    if (!mca_part_persist_component.progress_registered) {
+        mca_part_persist_component.progress_registered = true;
+        opal_progress_register(mca_part_persist_progress);
+    }
+    opal_list_append(&mca_part_persist_component.pending, &req->req_ompi.super.super);
+    req->req_on_pending_list = true;
+    OPAL_THREAD_UNLOCK(&mca_part_persist_component.lock);
+
+    *request = &req->req_ompi;
+    return OMPI_SUCCESS;
+}
+
+int mca_part_persist_pready(size_t low, size_t high, struct ompi_request_t *request)
+{
+    mca_part_persist_request_t *req = (mca_part_persist_request_t *) request;
+    int rc;
+
+    if (OPAL_UNLIKELY(!req->req_is_send || high >= req->req_partitions || low > high)) {
+        return OMPI_ERR_BAD_PARAM;
+    }
+
+    for (size_t i = low ; i <= high ; ++i) {
+        rc = mca_part_persist_start_part(req, i);
+        if (OPAL_UNLIKELY(OMPI_SUCCESS != rc)) {
+            return rc;
+        }
+    }
+    return OMPI_SUCCESS;
+}
+
+int mca_part_persist_parrived(size_t partition, int *flag, struct ompi_request_t *request)
+{
+    mca_part_persist_request_t *req = (mca_part_persist_request_t *) request;
+    size_t bytes, first, last;
+
+    if (OPAL_UNLIKELY(req->req_is_send || partition >= req->req_partitions)) {
+        return OMPI_ERR_BAD_PARAM;
+    }
+
+    *flag = 0;
+    if (REQUEST_COMPLETE(&req->req_ompi)) {
+        *flag = 1;
+        return OMPI_SUCCESS;
+    }
+    if (!req->req_setup_done || 0 == req->req_part_bytes) {
+        opal_progress();
+        return OMPI_SUCCESS;
+    }
+    opal_atomic_rmb();
+
+    /* the sender partitions overlapping this receive partition */
+    ompi_datatype_type_size(req->req_datatype, &bytes);
+    bytes *= req->req_count;
+    if (0 == bytes) {
+        *flag = 1;
+        return OMPI_SUCCESS;
+    }
+    first = (partition * bytes) / req->req_part_bytes;
+    last = ((partition + 1) * bytes - 1) / req->req_part_bytes;
+
+    for (size_t i = first ; i <= last ; ++i) {
+        if (!REQUEST_COMPLETE(req->req_parts[i])) {
+            opal_progress();
+            return OMPI_SUCCESS;
+        }
+    }
+    *flag = 1;
+    return OMPI_SUCCESS;
+}
+
+/*
+ * Create the partition receives of a request whose setup message
+ * arrived. Called with the component lock held.
+ */
+static void mca_part_persist_recv_setup(mca_part_persist_request_t *req)
+{
+    int64_t *setup = req->req_setup;
+    size_t size, elements, partitions, bytes;
+    ptrdiff_t lb, extent;
+    int rc = req->req_setup_req->req_status.MPI_ERROR;
+
+    ompi_request_free(&req->req_setup_req);
+    req->req_setup_req = NULL;
+
+    ompi_datatype_type_size(req->req_datatype, &size);
+    ompi_datatype_get_extent(req->req_datatype, &lb, &extent);
+    partitions = (size_t) setup[MCA_PART_PERSIST_SETUP_PARTITIONS];
+    bytes = (size_t) setup[MCA_PART_PERSIST_SETUP_BYTES];
+
+    if (OPAL_UNLIKELY(OMPI_SUCCESS != rc)) {
+        req->req_error = rc;
+    } else if (OPAL_UNLIKELY(setup[MCA_PART_PERSIST_SETUP_USER_TAG] != req->req_tag)) {
+        /* two partitioned requests with colliding setup tags were
+         * initialized in a different order on both sides */
+        req->req_error = MPI_ERR_TAG;
+    } else if (OPAL_UNLIKELY(partitions * bytes != req->req_partitions * req->req_count * size ||
+                             (0 != size && 0 != bytes % size))) {
+        /* the sender partitions must cover whole receive elements */
+        req->req_error = MPI_ERR_TRUNCATE;
+    } else {
+        elements = (0 == size) ? 0 : bytes / size;
+        req->req_parts = (ompi_request_t **) calloc(partitions, sizeof(ompi_request_t *));
+        if (OPAL_UNLIKELY(NULL == req->req_parts && 0 < partitions)) {
+            req->req_error = MPI_ERR_NO_MEM;
+            partitions = 0;
+        }
+        req->req_num_parts = partitions;
+        req->req_part_bytes = bytes;
+
+        for (size_t i = 0 ; i < partitions ; ++i) {
+            rc = MCA_PML_CALL(irecv_init((char *) req->req_addr + (ptrdiff_t) (i * elements) * extent,
+                                         elements, req->req_datatype, req->req_peer,
+                                         MCA_PART_PERSIST_DATA_TAG(setup[MCA_PART_PERSIST_SETUP_FIRST_TAG] + i),
+                                         req->req_comm, req->req_parts + i));
+            if (OPAL_UNLIKELY(OMPI_SUCCESS != rc)) {
+                req->req_error = MPI_ERR_INTERN;
+                break;
+            }
+        }
+    }
+    req->req_ompi.req_status._ucount = req->req_partitions * req->req_count * size;
+
+    opal_atomic_wmb();
+    req->req_setup_done = true;
+
+    if (req->req_start_pending) {
+        req->req_start_pending = false;
+        (void) mca_part_persist_recv_start_parts(req);
+    }
+}
+
+int mca_part_persist_progress(void)
+{
+    mca_part_persist_request_t *req, *next;
+    int count = 0;
+
+    if (opal_list_is_empty(&mca_part_persist_component.pending) ||
+        OPAL_THREAD_TRYLOCK(&mca_part_persist_component.lock)) {
+        return 0;
+    }
+
+    OPAL_LIST_FOREACH_SAFE(req, next, &mca_part_persist_component.pending, mca_part_persist_request_t) {
+        if (!REQUEST_COMPLETE(req->req_setup_req)) {
+            continue;
+        }
+        opal_list_remove_item(&mca_part_persist_component.pending, &req->req_ompi.super.super);
+        req->req_on_pending_list = false;
+        mca_part_persist_recv_setup(req);
+        ++count;
+    }
+
+    OPAL_THREAD_UNLOCK(&mca_part_persist_component.lock);
+
+    return count;
+}
@@ -0,0 +1,129 @@
+/* -*- Mode: C; c-basic-offset:4 ; indent-tabs-mode:nil -*- */
+/*
+ * $COPYRIGHT$
+ *
+ * Additional copyrights may follow
+ *
+ * $HEADER$
+ */
+/**
+ * @file
+ *
+ * Partitioned communication on top of the persistent requests of the
+ * PML.
+ *
+ * Each partition of a send request is a persistent PML send request,
+ * started by MPI_Pready, so that with ob1 every partition leaves as an
+ * eager fragment or an RDMA transfer scheduled through the BML as soon
+ * as it is ready. The receiver posts one persistent PML receive per
+ * sender partition and completes when all of them have completed.
+ *
+ * The two sides agree on the tags of the partitions with a setup
+ * message sent by the sender on psend_init: the sender allocates a
+ * block of tags from the partitioned range of the reserved tag space
+ * and sends it, along with the partitioning of its buffer, on a setup
+ * tag derived from the user tag. The receiver creates its partition
+ * receives once this message has arrived.
+ */
+
+#ifndef MCA_PART_PERSIST_H
+#define MCA_PART_PERSIST_H
+
+#include "ompi_config.h"
+
+#include "opal/class/opal_bitmap.h"
+#include "opal/class/opal_list.h"
+#include "opal/mca/threads/mutex.h"
+
+#include "ompi/mca/coll/base/coll_tags.h"
+#include "ompi/mca/part/part.h"
+#include "ompi/request/request.h"
+
+BEGIN_C_DECLS
+
+/* setup messages use one of these tags, depending on the user tag */
+#define MCA_PART_PERSIST_SETUP_TAGS 4096
+#define MCA_PART_PERSIST_SETUP_TAG(tag) \
+    (MCA_COLL_BASE_TAG_PART_BASE - (int) ((tag) % MCA_PART_PERSIST_SETUP_TAGS))
+
+/* and the partitions use the remainder of the partitioned range */
+#define MCA_PART_PERSIST_DATA_TAG_BASE (MCA_COLL_BASE_TAG_PART_BASE - MCA_PART_PERSIST_SETUP_TAGS)
+#define MCA_PART_PERSIST_DATA_TAGS \
+    ((uint32_t) (MCA_PART_PERSIST_DATA_TAG_BASE - MCA_COLL_BASE_TAG_PART_END + 1))
+#define MCA_PART_PERSIST_DATA_TAG(index) (MCA_PART_PERSIST_DATA_TAG_BASE - (int) (index))
+
+/* content of the setup message */
+enum {
+    MCA_PART_PERSIST_SETUP_USER_TAG,    /**< tag given by the user */
+    MCA_PART_PERSIST_SETUP_FIRST_TAG,   /**< index of the tag of the first partition */
+    MCA_PART_PERSIST_SETUP_PARTITIONS,  /**< number of partitions of the sender */
+    MCA_PART_PERSIST_SETUP_BYTES,       /**< size of a sender partition in bytes */
+    MCA_PART_PERSIST_SETUP_COUNT
+};
+
+struct mca_part_persist_component_t {
+    mca_part_base_component_t super;
+
+    int priority;
+    opal_mutex_t lock;
+    /** receive requests waiting for their setup message */
+    opal_list_t pending;
+    bool progress_registered;
+    /** partition tags in use by send requests, protected by lock */
+    opal_bitmap_t tags;
+    /** where the search for free partition tags starts */
+    uint32_t tag_cursor;
+};
+typedef struct mca_part_persist_component_t mca_part_persist_component_t;
+
+OMPI_DECLSPEC extern mca_part_persist_component_t mca_part_persist_component;
+extern mca_part_base_module_t mca_part_persist_module;
+
+struct mca_part_persist_request_t {
+    ompi_request_t req_ompi;            /**< base request, linked on the pending list */
+    bool req_is_send;
+    void *req_addr;
+    size_t req_partitions;              /**< user partitions */
+    size_t req_count;                   /**< elements in each user partition */
+    struct ompi_datatype_t *req_datatype;
+    struct ompi_communicator_t *req_comm;
+    int req_peer;
+    int req_tag;
+    int req_error;                      /**< error detected during setup */
+
+    ompi_request_t **req_parts;         /**< PML requests, one per sender partition */
+    size_t req_num_parts;
+    size_t req_part_bytes;              /**< size of a sender partition */
+    uint32_t req_first_tag;             /**< index of the tag of the first sender partition */
+    bool req_tags_allocated;            /**< the sender owns the tags of its partitions */
+    opal_atomic_int32_t req_pending;    /**< PML requests not yet completed */
+
+    int64_t req_setup[MCA_PART_PERSIST_SETUP_COUNT];
+    ompi_request_t *req_setup_req;
+    volatile bool req_setup_done;       /**< req_parts is ready to be started */
+    bool req_start_pending;             /**< started before the setup arrived */
+    bool req_on_pending_list;
+};
+typedef struct mca_part_persist_request_t mca_part_persist_request_t;
+
+OBJ_CLASS_DECLARATION(mca_part_persist_request_t);
+
+int mca_part_persist_psend_init(const void *buf, size_t partitions, size_t count,
+                                struct ompi_datatype_t *datatype, int dst, int tag,
+                                struct ompi_communicator_t *comm, struct opal_info_t *info,
+                                struct ompi_request_t **request);
+
+int mca_part_persist_precv_init(void *buf, size_t partitions, size_t count,
+                                struct ompi_datatype_t *datatype, int src, int tag,
+                                struct ompi_communicator_t *comm, struct opal_info_t *info,
+                                struct ompi_request_t **request);
+
+int mca_part_persist_pready(size_t low, size_t high, struct ompi_request_t *request);
+
+int mca_part_persist_parrived(size_t partition, int *flag, struct ompi_request_t *request);
+
+int mca_part_persist_progress(void);
+
+END_C_DECLS
+
+#endif /* MCA_PART_PERSIST_H */
@@ -0,0 +1,92 @@
+/* -*- Mode: C; c-basic-offset:4 ; indent-tabs-mode:nil -*- */
+/*
+ * $COPYRIGHT$
+ *
+ * Additional copyrights may follow
+ *
+ * $HEADER$
+ */
+
+#include "ompi_config.h"
+
+#include "opal/runtime/opal_progress.h"
+
+#include "ompi/constants.h"
+#include "ompi/mca/part/part.h"
+#include "ompi/mca/part/persist/part_persist.h"
+
+static int mca_part_persist_component_register(void);
+static int mca_part_persist_component_open(void);
+static int mca_part_persist_component_close(void);
+static mca_part_base_module_t *mca_part_persist_component_init(int *priority,
+                                                               bool enable_progress_threads,
+                                                               bool enable_mpi_threads);
+
+mca_part_persist_component_t mca_part_persist_component = {
+    .super = {
+        /* First, the mca_base_component_t struct containing meta
+           information about the component itself */
+
+        .partm_version = {
+            MCA_PART_BASE_VERSION_1_0_0,
+
+            .mca_component_name = "persist",
+            MCA_BASE_MAKE_VERSION(component, OMPI_MAJOR_VERSION, OMPI_MINOR_VERSION,
+                                  OMPI_RELEASE_VERSION),
+            .mca_open_component = mca_part_persist_component_open,
+            .mca_close_component = mca_part_persist_component_close,
+            .mca_register_component_params = mca_part_persist_component_register,
+        },
+        .partm_data = {
+            /* The component is checkpoint ready */
+            MCA_BASE_METADATA_PARAM_CHECKPOINT
+        },
+        .partm_init = mca_part_persist_component_init,
+    },
+};
+
+static int mca_part_persist_component_register(void)
+{
+    mca_part_persist_component.priority = 10;
+    (void) mca_base_component_var_register(&mca_part_persist_component.super.partm_version,
+                                           "priority", "Priority of the persist part component",
+                                           MCA_BASE_VAR_TYPE_INT, NULL, 0, 0,
+                                           OPAL_INFO_LVL_9,
+                                           MCA_BASE_VAR_SCOPE_READONLY,
+                                           &mca_part_persist_component.priority);
+
+    return OMPI_SUCCESS;
+}
+
+static int mca_part_persist_component_open(void)
+{
+    OBJ_CONSTRUCT(&mca_part_persist_component.lock, opal_mutex_t);
+    OBJ_CONSTRUCT(&mca_part_persist_component.pending, opal_list_t);
+    mca_part_persist_component.progress_registered = false;
+    OBJ_CONSTRUCT(&mca_part_persist_component.tags, opal_bitmap_t);
+    mca_part_persist_component.tag_cursor = 0;
+
+    return OMPI_SUCCESS;
+}
+
+static int mca_part_persist_component_close(void)
+{
+    if (mca_part_persist_component.progress_registered) {
+        opal_progress_unregister(mca_part_persist_progress);
+        mca_part_persist_component.progress_registered = false;
+    }
+
+    OBJ_DESTRUCT(&mca_part_persist_component.tags);
+    OBJ_DESTRUCT(&mca_part_persist_component.pending);
+    OBJ_DESTRUCT(&mca_part_persist_component.lock);
+
+    return OMPI_SUCCESS;
+}
+
+static mca_part_base_module_t *mca_part_persist_component_init(int *priority,
+                                                               bool enable_progress_threads,
+                                                               bool enable_mpi_threads)
+{
+    *priority = mca_part_persist_component.priority;
+    return &mca_part_persist_module;
+}
@@ -253,7 +253,7 @@ int mca_pml_ob1_add_comm(ompi_communicator_t* comm)
 
         if (OMPI_COMM_CHECK_ASSERT_ALLOW_OVERTAKE(comm)) {
 #if !MCA_PML_OB1_CUSTOM_MATCH
-            opal_list_append( &pml_proc->unexpected_frags, (opal_list_item_t*)frag );
+            mca_pml_ob1_append_unexpected (pml_proc, frag);
 #else
             custom_match_umq_append(pml_comm->umq, hdr->hdr_tag, hdr->hdr_src, frag);
 #endif
@@ -268,7 +268,7 @@ int mca_pml_ob1_add_comm(ompi_communicator_t* comm)
             /* We're now expecting the next sequence number. */
             pml_proc->expected_sequence++;
 #if !MCA_PML_OB1_CUSTOM_MATCH
-            opal_list_append( &pml_proc->unexpected_frags, (opal_list_item_t*)frag );
+            mca_pml_ob1_append_unexpected (pml_proc, frag);
 #else
             custom_match_umq_append(pml_comm->umq, hdr->hdr_tag, hdr->hdr_src, frag);
 #endif
@@ -629,9 +629,12 @@ int mca_pml_ob1_dump(struct ompi_communicator_t* comm, int verbose)
 
         /* dump all receive queues */
 #if !MCA_PML_OB1_CUSTOM_MATCH
-       if( opal_list_get_size(&proc->specific_receives) ) {
+       if( mca_pml_ob1_comm_proc_posted_count(proc) ) {
             opal_output(0, "expected specific receives\n");
             mca_pml_ob1_dump_frag_list(&proc->specific_receives, true);
+            for( uint32_t b = 0; NULL != proc->specific_buckets && b <= proc->bucket_mask; b++ ) {
+                mca_pml_ob1_dump_frag_list(proc->specific_buckets + b, true);
+            }
         }
 #endif
         if( NULL != proc->frags_cant_match ) {
@@ -639,9 +642,12 @@ int mca_pml_ob1_dump(struct ompi_communicator_t* comm, int verbose)
             mca_pml_ob1_dump_cant_match(proc->frags_cant_match);
         }
 #if !MCA_PML_OB1_CUSTOM_MATCH
-        if( opal_list_get_size(&proc->unexpected_frags) ) {
+        if( mca_pml_ob1_comm_proc_unexpected_count(proc) ) {
             opal_output(0, "unexpected frag\n");
             mca_pml_ob1_dump_frag_list(&proc->unexpected_frags, false);
+            for( uint32_t b = 0; NULL != proc->unexpected_buckets && b <= proc->bucket_mask; b++ ) {
+                mca_pml_ob1_dump_frag_list(proc->unexpected_buckets + b, false);
+            }
         }
 #endif
         /* dump all btls used for eager messages */
@@ -83,6 +83,7 @@ struct mca_pml_ob1_t {
     char* allocator_name;
     mca_allocator_base_module_t* allocator;
     unsigned int unexpected_limit;
+    int match_buckets;      /* number of tag buckets in each peer's matching queues (power of 2, 0 to disable) */
 };
 typedef struct mca_pml_ob1_t mca_pml_ob1_t;
 
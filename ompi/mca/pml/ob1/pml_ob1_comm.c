@@ -36,6 +36,21 @@ static void mca_pml_ob1_comm_proc_construct(mca_pml_ob1_comm_proc_t* proc)
 #if !MCA_PML_OB1_CUSTOM_MATCH
     OBJ_CONSTRUCT(&proc->specific_receives, opal_list_t);
     OBJ_CONSTRUCT(&proc->unexpected_frags, opal_list_t);
+    proc->specific_buckets = NULL;
+    proc->unexpected_buckets = NULL;
+    proc->bucket_mask = 0;
+    proc->unexpected_stamp = 0;
+    if (mca_pml_ob1.match_buckets > 1) {
+        /* if the allocation fails we just keep using the single queues */
+        proc->specific_buckets = (opal_list_t *) malloc (2 * mca_pml_ob1.match_buckets * sizeof (opal_list_t));
+        if (NULL != proc->specific_buckets) {
+            proc->unexpected_buckets = proc->specific_buckets + mca_pml_ob1.match_buckets;
+            proc->bucket_mask = mca_pml_ob1.match_buckets - 1;
+            for (int i = 0 ; i < 2 * mca_pml_ob1.match_buckets ; ++i) {
+                OBJ_CONSTRUCT(proc->specific_buckets + i, opal_list_t);
+            }
+        }
+    }
 #endif
 }
 
@@ -46,6 +61,12 @@ static void mca_pml_ob1_comm_proc_destruct(mca_pml_ob1_comm_proc_t* proc)
 #if !MCA_PML_OB1_CUSTOM_MATCH
     OBJ_DESTRUCT(&proc->specific_receives);
     OBJ_DESTRUCT(&proc->unexpected_frags);
+    if (NULL != proc->specific_buckets) {
+        for (uint32_t i = 0 ; i < 2 * (proc->bucket_mask + 1) ; ++i) {
+            OBJ_DESTRUCT(proc->specific_buckets + i);
+        }
+        free (proc->specific_buckets);
+    }
 #endif
     if (proc->ompi_proc) {
         OBJ_RELEASE(proc->ompi_proc);
@@ -49,6 +49,15 @@ struct mca_pml_ob1_comm_proc_t {
 #if !MCA_PML_OB1_CUSTOM_MATCH
     opal_list_t specific_receives; /**< queues of unmatched specific receives */
     opal_list_t unexpected_frags;  /**< unexpected fragment queues */
+    /* When pml_ob1_match_buckets is set the queues above are split by tag:
+     * specific_receives only holds the MPI_ANY_TAG receives, the others go
+     * to specific_buckets, and all unexpected fragments go to
+     * unexpected_buckets. Fragments are stamped on arrival so that
+     * MPI_ANY_TAG receives can still pick the oldest one. */
+    opal_list_t *specific_buckets;   /**< unmatched specific receives hashed by tag */
+    opal_list_t *unexpected_buckets; /**< unexpected fragments hashed by tag */
+    uint32_t bucket_mask;            /**< number of buckets - 1 */
+    uint64_t unexpected_stamp;       /**< arrival stamp of the next unexpected fragment */
 #endif
 };
 
@@ -107,6 +116,54 @@ static inline mca_pml_ob1_comm_proc_t *mca_pml_ob1_peer_lookup (struct ompi_comm
     return pml_comm->procs[rank];
 }
 
+#if !MCA_PML_OB1_CUSTOM_MATCH
+/**
+ * Queue holding the unmatched specific receives posted with this tag.
+ */
+static inline opal_list_t *mca_pml_ob1_comm_proc_posted_queue (mca_pml_ob1_comm_proc_t *proc, int tag)
+{
+    if (NULL == proc->specific_buckets || OMPI_ANY_TAG == tag) {
+        return &proc->specific_receives;
+    }
+    return proc->specific_buckets + ((uint32_t) tag & proc->bucket_mask);
+}
+
+/**
+ * Queue holding the unexpected fragments carrying this tag.
+ */
+static inline opal_list_t *mca_pml_ob1_comm_proc_unexpected_queue (mca_pml_ob1_comm_proc_t *proc, int tag)
+{
+    if (NULL == proc->unexpected_buckets) {
+        return &proc->unexpected_frags;
+    }
+    return proc->unexpected_buckets + ((uint32_t) tag & proc->bucket_mask);
+}
+
+static inline size_t mca_pml_ob1_comm_proc_posted_count (mca_pml_ob1_comm_proc_t *proc)
+{
+    size_t count = opal_list_get_size (&proc->specific_receives);
+
+    if (NULL != proc->specific_buckets) {
+        for (uint32_t i = 0 ; i <= proc->bucket_mask ; ++i) {
+            count += opal_list_get_size (proc->specific_buckets + i);
+        }
+    }
+    return count;
+}
+
+static inline size_t mca_pml_ob1_comm_proc_unexpected_count (mca_pml_ob1_comm_proc_t *proc)
+{
+    size_t count = opal_list_get_size (&proc->unexpected_frags);
+
+    if (NULL != proc->unexpected_buckets) {
+        for (uint32_t i = 0 ; i <= proc->bucket_mask ; ++i) {
+            count += opal_list_get_size (proc->unexpected_buckets + i);
+        }
+    }
+    return count;
+}
+#endif
+
 /**
  * Initialize an instance of mca_pml_ob1_comm_t based on the communicator size.
  *
@@ -45,6 +45,7 @@
 #include "opal/mca/base/mca_base_pvar.h"
 #include "opal/runtime/opal_params.h"
 #include "opal/mca/btl/base/base.h"
+#include "opal/util/bit_ops.h"
 
 OBJ_CLASS_INSTANCE( mca_pml_ob1_pckt_pending_t,
                     opal_free_list_item_t,
@@ -157,7 +158,7 @@ static int mca_pml_ob1_get_unex_msgq_size (const struct mca_base_pvar_t *pvar, v
             values[i] = custom_match_umq_size(pml_comm->umq); // TODO: given the structure of custom match this does not make sense,
                                                      //       as we only have one set of queues.
 #else
-            values[i] = opal_list_get_size (&pml_proc->unexpected_frags);
+            values[i] = mca_pml_ob1_comm_proc_unexpected_count (pml_proc);
 #endif
         } else {
             values[i] = 0;
@@ -184,7 +185,7 @@ static int mca_pml_ob1_get_posted_recvq_size (const struct mca_base_pvar_t *pvar
             values[i] = custom_match_prq_size(pml_comm->prq); // TODO: given the structure of custom match this does not make sense,
                                                      //       as we only have one set of queues.
 #else
-            values[i] = opal_list_get_size (&pml_proc->specific_receives);
+            values[i] = mca_pml_ob1_comm_proc_posted_count (pml_proc);
 #endif
         } else {
             values[i] = 0;
@@ -216,6 +217,17 @@ static int mca_pml_ob1_component_register(void)
 
     mca_pml_ob1_param_register_uint("unexpected_limit", 128, &mca_pml_ob1.unexpected_limit);
 
+    mca_pml_ob1.match_buckets = 0;
+    (void) mca_base_component_var_register(&mca_pml_ob1_component.pmlm_version, "match_buckets",
+                                           "Number of tag buckets used to index the posted receive and "
+                                           "unexpected message queues of each peer (rounded up to a power "
+                                           "of two). Matching cost then depends on the number of entries "
+                                           "sharing a bucket instead of the queue length, at the price of "
+                                           "two list heads per bucket for every peer of every communicator. "
+                                           "0 keeps a single queue per peer (default: 0)",
+                                           MCA_BASE_VAR_TYPE_INT, NULL, 0, 0, OPAL_INFO_LVL_5,
+                                           MCA_BASE_VAR_SCOPE_READONLY, &mca_pml_ob1.match_buckets);
+
     mca_pml_ob1.use_all_rdma = false;
     (void) mca_base_component_var_register(&mca_pml_ob1_component.pmlm_version, "use_all_rdma",
                                            "Use all available RDMA btls for the RDMA and RDMA pipeline protocols "
@@ -279,6 +291,12 @@ mca_pml_ob1_component_init( int* priority,
 
     *priority = mca_pml_ob1.priority;
 
+    if (mca_pml_ob1.match_buckets > 1) {
+        mca_pml_ob1.match_buckets = opal_next_poweroftwo_inclusive (mca_pml_ob1.match_buckets);
+    } else {
+        mca_pml_ob1.match_buckets = 0;
+    }
+
     allocator_component = mca_allocator_component_lookup( mca_pml_ob1.allocator_name );
     if(NULL == allocator_component) {
         opal_output(0, "mca_pml_ob1_component_init: can't find allocator: %s\n", mca_pml_ob1.allocator_name);
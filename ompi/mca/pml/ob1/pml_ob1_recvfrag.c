@@ -85,6 +85,20 @@ append_frag_to_list(opal_list_t *queue, mca_btl_base_module_t *btl,
     opal_list_append(queue, (opal_list_item_t*)frag);
 }
 
+#if !MCA_PML_OB1_CUSTOM_MATCH
+static void
+append_frag_to_unexpected(mca_pml_ob1_comm_proc_t *proc, mca_btl_base_module_t *btl,
+                          const mca_pml_ob1_match_hdr_t *hdr, const mca_btl_base_segment_t *segments,
+                          size_t num_segments, mca_pml_ob1_recv_frag_t* frag)
+{
+    if(NULL == frag) {
+        MCA_PML_OB1_RECV_FRAG_ALLOC(frag);
+        MCA_PML_OB1_RECV_FRAG_INIT(frag, hdr, segments, num_segments, btl);
+    }
+    mca_pml_ob1_append_unexpected(proc, frag);
+}
+#endif
+
 #if MCA_PML_OB1_CUSTOM_MATCH
 
 static void
@@ -370,14 +384,17 @@ int mca_pml_ob1_revoke_comm( struct ompi_communicator_t* ompi_comm, bool coll_on
          * so that we can send the nack as needed to remote cancel the send
          * from outside the match lock.
          */
-        opal_list_t* frags_list = &proc->unexpected_frags;
-        for( it = opal_list_get_first(frags_list);
-             it != opal_list_get_end(frags_list);
-             it = opal_list_get_next(it) ) {
-            mca_pml_ob1_recv_frag_t* frag = (mca_pml_ob1_recv_frag_t*)it;
-            if( pml_ob1_frag_is_revoked(ompi_comm, frag) ) {
-                it = opal_list_remove_item( frags_list, it );
-                opal_list_append(&nack_list, &frag->super.super);
+        size_t num_lists = 1 + (NULL != proc->unexpected_buckets ? proc->bucket_mask + 1 : 0);
+        for( size_t l = 0; l < num_lists; l++ ) {
+            opal_list_t* frags_list = (0 == l) ? &proc->unexpected_frags : proc->unexpected_buckets + (l - 1);
+            for( it = opal_list_get_first(frags_list);
+                 it != opal_list_get_end(frags_list);
+                 it = opal_list_get_next(it) ) {
+                mca_pml_ob1_recv_frag_t* frag = (mca_pml_ob1_recv_frag_t*)it;
+                if( pml_ob1_frag_is_revoked(ompi_comm, frag) ) {
+                    it = opal_list_remove_item( frags_list, it );
+                    opal_list_append(&nack_list, &frag->super.super);
+                }
             }
         }
         /* same for the cantmatch queue/heap; this list is more complicated
@@ -903,6 +920,56 @@ static mca_pml_ob1_recv_request_t *match_incomming_no_any_source (const mca_pml_
 }
 #endif
 
+#if !MCA_PML_OB1_CUSTOM_MATCH
+static mca_pml_ob1_recv_request_t *match_incomming_buckets(const mca_pml_ob1_match_hdr_t *hdr,
+                                                           mca_pml_ob1_comm_t *comm,
+                                                           mca_pml_ob1_comm_proc_t *proc,
+                                                           bool any_source)
+{
+    /* With hashed queues, a fragment can match receives from three
+     * queues: the wild receives, the MPI_ANY_TAG receives of the peer and
+     * the bucket of its tag. Walk them in the order the receives were
+     * posted (req_sequence) and take the first match. */
+    opal_list_t *queues[3];
+    mca_pml_ob1_recv_request_t *reqs[3];
+    int tag = hdr->hdr_tag, num_queues = 0;
+
+    if (any_source) {
+        queues[num_queues++] = &comm->wild_receives;
+    }
+    queues[num_queues++] = &proc->specific_receives;
+    queues[num_queues++] = mca_pml_ob1_comm_proc_posted_queue(proc, tag);
+    for (int i = 0 ; i < num_queues ; ++i) {
+        reqs[i] = get_posted_recv(queues[i]);
+    }
+
+    while (true) {
+        mca_pml_sequence_t seq = PML_MAX_SEQ;
+        int req_tag, oldest = -1;
+
+        for (int i = 0 ; i < num_queues ; ++i) {
+            if (NULL != reqs[i] && (oldest < 0 || reqs[i]->req_recv.req_base.req_sequence < seq)) {
+                seq = reqs[i]->req_recv.req_base.req_sequence;
+                oldest = i;
+            }
+        }
+        if (oldest < 0) {
+            return NULL;
+        }
+
+        req_tag = reqs[oldest]->req_recv.req_base.req_tag;
+        if(req_tag == tag || (req_tag == OMPI_ANY_TAG && tag >= 0)) {
+            opal_list_remove_item(queues[oldest], (opal_list_item_t*)reqs[oldest]);
+            PERUSE_TRACE_COMM_EVENT(PERUSE_COMM_REQ_REMOVE_FROM_POSTED_Q,
+                    &(reqs[oldest]->req_recv.req_base), PERUSE_RECV);
+            return reqs[oldest];
+        }
+
+        reqs[oldest] = get_next_posted_recv(queues[oldest], reqs[oldest]);
+    }
+}
+#endif
+
 static mca_pml_ob1_recv_request_t *match_one (mca_btl_base_module_t *btl,
                                               const mca_pml_ob1_match_hdr_t *hdr,
                                               const mca_btl_base_segment_t *segments,
@@ -922,7 +989,10 @@ static mca_pml_ob1_recv_request_t *match_one (mca_btl_base_module_t *btl,
 #if MCA_PML_OB1_CUSTOM_MATCH
         match = match_incomming(hdr, comm, proc);
 #else
-        if (!OMPI_COMM_CHECK_ASSERT_NO_ANY_SOURCE (comm_ptr)) {
+        if (OPAL_UNLIKELY(NULL != proc->specific_buckets)) {
+            match = match_incomming_buckets(hdr, comm, proc,
+                                            !OMPI_COMM_CHECK_ASSERT_NO_ANY_SOURCE (comm_ptr));
+        } else if (!OMPI_COMM_CHECK_ASSERT_NO_ANY_SOURCE (comm_ptr)) {
             match = match_incomming(hdr, comm, proc);
         } else {
             match = match_incomming_no_any_source (hdr, comm, proc);
@@ -971,8 +1041,8 @@ static mca_pml_ob1_recv_request_t *match_one (mca_btl_base_module_t *btl,
         append_frag_to_umq(comm->umq, btl, hdr, segments,
                             num_segments, frag);
 #else
-        append_frag_to_list(&proc->unexpected_frags, btl, hdr, segments,
-                            num_segments, frag);
+        append_frag_to_unexpected(proc, btl, hdr, segments,
+                                  num_segments, frag);
 #endif
         SPC_RECORD(OMPI_SPC_UNEXPECTED, 1);
         SPC_RECORD(OMPI_SPC_UNEXPECTED_IN_QUEUE, 1);
@@ -45,6 +45,7 @@ struct mca_pml_ob1_recv_frag_t {
     mca_pml_ob1_hdr_t hdr;
     size_t num_segments;
     struct mca_pml_ob1_recv_frag_t* range;
+    uint64_t stamp;       /**< arrival order on the unexpected queues of the peer */
     mca_btl_base_module_t* btl;
     mca_btl_base_segment_t segments[MCA_BTL_DES_MAX_SEGMENTS];
     mca_pml_ob1_buffer_t buffers[MCA_BTL_DES_MAX_SEGMENTS];
@@ -111,6 +112,19 @@ do {                                                                    \
  } while(0)
 
 
+#if !MCA_PML_OB1_CUSTOM_MATCH
+/**
+ * Append a fragment to the unexpected queue of the peer it comes from.
+ */
+static inline void mca_pml_ob1_append_unexpected (mca_pml_ob1_comm_proc_t *proc,
+                                                  mca_pml_ob1_recv_frag_t *frag)
+{
+    frag->stamp = proc->unexpected_stamp++;
+    opal_list_append (mca_pml_ob1_comm_proc_unexpected_queue (proc, frag->hdr.hdr_match.hdr_tag),
+                      (opal_list_item_t *) frag);
+}
+#endif
+
 /**
  *  Callback from BTL on receipt of a recv_frag (match).
  */
@@ -117,7 +117,8 @@ static int mca_pml_ob1_recv_request_cancel(struct ompi_request_t* ompi_request,
             opal_list_remove_item( &ob1_comm->wild_receives, (opal_list_item_t*)request );
         } else {
             mca_pml_ob1_comm_proc_t* proc = mca_pml_ob1_peer_lookup (comm, request->req_recv.req_base.req_peer);
-            opal_list_remove_item(&proc->specific_receives, (opal_list_item_t*)request);
+            opal_list_remove_item(mca_pml_ob1_comm_proc_posted_queue(proc, request->req_recv.req_base.req_tag),
+                                  (opal_list_item_t*)request);
         }
 #endif
         PERUSE_TRACE_COMM_EVENT( PERUSE_COMM_REQ_REMOVE_FROM_POSTED_Q,
@@ -1154,9 +1155,26 @@ recv_req_match_specific_proc( const mca_pml_ob1_recv_request_t *req,
 
 #if !MCA_PML_OB1_CUSTOM_MATCH
     int tag = req->req_recv.req_base.req_tag;
-    opal_list_t* unexpected_frags = &proc->unexpected_frags;
+    opal_list_t* unexpected_frags = mca_pml_ob1_comm_proc_unexpected_queue(proc, tag);
     mca_pml_ob1_recv_frag_t* frag;
 
+    if( OMPI_ANY_TAG == tag && NULL != proc->unexpected_buckets ) {
+        /* the oldest fragment with a user tag is at the head of one of
+         * the buckets, compare the heads by arrival stamp */
+        mca_pml_ob1_recv_frag_t* oldest = NULL;
+
+        for( uint32_t i = 0 ; i <= proc->bucket_mask ; ++i ) {
+            OPAL_LIST_FOREACH(frag, proc->unexpected_buckets + i, mca_pml_ob1_recv_frag_t) {
+                if( frag->hdr.hdr_match.hdr_tag >= 0 ) {
+                    if( NULL == oldest || frag->stamp < oldest->stamp )
+                        oldest = frag;
+                    break;
+                }
+            }
+        }
+        return oldest;
+    }
+
     if(opal_list_get_size(unexpected_frags) == 0) {
         return NULL;
     }
@@ -1342,7 +1360,7 @@ void mca_pml_ob1_recv_req_start(mca_pml_ob1_recv_request_t *req)
         frag = recv_req_match_specific_proc(req, proc, &hold_prev, &hold_elem, &hold_index);
 #else
         frag = recv_req_match_specific_proc(req, proc);
-        queue = &proc->specific_receives;
+        queue = mca_pml_ob1_comm_proc_posted_queue(proc, req->req_recv.req_base.req_tag);
 #endif
         /* wildcard recv will be prepared on match */
         prepare_recv_req_converter(req);
@@ -1382,7 +1400,7 @@ void mca_pml_ob1_recv_req_start(mca_pml_ob1_recv_request_t *req)
 #if MCA_PML_OB1_CUSTOM_MATCH
             custom_match_umq_remove_hold(req->req_recv.req_base.req_comm->c_pml_comm->umq, hold_prev, hold_elem, hold_index);
 #else
-            opal_list_remove_item(&proc->unexpected_frags,
+            opal_list_remove_item(mca_pml_ob1_comm_proc_unexpected_queue(proc, frag->hdr.hdr_match.hdr_tag),
                                   (opal_list_item_t*)frag);
 #endif
             SPC_RECORD(OMPI_SPC_UNEXPECTED_IN_QUEUE, -1);
@@ -1418,7 +1436,7 @@ void mca_pml_ob1_recv_req_start(mca_pml_ob1_recv_request_t *req)
 #if MCA_PML_OB1_CUSTOM_MATCH
             custom_match_umq_remove_hold(req->req_recv.req_base.req_comm->c_pml_comm->umq, hold_prev, hold_elem, hold_index);
 #else
-            opal_list_remove_item(&proc->unexpected_frags,
+            opal_list_remove_item(mca_pml_ob1_comm_proc_unexpected_queue(proc, frag->hdr.hdr_match.hdr_tag),
                                   (opal_list_item_t*)frag);
 #endif
             SPC_RECORD(OMPI_SPC_UNEXPECTED_IN_QUEUE, -1);
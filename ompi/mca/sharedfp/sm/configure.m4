@@ -27,21 +27,9 @@
 AC_DEFUN([MCA_ompi_sharedfp_sm_CONFIG],[
     AC_CONFIG_FILES([ompi/mca/sharedfp/sm/Makefile])
 
-    sharedfp_sm_happy=no
-    AC_CHECK_HEADER([semaphore.h],
-                    [dnl requires potentially pthread library
-                     OPAL_SEARCH_LIBS_COMPONENT([sharedfp_sm],
-                                    [sem_open], [pthread],
-                                    [AC_CHECK_FUNCS([sem_open],
-                                                    [sharedfp_sm_happy="yes"],[])]
-                                                )])
-    AC_CHECK_HEADER([semaphore.h],
-                    [dnl requires potentially pthread library
-                     OPAL_SEARCH_LIBS_COMPONENT([sharedfp_sm],
-                                    [sem_init], [pthread],
-                                    [AC_CHECK_FUNCS([sem_init],
-                                                    [sharedfp_sm_happy="yes"],[])]
-                                                )])
+    # The shared file pointer is kept in a file backed shared memory
+    # segment and only updated with atomic operations.
+    sharedfp_sm_happy=yes
     AS_IF([test "$sharedfp_sm_happy" = "yes"],
           [$1],
           [$2])
@@ -28,7 +28,7 @@
 #include "ompi/mca/mca.h"
 #include "ompi/mca/sharedfp/sharedfp.h"
 #include "ompi/mca/common/ompio/common_ompio.h"
-#include <semaphore.h>
+#include "opal/sys/atomic.h"
 
 BEGIN_C_DECLS
 
@@ -105,8 +105,8 @@ int mca_sharedfp_sm_iwrite (ompio_file_t *fh,
  *Structures and definitions only for this component
  *--------------------------------------------------------------*/
 struct mca_sharedfp_sm_offset{
-    sem_t mutex;      /* the mutex: a POSIX memory-based unnamed semaphore */
-    long long offset;  /* and the shared file pointer offset */
+    /* the shared file pointer offset, only updated with atomic operations */
+    opal_atomic_int64_t offset;
 };
 
 /*This structure will hang off of the mca_sharedfp_base_data_t's
@@ -117,11 +117,6 @@ struct mca_sharedfp_sm_data
     struct mca_sharedfp_sm_offset * sm_offset_ptr;
     /*save filename so that we can remove the file on close*/
     char * sm_filename;
-    /* The mutex: it will either point to a POSIX memory-based named
-       semaphore, or it will point to the a POSIX memory-based unnamed
-       semaphore located in sm_offset_ptr->mutex. */
-    sem_t *mutex;
-    char *sem_name;    /* Name of the semaphore */
 };
 
 typedef struct mca_sharedfp_sm_data sm_data_global;
@@ -41,7 +41,6 @@
 #include "ompi/mca/sharedfp/sharedfp.h"
 #include "ompi/mca/sharedfp/base/base.h"
 
-#include <semaphore.h>
 #include <sys/mman.h>
 #include <libgen.h>
 #include <unistd.h>
@@ -173,63 +172,15 @@ int mca_sharedfp_sm_file_open (struct ompi_communicator_t *comm,
         return OMPI_ERROR;
     }
 
-    /* Initialize semaphore so that is shared between processes.           */
-    /* the semaphore is shared by keeping it in the shared memory segment  */
-
-#if defined(HAVE_SEM_OPEN)
-
-#if defined (__APPLE__)
-    sm_data->sem_name = (char*) malloc( sizeof(char) * 32);
-    snprintf(sm_data->sem_name,31,"OMPIO_%s",filename_basename);
-#else
-    sm_data->sem_name = (char*) malloc( sizeof(char) * 253);
-    snprintf(sm_data->sem_name,252,"OMPIO_%s",filename_basename);
-#endif
-
-    if( (sm_data->mutex = sem_open(sm_data->sem_name, O_CREAT, 0644, 1)) != SEM_FAILED ) {
-#elif defined(HAVE_SEM_INIT)
-    sm_data->mutex = &sm_offset_ptr->mutex;
-    if(sem_init(&sm_offset_ptr->mutex, 1, 1) != -1){
-#endif
-        /*If opening was successful*/
-        /*Store the new file handle*/
-        sm_data->sm_offset_ptr = sm_offset_ptr;
-        /* Assign the sm_data to sh->selected_module_data*/
-        sh->selected_module_data   = sm_data;
-        /*remember the shared file handle*/
-        fh->f_sharedfp_data = sh;
-
-        /*write initial zero*/
-        if(fh->f_rank==0){
-            MPI_Offset position=0;
-
-            sem_wait(sm_data->mutex);
-            sm_offset_ptr->offset=position;
-            sem_post(sm_data->mutex);
-        }
-    }else{
-        free(sm_filename);
-        free(sm_data);
-        free(sh);
-        munmap(sm_offset_ptr, sizeof(struct mca_sharedfp_sm_offset));
-        return OMPI_ERROR;
-    }
-
-    err = comm->c_coll->coll_barrier (comm, comm->c_coll->coll_barrier_module );
-    if ( OMPI_SUCCESS != err ) {
-        opal_output(0,"mca_sharedfp_sm_file_open: Error in barrier operation \n");
-        free(sm_filename);
-        free(sm_data);
-        free(sh);
-        munmap(sm_offset_ptr, sizeof(struct mca_sharedfp_sm_offset));
-        return err;
-    }
-
-#if defined(HAVE_SEM_OPEN)
-    if ( 0 == fh->f_rank ) {
-        sem_unlink ( sm_data->sem_name);
-    }
-#endif
+    /* The file was zeroed by rank 0 before the barrier above, so the
+    ** shared file pointer starts at 0. It is only updated with atomic operations
+    ** on the mapped segment, see mca_sharedfp_sm_request_position.
+    */
+    sm_data->sm_offset_ptr = sm_offset_ptr;
+    /* Assign the sm_data to sh->selected_module_data*/
+    sh->selected_module_data   = sm_data;
+    /*remember the shared file handle*/
+    fh->f_sharedfp_data = sh;
 
     return OMPI_SUCCESS;
 }
@@ -257,13 +208,6 @@ int mca_sharedfp_sm_file_close (ompio_file_t *fh)
     if (file_data)  {
         /*Close sm handle*/
         if (file_data->sm_offset_ptr) {
-            /* destroy semaphore */
-#if defined(HAVE_SEM_OPEN)
-             sem_close ( file_data->mutex);
-             free (file_data->sem_name);
-#elif defined(HAVE_SEM_INIT)
-            sem_destroy(&file_data->sm_offset_ptr->mutex);
-#endif
             /*Release the shared memory segment.*/
             munmap(file_data->sm_offset_ptr,sizeof(struct mca_sharedfp_sm_offset));
             /*Q: Do we need to delete the file? */
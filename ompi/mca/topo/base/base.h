@@ -101,6 +101,16 @@ mca_topo_base_cart_map(ompi_communicator_t * comm,
                        int ndims,
                        const int *dims, const int *periods, int *newrank);
 
+/**
+ * Compute a locality aware placement of the first nprocs processes of
+ * comm on a cartesian grid: perm[i] is the rank in comm of the process
+ * that gets rank i. Collective over comm.
+ */
+OMPI_DECLSPEC int
+mca_topo_base_cart_reorder(ompi_communicator_t *comm,
+                           int ndims, const int *dims,
+                           int nprocs, int *perm);
+
 OMPI_DECLSPEC int
 mca_topo_base_cart_rank(ompi_communicator_t *comm,
                         const int *coords,
@@ -144,6 +154,14 @@ mca_topo_base_graph_map(ompi_communicator_t * comm,
                         int nnodes,
                         const int *index, const int *edges, int *newrank);
 
+/**
+ * Graph counterpart of mca_topo_base_cart_reorder(). Collective over comm.
+ */
+OMPI_DECLSPEC int
+mca_topo_base_graph_reorder(ompi_communicator_t *comm,
+                            int nnodes, const int *index, const int *edges,
+                            int *perm);
+
 OMPI_DECLSPEC int
 mca_topo_base_graph_neighbors(ompi_communicator_t *comm,
                               int rank,
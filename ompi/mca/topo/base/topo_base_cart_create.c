@@ -42,7 +42,9 @@
  * @param reorder ranking may be reordered (true) or not (false) (logical)
  * @param comm_cart communicator with new cartesian topology (handle)
  *
- * Open MPI currently ignores the 'reorder' flag.
+ * When 'reorder' is set the ranks are remapped so that neighbors in the
+ * grid share a node, and a socket, wherever possible (see
+ * mca_topo_base_cart_reorder()).
  *
  * @retval OMPI_SUCCESS
  */
@@ -56,6 +58,7 @@ int mca_topo_base_cart_create(mca_topo_base_module_t *topo,
                               ompi_communicator_t** comm_topo)
 {
     int nprocs = 1, i, new_rank, num_procs, ret;
+    int *perm = NULL;
     ompi_communicator_t *new_comm;
     ompi_proc_t **topo_procs = NULL;
     mca_topo_base_comm_cart_2_2_0_t* cart;
@@ -82,6 +85,26 @@ int mca_topo_base_cart_create(mca_topo_base_module_t *topo,
         num_procs = nprocs;
     }
 
+    /* all the processes of old_comm take part in the reordering, even the
+       ones left out of the new communicator */
+    if (reorder) {
+        perm = (int*)malloc(nprocs * sizeof(int));
+        if (NULL == perm) {
+            return OMPI_ERR_OUT_OF_RESOURCE;
+        }
+        ret = mca_topo_base_cart_reorder(old_comm, ndims, dims, nprocs, perm);
+        if (OMPI_SUCCESS != ret) {
+            free(perm);
+            return ret;
+        }
+        for (i = 0; (new_rank < nprocs) && (i < nprocs); i++) {
+            if (perm[i] == new_rank) {
+                new_rank = i;
+                break;
+            }
+        }
+    }
+
     if (new_rank > (nprocs-1)) {
         ndims = 0;
         new_rank = MPI_UNDEFINED;
@@ -90,6 +113,7 @@ int mca_topo_base_cart_create(mca_topo_base_module_t *topo,
 
     cart = OBJ_NEW(mca_topo_base_comm_cart_2_2_0_t);
     if( NULL == cart ) {
+        free(perm);
         return OMPI_ERR_OUT_OF_RESOURCE;
     }
     cart->ndims = ndims;
@@ -100,6 +124,7 @@ int mca_topo_base_cart_create(mca_topo_base_module_t *topo,
         cart->dims = (int*)malloc(sizeof(int) * ndims);
         if (NULL == cart->dims) {
             OBJ_RELEASE(cart);
+            free(perm);
             return OMPI_ERROR;
         }
         memcpy(cart->dims, dims, ndims * sizeof(int));
@@ -108,6 +133,7 @@ int mca_topo_base_cart_create(mca_topo_base_module_t *topo,
         cart->periods = (int*)malloc(sizeof(int) * ndims);
         if (NULL == cart->periods) {
             OBJ_RELEASE(cart);
+            free(perm);
             return OMPI_ERR_OUT_OF_RESOURCE;
         }
         memcpy(cart->periods, periods, ndims * sizeof(int));
@@ -115,6 +141,7 @@ int mca_topo_base_cart_create(mca_topo_base_module_t *topo,
         cart->coords = (int*)malloc(sizeof(int) * ndims);
         if (NULL == cart->coords) {
             OBJ_RELEASE(cart);
+            free(perm);
             return OMPI_ERR_OUT_OF_RESOURCE;
         }
         {  /* setup the cartesian topology */
@@ -139,9 +166,14 @@ int mca_topo_base_cart_create(mca_topo_base_module_t *topo,
         topo_procs = (ompi_proc_t**)malloc(num_procs * sizeof(ompi_proc_t *));
         if (NULL == topo_procs) {
             OBJ_RELEASE(cart);
+            free(perm);
             return OMPI_ERR_OUT_OF_RESOURCE;
         }
-        if(OMPI_GROUP_IS_DENSE(old_comm->c_local_group)) {
+        if(NULL != perm) {
+            for(i = 0 ; i < num_procs; i++) {
+                topo_procs[i] = ompi_group_peer_lookup(old_comm->c_local_group, perm[i]);
+            }
+        } else if(OMPI_GROUP_IS_DENSE(old_comm->c_local_group)) {
             memcpy(topo_procs,
                    old_comm->c_local_group->grp_proc_pointers,
                    num_procs * sizeof(ompi_proc_t *));
@@ -151,6 +183,7 @@ int mca_topo_base_cart_create(mca_topo_base_module_t *topo,
             }
         }
     }
+    free(perm);
 
     /* allocate a new communicator */
     new_comm = ompi_comm_allocate(num_procs, 0);
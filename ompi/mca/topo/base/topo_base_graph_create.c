@@ -36,6 +36,9 @@
  * @param reorder ranking may be reordered (true) or not (false) (logical)
  * @param comm_graph communicator with graph topology added (handle)
  *
+ * When 'reorder' is set the ranks are remapped so that adjacent vertices
+ * share a node wherever possible (see mca_topo_base_graph_reorder()).
+ *
  * @retval MPI_SUCCESS
  * @retval MPI_ERR_OUT_OF_RESOURCE
  */
@@ -50,6 +53,7 @@ int mca_topo_base_graph_create(mca_topo_base_module_t *topo,
 {
     ompi_communicator_t *new_comm;
     int new_rank, num_procs, ret, i;
+    int *perm = NULL;
     ompi_proc_t **topo_procs = NULL;
     mca_topo_base_comm_graph_2_2_0_t* graph;
 
@@ -63,6 +67,26 @@ int mca_topo_base_graph_create(mca_topo_base_module_t *topo,
     if( num_procs > nnodes ) {
         num_procs = nnodes;
     }
+    /* all the processes of old_comm take part in the reordering, even the
+       ones left out of the new communicator */
+    if( reorder ) {
+        perm = (int*)malloc(nnodes * sizeof(int));
+        if( NULL == perm ) {
+            return OMPI_ERR_OUT_OF_RESOURCE;
+        }
+        ret = mca_topo_base_graph_reorder(old_comm, nnodes, index, edges, perm);
+        if( OMPI_SUCCESS != ret ) {
+            free(perm);
+            return ret;
+        }
+        for( i = 0; (new_rank < nnodes) && (i < nnodes); i++ ) {
+            if( perm[i] == new_rank ) {
+                new_rank = i;
+                break;
+            }
+        }
+    }
+
     if( new_rank > (nnodes - 1) ) {
         new_rank = MPI_UNDEFINED;
         num_procs = 0;
@@ -71,6 +95,7 @@ int mca_topo_base_graph_create(mca_topo_base_module_t *topo,
 
     graph = OBJ_NEW(mca_topo_base_comm_graph_2_2_0_t);
     if( NULL == graph ) {
+        free(perm);
         return OMPI_ERR_OUT_OF_RESOURCE;
     }
     graph->nnodes = nnodes;
@@ -87,6 +112,7 @@ int mca_topo_base_graph_create(mca_topo_base_module_t *topo,
         graph->index = (int*)malloc(sizeof(int) * nnodes);
         if (NULL == graph->index) {
             OBJ_RELEASE(graph);
+            free(perm);
             return OMPI_ERR_OUT_OF_RESOURCE;
         }
         memcpy(graph->index, index, nnodes * sizeof(int));
@@ -95,6 +121,7 @@ int mca_topo_base_graph_create(mca_topo_base_module_t *topo,
         graph->edges = (int*)malloc(sizeof(int) * index[nnodes-1]);
         if (NULL == graph->edges) {
             OBJ_RELEASE(graph);
+            free(perm);
             return OMPI_ERR_OUT_OF_RESOURCE;
         }
         memcpy(graph->edges, edges, index[nnodes-1] * sizeof(int));
@@ -102,9 +129,14 @@ int mca_topo_base_graph_create(mca_topo_base_module_t *topo,
         topo_procs = (ompi_proc_t**)malloc(num_procs * sizeof(ompi_proc_t *));
         if (NULL == topo_procs) {
            OBJ_RELEASE(graph);
+           free(perm);
            return OMPI_ERR_OUT_OF_RESOURCE;
         }
-        if(OMPI_GROUP_IS_DENSE(old_comm->c_local_group)) {
+        if(NULL != perm) {
+            for(i = 0 ; i < num_procs; i++) {
+                topo_procs[i] = ompi_group_peer_lookup(old_comm->c_local_group, perm[i]);
+            }
+        } else if(OMPI_GROUP_IS_DENSE(old_comm->c_local_group)) {
             memcpy(topo_procs,
                    old_comm->c_local_group->grp_proc_pointers,
                    num_procs * sizeof(ompi_proc_t *));
@@ -114,6 +146,7 @@ int mca_topo_base_graph_create(mca_topo_base_module_t *topo,
             }
         }
     }
+    free(perm);
 
     /* allocate a new communicator */
     new_comm = ompi_comm_allocate(nnodes, 0);
@@ -0,0 +1,349 @@
+/* -*- Mode: C; c-basic-offset:4 ; indent-tabs-mode:nil -*- */
+/*
+ * $COPYRIGHT$
+ *
+ * Additional copyrights may follow
+ *
+ * $HEADER$
+ */
+
+#include "ompi_config.h"
+
+#include <stdlib.h>
+
+#include "opal/mca/hwloc/base/base.h"
+#include "opal/util/output.h"
+#include "ompi/constants.h"
+#include "ompi/communicator/communicator.h"
+#include "ompi/datatype/ompi_datatype.h"
+#include "ompi/mca/coll/coll.h"
+#include "ompi/mca/topo/base/base.h"
+
+/*
+ * Rank reordering for MPI_Cart_create and MPI_Graph_create.
+ *
+ * Every process publishes a locality key (the node and the socket it is
+ * bound to) and all of them compute the same permutation out of the
+ * gathered keys, so no further agreement is needed. The participating
+ * processes are sorted node major, then socket major, and handed out to
+ * the topology in an order that keeps neighbors together:
+ *  - cartesian: the grid is cut into identical sub-blocks, one per node
+ *    and inside a node one per socket, so that most of the faces between
+ *    neighbors stay inside a node.
+ *  - graph: the vertices are numbered in breadth first order, and
+ *    consecutive vertices go to the same node.
+ * Whenever the locality does not lend itself to this (a single node and
+ * socket, unbalanced nodes, a grid that can not be cut evenly) the
+ * identity permutation is returned.
+ */
+
+typedef struct {
+    int node;
+    int socket;
+    int rank;
+} topo_base_locality_t;
+
+static int topo_base_locality_cmp(const void *a, const void *b)
+{
+    const topo_base_locality_t *la = (const topo_base_locality_t*)a;
+    const topo_base_locality_t *lb = (const topo_base_locality_t*)b;
+
+    if (la->node != lb->node) {
+        return (la->node < lb->node) ? -1 : 1;
+    }
+    if (la->socket != lb->socket) {
+        return (la->socket < lb->socket) ? -1 : 1;
+    }
+    return (la->rank < lb->rank) ? -1 : (la->rank > lb->rank);
+}
+
+/* Index of the socket this process is bound to, -1 if unknown or unbound */
+static int topo_base_my_socket(void)
+{
+    hwloc_cpuset_t set;
+    hwloc_obj_t obj;
+    int socket = -1;
+
+    if (OPAL_SUCCESS != opal_hwloc_base_get_topology()) {
+        return -1;
+    }
+    set = hwloc_bitmap_alloc();
+    if (NULL == set) {
+        return -1;
+    }
+    if (0 == hwloc_get_cpubind(opal_hwloc_topology, set, 0) &&
+        !hwloc_bitmap_isincluded(hwloc_get_root_obj(opal_hwloc_topology)->cpuset, set)) {
+        obj = hwloc_get_obj_covering_cpuset(opal_hwloc_topology, set);
+        while (NULL != obj && obj->type != HWLOC_OBJ_SOCKET) {
+            obj = obj->parent;
+        }
+        if (NULL != obj) {
+            socket = (int)obj->logical_index;
+        }
+    }
+    hwloc_bitmap_free(set);
+    return socket;
+}
+
+/*
+ * Collect the locality of the first nprocs processes of comm, sorted node
+ * major. The node of a process is identified by the lowest rank sharing
+ * it. Returns the number of distinct (node, socket) pairs in *ndomains.
+ */
+static int topo_base_gather_locality(ompi_communicator_t *comm, int nprocs,
+                                     topo_base_locality_t **plocs, int *ndomains)
+{
+    int size = ompi_comm_size(comm), rank = ompi_comm_rank(comm);
+    int mine[2], *keys, i, err;
+    topo_base_locality_t *locs;
+    ompi_proc_t *proc;
+
+    mine[0] = rank;
+    for (i = 0; i < rank; i++) {
+        proc = ompi_group_peer_lookup(comm->c_local_group, i);
+        if (OPAL_PROC_ON_LOCAL_NODE(proc->super.proc_flags)) {
+            mine[0] = i;
+            break;
+        }
+    }
+    mine[1] = topo_base_my_socket();
+
+    keys = (int*)malloc(2 * size * sizeof(int));
+    if (NULL == keys) {
+        return OMPI_ERR_OUT_OF_RESOURCE;
+    }
+    err = comm->c_coll->coll_allgather(mine, 2, MPI_INT, keys, 2, MPI_INT, comm,
+                                       comm->c_coll->coll_allgather_module);
+    if (OMPI_SUCCESS != err) {
+        free(keys);
+        return err;
+    }
+
+    locs = (topo_base_locality_t*)malloc(nprocs * sizeof(topo_base_locality_t));
+    if (NULL == locs) {
+        free(keys);
+        return OMPI_ERR_OUT_OF_RESOURCE;
+    }
+    for (i = 0; i < nprocs; i++) {
+        locs[i].node = keys[2 * i];
+        locs[i].socket = keys[2 * i + 1];
+        locs[i].rank = i;
+    }
+    free(keys);
+    qsort(locs, nprocs, sizeof(topo_base_locality_t), topo_base_locality_cmp);
+
+    *ndomains = (nprocs > 0) ? 1 : 0;
+    for (i = 1; i < nprocs; i++) {
+        if (locs[i].node != locs[i-1].node || locs[i].socket != locs[i-1].socket) {
+            (*ndomains)++;
+        }
+    }
+    *plocs = locs;
+    return OMPI_SUCCESS;
+}
+
+/*
+ * Number of processes in each group of the sorted array when all the
+ * groups have the same size, 0 otherwise. A group is a node, or a node
+ * and a socket when by_socket is set.
+ */
+static int topo_base_uniform_group_size(const topo_base_locality_t *locs, int nprocs,
+                                        bool by_socket)
+{
+    int i, start = 0, gsize = 0;
+
+    for (i = 1; i <= nprocs; i++) {
+        if (i < nprocs && locs[i].node == locs[start].node &&
+            (!by_socket || locs[i].socket == locs[start].socket)) {
+            continue;
+        }
+        if (by_socket && locs[start].socket < 0) {
+            return 0;
+        }
+        if (0 == gsize) {
+            gsize = i - start;
+        } else if (gsize != i - start) {
+            return 0;
+        }
+        start = i;
+    }
+    return gsize;
+}
+
+/*
+ * Find a sub-block of extent holding exactly count elements, cutting the
+ * longest remaining dimension first to keep the block compact.
+ */
+static bool topo_base_cart_block(int ndims, const int *extent, int count, int *block)
+{
+    int d, best, p;
+
+    for (d = 0; d < ndims; d++) {
+        block[d] = 1;
+    }
+    for (p = 2; count > 1; p++) {
+        while (0 == (count % p)) {
+            best = -1;
+            for (d = 0; d < ndims; d++) {
+                if (0 != ((extent[d] / block[d]) % p)) {
+                    continue;
+                }
+                if (-1 == best || (extent[d] / block[d]) > (extent[best] / block[best])) {
+                    best = d;
+                }
+            }
+            if (-1 == best) {
+                return false;
+            }
+            block[best] *= p;
+            count /= p;
+        }
+    }
+    return true;
+}
+
+int mca_topo_base_cart_reorder(ompi_communicator_t *comm,
+                               int ndims, const int *dims,
+                               int nprocs, int *perm)
+{
+    topo_base_locality_t *locs = NULL;
+    int *node_block = NULL, *sock_block = NULL, *coords = NULL, *grid = NULL;
+    int i, d, k, idx, err, ndomains, node_size, sock_size, pos;
+
+    for (i = 0; i < nprocs; i++) {
+        perm[i] = i;
+    }
+
+    err = topo_base_gather_locality(comm, nprocs, &locs, &ndomains);
+    if (OMPI_SUCCESS != err) {
+        return err;
+    }
+    if (ndomains <= 1 || ndims <= 0) {
+        goto done;
+    }
+
+    node_size = topo_base_uniform_group_size(locs, nprocs, false);
+    if (0 == node_size) {
+        goto done;
+    }
+    sock_size = topo_base_uniform_group_size(locs, nprocs, true);
+    if (0 == sock_size) {
+        sock_size = node_size;
+    }
+
+    node_block = (int*)malloc(4 * ndims * sizeof(int));
+    if (NULL == node_block) {
+        err = OMPI_ERR_OUT_OF_RESOURCE;
+        goto done;
+    }
+    sock_block = node_block + ndims;
+    coords = sock_block + ndims;
+    grid = coords + ndims;
+
+    if (!topo_base_cart_block(ndims, dims, node_size, node_block)) {
+        goto done;
+    }
+    if (!topo_base_cart_block(ndims, node_block, sock_size, sock_block)) {
+        memcpy(sock_block, node_block, ndims * sizeof(int));
+        sock_size = node_size;
+    }
+
+    for (k = 0; k < nprocs; k++) {
+        for (d = 0; d < ndims; d++) {
+            coords[d] = 0;
+        }
+        /* node block, then socket block inside the node, then the process
+         * inside the socket, each of them numbered in row major order */
+        idx = k / node_size;
+        for (d = ndims - 1; d >= 0; d--) {
+            grid[d] = dims[d] / node_block[d];
+            coords[d] += (idx % grid[d]) * node_block[d];
+            idx /= grid[d];
+        }
+        idx = (k % node_size) / sock_size;
+        for (d = ndims - 1; d >= 0; d--) {
+            grid[d] = node_block[d] / sock_block[d];
+            coords[d] += (idx % grid[d]) * sock_block[d];
+            idx /= grid[d];
+        }
+        idx = k % sock_size;
+        for (d = ndims - 1; d >= 0; d--) {
+            coords[d] += idx % sock_block[d];
+            idx /= sock_block[d];
+        }
+        for (pos = 0, d = 0; d < ndims; d++) {
+            pos = pos * dims[d] + coords[d];
+        }
+        perm[pos] = locs[k].rank;
+    }
+
+    OPAL_OUTPUT_VERBOSE((10, ompi_topo_base_framework.framework_output,
+                         "topo:base:cart_reorder: %d processes in %d domains, %d per node, %d per socket",
+                         nprocs, ndomains, node_size, sock_size));
+
+ done:
+    free(node_block);
+    free(locs);
+    return err;
+}
+
+int mca_topo_base_graph_reorder(ompi_communicator_t *comm,
+                                int nnodes, const int *index, const int *edges,
+                                int *perm)
+{
+    topo_base_locality_t *locs = NULL;
+    int *queue = NULL;
+    char *visited = NULL;
+    int i, j, v, err, ndomains, head, tail, root;
+
+    for (i = 0; i < nnodes; i++) {
+        perm[i] = i;
+    }
+
+    err = topo_base_gather_locality(comm, nnodes, &locs, &ndomains);
+    if (OMPI_SUCCESS != err) {
+        return err;
+    }
+    if (ndomains <= 1) {
+        goto done;
+    }
+
+    queue = (int*)malloc(nnodes * sizeof(int));
+    visited = (char*)calloc(nnodes, sizeof(char));
+    if (NULL == queue || NULL == visited) {
+        err = OMPI_ERR_OUT_OF_RESOURCE;
+        goto done;
+    }
+
+    /* breadth first numbering of the vertices; the tail of the queue is
+     * the number of vertices already placed */
+    for (head = tail = 0, root = 0; root < nnodes; root++) {
+        if (visited[root]) {
+            continue;
+        }
+        visited[root] = 1;
+        queue[tail++] = root;
+        while (head < tail) {
+            v = queue[head++];
+            for (j = (0 == v) ? 0 : index[v-1]; j < index[v]; j++) {
+                if (!visited[edges[j]]) {
+                    visited[edges[j]] = 1;
+                    queue[tail++] = edges[j];
+                }
+            }
+        }
+    }
+    for (i = 0; i < nnodes; i++) {
+        perm[queue[i]] = locs[i].rank;
+    }
+
+    OPAL_OUTPUT_VERBOSE((10, ompi_topo_base_framework.framework_output,
+                         "topo:base:graph_reorder: %d processes in %d domains",
+                         nnodes, ndomains));
+
+ done:
+    free(visited);
+    free(queue);
+    free(locs);
+    return err;
+}
@@ -0,0 +1,77 @@
+/* -*- Mode: C; c-basic-offset:4 ; indent-tabs-mode:nil -*- */
+/*
+ * $COPYRIGHT$
+ *
+ * Additional copyrights may follow
+ *
+ * $HEADER$
+ */
+
+#include "ompi_config.h"
+
+#include <string.h>
+
+#include "ompi/mpi/c/bindings.h"
+#include "ompi/runtime/params.h"
+#include "ompi/communicator/communicator.h"
+#include "ompi/errhandler/errhandler.h"
+#include "ompi/group/group.h"
+#include "ompi/info/info.h"
+
+#if OMPI_BUILD_MPI_PROFILING
+#if OPAL_HAVE_WEAK_SYMBOLS
+#pragma weak MPI_Comm_create_from_group = PMPI_Comm_create_from_group
+#endif
+#define MPI_Comm_create_from_group PMPI_Comm_create_from_group
+#endif
+
+static const char FUNC_NAME[] = "MPI_Comm_create_from_group";
+
+int MPI_Comm_create_from_group(MPI_Group group, const char *stringtag, MPI_Info info,
+                               MPI_Errhandler errhandler, MPI_Comm *newcomm)
+{
+    int rc;
+
+    if (MPI_PARAM_CHECK) {
+        OMPI_ERR_INIT_FINALIZE(FUNC_NAME);
+
+        if (NULL == group || MPI_GROUP_NULL == group) {
+            return OMPI_ERRHANDLER_NOHANDLE_INVOKE(MPI_ERR_GROUP, FUNC_NAME);
+        }
+
+        if (NULL == stringtag || strlen(stringtag) >= MPI_MAX_STRINGTAG_LEN) {
+            return OMPI_ERRHANDLER_NOHANDLE_INVOKE(MPI_ERR_ARG, FUNC_NAME);
+        }
+
+        if (NULL == info || ompi_info_is_freed(info)) {
+            return OMPI_ERRHANDLER_NOHANDLE_INVOKE(MPI_ERR_INFO, FUNC_NAME);
+        }
+
+        if (NULL == errhandler || MPI_ERRHANDLER_NULL == errhandler ||
+            (OMPI_ERRHANDLER_TYPE_COMM != errhandler->eh_mpi_object_type &&
+             !ompi_errhandler_is_intrinsic(errhandler))) {
+            return OMPI_ERRHANDLER_NOHANDLE_INVOKE(MPI_ERR_ARG, FUNC_NAME);
+        }
+
+        if (NULL == newcomm) {
+            return OMPI_ERRHANDLER_NOHANDLE_INVOKE(MPI_ERR_ARG, FUNC_NAME);
+        }
+    }
+
+    if (MPI_UNDEFINED == ompi_group_rank(group)) {
+        *newcomm = MPI_COMM_NULL;
+        return MPI_SUCCESS;
+    }
+
+    rc = ompi_comm_create_from_group((ompi_group_t *) group, stringtag,
+                                     MPI_INFO_NULL == info ? NULL : &info->super,
+                                     errhandler, (ompi_communicator_t **) newcomm);
+    if (OPAL_UNLIKELY(OMPI_SUCCESS != rc)) {
+        /* there is no communicator yet, use the handler of the caller */
+        return ompi_errhandler_invoke(errhandler, &ompi_mpi_comm_null.comm,
+                                      OMPI_ERRHANDLER_TYPE_COMM,
+                                      ompi_errcode_get_mpi_code(rc), FUNC_NAME);
+    }
+
+    return MPI_SUCCESS;
+}
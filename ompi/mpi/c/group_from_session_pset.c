@@ -0,0 +1,44 @@
+/* -*- Mode: C; c-basic-offset:4 ; indent-tabs-mode:nil -*- */
+/*
+ * $COPYRIGHT$
+ *
+ * Additional copyrights may follow
+ *
+ * $HEADER$
+ */
+
+#include "ompi_config.h"
+
+#include "ompi/mpi/c/bindings.h"
+#include "ompi/runtime/params.h"
+#include "ompi/errhandler/errhandler.h"
+#include "ompi/group/group.h"
+#include "ompi/instance/instance.h"
+
+#if OMPI_BUILD_MPI_PROFILING
+#if OPAL_HAVE_WEAK_SYMBOLS
+#pragma weak MPI_Group_from_session_pset = PMPI_Group_from_session_pset
+#endif
+#define MPI_Group_from_session_pset PMPI_Group_from_session_pset
+#endif
+
+static const char FUNC_NAME[] = "MPI_Group_from_session_pset";
+
+int MPI_Group_from_session_pset(MPI_Session session, const char *pset_name, MPI_Group *newgroup)
+{
+    int ret;
+
+    if (MPI_PARAM_CHECK) {
+        OMPI_ERR_INIT_FINALIZE(FUNC_NAME);
+        if (ompi_instance_invalid(session)) {
+            return OMPI_ERRHANDLER_NOHANDLE_INVOKE(MPI_ERR_SESSION, FUNC_NAME);
+        }
+        if (NULL == pset_name || NULL == newgroup) {
+            return OMPI_ERRHANDLER_INVOKE(session, MPI_ERR_ARG, FUNC_NAME);
+        }
+    }
+
+    ret = ompi_group_from_pset(session, pset_name, newgroup);
+    /* an unknown process set is an erroneous argument */
+    OMPI_ERRHANDLER_RETURN(ret, session, MPI_ERR_ARG, FUNC_NAME);
+}
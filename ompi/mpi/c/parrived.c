@@ -0,0 +1,53 @@
+/* -*- Mode: C; c-basic-offset:4 ; indent-tabs-mode:nil -*- */
+/*
+ * $COPYRIGHT$
+ *
+ * Additional copyrights may follow
+ *
+ * $HEADER$
+ */
+#include "ompi_config.h"
+#include <stdio.h>
+
+#include "ompi/mpi/c/bindings.h"
+#include "ompi/runtime/params.h"
+#include "ompi/communicator/communicator.h"
+#include "ompi/errhandler/errhandler.h"
+#include "ompi/mca/part/part.h"
+#include "ompi/request/request.h"
+#include "ompi/memchecker.h"
+
+#if OMPI_BUILD_MPI_PROFILING
+#if OPAL_HAVE_WEAK_SYMBOLS
+#pragma weak MPI_Parrived = PMPI_Parrived
+#endif
+#define MPI_Parrived PMPI_Parrived
+#endif
+
+static const char FUNC_NAME[] = "MPI_Parrived";
+
+
+int MPI_Parrived(MPI_Request request, int partition, int *flag)
+{
+    int rc = MPI_SUCCESS;
+
+    if ( MPI_PARAM_CHECK ) {
+        OMPI_ERR_INIT_FINALIZE(FUNC_NAME);
+        if (NULL == request || (OMPI_REQUEST_PART != request->req_type &&
+                                OMPI_REQUEST_NOOP != request->req_type)) {
+            rc = MPI_ERR_REQUEST;
+        } else if (partition < 0 || NULL == flag) {
+            rc = MPI_ERR_ARG;
+        }
+        OMPI_ERRHANDLER_NOHANDLE_CHECK(rc, rc, FUNC_NAME);
+    }
+
+    /* partitioned requests from MPI_PROC_NULL */
+    if (OMPI_REQUEST_NOOP == request->req_type) {
+        *flag = 1;
+        return MPI_SUCCESS;
+    }
+
+    rc = MCA_PART_CALL(parrived((size_t) partition, flag, request));
+    OMPI_ERRHANDLER_RETURN(rc, request->req_mpi_object.comm, rc, FUNC_NAME);
+}
@@ -0,0 +1,52 @@
+/* -*- Mode: C; c-basic-offset:4 ; indent-tabs-mode:nil -*- */
+/*
+ * $COPYRIGHT$
+ *
+ * Additional copyrights may follow
+ *
+ * $HEADER$
+ */
+#include "ompi_config.h"
+#include <stdio.h>
+
+#include "ompi/mpi/c/bindings.h"
+#include "ompi/runtime/params.h"
+#include "ompi/communicator/communicator.h"
+#include "ompi/errhandler/errhandler.h"
+#include "ompi/mca/part/part.h"
+#include "ompi/request/request.h"
+#include "ompi/memchecker.h"
+
+#if OMPI_BUILD_MPI_PROFILING
+#if OPAL_HAVE_WEAK_SYMBOLS
+#pragma weak MPI_Pready_range = PMPI_Pready_range
+#endif
+#define MPI_Pready_range PMPI_Pready_range
+#endif
+
+static const char FUNC_NAME[] = "MPI_Pready_range";
+
+
+int MPI_Pready_range(int partition_low, int partition_high, MPI_Request request)
+{
+    int rc = MPI_SUCCESS;
+
+    if ( MPI_PARAM_CHECK ) {
+        OMPI_ERR_INIT_FINALIZE(FUNC_NAME);
+        if (NULL == request || (OMPI_REQUEST_PART != request->req_type &&
+                                OMPI_REQUEST_NOOP != request->req_type)) {
+            rc = MPI_ERR_REQUEST;
+        } else if (partition_low < 0 || partition_high < partition_low) {
+            rc = MPI_ERR_ARG;
+        }
+        OMPI_ERRHANDLER_NOHANDLE_CHECK(rc, rc, FUNC_NAME);
+    }
+
+    /* partitioned requests to MPI_PROC_NULL */
+    if (OMPI_REQUEST_NOOP == request->req_type) {
+        return MPI_SUCCESS;
+    }
+
+    rc = MCA_PART_CALL(pready((size_t) partition_low, (size_t) partition_high, request));
+    OMPI_ERRHANDLER_RETURN(rc, request->req_mpi_object.comm, rc, FUNC_NAME);
+}
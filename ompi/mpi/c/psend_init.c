@@ -0,0 +1,78 @@
+/* -*- Mode: C; c-basic-offset:4 ; indent-tabs-mode:nil -*- */
+/*
+ * $COPYRIGHT$
+ *
+ * Additional copyrights may follow
+ *
+ * $HEADER$
+ */
+#include "ompi_config.h"
+#include <stdio.h>
+
+#include "ompi/mpi/c/bindings.h"
+#include "ompi/runtime/params.h"
+#include "ompi/communicator/communicator.h"
+#include "ompi/errhandler/errhandler.h"
+#include "ompi/info/info.h"
+#include "ompi/mca/pml/pml.h"
+#include "ompi/mca/part/part.h"
+#include "ompi/request/request.h"
+#include "ompi/memchecker.h"
+
+#if OMPI_BUILD_MPI_PROFILING
+#if OPAL_HAVE_WEAK_SYMBOLS
+#pragma weak MPI_Psend_init = PMPI_Psend_init
+#endif
+#define MPI_Psend_init PMPI_Psend_init
+#endif
+
+static const char FUNC_NAME[] = "MPI_Psend_init";
+
+
+int MPI_Psend_init(const void *buf, int partitions, MPI_Count count,
+                   MPI_Datatype type, int dest, int tag, MPI_Comm comm,
+                   MPI_Info info, MPI_Request *request)
+{
+    int rc = MPI_SUCCESS;
+
+    MEMCHECKER(
+        memchecker_datatype(type);
+        memchecker_comm(comm);
+    );
+
+    if ( MPI_PARAM_CHECK ) {
+        OMPI_ERR_INIT_FINALIZE(FUNC_NAME);
+        if (ompi_comm_invalid(comm)) {
+            return OMPI_ERRHANDLER_NOHANDLE_INVOKE(MPI_ERR_COMM, FUNC_NAME);
+        } else if (partitions < 1) {
+            rc = MPI_ERR_ARG;
+        } else if (count < 0) {
+            rc = MPI_ERR_COUNT;
+        } else if (tag < 0 || tag > mca_pml.pml_max_tag) {
+            rc = MPI_ERR_TAG;
+        } else if (ompi_comm_peer_invalid(comm, dest) &&
+                   (MPI_PROC_NULL != dest)) {
+            rc = MPI_ERR_RANK;
+        } else if (NULL == info || ompi_info_is_freed(info)) {
+            rc = MPI_ERR_INFO;
+        } else if (request == NULL) {
+            rc = MPI_ERR_REQUEST;
+        } else {
+            OMPI_CHECK_DATATYPE_FOR_SEND(rc, type, count);
+        }
+        OMPI_ERRHANDLER_CHECK(rc, comm, rc, FUNC_NAME);
+    }
+
+    if (MPI_PROC_NULL == dest) {
+        rc = ompi_request_persistent_noop_create(request);
+        OMPI_ERRHANDLER_RETURN(rc, comm, rc, FUNC_NAME);
+    }
+
+    if (OPAL_UNLIKELY(NULL == mca_part.part_psend_init)) {
+        return OMPI_ERRHANDLER_INVOKE(comm, MPI_ERR_UNSUPPORTED_OPERATION, FUNC_NAME);
+    }
+
+    rc = MCA_PART_CALL(psend_init(buf, (size_t) partitions, (size_t) count, type, dest, tag,
+                                  comm, &info->super, request));
+    OMPI_ERRHANDLER_RETURN(rc, comm, rc, FUNC_NAME);
+}
@@ -0,0 +1,40 @@
+/* -*- Mode: C; c-basic-offset:4 ; indent-tabs-mode:nil -*- */
+/*
+ * $COPYRIGHT$
+ *
+ * Additional copyrights may follow
+ *
+ * $HEADER$
+ */
+
+#include "ompi_config.h"
+
+#include "ompi/mpi/c/bindings.h"
+#include "ompi/runtime/params.h"
+#include "ompi/errhandler/errhandler.h"
+#include "ompi/instance/instance.h"
+
+#if OMPI_BUILD_MPI_PROFILING
+#if OPAL_HAVE_WEAK_SYMBOLS
+#pragma weak MPI_Session_finalize = PMPI_Session_finalize
+#endif
+#define MPI_Session_finalize PMPI_Session_finalize
+#endif
+
+static const char FUNC_NAME[] = "MPI_Session_finalize";
+
+int MPI_Session_finalize(MPI_Session *session)
+{
+    int ret;
+
+    if (MPI_PARAM_CHECK) {
+        OMPI_ERR_INIT_FINALIZE(FUNC_NAME);
+        if (NULL == session || ompi_instance_invalid(*session)) {
+            return OMPI_ERRHANDLER_NOHANDLE_INVOKE(MPI_ERR_SESSION, FUNC_NAME);
+        }
+    }
+
+    ret = ompi_instance_finalize(session);
+    /* the session is gone, errors can only be reported globally */
+    OMPI_ERRHANDLER_NOHANDLE_RETURN(ret, ret, FUNC_NAME);
+}
@@ -0,0 +1,50 @@
+/* -*- Mode: C; c-basic-offset:4 ; indent-tabs-mode:nil -*- */
+/*
+ * $COPYRIGHT$
+ *
+ * Additional copyrights may follow
+ *
+ * $HEADER$
+ */
+
+#include "ompi_config.h"
+
+#include "ompi/mpi/c/bindings.h"
+#include "ompi/runtime/params.h"
+#include "ompi/errhandler/errhandler.h"
+#include "ompi/info/info.h"
+#include "ompi/instance/instance.h"
+
+#if OMPI_BUILD_MPI_PROFILING
+#if OPAL_HAVE_WEAK_SYMBOLS
+#pragma weak MPI_Session_get_info = PMPI_Session_get_info
+#endif
+#define MPI_Session_get_info PMPI_Session_get_info
+#endif
+
+static const char FUNC_NAME[] = "MPI_Session_get_info";
+
+int MPI_Session_get_info(MPI_Session session, MPI_Info *info_used)
+{
+    opal_info_t *opal_info_used;
+
+    if (MPI_PARAM_CHECK) {
+        OMPI_ERR_INIT_FINALIZE(FUNC_NAME);
+        if (ompi_instance_invalid(session)) {
+            return OMPI_ERRHANDLER_NOHANDLE_INVOKE(MPI_ERR_SESSION, FUNC_NAME);
+        }
+        if (NULL == info_used) {
+            return OMPI_ERRHANDLER_INVOKE(session, MPI_ERR_INFO, FUNC_NAME);
+        }
+    }
+
+    (*info_used) = OBJ_NEW(ompi_info_t);
+    if (NULL == (*info_used)) {
+        return OMPI_ERRHANDLER_INVOKE(session, MPI_ERR_NO_MEM, FUNC_NAME);
+    }
+    opal_info_used = &(*info_used)->super;
+
+    opal_info_dup(session->super.s_info, &opal_info_used);
+
+    return MPI_SUCCESS;
+}
@@ -0,0 +1,48 @@
+/* -*- Mode: C; c-basic-offset:4 ; indent-tabs-mode:nil -*- */
+/*
+ * $COPYRIGHT$
+ *
+ * Additional copyrights may follow
+ *
+ * $HEADER$
+ */
+
+#include "ompi_config.h"
+
+#include "ompi/mpi/c/bindings.h"
+#include "ompi/runtime/params.h"
+#include "ompi/errhandler/errhandler.h"
+#include "ompi/info/info.h"
+#include "ompi/instance/instance.h"
+
+#if OMPI_BUILD_MPI_PROFILING
+#if OPAL_HAVE_WEAK_SYMBOLS
+#pragma weak MPI_Session_get_nth_pset = PMPI_Session_get_nth_pset
+#endif
+#define MPI_Session_get_nth_pset PMPI_Session_get_nth_pset
+#endif
+
+static const char FUNC_NAME[] = "MPI_Session_get_nth_pset";
+
+int MPI_Session_get_nth_pset(MPI_Session session, MPI_Info info, int n, int *pset_len,
+                             char *pset_name)
+{
+    int ret;
+
+    if (MPI_PARAM_CHECK) {
+        OMPI_ERR_INIT_FINALIZE(FUNC_NAME);
+        if (ompi_instance_invalid(session)) {
+            return OMPI_ERRHANDLER_NOHANDLE_INVOKE(MPI_ERR_SESSION, FUNC_NAME);
+        }
+        if (NULL == pset_len || n < 0 || *pset_len < 0 ||
+            (0 != *pset_len && NULL == pset_name)) {
+            return OMPI_ERRHANDLER_INVOKE(session, MPI_ERR_ARG, FUNC_NAME);
+        }
+        if (NULL == info || ompi_info_is_freed(info)) {
+            return OMPI_ERRHANDLER_INVOKE(session, MPI_ERR_INFO, FUNC_NAME);
+        }
+    }
+
+    ret = ompi_instance_get_nth_pset(session, n, pset_len, pset_name);
+    OMPI_ERRHANDLER_RETURN(ret, session, ret, FUNC_NAME);
+}
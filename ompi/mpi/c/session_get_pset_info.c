@@ -0,0 +1,59 @@
+/* -*- Mode: C; c-basic-offset:4 ; indent-tabs-mode:nil -*- */
+/*
+ * $COPYRIGHT$
+ *
+ * Additional copyrights may follow
+ *
+ * $HEADER$
+ */
+
+#include "ompi_config.h"
+
+#include "ompi/mpi/c/bindings.h"
+#include "ompi/runtime/params.h"
+#include "ompi/errhandler/errhandler.h"
+#include "ompi/info/info.h"
+#include "ompi/instance/instance.h"
+
+#if OMPI_BUILD_MPI_PROFILING
+#if OPAL_HAVE_WEAK_SYMBOLS
+#pragma weak MPI_Session_get_pset_info = PMPI_Session_get_pset_info
+#endif
+#define MPI_Session_get_pset_info PMPI_Session_get_pset_info
+#endif
+
+static const char FUNC_NAME[] = "MPI_Session_get_pset_info";
+
+int MPI_Session_get_pset_info(MPI_Session session, const char *pset_name, MPI_Info *info)
+{
+    ompi_info_t *pset_info;
+    int ret;
+
+    if (MPI_PARAM_CHECK) {
+        OMPI_ERR_INIT_FINALIZE(FUNC_NAME);
+        if (ompi_instance_invalid(session)) {
+            return OMPI_ERRHANDLER_NOHANDLE_INVOKE(MPI_ERR_SESSION, FUNC_NAME);
+        }
+        if (NULL == pset_name) {
+            return OMPI_ERRHANDLER_INVOKE(session, MPI_ERR_ARG, FUNC_NAME);
+        }
+        if (NULL == info) {
+            return OMPI_ERRHANDLER_INVOKE(session, MPI_ERR_INFO, FUNC_NAME);
+        }
+    }
+
+    pset_info = OBJ_NEW(ompi_info_t);
+    if (NULL == pset_info) {
+        return OMPI_ERRHANDLER_INVOKE(session, MPI_ERR_NO_MEM, FUNC_NAME);
+    }
+
+    ret = ompi_instance_get_pset_info(session, pset_name, &pset_info->super);
+    if (OMPI_SUCCESS != ret) {
+        ompi_info_free(&pset_info);
+        OMPI_ERRHANDLER_RETURN(ret, session, MPI_ERR_ARG, FUNC_NAME);
+    }
+
+    *info = pset_info;
+
+    return MPI_SUCCESS;
+}
@@ -0,0 +1,81 @@
+/* -*- Mode: C; c-basic-offset:4 ; indent-tabs-mode:nil -*- */
+/*
+ * $COPYRIGHT$
+ *
+ * Additional copyrights may follow
+ *
+ * $HEADER$
+ */
+
+#include "ompi_config.h"
+
+#include <string.h>
+
+#include "ompi/mpi/c/bindings.h"
+#include "ompi/runtime/params.h"
+#include "ompi/errhandler/errhandler.h"
+#include "ompi/info/info.h"
+#include "ompi/instance/instance.h"
+
+#if OMPI_BUILD_MPI_PROFILING
+#if OPAL_HAVE_WEAK_SYMBOLS
+#pragma weak MPI_Session_init = PMPI_Session_init
+#endif
+#define MPI_Session_init PMPI_Session_init
+#endif
+
+static const char FUNC_NAME[] = "MPI_Session_init";
+
+static const char *thread_level_names[] = {
+    [MPI_THREAD_SINGLE] = "MPI_THREAD_SINGLE",
+    [MPI_THREAD_FUNNELED] = "MPI_THREAD_FUNNELED",
+    [MPI_THREAD_SERIALIZED] = "MPI_THREAD_SERIALIZED",
+    [MPI_THREAD_MULTIPLE] = "MPI_THREAD_MULTIPLE",
+};
+
+int MPI_Session_init(MPI_Info info, MPI_Errhandler errhandler, MPI_Session *session)
+{
+    int ret, flag, ts_level = MPI_THREAD_SINGLE;
+    opal_cstring_t *info_value;
+    opal_info_t *opal_info = NULL;
+
+    /* this function may be called before MPI_Init, do not check for
+       OMPI_ERR_INIT_FINALIZE */
+    if (MPI_PARAM_CHECK) {
+        if (NULL == session) {
+            return OMPI_ERRHANDLER_NOHANDLE_INVOKE(MPI_ERR_ARG, FUNC_NAME);
+        }
+        if (NULL == info || ompi_info_is_freed(info)) {
+            return OMPI_ERRHANDLER_NOHANDLE_INVOKE(MPI_ERR_INFO, FUNC_NAME);
+        }
+        /* there are no session specific error handlers yet */
+        if (NULL == errhandler || MPI_ERRHANDLER_NULL == errhandler ||
+            !ompi_errhandler_is_intrinsic(errhandler)) {
+            return OMPI_ERRHANDLER_NOHANDLE_INVOKE(MPI_ERR_ARG, FUNC_NAME);
+        }
+    }
+
+    if (MPI_INFO_NULL != info) {
+        opal_info = &info->super;
+        opal_info_get(opal_info, "thread_level", &info_value, &flag);
+        if (flag) {
+            for (int i = MPI_THREAD_SINGLE ; i <= MPI_THREAD_MULTIPLE ; ++i) {
+                if (0 == strcmp(info_value->string, thread_level_names[i])) {
+                    ts_level = i;
+                    break;
+                }
+            }
+            OBJ_RELEASE(info_value);
+        }
+    }
+
+    ret = ompi_instance_init(ts_level, opal_info, errhandler, session);
+    if (OPAL_UNLIKELY(OMPI_SUCCESS != ret)) {
+        /* the session does not exist, report the error on the handler
+           given by the application */
+        return ompi_errhandler_invoke(errhandler, NULL, OMPI_ERRHANDLER_TYPE_INSTANCE,
+                                      ompi_errcode_get_mpi_code(ret), FUNC_NAME);
+    }
+
+    return MPI_SUCCESS;
+}
@@ -51,6 +51,11 @@ opal_list_t  ompi_proc_list = {{0}};
 static opal_mutex_t ompi_proc_lock;
 static opal_hash_table_t ompi_proc_hash;
 
+/* sorted vpids of the processes of this job on the local node, when their
+ * ompi_proc_t are created on demand (!ompi_add_procs_local) */
+static ompi_vpid_t *ompi_proc_local_peers = NULL;
+static size_t ompi_proc_num_local_peers = 0;
+
 ompi_proc_t* ompi_proc_local_proc = NULL;
 
 static void ompi_proc_construct(ompi_proc_t* proc);
@@ -191,6 +196,38 @@ opal_proc_t *ompi_proc_lookup (const opal_process_name_t proc_name)
     return NULL;
 }
 
+static int ompi_proc_compare_vpid (const void *a, const void *b)
+{
+    ompi_vpid_t vpida = *(const ompi_vpid_t *) a, vpidb = *(const ompi_vpid_t *) b;
+
+    return (vpida > vpidb) - (vpida < vpidb);
+}
+
+/**
+ * Set the locality of a process created on demand
+ *
+ * Only the processes listed as local peers are asked for their
+ * locality, looking it up for a remote process could trigger a
+ * direct modex with its server.
+ */
+static void ompi_proc_set_locality (ompi_proc_t *proc)
+{
+    uint16_t u16, *u16ptr = &u16;
+    int ret;
+
+    if (NULL == ompi_proc_local_peers ||
+        OMPI_CAST_RTE_NAME(&proc->super.proc_name)->jobid != OMPI_PROC_MY_NAME->jobid ||
+        NULL == bsearch (&OMPI_CAST_RTE_NAME(&proc->super.proc_name)->vpid, ompi_proc_local_peers,
+                         ompi_proc_num_local_peers, sizeof (ompi_vpid_t), ompi_proc_compare_vpid)) {
+        return;
+    }
+
+    OPAL_MODEX_RECV_VALUE_OPTIONAL(ret, PMIX_LOCALITY, &proc->super.proc_name, &u16ptr, PMIX_UINT16);
+    if (OPAL_SUCCESS == ret) {
+        proc->super.proc_flags = u16;
+    }
+}
+
 static ompi_proc_t *ompi_proc_for_name_nolock (const opal_process_name_t proc_name)
 {
     ompi_proc_t *proc = NULL;
@@ -209,6 +246,9 @@ static ompi_proc_t *ompi_proc_for_name_nolock (const opal_process_name_t proc_na
         goto exit;
     }
 
+    /* the locality is needed by the btls, set it before anyone can see the proc */
+    ompi_proc_set_locality (proc);
+
     /* finish filling in the important proc data fields */
     ret = ompi_proc_complete_init_single (proc);
     if (OPAL_UNLIKELY(OMPI_SUCCESS != ret)) {
@@ -318,7 +358,23 @@ int ompi_proc_complete_init(void)
         char **peers = opal_argv_split(val, ',');
         int i;
         free(val);
-        for (i=0; NULL != peers[i]; i++) {
+        if (!ompi_add_procs_local) {
+            /* only remember who is local, the procs are created on first use */
+            ompi_proc_local_peers = (ompi_vpid_t *) malloc (opal_argv_count (peers) * sizeof (ompi_vpid_t));
+            if (NULL == ompi_proc_local_peers) {
+                opal_argv_free(peers);
+                opal_mutex_unlock (&ompi_proc_lock);
+                return OMPI_ERR_OUT_OF_RESOURCE;
+            }
+            for (i=0; NULL != peers[i]; i++) {
+                ompi_proc_local_peers[ompi_proc_num_local_peers++] = strtoul(peers[i], NULL, 10);
+            }
+            qsort (ompi_proc_local_peers, ompi_proc_num_local_peers, sizeof (ompi_vpid_t),
+                   ompi_proc_compare_vpid);
+            opal_argv_free(peers);
+            peers = NULL;
+        }
+        for (i=0; NULL != peers && NULL != peers[i]; i++) {
             ompi_vpid_t local_rank = strtoul(peers[i], NULL, 10);
             uint16_t u16, *u16ptr = &u16;
             if (OMPI_PROC_MY_NAME->vpid == local_rank) {
@@ -404,6 +460,10 @@ int ompi_proc_finalize (void)
     while ((ompi_proc_t *)opal_list_get_end(&ompi_proc_list) != (proc = (ompi_proc_t *)opal_list_get_first(&ompi_proc_list))) {
         OBJ_RELEASE(proc);
     }
+    free (ompi_proc_local_peers);
+    ompi_proc_local_peers = NULL;
+    ompi_proc_num_local_peers = 0;
+
     /* now destruct the list and thread lock */
     OBJ_DESTRUCT(&ompi_proc_list);
     OBJ_DESTRUCT(&ompi_proc_lock);
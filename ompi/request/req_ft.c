@@ -59,6 +59,7 @@ bool ompi_request_is_failed_fn(ompi_request_t *req)
         break;
     case OMPI_REQUEST_COLL:
     case OMPI_REQUEST_COMM:
+    case OMPI_REQUEST_PART:
         /* Supported by bubbling up errors from REQUEST_PML subrequests
          * thus this type of requests never need to be interrupted */
         return false;
@@ -55,6 +55,8 @@ OMPI_DECLSPEC extern opal_mutex_t ompi_mpi_bootstrap_mutex;
 OMPI_DECLSPEC extern opal_atomic_int32_t ompi_mpi_state;
 /** Has the RTE been initialized? */
 OMPI_DECLSPEC extern volatile bool ompi_rte_initialized;
+/** References on the MPI runtime (MPI_Init and the live sessions) */
+OMPI_DECLSPEC extern opal_atomic_int32_t ompi_instance_count;
 
 /** Do we have multiple threads? */
 OMPI_DECLSPEC extern bool ompi_mpi_thread_multiple;
@@ -205,6 +207,30 @@ int ompi_mpi_init(int argc, char **argv, int requested, int *provided,
  */
 int ompi_mpi_finalize(void);
 
+/**
+ * Bring up the part of the MPI environment shared by the world model
+ * and the sessions
+ *
+ * @param world The runtime is brought up by MPI_Init (IN)
+ *
+ * When called for a session, the modex is skipped and only the local
+ * process is added to the PML. Use ompi_mpi_instance_retain() rather
+ * than calling this directly.
+ */
+int ompi_mpi_init_runtime(int *argc, char ***argv, int requested, int *provided,
+                          bool world);
+
+/**
+ * Complete a runtime brought up by a session so that it can be used
+ * by the world model (modex and PML add_procs for the whole job)
+ */
+int ompi_mpi_init_world_procs(void);
+
+/**
+ * Tear down what ompi_mpi_init_runtime() brought up
+ */
+int ompi_mpi_finalize_runtime(void);
+
 /**
  * Abort the processes of comm
  */
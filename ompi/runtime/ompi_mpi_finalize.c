@@ -68,6 +68,7 @@
 #include "ompi/communicator/communicator.h"
 #include "ompi/datatype/ompi_datatype.h"
 #include "ompi/message/message.h"
+#include "ompi/instance/instance.h"
 #include "ompi/op/op.h"
 #include "ompi/file/file.h"
 #include "ompi/info/info.h"
@@ -78,6 +79,7 @@
 #include "ompi/mca/pml/base/base.h"
 #include "ompi/mca/bml/base/base.h"
 #include "ompi/mca/osc/base/base.h"
+#include "ompi/mca/part/base/base.h"
 #include "ompi/mca/coll/base/coll_base_functions.h"
 #include "ompi/mca/coll/base/base.h"
 #include "ompi/runtime/ompi_rte.h"
@@ -103,13 +105,6 @@ static void fence_cbfunc(pmix_status_t status, void *cbdata)
 int ompi_mpi_finalize(void)
 {
     int ret = MPI_SUCCESS;
-    opal_list_item_t *item;
-    ompi_proc_t** procs;
-    size_t nprocs;
-    volatile bool active;
-    uint32_t key;
-    ompi_datatype_t * datatype;
-    pmix_status_t rc;
 
     ompi_hook_base_mpi_finalize_top();
 
@@ -200,6 +195,38 @@ int ompi_mpi_finalize(void)
      */
     (void)mca_pml_base_bsend_detach(NULL, NULL);
 
+    /* Drop the reference of the world model on the MPI runtime. It is
+       torn down here unless a session is still alive. */
+    if (OMPI_SUCCESS != (ret = ompi_mpi_instance_release())) {
+        goto done;
+    }
+
+    /* All done */
+
+  done:
+    opal_atomic_wmb();
+    opal_atomic_swap_32(&ompi_mpi_state, OMPI_MPI_STATE_FINALIZE_COMPLETED);
+
+    ompi_hook_base_mpi_finalize_bottom();
+
+    return ret;
+}
+
+int ompi_mpi_finalize_runtime(void)
+{
+    int ret = MPI_SUCCESS;
+    opal_list_item_t *item;
+    ompi_proc_t** procs;
+    size_t nprocs;
+    volatile bool active;
+    uint32_t key;
+    ompi_datatype_t * datatype;
+    pmix_status_t rc;
+
+    /* Progress from the threads calling MPI from now on, as the
+       communication layers are about to be torn down */
+    opal_progress_stop_threads();
+
 #if OPAL_ENABLE_PROGRESS_THREADS == 0
     opal_progress_set_event_flag(OPAL_EVLOOP_ONCE | OPAL_EVLOOP_NONBLOCK);
 #endif
@@ -339,6 +366,12 @@ int ompi_mpi_finalize(void)
         goto done;
     }
 
+    /* partitioned requests are built on top of the pml */
+    if (OMPI_SUCCESS != (ret = mca_base_framework_close(&ompi_part_base_framework))) {
+        OMPI_ERROR_LOG(ret);
+        goto done;
+    }
+
     /* free communicator resources. this MUST come before finalizing the PML
      * as this will call into the pml */
     if (OMPI_SUCCESS != (ret = ompi_comm_finalize())) {
@@ -509,10 +542,5 @@ int ompi_mpi_finalize(void)
     /* All done */
 
   done:
-    opal_atomic_wmb();
-    opal_atomic_swap_32(&ompi_mpi_state, OMPI_MPI_STATE_FINALIZE_COMPLETED);
-
-    ompi_hook_base_mpi_finalize_bottom();
-
     return ret;
 }
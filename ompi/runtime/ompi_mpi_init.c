@@ -78,6 +78,7 @@
 #include "ompi/interlib/interlib.h"
 #include "ompi/request/request.h"
 #include "ompi/message/message.h"
+#include "ompi/instance/instance.h"
 #include "ompi/op/op.h"
 #include "ompi/mca/op/op.h"
 #include "ompi/mca/op/base/base.h"
@@ -88,6 +89,7 @@
 #include "ompi/mca/pml/base/base.h"
 #include "ompi/mca/bml/base/base.h"
 #include "ompi/mca/osc/base/base.h"
+#include "ompi/mca/part/base/base.h"
 #include "ompi/mca/coll/base/base.h"
 #include "ompi/mca/io/io.h"
 #include "ompi/mca/io/base/base.h"
@@ -388,56 +390,138 @@ static void evhandler_reg_callbk(pmix_status_t status,
     OPAL_PMIX_WAKEUP_THREAD(lock);
 }
 
+/* State of the modex of the world model, which may complete in the
+   background until the end of MPI_Init */
+static volatile bool ompi_mpi_modex_active = false;
+static bool ompi_mpi_modex_background = false;
+static bool ompi_mpi_modex_done = false;
 
-int ompi_mpi_init(int argc, char **argv, int requested, int *provided,
-                  bool reinit_ok)
+/* The runtime was started by MPI_Init, which undoes the event users
+   increment of opal_init once dyn_init is done */
+static bool ompi_mpi_event_users_pending = false;
+
+/*
+ * Exchange the connection information of the job. Only the world model
+ * does this: sessions do not synchronize with the rest of the job at
+ * startup and the connection information of a peer is retrieved from
+ * the PMIx server the first time it is needed.
+ */
+static int ompi_mpi_modex(void)
 {
-    int ret;
-    ompi_proc_t** procs;
+    pmix_info_t info[1];
+    pmix_status_t rc;
+
+    if (ompi_mpi_modex_done) {
+        return OMPI_SUCCESS;
+    }
+    ompi_mpi_modex_done = true;
+
+    if (ompi_singleton) {
+        return OMPI_SUCCESS;
+    }
+
+    if (opal_pmix_base_async_modex) {
+        /* if we are doing an async modex, but we are collecting all
+         * data, then execute the non-blocking modex in the background.
+         * All calls to modex_recv will be cached until the background
+         * modex completes. If collect_all_data is false, then we skip
+         * the fence completely and retrieve data on-demand from the
+         * source node.
+         */
+        if (opal_pmix_collect_all_data) {
+            /* execute the fence_nb in the background to collect
+             * the data */
+            ompi_mpi_modex_background = true;
+            ompi_mpi_modex_active = true;
+            OPAL_POST_OBJECT(&ompi_mpi_modex_active);
+            PMIX_INFO_LOAD(&info[0], PMIX_COLLECT_DATA, &opal_pmix_collect_all_data, PMIX_BOOL);
+            if( PMIX_SUCCESS != (rc = PMIx_Fence_nb(NULL, 0, NULL, 0,
+                                                    fence_release,
+                                                    (void*)&ompi_mpi_modex_active))) {
+                return opal_pmix_convert_status(rc);
+            }
+        }
+    } else {
+        /* we want to do the modex - we block at this point, but we must
+         * do so in a manner that allows us to call opal_progress so our
+         * event library can be cycled as we have tied PMIx to that
+         * event base */
+        ompi_mpi_modex_active = true;
+        OPAL_POST_OBJECT(&ompi_mpi_modex_active);
+        PMIX_INFO_LOAD(&info[0], PMIX_COLLECT_DATA, &opal_pmix_collect_all_data, PMIX_BOOL);
+        rc = PMIx_Fence_nb(NULL, 0, info, 1, fence_release, (void*)&ompi_mpi_modex_active);
+        if( PMIX_SUCCESS != rc) {
+            return opal_pmix_convert_status(rc);
+        }
+        /* cannot just wait on thread as we need to call opal_progress */
+        OMPI_LAZY_WAIT_FOR_COMPLETION(ompi_mpi_modex_active);
+    }
+
+    return OMPI_SUCCESS;
+}
+
+/*
+ * Add the processes of the job to the PML. The world model adds all the
+ * processes allocated so far. A session only adds itself and lets the
+ * PML create the endpoint of a peer on the first message to it, unless
+ * the PML needs to know the whole job upfront.
+ */
+static int ompi_mpi_add_procs(bool world, char **error)
+{
+    ompi_proc_t **procs;
     size_t nprocs;
+    int ret;
+
+    /* some btls/mtls require we call add_procs with all procs in the job.
+     * since the btls/mtls have no visibility here it is up to the pml to
+     * convey this requirement */
+    if (mca_pml_base_requires_world ()) {
+        if (NULL == (procs = ompi_proc_world (&nprocs))) {
+            *error = "ompi_proc_world () failed";
+            return OMPI_ERR_OUT_OF_RESOURCE;
+        }
+    } else if (world) {
+        /* add all allocated ompi_proc_t's to PML (below the add_procs limit this
+         * behaves identically to ompi_proc_world ()) */
+        if (NULL == (procs = ompi_proc_get_allocated (&nprocs))) {
+            *error = "ompi_proc_get_allocated () failed";
+            return OMPI_ERR_OUT_OF_RESOURCE;
+        }
+    } else {
+        if (NULL == (procs = (ompi_proc_t **) malloc (sizeof (ompi_proc_t *)))) {
+            *error = "ompi_proc_local () failed";
+            return OMPI_ERR_OUT_OF_RESOURCE;
+        }
+        procs[0] = ompi_proc_local ();
+        nprocs = 1;
+    }
+    ret = MCA_PML_CALL(add_procs(procs, nprocs));
+    free(procs);
+    /* If we got "unreachable", then print a specific error message.
+       Otherwise, if we got some other failure, fall through to print
+       a generic message. */
+    if (OMPI_ERR_UNREACH == ret) {
+        opal_show_help("help-mpi-runtime.txt",
+                       "mpi_init:startup:pml-add-procs-fail", true);
+        *error = NULL;
+    } else if (OMPI_SUCCESS != ret) {
+        *error = "PML add procs failed";
+    }
+
+    return ret;
+}
+
+int ompi_mpi_init_runtime(int *argc, char ***argv, int requested, int *provided,
+                          bool world)
+{
+    int ret;
     char *error = NULL;
-    volatile bool active;
-    bool background_fence = false;
     pmix_info_t info[2];
     pmix_status_t codes[1] = { PMIX_ERR_PROC_ABORTED };
     pmix_status_t rc;
-    OMPI_TIMING_INIT(64);
     opal_pmix_lock_t mylock;
     opal_process_name_t pname;
 
-    ompi_hook_base_mpi_init_top(argc, argv, requested, provided);
-
-    /* Ensure that we were not already initialized or finalized. */
-    int32_t expected = OMPI_MPI_STATE_NOT_INITIALIZED;
-    int32_t desired  = OMPI_MPI_STATE_INIT_STARTED;
-    opal_atomic_wmb();
-    if (!opal_atomic_compare_exchange_strong_32(&ompi_mpi_state, &expected,
-                                                desired)) {
-        // If we failed to atomically transition ompi_mpi_state from
-        // NOT_INITIALIZED to INIT_STARTED, then someone else already
-        // did that, and we should return.
-        if (expected >= OMPI_MPI_STATE_FINALIZE_STARTED) {
-            opal_show_help("help-mpi-runtime.txt",
-                           "mpi_init: already finalized", true);
-            return MPI_ERR_OTHER;
-        } else if (expected >= OMPI_MPI_STATE_INIT_STARTED) {
-            // In some cases (e.g., oshmem_shmem_init()), we may call
-            // ompi_mpi_init() multiple times.  In such cases, just
-            // silently return successfully once the initializing
-            // thread has completed.
-            if (reinit_ok) {
-                while (ompi_mpi_state < OMPI_MPI_STATE_INIT_COMPLETED) {
-                    usleep(1);
-                }
-                return MPI_SUCCESS;
-            }
-
-            opal_show_help("help-mpi-runtime.txt",
-                           "mpi_init: invoked multiple times", true);
-            return MPI_ERR_OTHER;
-        }
-    }
-
     /* Figure out the final MPI thread levels.  If we were not
        compiled for support for MPI threads, then don't allow
        MPI_THREAD_MULTIPLE.  Set this stuff up here early in the
@@ -448,11 +532,10 @@ int ompi_mpi_init(int argc, char **argv, int requested, int *provided,
 
     /* Setup enough to check get/set MCA params */
     memset(&opal_process_info, 0, sizeof(opal_process_info));
-    if (OPAL_SUCCESS != (ret = opal_init_util(&argc, &argv))) {
+    if (OPAL_SUCCESS != (ret = opal_init_util(argc, argv))) {
         error = "ompi_mpi_init: opal_init_util failed";
         goto error;
     }
-    OMPI_TIMING_IMPORT_OPAL("opal_init_util");
 
     /* If thread support was enabled, then setup OPAL to allow for them. This must be done
      * early to prevent a race condition that can occur with orte_init(). */
@@ -544,19 +627,15 @@ int ompi_mpi_init(int argc, char **argv, int requested, int *provided,
         goto error;
     }
 
-    ompi_hook_base_mpi_init_top_post_opal(argc, argv, requested, provided);
-
-
-    OMPI_TIMING_NEXT("initialization");
+    if (world) {
+        ompi_hook_base_mpi_init_top_post_opal(*argc, *argv, requested, provided);
+    }
 
     /* Setup RTE */
-    if (OMPI_SUCCESS != (ret = ompi_rte_init(&argc, &argv))) {
+    if (OMPI_SUCCESS != (ret = ompi_rte_init(argc, argv))) {
         error = "ompi_mpi_init: ompi_rte_init failed";
         goto error;
     }
-    OMPI_TIMING_NEXT("rte_init");
-    OMPI_TIMING_IMPORT_OPAL("orte_ess_base_app_setup");
-    OMPI_TIMING_IMPORT_OPAL("rte_init");
 
     ompi_rte_initialized = true;
 
@@ -655,6 +734,11 @@ int ompi_mpi_init(int argc, char **argv, int requested, int *provided,
         goto error;
     }
 
+    if (OMPI_SUCCESS != (ret = mca_base_framework_open(&ompi_part_base_framework, 0))) {
+        error = "mca_part_base_open() failed";
+        goto error;
+    }
+
     /* In order to reduce the common case for MPI apps (where they
        don't use MPI-2 IO or MPI-1 topology functions), the io and
        topo frameworks are initialized lazily, at the first use of
@@ -670,9 +754,6 @@ int ompi_mpi_init(int argc, char **argv, int requested, int *provided,
         goto error;
     }
 
-    OMPI_TIMING_IMPORT_OPAL("orte_init");
-    OMPI_TIMING_NEXT("rte_init-commit");
-
     /* exchange connection info - this function may also act as a barrier
      * if data exchange is required. The modex occurs solely across procs
      * in our job. If a barrier is required, the "modex" function will
@@ -683,69 +764,12 @@ int ompi_mpi_init(int argc, char **argv, int requested, int *provided,
         error = "PMIx_Commit()";
         goto error;
     }
-    OMPI_TIMING_NEXT("commit");
-#if (OPAL_ENABLE_TIMING)
-    if (OMPI_TIMING_ENABLED && !opal_pmix_base_async_modex &&
-            opal_pmix_collect_all_data && !ompi_singleton) {
-        if (PMIX_SUCCESS != (rc = PMIx_Fence(NULL, 0, NULL, 0))) {
-            ret - opal_pmix_convert_status(rc);
-            error = "timing: pmix-barrier-1 failed";
-            goto error;
-        }
-        OMPI_TIMING_NEXT("pmix-barrier-1");
-        if (PMIX_SUCCESS != (rc = PMIx_Fence(NULL, 0, NULL, 0))) {
-            error = "timing: pmix-barrier-2 failed";
-            goto error;
-        }
-        OMPI_TIMING_NEXT("pmix-barrier-2");
-    }
-#endif
 
-    if (!ompi_singleton) {
-        if (opal_pmix_base_async_modex) {
-            /* if we are doing an async modex, but we are collecting all
-             * data, then execute the non-blocking modex in the background.
-             * All calls to modex_recv will be cached until the background
-             * modex completes. If collect_all_data is false, then we skip
-             * the fence completely and retrieve data on-demand from the
-             * source node.
-             */
-            if (opal_pmix_collect_all_data) {
-                /* execute the fence_nb in the background to collect
-                 * the data */
-                background_fence = true;
-                active = true;
-                OPAL_POST_OBJECT(&active);
-                PMIX_INFO_LOAD(&info[0], PMIX_COLLECT_DATA, &opal_pmix_collect_all_data, PMIX_BOOL);
-                if( PMIX_SUCCESS != (rc = PMIx_Fence_nb(NULL, 0, NULL, 0,
-                                                        fence_release,
-                                                        (void*)&active))) {
-                    ret = opal_pmix_convert_status(rc);
-                    error = "PMIx_Fence_nb() failed";
-                    goto error;
-                }
-            }
-        } else {
-            /* we want to do the modex - we block at this point, but we must
-             * do so in a manner that allows us to call opal_progress so our
-             * event library can be cycled as we have tied PMIx to that
-             * event base */
-            active = true;
-            OPAL_POST_OBJECT(&active);
-            PMIX_INFO_LOAD(&info[0], PMIX_COLLECT_DATA, &opal_pmix_collect_all_data, PMIX_BOOL);
-            rc = PMIx_Fence_nb(NULL, 0, info, 1, fence_release, (void*)&active);
-            if( PMIX_SUCCESS != rc) {
-                ret = opal_pmix_convert_status(rc);
-                error = "PMIx_Fence() failed";
-                goto error;
-            }
-            /* cannot just wait on thread as we need to call opal_progress */
-            OMPI_LAZY_WAIT_FOR_COMPLETION(active);
-        }
+    if (world && OMPI_SUCCESS != (ret = ompi_mpi_modex())) {
+        error = "PMIx_Fence_nb() failed";
+        goto error;
     }
 
-    OMPI_TIMING_NEXT("modex");
-
     /* select buffered send allocator component to be used */
     if( OMPI_SUCCESS !=
         (ret = mca_pml_base_bsend_init(ompi_mpi_thread_multiple))) {
@@ -767,6 +791,13 @@ int ompi_mpi_init(int argc, char **argv, int requested, int *provided,
         goto error;
     }
 
+    if (OMPI_SUCCESS !=
+        (ret = mca_part_base_select(OPAL_ENABLE_PROGRESS_THREADS,
+                                    ompi_mpi_thread_multiple))) {
+        error = "mca_part_base_select() failed";
+        goto error;
+    }
+
     /* io and topo components are not selected here -- see comment
        above about the io and topo frameworks being loaded lazily */
 
@@ -851,39 +882,201 @@ int ompi_mpi_init(int argc, char **argv, int requested, int *provided,
         goto error;
     }
 
-    /* some btls/mtls require we call add_procs with all procs in the job.
-     * since the btls/mtls have no visibility here it is up to the pml to
-     * convey this requirement */
-    if (mca_pml_base_requires_world ()) {
-        if (NULL == (procs = ompi_proc_world (&nprocs))) {
-            error = "ompi_proc_world () failed";
-            goto error;
-        }
+    if (OMPI_SUCCESS != (ret = ompi_mpi_add_procs(world, &error))) {
+        goto error;
+    }
+
+    /* MPI_COMM_WORLD is also the communicator used to allocate the
+       context ids of the communicators created from a session */
+    MCA_PML_CALL(add_comm(&ompi_mpi_comm_world.comm));
+    MCA_PML_CALL(add_comm(&ompi_mpi_comm_self.comm));
+
+#if OPAL_ENABLE_PROGRESS_THREADS == 0
+    /* Start setting up the event engine for MPI operations.  Don't
+       block in the event library, so that communications don't take
+       forever between procs in the dynamic code.  This will increase
+       CPU utilization for the remainder of MPI_INIT when we are
+       blocking on RTE-level events, but may greatly reduce non-TCP
+       latency. */
+    opal_progress_set_event_flag(OPAL_EVLOOP_NONBLOCK);
+#endif
+
+    /* Setup the dynamic process management (DPM) subsystem */
+    if (OMPI_SUCCESS != (ret = ompi_dpm_init())) {
+        error = "ompi_dpm_init() failed";
+        goto error;
+    }
+
+    /* Determine the overall threadlevel support of all processes
+       in MPI_COMM_WORLD. This has to be done before calling
+       coll_base_comm_select, since some of the collective components
+       e.g. hierarch, might create subcommunicators. The threadlevel
+       requested by all processes is required in order to know
+       which cid allocation algorithm can be used. */
+    if (OMPI_SUCCESS != ( ret = ompi_comm_cid_init ())) {
+        error = "ompi_mpi_init: ompi_comm_cid_init failed";
+        goto error;
+    }
+
+    /* Init coll for the comms. This has to be after dpm_base_select,
+       (since dpm.mark_dyncomm is not set in the communicator creation
+       function else), but before dpm.dyncom_init, since this function
+       might require collective for the CID allocation. */
+    if (OMPI_SUCCESS !=
+        (ret = mca_coll_base_comm_select(MPI_COMM_WORLD))) {
+        error = "mca_coll_base_comm_select(MPI_COMM_WORLD) failed";
+        goto error;
+    }
+
+    if (OMPI_SUCCESS !=
+        (ret = mca_coll_base_comm_select(MPI_COMM_SELF))) {
+        error = "mca_coll_base_comm_select(MPI_COMM_SELF) failed";
+        goto error;
+    }
+
+    /* Undo OPAL calling opal_progress_event_users_increment() during
+       opal_init, to get better latency when not using TCP.  MPI_Init
+       does this after dyn_init, see ompi_mpi_init(). */
+    if (world) {
+        ompi_mpi_event_users_pending = true;
     } else {
-        /* add all allocated ompi_proc_t's to PML (below the add_procs limit this
-         * behaves identically to ompi_proc_world ()) */
-        if (NULL == (procs = ompi_proc_get_allocated (&nprocs))) {
-            error = "ompi_proc_get_allocated () failed";
-            goto error;
-        }
+        opal_progress_event_users_decrement();
     }
-    ret = MCA_PML_CALL(add_procs(procs, nprocs));
-    free(procs);
-    /* If we got "unreachable", then print a specific error message.
-       Otherwise, if we got some other failure, fall through to print
-       a generic message. */
-    if (OMPI_ERR_UNREACH == ret) {
-        opal_show_help("help-mpi-runtime.txt",
-                       "mpi_init:startup:pml-add-procs-fail", true);
-        error = NULL;
+
+    /* see if yield_when_idle was specified - if so, use it */
+    opal_progress_set_yield_when_idle(ompi_mpi_yield_when_idle);
+
+    /* negative value means use default - just don't do anything */
+    if (ompi_mpi_event_tick_rate >= 0) {
+        opal_progress_set_event_poll_rate(ompi_mpi_event_tick_rate);
+    }
+
+    /* the communication layers are ready, hand their progress over to
+       the dedicated progress threads if requested */
+    if (OPAL_SUCCESS != (ret = opal_progress_start_threads())) {
+        error = "opal_progress_start_threads() failed";
         goto error;
-    } else if (OMPI_SUCCESS != ret) {
-        error = "PML add procs failed";
+    }
+
+    /* Initialize the registered datarep list to be empty */
+    OBJ_CONSTRUCT(&ompi_registered_datareps, opal_list_t);
+
+    /* Initialize the arrays used to store the F90 types returned by the
+     *  MPI_Type_create_f90_XXX functions.
+     */
+    OBJ_CONSTRUCT( &ompi_mpi_f90_integer_hashtable, opal_hash_table_t);
+    opal_hash_table_init(&ompi_mpi_f90_integer_hashtable, 16 /* why not? */);
+
+    OBJ_CONSTRUCT( &ompi_mpi_f90_real_hashtable, opal_hash_table_t);
+    opal_hash_table_init(&ompi_mpi_f90_real_hashtable, FLT_MAX_10_EXP);
+
+    OBJ_CONSTRUCT( &ompi_mpi_f90_complex_hashtable, opal_hash_table_t);
+    opal_hash_table_init(&ompi_mpi_f90_complex_hashtable, FLT_MAX_10_EXP);
+
+    return OMPI_SUCCESS;
+
+ error:
+    /* Only print a message if one was not already printed */
+    if (NULL != error && OMPI_ERR_SILENT != ret) {
+        const char *err_msg = opal_strerror(ret);
+        const char *func = world ? "MPI_INIT" : "MPI_SESSION_INIT";
+        opal_show_help("help-mpi-runtime.txt",
+                       "mpi_init:startup:internal-failure", true,
+                       func, func, error, err_msg, ret);
+    }
+    return ret;
+}
+
+int ompi_mpi_init_world_procs(void)
+{
+    char *error = NULL;
+    int ret;
+
+    if (OMPI_SUCCESS != (ret = ompi_mpi_modex())) {
+        error = "PMIx_Fence_nb() failed";
+    } else {
+        ret = ompi_mpi_add_procs(true, &error);
+    }
+
+    if (OMPI_SUCCESS != ret && NULL != error && OMPI_ERR_SILENT != ret) {
+        opal_show_help("help-mpi-runtime.txt",
+                       "mpi_init:startup:internal-failure", true,
+                       "MPI_INIT", "MPI_INIT", error, opal_strerror(ret), ret);
+    }
+    return ret;
+}
+
+int ompi_mpi_init(int argc, char **argv, int requested, int *provided,
+                  bool reinit_ok)
+{
+    int ret;
+    char *error = NULL;
+    volatile bool active;
+    pmix_info_t info[1];
+    pmix_status_t rc;
+    OMPI_TIMING_INIT(64);
+
+    ompi_hook_base_mpi_init_top(argc, argv, requested, provided);
+
+    /* Ensure that we were not already initialized or finalized. */
+    int32_t expected = OMPI_MPI_STATE_NOT_INITIALIZED;
+    int32_t desired  = OMPI_MPI_STATE_INIT_STARTED;
+    opal_atomic_wmb();
+    if (!opal_atomic_compare_exchange_strong_32(&ompi_mpi_state, &expected,
+                                                desired)) {
+        // If we failed to atomically transition ompi_mpi_state from
+        // NOT_INITIALIZED to INIT_STARTED, then someone else already
+        // did that, and we should return.
+        if (expected >= OMPI_MPI_STATE_FINALIZE_STARTED) {
+            opal_show_help("help-mpi-runtime.txt",
+                           "mpi_init: already finalized", true);
+            return MPI_ERR_OTHER;
+        } else if (expected >= OMPI_MPI_STATE_INIT_STARTED) {
+            // In some cases (e.g., oshmem_shmem_init()), we may call
+            // ompi_mpi_init() multiple times.  In such cases, just
+            // silently return successfully once the initializing
+            // thread has completed.
+            if (reinit_ok) {
+                while (ompi_mpi_state < OMPI_MPI_STATE_INIT_COMPLETED) {
+                    usleep(1);
+                }
+                return MPI_SUCCESS;
+            }
+
+            opal_show_help("help-mpi-runtime.txt",
+                           "mpi_init: invoked multiple times", true);
+            return MPI_ERR_OTHER;
+        }
+    }
+
+    /* Bring up the MPI runtime, or join the one already brought up by
+       a session */
+    if (OMPI_SUCCESS != (ret = ompi_mpi_instance_retain(&argc, &argv, requested,
+                                                        provided, true))) {
+        /* the error has already been reported */
         goto error;
     }
+    OMPI_TIMING_IMPORT_OPAL("opal_init_util");
+    OMPI_TIMING_IMPORT_OPAL("orte_ess_base_app_setup");
+    OMPI_TIMING_IMPORT_OPAL("rte_init");
+    OMPI_TIMING_NEXT("runtime");
 
-    MCA_PML_CALL(add_comm(&ompi_mpi_comm_world.comm));
-    MCA_PML_CALL(add_comm(&ompi_mpi_comm_self.comm));
+#if (OPAL_ENABLE_TIMING)
+    if (OMPI_TIMING_ENABLED && !opal_pmix_base_async_modex &&
+            opal_pmix_collect_all_data && !ompi_singleton) {
+        if (PMIX_SUCCESS != (rc = PMIx_Fence(NULL, 0, NULL, 0))) {
+            ret = opal_pmix_convert_status(rc);
+            error = "timing: pmix-barrier-1 failed";
+            goto error;
+        }
+        OMPI_TIMING_NEXT("pmix-barrier-1");
+        if (PMIX_SUCCESS != (rc = PMIx_Fence(NULL, 0, NULL, 0))) {
+            error = "timing: pmix-barrier-2 failed";
+            goto error;
+        }
+        OMPI_TIMING_NEXT("pmix-barrier-2");
+    }
+#endif
 
 #if OPAL_ENABLE_FT_MPI
     /* initialize the fault tolerant infrastructure (revoke, detector,
@@ -911,7 +1104,7 @@ int ompi_mpi_init(int argc, char **argv, int requested, int *provided,
      */
     if (ompi_mpi_show_mca_params) {
         ompi_show_all_mca_params(ompi_mpi_comm_world.comm.c_my_rank,
-                                 nprocs,
+                                 ompi_process_info.num_procs,
                                  ompi_process_info.nodename);
     }
 
@@ -925,8 +1118,8 @@ int ompi_mpi_init(int argc, char **argv, int requested, int *provided,
         /* if we executed the above fence in the background, then
          * we have to wait here for it to complete. However, there
          * is no reason to do two barriers! */
-        if (background_fence) {
-            OMPI_LAZY_WAIT_FOR_COMPLETION(active);
+        if (ompi_mpi_modex_background) {
+            OMPI_LAZY_WAIT_FOR_COMPLETION(ompi_mpi_modex_active);
         } else if (!ompi_async_mpi_init) {
             /* wait for everyone to reach this point - this is a hard
              * barrier requirement at this time, though we hope to relax
@@ -949,16 +1142,6 @@ int ompi_mpi_init(int argc, char **argv, int requested, int *provided,
        time if so, then start the clock again */
     OMPI_TIMING_NEXT("barrier");
 
-#if OPAL_ENABLE_PROGRESS_THREADS == 0
-    /* Start setting up the event engine for MPI operations.  Don't
-       block in the event library, so that communications don't take
-       forever between procs in the dynamic code.  This will increase
-       CPU utilization for the remainder of MPI_INIT when we are
-       blocking on RTE-level events, but may greatly reduce non-TCP
-       latency. */
-    opal_progress_set_event_flag(OPAL_EVLOOP_NONBLOCK);
-#endif
-
     /* wire up the mpi interface, if requested.  Do this after the
        non-block switch for non-TCP performance.  Do before the
        polling change as anyone with a complex wire-up is going to be
@@ -968,39 +1151,6 @@ int ompi_mpi_init(int argc, char **argv, int requested, int *provided,
         goto error;
     }
 
-    /* Setup the dynamic process management (DPM) subsystem */
-    if (OMPI_SUCCESS != (ret = ompi_dpm_init())) {
-        error = "ompi_dpm_init() failed";
-        goto error;
-    }
-
-    /* Determine the overall threadlevel support of all processes
-       in MPI_COMM_WORLD. This has to be done before calling
-       coll_base_comm_select, since some of the collective components
-       e.g. hierarch, might create subcommunicators. The threadlevel
-       requested by all processes is required in order to know
-       which cid allocation algorithm can be used. */
-    if (OMPI_SUCCESS != ( ret = ompi_comm_cid_init ())) {
-        error = "ompi_mpi_init: ompi_comm_cid_init failed";
-        goto error;
-    }
-
-    /* Init coll for the comms. This has to be after dpm_base_select,
-       (since dpm.mark_dyncomm is not set in the communicator creation
-       function else), but before dpm.dyncom_init, since this function
-       might require collective for the CID allocation. */
-    if (OMPI_SUCCESS !=
-        (ret = mca_coll_base_comm_select(MPI_COMM_WORLD))) {
-        error = "mca_coll_base_comm_select(MPI_COMM_WORLD) failed";
-        goto error;
-    }
-
-    if (OMPI_SUCCESS !=
-        (ret = mca_coll_base_comm_select(MPI_COMM_SELF))) {
-        error = "mca_coll_base_comm_select(MPI_COMM_SELF) failed";
-        goto error;
-    }
-
     /* Check whether we have been spawned or not.  We introduce that
        at the very end, since we need collectives, datatypes, ptls
        etc. up and running here.... */
@@ -1014,14 +1164,9 @@ int ompi_mpi_init(int argc, char **argv, int requested, int *provided,
        this *after* dyn_init, as dyn init uses lots of RTE
        communication and we don't want to hinder the performance of
        that code. */
-    opal_progress_event_users_decrement();
-
-    /* see if yield_when_idle was specified - if so, use it */
-    opal_progress_set_yield_when_idle(ompi_mpi_yield_when_idle);
-
-    /* negative value means use default - just don't do anything */
-    if (ompi_mpi_event_tick_rate >= 0) {
-        opal_progress_set_event_poll_rate(ompi_mpi_event_tick_rate);
+    if (ompi_mpi_event_users_pending) {
+        ompi_mpi_event_users_pending = false;
+        opal_progress_event_users_decrement();
     }
 
     /* At this point, we are fully configured and in MPI mode.  Any
@@ -1057,21 +1202,6 @@ int ompi_mpi_init(int argc, char **argv, int requested, int *provided,
         return ret;
     }
 
-    /* Initialize the registered datarep list to be empty */
-    OBJ_CONSTRUCT(&ompi_registered_datareps, opal_list_t);
-
-    /* Initialize the arrays used to store the F90 types returned by the
-     *  MPI_Type_create_f90_XXX functions.
-     */
-    OBJ_CONSTRUCT( &ompi_mpi_f90_integer_hashtable, opal_hash_table_t);
-    opal_hash_table_init(&ompi_mpi_f90_integer_hashtable, 16 /* why not? */);
-
-    OBJ_CONSTRUCT( &ompi_mpi_f90_real_hashtable, opal_hash_table_t);
-    opal_hash_table_init(&ompi_mpi_f90_real_hashtable, FLT_MAX_10_EXP);
-
-    OBJ_CONSTRUCT( &ompi_mpi_f90_complex_hashtable, opal_hash_table_t);
-    opal_hash_table_init(&ompi_mpi_f90_complex_hashtable, FLT_MAX_10_EXP);
-
     /* All done.  Wasn't that simple? */
     opal_atomic_wmb();
     opal_atomic_swap_32(&ompi_mpi_state, OMPI_MPI_STATE_INIT_COMPLETED);
@@ -37,7 +37,9 @@
 #include "ompi/runtime/mpiruntime.h"
 #include "ompi/runtime/params.h"
 #include "ompi/runtime/ompi_rte.h"
+#include "ompi/proc/proc.h"
 
+#include "opal/mca/base/mca_base_pvar.h"
 #include "opal/mca/pmix/base/base.h"
 #include "opal/util/argv.h"
 #include "opal/util/output.h"
@@ -77,6 +79,7 @@ bool ompi_async_mpi_finalize = false;
 
 #define OMPI_ADD_PROCS_CUTOFF_DEFAULT 0
 uint32_t ompi_add_procs_cutoff = OMPI_ADD_PROCS_CUTOFF_DEFAULT;
+bool ompi_add_procs_local = true;
 bool ompi_mpi_dynamics_enabled = true;
 
 bool ompi_mpi_compat_mpi3 = false;
@@ -90,6 +93,16 @@ static bool show_enviro_mca_params = false;
 static bool show_override_mca_params = false;
 static bool ompi_mpi_oversubscribe = false;
 
+static int ompi_mpi_proc_pvar_read(const struct mca_base_pvar_t *pvar, void *value, void *obj)
+{
+    unsigned long nprocs = (unsigned long) opal_list_get_size(&ompi_proc_list);
+
+    /* the ctx selects between the number of procs and their footprint */
+    *(unsigned long *) value = (NULL == pvar->ctx) ? nprocs : nprocs * sizeof(ompi_proc_t);
+
+    return OMPI_SUCCESS;
+}
+
 #if OPAL_ENABLE_FT_MPI
 int ompi_ftmpi_output_handle = 0;
 bool ompi_ftmpi_enabled = false;
@@ -329,6 +342,29 @@ int ompi_mpi_register_params(void)
                                   0, 0, OPAL_INFO_LVL_3, MCA_BASE_VAR_SCOPE_LOCAL,
                                   &ompi_add_procs_cutoff);
 
+    ompi_add_procs_local = true;
+    (void) mca_base_var_register ("ompi", "mpi", NULL, "add_procs_local",
+                                  "Pre-allocate resources for all the processes on the local node "
+                                  "regardless of mpi_add_procs_cutoff. When false, local processes "
+                                  "are set up on first communication, like remote processes",
+                                  MCA_BASE_VAR_TYPE_BOOL, NULL,
+                                  0, 0, OPAL_INFO_LVL_5, MCA_BASE_VAR_SCOPE_LOCAL,
+                                  &ompi_add_procs_local);
+
+    (void) mca_base_pvar_register ("ompi", "mpi", NULL, "proc_count",
+                                   "Number of peer processes this process holds a structure for",
+                                   OPAL_INFO_LVL_4, MCA_BASE_PVAR_CLASS_LEVEL,
+                                   MCA_BASE_VAR_TYPE_UNSIGNED_LONG, NULL, MCA_BASE_VAR_BIND_NO_OBJECT,
+                                   MCA_BASE_PVAR_FLAG_READONLY | MCA_BASE_PVAR_FLAG_CONTINUOUS,
+                                   ompi_mpi_proc_pvar_read, NULL, NULL, NULL);
+
+    (void) mca_base_pvar_register ("ompi", "mpi", NULL, "proc_memory",
+                                   "Memory (bytes) used by the peer process structures of this process",
+                                   OPAL_INFO_LVL_4, MCA_BASE_PVAR_CLASS_LEVEL,
+                                   MCA_BASE_VAR_TYPE_UNSIGNED_LONG, NULL, MCA_BASE_VAR_BIND_NO_OBJECT,
+                                   MCA_BASE_PVAR_FLAG_READONLY | MCA_BASE_PVAR_FLAG_CONTINUOUS,
+                                   ompi_mpi_proc_pvar_read, NULL, NULL, (void *) &ompi_proc_list);
+
     ompi_mpi_dynamics_enabled = true;
     (void) mca_base_var_register("ompi", "mpi", NULL, "dynamics_enabled",
                                  "Is the MPI dynamic process functionality enabled (e.g., MPI_COMM_SPAWN)?  Default is yes, but certain transports and/or environments may disable it.",
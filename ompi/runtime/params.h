@@ -142,6 +142,12 @@ OMPI_DECLSPEC extern bool ompi_use_sparse_group_storage;
  */
 OMPI_DECLSPEC extern uint32_t ompi_add_procs_cutoff;
 
+/**
+ * Whether resources for the processes on the local node are allocated
+ * at init regardless of ompi_add_procs_cutoff
+ */
+OMPI_DECLSPEC extern bool ompi_add_procs_local;
+
 /**
  * Whether anything in the code base has disabled MPI dynamic process
  * functionality or not
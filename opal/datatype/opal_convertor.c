@@ -605,6 +605,8 @@ int32_t opal_convertor_prepare_for_recv(opal_convertor_t *convertor,
         } else {
             if (convertor->pDesc->flags & OPAL_DATATYPE_FLAG_CONTIGUOUS) {
                 convertor->fAdvance = opal_unpack_homogeneous_contig;
+            } else if (NULL != convertor->pDesc->plan) {
+                convertor->fAdvance = opal_unpack_homogeneous_plan;
             } else {
                 convertor->fAdvance = opal_generic_simple_unpack;
             }
@@ -658,6 +660,8 @@ int32_t opal_convertor_prepare_for_send(opal_convertor_t *convertor,
                 } else {
                     convertor->fAdvance = opal_pack_homogeneous_contig_with_gaps;
                 }
+            } else if (NULL != datatype->plan) {
+                convertor->fAdvance = opal_pack_homogeneous_plan;
             } else {
                 convertor->fAdvance = opal_generic_simple_pack;
             }
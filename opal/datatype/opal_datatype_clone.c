@@ -45,6 +45,7 @@ int32_t opal_datatype_clone(const opal_datatype_t *src_type, opal_datatype_t *de
     dest_type->flags &= (~OPAL_DATATYPE_FLAG_PREDEFINED);
     dest_type->ptypes = NULL;
     dest_type->desc.desc = temp;
+    dest_type->plan = opal_datatype_clone_plan(src_type->plan);
 
     /**
      * Allow duplication of MPI_UB and MPI_LB.
@@ -55,6 +55,7 @@ static void opal_datatype_construct(opal_datatype_t *pData)
 
     pData->ptypes = NULL;
     pData->loops = 0;
+    pData->plan = NULL;
 }
 
 static void opal_datatype_destruct(opal_datatype_t *datatype)
@@ -85,6 +86,11 @@ static void opal_datatype_destruct(opal_datatype_t *datatype)
         datatype->ptypes = NULL;
     }
 
+    if (NULL != datatype->plan) {
+        free(datatype->plan);
+        datatype->plan = NULL;
+    }
+
     /* make sure the name is set to empty */
     datatype->name[0] = '\0';
 }
@@ -589,6 +589,33 @@ OPAL_DECLSPEC int opal_datatype_dump_data_flags(unsigned short usflags, char *pt
 OPAL_DECLSPEC int opal_datatype_dump_data_desc(union dt_elem_desc *pDesc, int nbElems, char *ptr,
                                                size_t length);
 
+/**
+ * A copy plan is the optimized description of a datatype lowered to a flat
+ * list of runs, with all the loops either folded into strided runs or
+ * unrolled. Each run moves count blocks of length bytes, the first one at
+ * disp and the next ones stride bytes apart, and the runs are in the order
+ * of the packed data. Plans are built at commit time for non contiguous
+ * datatypes that need at most opal_ddt_plan_max_runs runs.
+ */
+struct opal_datatype_plan_run_t {
+    ptrdiff_t disp;   /**< displacement of the first block */
+    ptrdiff_t stride; /**< distance between two consecutive blocks */
+    size_t length;    /**< length in bytes of each block */
+    size_t count;     /**< number of blocks */
+};
+typedef struct opal_datatype_plan_run_t opal_datatype_plan_run_t;
+
+struct opal_datatype_plan_t {
+    uint32_t used;                   /**< number of runs */
+    opal_datatype_plan_run_t runs[]; /**< the runs */
+};
+typedef struct opal_datatype_plan_t opal_datatype_plan_t;
+
+int32_t opal_datatype_create_plan(opal_datatype_t *pData);
+opal_datatype_plan_t *opal_datatype_clone_plan(const opal_datatype_plan_t *plan);
+
+extern int opal_ddt_plan_max_runs;
+
 extern bool opal_ddt_position_debug;
 extern bool opal_ddt_copy_debug;
 extern bool opal_ddt_unpack_debug;
@@ -0,0 +1,303 @@
+/* -*- Mode: C; c-basic-offset:4 ; -*- */
+/*
+ * $COPYRIGHT$
+ *
+ * Additional copyrights may follow
+ *
+ * $HEADER$
+ */
+
+#include "opal_config.h"
+
+#include <stddef.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "opal/constants.h"
+#include "opal/datatype/opal_convertor_internal.h"
+#include "opal/datatype/opal_datatype_internal.h"
+#include "opal/datatype/opal_datatype_memcpy.h"
+#include "opal/datatype/opal_datatype_prototypes.h"
+
+/* larger plans are not worth it, the generic functions are as fast */
+int opal_ddt_plan_max_runs = 64;
+
+#define PLAN_SIZE(RUNS) (sizeof(opal_datatype_plan_t) + (RUNS) * sizeof(opal_datatype_plan_run_t))
+
+/*
+ * Append a run to the plan, merging it with the previous one when they
+ * describe contiguous memory or blocks of the same length at the same
+ * distance. Fails if the plan is full.
+ */
+static int32_t opal_datatype_plan_add_run(opal_datatype_plan_t *plan, uint32_t max_runs,
+                                          ptrdiff_t disp, ptrdiff_t stride, size_t length,
+                                          size_t count)
+{
+    opal_datatype_plan_run_t *last = (0 == plan->used) ? NULL : &plan->runs[plan->used - 1];
+
+    if (0 == length || 0 == count) {
+        return OPAL_SUCCESS;
+    }
+    if ((1 == count) || ((ptrdiff_t) length == stride)) {
+        length *= count;
+        count = 1;
+        stride = 0;
+    }
+
+    if (NULL != last && 1 == count && last->length == length) {
+        if (1 == last->count && (last->disp + (ptrdiff_t) last->length) != disp) {
+            last->stride = disp - last->disp;
+            last->count = 2;
+            return OPAL_SUCCESS;
+        }
+        if (1 < last->count && (last->disp + (ptrdiff_t) last->count * last->stride) == disp) {
+            last->count++;
+            return OPAL_SUCCESS;
+        }
+    }
+    if (NULL != last && 1 == count && 1 == last->count
+        && (last->disp + (ptrdiff_t) last->length) == disp) {
+        last->length += length;
+        return OPAL_SUCCESS;
+    }
+
+    if (plan->used == max_runs) {
+        return OPAL_ERR_OUT_OF_RESOURCE;
+    }
+    plan->runs[plan->used].disp = disp;
+    plan->runs[plan->used].stride = stride;
+    plan->runs[plan->used].length = length;
+    plan->runs[plan->used].count = count;
+    plan->used++;
+    return OPAL_SUCCESS;
+}
+
+/*
+ * Lower the elements [0, nb_elems) of a description, shifted by disp,
+ * into the plan. A loop whose body is a single run is folded into a
+ * strided run, any other loop is unrolled.
+ */
+static int32_t opal_datatype_plan_append(opal_datatype_plan_t *plan, uint32_t max_runs,
+                                         const dt_elem_desc_t *pElem, size_t nb_elems,
+                                         ptrdiff_t disp)
+{
+    opal_datatype_plan_t *body;
+    int32_t rc = OPAL_SUCCESS;
+
+    for (size_t i = 0; i < nb_elems; i++) {
+        if (pElem[i].elem.common.flags & OPAL_DATATYPE_FLAG_DATA) {
+            const ddt_elem_desc_t *elem = &pElem[i].elem;
+            size_t blength = elem->blocklen
+                             * opal_datatype_basicDatatypes[elem->common.type]->size;
+
+            rc = opal_datatype_plan_add_run(plan, max_runs, disp + elem->disp, elem->extent,
+                                            blength, elem->count);
+            if (OPAL_SUCCESS != rc) {
+                return rc;
+            }
+            continue;
+        }
+
+        /* a loop: its body is followed by the matching end loop */
+        const ddt_loop_desc_t *loop = &pElem[i].loop;
+
+        body = (opal_datatype_plan_t *) malloc(PLAN_SIZE(max_runs));
+        if (NULL == body) {
+            return OPAL_ERR_OUT_OF_RESOURCE;
+        }
+        body->used = 0;
+        rc = opal_datatype_plan_append(body, max_runs, pElem + i + 1, loop->items - 1, 0);
+        if (OPAL_SUCCESS == rc) {
+            const opal_datatype_plan_run_t *run = &body->runs[0];
+
+            if (1 == body->used && 1 == run->count) {
+                rc = opal_datatype_plan_add_run(plan, max_runs, disp + run->disp, loop->extent,
+                                                run->length, loop->loops);
+            } else if (1 == body->used && (run->stride * (ptrdiff_t) run->count) == loop->extent) {
+                rc = opal_datatype_plan_add_run(plan, max_runs, disp + run->disp, run->stride,
+                                                run->length, run->count * loop->loops);
+            } else {
+                for (uint32_t j = 0; (OPAL_SUCCESS == rc) && (j < loop->loops); j++) {
+                    for (uint32_t k = 0; (OPAL_SUCCESS == rc) && (k < body->used); k++) {
+                        run = &body->runs[k];
+                        rc = opal_datatype_plan_add_run(plan, max_runs,
+                                                        disp + j * loop->extent + run->disp,
+                                                        run->stride, run->length, run->count);
+                    }
+                }
+            }
+        }
+        free(body);
+        if (OPAL_SUCCESS != rc) {
+            return rc;
+        }
+        i += loop->items;
+    }
+    return OPAL_SUCCESS;
+}
+
+/*
+ * Build the copy plan of a committed datatype. Contiguous datatypes
+ * already have their own fast path, and datatypes needing more than
+ * opal_ddt_plan_max_runs runs keep using the generic functions.
+ */
+int32_t opal_datatype_create_plan(opal_datatype_t *pData)
+{
+    opal_datatype_plan_t *plan;
+    uint32_t max_runs;
+
+    pData->plan = NULL;
+    if ((pData->flags & OPAL_DATATYPE_FLAG_CONTIGUOUS) || (0 == pData->opt_desc.used)
+        || (0 >= opal_ddt_plan_max_runs)) {
+        return OPAL_SUCCESS;
+    }
+    max_runs = (uint32_t) opal_ddt_plan_max_runs;
+
+    plan = (opal_datatype_plan_t *) malloc(PLAN_SIZE(max_runs));
+    if (NULL == plan) {
+        return OPAL_ERR_OUT_OF_RESOURCE;
+    }
+    plan->used = 0;
+    if (OPAL_SUCCESS
+        != opal_datatype_plan_append(plan, max_runs, pData->opt_desc.desc,
+                                     pData->opt_desc.used, 0)) {
+        free(plan);
+        return OPAL_SUCCESS;
+    }
+
+    pData->plan = (opal_datatype_plan_t *) realloc(plan, PLAN_SIZE(plan->used));
+    if (NULL == pData->plan) {
+        pData->plan = plan;
+    }
+    return OPAL_SUCCESS;
+}
+
+opal_datatype_plan_t *opal_datatype_clone_plan(const opal_datatype_plan_t *plan)
+{
+    opal_datatype_plan_t *clone;
+
+    if (NULL == plan) {
+        return NULL;
+    }
+    clone = (opal_datatype_plan_t *) malloc(PLAN_SIZE(plan->used));
+    if (NULL != clone) {
+        memcpy(clone, plan, PLAN_SIZE(plan->used));
+    }
+    return clone;
+}
+
+/*
+ * Copy COUNT blocks of LENGTH bytes. The common small block lengths are
+ * spelled out so that the compiler can inline the copies.
+ */
+#define PLAN_COPY_BLOCKS(DST, DST_STEP, SRC, SRC_STEP, LENGTH, COUNT) \
+    do {                                                              \
+        size_t _k;                                                    \
+        switch (LENGTH) {                                             \
+        case 4:                                                       \
+            for (_k = 0; _k < (COUNT); _k++) {                        \
+                memcpy((DST), (SRC), 4);                              \
+                (DST) += (DST_STEP);                                  \
+                (SRC) += (SRC_STEP);                                  \
+            }                                                         \
+            break;                                                    \
+        case 8:                                                       \
+            for (_k = 0; _k < (COUNT); _k++) {                        \
+                memcpy((DST), (SRC), 8);                              \
+                (DST) += (DST_STEP);                                  \
+                (SRC) += (SRC_STEP);                                  \
+            }                                                         \
+            break;                                                    \
+        case 16:                                                      \
+            for (_k = 0; _k < (COUNT); _k++) {                        \
+                memcpy((DST), (SRC), 16);                             \
+                (DST) += (DST_STEP);                                  \
+                (SRC) += (SRC_STEP);                                  \
+            }                                                         \
+            break;                                                    \
+        default:                                                      \
+            for (_k = 0; _k < (COUNT); _k++) {                        \
+                MEMCPY((DST), (SRC), (LENGTH));                       \
+                (DST) += (DST_STEP);                                  \
+                (SRC) += (SRC_STEP);                                  \
+            }                                                         \
+        }                                                             \
+    } while (0)
+
+/*
+ * The plan functions only handle a whole message moved in a single call
+ * starting at the beginning of the data, which is what the eager protocols
+ * and MPI_Pack/MPI_Unpack do. Everything else goes to the generic functions.
+ */
+static inline bool opal_datatype_plan_usable(const opal_convertor_t *pConv,
+                                             const struct iovec *iov, uint32_t out_size)
+{
+    return (0 == pConv->bConverted) && (0 < out_size) && (NULL != iov[0].iov_base)
+           && (iov[0].iov_len >= pConv->local_size)
+#if OPAL_CUDA_SUPPORT
+           && !(pConv->flags & CONVERTOR_CUDA)
+#endif
+        ;
+}
+
+static inline int32_t opal_datatype_plan_complete(opal_convertor_t *pConv, struct iovec *iov,
+                                                  uint32_t *out_size, size_t *max_data)
+{
+    iov[0].iov_len = pConv->local_size;
+    *out_size = 1;
+    *max_data = pConv->local_size;
+    pConv->bConverted = pConv->local_size;
+    pConv->flags |= CONVERTOR_COMPLETED;
+    return 1;
+}
+
+int32_t opal_pack_homogeneous_plan(opal_convertor_t *pConv, struct iovec *iov, uint32_t *out_size,
+                                   size_t *max_data)
+{
+    const opal_datatype_t *pData = pConv->pDesc;
+    const opal_datatype_plan_t *plan = pData->plan;
+    ptrdiff_t extent = pData->ub - pData->lb;
+    unsigned char *packed, *user_memory, *source;
+
+    if (!opal_datatype_plan_usable(pConv, iov, *out_size)) {
+        return opal_generic_simple_pack(pConv, iov, out_size, max_data);
+    }
+
+    packed = (unsigned char *) iov[0].iov_base;
+    user_memory = pConv->pBaseBuf;
+    for (size_t i = 0; i < pConv->count; i++, user_memory += extent) {
+        for (uint32_t r = 0; r < plan->used; r++) {
+            const opal_datatype_plan_run_t *run = &plan->runs[r];
+
+            source = user_memory + run->disp;
+            PLAN_COPY_BLOCKS(packed, run->length, source, run->stride, run->length, run->count);
+        }
+    }
+    return opal_datatype_plan_complete(pConv, iov, out_size, max_data);
+}
+
+int32_t opal_unpack_homogeneous_plan(opal_convertor_t *pConv, struct iovec *iov,
+                                     uint32_t *out_size, size_t *max_data)
+{
+    const opal_datatype_t *pData = pConv->pDesc;
+    const opal_datatype_plan_t *plan = pData->plan;
+    ptrdiff_t extent = pData->ub - pData->lb;
+    unsigned char *packed, *user_memory, *destination;
+
+    if (!opal_datatype_plan_usable(pConv, iov, *out_size)) {
+        return opal_generic_simple_unpack(pConv, iov, out_size, max_data);
+    }
+
+    packed = (unsigned char *) iov[0].iov_base;
+    user_memory = pConv->pBaseBuf;
+    for (size_t i = 0; i < pConv->count; i++, user_memory += extent) {
+        for (uint32_t r = 0; r < plan->used; r++) {
+            const opal_datatype_plan_run_t *run = &plan->runs[r];
+
+            destination = user_memory + run->disp;
+            PLAN_COPY_BLOCKS(destination, run->stride, packed, run->length, run->length,
+                             run->count);
+        }
+    }
+    return opal_datatype_plan_complete(pConv, iov, out_size, max_data);
+}
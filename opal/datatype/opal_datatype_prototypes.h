@@ -46,6 +46,10 @@ int32_t opal_generic_simple_pack(opal_convertor_t *pConvertor, struct iovec *iov
                                  uint32_t *out_size, size_t *max_data);
 int32_t opal_generic_simple_pack_checksum(opal_convertor_t *pConvertor, struct iovec *iov,
                                           uint32_t *out_size, size_t *max_data);
+int32_t opal_pack_homogeneous_plan(opal_convertor_t *pConv, struct iovec *iov, uint32_t *out_size,
+                                   size_t *max_data);
+int32_t opal_unpack_homogeneous_plan(opal_convertor_t *pConv, struct iovec *iov,
+                                     uint32_t *out_size, size_t *max_data);
 int32_t opal_unpack_homogeneous_contig(opal_convertor_t *pConv, struct iovec *iov,
                                        uint32_t *out_size, size_t *max_data);
 int32_t opal_unpack_homogeneous_contig_checksum(opal_convertor_t *pConv, struct iovec *iov,
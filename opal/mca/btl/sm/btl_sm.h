@@ -52,6 +52,7 @@
 #include "opal/mca/btl/base/btl_base_error.h"
 #include "opal/mca/btl/btl.h"
 #include "opal/mca/btl/sm/btl_sm_types.h"
+#include "opal/mca/memcpy/base/base.h"
 #include "opal/mca/mpool/base/base.h"
 #include "opal/mca/rcache/base/base.h"
 #include "opal/mca/rcache/base/rcache_base_vma.h"
@@ -88,7 +89,7 @@ OPAL_MODULE_DECLSPEC extern mca_btl_sm_t mca_btl_sm;
 static inline void sm_memmove(void *dst, void *src, size_t size)
 {
     if (size >= (size_t) mca_btl_sm_component.memcpy_limit) {
-        memcpy(dst, src, size);
+        opal_memcpy(dst, src, size);
     } else {
         memmove(dst, src, size);
     }
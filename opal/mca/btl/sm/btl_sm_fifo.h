@@ -56,6 +56,13 @@
 /* large enough to ensure the fifo is on its own cache line */
 #define MCA_BTL_SM_FIFO_SIZE 128
 
+/**
+ * Set up the endpoint of a local peer that sent a fragment before it was
+ * added to this btl. Peers are added on demand so the first fragment can
+ * arrive before the receiver ever talked to the sender. Aborts on failure.
+ */
+void mca_btl_sm_endpoint_connect(uint16_t local_rank);
+
 /**
  * sm_fifo_read:
  *
@@ -82,6 +89,10 @@ static inline mca_btl_sm_hdr_t *sm_fifo_read(sm_fifo_t *fifo, struct mca_btl_bas
     value = fifo->fifo_head;
 
     *ep = &mca_btl_sm_component.endpoints[value >> MCA_BTL_SM_OFFSET_BITS];
+    if (OPAL_UNLIKELY(NULL == (*ep)->fifo)) {
+        /* the segment of the sender is needed to read the fragment */
+        mca_btl_sm_endpoint_connect((uint16_t)(value >> MCA_BTL_SM_OFFSET_BITS));
+    }
     hdr = (mca_btl_sm_hdr_t *) relative2virtual(value);
 
     fifo->fifo_head = SM_FIFO_FREE;
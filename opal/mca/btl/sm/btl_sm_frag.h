@@ -93,7 +93,7 @@ static inline void mca_btl_sm_rdma_frag_advance(mca_btl_base_module_t *btl,
 
     if (frag->rdma.sent) {
         if (MCA_BTL_SM_OP_GET == hdr->type) {
-            memcpy(frag->rdma.local_address, data, len);
+            opal_memcpy(frag->rdma.local_address, data, len);
         } else if ((MCA_BTL_SM_OP_ATOMIC == hdr->type || MCA_BTL_SM_OP_CSWAP == hdr->type)
                    && frag->rdma.local_address) {
             if (8 == len) {
@@ -115,7 +115,7 @@ static inline void mca_btl_sm_rdma_frag_advance(mca_btl_base_module_t *btl,
 
         if (MCA_BTL_SM_OP_PUT == hdr->type) {
             /* copy the next block into the fragment buffer */
-            memcpy((void *) (hdr + 1), frag->rdma.local_address, packet_size);
+            opal_memcpy((void *) (hdr + 1), frag->rdma.local_address, packet_size);
         }
 
         hdr->addr = frag->rdma.remote_address;
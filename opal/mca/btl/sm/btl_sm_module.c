@@ -29,6 +29,7 @@
  */
 
 #include "opal_config.h"
+#include "opal/util/argv.h"
 #include "opal/util/show_help.h"
 
 #include "opal/mca/btl/sm/btl_sm.h"
@@ -192,6 +193,11 @@ static int init_sm_endpoint(struct mca_btl_base_endpoint_t **ep_out, struct opal
     mca_btl_base_endpoint_t *ep = component->endpoints + peer_local_rank;
     *ep_out = ep;
 
+    if (NULL != ep->fifo) {
+        /* already set up when the peer sent us its first fragment */
+        return OPAL_SUCCESS;
+    }
+
     OBJ_CONSTRUCT(ep, mca_btl_sm_endpoint_t);
 
     ep->peer_smp_rank = peer_local_rank;
@@ -275,11 +281,93 @@ static int init_sm_endpoint(struct mca_btl_base_endpoint_t **ep_out, struct opal
         ep->segment_base = component->my_segment;
     }
 
+    /* the fifo marks the endpoint as initialized */
+    opal_atomic_wmb();
     ep->fifo = (struct sm_fifo_t *) ep->segment_base;
 
     return OPAL_SUCCESS;
 }
 
+static int sm_local_rank_to_name(uint16_t local_rank, opal_process_name_t *name)
+{
+    mca_btl_sm_component_t *component = &mca_btl_sm_component;
+    int rc;
+
+    if (NULL == component->local_rank_vpids) {
+        opal_process_name_t peer = {.jobid = OPAL_PROC_MY_NAME.jobid, .vpid = OPAL_VPID_WILDCARD};
+        opal_vpid_t *vpids;
+        char *val = NULL, **peers;
+
+        OPAL_MODEX_RECV_VALUE(rc, PMIX_LOCAL_PEERS, &peer, &val, PMIX_STRING);
+        if (OPAL_SUCCESS != rc || NULL == val) {
+            BTL_VERBOSE(("could not read the local peers. rc=%d", rc));
+            return OPAL_ERR_NOT_FOUND;
+        }
+
+        peers = opal_argv_split(val, ',');
+        free(val);
+
+        vpids = malloc((1 + MCA_BTL_SM_NUM_LOCAL_PEERS) * sizeof(opal_vpid_t));
+        if (NULL == vpids) {
+            opal_argv_free(peers);
+            return OPAL_ERR_OUT_OF_RESOURCE;
+        }
+
+        for (int i = 0; i < (int) (1 + MCA_BTL_SM_NUM_LOCAL_PEERS); ++i) {
+            vpids[i] = OPAL_VPID_INVALID;
+        }
+
+        /* local data only, this does not involve the other nodes */
+        for (int i = 0; NULL != peers && NULL != peers[i]; ++i) {
+            uint16_t peer_local_rank, *ptr = &peer_local_rank;
+
+            peer.vpid = strtoul(peers[i], NULL, 10);
+            OPAL_MODEX_RECV_VALUE(rc, PMIX_LOCAL_RANK, &peer, &ptr, PMIX_UINT16);
+            if (OPAL_SUCCESS == rc && peer_local_rank <= MCA_BTL_SM_NUM_LOCAL_PEERS) {
+                vpids[peer_local_rank] = peer.vpid;
+            }
+        }
+        opal_argv_free(peers);
+
+        component->local_rank_vpids = vpids;
+    }
+
+    if (local_rank > MCA_BTL_SM_NUM_LOCAL_PEERS
+        || OPAL_VPID_INVALID == component->local_rank_vpids[local_rank]) {
+        return OPAL_ERR_NOT_FOUND;
+    }
+
+    name->jobid = OPAL_PROC_MY_NAME.jobid;
+    name->vpid = component->local_rank_vpids[local_rank];
+
+    return OPAL_SUCCESS;
+}
+
+void mca_btl_sm_endpoint_connect(uint16_t local_rank)
+{
+    mca_btl_sm_component_t *component = &mca_btl_sm_component;
+    struct mca_btl_base_endpoint_t *ep;
+    opal_process_name_t name;
+    opal_proc_t *proc;
+    int rc = OPAL_SUCCESS;
+
+    OPAL_THREAD_LOCK(&component->lock);
+    if (NULL == component->endpoints[local_rank].fifo) {
+        rc = sm_local_rank_to_name(local_rank, &name);
+        if (OPAL_SUCCESS == rc) {
+            /* creates the proc if this process never heard of the peer */
+            proc = opal_proc_for_name(name);
+            rc = (NULL == proc) ? OPAL_ERR_NOT_FOUND : init_sm_endpoint(&ep, proc);
+        }
+    }
+    OPAL_THREAD_UNLOCK(&component->lock);
+
+    if (OPAL_UNLIKELY(OPAL_SUCCESS != rc)) {
+        BTL_ERROR(("could not set up the endpoint of local rank %d. rc=%d", local_rank, rc));
+        sm_btl_exit(&mca_btl_sm);
+    }
+}
+
 static int fini_sm_endpoint(struct mca_btl_base_endpoint_t *ep)
 {
     /* check if the endpoint is initialized. avoids a double-destruct */
@@ -348,8 +436,11 @@ static int sm_add_procs(struct mca_btl_base_module_t *btl, size_t nprocs,
             }
         }
 
-        /* setup endpoint */
+        /* setup endpoint. the peer may have been set up already by an
+         * incoming fragment */
+        OPAL_THREAD_LOCK(&mca_btl_sm_component.lock);
         rc = init_sm_endpoint(peers + proc, procs[proc]);
+        OPAL_THREAD_UNLOCK(&mca_btl_sm_component.lock);
         if (OPAL_SUCCESS != rc) {
             break;
         }
@@ -410,6 +501,9 @@ static int sm_finalize(struct mca_btl_base_module_t *btl)
     free(component->endpoints);
     component->endpoints = NULL;
 
+    free(component->local_rank_vpids);
+    component->local_rank_vpids = NULL;
+
     sm_btl->btl_inited = false;
 
     free(component->fbox_in_endpoints);
@@ -566,8 +660,8 @@ static struct mca_btl_base_descriptor_t *sm_prepare_src(struct mca_btl_base_modu
         } else {
 #endif
             /* NTH: the covertor adds some latency so we bypass it here */
-            memcpy((void *) ((uintptr_t) frag->segments[0].seg_addr.pval + reserve), data_ptr,
-                   *size);
+            opal_memcpy((void *) ((uintptr_t) frag->segments[0].seg_addr.pval + reserve),
+                        data_ptr, *size);
             frag->segments[0].seg_len = total_size;
 #if OPAL_BTL_SM_HAVE_XPMEM
         }
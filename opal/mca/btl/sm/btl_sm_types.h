@@ -168,6 +168,8 @@ struct mca_btl_sm_component_t {
 
     mca_btl_base_endpoint_t
         *endpoints; /**< array of local endpoints (one for each local peer including myself) */
+    opal_vpid_t *local_rank_vpids; /**< vpid of each local rank, resolved on the first fragment
+                                    *   from a peer that was not added to this btl */
     mca_btl_base_endpoint_t **fbox_in_endpoints; /**< array of fast box in endpoints */
     unsigned int num_fbox_in_endpoints;          /**< number of fast boxes to poll */
     struct sm_fifo_t *my_fifo;                   /**< pointer to the local fifo */
@@ -339,6 +339,37 @@ static void fake_rdma_complete(mca_btl_base_module_t *btl, mca_btl_base_endpoint
                   frag->cb.data, rc);
 }
 
+void mca_btl_tcp_put_received(mca_btl_tcp_module_t *btl, size_t size, opal_timer_t start)
+{
+    opal_timer_t now;
+
+    if (0 == mca_btl_tcp_component.tcp_frag_target_usec || size < btl->super.btl_max_send_size) {
+        return;
+    }
+    now = opal_timer_base_get_usec();
+    if (now > start) {
+        btl->tcp_put_rate = 0.75 * btl->tcp_put_rate
+                            + 0.25 * ((double) size / (double) (now - start));
+        mca_btl_tcp_update_frag_size(btl);
+    }
+}
+
+void mca_btl_tcp_update_frag_size(mca_btl_tcp_module_t *btl)
+{
+    double frag_size = btl->tcp_put_rate * mca_btl_tcp_component.tcp_frag_target_usec;
+
+    if (0 == mca_btl_tcp_component.tcp_frag_target_usec) {
+        return;
+    }
+    if (frag_size < (double) btl->super.btl_max_send_size) {
+        frag_size = (double) btl->super.btl_max_send_size;
+    }
+    if (frag_size > (double) btl->tcp_max_frag_size) {
+        frag_size = (double) btl->tcp_max_frag_size;
+    }
+    btl->super.btl_rdma_pipeline_frag_size = (size_t) frag_size;
+}
+
 /**
  * Initiate an asynchronous put.
  */
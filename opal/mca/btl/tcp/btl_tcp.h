@@ -49,6 +49,7 @@
 #include "opal/mca/btl/base/base.h"
 #include "opal/mca/btl/btl.h"
 #include "opal/mca/mpool/mpool.h"
+#include "opal/mca/timer/base/base.h"
 #include "opal/util/event.h"
 #include "opal/util/fd.h"
 
@@ -145,6 +146,10 @@ struct mca_btl_tcp_component_t {
      * that are not found?
      */
     bool report_all_unfound_interfaces;
+
+    /* time a put fragment should take on the wire, used to size the
+     * RDMA pipeline fragments of each module (0 to keep a fixed size) */
+    unsigned int tcp_frag_target_usec;
 };
 typedef struct mca_btl_tcp_component_t mca_btl_tcp_component_t;
 
@@ -170,6 +175,9 @@ struct mca_btl_tcp_module_t {
     opal_list_t tcp_endpoints;
 
     mca_btl_base_module_error_cb_fn_t tcp_error_cb; /**< Upper layer error callback */
+
+    size_t tcp_max_frag_size;  /**< upper bound of the RDMA pipeline fragment size */
+    double tcp_put_rate;       /**< measured bandwidth of the incoming puts, in bytes per usec */
 #if MCA_BTL_TCP_STATISTICS
     size_t tcp_bytes_sent;
     size_t tcp_bytes_recv;
@@ -251,6 +259,22 @@ extern int mca_btl_tcp_send(struct mca_btl_base_module_t *btl,
                             struct mca_btl_base_endpoint_t *btl_peer,
                             struct mca_btl_base_descriptor_t *descriptor, mca_btl_base_tag_t tag);
 
+/**
+ * Account for an incoming put of size bytes whose header was read at
+ * start. The bandwidth is measured on the receiving side because this is
+ * where the PML schedules the put fragments of a rendezvous.
+ */
+void mca_btl_tcp_put_received(mca_btl_tcp_module_t *btl, size_t size, opal_timer_t start);
+
+/**
+ * Size the RDMA pipeline fragments of the module so that a put takes
+ * about btl_tcp_frag_target_usec at the measured bandwidth of the link.
+ * The PML reads btl_rdma_pipeline_frag_size each time it schedules a
+ * fragment, so faster links get larger fragments and slower ones
+ * smaller fragments.
+ */
+void mca_btl_tcp_update_frag_size(mca_btl_tcp_module_t *btl);
+
 /**
  * Initiate an asynchronous put.
  */
@@ -347,6 +347,13 @@ static int mca_btl_tcp_component_register(void)
     }
     mca_btl_tcp_param_register_int("disable_family", NULL, 0, OPAL_INFO_LVL_2,
                                    &mca_btl_tcp_component.tcp_disable_family);
+    mca_btl_tcp_param_register_uint(
+        "frag_target_usec",
+        "Time in microseconds a put fragment of the RDMA pipeline should take on the wire. "
+        "The fragment size of each link follows its measured bandwidth, between "
+        "btl_tcp_max_send_size and btl_tcp_rdma_pipeline_frag_size (0 keeps "
+        "btl_tcp_rdma_pipeline_frag_size)",
+        2000, OPAL_INFO_LVL_5, &mca_btl_tcp_component.tcp_frag_target_usec);
 
     return mca_btl_tcp_component_verify();
 }
@@ -611,6 +618,11 @@ static int mca_btl_tcp_create(const int if_kindex, const char *if_name)
             }
         }
 
+        /* start from the nominal bandwidth (Mb/s) until incoming puts are timed */
+        btl->tcp_max_frag_size = btl->super.btl_rdma_pipeline_frag_size;
+        btl->tcp_put_rate = (double) btl->super.btl_bandwidth / 8.0;
+        mca_btl_tcp_update_frag_size(btl);
+
         /* Add another entry to the local interface list */
         opal_string_copy(copied_interface->if_name, if_name, OPAL_IF_NAMESIZE);
         copied_interface->if_index = if_index;
@@ -1043,6 +1043,8 @@ static void mca_btl_tcp_endpoint_recv_handler(int sd, short flags, void *user)
                        .tag = frag->hdr.base.tag,
                        .cbdata = reg->cbdata};
                 reg->cbfunc(&frag->btl->super, &desc);
+            } else if (MCA_BTL_TCP_HDR_TYPE_PUT == frag->hdr.type) {
+                mca_btl_tcp_put_received(frag->btl, frag->hdr.size, frag->start);
             }
 #if MCA_BTL_TCP_ENDPOINT_CACHE
             if (0 != btl_endpoint->endpoint_cache_length) {
@@ -290,6 +290,7 @@ advance_iov_position:
             break;
         case MCA_BTL_TCP_HDR_TYPE_PUT:
             if (frag->iov_idx == 1) {
+                frag->start = opal_timer_base_get_usec();
                 frag->iov[1].iov_base = (IOVBASE_TYPE *) frag->segments;
                 frag->iov[1].iov_len = frag->hdr.count * sizeof(mca_btl_base_segment_t);
                 frag->iov_cnt++;
@@ -64,6 +64,7 @@ struct mca_btl_tcp_frag_t {
         void *data;
         void *context;
     } cb;
+    opal_timer_t start; /**< time the header of an incoming put was read */
 };
 typedef struct mca_btl_tcp_frag_t mca_btl_tcp_frag_t;
 OBJ_CLASS_DECLARATION(mca_btl_tcp_frag_t);
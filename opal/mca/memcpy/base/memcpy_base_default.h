@@ -12,7 +12,9 @@
 #ifndef OPAL_MCA_MEMCPY_BASE_MEMCPY_BASE_NULL_H
 #define OPAL_MCA_MEMCPY_BASE_MEMCPY_BASE_NULL_H
 
-#define opal_memcpy(dst, src, length) memcpy((dst), (src), (length));
+#include <string.h>
+
+#define opal_memcpy(dst, src, length) memcpy((dst), (src), (length))
 
 #define opal_memcpy_tov(dst_iov, src, count)                              \
     do {                                                                  \
@@ -0,0 +1,96 @@
+# -*- shell-script -*-
+#
+# $COPYRIGHT$
+#
+# Additional copyrights may follow
+#
+# $HEADER$
+#
+
+AC_DEFUN([MCA_opal_memcpy_x86_PRIORITY], [30])
+
+AC_DEFUN([MCA_opal_memcpy_x86_COMPILE_MODE], [
+    AC_MSG_CHECKING([for MCA component $2:$3 compile mode])
+    $4="static"
+    AC_MSG_RESULT([$$4])
+])
+
+AC_DEFUN([MCA_opal_memcpy_x86_POST_CONFIG],[
+    AS_IF([test "$1" = "1"], [memcpy_base_include="x86/memcpy_x86.h"])
+])dnl
+
+# MCA_memcpy_x86_CONFIG(action-if-can-compile,
+#                       [action-if-cant-compile])
+# ------------------------------------------------
+# The component itself only needs an x86_64 target (for rep movsb).
+# The streaming kernels are built in separate convenience libraries
+# with the flags required by the corresponding ISA, and are selected
+# at runtime based on the processor capabilities.
+AC_DEFUN([MCA_opal_memcpy_x86_CONFIG],[
+    AC_CONFIG_FILES([opal/mca/memcpy/x86/Makefile])
+
+    MCA_BUILD_MEMCPY_X86_AVX2_FLAGS=""
+    MCA_BUILD_MEMCPY_X86_AVX512_FLAGS=""
+    memcpy_x86_avx2_support=0
+    memcpy_x86_avx512_support=0
+
+    OPAL_VAR_SCOPE_PUSH([memcpy_x86_cflags_save])
+
+    AS_IF([test "$opal_cv_asm_arch" = "X86_64"],
+          [memcpy_x86_happy="yes"
+           AC_LANG_PUSH([C])
+           memcpy_x86_cflags_save="$CFLAGS"
+
+           AC_MSG_CHECKING([for AVX512 streaming store support (with -mavx512f)])
+           CFLAGS="-mavx512f $memcpy_x86_cflags_save"
+           AC_LINK_IFELSE(
+               [AC_LANG_PROGRAM([[#include <immintrin.h>]],
+                                [[
+    long long A[16];
+    __m512i vA = _mm512_loadu_si512((void*)A);
+    _mm512_stream_si512((void*)A, vA);
+    _mm_sfence()
+                                ]])],
+               [memcpy_x86_avx512_support=1
+                MCA_BUILD_MEMCPY_X86_AVX512_FLAGS="-mavx512f"
+                AC_MSG_RESULT([yes])],
+               [AC_MSG_RESULT([no])])
+
+           AC_MSG_CHECKING([for AVX2 streaming store support (with -mavx2)])
+           CFLAGS="-mavx2 $memcpy_x86_cflags_save"
+           AC_LINK_IFELSE(
+               [AC_LANG_PROGRAM([[#include <immintrin.h>]],
+                                [[
+    long long A[8];
+    __m256i vA = _mm256_loadu_si256((__m256i*)A);
+    _mm256_stream_si256((__m256i*)A, vA);
+    _mm_sfence()
+                                ]])],
+               [memcpy_x86_avx2_support=1
+                MCA_BUILD_MEMCPY_X86_AVX2_FLAGS="-mavx2"
+                AC_MSG_RESULT([yes])],
+               [AC_MSG_RESULT([no])])
+
+           CFLAGS="$memcpy_x86_cflags_save"
+           AC_LANG_POP([C])],
+          [memcpy_x86_happy="no"])
+
+    AC_DEFINE_UNQUOTED([OPAL_MEMCPY_X86_HAVE_AVX512],
+                       [$memcpy_x86_avx512_support],
+                       [Whether the memcpy/x86 component builds the AVX512 streaming copy])
+    AC_DEFINE_UNQUOTED([OPAL_MEMCPY_X86_HAVE_AVX2],
+                       [$memcpy_x86_avx2_support],
+                       [Whether the memcpy/x86 component builds the AVX2 streaming copy])
+    AM_CONDITIONAL([MCA_BUILD_opal_memcpy_x86_has_avx512_support],
+                   [test "$memcpy_x86_avx512_support" = "1"])
+    AM_CONDITIONAL([MCA_BUILD_opal_memcpy_x86_has_avx2_support],
+                   [test "$memcpy_x86_avx2_support" = "1"])
+    AC_SUBST(MCA_BUILD_MEMCPY_X86_AVX512_FLAGS)
+    AC_SUBST(MCA_BUILD_MEMCPY_X86_AVX2_FLAGS)
+
+    OPAL_VAR_SCOPE_POP
+
+    AS_IF([test "$memcpy_x86_happy" = "yes"],
+          [$1],
+          [$2])
+])
@@ -0,0 +1,55 @@
+/*
+ * $COPYRIGHT$
+ *
+ * Additional copyrights may follow
+ *
+ * $HEADER$
+ */
+
+#ifndef OPAL_MCA_MEMCPY_X86_MEMCPY_X86_H
+#define OPAL_MCA_MEMCPY_X86_MEMCPY_X86_H
+
+#include "opal_config.h"
+
+#include <stddef.h>
+#include <string.h>
+
+#include "opal/prefetch.h"
+
+BEGIN_C_DECLS
+
+typedef void *(*opal_memcpy_x86_fn_t)(void *dst, const void *src, size_t length);
+
+/**
+ * Copies shorter than opal_memcpy_x86_erms_threshold go straight to the
+ * libc memcpy. Copies up to opal_memcpy_x86_stream_threshold use the
+ * medium copy (rep movsb on processors with ERMS), and larger ones the
+ * non-temporal streaming copy so that they do not evict the working
+ * set from the caches. Both thresholds are SIZE_MAX until the component
+ * is opened.
+ */
+OPAL_DECLSPEC extern size_t opal_memcpy_x86_erms_threshold;
+OPAL_DECLSPEC extern size_t opal_memcpy_x86_stream_threshold;
+OPAL_DECLSPEC extern opal_memcpy_x86_fn_t opal_memcpy_x86_medium;
+OPAL_DECLSPEC extern opal_memcpy_x86_fn_t opal_memcpy_x86_large;
+
+static inline void *opal_memcpy_x86(void *dst, const void *src, size_t length)
+{
+    if (OPAL_LIKELY(length < opal_memcpy_x86_erms_threshold)) {
+        return memcpy(dst, src, length);
+    }
+    if (length < opal_memcpy_x86_stream_threshold) {
+        return opal_memcpy_x86_medium(dst, src, length);
+    }
+    return opal_memcpy_x86_large(dst, src, length);
+}
+
+END_C_DECLS
+
+/* reuse the iovec helpers from the default implementation */
+#include "opal/mca/memcpy/base/memcpy_base_default.h"
+
+#undef opal_memcpy
+#define opal_memcpy(dst, src, length) opal_memcpy_x86((dst), (src), (length))
+
+#endif /* OPAL_MCA_MEMCPY_X86_MEMCPY_X86_H */
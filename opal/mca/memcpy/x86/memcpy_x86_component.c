@@ -0,0 +1,218 @@
+/*
+ * $COPYRIGHT$
+ *
+ * Additional copyrights may follow
+ *
+ * $HEADER$
+ */
+
+#include "opal_config.h"
+
+#include <stdint.h>
+#include <string.h>
+#ifdef HAVE_UNISTD_H
+#    include <unistd.h>
+#endif
+
+#include "opal/constants.h"
+#include "opal_stdint.h"
+#include "opal/mca/base/base.h"
+#include "opal/mca/memcpy/base/base.h"
+#include "opal/mca/memcpy/memcpy.h"
+#include "opal/mca/memcpy/x86/memcpy_x86.h"
+#include "opal/util/output.h"
+
+#if OPAL_MEMCPY_X86_HAVE_AVX2
+extern void *opal_memcpy_x86_stream_avx2(void *dst, const void *src, size_t length);
+#endif
+#if OPAL_MEMCPY_X86_HAVE_AVX512
+extern void *opal_memcpy_x86_stream_avx512(void *dst, const void *src, size_t length);
+#endif
+
+#define MEMCPY_X86_HAS_ERMS_FLAG   0x00000001
+#define MEMCPY_X86_HAS_AVX2_FLAG   0x00000002
+#define MEMCPY_X86_HAS_AVX512_FLAG 0x00000004
+
+static int memcpy_x86_register(void);
+static int memcpy_x86_open(void);
+static int memcpy_x86_close(void);
+
+/* Until the component is opened every copy goes to libc */
+size_t opal_memcpy_x86_erms_threshold = SIZE_MAX;
+size_t opal_memcpy_x86_stream_threshold = SIZE_MAX;
+opal_memcpy_x86_fn_t opal_memcpy_x86_medium = memcpy;
+opal_memcpy_x86_fn_t opal_memcpy_x86_large = memcpy;
+
+static size_t memcpy_x86_erms_threshold_param;
+static size_t memcpy_x86_stream_threshold_param;
+static uint32_t memcpy_x86_flags;
+
+const opal_memcpy_base_component_2_0_0_t mca_memcpy_x86_component = {
+    /* First, the mca_component_t struct containing meta information
+       about the component itself */
+    .memcpyc_version =
+        {
+            OPAL_MEMCPY_BASE_VERSION_2_0_0,
+
+            /* Component name and version */
+            .mca_component_name = "x86",
+            MCA_BASE_MAKE_VERSION(component, OPAL_MAJOR_VERSION, OPAL_MINOR_VERSION,
+                                  OPAL_RELEASE_VERSION),
+
+            /* Component open and close functions */
+            .mca_open_component = memcpy_x86_open,
+            .mca_close_component = memcpy_x86_close,
+            .mca_register_component_params = memcpy_x86_register,
+        },
+    .memcpyc_data =
+        {/* The component is checkpoint ready */
+         MCA_BASE_METADATA_PARAM_CHECKPOINT},
+};
+
+static void memcpy_x86_cpuid(uint32_t eax, uint32_t ecx, uint32_t *abcd)
+{
+    uint32_t ebx = 0, edx = 0;
+
+    __asm__("cpuid" : "+b"(ebx), "+a"(eax), "+c"(ecx), "=d"(edx));
+    abcd[0] = eax;
+    abcd[1] = ebx;
+    abcd[2] = ecx;
+    abcd[3] = edx;
+}
+
+static uint32_t memcpy_x86_features(void)
+{
+    const uint32_t osxsave_mask = (1U << 27); /* OSXSAVE (EAX = 1, ECX = 0) : ECX */
+    const uint32_t avx2_mask = (1U << 5);     /* AVX2    (EAX = 7, ECX = 0) : EBX */
+    const uint32_t erms_mask = (1U << 9);     /* ERMS    (EAX = 7, ECX = 0) : EBX */
+    const uint32_t avx512f_mask = (1U << 16); /* AVX512F (EAX = 7, ECX = 0) : EBX */
+    uint32_t flags = 0, xcr0 = 0, abcd[4];
+
+    memcpy_x86_cpuid(0, 0, abcd);
+    if (abcd[0] < 7) {
+        return 0;
+    }
+
+    memcpy_x86_cpuid(1, 0, abcd);
+    if (abcd[2] & osxsave_mask) {
+        uint32_t xcr0_hi;
+        /* xgetbv: which register states the OS saves on context switch */
+        __asm__("xgetbv" : "=a"(xcr0), "=d"(xcr0_hi) : "c"(0));
+        (void) xcr0_hi;
+    }
+
+    memcpy_x86_cpuid(7, 0, abcd);
+    flags |= (abcd[1] & erms_mask) ? MEMCPY_X86_HAS_ERMS_FLAG : 0;
+    /* YMM state (bits 1-2) for AVX2, plus opmask and ZMM state (bits 5-7) for AVX512 */
+    if (0x6 == (xcr0 & 0x6)) {
+        flags |= (abcd[1] & avx2_mask) ? MEMCPY_X86_HAS_AVX2_FLAG : 0;
+        if (0xe6 == (xcr0 & 0xe6)) {
+            flags |= (abcd[1] & avx512f_mask) ? MEMCPY_X86_HAS_AVX512_FLAG : 0;
+        }
+    }
+    return flags;
+}
+
+static void *memcpy_x86_erms(void *dst, const void *src, size_t length)
+{
+    void *d = dst;
+    const void *s = src;
+
+    __asm__ __volatile__("rep movsb" : "+D"(d), "+S"(s), "+c"(length) : : "memory");
+    return dst;
+}
+
+static int memcpy_x86_register(void)
+{
+    memcpy_x86_flags = memcpy_x86_features();
+
+    memcpy_x86_erms_threshold_param = 2048;
+    (void) mca_base_component_var_register(
+        &mca_memcpy_x86_component.memcpyc_version, "erms_threshold",
+        "Size (in bytes) from which copies use rep movsb on processors with enhanced rep "
+        "movsb support (set to a very large value to disable)",
+        MCA_BASE_VAR_TYPE_SIZE_T, NULL, 0, 0, OPAL_INFO_LVL_5, MCA_BASE_VAR_SCOPE_READONLY,
+        &memcpy_x86_erms_threshold_param);
+
+    memcpy_x86_stream_threshold_param = 0;
+    (void) mca_base_component_var_register(
+        &mca_memcpy_x86_component.memcpyc_version, "stream_threshold",
+        "Size (in bytes) from which copies use non-temporal stores and bypass the caches. "
+        "0 selects half of the last level cache size (set to a very large value to disable)",
+        MCA_BASE_VAR_TYPE_SIZE_T, NULL, 0, 0, OPAL_INFO_LVL_5, MCA_BASE_VAR_SCOPE_READONLY,
+        &memcpy_x86_stream_threshold_param);
+
+    (void) mca_base_component_var_register(
+        &mca_memcpy_x86_component.memcpyc_version, "flags",
+        "Processor capabilities used by the memcpy/x86 component: 0x1 ERMS, 0x2 AVX2, "
+        "0x4 AVX512F. Defaults to the capabilities of the processor, and can only be used "
+        "to restrict them",
+        MCA_BASE_VAR_TYPE_UNSIGNED_INT, NULL, 0, 0, OPAL_INFO_LVL_6,
+        MCA_BASE_VAR_SCOPE_READONLY, &memcpy_x86_flags);
+
+    return OPAL_SUCCESS;
+}
+
+static int memcpy_x86_open(void)
+{
+    size_t stream_threshold = memcpy_x86_stream_threshold_param;
+
+    /* user provided flags can only restrict what the hardware supports */
+    memcpy_x86_flags &= memcpy_x86_features();
+
+    if (0 == stream_threshold) {
+#if defined(_SC_LEVEL3_CACHE_SIZE)
+        long llc_size = sysconf(_SC_LEVEL3_CACHE_SIZE);
+        stream_threshold = (llc_size > 0) ? (size_t) llc_size / 2 : 0;
+#endif
+        if (0 == stream_threshold) {
+            stream_threshold = 1024 * 1024;
+        }
+    }
+
+    opal_memcpy_x86_medium = memcpy;
+    opal_memcpy_x86_large = memcpy;
+    if (memcpy_x86_flags & MEMCPY_X86_HAS_ERMS_FLAG) {
+        opal_memcpy_x86_medium = memcpy_x86_erms;
+    }
+#if OPAL_MEMCPY_X86_HAVE_AVX2
+    if (memcpy_x86_flags & MEMCPY_X86_HAS_AVX2_FLAG) {
+        opal_memcpy_x86_large = opal_memcpy_x86_stream_avx2;
+    }
+#endif
+#if OPAL_MEMCPY_X86_HAVE_AVX512
+    if (memcpy_x86_flags & MEMCPY_X86_HAS_AVX512_FLAG) {
+        opal_memcpy_x86_large = opal_memcpy_x86_stream_avx512;
+    }
+#endif
+
+    /* without a streaming kernel everything above the ERMS threshold
+     * stays on the medium copy */
+    opal_memcpy_x86_stream_threshold = (memcpy == opal_memcpy_x86_large) ? SIZE_MAX
+                                                                          : stream_threshold;
+    opal_memcpy_x86_erms_threshold = (memcpy_x86_erms_threshold_param
+                                      < opal_memcpy_x86_stream_threshold)
+                                         ? memcpy_x86_erms_threshold_param
+                                         : opal_memcpy_x86_stream_threshold;
+    if (memcpy == opal_memcpy_x86_medium) {
+        opal_memcpy_x86_erms_threshold = opal_memcpy_x86_stream_threshold;
+    }
+
+    opal_output_verbose(10, opal_memcpy_base_framework.framework_output,
+                        "memcpy:x86: flags 0x%x, rep movsb from %" PRIsize_t
+                        " bytes, streaming stores from %" PRIsize_t " bytes",
+                        memcpy_x86_flags, opal_memcpy_x86_erms_threshold,
+                        opal_memcpy_x86_stream_threshold);
+
+    return OPAL_SUCCESS;
+}
+
+static int memcpy_x86_close(void)
+{
+    opal_memcpy_x86_erms_threshold = SIZE_MAX;
+    opal_memcpy_x86_stream_threshold = SIZE_MAX;
+    opal_memcpy_x86_medium = memcpy;
+    opal_memcpy_x86_large = memcpy;
+
+    return OPAL_SUCCESS;
+}
@@ -0,0 +1,92 @@
+/*
+ * $COPYRIGHT$
+ *
+ * Additional copyrights may follow
+ *
+ * $HEADER$
+ */
+
+/*
+ * Non-temporal copy kernels. This file is compiled once per supported
+ * ISA (see Makefile.am), with GENERATE_<ISA>_CODE selecting the kernel
+ * to generate.
+ */
+
+#include "opal_config.h"
+
+#include <stdint.h>
+#include <string.h>
+
+#include <immintrin.h>
+
+#include "opal/mca/memcpy/x86/memcpy_x86.h"
+
+/* Unrolled by four vectors to keep enough loads in flight, with the
+ * source prefetched a few iterations ahead. The destination is first
+ * brought to a vector boundary so that every streaming store is
+ * aligned, and the trailing bytes go through memcpy after the fence. */
+#define MEMCPY_X86_STREAM_FUNC(name, vtype, vsize, loadu, stream)            \
+    void *name(void *dst, const void *src, size_t length)                     \
+    {                                                                         \
+        unsigned char *d = (unsigned char *) dst;                             \
+        const unsigned char *s = (const unsigned char *) src;                 \
+        size_t head = ((vsize) - ((uintptr_t) d & ((vsize) -1))) & ((vsize) -1); \
+                                                                              \
+        if (length < head + 4 * (vsize)) {                                    \
+            return memcpy(dst, src, length);                                  \
+        }                                                                     \
+        if (head) {                                                           \
+            memcpy(d, s, head);                                               \
+            d += head;                                                        \
+            s += head;                                                        \
+            length -= head;                                                   \
+        }                                                                     \
+        for (; length >= 4 * (vsize); length -= 4 * (vsize)) {                \
+            _mm_prefetch((const char *) s + 16 * (vsize), _MM_HINT_NTA);      \
+            vtype v0 = loadu((const vtype *) s);                              \
+            vtype v1 = loadu((const vtype *) (s + (vsize)));                  \
+            vtype v2 = loadu((const vtype *) (s + 2 * (vsize)));              \
+            vtype v3 = loadu((const vtype *) (s + 3 * (vsize)));              \
+            stream((vtype *) d, v0);                                          \
+            stream((vtype *) (d + (vsize)), v1);                              \
+            stream((vtype *) (d + 2 * (vsize)), v2);                          \
+            stream((vtype *) (d + 3 * (vsize)), v3);                          \
+            s += 4 * (vsize);                                                 \
+            d += 4 * (vsize);                                                 \
+        }                                                                     \
+        for (; length >= (vsize); length -= (vsize)) {                        \
+            stream((vtype *) d, loadu((const vtype *) s));                    \
+            s += (vsize);                                                     \
+            d += (vsize);                                                     \
+        }                                                                     \
+        /* order the weakly-ordered stores before anything that follows */    \
+        _mm_sfence();                                                         \
+        if (length) {                                                         \
+            memcpy(d, s, length);                                             \
+        }                                                                     \
+        return dst;                                                           \
+    }
+
+#if defined(GENERATE_AVX512_CODE)
+#    if !defined(__AVX512F__)
+#        error Target architecture lacks AVX512F support needed for _mm512_stream_si512
+#    endif
+static inline __m512i memcpy_x86_loadu512(const __m512i *p)
+{
+    return _mm512_loadu_si512((const void *) p);
+}
+static inline void memcpy_x86_stream512(__m512i *p, __m512i v)
+{
+    _mm512_stream_si512((void *) p, v);
+}
+MEMCPY_X86_STREAM_FUNC(opal_memcpy_x86_stream_avx512, __m512i, 64, memcpy_x86_loadu512,
+                       memcpy_x86_stream512)
+#endif /* defined(GENERATE_AVX512_CODE) */
+
+#if defined(GENERATE_AVX2_CODE)
+#    if !defined(__AVX2__)
+#        error Target architecture lacks AVX2 support needed for _mm256_stream_si256
+#    endif
+MEMCPY_X86_STREAM_FUNC(opal_memcpy_x86_stream_avx2, __m256i, 32, _mm256_loadu_si256,
+                       _mm256_stream_si256)
+#endif /* defined(GENERATE_AVX2_CODE) */
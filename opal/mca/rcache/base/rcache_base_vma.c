@@ -31,6 +31,7 @@
 #include "opal/mca/rcache/base/base.h"
 #include "opal/mca/rcache/rcache.h"
 #include "rcache_base_vma.h"
+#include "rcache_base_vma_index.h"
 #include "rcache_base_vma_tree.h"
 
 /**
@@ -40,6 +41,8 @@
 static void mca_rcache_base_vma_module_construct(mca_rcache_base_vma_module_t *vma_module)
 {
     OBJ_CONSTRUCT(&vma_module->vma_lock, opal_recursive_mutex_t);
+    vma_module->index = NULL;
+    vma_module->index_readers = NULL;
     (void) mca_rcache_base_vma_tree_init(vma_module);
 }
 
@@ -47,6 +50,7 @@ static void mca_rcache_base_vma_module_destruct(mca_rcache_base_vma_module_t *vm
 {
     OBJ_DESTRUCT(&vma_module->vma_lock);
     mca_rcache_base_vma_tree_finalize(vma_module);
+    mca_rcache_base_vma_index_finalize(vma_module);
 }
 
 OBJ_CLASS_INSTANCE(mca_rcache_base_vma_module_t, opal_object_t,
@@ -57,6 +61,28 @@ mca_rcache_base_vma_module_t *mca_rcache_base_vma_module_alloc(void)
     return OBJ_NEW(mca_rcache_base_vma_module_t);
 }
 
+int mca_rcache_base_vma_enable_index(mca_rcache_base_vma_module_t *vma_module, size_t max_pages)
+{
+    return mca_rcache_base_vma_index_init(vma_module, max_pages);
+}
+
+int mca_rcache_base_vma_reader_enter(mca_rcache_base_vma_module_t *vma_module)
+{
+    return mca_rcache_base_vma_index_reader_enter(vma_module);
+}
+
+void mca_rcache_base_vma_reader_exit(mca_rcache_base_vma_module_t *vma_module, int token)
+{
+    mca_rcache_base_vma_index_reader_exit(vma_module, token);
+}
+
+mca_rcache_base_registration_t *
+mca_rcache_base_vma_lookup(mca_rcache_base_vma_module_t *vma_module, unsigned char *base,
+                           unsigned char *bound)
+{
+    return mca_rcache_base_vma_index_find(vma_module, base, bound);
+}
+
 int mca_rcache_base_vma_find(mca_rcache_base_vma_module_t *vma_module, void *addr, size_t size,
                              mca_rcache_base_registration_t **reg)
 {
@@ -75,7 +101,17 @@ int mca_rcache_base_vma_find(mca_rcache_base_vma_module_t *vma_module, void *add
         return rc;
     }
 
-    *reg = mca_rcache_base_vma_tree_find(vma_module, (unsigned char *) addr, bound_addr);
+    if (NULL != vma_module->index) {
+        int token = mca_rcache_base_vma_index_reader_enter(vma_module);
+        *reg = mca_rcache_base_vma_index_find(vma_module, (unsigned char *) addr, bound_addr);
+        mca_rcache_base_vma_index_reader_exit(vma_module, token);
+    } else {
+        *reg = NULL;
+    }
+
+    if (NULL == *reg) {
+        *reg = mca_rcache_base_vma_tree_find(vma_module, (unsigned char *) addr, bound_addr);
+    }
 
     return OPAL_SUCCESS;
 }
@@ -125,6 +161,7 @@ int mca_rcache_base_vma_insert(mca_rcache_base_vma_module_t *vma_module,
         /* If we successfully registered, then tell the memory manager
            to start monitoring this region */
         opal_memory->memoryc_register(reg->base, (uint64_t) reg_size, (uint64_t)(uintptr_t) reg);
+        mca_rcache_base_vma_index_insert(vma_module, reg);
     }
 
     return rc;
@@ -137,6 +174,7 @@ int mca_rcache_base_vma_delete(mca_rcache_base_vma_module_t *vma_module,
        region */
     opal_memory->memoryc_deregister(reg->base, (uint64_t)(reg->bound - reg->base),
                                     (uint64_t)(uintptr_t) reg);
+    mca_rcache_base_vma_index_delete(vma_module, reg);
     return mca_rcache_base_vma_tree_delete(vma_module, reg);
 }
 
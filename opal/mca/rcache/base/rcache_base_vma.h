@@ -40,6 +40,16 @@ BEGIN_C_DECLS
 
 struct mca_rcache_base_registration_t;
 
+/** maximum number of reader slots of the page index */
+#define MCA_RCACHE_BASE_VMA_INDEX_MAX_READERS 128
+
+/** reader slot of the page index. each slot has its own cache line. */
+struct mca_rcache_base_vma_index_reader_t {
+    opal_atomic_uint32_t epoch;
+    char padding[64 - sizeof(opal_atomic_uint32_t)];
+};
+typedef struct mca_rcache_base_vma_index_reader_t mca_rcache_base_vma_index_reader_t;
+
 struct mca_rcache_base_vma_module_t {
     opal_object_t super;
     opal_interval_tree_t tree;
@@ -47,24 +57,76 @@ struct mca_rcache_base_vma_module_t {
     opal_lifo_t vma_gc_lifo;
     size_t reg_cur_cache_size;
     opal_mutex_t vma_lock;
+    /** lock-free page index in front of the tree. NULL if not enabled. */
+    opal_atomic_intptr_t *index;
+    unsigned int index_page_shift;
+    size_t index_max_pages;
+    /** epochs of the page index readers. a deleted registration is only
+     * recycled once all readers that might have seen it are gone. */
+    mca_rcache_base_vma_index_reader_t *index_readers;
+    opal_atomic_uint32_t index_epoch;
+    opal_atomic_int32_t index_reader_count;
 };
 typedef struct mca_rcache_base_vma_module_t mca_rcache_base_vma_module_t;
 
 OBJ_CLASS_DECLARATION(mca_rcache_base_vma_module_t);
 
-mca_rcache_base_vma_module_t *mca_rcache_base_vma_module_alloc(void);
+OPAL_DECLSPEC mca_rcache_base_vma_module_t *mca_rcache_base_vma_module_alloc(void);
+
+/**
+ * Enable the page index of a vma module.
+ *
+ * @param[in] vma_module  vma tree
+ * @param[in] max_pages   maximum number of pages indexed per registration
+ *
+ * Registrations inserted after this call are also added to a page granular
+ * index which is searched by mca_rcache_base_vma_lookup() and
+ * mca_rcache_base_vma_find() without taking any lock. Readers of the index
+ * are tracked with epochs, and mca_rcache_base_vma_delete() waits until
+ * no reader can still hold the deleted registration before returning.
+ */
+OPAL_DECLSPEC int mca_rcache_base_vma_enable_index(mca_rcache_base_vma_module_t *vma_module,
+                                                   size_t max_pages);
+
+/**
+ * Enter a page index read-side critical section.
+ *
+ * @returns a token to pass to mca_rcache_base_vma_reader_exit()
+ *
+ * A registration returned by mca_rcache_base_vma_lookup() stays valid memory
+ * (it is not deleted and recycled) until the section is left. Sections must
+ * be short and must not be nested, and the caller must not delete a
+ * registration from the vma module while it is inside one.
+ */
+OPAL_DECLSPEC int mca_rcache_base_vma_reader_enter(mca_rcache_base_vma_module_t *vma_module);
+
+OPAL_DECLSPEC void mca_rcache_base_vma_reader_exit(mca_rcache_base_vma_module_t *vma_module,
+                                                   int token);
+
+/**
+ * Lock-free lookup of a registration covering [base, bound].
+ *
+ * Returns NULL if the page index is not enabled or has no usable candidate. Must
+ * be called inside a read-side critical section. The returned registration may
+ * still be invalidated concurrently and must be validated by the caller.
+ */
+OPAL_DECLSPEC struct mca_rcache_base_registration_t *
+mca_rcache_base_vma_lookup(mca_rcache_base_vma_module_t *vma_module, unsigned char *base,
+                           unsigned char *bound);
 
-int mca_rcache_base_vma_find(mca_rcache_base_vma_module_t *vma_module, void *addr, size_t size,
-                             struct mca_rcache_base_registration_t **reg);
+OPAL_DECLSPEC int mca_rcache_base_vma_find(mca_rcache_base_vma_module_t *vma_module, void *addr,
+                                           size_t size,
+                                           struct mca_rcache_base_registration_t **reg);
 
 int mca_rcache_base_vma_find_all(mca_rcache_base_vma_module_t *vma_module, void *addr, size_t size,
                                  struct mca_rcache_base_registration_t **regs, int reg_cnt);
 
-int mca_rcache_base_vma_insert(mca_rcache_base_vma_module_t *vma_module,
-                               struct mca_rcache_base_registration_t *registration, size_t limit);
+OPAL_DECLSPEC int mca_rcache_base_vma_insert(mca_rcache_base_vma_module_t *vma_module,
+                                             struct mca_rcache_base_registration_t *registration,
+                                             size_t limit);
 
-int mca_rcache_base_vma_delete(mca_rcache_base_vma_module_t *vma_module,
-                               struct mca_rcache_base_registration_t *registration);
+OPAL_DECLSPEC int mca_rcache_base_vma_delete(mca_rcache_base_vma_module_t *vma_module,
+                                             struct mca_rcache_base_registration_t *registration);
 
 void mca_rcache_base_vma_dump_range(mca_rcache_base_vma_module_t *vma_module, unsigned char *base,
                                     size_t size, char *msg);
@@ -85,10 +147,11 @@ void mca_rcache_base_vma_dump_range(mca_rcache_base_vma_module_t *vma_module, un
  * from the callback. The iteration will terminate if the callback returns anything
  * other than OPAL_SUCCESS.
  */
-int mca_rcache_base_vma_iterate(mca_rcache_base_vma_module_t *vma_module, unsigned char *base,
-                                size_t size, bool partial_ok,
-                                int (*callback_fn)(struct mca_rcache_base_registration_t *, void *),
-                                void *ctx);
+OPAL_DECLSPEC int
+mca_rcache_base_vma_iterate(mca_rcache_base_vma_module_t *vma_module, unsigned char *base,
+                            size_t size, bool partial_ok,
+                            int (*callback_fn)(struct mca_rcache_base_registration_t *, void *),
+                            void *ctx);
 
 size_t mca_rcache_base_vma_size(mca_rcache_base_vma_module_t *vma_module);
 
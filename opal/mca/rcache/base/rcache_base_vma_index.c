@@ -0,0 +1,318 @@
+/* -*- Mode: C; c-basic-offset:4 ; indent-tabs-mode:nil -*- */
+/*
+ * $COPYRIGHT$
+ *
+ * Additional copyrights may follow
+ *
+ * $HEADER$
+ */
+
+#include "opal_config.h"
+
+#include <limits.h>
+#include <stdlib.h>
+
+#include "opal/mca/threads/thread_usage.h"
+#include "opal/sys/atomic.h"
+#include "opal/util/sys_limits.h"
+#include "rcache_base_vma_index.h"
+
+#define MCA_RCACHE_BASE_VMA_INDEX_FANOUT (1 << MCA_RCACHE_BASE_VMA_INDEX_BITS)
+#define MCA_RCACHE_BASE_VMA_INDEX_MASK   (MCA_RCACHE_BASE_VMA_INDEX_FANOUT - 1)
+
+/* next reader slot handed out. threads keep their slot so readers on
+ * different threads do not share a cache line. */
+static opal_atomic_int32_t mca_rcache_base_vma_index_next_reader = 0;
+#if OPAL_HAVE_THREAD_LOCAL
+static opal_thread_local int32_t mca_rcache_base_vma_index_my_reader = -1;
+#endif
+
+static inline opal_atomic_intptr_t *mca_rcache_base_vma_index_node_alloc(void)
+{
+    return (opal_atomic_intptr_t *) calloc(MCA_RCACHE_BASE_VMA_INDEX_FANOUT,
+                                           sizeof(opal_atomic_intptr_t));
+}
+
+static void mca_rcache_base_vma_index_node_free(opal_atomic_intptr_t *node, int level)
+{
+    if (level > 0) {
+        for (int i = 0; i < MCA_RCACHE_BASE_VMA_INDEX_FANOUT; ++i) {
+            if (node[i]) {
+                mca_rcache_base_vma_index_node_free((opal_atomic_intptr_t *) node[i], level - 1);
+            }
+        }
+    }
+
+    free((void *) node);
+}
+
+/**
+ * Returns the leaf entry of a page, allocating interior nodes if requested
+ */
+static opal_atomic_intptr_t *
+mca_rcache_base_vma_index_entry(mca_rcache_base_vma_module_t *vma_module, uintptr_t page,
+                                bool create)
+{
+    opal_atomic_intptr_t *node = vma_module->index;
+
+    if (OPAL_UNLIKELY(page
+                      >> (MCA_RCACHE_BASE_VMA_INDEX_BITS * MCA_RCACHE_BASE_VMA_INDEX_LEVELS))) {
+        /* outside of the range covered by the index */
+        return NULL;
+    }
+
+    for (int level = MCA_RCACHE_BASE_VMA_INDEX_LEVELS - 1; level > 0; --level) {
+        opal_atomic_intptr_t *entry = node
+                                      + ((page >> (level * MCA_RCACHE_BASE_VMA_INDEX_BITS))
+                                         & MCA_RCACHE_BASE_VMA_INDEX_MASK);
+        intptr_t child = *entry;
+
+        if (0 == child) {
+            intptr_t expected = 0;
+
+            if (!create) {
+                return NULL;
+            }
+
+            child = (intptr_t) mca_rcache_base_vma_index_node_alloc();
+            if (OPAL_UNLIKELY(0 == child)) {
+                return NULL;
+            }
+
+            /* publish the new node. if another thread beat us to it use its node instead */
+            if (!opal_atomic_compare_exchange_strong_ptr(entry, &expected, child)) {
+                free((void *) child);
+                child = expected;
+            }
+        }
+
+        node = (opal_atomic_intptr_t *) child;
+    }
+
+    return node + (page & MCA_RCACHE_BASE_VMA_INDEX_MASK);
+}
+
+int mca_rcache_base_vma_index_init(mca_rcache_base_vma_module_t *vma_module, size_t max_pages)
+{
+    size_t page_size = opal_getpagesize();
+    opal_atomic_intptr_t *root;
+
+    if (NULL != vma_module->index || 0 == max_pages) {
+        return OPAL_SUCCESS;
+    }
+
+    if (0 != posix_memalign((void **) &vma_module->index_readers, 64,
+                            MCA_RCACHE_BASE_VMA_INDEX_MAX_READERS
+                                * sizeof(mca_rcache_base_vma_index_reader_t))) {
+        vma_module->index_readers = NULL;
+        return OPAL_ERR_OUT_OF_RESOURCE;
+    }
+
+    /* UINT_MAX marks an unused slot. the epoch never takes this value. */
+    for (int i = 0; i < MCA_RCACHE_BASE_VMA_INDEX_MAX_READERS; ++i) {
+        vma_module->index_readers[i].epoch = UINT_MAX;
+    }
+    vma_module->index_epoch = 0;
+    vma_module->index_reader_count = 0;
+
+    root = mca_rcache_base_vma_index_node_alloc();
+    if (NULL == root) {
+        free(vma_module->index_readers);
+        vma_module->index_readers = NULL;
+        return OPAL_ERR_OUT_OF_RESOURCE;
+    }
+
+    for (vma_module->index_page_shift = 0; page_size > 1; page_size >>= 1) {
+        ++vma_module->index_page_shift;
+    }
+
+    vma_module->index_max_pages = max_pages;
+
+    opal_atomic_wmb();
+    vma_module->index = root;
+
+    return OPAL_SUCCESS;
+}
+
+void mca_rcache_base_vma_index_finalize(mca_rcache_base_vma_module_t *vma_module)
+{
+    if (NULL != vma_module->index) {
+        mca_rcache_base_vma_index_node_free(vma_module->index,
+                                            MCA_RCACHE_BASE_VMA_INDEX_LEVELS - 1);
+        vma_module->index = NULL;
+    }
+
+    free(vma_module->index_readers);
+    vma_module->index_readers = NULL;
+}
+
+int mca_rcache_base_vma_index_reader_enter(mca_rcache_base_vma_module_t *vma_module)
+{
+    int32_t token, reader_count;
+
+    if (NULL == vma_module->index) {
+        return -1;
+    }
+
+#if OPAL_HAVE_THREAD_LOCAL
+    if (mca_rcache_base_vma_index_my_reader < 0) {
+        mca_rcache_base_vma_index_my_reader
+            = opal_atomic_fetch_add_32(&mca_rcache_base_vma_index_next_reader, 1)
+              % MCA_RCACHE_BASE_VMA_INDEX_MAX_READERS;
+    }
+    token = mca_rcache_base_vma_index_my_reader;
+#else
+    token = opal_atomic_fetch_add_32(&mca_rcache_base_vma_index_next_reader, 1)
+            % MCA_RCACHE_BASE_VMA_INDEX_MAX_READERS;
+#endif
+
+    /* make sure writers look at this slot */
+    reader_count = vma_module->index_reader_count;
+    while (OPAL_UNLIKELY(reader_count <= token)) {
+        if (opal_atomic_compare_exchange_strong_32(&vma_module->index_reader_count, &reader_count,
+                                                   token + 1)) {
+            break;
+        }
+    }
+
+    /* the slot may be shared with another thread. wait until it is free. */
+    while (!opal_atomic_compare_exchange_strong_32(
+        (opal_atomic_int32_t *) &vma_module->index_readers[token].epoch, &(int32_t){UINT_MAX},
+        (int32_t) vma_module->index_epoch)) {
+    }
+
+    return token;
+}
+
+void mca_rcache_base_vma_index_reader_exit(mca_rcache_base_vma_module_t *vma_module, int token)
+{
+    if (token >= 0) {
+        /* make sure all reads of the section are done before leaving */
+        opal_atomic_mb();
+        vma_module->index_readers[token].epoch = UINT_MAX;
+    }
+}
+
+/* wait for all readers that entered before the call */
+static void mca_rcache_base_vma_index_wait_for_readers(mca_rcache_base_vma_module_t *vma_module)
+{
+    int32_t old_epoch = (int32_t) vma_module->index_epoch;
+    uint32_t epoch;
+
+    /* skip the unused slot marker when the epoch wraps around */
+    do {
+        epoch = (uint32_t) old_epoch + 1;
+        if (UINT_MAX == epoch) {
+            epoch = 0;
+        }
+    } while (!opal_atomic_compare_exchange_strong_32(
+        (opal_atomic_int32_t *) &vma_module->index_epoch, &old_epoch, (int32_t) epoch));
+
+    /* compare the difference so the check still holds after a wrap. the
+     * epoch of a reader is only misread if it stays for 2^31 updates. */
+    for (int i = 0; i < vma_module->index_reader_count; ++i) {
+        uint32_t reader_epoch;
+
+        while (UINT_MAX != (reader_epoch = vma_module->index_readers[i].epoch)
+               && (int32_t) (reader_epoch - epoch) < 0) {
+            opal_atomic_rmb();
+        }
+    }
+}
+
+mca_rcache_base_registration_t *
+mca_rcache_base_vma_index_find(mca_rcache_base_vma_module_t *vma_module, unsigned char *base,
+                               unsigned char *bound)
+{
+    mca_rcache_base_registration_t *reg;
+    opal_atomic_intptr_t *entry;
+
+    if (NULL == vma_module->index) {
+        return NULL;
+    }
+
+    entry = mca_rcache_base_vma_index_entry(vma_module,
+                                            (uintptr_t) base >> vma_module->index_page_shift,
+                                            false);
+    if (NULL == entry) {
+        return NULL;
+    }
+
+    reg = (mca_rcache_base_registration_t *) *entry;
+    if (NULL == reg || (reg->flags & MCA_RCACHE_FLAGS_INVALID) || reg->base > base
+        || reg->bound < bound) {
+        return NULL;
+    }
+
+    return reg;
+}
+
+void mca_rcache_base_vma_index_insert(mca_rcache_base_vma_module_t *vma_module,
+                                      mca_rcache_base_registration_t *reg)
+{
+    uintptr_t first, last;
+
+    if (NULL == vma_module->index) {
+        return;
+    }
+
+    /* large registrations are only indexed up to index_max_pages. lookups starting past
+     * that point will be resolved by the tree. */
+    first = (uintptr_t) reg->base >> vma_module->index_page_shift;
+    last = (uintptr_t) reg->bound >> vma_module->index_page_shift;
+    if (last - first >= vma_module->index_max_pages) {
+        last = first + vma_module->index_max_pages - 1;
+    }
+
+    for (uintptr_t page = first; page <= last; ++page) {
+        opal_atomic_intptr_t *entry = mca_rcache_base_vma_index_entry(vma_module, page, true);
+        intptr_t current;
+
+        if (NULL == entry) {
+            /* the registration is still in the tree so this is not an error */
+            break;
+        }
+
+        current = *entry;
+        do {
+            mca_rcache_base_registration_t *old_reg = (mca_rcache_base_registration_t *) current;
+
+            /* keep the larger of the two registrations. it satisfies more lookups. */
+            if (NULL != old_reg && !(old_reg->flags & MCA_RCACHE_FLAGS_INVALID)
+                && (old_reg->bound - old_reg->base) >= (reg->bound - reg->base)) {
+                break;
+            }
+        } while (!opal_atomic_compare_exchange_strong_ptr(entry, &current, (intptr_t) reg));
+    }
+}
+
+void mca_rcache_base_vma_index_delete(mca_rcache_base_vma_module_t *vma_module,
+                                      mca_rcache_base_registration_t *reg)
+{
+    uintptr_t first, last;
+
+    if (NULL == vma_module->index) {
+        return;
+    }
+
+    first = (uintptr_t) reg->base >> vma_module->index_page_shift;
+    last = (uintptr_t) reg->bound >> vma_module->index_page_shift;
+    if (last - first >= vma_module->index_max_pages) {
+        last = first + vma_module->index_max_pages - 1;
+    }
+
+    for (uintptr_t page = first; page <= last; ++page) {
+        opal_atomic_intptr_t *entry = mca_rcache_base_vma_index_entry(vma_module, page, false);
+        intptr_t expected = (intptr_t) reg;
+
+        if (NULL != entry) {
+            /* only clear entries that still refer to this registration */
+            (void) opal_atomic_compare_exchange_strong_ptr(entry, &expected, 0);
+        }
+    }
+
+    /* a reader may have found the registration before its entries were
+     * cleared (or overwritten by a larger registration). it must be done
+     * with it before the caller recycles the registration. */
+    mca_rcache_base_vma_index_wait_for_readers(vma_module);
+}
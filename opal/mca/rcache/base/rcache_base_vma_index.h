@@ -0,0 +1,76 @@
+/* -*- Mode: C; c-basic-offset:4 ; indent-tabs-mode:nil -*- */
+/*
+ * $COPYRIGHT$
+ *
+ * Additional copyrights may follow
+ *
+ * $HEADER$
+ */
+/**
+ * @file
+ * Registation cache page index
+ *
+ * Page granular radix index that sits in front of the vma tree. Each
+ * indexed page points to (at most) one registration covering it. The
+ * index is read without any lock: interior nodes are published with a
+ * compare-and-swap and are never released before the vma module is
+ * destroyed, and leaf entries are updated atomically.
+ *
+ * Readers announce themselves in a reader slot with the current epoch,
+ * like the readers of the interval tree. Deleting a registration clears
+ * its entries, advances the epoch and waits for the readers of older
+ * epochs to leave, so a registration is never recycled while a reader
+ * might still use it. A registration returned by the index may still be
+ * invalidated concurrently so the caller must validate it the same way
+ * it validates registrations returned by a tree traversal.
+ */
+#ifndef MCA_RCACHE_BASE_VMA_INDEX_H
+#define MCA_RCACHE_BASE_VMA_INDEX_H
+
+#include "opal_config.h"
+
+#include "opal/mca/rcache/rcache.h"
+#include "rcache_base_vma.h"
+
+/** bits of the page number resolved by each level of the index */
+#define MCA_RCACHE_BASE_VMA_INDEX_BITS   12
+/** number of levels. with 4k pages this covers 48-bit virtual addresses */
+#define MCA_RCACHE_BASE_VMA_INDEX_LEVELS 3
+
+/*
+ * enable the index
+ */
+int mca_rcache_base_vma_index_init(mca_rcache_base_vma_module_t *vma_module, size_t max_pages);
+
+/*
+ * release all index nodes. must only be called when there are no readers left.
+ */
+void mca_rcache_base_vma_index_finalize(mca_rcache_base_vma_module_t *vma_module);
+
+/*
+ * enter and leave a read-side critical section
+ */
+int mca_rcache_base_vma_index_reader_enter(mca_rcache_base_vma_module_t *vma_module);
+void mca_rcache_base_vma_index_reader_exit(mca_rcache_base_vma_module_t *vma_module, int token);
+
+/**
+ * Returns a registration covering [base, bound] or NULL
+ */
+mca_rcache_base_registration_t *
+mca_rcache_base_vma_index_find(mca_rcache_base_vma_module_t *vma_module, unsigned char *base,
+                               unsigned char *bound);
+
+/*
+ * add the pages of a registration to the index
+ */
+void mca_rcache_base_vma_index_insert(mca_rcache_base_vma_module_t *vma_module,
+                                      mca_rcache_base_registration_t *reg);
+
+/*
+ * remove all references to a registration from the index and wait for the
+ * readers that might still hold it
+ */
+void mca_rcache_base_vma_index_delete(mca_rcache_base_vma_module_t *vma_module,
+                                      mca_rcache_base_registration_t *reg);
+
+#endif /* MCA_RCACHE_BASE_VMA_INDEX_H */
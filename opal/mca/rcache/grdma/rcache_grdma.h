@@ -57,6 +57,11 @@ struct mca_rcache_grdma_component_t {
     char *rcache_name;
     bool print_stats;
     int leave_pinned;
+    unsigned int index_max_pages;
+    /* performance variables (summed over all grdma modules) */
+    opal_atomic_size_t pvar_cache_hit;
+    opal_atomic_size_t pvar_cache_miss;
+    opal_atomic_size_t pvar_evicted;
 };
 typedef struct mca_rcache_grdma_component_t mca_rcache_grdma_component_t;
 
@@ -25,6 +25,7 @@
 #define OPAL_DISABLE_ENABLE_MEM_DEBUG 1
 #include "opal_config.h"
 #include "opal/mca/base/base.h"
+#include "opal/mca/base/mca_base_pvar.h"
 #include "opal/runtime/opal_params.h"
 #include "rcache_grdma.h"
 #ifdef HAVE_UNISTD_H
@@ -82,6 +83,38 @@ static int grdma_register(void)
         NULL, 0, 0, OPAL_INFO_LVL_9, MCA_BASE_VAR_SCOPE_READONLY,
         &mca_rcache_grdma_component.print_stats);
 
+    mca_rcache_grdma_component.index_max_pages = 1024;
+    (void) mca_base_component_var_register(
+        &mca_rcache_grdma_component.super.rcache_version, "index_max_pages",
+        "Maximum number of pages of each registration added to the lock-free page index "
+        "searched before the registration tree. 0 disables the index (default: 1024)",
+        MCA_BASE_VAR_TYPE_UNSIGNED_INT, NULL, 0, 0, OPAL_INFO_LVL_9, MCA_BASE_VAR_SCOPE_READONLY,
+        &mca_rcache_grdma_component.index_max_pages);
+
+    mca_rcache_grdma_component.pvar_cache_hit = 0;
+    (void) mca_base_component_pvar_register(
+        &mca_rcache_grdma_component.super.rcache_version, "cache_hit",
+        "Number of registration requests satisfied by an existing registration",
+        OPAL_INFO_LVL_4, MCA_BASE_PVAR_CLASS_COUNTER, MCA_BASE_VAR_TYPE_UNSIGNED_LONG, NULL,
+        MCA_BASE_VAR_BIND_NO_OBJECT, MCA_BASE_PVAR_FLAG_READONLY | MCA_BASE_PVAR_FLAG_CONTINUOUS,
+        NULL, NULL, NULL, (void *) &mca_rcache_grdma_component.pvar_cache_hit);
+
+    mca_rcache_grdma_component.pvar_cache_miss = 0;
+    (void) mca_base_component_pvar_register(
+        &mca_rcache_grdma_component.super.rcache_version, "cache_miss",
+        "Number of registration requests that required registering memory",
+        OPAL_INFO_LVL_4, MCA_BASE_PVAR_CLASS_COUNTER, MCA_BASE_VAR_TYPE_UNSIGNED_LONG, NULL,
+        MCA_BASE_VAR_BIND_NO_OBJECT, MCA_BASE_PVAR_FLAG_READONLY | MCA_BASE_PVAR_FLAG_CONTINUOUS,
+        NULL, NULL, NULL, (void *) &mca_rcache_grdma_component.pvar_cache_miss);
+
+    mca_rcache_grdma_component.pvar_evicted = 0;
+    (void) mca_base_component_pvar_register(
+        &mca_rcache_grdma_component.super.rcache_version, "evicted",
+        "Number of unused registrations evicted from the cache to make room for new ones",
+        OPAL_INFO_LVL_4, MCA_BASE_PVAR_CLASS_COUNTER, MCA_BASE_VAR_TYPE_UNSIGNED_LONG, NULL,
+        MCA_BASE_VAR_BIND_NO_OBJECT, MCA_BASE_PVAR_FLAG_READONLY | MCA_BASE_PVAR_FLAG_CONTINUOUS,
+        NULL, NULL, NULL, (void *) &mca_rcache_grdma_component.pvar_evicted);
+
     return OPAL_SUCCESS;
 }
 
@@ -86,6 +86,12 @@ static void mca_rcache_grdma_cache_contructor(mca_rcache_grdma_cache_t *cache)
     OBJ_CONSTRUCT(&cache->gc_lifo, opal_lifo_t);
 
     cache->vma_module = mca_rcache_base_vma_module_alloc();
+    if (NULL != cache->vma_module) {
+        /* registrations are returned to the module free list when they are deleted so
+         * it is safe to look them up without holding any lock */
+        (void) mca_rcache_base_vma_enable_index(cache->vma_module,
+                                                mca_rcache_grdma_component.index_max_pages);
+    }
 }
 
 static void mca_rcache_grdma_cache_destructor(mca_rcache_grdma_cache_t *cache)
@@ -137,6 +143,8 @@ static inline int dereg_mem(mca_rcache_base_registration_t *reg)
     mca_rcache_grdma_module_t *rcache_grdma = (mca_rcache_grdma_module_t *) reg->rcache;
     int rc;
 
+    /* make sure lookups racing with the destruction reject this registration */
+    opal_atomic_fetch_or_32((opal_atomic_int32_t *) &reg->flags, MCA_RCACHE_FLAGS_INVALID);
     reg->ref_count = 0;
 
     if (!(reg->flags & MCA_RCACHE_FLAGS_CACHE_BYPASS)) {
@@ -219,6 +227,7 @@ static inline bool mca_rcache_grdma_evict_lru_local(mca_rcache_grdma_cache_t *ca
 
     (void) dereg_mem(old_reg);
     rcache_grdma->stat_evicted++;
+    (void) OPAL_THREAD_ADD_FETCH_SIZE_T(&mca_rcache_grdma_component.pvar_evicted, 1);
 
     return true;
 }
@@ -291,6 +300,23 @@ static int mca_rcache_grdma_check_cached(mca_rcache_base_registration_t *grdma_r
     }
 
     int32_t ref_cnt = opal_atomic_fetch_add_32(&grdma_reg->ref_count, 1);
+    int32_t flags = grdma_reg->flags;
+
+    /* the state of the registration may have changed while the reference was taken. an
+     * unreferenced registration that is not (and will not be) in the LRU is being
+     * destroyed, and a referenced one may have been invalidated. */
+    if (OPAL_UNLIKELY(0 == ref_cnt ? !(flags & MCA_RCACHE_GRDMA_REG_FLAG_IN_LRU)
+                                         && !registration_flags_cacheable(flags)
+                                   : (flags & MCA_RCACHE_FLAGS_INVALID))) {
+        if (0 == opal_atomic_add_fetch_32(&grdma_reg->ref_count, -1) && 0 != ref_cnt) {
+            /* all the other references were dropped in the meantime so it is up to
+             * this thread to get rid of the registration. it can't be deregistered
+             * here as there may be readers in progress (including this one). */
+            opal_lifo_push_atomic(&rcache_grdma->cache->gc_lifo, (opal_list_item_t *) grdma_reg);
+        }
+        return 0;
+    }
+
     args->reg = grdma_reg;
 
     if (0 == ref_cnt) {
@@ -299,6 +325,7 @@ static int mca_rcache_grdma_check_cached(mca_rcache_base_registration_t *grdma_r
 
     /* This segment fits fully within an existing segment. */
     (void) opal_atomic_fetch_add_32((opal_atomic_int32_t *) &rcache_grdma->stat_cache_hit, 1);
+    (void) OPAL_THREAD_ADD_FETCH_SIZE_T(&mca_rcache_grdma_component.pvar_cache_hit, 1);
     OPAL_OUTPUT_VERBOSE((MCA_BASE_VERBOSE_TRACE, opal_rcache_base_framework.framework_output,
                          "returning existing registration %p. references %d", (void *) grdma_reg,
                          ref_cnt));
@@ -319,7 +346,7 @@ static int mca_rcache_grdma_register(mca_rcache_base_module_t *rcache, void *add
     opal_free_list_item_t *item;
     unsigned char *base, *bound;
     unsigned int page_size = opal_getpagesize();
-    int rc;
+    int rc, token;
 
     *reg = NULL;
 
@@ -348,6 +375,19 @@ static int mca_rcache_grdma_register(mca_rcache_base_module_t *rcache, void *add
                                                  .base = base,
                                                  .bound = bound,
                                                  .access_flags = access_flags};
+
+        /* try the page index first. this avoids walking the tree for the common case of
+         * reusing a buffer that is already registered. the registration can not be
+         * recycled before the read-side section is left. */
+        token = mca_rcache_base_vma_reader_enter(rcache_grdma->cache->vma_module);
+        grdma_reg = mca_rcache_base_vma_lookup(rcache_grdma->cache->vma_module, base, bound);
+        rc = (NULL != grdma_reg) ? mca_rcache_grdma_check_cached(grdma_reg, &find_args) : 0;
+        mca_rcache_base_vma_reader_exit(rcache_grdma->cache->vma_module, token);
+        if (1 == rc) {
+            *reg = find_args.reg;
+            return OPAL_SUCCESS;
+        }
+
         /* check to see if memory is registered */
         rc = mca_rcache_base_vma_iterate(rcache_grdma->cache->vma_module, base, size, false,
                                          mca_rcache_grdma_check_cached, (void *) &find_args);
@@ -360,6 +400,7 @@ static int mca_rcache_grdma_register(mca_rcache_base_module_t *rcache, void *add
         access_flags = find_args.access_flags;
 
         OPAL_THREAD_ADD_FETCH32((opal_atomic_int32_t *) &rcache_grdma->stat_cache_miss, 1);
+        (void) OPAL_THREAD_ADD_FETCH_SIZE_T(&mca_rcache_grdma_component.pvar_cache_miss, 1);
     }
 
     item = opal_free_list_get_mt(&rcache_grdma->reg_list);
@@ -172,6 +172,30 @@ int opal_register_params(void)
                                 &opal_progress_yield_when_idle);
 #endif
 
+    opal_progress_shard = false;
+    ret = mca_base_var_register("opal", "opal", "progress", "shard",
+                                "With multiple threads, let each thread calling opal_progress start "
+                                "with a different progress callback and skip the callbacks already "
+                                "being progressed by another thread, instead of having all the "
+                                "threads contend on the same callbacks",
+                                MCA_BASE_VAR_TYPE_BOOL, NULL, 0, 0, OPAL_INFO_LVL_8,
+                                MCA_BASE_VAR_SCOPE_LOCAL, &opal_progress_shard);
+    if (0 > ret) {
+        return ret;
+    }
+
+    opal_progress_threads = 0;
+    ret = mca_base_var_register("opal", "opal", "progress", "threads",
+                                "Number of dedicated threads progressing the communication "
+                                "callbacks when running with multiple threads (0 = none, the "
+                                "threads waiting for completion progress the callbacks). Each "
+                                "callback is pinned to one of the progress threads",
+                                MCA_BASE_VAR_TYPE_INT, NULL, 0, 0, OPAL_INFO_LVL_8,
+                                MCA_BASE_VAR_SCOPE_LOCAL, &opal_progress_threads);
+    if (0 > ret) {
+        return ret;
+    }
+
 #if OPAL_ENABLE_DEBUG
     opal_progress_debug = false;
     ret = mca_base_var_register("opal", "opal", "progress", "debug",
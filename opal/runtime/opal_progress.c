@@ -34,6 +34,7 @@
 #include "opal/runtime/opal.h"
 #include "opal/runtime/opal_params.h"
 #include "opal/runtime/opal_progress.h"
+#include "opal/runtime/opal_progress_threads.h"
 #include "opal/util/event.h"
 #include "opal/util/output.h"
 
@@ -49,6 +50,8 @@ bool opal_progress_debug = false;
  */
 static int opal_progress_event_flag = OPAL_EVLOOP_ONCE | OPAL_EVLOOP_NONBLOCK;
 int opal_progress_spin_count = 10000;
+bool opal_progress_shard = false;
+int opal_progress_threads = 0;
 
 /*
  * Local variables
@@ -64,6 +67,21 @@ static volatile opal_progress_callback_t *callbacks_lp = NULL;
 static size_t callbacks_lp_len = 0;
 static size_t callbacks_lp_size = 0;
 
+/* With sharding, a callback is progressed by a single thread at a time:
+ * the other threads skip it instead of contending on its internal
+ * locks. Callbacks are mapped to the locks by their index. */
+#define OPAL_PROGRESS_SHARD_LOCKS 64
+static opal_atomic_lock_t callbacks_locks[OPAL_PROGRESS_SHARD_LOCKS];
+
+/* index of the first callback progressed by the next thread */
+static opal_atomic_int32_t next_shard = 0;
+#if OPAL_HAVE_THREAD_LOCAL
+static opal_thread_local int32_t my_shard = -1;
+#endif
+
+/* number of running dedicated progress threads */
+static int progress_threads_running = 0;
+
 /* do we want to yield() if nothing happened */
 bool opal_progress_yield_when_idle = false;
 
@@ -103,6 +121,8 @@ static int _opal_progress_unregister(opal_progress_callback_t cb,
 
 static void opal_progress_finalize(void)
 {
+    opal_progress_stop_threads();
+
     /* free memory associated with the callbacks */
     opal_atomic_lock(&progress_lock);
 
@@ -124,6 +144,9 @@ int opal_progress_init(void)
 {
     /* reentrant issues */
     opal_atomic_lock_init(&progress_lock, OPAL_ATOMIC_LOCK_UNLOCKED);
+    for (int i = 0; i < OPAL_PROGRESS_SHARD_LOCKS; ++i) {
+        opal_atomic_lock_init(&callbacks_locks[i], OPAL_ATOMIC_LOCK_UNLOCKED);
+    }
 
     /* set the event tick rate */
     opal_progress_set_event_poll_rate(10000);
@@ -202,6 +225,113 @@ static int opal_progress_events(void)
     return events;
 }
 
+/* Run the callback at index i unless another thread is already running it */
+static inline int opal_progress_shard_callback(size_t i)
+{
+    opal_atomic_lock_t *lock = &callbacks_locks[i % OPAL_PROGRESS_SHARD_LOCKS];
+    int events;
+
+    if (opal_atomic_trylock(lock)) {
+        return 0;
+    }
+    events = (callbacks[i])();
+    opal_atomic_unlock(lock);
+
+    return events;
+}
+
+/*
+ * Progress all the callbacks, starting from a different one in each
+ * thread so that concurrent threads spread over different callbacks.
+ */
+static int opal_progress_sharded(void)
+{
+    size_t len = callbacks_len, first;
+    int events = 0;
+
+    if (0 == len) {
+        return 0;
+    }
+#if OPAL_HAVE_THREAD_LOCAL
+    if (my_shard < 0) {
+        my_shard = opal_atomic_fetch_add_32(&next_shard, 1) & INT32_MAX;
+    }
+    first = (size_t) my_shard % len;
+#else
+    first = (size_t) (opal_atomic_fetch_add_32(&next_shard, 1) & INT32_MAX) % len;
+#endif
+
+    for (size_t n = 0; n < len; ++n) {
+        events += opal_progress_shard_callback((first + n) % len);
+    }
+
+    return events;
+}
+
+/*
+ * Main loop of the dedicated progress thread number id: progress the
+ * callbacks pinned to this thread.
+ */
+static int opal_progress_thread_poll(void *arg)
+{
+    size_t id = (size_t) (intptr_t) arg;
+    int events = 0;
+
+    for (size_t i = id; i < callbacks_len; i += (size_t) opal_progress_threads) {
+        events += opal_progress_shard_callback(i);
+    }
+
+    return events;
+}
+
+static void opal_progress_thread_name(char *name, size_t size, int id)
+{
+    snprintf(name, size, "OPAL progress thread %d", id);
+}
+
+int opal_progress_start_threads(void)
+{
+    char name[64];
+
+    if (opal_progress_threads <= 0 || !opal_using_threads() || progress_threads_running > 0) {
+        return OPAL_SUCCESS;
+    }
+
+    /* the application threads and the progress threads must not run a
+     * callback concurrently */
+    opal_progress_shard = true;
+
+    for (int i = 0; i < opal_progress_threads; ++i) {
+        opal_progress_thread_name(name, sizeof(name), i);
+        if (NULL == opal_progress_thread_poll_init(name, opal_progress_thread_poll,
+                                                   (void *) (intptr_t) i)) {
+            opal_progress_stop_threads();
+            return OPAL_ERR_OUT_OF_RESOURCE;
+        }
+        /* make opal_progress() leave the callbacks to the threads as soon
+         * as one of them is running */
+        ++progress_threads_running;
+    }
+
+    OPAL_OUTPUT((debug_output, "progress: started %d progress threads", progress_threads_running));
+
+    return OPAL_SUCCESS;
+}
+
+void opal_progress_stop_threads(void)
+{
+    char name[64];
+    int running = progress_threads_running;
+
+    progress_threads_running = 0;
+    opal_atomic_wmb();
+
+    for (int i = 0; i < running; ++i) {
+        opal_progress_thread_name(name, sizeof(name), i);
+        (void) opal_progress_thread_finalize(name);
+    }
+}
+
 /*
  * Progress the event library and any functions that have registered to
  * be called.  We don't propogate errors from the progress functions,
@@ -219,9 +349,13 @@ void opal_progress(void)
     size_t i;
     int events = 0;
 
-    /* progress all registered callbacks */
-    for (i = 0; i < callbacks_len; ++i) {
-        events += (callbacks[i])();
+    /* progress all registered callbacks, unless the progress threads do */
+    if (OPAL_LIKELY(!opal_progress_shard || !opal_using_threads())) {
+        for (i = 0; i < callbacks_len; ++i) {
+            events += (callbacks[i])();
+        }
+    } else if (0 == progress_threads_running) {
+        events += opal_progress_sharded();
     }
 
     /* Run low priority callbacks and events once every 8 calls to opal_progress().
@@ -166,8 +166,32 @@ OPAL_DECLSPEC int opal_progress_register_lp(opal_progress_callback_t cb);
  */
 OPAL_DECLSPEC int opal_progress_unregister(opal_progress_callback_t cb);
 
+/**
+ * Start the dedicated progress threads
+ *
+ * If opal_progress_threads is positive and OPAL is using threads,
+ * start that many threads that progress the callbacks registered with
+ * opal_progress_register(), each callback being pinned to one of the
+ * threads. opal_progress() then only progresses the low priority
+ * callbacks and the event library. Must be called once the callbacks
+ * are ready to be called concurrently.
+ */
+OPAL_DECLSPEC int opal_progress_start_threads(void);
+
+/**
+ * Stop the dedicated progress threads, if any
+ */
+OPAL_DECLSPEC void opal_progress_stop_threads(void);
+
 OPAL_DECLSPEC extern int opal_progress_spin_count;
 
+/* do threads calling opal_progress() concurrently skip the callbacks
+ * already being progressed by another thread */
+OPAL_DECLSPEC extern bool opal_progress_shard;
+
+/* number of dedicated progress threads */
+OPAL_DECLSPEC extern int opal_progress_threads;
+
 /* do we want to call sched_yield() if nothing happened */
 OPAL_DECLSPEC extern bool opal_progress_yield_when_idle;
 
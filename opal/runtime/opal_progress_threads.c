@@ -47,6 +47,10 @@ typedef struct {
 
     bool engine_constructed;
     opal_thread_t engine;
+
+    /* polling function of the thread, NULL to block in the event base */
+    opal_progress_thread_poll_fn_t poll;
+    void *poll_arg;
 } opal_progress_tracker_t;
 
 static void tracker_constructor(opal_progress_tracker_t *p)
@@ -56,6 +60,8 @@ static void tracker_constructor(opal_progress_tracker_t *p)
     p->ev_base = NULL;
     p->ev_active = false;
     p->engine_constructed = false;
+    p->poll = NULL;
+    p->poll_arg = NULL;
 }
 
 static void tracker_destructor(opal_progress_tracker_t *p)
@@ -100,6 +106,17 @@ static void *progress_engine(opal_object_t *obj)
     opal_thread_t *t = (opal_thread_t *) obj;
     opal_progress_tracker_t *trk = (opal_progress_tracker_t *) t->t_arg;
 
+    if (NULL != trk->poll) {
+        while (trk->ev_active) {
+            int events = trk->poll(trk->poll_arg);
+            events += opal_event_loop(trk->ev_base, OPAL_EVLOOP_NONBLOCK);
+            if (events <= 0) {
+                opal_thread_yield();
+            }
+        }
+        return OPAL_THREAD_CANCELLED;
+    }
+
     while (trk->ev_active) {
         opal_event_loop(trk->ev_base, OPAL_EVLOOP_ONCE);
     }
@@ -137,6 +154,12 @@ static int start_progress_engine(opal_progress_tracker_t *trk)
 }
 
 opal_event_base_t *opal_progress_thread_init(const char *name)
+{
+    return opal_progress_thread_poll_init(name, NULL, NULL);
+}
+
+opal_event_base_t *opal_progress_thread_poll_init(const char *name,
+                                                 opal_progress_thread_poll_fn_t poll, void *arg)
 {
     opal_progress_tracker_t *trk;
     int rc;
@@ -184,6 +207,9 @@ opal_event_base_t *opal_progress_thread_init(const char *name)
     opal_event_set(trk->ev_base, &trk->block, -1, OPAL_EV_PERSIST, dummy_timeout_cb, trk);
     opal_event_add(&trk->block, &long_timeout);
 
+    trk->poll = poll;
+    trk->poll_arg = arg;
+
     /* construct the thread object */
     OBJ_CONSTRUCT(&trk->engine, opal_thread_t);
     trk->engine_constructed = true;
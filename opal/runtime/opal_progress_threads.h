@@ -33,6 +33,26 @@
  */
 OPAL_DECLSPEC opal_event_base_t *opal_progress_thread_init(const char *name);
 
+/**
+ * Polling function of a progress thread, returning the number of
+ * events progressed.
+ */
+typedef int (*opal_progress_thread_poll_fn_t)(void *arg);
+
+/**
+ * Same as opal_progress_thread_init(), but the progress thread does
+ * not block in its event base: it calls poll(arg) in a loop, and
+ * progresses its event base without blocking in between. The thread
+ * yields the processor when nothing was progressed.
+ *
+ * If a name is passed that was already used in a prior call, the
+ * already-running progress thread is returned and keeps its original
+ * polling function.
+ */
+OPAL_DECLSPEC opal_event_base_t *opal_progress_thread_poll_init(const char *name,
+                                                               opal_progress_thread_poll_fn_t poll,
+                                                               void *arg);
+
 /**
  * Finalize a progress thread name (reference counted).
  *
@@ -16,6 +16,9 @@
 #include "oshmem/mca/mca.h"
 #include "oshmem/mca/atomic/atomic.h"
 #include "oshmem/util/oshmem_util.h"
+#include "oshmem/mca/memheap/memheap.h"
+#include "oshmem/mca/memheap/base/base.h"
+#include "opal/sys/atomic.h"
 
 BEGIN_C_DECLS
 
@@ -26,6 +29,8 @@ BEGIN_C_DECLS
 OSHMEM_MODULE_DECLSPEC extern mca_atomic_base_component_1_0_0_t
 mca_atomic_basic_component;
 
+OSHMEM_MODULE_DECLSPEC extern bool mca_atomic_basic_shm;
+
 OSHMEM_DECLSPEC void atomic_basic_lock(shmem_ctx_t ctx, int pe);
 OSHMEM_DECLSPEC void atomic_basic_unlock(shmem_ctx_t ctx, int pe);
 
@@ -44,6 +49,48 @@ int mca_atomic_basic_cswap(shmem_ctx_t ctx,
                            size_t size,
                            int pe);
 
+/*
+ * When all the PEs run on the same node, the segments attached by every
+ * PE (see mca_memheap_base_mkey_is_shm()) are updated with the processor
+ * atomics instead of the lock. Whether a segment is attached does not
+ * depend on the PE doing the update, so all the updates of a given
+ * variable go through the same path.
+ *
+ * Returns the address of the target in the local mapping of the segment
+ * or NULL if the lock has to be used.
+ */
+static inline void *mca_atomic_basic_shm_addr(shmem_ctx_t ctx, void *target, int pe)
+{
+    sshmem_mkey_t *mkey;
+    void *rva;
+
+    if (!mca_atomic_basic_shm) {
+        return NULL;
+    }
+
+    mkey = mca_memheap_base_get_cached_mkey(ctx, pe, target, 0, &rva);
+    if (OPAL_UNLIKELY(NULL == mkey) || !mca_memheap_base_mkey_is_shm(mkey)) {
+        return NULL;
+    }
+    return rva;
+}
+
+/* return from the calling function if the operation was done in place */
+#define MCA_ATOMIC_BASIC_SHM_FOP(ctx, target, prev, value, size, pe, op)          \
+    do {                                                                          \
+        void *_addr = mca_atomic_basic_shm_addr((ctx), (target), (pe));           \
+        if (NULL != _addr) {                                                      \
+            if (sizeof(uint64_t) == (size)) {                                     \
+                *(int64_t *)(prev) = opal_atomic_##op##_64((opal_atomic_int64_t *)_addr, \
+                                                           (int64_t)(value));     \
+            } else {                                                              \
+                *(int32_t *)(prev) = opal_atomic_##op##_32((opal_atomic_int32_t *)_addr, \
+                                                           (int32_t)(value));     \
+            }                                                                     \
+            return OSHMEM_SUCCESS;                                                \
+        }                                                                         \
+    } while (0)
+
 struct mca_atomic_basic_module_t {
     mca_atomic_base_module_t super;
 };
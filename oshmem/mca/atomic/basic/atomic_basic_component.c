@@ -27,6 +27,7 @@ const char *mca_atomic_basic_component_version_string =
 /*
  * Global variable
  */
+bool mca_atomic_basic_shm = true;
 
 /*
  * Local function
@@ -78,6 +79,16 @@ static int _basic_register(void)
                                      MCA_BASE_VAR_SCOPE_ALL_EQ,
                                      &mca_atomic_basic_component.priority);
 
+    mca_atomic_basic_shm = true;
+    mca_base_component_var_register (&mca_atomic_basic_component.atomic_version,
+                                     "shm", "Use the processor atomics on the symmetric "
+                                     "memory attached by all the PEs when the job runs on "
+                                     "a single node (default: true)", MCA_BASE_VAR_TYPE_BOOL,
+                                     NULL, 0, MCA_BASE_VAR_FLAG_SETTABLE,
+                                     OPAL_INFO_LVL_5,
+                                     MCA_BASE_VAR_SCOPE_ALL_EQ,
+                                     &mca_atomic_basic_shm);
+
     return OSHMEM_SUCCESS;
 }
 
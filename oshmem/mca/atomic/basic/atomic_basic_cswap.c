@@ -27,12 +27,26 @@ int mca_atomic_basic_cswap(shmem_ctx_t ctx,
                            int pe)
 {
     int rc = OSHMEM_SUCCESS;
+    void *addr;
 
     if (!prev) {
         rc = OSHMEM_ERROR;
     }
 
-    if (rc == OSHMEM_SUCCESS) {
+    addr = (rc == OSHMEM_SUCCESS) ? mca_atomic_basic_shm_addr(ctx, target, pe) : NULL;
+    if (NULL != addr) {
+        if (sizeof(uint64_t) == nlong) {
+            int64_t old = (int64_t)cond;
+            opal_atomic_compare_exchange_strong_64((opal_atomic_int64_t *)addr, &old,
+                                                   (int64_t)value);
+            *(int64_t *)prev = old;
+        } else {
+            int32_t old = (int32_t)cond;
+            opal_atomic_compare_exchange_strong_32((opal_atomic_int32_t *)addr, &old,
+                                                   (int32_t)value);
+            *(int32_t *)prev = old;
+        }
+    } else if (rc == OSHMEM_SUCCESS) {
         atomic_basic_lock(ctx, pe);
 
         rc = MCA_SPML_CALL(get(ctx, target, nlong, prev, pe));
@@ -40,6 +40,11 @@ int mca_atomic_basic_startup(bool enable_progress_threads, bool enable_threads)
     void* ptr = NULL;
     int num_pe = oshmem_num_procs();
 
+    /* the PEs of other nodes would update the same variables under the lock */
+    if (ompi_process_info.num_local_peers + 1 < ompi_process_info.num_procs) {
+        mca_atomic_basic_shm = false;
+    }
+
     rc = MCA_MEMHEAP_CALL(private_alloc((num_pe * sizeof(char)), &ptr));
     if (rc == OSHMEM_SUCCESS) {
         atomic_lock_sync = (char*) ptr;
@@ -140,6 +145,9 @@ int mca_atomic_basic_op(shmem_ctx_t ctx,
 static int mca_atomic_basic_add(shmem_ctx_t ctx, void *target, uint64_t value,
                                 size_t size, int pe)
 {
+    uint64_t prev;
+
+    MCA_ATOMIC_BASIC_SHM_FOP(ctx, target, &prev, value, size, pe, fetch_add);
     return mca_atomic_basic_op(ctx, target, value, size, pe,
                                MCA_BASIC_OP(size, oshmem_op_sum_int32, oshmem_op_sum_int64));
 }
@@ -148,28 +156,38 @@ static int mca_atomic_basic_and(shmem_ctx_t ctx,
                                 void *target, uint64_t value,
                                 size_t size, int pe)
 {
+    uint64_t prev;
+
+    MCA_ATOMIC_BASIC_SHM_FOP(ctx, target, &prev, value, size, pe, fetch_and);
     return mca_atomic_basic_op(ctx, target, value, size, pe,
-                               MCA_BASIC_OP(size, oshmem_op_sum_int32, oshmem_op_and_int64));
+                               MCA_BASIC_OP(size, oshmem_op_and_int32, oshmem_op_and_int64));
 }
 
 static int mca_atomic_basic_or(shmem_ctx_t ctx, void *target, uint64_t value,
                                size_t size, int pe)
 {
+    uint64_t prev;
+
+    MCA_ATOMIC_BASIC_SHM_FOP(ctx, target, &prev, value, size, pe, fetch_or);
     return mca_atomic_basic_op(ctx, target, value, size, pe,
-                               MCA_BASIC_OP(size, oshmem_op_sum_int32, oshmem_op_or_int64));
+                               MCA_BASIC_OP(size, oshmem_op_or_int32, oshmem_op_or_int64));
 }
 
 static int mca_atomic_basic_xor(shmem_ctx_t ctx,
                                 void *target, uint64_t value,
                                 size_t size, int pe)
 {
+    uint64_t prev;
+
+    MCA_ATOMIC_BASIC_SHM_FOP(ctx, target, &prev, value, size, pe, fetch_xor);
     return mca_atomic_basic_op(ctx, target, value, size, pe,
-                               MCA_BASIC_OP(size, oshmem_op_sum_int32, oshmem_op_xor_int64));
+                               MCA_BASIC_OP(size, oshmem_op_xor_int32, oshmem_op_xor_int64));
 }
 
 static int mca_atomic_basic_fadd(shmem_ctx_t ctx, void *target, void *prev, uint64_t value,
                                  size_t size, int pe)
 {
+    MCA_ATOMIC_BASIC_SHM_FOP(ctx, target, prev, value, size, pe, fetch_add);
     return mca_atomic_basic_fop(ctx, target, prev, value, size, pe,
                                 MCA_BASIC_OP(size, oshmem_op_sum_int32, oshmem_op_sum_int64));
 }
@@ -178,27 +196,31 @@ static int mca_atomic_basic_fand(shmem_ctx_t ctx,
                                  void *target, void *prev, uint64_t value,
                                  size_t size, int pe)
 {
+    MCA_ATOMIC_BASIC_SHM_FOP(ctx, target, prev, value, size, pe, fetch_and);
     return mca_atomic_basic_fop(ctx, target, prev, value, size, pe,
-                                MCA_BASIC_OP(size, oshmem_op_sum_int32, oshmem_op_and_int64));
+                                MCA_BASIC_OP(size, oshmem_op_and_int32, oshmem_op_and_int64));
 }
 
 static int mca_atomic_basic_for(shmem_ctx_t ctx, void *target, void *prev, uint64_t value,
                                 size_t size, int pe)
 {
+    MCA_ATOMIC_BASIC_SHM_FOP(ctx, target, prev, value, size, pe, fetch_or);
     return mca_atomic_basic_fop(ctx, target, prev, value, size, pe,
-                                MCA_BASIC_OP(size, oshmem_op_sum_int32, oshmem_op_or_int64));
+                                MCA_BASIC_OP(size, oshmem_op_or_int32, oshmem_op_or_int64));
 }
 
 static int mca_atomic_basic_fxor(shmem_ctx_t ctx, void *target, void *prev, uint64_t value,
                                  size_t size, int pe)
 {
+    MCA_ATOMIC_BASIC_SHM_FOP(ctx, target, prev, value, size, pe, fetch_xor);
     return mca_atomic_basic_fop(ctx, target, prev, value, size, pe,
-                                MCA_BASIC_OP(size, oshmem_op_sum_int32, oshmem_op_xor_int64));
+                                MCA_BASIC_OP(size, oshmem_op_xor_int32, oshmem_op_xor_int64));
 }
 
 static int mca_atomic_basic_swap(shmem_ctx_t ctx, void *target, void *prev, uint64_t value,
                                  size_t size, int pe)
 {
+    MCA_ATOMIC_BASIC_SHM_FOP(ctx, target, prev, value, size, pe, swap);
     return mca_atomic_basic_fop(ctx, target, prev, value, size, pe,
                                 MCA_BASIC_OP(size, oshmem_op_swap_int32, oshmem_op_swap_int64));
 }
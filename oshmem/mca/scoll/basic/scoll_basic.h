@@ -40,6 +40,8 @@ OSHMEM_DECLSPEC extern int mca_scoll_basic_param_barrier_algorithm;
 extern int mca_scoll_basic_param_broadcast_algorithm;
 extern int mca_scoll_basic_param_collect_algorithm;
 extern int mca_scoll_basic_param_reduce_algorithm;
+extern int mca_scoll_basic_param_knomial_radix;
+extern size_t mca_scoll_basic_param_long_msg;
 
 /* API functions */
 
@@ -34,6 +34,12 @@ static int _algorithm_binomial_tree(struct oshmem_group_t *group,
                                      const void *source,
                                      size_t nlong,
                                      long *pSync);
+static int _algorithm_knomial_tree(struct oshmem_group_t *group,
+                                    int PE_root,
+                                    void *target,
+                                    const void *source,
+                                    size_t nlong,
+                                    long *pSync);
 
 int mca_scoll_basic_broadcast(struct oshmem_group_t *group,
                               int PE_root,
@@ -64,6 +70,16 @@ int mca_scoll_basic_broadcast(struct oshmem_group_t *group,
         if (pSync) {
             alg = (alg == SCOLL_DEFAULT_ALG ?
                     mca_scoll_basic_param_broadcast_algorithm : alg);
+            if (alg == SCOLL_ALG_BROADCAST_ADAPTIVE) {
+                /* Only the root is sure to know the size when it is not
+                 * given by the caller, every PE must pick the same tree.
+                 * Long messages go down the binomial tree where a PE
+                 * sends to fewer children at each level.
+                 */
+                alg = ((nlong_type && (nlong >= mca_scoll_basic_param_long_msg)) ?
+                        SCOLL_ALG_BROADCAST_BINOMIAL :
+                        SCOLL_ALG_BROADCAST_KNOMIAL);
+            }
             switch (alg) {
             case SCOLL_ALG_BROADCAST_CENTRAL_COUNTER:
                 {
@@ -85,6 +101,16 @@ int mca_scoll_basic_broadcast(struct oshmem_group_t *group,
                                                    pSync);
                     break;
                 }
+            case SCOLL_ALG_BROADCAST_KNOMIAL:
+                {
+                    rc = _algorithm_knomial_tree(group,
+                                                  PE_root,
+                                                  target,
+                                                  source,
+                                                  nlong,
+                                                  pSync);
+                    break;
+                }
             default:
                 {
                     rc = _algorithm_binomial_tree(group,
@@ -258,3 +284,108 @@ static int _algorithm_binomial_tree(struct oshmem_group_t *group,
 
     return rc;
 }
+
+/*
+ The K-nomial Spanning Tree algorithm.
+ A PE forwards the data to up to (K-1) children at each level of the tree, so
+ the depth of the tree is logK(NP) instead of log2(NP). K is set by the
+ knomial_radix parameter, K = 2 gives the binomial tree.
+ Outlay:
+ The game scales with logK(NP) and uses 1 byte of memory.
+ */
+static int _algorithm_knomial_tree(struct oshmem_group_t *group,
+                                    int PE_root,
+                                    void *target,
+                                    const void *source,
+                                    size_t nlong,
+                                    long *pSync)
+{
+    int rc = OSHMEM_SUCCESS;
+    long value = SHMEM_SYNC_INIT;
+    int radix = mca_scoll_basic_param_knomial_radix;
+    int root_id = oshmem_proc_group_find_id(group, PE_root);
+    int my_id = oshmem_proc_group_find_id(group, group->my_pe);
+    int peer_id = 0;
+    int peer_pe = 0;
+    int vrank;
+    int mask;
+    int i = 0;
+
+    if (radix < 2) {
+        radix = 2;
+    }
+
+    SCOLL_VERBOSE(12,
+                  "[#%d] Broadcast algorithm: K-nomial Tree (radix = %d)",
+                  group->my_pe, radix);
+    SCOLL_VERBOSE(15,
+                  "[#%d] pSync[0] = %ld root = #%d",
+                  group->my_pe, pSync[0], PE_root);
+
+    vrank = (my_id + group->proc_count - root_id) % group->proc_count;
+
+    /* The level where this PE is attached to its parent is the lowest
+     * nonzero digit of vrank written in base radix.
+     */
+    for (mask = 1; mask < group->proc_count; mask *= radix) {
+        if (vrank % (mask * radix)) {
+            break;
+        }
+    }
+
+    SCOLL_VERBOSE(15,
+                  "[#%d] vrank = %d mask = %d",
+                  group->my_pe, vrank, mask);
+
+    pSync[0] = SHMEM_SYNC_READY;
+    /* Receive data from parent in the tree. */
+    if (vrank > 0) {
+        value = SHMEM_SYNC_READY;
+
+        SCOLL_VERBOSE(14, "[#%d] wait", group->my_pe);
+        rc = MCA_SPML_CALL(wait((void*)pSync, SHMEM_CMP_NE, (void*)&value, SHMEM_LONG));
+        while ((value = pSync[0]) < 0) {
+            SCOLL_VERBOSE(14,
+                          "[#%d] Broadcast size is a negative value (%li)\n",
+                          group->my_pe, pSync[0]);
+            MCA_SPML_CALL(wait((void*)pSync, SHMEM_CMP_NE, (void*)&value, SHMEM_LONG));
+        }
+        if (OSHMEM_SUCCESS != rc) {
+            return rc;
+        }
+        nlong = (size_t) pSync[0];
+    }
+
+    /* Send data to the children, the largest subtrees first. */
+    for (mask /= radix; (mask > 0) && (rc == OSHMEM_SUCCESS); mask /= radix) {
+        for (i = 1; (i < radix) && (rc == OSHMEM_SUCCESS); i++) {
+            peer_id = vrank + i * mask;
+
+            if (peer_id >= group->proc_count) {
+                break;
+            }
+
+            /* Wait for the child to be ready to receive (pSync must have the initial value) */
+            peer_id = (peer_id + root_id) % group->proc_count;
+            peer_pe = oshmem_proc_pe(group->proc_array[peer_id]);
+
+            SCOLL_VERBOSE(14,
+                          "[#%d] check remote pe is ready to receive #%d",
+                          group->my_pe, peer_pe);
+            do {
+                rc = MCA_SPML_CALL(get(oshmem_ctx_default, (void*)pSync, sizeof(long), (void*)pSync, peer_pe));
+            } while ((OSHMEM_SUCCESS == rc) && (pSync[0] != SHMEM_SYNC_READY));
+
+            SCOLL_VERBOSE(14, "[#%d] send data to #%d", group->my_pe, peer_pe);
+            rc = MCA_SPML_CALL(put(oshmem_ctx_default, target, nlong, (my_id == root_id ? (void *)source : target), peer_pe));
+
+            MCA_SPML_CALL(fence(oshmem_ctx_default));
+
+            SCOLL_VERBOSE(14, "[#%d] signals to #%d", group->my_pe, peer_pe);
+            value = nlong;
+            rc = MCA_SPML_CALL(put(oshmem_ctx_default, (void*)pSync, sizeof(value), (void*)&value, peer_pe));
+        }
+    }
+
+    return rc;
+}
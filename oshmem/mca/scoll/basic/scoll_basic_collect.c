@@ -14,6 +14,8 @@
 #include <stdio.h>
 #include <stdlib.h>
 
+#include "opal/util/bit_ops.h"
+
 #include "oshmem/constants.h"
 #include "oshmem/mca/spml/spml.h"
 #include "oshmem/mca/scoll/scoll.h"
@@ -45,6 +47,11 @@ static int _algorithm_f_ring(struct oshmem_group_t *group,
                               const void *source,
                               size_t nlong,
                               long *pSync);
+static int _algorithm_f_bruck(struct oshmem_group_t *group,
+                               void *target,
+                               const void *source,
+                               size_t nlong,
+                               long *pSync);
 
 int mca_scoll_basic_collect(struct oshmem_group_t *group,
                             void *target,
@@ -75,6 +82,19 @@ int mca_scoll_basic_collect(struct oshmem_group_t *group,
 
             alg = (alg == SCOLL_DEFAULT_ALG ?
                     mca_scoll_basic_param_collect_algorithm : alg);
+            if (alg == SCOLL_ALG_COLLECT_ADAPTIVE) {
+                /* Ring is bandwidth optimal for long messages. For short
+                 * ones recursive doubling needs log2(NP) rounds when NP is
+                 * a power of two, Bruck needs ceil(log2(NP)) for any NP.
+                 */
+                if ((group->proc_count * nlong) >= mca_scoll_basic_param_long_msg) {
+                    alg = SCOLL_ALG_COLLECT_RING;
+                } else if (opal_next_poweroftwo_inclusive(group->proc_count) == group->proc_count) {
+                    alg = SCOLL_ALG_COLLECT_RECURSIVE_DOUBLING;
+                } else {
+                    alg = SCOLL_ALG_COLLECT_BRUCK;
+                }
+            }
             switch (alg) {
             case SCOLL_ALG_COLLECT_CENTRAL_COUNTER:
                 {
@@ -112,6 +132,15 @@ int mca_scoll_basic_collect(struct oshmem_group_t *group,
                                             pSync);
                     break;
                 }
+            case SCOLL_ALG_COLLECT_BRUCK:
+                {
+                    rc = _algorithm_f_bruck(group,
+                                             target,
+                                             source,
+                                             nlong,
+                                             pSync);
+                    break;
+                }
             default:
                 {
                     rc = _algorithm_f_central_counter(group,
@@ -378,6 +407,85 @@ static int _algorithm_f_ring(struct oshmem_group_t *group,
     return rc;
 }
 
+/*
+ The Bruck algorithm.
+ At round k a PE owns its block and the blocks of the PEs that follow it in the
+ group, 2^k in total, and puts them to the PE that is 2^k positions before it. Blocks are stored
+ straight at their final place in target, so no rotation is needed and a
+ block is never written twice.
+ Outlay:
+ The game scales with ceil(log2(NP)) for any NP.
+ */
+static int _algorithm_f_bruck(struct oshmem_group_t *group,
+                               void *target,
+                               const void *source,
+                               size_t nlong,
+                               long *pSync)
+{
+    int rc = OSHMEM_SUCCESS;
+    int round = 0;
+    int distance = 0;
+    int count = 0;
+    int first = 0;
+    long value = SHMEM_SYNC_INIT;
+    int my_id = oshmem_proc_group_find_id(group, group->my_pe);
+    int peer_id = 0;
+    int peer_pe = 0;
+
+    SCOLL_VERBOSE(12,
+                  "[#%d] Collect algorithm: Bruck (identical size)",
+                  group->my_pe);
+    SCOLL_VERBOSE(15, "[#%d] pSync[0] = %ld", group->my_pe, pSync[0]);
+
+    memcpy((void*) ((unsigned char*) target + my_id * nlong),
+           (void *) source,
+           nlong);
+
+    pSync[0] = round;
+    for (distance = 1; (distance < group->proc_count) && (rc == OSHMEM_SUCCESS); distance <<= 1) {
+        peer_id = (my_id + group->proc_count - distance) % group->proc_count;
+        peer_pe = oshmem_proc_pe(group->proc_array[peer_id]);
+        count = (distance < (group->proc_count - distance) ?
+                 distance : (group->proc_count - distance));
+
+        /* Wait until the peer got the data of the previous round */
+        do {
+            MCA_SPML_CALL(get(oshmem_ctx_default, (void*)pSync, sizeof(value), (void*)&value, peer_pe));
+        } while (value != round);
+
+        SCOLL_VERBOSE(14,
+                      "[#%d] round = %d send %d blocks to #%d",
+                      group->my_pe, round, count, peer_pe);
+
+        /* The blocks my_id .. my_id + count - 1 may wrap around the group */
+        first = (group->proc_count - my_id < count ?
+                 group->proc_count - my_id : count);
+        rc = MCA_SPML_CALL(put(oshmem_ctx_default, (void*)((unsigned char*)target + my_id * nlong), first * nlong, (void*)((unsigned char*)target + my_id * nlong), peer_pe));
+        if ((rc == OSHMEM_SUCCESS) && (first < count)) {
+            rc = MCA_SPML_CALL(put(oshmem_ctx_default, target, (count - first) * nlong, target, peer_pe));
+        }
+
+        MCA_SPML_CALL(fence(oshmem_ctx_default));
+
+        SCOLL_VERBOSE(14,
+                      "[#%d] round = %d signals to #%d",
+                      group->my_pe, round, peer_pe);
+        value = SHMEM_SYNC_RUN;
+        rc = MCA_SPML_CALL(put(oshmem_ctx_default, (void*)pSync, sizeof(value), (void*)&value, peer_pe));
+
+        SCOLL_VERBOSE(14, "[#%d] round = %d wait", group->my_pe, round);
+        value = SHMEM_SYNC_RUN;
+        rc = MCA_SPML_CALL(wait((void*)pSync, SHMEM_CMP_EQ, (void*)&value, SHMEM_LONG));
+
+        round++;
+        pSync[0] = round;
+    }
+
+    SCOLL_VERBOSE(15, "[#%d] pSync[0] = %ld", group->my_pe, pSync[0]);
+
+    return rc;
+}
+
 static int _algorithm_f_recursive_doubling(struct oshmem_group_t *group,
                                             void *target,
                                             const void *source,
@@ -29,10 +29,11 @@ const char *mca_scoll_basic_component_version_string =
  */
 int mca_scoll_basic_priority_param = -1;
 int mca_scoll_basic_param_barrier_algorithm = SCOLL_ALG_BARRIER_ADAPTIVE;
-int mca_scoll_basic_param_broadcast_algorithm = SCOLL_ALG_BROADCAST_BINOMIAL;
-int mca_scoll_basic_param_collect_algorithm =
-        SCOLL_ALG_COLLECT_RECURSIVE_DOUBLING;
-int mca_scoll_basic_param_reduce_algorithm = SCOLL_ALG_REDUCE_RECURSIVE_DOUBLING;
+int mca_scoll_basic_param_broadcast_algorithm = SCOLL_ALG_BROADCAST_ADAPTIVE;
+int mca_scoll_basic_param_collect_algorithm = SCOLL_ALG_COLLECT_ADAPTIVE;
+int mca_scoll_basic_param_reduce_algorithm = SCOLL_ALG_REDUCE_ADAPTIVE;
+int mca_scoll_basic_param_knomial_radix = 4;
+size_t mca_scoll_basic_param_long_msg = 8192;
 
 /*
  * Local function
@@ -106,9 +107,11 @@ static int basic_register(void)
                                            &mca_scoll_basic_param_barrier_algorithm);
 
     sprintf(help_msg,
-            "Algorithm selection for Broadcast (%d - Central Counter, %d - Binomial)",
+            "Algorithm selection for Broadcast (%d - Central Counter, %d - Binomial, %d - K-nomial, %d - Adaptive)",
             SCOLL_ALG_BROADCAST_CENTRAL_COUNTER,
-            SCOLL_ALG_BROADCAST_BINOMIAL);
+            SCOLL_ALG_BROADCAST_BINOMIAL,
+            SCOLL_ALG_BROADCAST_KNOMIAL,
+            SCOLL_ALG_BROADCAST_ADAPTIVE);
     (void) mca_base_component_var_register(comp,
                                            "broadcast_alg",
                                            help_msg,
@@ -118,11 +121,13 @@ static int basic_register(void)
                                            &mca_scoll_basic_param_broadcast_algorithm);
 
     sprintf(help_msg,
-            "Algorithm selection for Collect (%d - Central Counter, %d - Tournament, %d - Recursive Doubling, %d - Ring)",
+            "Algorithm selection for Collect (%d - Central Counter, %d - Tournament, %d - Recursive Doubling, %d - Ring, %d - Bruck, %d - Adaptive)",
             SCOLL_ALG_COLLECT_CENTRAL_COUNTER,
             SCOLL_ALG_COLLECT_TOURNAMENT,
             SCOLL_ALG_COLLECT_RECURSIVE_DOUBLING,
-            SCOLL_ALG_COLLECT_RING);
+            SCOLL_ALG_COLLECT_RING,
+            SCOLL_ALG_COLLECT_BRUCK,
+            SCOLL_ALG_COLLECT_ADAPTIVE);
     (void) mca_base_component_var_register(comp,
                                            "collect_alg",
                                            help_msg,
@@ -132,12 +137,14 @@ static int basic_register(void)
                                            &mca_scoll_basic_param_collect_algorithm);
 
     sprintf(help_msg,
-            "Algorithm selection for Reduce (%d - Central Counter, %d - Tournament, %d - Recursive Doubling %d - Linear %d - Log)",
+            "Algorithm selection for Reduce (%d - Central Counter, %d - Tournament, %d - Recursive Doubling %d - Linear %d - Log %d - Rabenseifner %d - Adaptive)",
             SCOLL_ALG_REDUCE_CENTRAL_COUNTER,
             SCOLL_ALG_REDUCE_TOURNAMENT,
             SCOLL_ALG_REDUCE_RECURSIVE_DOUBLING,
             SCOLL_ALG_REDUCE_LEGACY_LINEAR,
-            SCOLL_ALG_REDUCE_LEGACY_LOG);
+            SCOLL_ALG_REDUCE_LEGACY_LOG,
+            SCOLL_ALG_REDUCE_RABENSEIFNER,
+            SCOLL_ALG_REDUCE_ADAPTIVE);
     (void) mca_base_component_var_register(comp,
                                            "reduce_alg",
                                            help_msg,
@@ -146,6 +153,23 @@ static int basic_register(void)
                                            MCA_BASE_VAR_SCOPE_READONLY,
                                            &mca_scoll_basic_param_reduce_algorithm);
 
+    (void) mca_base_component_var_register(comp,
+                                           "knomial_radix",
+                                           "Radix of the K-nomial tree used by Broadcast (minimum 2)",
+                                           MCA_BASE_VAR_TYPE_INT, NULL, 0, MCA_BASE_VAR_FLAG_SETTABLE,
+                                           OPAL_INFO_LVL_9,
+                                           MCA_BASE_VAR_SCOPE_READONLY,
+                                           &mca_scoll_basic_param_knomial_radix);
+
+    (void) mca_base_component_var_register(comp,
+                                           "long_msg",
+                                           "Size in bytes from which the adaptive Broadcast, Collect and Reduce "
+                                           "switch to the bandwidth oriented algorithms",
+                                           MCA_BASE_VAR_TYPE_SIZE_T, NULL, 0, MCA_BASE_VAR_FLAG_SETTABLE,
+                                           OPAL_INFO_LVL_9,
+                                           MCA_BASE_VAR_SCOPE_READONLY,
+                                           &mca_scoll_basic_param_long_msg);
+
     return OSHMEM_SUCCESS;
 }
 
@@ -42,6 +42,13 @@ static int _algorithm_recursive_doubling(struct oshmem_group_t *group,
                                           size_t nlong,
                                           long *pSync,
                                           void *pWrk);
+static int _algorithm_rabenseifner(struct oshmem_group_t *group,
+                                    struct oshmem_op_t *op,
+                                    void *target,
+                                    const void *source,
+                                    size_t nlong,
+                                    long *pSync,
+                                    void *pWrk);
 static int _algorithm_linear(struct oshmem_group_t *group,
                               struct oshmem_op_t *op,
                               void *target,
@@ -86,6 +93,15 @@ int mca_scoll_basic_reduce(struct oshmem_group_t *group,
         if (pSync) {
             alg = (alg == SCOLL_DEFAULT_ALG ?
                     mca_scoll_basic_param_reduce_algorithm : alg);
+            if (alg == SCOLL_ALG_REDUCE_ADAPTIVE) {
+                /* Rabenseifner moves about 2*nlong bytes per PE instead of
+                 * nlong*log2(NP) but needs at least one element per PE.
+                 */
+                alg = (((nlong >= mca_scoll_basic_param_long_msg) &&
+                        ((nlong / op->dt_size) >= (size_t) group->proc_count)) ?
+                        SCOLL_ALG_REDUCE_RABENSEIFNER :
+                        SCOLL_ALG_REDUCE_RECURSIVE_DOUBLING);
+            }
             switch (alg) {
             case SCOLL_ALG_REDUCE_CENTRAL_COUNTER:
                 {
@@ -120,6 +136,17 @@ int mca_scoll_basic_reduce(struct oshmem_group_t *group,
                                                         pWrk);
                     break;
                 }
+            case SCOLL_ALG_REDUCE_RABENSEIFNER:
+                {
+                    rc = _algorithm_rabenseifner(group,
+                                                  op,
+                                                  target,
+                                                  source,
+                                                  nlong,
+                                                  pSync,
+                                                  pWrk);
+                    break;
+                }
             case SCOLL_ALG_REDUCE_LEGACY_LINEAR:
                 {
                     rc = _algorithm_linear(group,
@@ -546,6 +573,264 @@ static int _algorithm_recursive_doubling(struct oshmem_group_t *group,
     return rc;
 }
 
+/*
+ One round of the Rabenseifner algorithm: wait until the peer is at the same
+ round, put the data at addr of the peer and signal it, then wait for the
+ signal of the peer.
+ */
+static int _rabenseifner_exchange(struct oshmem_group_t *group,
+                                  void *addr,
+                                  void *data,
+                                  size_t size,
+                                  long round,
+                                  long *pSync,
+                                  int peer_pe)
+{
+    int rc = OSHMEM_SUCCESS;
+    long value = SHMEM_SYNC_INIT;
+
+    do {
+        rc = MCA_SPML_CALL(get(oshmem_ctx_default, (void*)pSync, sizeof(value), (void*)&value, peer_pe));
+    } while ((rc == OSHMEM_SUCCESS) && (value != round));
+
+    if ((rc == OSHMEM_SUCCESS) && size) {
+        SCOLL_VERBOSE(14,
+                      "[#%d] round = %ld send %d bytes to #%d",
+                      group->my_pe, round, (int)size, peer_pe);
+        rc = MCA_SPML_CALL(put(oshmem_ctx_default, addr, size, data, peer_pe));
+    }
+
+    MCA_SPML_CALL(fence(oshmem_ctx_default));
+
+    if (rc == OSHMEM_SUCCESS) {
+        SCOLL_VERBOSE(14,
+                      "[#%d] round = %ld signals to #%d",
+                      group->my_pe, round, peer_pe);
+        value = SHMEM_SYNC_RUN;
+        rc = MCA_SPML_CALL(put(oshmem_ctx_default, (void*)pSync, sizeof(value), (void*)&value, peer_pe));
+    }
+
+    if (rc == OSHMEM_SUCCESS) {
+        SCOLL_VERBOSE(14, "[#%d] round = %ld wait", group->my_pe, round);
+        value = SHMEM_SYNC_RUN;
+        rc = MCA_SPML_CALL(wait((void*)pSync, SHMEM_CMP_EQ, (void*)&value, SHMEM_LONG));
+    }
+
+    return rc;
+}
+
+/*
+ The Rabenseifner algorithm.
+ A reduce-scatter by recursive halving leaves each PE with one reduced block
+ of the vector, then an allgather by recursive doubling gives the whole result
+ to everyone. Extra PEs above the largest power of two are folded into their
+ partner first, like in the recursive doubling algorithm.
+ Outlay:
+ The game scales with 2*log2(NP) and every PE sends about 2*nlong bytes
+ whatever NP is, so it is the choice for long vectors.
+ */
+static int _algorithm_rabenseifner(struct oshmem_group_t *group,
+                                    struct oshmem_op_t *op,
+                                    void *target,
+                                    const void *source,
+                                    size_t nlong,
+                                    long *pSync,
+                                    void *pWrk)
+{
+    int rc = OSHMEM_SUCCESS;
+    long round = 0;
+    int floor2_proc = 0;
+    int level = 0;
+    int mask = 0;
+    long value = SHMEM_SYNC_INIT;
+    unsigned char *target_cur = NULL;
+    size_t dt_size = op->dt_size;
+    size_t lo = 0;
+    size_t hi = nlong / dt_size;
+    size_t mid = 0;
+    size_t send_lo = 0;
+    size_t send_hi = 0;
+    size_t seg_lo[sizeof(int) * 8];
+    size_t seg_hi[sizeof(int) * 8];
+    int my_id = oshmem_proc_group_find_id(group, group->my_pe);
+    int peer_id = 0;
+    int peer_pe = 0;
+    int i = 0;
+
+    floor2_proc = 1;
+    i = group->proc_count;
+    i >>= 1;
+    while (i) {
+        i >>= 1;
+        floor2_proc <<= 1;
+    }
+
+    target_cur = malloc(nlong);
+    if (target_cur) {
+        memcpy(target_cur, (void *) source, nlong);
+    } else {
+        return OSHMEM_ERR_OUT_OF_RESOURCE;
+    }
+
+    SCOLL_VERBOSE(12,
+                  "[#%d] Reduce algorithm: Rabenseifner",
+                  group->my_pe);
+    SCOLL_VERBOSE(15,
+                  "[#%d] pSync[0] = %ld floor2_proc = %d",
+                  group->my_pe, pSync[0], floor2_proc);
+
+    if (my_id >= floor2_proc) {
+        /* I am in extra group, my partner is node (my_id-y) in basic group */
+        peer_id = my_id - floor2_proc;
+        peer_pe = oshmem_proc_pe(group->proc_array[peer_id]);
+
+        /* Special procedure is needed in case target and source are the same */
+        if (source == target) {
+            SCOLL_VERBOSE(14,
+                          "[#%d] wait for peer #%d is ready",
+                          group->my_pe, peer_pe);
+            value = SHMEM_SYNC_WAIT;
+            rc = MCA_SPML_CALL(wait((void*)pSync, SHMEM_CMP_EQ, (void*)&value, SHMEM_LONG));
+        }
+
+        SCOLL_VERBOSE(14,
+                      "[#%d] is extra send data to #%d",
+                      group->my_pe, peer_pe);
+        rc = MCA_SPML_CALL(put(oshmem_ctx_default, target, nlong, target_cur, peer_pe));
+
+        MCA_SPML_CALL(fence(oshmem_ctx_default));
+
+        SCOLL_VERBOSE(14,
+                      "[#%d] is extra and signal to #%d",
+                      group->my_pe, peer_pe);
+        value = SHMEM_SYNC_RUN;
+        rc = MCA_SPML_CALL(put(oshmem_ctx_default, (void*)pSync, sizeof(value), (void*)&value, peer_pe));
+
+        SCOLL_VERBOSE(14, "[#%d] wait", group->my_pe);
+        value = SHMEM_SYNC_RUN;
+        rc = MCA_SPML_CALL(wait((void*)pSync, SHMEM_CMP_EQ, (void*)&value, SHMEM_LONG));
+    } else {
+        /* Wait for a peer from extra group */
+        if ((group->proc_count - floor2_proc) > my_id) {
+            /* I am in basic group, my partner is node (my_id+y) in extra group */
+            peer_id = my_id + floor2_proc;
+            peer_pe = oshmem_proc_pe(group->proc_array[peer_id]);
+
+            /* Special procedure is needed in case target and source are the same */
+            if (source == target) {
+                SCOLL_VERBOSE(14,
+                              "[#%d] signal to #%d that I am ready",
+                              group->my_pe, peer_pe);
+                value = SHMEM_SYNC_WAIT;
+                rc = MCA_SPML_CALL(put(oshmem_ctx_default, (void*)pSync, sizeof(value), (void*)&value, peer_pe));
+            }
+
+            SCOLL_VERBOSE(14,
+                          "[#%d] wait a signal from #%d",
+                          group->my_pe, peer_pe);
+            value = SHMEM_SYNC_RUN;
+            rc = MCA_SPML_CALL(wait((void*)pSync, SHMEM_CMP_EQ, (void*)&value, SHMEM_LONG));
+
+            /* Do reduction operation */
+            if (rc == OSHMEM_SUCCESS) {
+                op->o_func.c_fn(target, target_cur, nlong / dt_size);
+            }
+        }
+
+        /* Reduce-scatter: keep one half of the current block and send the
+         * other one to the peer, which reduces it into its own half.
+         */
+        pSync[0] = round;
+        for (mask = floor2_proc >> 1; (mask > 0) && (rc == OSHMEM_SUCCESS); mask >>= 1) {
+            peer_id = my_id ^ mask;
+            peer_pe = oshmem_proc_pe(group->proc_array[peer_id]);
+
+            seg_lo[level] = lo;
+            seg_hi[level] = hi;
+            level++;
+
+            mid = lo + (hi - lo) / 2;
+            if (my_id & mask) {
+                send_lo = lo;
+                send_hi = mid;
+                lo = mid;
+            } else {
+                send_lo = mid;
+                send_hi = hi;
+                hi = mid;
+            }
+
+            rc = _rabenseifner_exchange(group,
+                                        (void*)((unsigned char*)target + send_lo * dt_size),
+                                        (void*)(target_cur + send_lo * dt_size),
+                                        (send_hi - send_lo) * dt_size,
+                                        round,
+                                        pSync,
+                                        peer_pe);
+
+            /* Do reduction operation */
+            if ((rc == OSHMEM_SUCCESS) && (hi > lo)) {
+                op->o_func.c_fn((void*)((unsigned char*)target + lo * dt_size),
+                                (void*)(target_cur + lo * dt_size),
+                                hi - lo);
+            }
+
+            round++;
+            pSync[0] = round;
+        }
+
+        /* Allgather: the blocks are exchanged in the reverse order and put
+         * straight at their place in target.
+         */
+        memcpy((void*)((unsigned char*)target + lo * dt_size),
+               (void*)(target_cur + lo * dt_size),
+               (hi - lo) * dt_size);
+        for (mask = 1; (mask < floor2_proc) && (rc == OSHMEM_SUCCESS); mask <<= 1) {
+            peer_id = my_id ^ mask;
+            peer_pe = oshmem_proc_pe(group->proc_array[peer_id]);
+
+            rc = _rabenseifner_exchange(group,
+                                        (void*)((unsigned char*)target + lo * dt_size),
+                                        (void*)((unsigned char*)target + lo * dt_size),
+                                        (hi - lo) * dt_size,
+                                        round,
+                                        pSync,
+                                        peer_pe);
+
+            level--;
+            lo = seg_lo[level];
+            hi = seg_hi[level];
+
+            round++;
+            pSync[0] = round;
+        }
+
+        /* Notify a peer from extra group */
+        if ((rc == OSHMEM_SUCCESS) && ((group->proc_count - floor2_proc) > my_id)) {
+            /* I am in basic group, my partner is node (my_id+y) in extra group */
+            peer_id = my_id + floor2_proc;
+            peer_pe = oshmem_proc_pe(group->proc_array[peer_id]);
+
+            SCOLL_VERBOSE(14,
+                          "[#%d] is extra send data to #%d",
+                          group->my_pe, peer_pe);
+            rc = MCA_SPML_CALL(put(oshmem_ctx_default, target, nlong, target, peer_pe));
+
+            MCA_SPML_CALL(fence(oshmem_ctx_default));
+
+            SCOLL_VERBOSE(14, "[#%d] signals to #%d", group->my_pe, peer_pe);
+            value = SHMEM_SYNC_RUN;
+            rc = MCA_SPML_CALL(put(oshmem_ctx_default, (void*)pSync, sizeof(value), (void*)&value, peer_pe));
+        }
+    }
+
+    free(target_cur);
+
+    SCOLL_VERBOSE(15, "[#%d] pSync[0] = %ld", group->my_pe, pSync[0]);
+
+    return rc;
+}
+
 static int _algorithm_linear(struct oshmem_group_t *group,
                               struct oshmem_op_t *op,
                               void *target,
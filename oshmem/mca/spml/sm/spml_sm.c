@@ -0,0 +1,377 @@
+/*
+ * $COPYRIGHT$
+ *
+ * Additional copyrights may follow
+ *
+ * $HEADER$
+ */
+
+#define _GNU_SOURCE
+#include <stdio.h>
+#include <string.h>
+#include <errno.h>
+
+#include <sys/types.h>
+#include <unistd.h>
+
+#include "oshmem_config.h"
+#include "opal/sys/atomic.h"
+#include "ompi/datatype/ompi_datatype.h"
+#include "ompi/mca/pml/pml.h"
+
+#include "oshmem/mca/spml/sm/spml_sm.h"
+#include "oshmem/include/shmem.h"
+#include "oshmem/mca/memheap/memheap.h"
+#include "oshmem/mca/memheap/base/base.h"
+#include "oshmem/proc/proc.h"
+#include "oshmem/mca/spml/base/base.h"
+#include "oshmem/mca/atomic/atomic.h"
+#include "oshmem/runtime/runtime.h"
+
+#if OSHMEM_SPML_SM_HAVE_CMA
+#include <sys/uio.h>
+
+#if OPAL_CMA_NEED_SYSCALL_DEFS
+#include "opal/sys/cma.h"
+#endif /* OPAL_CMA_NEED_SYSCALL_DEFS */
+#endif
+
+mca_spml_sm_t mca_spml_sm = {
+    .super = {
+        /* Init mca_spml_base_module_t */
+        .spml_add_procs     = mca_spml_sm_add_procs,
+        .spml_del_procs     = mca_spml_sm_del_procs,
+        .spml_enable        = mca_spml_sm_enable,
+        .spml_register      = mca_spml_sm_register,
+        .spml_deregister    = mca_spml_sm_deregister,
+        .spml_oob_get_mkeys = mca_spml_base_oob_get_mkeys,
+        .spml_ctx_create    = mca_spml_sm_ctx_create,
+        .spml_ctx_destroy   = mca_spml_sm_ctx_destroy,
+        .spml_put           = mca_spml_sm_put,
+        .spml_put_nb        = mca_spml_sm_put_nb,
+        .spml_get           = mca_spml_sm_get,
+        .spml_get_nb        = mca_spml_sm_get_nb,
+        .spml_recv          = mca_spml_sm_recv,
+        .spml_send          = mca_spml_sm_send,
+        .spml_wait          = mca_spml_base_wait,
+        .spml_wait_nb       = mca_spml_base_wait_nb,
+        .spml_test          = mca_spml_base_test,
+        .spml_fence         = mca_spml_sm_fence,
+        .spml_quiet         = mca_spml_sm_quiet,
+        .spml_rmkey_unpack  = mca_spml_base_rmkey_unpack,
+        .spml_rmkey_free    = mca_spml_base_rmkey_free,
+        .spml_rmkey_ptr     = mca_spml_sm_rmkey_ptr,
+        .spml_memuse_hook   = mca_spml_base_memuse_hook,
+        .spml_put_all_nb    = mca_spml_sm_put_all_nb,
+        .self               = (void*)&mca_spml_sm
+    },
+
+    .enabled                = false
+};
+
+mca_spml_sm_ctx_t mca_spml_sm_ctx_default = {
+    .options            = 0
+};
+
+int mca_spml_sm_enable(bool enable)
+{
+    SPML_VERBOSE(50, "*** sm ENABLED ****");
+    if (false == enable) {
+        return OSHMEM_SUCCESS;
+    }
+
+    mca_spml_sm.enabled = true;
+
+    return OSHMEM_SUCCESS;
+}
+
+int mca_spml_sm_add_procs(ompi_proc_t** procs, size_t nprocs)
+{
+    size_t i;
+
+    for (i = 0; i < nprocs; i++) {
+        if (procs[i] != oshmem_proc_local() &&
+            !OPAL_PROC_ON_LOCAL_NODE(procs[i]->super.proc_flags)) {
+            SPML_ERROR("pe %d is not on the local node, spml sm can not reach it",
+                       oshmem_proc_pe(procs[i]));
+            return OSHMEM_ERR_UNREACH;
+        }
+    }
+
+    return OSHMEM_SUCCESS;
+}
+
+int mca_spml_sm_del_procs(ompi_proc_t** procs, size_t nprocs)
+{
+    return OSHMEM_SUCCESS;
+}
+
+/*
+ * Segments allocated by sshmem sysv are attached by the local peers when
+ * they receive the mkey, see memheap_attach_segment(), and accessed with
+ * plain copies. sshmem mmap has the higher priority by default, jobs using
+ * this spml should select sysv with --mca sshmem sysv.
+ * The others are described by their address in this process and, when
+ * CMA is available, by the pid of this process.
+ */
+sshmem_mkey_t *mca_spml_sm_register(void* addr,
+                                    size_t size,
+                                    uint64_t shmid,
+                                    int *count)
+{
+    sshmem_mkey_t *mkeys;
+    map_segment_t *mem_seg;
+
+    *count = 0;
+    mkeys = (sshmem_mkey_t *) calloc(1, sizeof(*mkeys));
+    if (!mkeys) {
+        return NULL;
+    }
+
+    mem_seg = memheap_find_va(addr);
+    if (NULL != mem_seg && MAP_SEGMENT_ALLOC_SHM == mem_seg->type &&
+        MAP_SEGMENT_SHM_INVALID != (int)shmid) {
+        mkeys[0].va_base = NULL;
+        mkeys[0].len     = 0;
+        mkeys[0].u.key   = shmid;
+        *count = 1;
+        return mkeys;
+    }
+
+    SPML_VERBOSE(5, "segment %p - %p is not shared, %s",
+                 addr, (void*)((uintptr_t)addr + size),
+                 OSHMEM_SPML_SM_HAVE_CMA ? "using CMA" : "peers can not access it");
+    if (NULL != mem_seg && MAP_SEGMENT_STATIC != mem_seg->type) {
+        /* every put and get to the heap will be a system call */
+        SPML_WARNING("the symmetric heap is not in shared memory (select it with "
+                     "--mca sshmem sysv), %s",
+                     OSHMEM_SPML_SM_HAVE_CMA ? "peers access it through CMA"
+                                             : "peers can not access it");
+    }
+    mkeys[0].va_base = addr;
+#if OSHMEM_SPML_SM_HAVE_CMA
+    mkeys[0].u.data = malloc(sizeof(pid_t));
+    if (NULL == mkeys[0].u.data) {
+        free(mkeys);
+        return NULL;
+    }
+    *(pid_t *)mkeys[0].u.data = getpid();
+    mkeys[0].len = sizeof(pid_t);
+#else
+    mkeys[0].len   = 0;
+    mkeys[0].u.key = MAP_SEGMENT_SHM_INVALID;
+#endif
+    *count = 1;
+    return mkeys;
+}
+
+int mca_spml_sm_deregister(sshmem_mkey_t *mkeys)
+{
+    MCA_SPML_CALL(quiet(oshmem_ctx_default));
+    if (!mkeys)
+        return OSHMEM_SUCCESS;
+
+    if (0 < mkeys[0].len) {
+        free(mkeys[0].u.data);
+    }
+
+    free(mkeys);
+
+    return OSHMEM_SUCCESS;
+}
+
+void *mca_spml_sm_rmkey_ptr(const void *dst_addr, sshmem_mkey_t *mkey, int pe)
+{
+    /* attached segments are already handled by the caller, the others
+     * can not be loaded from */
+    return NULL;
+}
+
+int mca_spml_sm_ctx_create(long options, shmem_ctx_t *ctx)
+{
+    mca_spml_sm_ctx_t *sm_ctx;
+
+    sm_ctx = (mca_spml_sm_ctx_t *) malloc(sizeof(*sm_ctx));
+    if (NULL == sm_ctx) {
+        SPML_ERROR("ctx create FAILED rc=%d", OSHMEM_ERR_OUT_OF_RESOURCE);
+        return OSHMEM_ERR_OUT_OF_RESOURCE;
+    }
+    sm_ctx->options = options;
+
+    (*ctx) = (shmem_ctx_t)sm_ctx;
+    return OSHMEM_SUCCESS;
+}
+
+void mca_spml_sm_ctx_destroy(shmem_ctx_t ctx)
+{
+    MCA_SPML_CALL(quiet(ctx));
+
+    if (ctx != oshmem_ctx_default) {
+        free(ctx);
+    }
+}
+
+#if OSHMEM_SPML_SM_HAVE_CMA
+static int mca_spml_sm_cma_copy(pid_t pid, void *remote_addr, size_t size,
+                                void *local_addr, bool is_put)
+{
+    struct iovec local_iov = {.iov_base = local_addr, .iov_len = size};
+    struct iovec remote_iov = {.iov_base = remote_addr, .iov_len = size};
+    ssize_t ret;
+
+    /* the kernel may move less than asked, see mca_btl_sm_get_cma() */
+    while (0 < local_iov.iov_len) {
+        if (is_put) {
+            ret = process_vm_writev(pid, &local_iov, 1, &remote_iov, 1, 0);
+        } else {
+            ret = process_vm_readv(pid, &local_iov, 1, &remote_iov, 1, 0);
+        }
+        if (0 > ret) {
+            SPML_ERROR("CMA %s of %llu bytes from pid %d failed: %s",
+                       is_put ? "write" : "read", (unsigned long long)size, (int)pid,
+                       strerror(errno));
+            return OSHMEM_ERROR;
+        }
+        local_iov.iov_base = (void *)((char *)local_iov.iov_base + ret);
+        local_iov.iov_len -= ret;
+        remote_iov.iov_base = (void *)((char *)remote_iov.iov_base + ret);
+        remote_iov.iov_len -= ret;
+    }
+
+    return OSHMEM_SUCCESS;
+}
+#endif
+
+static inline int mca_spml_sm_copy(shmem_ctx_t ctx, void *remote_addr, size_t size,
+                                   void *local_addr, int pe, bool is_put)
+{
+    sshmem_mkey_t *mkey;
+    void *rva;
+
+    if (OPAL_UNLIKELY(0 == size)) {
+        return OSHMEM_SUCCESS;
+    }
+
+    mkey = mca_memheap_base_get_cached_mkey(ctx, pe, remote_addr, 0, &rva);
+    if (OPAL_UNLIKELY(NULL == mkey)) {
+        SPML_ERROR("pe=%d: %p is not address of symmetric variable",
+                   pe, remote_addr);
+        oshmem_shmem_abort(-1);
+        return OSHMEM_ERROR;
+    }
+
+    if (OPAL_LIKELY(pe == oshmem_my_proc_id() || mca_memheap_base_mkey_is_shm(mkey))) {
+        if (is_put) {
+            memcpy(rva, local_addr, size);
+        } else {
+            memcpy(local_addr, rva, size);
+        }
+        return OSHMEM_SUCCESS;
+    }
+
+#if OSHMEM_SPML_SM_HAVE_CMA
+    if (0 < mkey->len) {
+        return mca_spml_sm_cma_copy(*(pid_t *)mkey->u.data, rva, size, local_addr, is_put);
+    }
+#endif
+
+    SPML_ERROR("pe=%d: %p is not in a segment shared with this pe",
+               pe, remote_addr);
+    return OSHMEM_ERR_NOT_SUPPORTED;
+}
+
+int mca_spml_sm_get(shmem_ctx_t ctx, void *src_addr, size_t size, void *dst_addr, int src)
+{
+    return mca_spml_sm_copy(ctx, src_addr, size, dst_addr, src, false);
+}
+
+/* copies complete at once, there is nothing left to wait for */
+int mca_spml_sm_get_nb(shmem_ctx_t ctx, void *src_addr, size_t size, void *dst_addr, int src, void **handle)
+{
+    return mca_spml_sm_copy(ctx, src_addr, size, dst_addr, src, false);
+}
+
+int mca_spml_sm_put(shmem_ctx_t ctx, void* dst_addr, size_t size, void* src_addr, int dst)
+{
+    return mca_spml_sm_copy(ctx, dst_addr, size, src_addr, dst, true);
+}
+
+int mca_spml_sm_put_nb(shmem_ctx_t ctx, void* dst_addr, size_t size, void* src_addr, int dst, void **handle)
+{
+    return mca_spml_sm_copy(ctx, dst_addr, size, src_addr, dst, true);
+}
+
+/*
+ * Puts are stores to the peer memory, ordering them only requires a
+ * write barrier and completing them a full barrier.
+ */
+int mca_spml_sm_fence(shmem_ctx_t ctx)
+{
+    opal_atomic_wmb();
+    return OSHMEM_SUCCESS;
+}
+
+int mca_spml_sm_quiet(shmem_ctx_t ctx)
+{
+    opal_atomic_mb();
+    return OSHMEM_SUCCESS;
+}
+
+/* blocking receive */
+int mca_spml_sm_recv(void* buf, size_t size, int src)
+{
+    int rc = OSHMEM_SUCCESS;
+
+    rc = MCA_PML_CALL(recv(buf,
+                size,
+                &(ompi_mpi_unsigned_char.dt),
+                src,
+                0,
+                &(ompi_mpi_comm_world.comm),
+                NULL));
+
+    return rc;
+}
+
+/* for now only do blocking copy send */
+int mca_spml_sm_send(void* buf,
+                     size_t size,
+                     int dst,
+                     mca_spml_base_put_mode_t mode)
+{
+    int rc = OSHMEM_SUCCESS;
+
+    rc = MCA_PML_CALL(send(buf,
+                size,
+                &(ompi_mpi_unsigned_char.dt),
+                dst,
+                0,
+                (mca_pml_base_send_mode_t)mode,
+                &(ompi_mpi_comm_world.comm)));
+
+    return rc;
+}
+
+int mca_spml_sm_put_all_nb(void *dest, const void *source, size_t size, long *counter)
+{
+    int my_pe = oshmem_my_proc_id();
+    long val  = 1;
+    int peer, dst_pe, rc;
+
+    for (peer = 0; peer < oshmem_num_procs(); peer++) {
+        dst_pe = (peer + my_pe) % oshmem_num_procs();
+        rc = mca_spml_sm_put(oshmem_ctx_default,
+                             (void*)((uintptr_t)dest + my_pe * size),
+                             size,
+                             (void*)((uintptr_t)source + dst_pe * size),
+                             dst_pe);
+        RUNTIME_CHECK_RC(rc);
+
+        mca_spml_sm_fence(oshmem_ctx_default);
+
+        rc = MCA_ATOMIC_CALL(add(oshmem_ctx_default, (void*)counter, val, sizeof(val), dst_pe));
+        RUNTIME_CHECK_RC(rc);
+    }
+
+    return OSHMEM_SUCCESS;
+}
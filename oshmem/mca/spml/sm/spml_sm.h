@@ -0,0 +1,99 @@
+/*
+ * $COPYRIGHT$
+ *
+ * Additional copyrights may follow
+ *
+ * $HEADER$
+ */
+/**
+ *  @file
+ *
+ *  Shared memory SPML for jobs running on a single node.
+ *
+ *  The symmetric heap segment created by sshmem sysv, which is preferred
+ *  when this spml is selected, is attached by every peer (see
+ *  memheap_attach_segment()), so a remote symmetric address
+ *  is translated to the local mapping of the peer segment and puts and
+ *  gets are plain copies. Segments that cannot be attached, like the
+ *  static data of the peers or a private heap, are reached with CMA
+ *  when it is available.
+ */
+
+#ifndef MCA_SPML_SM_H
+#define MCA_SPML_SM_H
+
+#include "oshmem_config.h"
+#include "oshmem/mca/spml/spml.h"
+#include "oshmem/mca/spml/base/base.h"
+#include "oshmem/proc/proc.h"
+
+#include "oshmem/mca/memheap/memheap.h"
+#include "oshmem/mca/memheap/base/base.h"
+
+BEGIN_C_DECLS
+
+struct mca_spml_sm_ctx {
+    long options;
+};
+typedef struct mca_spml_sm_ctx mca_spml_sm_ctx_t;
+
+struct mca_spml_sm {
+    mca_spml_base_module_t super;
+    int priority;             /* component priority */
+    bool enabled;
+};
+typedef struct mca_spml_sm mca_spml_sm_t;
+
+extern mca_spml_sm_t mca_spml_sm;
+extern mca_spml_sm_ctx_t mca_spml_sm_ctx_default;
+
+extern int mca_spml_sm_enable(bool enable);
+extern int mca_spml_sm_add_procs(ompi_proc_t** procs, size_t nprocs);
+extern int mca_spml_sm_del_procs(ompi_proc_t** procs, size_t nprocs);
+
+extern sshmem_mkey_t *mca_spml_sm_register(void* addr,
+                                           size_t size,
+                                           uint64_t shmid,
+                                           int *count);
+extern int mca_spml_sm_deregister(sshmem_mkey_t *mkeys);
+extern void *mca_spml_sm_rmkey_ptr(const void *dst_addr, sshmem_mkey_t *mkey, int pe);
+
+extern int mca_spml_sm_ctx_create(long options, shmem_ctx_t *ctx);
+extern void mca_spml_sm_ctx_destroy(shmem_ctx_t ctx);
+
+extern int mca_spml_sm_put(shmem_ctx_t ctx,
+                           void* dst_addr,
+                           size_t size,
+                           void* src_addr,
+                           int dst);
+extern int mca_spml_sm_put_nb(shmem_ctx_t ctx,
+                              void* dst_addr,
+                              size_t size,
+                              void* src_addr,
+                              int dst,
+                              void **handle);
+extern int mca_spml_sm_get(shmem_ctx_t ctx,
+                           void* src_addr,
+                           size_t size,
+                           void* dst_addr,
+                           int src);
+extern int mca_spml_sm_get_nb(shmem_ctx_t ctx,
+                              void* src_addr,
+                              size_t size,
+                              void* dst_addr,
+                              int src,
+                              void **handle);
+extern int mca_spml_sm_put_all_nb(void *dest, const void *source, size_t size, long *counter);
+
+extern int mca_spml_sm_recv(void* buf, size_t size, int src);
+extern int mca_spml_sm_send(void* buf,
+                            size_t size,
+                            int dst,
+                            mca_spml_base_put_mode_t mode);
+
+extern int mca_spml_sm_fence(shmem_ctx_t ctx);
+extern int mca_spml_sm_quiet(shmem_ctx_t ctx);
+
+END_C_DECLS
+
+#endif
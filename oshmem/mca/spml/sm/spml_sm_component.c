@@ -0,0 +1,123 @@
+/*
+ * $COPYRIGHT$
+ *
+ * Additional copyrights may follow
+ *
+ * $HEADER$
+ */
+#define _GNU_SOURCE
+#include <stdio.h>
+
+#include <sys/types.h>
+#include <unistd.h>
+
+#include "oshmem_config.h"
+#include "shmem.h"
+#include "oshmem/runtime/params.h"
+#include "oshmem/mca/spml/spml.h"
+#include "oshmem/mca/spml/base/base.h"
+#include "spml_sm_component.h"
+#include "oshmem/mca/spml/sm/spml_sm.h"
+
+#ifdef HAVE_SYS_PRCTL_H
+#include <sys/prctl.h>
+#endif
+
+static int mca_spml_sm_component_register(void);
+static int mca_spml_sm_component_open(void);
+static int mca_spml_sm_component_close(void);
+static mca_spml_base_module_t*
+mca_spml_sm_component_init(int* priority,
+                           bool enable_progress_threads,
+                           bool enable_mpi_threads);
+static int mca_spml_sm_component_fini(void);
+mca_spml_base_component_2_0_0_t mca_spml_sm_component = {
+
+    /* First, the mca_base_component_t struct containing meta
+       information about the component itself */
+
+    .spmlm_version = {
+        MCA_SPML_BASE_VERSION_2_0_0,
+
+        .mca_component_name            = "sm",
+        .mca_component_major_version   = OSHMEM_MAJOR_VERSION,
+        .mca_component_minor_version   = OSHMEM_MINOR_VERSION,
+        .mca_component_release_version = OSHMEM_RELEASE_VERSION,
+        .mca_open_component            = mca_spml_sm_component_open,
+        .mca_close_component           = mca_spml_sm_component_close,
+        .mca_query_component           = NULL,
+        .mca_register_component_params = mca_spml_sm_component_register
+    },
+    .spmlm_data = {
+        /* The component is checkpoint ready */
+        .param_field                   = MCA_BASE_METADATA_PARAM_CHECKPOINT
+    },
+
+    .spmlm_init                        = mca_spml_sm_component_init,
+    .spmlm_finalize                    = mca_spml_sm_component_fini
+};
+
+static int mca_spml_sm_component_register(void)
+{
+    /* lower than ucx, which is preferred when it is available */
+    mca_spml_sm.priority = 10;
+    (void) mca_base_component_var_register(&mca_spml_sm_component.spmlm_version,
+                                           "priority",
+                                           "[integer] sm priority",
+                                           MCA_BASE_VAR_TYPE_INT, NULL, 0, 0,
+                                           OPAL_INFO_LVL_9,
+                                           MCA_BASE_VAR_SCOPE_READONLY,
+                                           &mca_spml_sm.priority);
+
+    return OSHMEM_SUCCESS;
+}
+
+static int mca_spml_sm_component_open(void)
+{
+    return OSHMEM_SUCCESS;
+}
+
+static int mca_spml_sm_component_close(void)
+{
+    return OSHMEM_SUCCESS;
+}
+
+static mca_spml_base_module_t*
+mca_spml_sm_component_init(int* priority,
+                           bool enable_progress_threads,
+                           bool enable_mpi_threads)
+{
+    SPML_VERBOSE( 10, "in sm, my priority is %d\n", mca_spml_sm.priority);
+
+    if ((*priority) > mca_spml_sm.priority) {
+        *priority = mca_spml_sm.priority;
+        return NULL ;
+    }
+
+    /* only jobs running on a single node */
+    if (ompi_process_info.num_local_peers + 1 < ompi_process_info.num_procs) {
+        SPML_VERBOSE(10, "sm can not be used, the job spans several nodes");
+        return NULL ;
+    }
+    *priority = mca_spml_sm.priority;
+
+#if OSHMEM_SPML_SM_HAVE_CMA && defined(PR_SET_PTRACER)
+    /* let the peers read and write the segments that are not shared */
+    (void) prctl(PR_SET_PTRACER, PR_SET_PTRACER_ANY, 0, 0, 0);
+#endif
+
+    oshmem_ctx_default = (shmem_ctx_t) &mca_spml_sm_ctx_default;
+
+    SPML_VERBOSE(50, "*** sm initialized ****");
+    return &mca_spml_sm.super;
+}
+
+static int mca_spml_sm_component_fini(void)
+{
+    if(!mca_spml_sm.enabled)
+        return OSHMEM_SUCCESS; /* never selected.. return success.. */
+
+    mca_spml_sm.enabled = false;  /* not anymore */
+
+    return OSHMEM_SUCCESS;
+}
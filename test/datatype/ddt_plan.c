@@ -0,0 +1,189 @@
+/* -*- Mode: C; c-basic-offset:4 ; indent-tabs-mode:nil -*- */
+/*
+ * $COPYRIGHT$
+ *
+ * Additional copyrights may follow
+ *
+ * $HEADER$
+ */
+
+#include "ompi_config.h"
+#include <stdbool.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "opal/datatype/opal_convertor.h"
+#include "opal/datatype/opal_datatype_internal.h"
+#include "ompi/datatype/ompi_datatype.h"
+#include "opal/runtime/opal.h"
+
+/**
+ * Check that packing and unpacking a whole message at once, which goes
+ * through the copy plan of the datatype, gives the same result as the
+ * generic functions used when the message is moved in small fragments.
+ * Also check that the datatypes which should have a copy plan do have
+ * one, and that the contiguous and the too irregular ones do not.
+ */
+
+#define COUNT 7
+#define FRAGMENT 13
+#define IRREGULAR 100
+
+static int pack_unpack(ompi_datatype_t *datatype, const char *name, bool expect_plan)
+{
+    opal_convertor_t *convertor;
+    ptrdiff_t lb, extent;
+    size_t size, max_data, position;
+    char *user, *whole, *pieces, *recv_whole, *recv_pieces;
+    struct iovec iov;
+    uint32_t iov_count;
+    int errors = 0;
+
+    ompi_datatype_get_extent(datatype, &lb, &extent);
+    ompi_datatype_type_size(datatype, &size);
+    size *= COUNT;
+
+    user = malloc(extent * COUNT);
+    recv_whole = malloc(extent * COUNT);
+    recv_pieces = malloc(extent * COUNT);
+    whole = malloc(size);
+    pieces = malloc(size);
+    for (ptrdiff_t i = 0; i < extent * COUNT; i++) {
+        user[i] = (char) i;
+    }
+    memset(recv_whole, 0xff, extent * COUNT);
+    memset(recv_pieces, 0xff, extent * COUNT);
+
+    /* pack everything at once */
+    convertor = opal_convertor_create(opal_local_arch, 0);
+    opal_convertor_prepare_for_send(convertor, &(datatype->super), COUNT, user - lb);
+    iov.iov_base = whole;
+    iov.iov_len = size;
+    iov_count = 1;
+    max_data = size;
+    opal_convertor_pack(convertor, &iov, &iov_count, &max_data);
+    if (max_data != size) {
+        printf("%s: packed %" PRIsize_t " bytes instead of %" PRIsize_t "\n", name, max_data, size);
+        errors++;
+    }
+    OBJ_RELEASE(convertor);
+
+    /* pack in fragments */
+    convertor = opal_convertor_create(opal_local_arch, 0);
+    opal_convertor_prepare_for_send(convertor, &(datatype->super), COUNT, user - lb);
+    for (position = 0; position < size; position += max_data) {
+        iov.iov_base = pieces + position;
+        iov.iov_len = (size - position) < FRAGMENT ? (size - position) : FRAGMENT;
+        iov_count = 1;
+        max_data = iov.iov_len;
+        opal_convertor_pack(convertor, &iov, &iov_count, &max_data);
+    }
+    OBJ_RELEASE(convertor);
+
+    if (0 != memcmp(whole, pieces, size)) {
+        printf("%s: packed data differ\n", name);
+        errors++;
+    }
+
+    /* unpack everything at once */
+    convertor = opal_convertor_create(opal_local_arch, 0);
+    opal_convertor_prepare_for_recv(convertor, &(datatype->super), COUNT, recv_whole - lb);
+    iov.iov_base = whole;
+    iov.iov_len = size;
+    iov_count = 1;
+    max_data = size;
+    opal_convertor_unpack(convertor, &iov, &iov_count, &max_data);
+    OBJ_RELEASE(convertor);
+
+    /* unpack in fragments */
+    convertor = opal_convertor_create(opal_local_arch, 0);
+    opal_convertor_prepare_for_recv(convertor, &(datatype->super), COUNT, recv_pieces - lb);
+    for (position = 0; position < size; position += max_data) {
+        iov.iov_base = pieces + position;
+        iov.iov_len = (size - position) < FRAGMENT ? (size - position) : FRAGMENT;
+        iov_count = 1;
+        max_data = iov.iov_len;
+        opal_convertor_unpack(convertor, &iov, &iov_count, &max_data);
+    }
+    OBJ_RELEASE(convertor);
+
+    if (0 != memcmp(recv_whole, recv_pieces, extent * COUNT)) {
+        printf("%s: unpacked data differ\n", name);
+        errors++;
+    }
+
+    if (expect_plan != (NULL != datatype->super.plan)) {
+        printf("%s: copy plan %s\n", name, expect_plan ? "missing" : "unexpected");
+        errors++;
+    }
+    printf("%s: %s copy plan, %s\n", name,
+           (NULL != datatype->super.plan) ? "with" : "without", errors ? "FAILED" : "OK");
+
+    free(user);
+    free(recv_whole);
+    free(recv_pieces);
+    free(whole);
+    free(pieces);
+    return errors;
+}
+
+int main(int argc, char *argv[])
+{
+    ompi_datatype_t *vector, *hvector, *indexed, *structure, *contiguous, *irregular, *types[3];
+    int blengths[3] = {2, 1, 3}, displs[3] = {0, 5, 7};
+    int irregular_blengths[IRREGULAR], irregular_displs[IRREGULAR];
+    ptrdiff_t sdispls[3] = {0, 16, 40};
+    int errors = 0;
+
+    opal_init_util(NULL, NULL);
+    ompi_datatype_init();
+
+    ompi_datatype_create_vector(10, 2, 5, MPI_DOUBLE, &vector);
+    ompi_datatype_commit(&vector);
+    errors += pack_unpack(vector, "vector", true);
+
+    ompi_datatype_create_hvector(3, 1, 200, vector, &hvector);
+    ompi_datatype_commit(&hvector);
+    errors += pack_unpack(hvector, "hvector of vector", true);
+
+    ompi_datatype_create_indexed(3, blengths, displs, MPI_INT, &indexed);
+    ompi_datatype_commit(&indexed);
+    errors += pack_unpack(indexed, "indexed", true);
+
+    types[0] = &ompi_mpi_int.dt;
+    types[1] = &ompi_mpi_double.dt;
+    types[2] = indexed;
+    ompi_datatype_create_struct(3, blengths, sdispls, types, &structure);
+    ompi_datatype_commit(&structure);
+    errors += pack_unpack(structure, "struct", true);
+
+    ompi_datatype_create_contiguous(4, MPI_INT, &contiguous);
+    ompi_datatype_commit(&contiguous);
+    errors += pack_unpack(contiguous, "contiguous", false);
+
+    /* blocks of changing lengths at changing distances cannot be merged,
+     * this needs more runs than a plan may have */
+    for (int i = 0; i < IRREGULAR; i++) {
+        irregular_blengths[i] = i % 3 + 1;
+        irregular_displs[i] = (0 == i) ? 0 : irregular_displs[i - 1] + irregular_blengths[i - 1]
+                                                 + i % 5 + 1;
+    }
+    ompi_datatype_create_indexed(IRREGULAR, irregular_blengths, irregular_displs, MPI_INT,
+                                 &irregular);
+    ompi_datatype_commit(&irregular);
+    errors += pack_unpack(irregular, "irregular indexed", false);
+
+    ompi_datatype_destroy(&irregular);
+    ompi_datatype_destroy(&contiguous);
+
+    ompi_datatype_destroy(&structure);
+    ompi_datatype_destroy(&indexed);
+    ompi_datatype_destroy(&hvector);
+    ompi_datatype_destroy(&vector);
+
+    ompi_datatype_finalize();
+    opal_finalize_util();
+
+    return (0 == errors) ? 0 : 1;
+}
@@ -0,0 +1,247 @@
+/* -*- Mode: C; c-basic-offset:4 ; indent-tabs-mode:nil -*- */
+/*
+ * $COPYRIGHT$
+ *
+ * Additional copyrights may follow
+ *
+ * $HEADER$
+ */
+
+#include "ompi_config.h"
+
+#include <stddef.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdint.h>
+
+#include "mpi.h"
+#include "ompi/datatype/ompi_datatype.h"
+#include "ompi/op/op.h"
+
+/**
+ * Compare the logical, MAXLOC/MINLOC and complex sum/prod reductions with a
+ * scalar loop, for every count up to a few vector widths and at unaligned
+ * addresses, so that all the remainder paths of the vectorized functions
+ * are covered. Both the two and the three buffer versions are checked.
+ *
+ * The complex products are also computed on fractional inputs, for which
+ * the result depends on whether the products are rounded before the
+ * subtraction and the addition. All the vector paths must round them like
+ * the scalar code, or MPI_PROD would give different results on different
+ * processors. The fractional inputs are only used on x86, where the vector
+ * functions are, as compilers on other architectures may contract the
+ * products of the base functions into fused multiply-adds.
+ */
+
+#define MAX_COUNT 130
+#define MAX_SHIFT 3
+
+static int errors = 0;
+
+static void report(const char *op, const char *type, const char *variant, int count, int shift,
+                   int i)
+{
+    if (errors < 20) {
+        fprintf(stderr, "%s %s (%s) count %d shift %d: wrong element %d\n", op, type, variant,
+                count, shift, i);
+    }
+    errors++;
+}
+
+/* run MPI_Reduce_local and the three buffer reduction on in and out, and
+ * check both against ref. Only the first cmp_size bytes of every element are
+ * compared, the rest is padding. */
+static void check(MPI_Op op, MPI_Datatype type, const char *op_name, const char *type_name,
+                  size_t elem_size, size_t cmp_size, const void *in, const void *out,
+                  const void *ref, int count, int shift)
+{
+    char *inout = malloc((count + 1) * elem_size), *target = malloc((count + 1) * elem_size);
+
+    memcpy(inout, out, count * elem_size);
+    MPI_Reduce_local((void *) in, inout, count, type, op);
+    for (int i = 0; i < count; i++) {
+        if (0 != memcmp(inout + i * elem_size, (const char *) ref + i * elem_size, cmp_size)) {
+            report(op_name, type_name, "2buff", count, shift, i);
+            break;
+        }
+    }
+
+    memset(target, 0x5a, count * elem_size);
+    ompi_3buff_op_reduce((ompi_op_t *) op, (void *) in, (void *) out, target, count,
+                         (ompi_datatype_t *) type);
+    for (int i = 0; i < count; i++) {
+        if (0 != memcmp(target + i * elem_size, (const char *) ref + i * elem_size, cmp_size)) {
+            report(op_name, type_name, "3buff", count, shift, i);
+            break;
+        }
+    }
+
+    free(inout);
+    free(target);
+}
+
+#define TEST_LOGICAL(ctype, mpitype)                                                               \
+    static void test_logical_##ctype(void)                                                         \
+    {                                                                                              \
+        ctype in[MAX_COUNT + MAX_SHIFT], out[MAX_COUNT + MAX_SHIFT], ref[MAX_COUNT];               \
+        for (int i = 0; i < MAX_COUNT + MAX_SHIFT; i++) {                                          \
+            in[i] = (ctype) (rand() % 3);                                                          \
+            out[i] = (ctype) (rand() % 3);                                                         \
+        }                                                                                          \
+        for (int shift = 0; shift < MAX_SHIFT; shift++) {                                          \
+            for (int count = 1; count <= MAX_COUNT; count++) {                                     \
+                for (int i = 0; i < count; i++) {                                                  \
+                    ref[i] = in[shift + i] && out[shift + i];                                      \
+                }                                                                                  \
+                check(MPI_LAND, mpitype, "land", #ctype, sizeof(ctype), sizeof(ctype), in + shift, \
+                      out + shift, ref, count, shift);                                             \
+                for (int i = 0; i < count; i++) {                                                  \
+                    ref[i] = in[shift + i] || out[shift + i];                                      \
+                }                                                                                  \
+                check(MPI_LOR, mpitype, "lor", #ctype, sizeof(ctype), sizeof(ctype), in + shift,   \
+                      out + shift, ref, count, shift);                                             \
+                for (int i = 0; i < count; i++) {                                                  \
+                    ref[i] = !in[shift + i] != !out[shift + i];                                    \
+                }                                                                                  \
+                check(MPI_LXOR, mpitype, "lxor", #ctype, sizeof(ctype), sizeof(ctype), in + shift, \
+                      out + shift, ref, count, shift);                                             \
+            }                                                                                      \
+        }                                                                                          \
+    }
+
+TEST_LOGICAL(int8_t, MPI_INT8_T)
+TEST_LOGICAL(uint8_t, MPI_UINT8_T)
+TEST_LOGICAL(int16_t, MPI_INT16_T)
+TEST_LOGICAL(uint16_t, MPI_UINT16_T)
+TEST_LOGICAL(int32_t, MPI_INT32_T)
+TEST_LOGICAL(uint32_t, MPI_UINT32_T)
+TEST_LOGICAL(int64_t, MPI_INT64_T)
+TEST_LOGICAL(uint64_t, MPI_UINT64_T)
+
+#define TEST_LOC(name, vtype, mpitype)                                                  \
+    typedef struct {                                                                    \
+        vtype v;                                                                        \
+        int k;                                                                          \
+    } name##_t;                                                                         \
+    static void test_loc_##name(void)                                                   \
+    {                                                                                   \
+        name##_t in[MAX_COUNT + MAX_SHIFT], out[MAX_COUNT + MAX_SHIFT], ref[MAX_COUNT]; \
+        memset(in, 0, sizeof(in));                                                      \
+        memset(out, 0, sizeof(out));                                                    \
+        memset(ref, 0, sizeof(ref));                                                    \
+        for (int i = 0; i < MAX_COUNT + MAX_SHIFT; i++) {                               \
+            in[i].v = (vtype) (rand() % 5);                                             \
+            in[i].k = rand() % 100;                                                     \
+            out[i].v = (vtype) (rand() % 5);                                            \
+            out[i].k = rand() % 100;                                                    \
+        }                                                                               \
+        for (int shift = 0; shift < MAX_SHIFT; shift++) {                               \
+            name##_t *a = in + shift, *b = out + shift;                                 \
+            for (int count = 1; count <= MAX_COUNT; count++) {                          \
+                for (int i = 0; i < count; i++) {                                       \
+                    ref[i] = (a[i].v > b[i].v) ? a[i] : b[i];                           \
+                    if (a[i].v == b[i].v) {                                             \
+                        ref[i].k = (a[i].k < b[i].k) ? a[i].k : b[i].k;                 \
+                    }                                                                   \
+                }                                                                       \
+                check(MPI_MAXLOC, mpitype, "maxloc", #name, sizeof(name##_t),           \
+                      offsetof(name##_t, k) + sizeof(int), a, b, ref, count, shift);    \
+                for (int i = 0; i < count; i++) {                                       \
+                    ref[i] = (a[i].v < b[i].v) ? a[i] : b[i];                           \
+                    if (a[i].v == b[i].v) {                                             \
+                        ref[i].k = (a[i].k < b[i].k) ? a[i].k : b[i].k;                 \
+                    }                                                                   \
+                }                                                                       \
+                check(MPI_MINLOC, mpitype, "minloc", #name, sizeof(name##_t),           \
+                      offsetof(name##_t, k) + sizeof(int), a, b, ref, count, shift);    \
+            }                                                                           \
+        }                                                                               \
+    }
+
+TEST_LOC(two_int, int, MPI_2INT)
+TEST_LOC(float_int, float, MPI_FLOAT_INT)
+TEST_LOC(double_int, double, MPI_DOUBLE_INT)
+
+#if defined(__x86_64__) || defined(__i386__)
+#    define COMPLEX_INPUTS 2
+#else
+#    define COMPLEX_INPUTS 1
+#endif
+
+#define TEST_COMPLEX(name, ftype, mpitype)                                                      \
+    static void test_complex_##name(void)                                                       \
+    {                                                                                           \
+        ftype in[2 * (MAX_COUNT + MAX_SHIFT)], out[2 * (MAX_COUNT + MAX_SHIFT)];                \
+        ftype ref[2 * MAX_COUNT];                                                               \
+        for (int fractional = 0; fractional < COMPLEX_INPUTS; fractional++) {                   \
+            for (int i = 0; i < 2 * (MAX_COUNT + MAX_SHIFT); i++) {                             \
+                if (fractional) {                                                               \
+                    in[i] = (ftype) (rand() % 2001 - 1000) / (ftype) 7;                         \
+                    out[i] = (ftype) (rand() % 2001 - 1000) / (ftype) 3;                        \
+                } else {                                                                        \
+                    in[i] = (ftype) (rand() % 17 - 8);                                          \
+                    out[i] = (ftype) (rand() % 17 - 8);                                         \
+                }                                                                               \
+            }                                                                                   \
+            for (int shift = 0; shift < MAX_SHIFT; shift++) {                                   \
+                ftype *a = in + 2 * shift, *b = out + 2 * shift;                                \
+                for (int count = 1; count <= MAX_COUNT; count++) {                              \
+                    for (int i = 0; i < 2 * count; i++) {                                       \
+                        ref[i] = a[i] + b[i];                                                   \
+                    }                                                                           \
+                    check(MPI_SUM, mpitype, "sum", #name, 2 * sizeof(ftype), 2 * sizeof(ftype), \
+                          a, b, ref, count, shift);                                             \
+                    for (int i = 0; i < count; i++) {                                           \
+                        /* volatile rounds every product on its own */                          \
+                        volatile ftype ac = a[2 * i] * b[2 * i];                                \
+                        volatile ftype bd = a[2 * i + 1] * b[2 * i + 1];                        \
+                        volatile ftype ad = a[2 * i] * b[2 * i + 1];                            \
+                        volatile ftype bc = a[2 * i + 1] * b[2 * i];                            \
+                        ref[2 * i] = ac - bd;                                                   \
+                        ref[2 * i + 1] = ad + bc;                                               \
+                    }                                                                           \
+                    check(MPI_PROD, mpitype, fractional ? "prod (fractional)" : "prod", #name,  \
+                          2 * sizeof(ftype), 2 * sizeof(ftype), a, b, ref, count, shift);       \
+                }                                                                               \
+            }                                                                                   \
+        }                                                                                       \
+    }
+
+#if HAVE_FLOAT__COMPLEX
+TEST_COMPLEX(c_float_complex, float, MPI_C_FLOAT_COMPLEX)
+#endif
+#if HAVE_DOUBLE__COMPLEX
+TEST_COMPLEX(c_double_complex, double, MPI_C_DOUBLE_COMPLEX)
+#endif
+
+int main(int argc, char *argv[])
+{
+    MPI_Init(&argc, &argv);
+    srand(1);
+
+    test_logical_int8_t();
+    test_logical_uint8_t();
+    test_logical_int16_t();
+    test_logical_uint16_t();
+    test_logical_int32_t();
+    test_logical_uint32_t();
+    test_logical_int64_t();
+    test_logical_uint64_t();
+
+    test_loc_two_int();
+    test_loc_float_int();
+    test_loc_double_int();
+
+#if HAVE_FLOAT__COMPLEX
+    test_complex_c_float_complex();
+#endif
+#if HAVE_DOUBLE__COMPLEX
+    test_complex_c_double_complex();
+#endif
+
+    printf("reduce_avx: %s (%d errors)\n", (0 == errors) ? "passed" : "FAILED", errors);
+
+    MPI_Finalize();
+    return (0 == errors) ? 0 : 1;
+}
@@ -0,0 +1,92 @@
+/*
+ * Correctness check of the segmented allreduce of coll sm. The counts go
+ * from a single element to many fragments, below, equal to and above the
+ * size of a fragment, with counts that are not a multiple of it, e.g.
+ *
+ *   mpirun -np 4 --mca coll_sm_priority 100 coll_sm_allreduce [fragment_size]
+ *
+ * fragment_size must match coll_sm_fragment_size (8192 by default). The
+ * program exits with a non zero status if any result is wrong.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "mpi.h"
+
+static int check(int rank, int size, int count, int in_place)
+{
+    int *ibuf = malloc((count + 1) * sizeof(int)), *iresult = malloc((count + 1) * sizeof(int));
+    double *dbuf = malloc((count + 1) * sizeof(double));
+    double *dresult = malloc((count + 1) * sizeof(double));
+    int i, errors = 0;
+
+    for (i = 0; i < count; i++) {
+        iresult[i] = ibuf[i] = rank + i;
+        dresult[i] = dbuf[i] = (double) ((rank * 7 + i) % 11);
+    }
+
+    if (in_place) {
+        MPI_Allreduce(MPI_IN_PLACE, iresult, count, MPI_INT, MPI_SUM, MPI_COMM_WORLD);
+        MPI_Allreduce(MPI_IN_PLACE, dresult, count, MPI_DOUBLE, MPI_MAX, MPI_COMM_WORLD);
+    } else {
+        MPI_Allreduce(ibuf, iresult, count, MPI_INT, MPI_SUM, MPI_COMM_WORLD);
+        MPI_Allreduce(dbuf, dresult, count, MPI_DOUBLE, MPI_MAX, MPI_COMM_WORLD);
+    }
+
+    for (i = 0; i < count; i++) {
+        double dexpected = 0.0;
+        int r;
+
+        for (r = 0; r < size; r++) {
+            double v = (double) ((r * 7 + i) % 11);
+            dexpected = (v > dexpected) ? v : dexpected;
+        }
+        if (iresult[i] != size * (size - 1) / 2 + size * i || dresult[i] != dexpected) {
+            errors++;
+        }
+        /* the send buffer must be left alone */
+        if (!in_place && (ibuf[i] != rank + i || dbuf[i] != (double) ((rank * 7 + i) % 11))) {
+            errors++;
+        }
+    }
+
+    free(ibuf);
+    free(iresult);
+    free(dbuf);
+    free(dresult);
+    return errors;
+}
+
+int main(int argc, char *argv[])
+{
+    int rank, size, c, in_place, errors = 0, all_errors = 0;
+    int fragment = (argc > 1) ? atoi(argv[1]) : 8192;
+    int seg = fragment / (int) sizeof(double);
+    int counts[] = {1, 3, seg - 1, seg, seg + 1, 2 * seg, 3 * seg + 7, 41 * seg + 5};
+    int ncounts = (int) (sizeof(counts) / sizeof(counts[0]));
+
+    MPI_Init(&argc, &argv);
+    MPI_Comm_rank(MPI_COMM_WORLD, &rank);
+    MPI_Comm_size(MPI_COMM_WORLD, &size);
+
+    for (in_place = 0; in_place < 2; in_place++) {
+        for (c = 0; c < ncounts; c++) {
+            int e = check(rank, size, counts[c], in_place);
+
+            if (0 != e) {
+                fprintf(stderr, "[%d] allreduce%s count %d: %d wrong elements\n", rank,
+                        in_place ? " in place" : "", counts[c], e);
+            }
+            errors += e;
+        }
+    }
+
+    MPI_Allreduce(&errors, &all_errors, 1, MPI_INT, MPI_SUM, MPI_COMM_WORLD);
+    if (0 == rank) {
+        printf("coll sm allreduce: %s\n", (0 == all_errors) ? "passed" : "FAILED");
+    }
+
+    MPI_Finalize();
+    return (0 == all_errors) ? 0 : 1;
+}
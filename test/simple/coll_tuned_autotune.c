@@ -0,0 +1,221 @@
+/*
+ * Correctness check of the collectives tuned online by coll tuned. Every
+ * collective is called often enough, for a few message sizes, to go
+ * through the learning phase, in which all the algorithms are tried, and
+ * then to run with the algorithm pinned for the size, e.g.
+ *
+ *   mpirun -np 5 --mca coll_tuned_use_dynamic_rules 1 --mca coll_tuned_autotune 1 \
+ *       --mca coll_tuned_autotune_samples 2 \
+ *       --mca coll_tuned_autotune_output /tmp/autotune.rules \
+ *       coll_tuned_autotune /tmp/autotune.rules
+ *
+ * The reductions are also done with a non commutative operation, which
+ * must only be tuned among the algorithms that keep the order of the
+ * ranks. If a file name is given, it must be the autotune output, and
+ * the program checks that the learned rules were written to it. The
+ * program exits with a non zero status if any result is wrong.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "mpi.h"
+
+/* enough calls for the algorithms of every collective to be tried
+ * coll_tuned_autotune_samples (up to 2) times, and some more */
+#define CALLS 40
+
+static const int counts[] = {1, 100, 10000};
+#define NCOUNTS (int) (sizeof(counts) / sizeof(counts[0]))
+
+/* x -> a * x + b; the composition of such functions is associative but
+ * not commutative */
+typedef struct {
+    unsigned int a, b;
+} affine_t;
+
+static void compose(void *in, void *inout, int *len, MPI_Datatype *type)
+{
+    affine_t *f = (affine_t *) in, *g = (affine_t *) inout;
+    int i;
+
+    (void) type;
+    for (i = 0; i < *len; i++) {
+        /* g = f o g */
+        g[i].b = f[i].a * g[i].b + f[i].b;
+        g[i].a = f[i].a * g[i].a;
+    }
+}
+
+static affine_t function_of(int rank, int i)
+{
+    affine_t f = {2u * rank + 3u + i, rank + 1u + 7u * i};
+    return f;
+}
+
+static int check_reductions(MPI_Comm comm, MPI_Op op, MPI_Datatype affine, int count)
+{
+    int rank, size, i, r, errors = 0;
+    affine_t *fs, *result, expected;
+    int *sums, *sum_result;
+
+    MPI_Comm_rank(comm, &rank);
+    MPI_Comm_size(comm, &size);
+    fs = malloc(count * sizeof(affine_t));
+    result = malloc(count * size * sizeof(affine_t));
+    sums = malloc(count * size * sizeof(int));
+    sum_result = malloc(count * size * sizeof(int));
+
+    for (i = 0; i < count; i++) {
+        fs[i] = function_of(rank, i);
+    }
+    for (i = 0; i < count * size; i++) {
+        sums[i] = rank + i;
+    }
+
+    MPI_Allreduce(fs, result, count, affine, op, comm);
+    MPI_Allreduce(sums, sum_result, count, MPI_INT, MPI_SUM, comm);
+    for (i = 0; i < count; i++) {
+        /* f_0 o f_1 o ... o f_{size - 1} */
+        expected = function_of(size - 1, i);
+        for (r = size - 2; r >= 0; r--) {
+            affine_t f = function_of(r, i);
+            int one = 1;
+            compose(&f, &expected, &one, NULL);
+        }
+        if (result[i].a != expected.a || result[i].b != expected.b) {
+            errors++;
+        }
+        if (sum_result[i] != size * (size - 1) / 2 + size * i) {
+            errors++;
+        }
+    }
+
+    MPI_Reduce(fs, result, count, affine, op, size - 1, comm);
+    if (size - 1 == rank) {
+        for (i = 0; i < count; i++) {
+            expected = function_of(size - 1, i);
+            for (r = size - 2; r >= 0; r--) {
+                affine_t f = function_of(r, i);
+                int one = 1;
+                compose(&f, &expected, &one, NULL);
+            }
+            if (result[i].a != expected.a || result[i].b != expected.b) {
+                errors++;
+            }
+        }
+    }
+
+    MPI_Reduce_scatter_block(sums, sum_result, count, MPI_INT, MPI_SUM, comm);
+    for (i = 0; i < count; i++) {
+        if (sum_result[i] != size * (size - 1) / 2 + size * (rank * count + i)) {
+            errors++;
+        }
+    }
+
+    free(fs);
+    free(result);
+    free(sums);
+    free(sum_result);
+    return errors;
+}
+
+static int check_data_movement(MPI_Comm comm, int count)
+{
+    int rank, size, i, p, errors = 0;
+    int *sbuf, *rbuf;
+
+    MPI_Comm_rank(comm, &rank);
+    MPI_Comm_size(comm, &size);
+    sbuf = malloc(count * size * sizeof(int));
+    rbuf = malloc(count * size * sizeof(int));
+
+    for (i = 0; i < count; i++) {
+        rbuf[i] = (1 == rank % size) ? 1000 + i : -1;
+    }
+    MPI_Bcast(rbuf, count, MPI_INT, 1 % size, comm);
+    for (i = 0; i < count; i++) {
+        errors += (rbuf[i] != 1000 + i);
+    }
+
+    for (i = 0; i < count; i++) {
+        sbuf[i] = rank * count + i;
+    }
+    MPI_Allgather(sbuf, count, MPI_INT, rbuf, count, MPI_INT, comm);
+    for (i = 0; i < count * size; i++) {
+        errors += (rbuf[i] != i);
+    }
+
+    for (p = 0; p < size; p++) {
+        for (i = 0; i < count; i++) {
+            sbuf[p * count + i] = rank * 100003 + p * 101 + i;
+        }
+    }
+    MPI_Alltoall(sbuf, count, MPI_INT, rbuf, count, MPI_INT, comm);
+    for (p = 0; p < size; p++) {
+        for (i = 0; i < count; i++) {
+            errors += (rbuf[p * count + i] != p * 100003 + rank * 101 + i);
+        }
+    }
+
+    MPI_Barrier(comm);
+
+    free(sbuf);
+    free(rbuf);
+    return errors;
+}
+
+int main(int argc, char *argv[])
+{
+    int rank, c, call, errors = 0, all_errors = 0;
+    MPI_Datatype affine;
+    MPI_Op op;
+
+    MPI_Init(&argc, &argv);
+    MPI_Comm_rank(MPI_COMM_WORLD, &rank);
+
+    MPI_Type_contiguous(2, MPI_UNSIGNED, &affine);
+    MPI_Type_commit(&affine);
+    MPI_Op_create(compose, 0, &op);
+
+    for (c = 0; c < NCOUNTS; c++) {
+        for (call = 0; call < CALLS; call++) {
+            int e = check_reductions(MPI_COMM_WORLD, op, affine, counts[c]);
+
+            e += check_data_movement(MPI_COMM_WORLD, counts[c]);
+            if (0 != e) {
+                fprintf(stderr, "[%d] count %d call %d: %d wrong elements\n", rank, counts[c],
+                        call, e);
+            }
+            errors += e;
+        }
+    }
+
+    MPI_Allreduce(&errors, &all_errors, 1, MPI_INT, MPI_SUM, MPI_COMM_WORLD);
+    if (0 == rank) {
+        printf("coll tuned autotune: %s\n", (0 == all_errors) ? "passed" : "FAILED");
+    }
+
+    MPI_Op_free(&op);
+    MPI_Type_free(&affine);
+    MPI_Finalize();
+
+    /* the rules are written at MPI_Finalize */
+    if (0 == rank && argc > 1) {
+        FILE *rules = fopen(argv[1], "r");
+        int rule_lines = 0, ch;
+
+        while (NULL != rules && EOF != (ch = fgetc(rules))) {
+            rule_lines += ('\n' == ch);
+        }
+        if (0 == rule_lines) {
+            fprintf(stderr, "no rules were written to %s\n", argv[1]);
+            all_errors++;
+        }
+        if (NULL != rules) {
+            fclose(rules);
+        }
+    }
+
+    return (0 == all_errors) ? 0 : 1;
+}
@@ -0,0 +1,167 @@
+/*
+ * Correctness check of the MPI-IO reads and writes of fbtl uring, e.g.
+ *
+ *   mpirun -np 4 --mca io ompio --mca fbtl uring fbtl_uring [file]
+ *   mpirun -np 4 --mca io ompio --mca fbtl uring \
+ *       --mca fbtl_uring_fixed_buffer_size 65536 fbtl_uring [file]
+ *   mpirun -np 4 --mca io ompio --mca fbtl uring \
+ *       --mca fbtl_uring_fixed_buffer_size 1073741824 fbtl_uring [file]
+ *
+ * The first run does not use a registered buffer. In the second one the
+ * small operations are staged through the registered buffer, and the
+ * larger ones, the strided ones and the ones issued while another
+ * operation holds the buffer go to the user buffers. The third one asks
+ * for a buffer larger than RLIMIT_MEMLOCK usually allows, so it can not be
+ * registered and everything falls back to the user buffers.
+ *
+ * Every process writes and reads back its own part of the file with
+ * blocking, non blocking and collective calls, through a contiguous and
+ * a strided file view. The program exits with a non zero status if any
+ * call fails or any value read back is wrong.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "mpi.h"
+
+#define NREQS 4
+#define BLOCK 8
+
+static const int sizes[] = {1, 100, 4096, 65537, 1 << 20};
+#define NSIZES (int) (sizeof(sizes) / sizeof(sizes[0]))
+
+static int errors = 0;
+
+static void check_rc(int rc, const char *what, int rank, int size)
+{
+    if (MPI_SUCCESS != rc) {
+        fprintf(stderr, "[%d] %s of %d bytes returned %d\n", rank, what, size, rc);
+        errors++;
+    }
+}
+
+static char pattern(int rank, int req, int i, int size)
+{
+    return (char) (rank * 31 + req * 17 + i * 7 + size);
+}
+
+static void check_data(const char *buf, int rank, int req, int size, const char *what)
+{
+    int i;
+
+    for (i = 0; i < size; i++) {
+        if (buf[i] != pattern(rank, req, i, size)) {
+            fprintf(stderr, "[%d] %s of %d bytes: wrong byte %d\n", rank, what, size, i);
+            errors++;
+            return;
+        }
+    }
+}
+
+int main(int argc, char *argv[])
+{
+    const char *name = (argc > 1) ? argv[1] : "fbtl_uring.dat";
+    int rank, nprocs, s, r, i, all_errors = 0;
+    char *wbuf[NREQS], *rbuf[NREQS];
+    MPI_Request reqs[NREQS];
+    MPI_Datatype strided;
+    MPI_File fh;
+
+    MPI_Init(&argc, &argv);
+    MPI_Comm_rank(MPI_COMM_WORLD, &rank);
+    MPI_Comm_size(MPI_COMM_WORLD, &nprocs);
+
+    for (r = 0; r < NREQS; r++) {
+        wbuf[r] = malloc(sizes[NSIZES - 1]);
+        rbuf[r] = malloc(sizes[NSIZES - 1]);
+    }
+
+    check_rc(MPI_File_open(MPI_COMM_WORLD, name,
+                           MPI_MODE_CREATE | MPI_MODE_RDWR | MPI_MODE_DELETE_ON_CLOSE,
+                           MPI_INFO_NULL, &fh),
+             "open", rank, 0);
+
+    for (s = 0; s < NSIZES; s++) {
+        int size = sizes[s];
+        /* every process owns NREQS consecutive blocks of size bytes */
+        MPI_Offset base = (MPI_Offset) rank * NREQS * size;
+
+        for (r = 0; r < NREQS; r++) {
+            for (i = 0; i < size; i++) {
+                wbuf[r][i] = pattern(rank, r, i, size);
+            }
+        }
+
+        /* blocking */
+        check_rc(MPI_File_write_at(fh, base, wbuf[0], size, MPI_BYTE, MPI_STATUS_IGNORE),
+                 "write_at", rank, size);
+        memset(rbuf[0], 0, size);
+        check_rc(MPI_File_read_at(fh, base, rbuf[0], size, MPI_BYTE, MPI_STATUS_IGNORE),
+                 "read_at", rank, size);
+        check_data(rbuf[0], rank, 0, size, "read_at");
+
+        /* several operations in flight, only one of them can hold the
+         * registered buffer */
+        for (r = 0; r < NREQS; r++) {
+            check_rc(MPI_File_iwrite_at(fh, base + (MPI_Offset) r * size, wbuf[r], size, MPI_BYTE,
+                                        reqs + r),
+                     "iwrite_at", rank, size);
+        }
+        check_rc(MPI_Waitall(NREQS, reqs, MPI_STATUSES_IGNORE), "iwrite_at", rank, size);
+        for (r = 0; r < NREQS; r++) {
+            memset(rbuf[r], 0, size);
+            check_rc(MPI_File_iread_at(fh, base + (MPI_Offset) r * size, rbuf[r], size, MPI_BYTE,
+                                       reqs + r),
+                     "iread_at", rank, size);
+        }
+        check_rc(MPI_Waitall(NREQS, reqs, MPI_STATUSES_IGNORE), "iread_at", rank, size);
+        for (r = 0; r < NREQS; r++) {
+            check_data(rbuf[r], rank, r, size, "iread_at");
+        }
+
+        /* collective */
+        check_rc(MPI_File_write_at_all(fh, base, wbuf[1], size, MPI_BYTE, MPI_STATUS_IGNORE),
+                 "write_at_all", rank, size);
+        memset(rbuf[1], 0, size);
+        check_rc(MPI_File_read_at_all(fh, base, rbuf[1], size, MPI_BYTE, MPI_STATUS_IGNORE),
+                 "read_at_all", rank, size);
+        check_data(rbuf[1], rank, 1, size, "read_at_all");
+    }
+
+    /* blocks of BLOCK bytes of each process in turn */
+    MPI_Type_vector(sizes[NSIZES - 1] / BLOCK, BLOCK, BLOCK * nprocs, MPI_BYTE, &strided);
+    MPI_Type_commit(&strided);
+    check_rc(MPI_File_set_view(fh, (MPI_Offset) rank * BLOCK, MPI_BYTE, strided, "native",
+                               MPI_INFO_NULL),
+             "set_view", rank, 0);
+    for (s = 0; s < NSIZES; s++) {
+        int size = sizes[s];
+
+        for (i = 0; i < size; i++) {
+            wbuf[2][i] = pattern(rank, 2, i, size);
+        }
+        check_rc(MPI_File_write_at(fh, 0, wbuf[2], size, MPI_BYTE, MPI_STATUS_IGNORE),
+                 "strided write_at", rank, size);
+        memset(rbuf[2], 0, size);
+        check_rc(MPI_File_read_at(fh, 0, rbuf[2], size, MPI_BYTE, MPI_STATUS_IGNORE),
+                 "strided read_at", rank, size);
+        check_data(rbuf[2], rank, 2, size, "strided read_at");
+    }
+    MPI_Type_free(&strided);
+
+    check_rc(MPI_File_close(&fh), "close", rank, 0);
+
+    MPI_Allreduce(&errors, &all_errors, 1, MPI_INT, MPI_SUM, MPI_COMM_WORLD);
+    if (0 == rank) {
+        printf("fbtl uring: %s\n", (0 == all_errors) ? "passed" : "FAILED");
+    }
+
+    for (r = 0; r < NREQS; r++) {
+        free(wbuf[r]);
+        free(rbuf[r]);
+    }
+    MPI_Finalize();
+    return (0 == all_errors) ? 0 : 1;
+}
@@ -0,0 +1,168 @@
+/*
+ * Correctness check of the hierarchical alltoall, alltoallv and
+ * reduce_scatter. Every collective is run with block sizes below and above
+ * the size limits of the han implementations, with a segment size small
+ * enough to pipeline over several segments, e.g.
+ *
+ *   mpirun -np 8 --map-by ppr:4:node --mca coll_han_priority 100 \
+ *       --mca coll_han_alltoall_segsize 1024 han_collectives
+ *
+ * The program exits with a non zero status if any result is wrong.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "mpi.h"
+
+static const int counts[] = {1, 7, 64, 1000, 4096};
+#define NCOUNTS (int) (sizeof(counts) / sizeof(counts[0]))
+
+/* value sent by rank src to rank dst at position i */
+static int value(int src, int dst, int i)
+{
+    return src * 1000003 + dst * 1009 + i;
+}
+
+static int check_alltoall(int rank, int size, int count)
+{
+    int *sbuf = malloc((size_t) size * count * sizeof(int));
+    int *rbuf = malloc((size_t) size * count * sizeof(int));
+    int p, i, errors = 0;
+
+    for (p = 0; p < size; p++) {
+        for (i = 0; i < count; i++) {
+            sbuf[p * count + i] = value(rank, p, i);
+            rbuf[p * count + i] = -1;
+        }
+    }
+    MPI_Alltoall(sbuf, count, MPI_INT, rbuf, count, MPI_INT, MPI_COMM_WORLD);
+    for (p = 0; p < size; p++) {
+        for (i = 0; i < count; i++) {
+            if (rbuf[p * count + i] != value(p, rank, i)) {
+                errors++;
+            }
+        }
+    }
+
+    free(sbuf);
+    free(rbuf);
+    return errors;
+}
+
+/* rank src sends (src + dst) % 3 * count elements to rank dst */
+static int check_alltoallv(int rank, int size, int count)
+{
+    int *scounts = malloc(4 * size * sizeof(int));
+    int *sdispls = scounts + size, *rcounts = scounts + 2 * size, *rdispls = scounts + 3 * size;
+    int *sbuf, *rbuf, p, i, stotal = 0, rtotal = 0, errors = 0;
+
+    for (p = 0; p < size; p++) {
+        scounts[p] = (rank + p) % 3 * count;
+        rcounts[p] = (p + rank) % 3 * count;
+        sdispls[p] = stotal;
+        rdispls[p] = rtotal;
+        stotal += scounts[p];
+        rtotal += rcounts[p];
+    }
+    sbuf = malloc((stotal + 1) * sizeof(int));
+    rbuf = malloc((rtotal + 1) * sizeof(int));
+    for (p = 0; p < size; p++) {
+        for (i = 0; i < scounts[p]; i++) {
+            sbuf[sdispls[p] + i] = value(rank, p, i);
+        }
+    }
+    for (i = 0; i < rtotal; i++) {
+        rbuf[i] = -1;
+    }
+
+    MPI_Alltoallv(sbuf, scounts, sdispls, MPI_INT, rbuf, rcounts, rdispls, MPI_INT,
+                  MPI_COMM_WORLD);
+    for (p = 0; p < size; p++) {
+        for (i = 0; i < rcounts[p]; i++) {
+            if (rbuf[rdispls[p] + i] != value(p, rank, i)) {
+                errors++;
+            }
+        }
+    }
+
+    free(sbuf);
+    free(rbuf);
+    free(scounts);
+    return errors;
+}
+
+/* rank p gets (p % 2 + 1) * count elements */
+static int check_reduce_scatter(int rank, int size, int count)
+{
+    int *rcounts = malloc(size * sizeof(int));
+    int *sbuf, *rbuf, p, i, total = 0, first = 0, errors = 0;
+
+    for (p = 0; p < size; p++) {
+        rcounts[p] = (p % 2 + 1) * count;
+        if (p < rank) {
+            first += rcounts[p];
+        }
+        total += rcounts[p];
+    }
+    sbuf = malloc(total * sizeof(int));
+    rbuf = malloc(rcounts[rank] * sizeof(int));
+    for (i = 0; i < total; i++) {
+        sbuf[i] = rank + i;
+    }
+    for (i = 0; i < rcounts[rank]; i++) {
+        rbuf[i] = -1;
+    }
+
+    MPI_Reduce_scatter(sbuf, rbuf, rcounts, MPI_INT, MPI_SUM, MPI_COMM_WORLD);
+    for (i = 0; i < rcounts[rank]; i++) {
+        /* sum over all ranks r of r + first + i */
+        if (rbuf[i] != size * (size - 1) / 2 + size * (first + i)) {
+            errors++;
+        }
+    }
+
+    free(sbuf);
+    free(rbuf);
+    free(rcounts);
+    return errors;
+}
+
+int main(int argc, char *argv[])
+{
+    int rank, size, c, errors = 0, all_errors = 0;
+
+    MPI_Init(&argc, &argv);
+    MPI_Comm_rank(MPI_COMM_WORLD, &rank);
+    MPI_Comm_size(MPI_COMM_WORLD, &size);
+
+    for (c = 0; c < NCOUNTS; c++) {
+        int e;
+
+        e = check_alltoall(rank, size, counts[c]);
+        if (0 != e) {
+            fprintf(stderr, "[%d] alltoall count %d: %d wrong elements\n", rank, counts[c], e);
+        }
+        errors += e;
+
+        e = check_alltoallv(rank, size, counts[c]);
+        if (0 != e) {
+            fprintf(stderr, "[%d] alltoallv count %d: %d wrong elements\n", rank, counts[c], e);
+        }
+        errors += e;
+
+        e = check_reduce_scatter(rank, size, counts[c]);
+        if (0 != e) {
+            fprintf(stderr, "[%d] reduce_scatter count %d: %d wrong elements\n", rank, counts[c], e);
+        }
+        errors += e;
+    }
+
+    MPI_Allreduce(&errors, &all_errors, 1, MPI_INT, MPI_SUM, MPI_COMM_WORLD);
+    if (0 == rank) {
+        printf("han collectives: %s\n", (0 == all_errors) ? "passed" : "FAILED");
+    }
+
+    MPI_Finalize();
+    return (0 == all_errors) ? 0 : 1;
+}
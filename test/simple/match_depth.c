@@ -0,0 +1,124 @@
+/*
+ * Measure the cost of message matching as a function of the depth of
+ * the posted and unexpected receive queues.
+ *
+ * Rank 1 keeps "depth" messages in one of its matching queues and the
+ * messages are matched in the order that forces the longest walk:
+ *
+ *   posted:     rank 1 pre-posts depth receives with distinct tags and
+ *               rank 0 sends the tags in reverse order.
+ *   unexpected: rank 0 sends depth messages with distinct tags and
+ *               rank 1 receives them in reverse order.
+ *
+ * Compare the results with and without --mca pml_ob1_match_buckets.
+ *
+ *   mpirun -np 2 ./match_depth [max_depth] [iterations]
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "mpi.h"
+
+#define MAX_DEPTH_DEFAULT 4096
+#define ITERATIONS_DEFAULT 20
+
+static double run_posted(int rank, int depth, int iterations, MPI_Request *reqs, char *buf)
+{
+    double start = 0.0, elapsed = 0.0;
+    int i, it;
+
+    for (it = 0; it < iterations; it++) {
+        if (1 == rank) {
+            for (i = 0; i < depth; i++) {
+                MPI_Irecv(&buf[i], 1, MPI_CHAR, 0, i, MPI_COMM_WORLD, &reqs[i]);
+            }
+        }
+        MPI_Barrier(MPI_COMM_WORLD);
+        start = MPI_Wtime();
+        if (0 == rank) {
+            for (i = depth - 1; i >= 0; i--) {
+                MPI_Send(&buf[i], 1, MPI_CHAR, 1, i, MPI_COMM_WORLD);
+            }
+        } else if (1 == rank) {
+            MPI_Waitall(depth, reqs, MPI_STATUSES_IGNORE);
+            elapsed += MPI_Wtime() - start;
+        }
+    }
+    return elapsed;
+}
+
+static double run_unexpected(int rank, int depth, int iterations, MPI_Request *reqs, char *buf)
+{
+    double start = 0.0, elapsed = 0.0;
+    int i, it;
+
+    for (it = 0; it < iterations; it++) {
+        if (0 == rank) {
+            for (i = 0; i < depth; i++) {
+                MPI_Isend(&buf[i], 1, MPI_CHAR, 1, i, MPI_COMM_WORLD, &reqs[i]);
+            }
+        }
+        /* give the messages time to land in the unexpected queue */
+        MPI_Barrier(MPI_COMM_WORLD);
+        if (1 == rank) {
+            start = MPI_Wtime();
+            for (i = depth - 1; i >= 0; i--) {
+                MPI_Recv(&buf[i], 1, MPI_CHAR, 0, i, MPI_COMM_WORLD, MPI_STATUS_IGNORE);
+            }
+            elapsed += MPI_Wtime() - start;
+        } else if (0 == rank) {
+            MPI_Waitall(depth, reqs, MPI_STATUSES_IGNORE);
+        }
+        MPI_Barrier(MPI_COMM_WORLD);
+    }
+    return elapsed;
+}
+
+int main(int argc, char *argv[])
+{
+    int rank, size, depth, max_depth = MAX_DEPTH_DEFAULT, iterations = ITERATIONS_DEFAULT;
+    MPI_Request *reqs;
+    double posted, unexpected;
+    char *buf;
+
+    MPI_Init(&argc, &argv);
+    MPI_Comm_rank(MPI_COMM_WORLD, &rank);
+    MPI_Comm_size(MPI_COMM_WORLD, &size);
+
+    if (argc > 1) {
+        max_depth = atoi(argv[1]);
+    }
+    if (argc > 2) {
+        iterations = atoi(argv[2]);
+    }
+    if (size < 2 || max_depth < 1 || iterations < 1) {
+        if (0 == rank) {
+            fprintf(stderr, "Usage: mpirun -np 2 ./match_depth [max_depth] [iterations]\n");
+        }
+        MPI_Finalize();
+        return 1;
+    }
+
+    reqs = (MPI_Request *) malloc(max_depth * sizeof(MPI_Request));
+    buf = (char *) calloc(max_depth, 1);
+
+    if (1 == rank) {
+        printf("%10s %20s %20s\n", "depth", "posted (us/msg)", "unexpected (us/msg)");
+    }
+    for (depth = 1; depth <= max_depth; depth *= 2) {
+        posted = run_posted(rank, depth, iterations, reqs, buf);
+        unexpected = run_unexpected(rank, depth, iterations, reqs, buf);
+        if (1 == rank) {
+            printf("%10d %20.3f %20.3f\n", depth,
+                   posted * 1e6 / ((double) depth * iterations),
+                   unexpected * 1e6 / ((double) depth * iterations));
+            fflush(stdout);
+        }
+    }
+
+    free(reqs);
+    free(buf);
+    MPI_Finalize();
+    return 0;
+}
@@ -0,0 +1,144 @@
+/*
+ * Check that the read cache of ompio never returns stale data, e.g.
+ *
+ *   mpirun -np 4 --mca io ompio --mca io_ompio_read_cache_size 1048576 \
+ *       ompio_read_cache [file]
+ *
+ * Every process fills the cache with small strided reads of its part of
+ * the file, changes the file, and reads it again. The file is changed by
+ * an individual write, a non blocking write, a collective write, a write
+ * of another process made visible with sync, barrier, sync, and a
+ * truncation with MPI_File_set_size followed by an extension, after which
+ * the file must read as zeros. The program exits with a non zero status
+ * if any value read back is wrong.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "mpi.h"
+
+/* several cache blocks per process, read CHUNK bytes every STEP bytes */
+#define REGION (256 * 1024)
+#define CHUNK  100
+#define STEP   1000
+
+static int errors = 0;
+
+/* version 0 is a hole in the file */
+static char pattern(int version, MPI_Offset pos)
+{
+    return (0 == version) ? 0 : (char) (version * 37 + pos * 7 + pos / 251);
+}
+
+static void fill(char *buf, int version, MPI_Offset base)
+{
+    int i;
+
+    for (i = 0; i < REGION; i++) {
+        buf[i] = pattern(version, base + i);
+    }
+}
+
+/* small reads all over the region of owner, which must hold version, or be
+ * beyond the end of the file when version is negative */
+static void check(MPI_File fh, int owner, int version, int rank, const char *after)
+{
+    MPI_Offset base = (MPI_Offset) owner * REGION, pos;
+    char buf[CHUNK];
+    MPI_Status status;
+    int i, count;
+
+    for (pos = base; pos + CHUNK <= base + REGION; pos += STEP) {
+        memset(buf, -1, CHUNK);
+        if (MPI_SUCCESS != MPI_File_read_at(fh, pos, buf, CHUNK, MPI_BYTE, &status)) {
+            fprintf(stderr, "[%d] read at %lld failed after %s\n", rank, (long long) pos, after);
+            errors++;
+            return;
+        }
+        MPI_Get_count(&status, MPI_BYTE, &count);
+        if (count != ((version < 0) ? 0 : CHUNK)) {
+            fprintf(stderr, "[%d] read %d bytes at %lld after %s\n", rank, count, (long long) pos,
+                    after);
+            errors++;
+            return;
+        }
+        for (i = 0; i < count; i++) {
+            if (buf[i] != pattern(version, pos + i)) {
+                fprintf(stderr, "[%d] stale data at %lld after %s\n", rank, (long long) pos + i,
+                        after);
+                errors++;
+                return;
+            }
+        }
+    }
+}
+
+int main(int argc, char *argv[])
+{
+    const char *name = (argc > 1) ? argv[1] : "ompio_read_cache.dat";
+    int rank, nprocs, next, all_errors = 0;
+    MPI_Offset base;
+    MPI_Request req;
+    MPI_File fh;
+    char *buf;
+
+    MPI_Init(&argc, &argv);
+    MPI_Comm_rank(MPI_COMM_WORLD, &rank);
+    MPI_Comm_size(MPI_COMM_WORLD, &nprocs);
+    next = (rank + 1) % nprocs;
+    base = (MPI_Offset) rank * REGION;
+    buf = malloc(REGION);
+
+    MPI_File_open(MPI_COMM_WORLD, name, MPI_MODE_CREATE | MPI_MODE_RDWR | MPI_MODE_DELETE_ON_CLOSE,
+                  MPI_INFO_NULL, &fh);
+
+    fill(buf, 1, base);
+    MPI_File_write_at(fh, base, buf, REGION, MPI_BYTE, MPI_STATUS_IGNORE);
+    check(fh, rank, 1, rank, "the first write");
+
+    fill(buf, 2, base);
+    MPI_File_write_at(fh, base, buf, REGION, MPI_BYTE, MPI_STATUS_IGNORE);
+    check(fh, rank, 2, rank, "write_at");
+
+    fill(buf, 3, base);
+    MPI_File_iwrite_at(fh, base, buf, REGION, MPI_BYTE, &req);
+    MPI_Wait(&req, MPI_STATUS_IGNORE);
+    check(fh, rank, 3, rank, "iwrite_at");
+
+    fill(buf, 4, base);
+    MPI_File_write_at_all(fh, base, buf, REGION, MPI_BYTE, MPI_STATUS_IGNORE);
+    check(fh, rank, 4, rank, "write_at_all");
+
+    /* the region of the next process is in the cache before it changes it */
+    MPI_File_sync(fh);
+    MPI_Barrier(MPI_COMM_WORLD);
+    MPI_File_sync(fh);
+    check(fh, next, 4, rank, "write_at_all of another process");
+    MPI_Barrier(MPI_COMM_WORLD);
+    fill(buf, 5, base);
+    MPI_File_write_at(fh, base, buf, REGION, MPI_BYTE, MPI_STATUS_IGNORE);
+    MPI_File_sync(fh);
+    MPI_Barrier(MPI_COMM_WORLD);
+    MPI_File_sync(fh);
+    check(fh, next, 5, rank, "write_at of another process");
+
+    /* truncate the cached data away, then extend the file with a hole */
+    check(fh, rank, 5, rank, "sync");
+    MPI_File_set_size(fh, 0);
+    check(fh, rank, -1, rank, "set_size to 0");
+    MPI_File_set_size(fh, (MPI_Offset) nprocs * REGION);
+    check(fh, rank, 0, rank, "set_size extending the file");
+
+    MPI_File_close(&fh);
+
+    MPI_Allreduce(&errors, &all_errors, 1, MPI_INT, MPI_SUM, MPI_COMM_WORLD);
+    if (0 == rank) {
+        printf("ompio read cache: %s\n", (0 == all_errors) ? "passed" : "FAILED");
+    }
+
+    free(buf);
+    MPI_Finalize();
+    return (0 == all_errors) ? 0 : 1;
+}
@@ -0,0 +1,184 @@
+/*
+ * Correctness check of the small accumulates buffered per target by osc
+ * rdma, e.g.
+ *
+ *   mpirun -np 4 --mca osc rdma --mca btl self,tcp osc_rdma_accumulate
+ *   mpirun -np 4 --mca osc rdma --mca btl self,tcp \
+ *       --mca osc_rdma_acc_aggregate_size 0 osc_rdma_accumulate
+ *
+ * The second run disables the buffering and must give the same results.
+ * Every process adds to all the elements of every target, one or two
+ * elements at a time and in decreasing then increasing order, so that the
+ * buffered elements are combined, sorted and issued in runs. It also
+ * takes the maximum of doubles, and checks that a fetch and op issued
+ * after buffered accumulates to the same target sees them.
+ *
+ * The window uses MPI_ERRORS_RETURN. The synchronization calls must
+ * return MPI_SUCCESS, an accumulate out of the window must fail without
+ * losing the accumulates buffered before it, and a flush outside of an
+ * epoch must fail with MPI_ERR_RMA_SYNC. The program exits with a non
+ * zero status if any check fails.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "mpi.h"
+
+#define NELEMS     100
+#define ITERATIONS 12
+
+static int rc_errors = 0;
+
+static void check_rc(int rc, const char *what, int rank)
+{
+    if (MPI_SUCCESS != rc) {
+        fprintf(stderr, "[%d] %s returned %d\n", rank, what, rc);
+        rc_errors++;
+    }
+}
+
+static double dvalue(int rank, int i)
+{
+    return (double) ((rank * 7 + i) % 11) / 4.0;
+}
+
+int main(int argc, char *argv[])
+{
+    int rank, size, t, it, i, rc, class, errors = 0, all_errors = 0;
+    long *lbase, *slots, *shared, one, two[2], unit = 1;
+    double *dbase, dvalues[NELEMS];
+    MPI_Aint win_bytes, shared_disp, slots_disp, dmax_disp;
+    MPI_Win win;
+
+    MPI_Init(&argc, &argv);
+    MPI_Comm_rank(MPI_COMM_WORLD, &rank);
+    MPI_Comm_size(MPI_COMM_WORLD, &size);
+
+    /* one slot per origin, then the elements shared by all the origins,
+     * then the doubles */
+    slots_disp = 0;
+    shared_disp = size * sizeof(long);
+    dmax_disp = shared_disp + NELEMS * sizeof(long);
+    win_bytes = dmax_disp + NELEMS * sizeof(double);
+    MPI_Win_allocate(win_bytes, 1, MPI_INFO_NULL, MPI_COMM_WORLD, &lbase, &win);
+    MPI_Win_set_errhandler(win, MPI_ERRORS_RETURN);
+    slots = lbase;
+    shared = lbase + size;
+    dbase = (double *) ((char *) lbase + dmax_disp);
+
+    MPI_Win_lock(MPI_LOCK_EXCLUSIVE, rank, 0, win);
+    for (i = 0; i < size + NELEMS; i++) {
+        lbase[i] = 0;
+    }
+    for (i = 0; i < NELEMS; i++) {
+        dbase[i] = -1.0;
+    }
+    MPI_Win_unlock(rank, win);
+    MPI_Barrier(MPI_COMM_WORLD);
+
+    /* a flush outside of an epoch */
+    rc = MPI_Win_flush(0, win);
+    MPI_Error_class(rc, &class);
+    if (MPI_ERR_RMA_SYNC != class) {
+        fprintf(stderr, "[%d] flush outside of an epoch returned %d\n", rank, rc);
+        errors++;
+    }
+
+    one = rank + 1;
+    two[0] = two[1] = rank + 1;
+    check_rc(MPI_Win_lock_all(0, win), "lock_all", rank);
+    for (it = 0; it < ITERATIONS; it++) {
+        /* the origin buffers are only reused once the target is flushed */
+        for (i = 0; i < NELEMS; i++) {
+            dvalues[i] = dvalue(rank, i) + it;
+        }
+        for (t = 0; t < size; t++) {
+            long fetched = -1;
+
+            for (i = NELEMS - 1; i >= 0; i--) {
+                check_rc(MPI_Accumulate(&one, 1, MPI_LONG, t, shared_disp + i * sizeof(long), 1,
+                                        MPI_LONG, MPI_SUM, win),
+                         "accumulate", rank);
+            }
+            for (i = 0; i < NELEMS; i += 2) {
+                check_rc(MPI_Accumulate(two, 2, MPI_LONG, t, shared_disp + i * sizeof(long), 2,
+                                        MPI_LONG, MPI_SUM, win),
+                         "accumulate", rank);
+            }
+            for (i = 0; i < NELEMS; i++) {
+                check_rc(MPI_Accumulate(dvalues + i, 1, MPI_DOUBLE, t,
+                                        dmax_disp + i * sizeof(double), 1, MPI_DOUBLE, MPI_MAX,
+                                        win),
+                         "accumulate", rank);
+            }
+
+            /* only this process writes its slot, the fetch must see all its adds */
+            check_rc(MPI_Accumulate(&unit, 1, MPI_LONG, t, slots_disp + rank * sizeof(long), 1,
+                                    MPI_LONG, MPI_SUM, win),
+                     "accumulate", rank);
+            check_rc(MPI_Fetch_and_op(NULL, &fetched, MPI_LONG, t,
+                                      slots_disp + rank * sizeof(long), MPI_NO_OP, win),
+                     "fetch_and_op", rank);
+            check_rc(MPI_Win_flush(t, win), "flush", rank);
+            if (fetched != it + 1) {
+                fprintf(stderr, "[%d] fetched %ld from target %d after %d adds\n", rank, fetched,
+                        t, it + 1);
+                errors++;
+            }
+        }
+
+        if (ITERATIONS / 2 == it) {
+            /* an accumulate out of the window must not drop the buffered ones */
+            rc = MPI_Accumulate(&one, 1, MPI_LONG, (rank + 1) % size, win_bytes, 1, MPI_LONG,
+                                MPI_SUM, win);
+            MPI_Error_class(rc, &class);
+            if (MPI_ERR_RMA_RANGE != class) {
+                fprintf(stderr, "[%d] accumulate out of the window returned %d\n", rank, rc);
+                errors++;
+            }
+            check_rc(MPI_Win_flush_all(win), "flush_all", rank);
+        }
+    }
+    check_rc(MPI_Win_unlock_all(win), "unlock_all", rank);
+
+    /* the same with fences */
+    check_rc(MPI_Win_fence(0, win), "fence", rank);
+    for (t = 0; t < size; t++) {
+        for (i = NELEMS - 1; i >= 0; i--) {
+            check_rc(MPI_Accumulate(&one, 1, MPI_LONG, t, shared_disp + i * sizeof(long), 1,
+                                    MPI_LONG, MPI_SUM, win),
+                     "accumulate", rank);
+        }
+    }
+    check_rc(MPI_Win_fence(0, win), "fence", rank);
+    MPI_Barrier(MPI_COMM_WORLD);
+
+    MPI_Win_lock(MPI_LOCK_SHARED, rank, 0, win);
+    for (i = 0; i < size; i++) {
+        errors += (slots[i] != ITERATIONS);
+    }
+    for (i = 0; i < NELEMS; i++) {
+        double dexpected = -1.0;
+        int r;
+
+        /* every origin adds rank + 1 twice per iteration, then once more */
+        errors += (shared[i] != (long) (2 * ITERATIONS + 1) * size * (size + 1) / 2);
+        for (r = 0; r < size; r++) {
+            double v = dvalue(r, i) + ITERATIONS - 1;
+            dexpected = (v > dexpected) ? v : dexpected;
+        }
+        errors += (dbase[i] != dexpected);
+    }
+    MPI_Win_unlock(rank, win);
+
+    errors += rc_errors;
+    MPI_Allreduce(&errors, &all_errors, 1, MPI_INT, MPI_SUM, MPI_COMM_WORLD);
+    if (0 == rank) {
+        printf("osc rdma accumulate: %s\n", (0 == all_errors) ? "passed" : "FAILED");
+    }
+
+    MPI_Win_free(&win);
+    MPI_Finalize();
+    return (0 == all_errors) ? 0 : 1;
+}
@@ -0,0 +1,133 @@
+/*
+ * Concurrent accumulates from all the ranks of a node to the same shared
+ * memory window, mixing sizes below and above the limit of the processor
+ * atomics path of osc sm, e.g.
+ *
+ *   mpirun -np 4 --mca osc sm osc_sm_accumulate
+ *
+ * The sums are done on integer values so the floating point results are
+ * exact. The program exits with a non zero status if any result is wrong.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "mpi.h"
+
+#define COUNT      8192
+#define ITERATIONS 20
+
+static const int counts[] = {1, 3, 64, 1000, COUNT};
+#define NCOUNTS (int) (sizeof(counts) / sizeof(counts[0]))
+
+int main(int argc, char *argv[])
+{
+    int rank, size, c, i, it, errors = 0, all_errors = 0;
+    double *dorigin, *dbase, dresult;
+    float *forigin, *fbase;
+    long *lbase, lone = 1, lresult;
+    MPI_Comm node;
+    MPI_Win win;
+    MPI_Aint win_size;
+    char *base;
+
+    MPI_Init(&argc, &argv);
+    MPI_Comm_split_type(MPI_COMM_WORLD, MPI_COMM_TYPE_SHARED, 0, MPI_INFO_NULL, &node);
+    MPI_Comm_rank(node, &rank);
+    MPI_Comm_size(node, &size);
+
+    win_size = (0 == rank) ? COUNT * (sizeof(double) + sizeof(float) + sizeof(long)) : 0;
+    MPI_Win_allocate_shared(win_size, 1, MPI_INFO_NULL, node, &base, &win);
+    if (0 != rank) {
+        int disp_unit;
+        MPI_Win_shared_query(win, 0, &win_size, &disp_unit, &base);
+    }
+    dbase = (double *) base;
+    fbase = (float *) (dbase + COUNT);
+    lbase = (long *) (fbase + COUNT);
+
+    dorigin = malloc(COUNT * sizeof(double));
+    forigin = malloc(COUNT * sizeof(float));
+    for (i = 0; i < COUNT; i++) {
+        dorigin[i] = (double) (i % 7);
+        forigin[i] = (float) (i % 5);
+    }
+
+    MPI_Win_lock_all(0, win);
+    if (0 == rank) {
+        for (i = 0; i < COUNT; i++) {
+            dbase[i] = 0.0;
+            fbase[i] = 0.0f;
+            lbase[i] = 0;
+        }
+    }
+    MPI_Win_sync(win);
+    MPI_Barrier(node);
+
+    /* every element gets ITERATIONS updates per count and rank, through
+     * paths that differ with the size of the call */
+    for (it = 0; it < ITERATIONS; it++) {
+        for (c = 0; c < NCOUNTS; c++) {
+            MPI_Accumulate(dorigin, counts[c], MPI_DOUBLE, 0, 0, counts[c], MPI_DOUBLE, MPI_SUM,
+                           win);
+            MPI_Accumulate(forigin, counts[c], MPI_FLOAT, 0, COUNT * sizeof(double), counts[c],
+                           MPI_FLOAT, MPI_SUM, win);
+            MPI_Accumulate(&lone, 1, MPI_LONG, 0,
+                           COUNT * (sizeof(double) + sizeof(float)) + (it % COUNT) * sizeof(long),
+                           1, MPI_LONG, MPI_SUM, win);
+        }
+        MPI_Fetch_and_op(&dorigin[1], &dresult, MPI_DOUBLE, 0, sizeof(double), MPI_SUM, win);
+        MPI_Fetch_and_op(&lone, &lresult, MPI_LONG, 0, COUNT * (sizeof(double) + sizeof(float)),
+                         MPI_SUM, win);
+        MPI_Win_flush(0, win);
+    }
+
+    MPI_Win_sync(win);
+    MPI_Barrier(node);
+    MPI_Win_sync(win);
+
+    if (0 == rank) {
+        for (i = 0; i < COUNT; i++) {
+            int calls = 0;
+            double dexpected;
+            float fexpected;
+
+            for (c = 0; c < NCOUNTS; c++) {
+                calls += (i < counts[c]);
+            }
+            dexpected = (double) size * ITERATIONS * calls * (i % 7);
+            fexpected = (float) size * ITERATIONS * calls * (i % 5);
+            if (1 == i) {
+                dexpected += (double) size * ITERATIONS * dorigin[1];
+            }
+            if (dbase[i] != dexpected || fbase[i] != fexpected) {
+                if (errors < 10) {
+                    fprintf(stderr, "element %d: got %g/%g, expected %g/%g\n", i, dbase[i],
+                            (double) fbase[i], dexpected, (double) fexpected);
+                }
+                errors++;
+            }
+        }
+        for (i = 0; i < ITERATIONS; i++) {
+            long lexpected = (long) size * NCOUNTS + (0 == i ? (long) size * ITERATIONS : 0);
+            if (lbase[i] != lexpected) {
+                fprintf(stderr, "counter %d: got %ld, expected %ld\n", i, lbase[i], lexpected);
+                errors++;
+            }
+        }
+    }
+    MPI_Win_unlock_all(win);
+
+    MPI_Allreduce(&errors, &all_errors, 1, MPI_INT, MPI_SUM, MPI_COMM_WORLD);
+    if (0 == rank) {
+        printf("osc sm accumulate: %s\n", (0 == all_errors) ? "passed" : "FAILED");
+    }
+
+    MPI_Win_free(&win);
+    MPI_Comm_free(&node);
+    free(dorigin);
+    free(forigin);
+
+    MPI_Finalize();
+    return (0 == all_errors) ? 0 : 1;
+}
@@ -0,0 +1,132 @@
+/*
+ * Put and get between the PEs of a node, to and from the symmetric heap
+ * and the static data, e.g.
+ *
+ *   oshrun -np 4 --mca spml sm oshmem_put_get
+ *
+ * Every PE writes a pattern to the next PE and reads the one of the
+ * previous PE back, for sizes from a byte to a few pages, with blocking
+ * and non blocking calls. The program exits with a non zero status if
+ * any value is wrong. It also reports whether the heap of the neighbour
+ * is mapped directly (shmem_ptr), which spml sm needs to avoid a system
+ * call per access.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "shmem.h"
+
+#define MAX_SIZE (64 * 1024)
+
+static char static_buf[MAX_SIZE];
+
+static char pattern(int pe, size_t i, size_t size)
+{
+    return (char) (pe * 31 + i * 7 + size);
+}
+
+static int check(const char *buf, int pe, size_t size)
+{
+    size_t i;
+
+    for (i = 0; i < size; i++) {
+        if (buf[i] != pattern(pe, i, size)) {
+            return 1;
+        }
+    }
+    return 0;
+}
+
+static int run(char *sym, char *local, int me, int npes, const char *name)
+{
+    int next = (me + 1) % npes, prev = (me + npes - 1) % npes;
+    int nbi, errors = 0;
+    size_t size, i;
+
+    for (nbi = 0; nbi < 2; nbi++) {
+        for (size = 1; size <= MAX_SIZE; size = size * 4 + 1) {
+            size_t len = (size < MAX_SIZE) ? size : MAX_SIZE;
+
+            for (i = 0; i < len; i++) {
+                local[i] = pattern(me, i, len);
+            }
+            memset(sym, -1, MAX_SIZE);
+            shmem_barrier_all();
+
+            /* put my pattern to the next pe */
+            if (nbi) {
+                shmem_putmem_nbi(sym, local, len, next);
+                shmem_quiet();
+            } else {
+                shmem_putmem(sym, local, len, next);
+            }
+            shmem_barrier_all();
+            if (check(sym, prev, len)) {
+                fprintf(stderr, "[%d] %s put%s of %zu bytes from pe %d is wrong\n", me, name,
+                        nbi ? "_nbi" : "", len, prev);
+                errors++;
+            }
+
+            /* get the pattern the previous pe got from me back */
+            memset(local, -1, len);
+            if (nbi) {
+                shmem_getmem_nbi(local, sym, len, next);
+                shmem_quiet();
+            } else {
+                shmem_getmem(local, sym, len, next);
+            }
+            if (check(local, me, len)) {
+                fprintf(stderr, "[%d] %s get%s of %zu bytes from pe %d is wrong\n", me, name,
+                        nbi ? "_nbi" : "", len, next);
+                errors++;
+            }
+            shmem_barrier_all();
+        }
+    }
+
+    return errors;
+}
+
+static int errors_all;
+static int errors_sym;
+static long psync[SHMEM_REDUCE_SYNC_SIZE];
+static int pwrk[SHMEM_REDUCE_MIN_WRKDATA_SIZE];
+
+int main(int argc, char *argv[])
+{
+    int me, npes, i;
+    char *heap_buf, *local;
+
+    shmem_init();
+    me = shmem_my_pe();
+    npes = shmem_n_pes();
+
+    heap_buf = shmem_malloc(MAX_SIZE);
+    local = malloc(MAX_SIZE);
+
+    if (0 == me) {
+        printf("heap of pe %d is %s\n", (me + 1) % npes,
+               (NULL != shmem_ptr(heap_buf, (me + 1) % npes)) ? "mapped directly"
+                                                             : "not mapped, accessed by the spml");
+    }
+
+    errors_sym = run(heap_buf, local, me, npes, "heap");
+    errors_sym += run(static_buf, local, me, npes, "static");
+
+    for (i = 0; i < SHMEM_REDUCE_SYNC_SIZE; i++) {
+        psync[i] = SHMEM_SYNC_VALUE;
+    }
+    shmem_barrier_all();
+    shmem_int_sum_to_all(&errors_all, &errors_sym, 1, 0, 0, npes, pwrk, psync);
+    if (0 == me) {
+        printf("oshmem put/get: %s\n", (0 == errors_all) ? "passed" : "FAILED");
+    }
+
+    shmem_free(heap_buf);
+    free(local);
+    shmem_finalize();
+
+    return (0 == errors_all) ? 0 : 1;
+}
@@ -0,0 +1,193 @@
+/*
+ * Correctness check of the broadcast, collect and reduction algorithms of
+ * scoll basic, on all the PEs and on an active set of every other PE, for
+ * sizes below and above scoll_basic_long_msg, e.g.
+ *
+ *   oshrun -np 6 --mca scoll basic oshmem_scoll
+ *   oshrun -np 6 --mca scoll basic --mca scoll_basic_broadcast_alg 2 \
+ *       --mca scoll_basic_knomial_radix 3 --mca scoll_basic_collect_alg 4 \
+ *       --mca scoll_basic_reduce_alg 5 oshmem_scoll
+ *
+ * The first run goes through the adaptive selection, the second one
+ * forces the k-nomial broadcast, the Bruck collect and the Rabenseifner
+ * reduction. Run it with a number of PEs that is not a power of two as
+ * well, the Bruck collect and the Rabenseifner reduction handle the extra
+ * PEs separately. The program exits with a non zero status if any value
+ * is wrong.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "shmem.h"
+
+#define MAX_COUNT 5000
+
+static const int counts[] = {1, 2, 3, 7, 100, 1023, 1025, MAX_COUNT};
+#define NCOUNTS (int) (sizeof(counts) / sizeof(counts[0]))
+
+static long psync[SHMEM_REDUCE_SYNC_SIZE];
+static long bsync[SHMEM_BARRIER_SYNC_SIZE];
+static long lwrk[MAX_COUNT / 2 + SHMEM_REDUCE_MIN_WRKDATA_SIZE];
+static double dwrk[MAX_COUNT / 2 + SHMEM_REDUCE_MIN_WRKDATA_SIZE];
+static int iwrk[SHMEM_REDUCE_MIN_WRKDATA_SIZE];
+static int errors_all;
+static int errors_pe;
+
+static long value(int pe, int i)
+{
+    return (long) pe * 100003 + i * 7 + 1;
+}
+
+/* the PEs of the active set are start, start + stride, ... */
+static int check_bcast(long *source, long *target, int me, int start, int log_stride, int size,
+                       int count)
+{
+    int stride = 1 << log_stride, r, i, errors = 0;
+
+    for (r = 0; r < size; r++) {
+        int root = start + r * stride;
+
+        for (i = 0; i < count; i++) {
+            source[i] = (me == root) ? value(root, i) : -1;
+            target[i] = -2;
+        }
+        shmem_barrier(start, log_stride, size, bsync);
+        shmem_broadcast64(target, source, count, r, start, log_stride, size, psync);
+        shmem_barrier(start, log_stride, size, bsync);
+        /* the target of the root is left alone */
+        for (i = 0; i < count; i++) {
+            errors += (target[i] != ((me == root) ? -2 : value(root, i)));
+        }
+    }
+    return errors;
+}
+
+static int check_collect(long *source, long *target, int me, int start, int log_stride, int size,
+                         int count)
+{
+    int stride = 1 << log_stride, rank = (me - start) / stride, r, i, offset, errors = 0;
+
+    for (i = 0; i < count; i++) {
+        source[i] = value(me, i);
+    }
+    for (i = 0; i < count * size; i++) {
+        target[i] = -1;
+    }
+    shmem_barrier(start, log_stride, size, bsync);
+    shmem_fcollect64(target, source, count, start, log_stride, size, psync);
+    shmem_barrier(start, log_stride, size, bsync);
+    for (r = 0; r < size; r++) {
+        for (i = 0; i < count; i++) {
+            errors += (target[r * count + i] != value(start + r * stride, i));
+        }
+    }
+
+    /* every PE contributes a different number of elements */
+    for (i = 0; i < count * size; i++) {
+        target[i] = -1;
+    }
+    shmem_barrier(start, log_stride, size, bsync);
+    shmem_collect64(target, source, (count + rank) % (count + 1), start, log_stride, size, psync);
+    shmem_barrier(start, log_stride, size, bsync);
+    for (r = 0, offset = 0; r < size; r++) {
+        for (i = 0; i < (count + r) % (count + 1); i++) {
+            errors += (target[offset++] != value(start + r * stride, i));
+        }
+    }
+    return errors;
+}
+
+static int check_reduce(long *source, long *target, int me, int start, int log_stride, int size,
+                        int count)
+{
+    double *dsource = (double *) source, *dtarget = (double *) target;
+    int stride = 1 << log_stride, rank = (me - start) / stride, r, i, errors = 0;
+
+    for (i = 0; i < count; i++) {
+        source[i] = value(me, i);
+        target[i] = -1;
+    }
+    shmem_barrier(start, log_stride, size, bsync);
+    shmem_long_sum_to_all(target, source, count, start, log_stride, size, lwrk, psync);
+    shmem_barrier(start, log_stride, size, bsync);
+    for (i = 0; i < count; i++) {
+        long expected = 0;
+
+        for (r = 0; r < size; r++) {
+            expected += value(start + r * stride, i);
+        }
+        errors += (target[i] != expected);
+    }
+
+    /* the maximum is on a different PE for every element */
+    for (i = 0; i < count; i++) {
+        dsource[i] = (double) ((rank * 7 + i) % 11) / 4.0;
+        dtarget[i] = -1.0;
+    }
+    shmem_barrier(start, log_stride, size, bsync);
+    shmem_double_max_to_all(dtarget, dsource, count, start, log_stride, size, dwrk, psync);
+    shmem_barrier(start, log_stride, size, bsync);
+    for (i = 0; i < count; i++) {
+        double expected = 0.0;
+
+        for (r = 0; r < size; r++) {
+            double v = (double) ((r * 7 + i) % 11) / 4.0;
+            expected = (v > expected) ? v : expected;
+        }
+        errors += (dtarget[i] != expected);
+    }
+    return errors;
+}
+
+int main(int argc, char *argv[])
+{
+    int me, npes, i, c, set;
+    long *source, *target;
+
+    shmem_init();
+    me = shmem_my_pe();
+    npes = shmem_n_pes();
+
+    for (i = 0; i < SHMEM_REDUCE_SYNC_SIZE; i++) {
+        psync[i] = SHMEM_SYNC_VALUE;
+    }
+    for (i = 0; i < SHMEM_BARRIER_SYNC_SIZE; i++) {
+        bsync[i] = SHMEM_SYNC_VALUE;
+    }
+    source = shmem_malloc(MAX_COUNT * sizeof(long));
+    target = shmem_malloc(MAX_COUNT * npes * sizeof(long));
+    shmem_barrier_all();
+
+    /* all the PEs, then every other PE */
+    for (set = 0; set < 2; set++) {
+        int log_stride = set, size = (npes + set) >> set;
+
+        if (0 != me % (1 << log_stride) || size < 2) {
+            continue;
+        }
+        for (c = 0; c < NCOUNTS; c++) {
+            int e = check_bcast(source, target, me, 0, log_stride, size, counts[c]);
+
+            e += check_collect(source, target, me, 0, log_stride, size, counts[c]);
+            e += check_reduce(source, target, me, 0, log_stride, size, counts[c]);
+            if (0 != e) {
+                fprintf(stderr, "[%d] %s count %d: %d wrong elements\n", me,
+                        set ? "every other pe" : "all pes", counts[c], e);
+            }
+            errors_pe += e;
+        }
+    }
+
+    shmem_barrier_all();
+    shmem_int_sum_to_all(&errors_all, &errors_pe, 1, 0, 0, npes, iwrk, psync);
+    if (0 == me) {
+        printf("oshmem scoll: %s\n", (0 == errors_all) ? "passed" : "FAILED");
+    }
+
+    shmem_free(target);
+    shmem_free(source);
+    shmem_finalize();
+
+    return (0 == errors_all) ? 0 : 1;
+}
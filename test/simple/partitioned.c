@@ -0,0 +1,75 @@
+/*
+ * Ring exchange with partitioned point-to-point communication.
+ *
+ * Every rank sends its buffer to the next rank in PARTITIONS partitions
+ * marked ready in reverse order, and receives the buffer of the
+ * previous rank in half as many partitions, polling MPI_Parrived.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "mpi.h"
+
+#define PARTITIONS 8
+#define COUNT 1024
+#define ITERATIONS 10
+
+int main(int argc, char *argv[])
+{
+    int rank, size, next, prev, it, i, flag, errors = 0;
+    MPI_Request reqs[2];
+    int *sbuf, *rbuf;
+
+    MPI_Init(&argc, &argv);
+    MPI_Comm_rank(MPI_COMM_WORLD, &rank);
+    MPI_Comm_size(MPI_COMM_WORLD, &size);
+    next = (rank + 1) % size;
+    prev = (rank + size - 1) % size;
+
+    sbuf = (int *) malloc(PARTITIONS * COUNT * sizeof(int));
+    rbuf = (int *) malloc(PARTITIONS * COUNT * sizeof(int));
+
+    MPI_Psend_init(sbuf, PARTITIONS, COUNT, MPI_INT, next, 42, MPI_COMM_WORLD,
+                   MPI_INFO_NULL, &reqs[0]);
+    MPI_Precv_init(rbuf, PARTITIONS / 2, 2 * COUNT, MPI_INT, prev, 42, MPI_COMM_WORLD,
+                   MPI_INFO_NULL, &reqs[1]);
+
+    for (it = 0; it < ITERATIONS; it++) {
+        for (i = 0; i < PARTITIONS * COUNT; i++) {
+            rbuf[i] = -1;
+        }
+        MPI_Startall(2, reqs);
+
+        for (i = PARTITIONS - 1; i >= 0; i--) {
+            int j;
+            for (j = 0; j < COUNT; j++) {
+                sbuf[i * COUNT + j] = rank * it + i * COUNT + j;
+            }
+            MPI_Pready(i, reqs[0]);
+        }
+
+        for (i = 0; i < PARTITIONS / 2; i++) {
+            do {
+                MPI_Parrived(reqs[1], i, &flag);
+            } while (!flag);
+        }
+        MPI_Waitall(2, reqs, MPI_STATUSES_IGNORE);
+
+        for (i = 0; i < PARTITIONS * COUNT; i++) {
+            if (rbuf[i] != prev * it + i) {
+                errors++;
+            }
+        }
+    }
+
+    MPI_Request_free(&reqs[0]);
+    MPI_Request_free(&reqs[1]);
+
+    printf("Rank %d: %s (%d errors)\n", rank, errors ? "FAILED" : "OK", errors);
+
+    free(sbuf);
+    free(rbuf);
+    MPI_Finalize();
+    return errors ? 1 : 0;
+}
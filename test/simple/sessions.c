@@ -0,0 +1,80 @@
+/* -*- C -*-
+ *
+ * $HEADER$
+ *
+ * Create a communicator from the world process set of a session,
+ * without calling MPI_Init, and run a collective on it. The program
+ * exits with a non zero status if anything goes wrong.
+ */
+
+#include <stdio.h>
+#include "mpi.h"
+
+int main(int argc, char* argv[])
+{
+    MPI_Session session;
+    MPI_Group group;
+    MPI_Comm comm, self;
+    MPI_Info info;
+    char name[MPI_MAX_PSET_NAME_LEN], value[MPI_MAX_INFO_VAL], level[MPI_MAX_INFO_VAL];
+    int i, npsets, len, flag, rank, size, sum, result, errors = 0;
+
+    MPI_Info_create(&info);
+    MPI_Info_set(info, "thread_level", "MPI_THREAD_MULTIPLE");
+    MPI_Session_init(info, MPI_ERRORS_RETURN, &session);
+    MPI_Info_free(&info);
+
+    MPI_Session_get_info(session, &info);
+    MPI_Info_get(info, "thread_level", MPI_MAX_INFO_VAL, level, &flag);
+    MPI_Info_free(&info);
+
+    MPI_Session_get_num_psets(session, MPI_INFO_NULL, &npsets);
+    for (i = 0; i < npsets; i++) {
+        len = MPI_MAX_PSET_NAME_LEN;
+        MPI_Session_get_nth_pset(session, MPI_INFO_NULL, i, &len, name);
+        MPI_Session_get_pset_info(session, name, &info);
+        MPI_Info_get(info, "mpi_size", MPI_MAX_INFO_VAL, value, &flag);
+        fprintf(stderr, "pset %s: mpi_size %s\n", name, (flag) ? value : "Not found");
+        MPI_Info_free(&info);
+    }
+
+    if (MPI_SUCCESS != MPI_Group_from_session_pset(session, "mpi://WORLD", &group) ||
+        MPI_SUCCESS != MPI_Comm_create_from_group(group, "org.open-mpi.test.sessions",
+                                                  MPI_INFO_NULL, MPI_ERRORS_RETURN, &comm)) {
+        fprintf(stderr, "could not create a communicator from mpi://WORLD\n");
+        return 1;
+    }
+    MPI_Group_free(&group);
+
+    MPI_Comm_rank(comm, &rank);
+    MPI_Comm_size(comm, &size);
+    MPI_Allreduce(&rank, &sum, 1, MPI_INT, MPI_SUM, comm);
+    if (sum != size * (size - 1) / 2) {
+        fprintf(stderr, "rank %d: wrong sum %d\n", rank, sum);
+        errors++;
+    }
+    printf("Hello, World, I am %d of %d (thread level %s)\n", rank, size, level);
+
+    /* a second communicator with another string tag must be distinct */
+    if (MPI_SUCCESS != MPI_Group_from_session_pset(session, "mpi://SELF", &group) ||
+        MPI_SUCCESS != MPI_Comm_create_from_group(group, "org.open-mpi.test.sessions.self",
+                                                  MPI_INFO_NULL, MPI_ERRORS_RETURN, &self)) {
+        fprintf(stderr, "rank %d: could not create a communicator from mpi://SELF\n", rank);
+        return 1;
+    }
+    MPI_Group_free(&group);
+
+    MPI_Comm_size(self, &size);
+    MPI_Comm_compare(comm, self, &result);
+    if (1 != size || MPI_IDENT == result) {
+        fprintf(stderr, "rank %d: wrong mpi://SELF communicator\n", rank);
+        errors++;
+    }
+    MPI_Comm_free(&self);
+
+    MPI_Allreduce(MPI_IN_PLACE, &errors, 1, MPI_INT, MPI_SUM, comm);
+
+    MPI_Comm_free(&comm);
+    MPI_Session_finalize(&session);
+    return (0 == errors) ? 0 : 1;
+}
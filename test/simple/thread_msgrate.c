@@ -0,0 +1,118 @@
+/*
+ * Measure the message rate between two ranks as a function of the
+ * number of communicating threads.
+ *
+ * Every thread of rank 0 sends windows of small messages to the same
+ * thread of rank 1 on its own communicator, and waits for an
+ * acknowledgement after each window.
+ *
+ * Compare the results with --mca opal_progress_shard 1 and with
+ * --mca opal_progress_threads N.
+ *
+ *   mpirun -np 2 ./thread_msgrate [max_threads] [iterations]
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <pthread.h>
+
+#include "mpi.h"
+
+#define MAX_THREADS_DEFAULT 16
+#define ITERATIONS_DEFAULT 1000
+#define WINDOW 64
+
+struct thread_args {
+    MPI_Comm comm;
+    int rank;
+    int iterations;
+};
+
+static void *run_thread(void *arg)
+{
+    struct thread_args *args = (struct thread_args *) arg;
+    MPI_Request reqs[WINDOW];
+    char buf[WINDOW], ack = 0;
+    int i, it;
+
+    for (it = 0; it < args->iterations; it++) {
+        for (i = 0; i < WINDOW; i++) {
+            if (0 == args->rank) {
+                MPI_Isend(&buf[i], 1, MPI_CHAR, 1, i, args->comm, &reqs[i]);
+            } else {
+                MPI_Irecv(&buf[i], 1, MPI_CHAR, 0, i, args->comm, &reqs[i]);
+            }
+        }
+        MPI_Waitall(WINDOW, reqs, MPI_STATUSES_IGNORE);
+        if (0 == args->rank) {
+            MPI_Recv(&ack, 1, MPI_CHAR, 1, WINDOW, args->comm, MPI_STATUS_IGNORE);
+        } else {
+            MPI_Send(&ack, 1, MPI_CHAR, 0, WINDOW, args->comm);
+        }
+    }
+    return NULL;
+}
+
+int main(int argc, char *argv[])
+{
+    int rank, size, provided, nthreads, i;
+    int max_threads = MAX_THREADS_DEFAULT, iterations = ITERATIONS_DEFAULT;
+    struct thread_args *args;
+    pthread_t *threads;
+    double start, elapsed;
+
+    MPI_Init_thread(&argc, &argv, MPI_THREAD_MULTIPLE, &provided);
+    MPI_Comm_rank(MPI_COMM_WORLD, &rank);
+    MPI_Comm_size(MPI_COMM_WORLD, &size);
+
+    if (argc > 1) {
+        max_threads = atoi(argv[1]);
+    }
+    if (argc > 2) {
+        iterations = atoi(argv[2]);
+    }
+    if (size != 2 || provided < MPI_THREAD_MULTIPLE || max_threads < 1 || iterations < 1) {
+        if (0 == rank) {
+            fprintf(stderr, "Usage: mpirun -np 2 ./thread_msgrate [max_threads] [iterations]\n"
+                            "(requires MPI_THREAD_MULTIPLE)\n");
+        }
+        MPI_Finalize();
+        return 1;
+    }
+
+    args = (struct thread_args *) malloc(max_threads * sizeof(struct thread_args));
+    threads = (pthread_t *) malloc(max_threads * sizeof(pthread_t));
+    for (i = 0; i < max_threads; i++) {
+        MPI_Comm_dup(MPI_COMM_WORLD, &args[i].comm);
+        args[i].rank = rank;
+        args[i].iterations = iterations;
+    }
+
+    if (0 == rank) {
+        printf("%10s %20s\n", "threads", "rate (msg/s)");
+    }
+    for (nthreads = 1; nthreads <= max_threads; nthreads *= 2) {
+        MPI_Barrier(MPI_COMM_WORLD);
+        start = MPI_Wtime();
+        for (i = 0; i < nthreads; i++) {
+            pthread_create(&threads[i], NULL, run_thread, &args[i]);
+        }
+        for (i = 0; i < nthreads; i++) {
+            pthread_join(threads[i], NULL);
+        }
+        elapsed = MPI_Wtime() - start;
+        if (0 == rank) {
+            printf("%10d %20.0f\n", nthreads,
+                   (double) nthreads * iterations * WINDOW / elapsed);
+            fflush(stdout);
+        }
+    }
+
+    for (i = 0; i < max_threads; i++) {
+        MPI_Comm_free(&args[i].comm);
+    }
+    free(args);
+    free(threads);
+    MPI_Finalize();
+    return 0;
+}
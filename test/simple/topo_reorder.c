@@ -0,0 +1,190 @@
+/*
+ * Correctness check of MPI_Cart_create and MPI_Graph_create with reorder
+ * set, which may give the processes new ranks, e.g.
+ *
+ *   mpirun -np 8 --map-by ppr:4:node --mca topo basic topo_reorder
+ *
+ * Every process checks that the new communicator holds each process once,
+ * that the coordinates and the neighbours it gets from the topology match
+ * the ones its neighbours see from their side, and that a reduction over
+ * the new communicator is right. The program exits with a non zero status
+ * if any check fails.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "mpi.h"
+
+#define MAX_DIMS 3
+
+/* every process is in comm once */
+static int check_members(MPI_Comm comm)
+{
+    int rank, size, world_rank, i, sum = 0, errors = 0;
+    int *world_ranks, *seen;
+
+    MPI_Comm_rank(comm, &rank);
+    MPI_Comm_size(comm, &size);
+    MPI_Comm_rank(MPI_COMM_WORLD, &world_rank);
+    world_ranks = malloc(size * sizeof(int));
+    seen = calloc(size, sizeof(int));
+
+    MPI_Allgather(&world_rank, 1, MPI_INT, world_ranks, 1, MPI_INT, comm);
+    for (i = 0; i < size; i++) {
+        if (world_ranks[i] < 0 || world_ranks[i] >= size || seen[world_ranks[i]]++) {
+            errors++;
+        }
+    }
+    errors += (world_ranks[rank] != world_rank);
+
+    MPI_Allreduce(&rank, &sum, 1, MPI_INT, MPI_SUM, comm);
+    errors += (sum != size * (size - 1) / 2);
+
+    free(world_ranks);
+    free(seen);
+    return errors;
+}
+
+static int check_cart(int ndims)
+{
+    int size, rank, back, d, errors = 0;
+    int dims[MAX_DIMS] = {0}, periods[MAX_DIMS], coords[MAX_DIMS];
+    MPI_Comm cart;
+
+    MPI_Comm_size(MPI_COMM_WORLD, &size);
+    MPI_Dims_create(size, ndims, dims);
+    for (d = 0; d < ndims; d++) {
+        periods[d] = (0 == d % 2);
+    }
+    MPI_Cart_create(MPI_COMM_WORLD, ndims, dims, periods, 1, &cart);
+    if (MPI_COMM_NULL == cart) {
+        return 1;
+    }
+
+    errors += check_members(cart);
+    MPI_Comm_rank(cart, &rank);
+    MPI_Cart_coords(cart, rank, ndims, coords);
+    MPI_Cart_rank(cart, coords, &back);
+    errors += (back != rank);
+
+    /* the neighbours in each direction must agree on their coordinates */
+    for (d = 0; d < ndims; d++) {
+        int src, dst, i, expected[MAX_DIMS], got[MAX_DIMS];
+
+        MPI_Cart_shift(cart, d, 1, &src, &dst);
+        for (i = 0; i < ndims; i++) {
+            got[i] = -1;
+        }
+        MPI_Sendrecv(coords, ndims, MPI_INT, dst, d, got, ndims, MPI_INT, src, d, cart,
+                     MPI_STATUS_IGNORE);
+        if (MPI_PROC_NULL == src) {
+            errors += !(0 == coords[d] && !periods[d]);
+            continue;
+        }
+        for (i = 0; i < ndims; i++) {
+            expected[i] = coords[i];
+        }
+        expected[d] = (coords[d] - 1 + dims[d]) % dims[d];
+        for (i = 0; i < ndims; i++) {
+            errors += (got[i] != expected[i]);
+        }
+    }
+
+    MPI_Comm_free(&cart);
+    return errors;
+}
+
+/* a ring with chords between the mirrored vertices i and size - 1 - i */
+static int graph_neighbors(int vertex, int size, int *neighbors)
+{
+    int candidates[3] = {(vertex + 1) % size, (vertex - 1 + size) % size, size - 1 - vertex};
+    int i, j, n = 0;
+
+    for (i = 0; i < 3; i++) {
+        int dup = (candidates[i] == vertex);
+
+        for (j = 0; j < n; j++) {
+            dup |= (neighbors[j] == candidates[i]);
+        }
+        if (!dup) {
+            neighbors[n++] = candidates[i];
+        }
+    }
+    return n;
+}
+
+static int check_graph(void)
+{
+    int size, rank, v, i, nedges = 0, nneighbors, errors = 0;
+    int *index, *edges, neighbors[3], got[3], expected[3];
+    MPI_Request reqs[6];
+    MPI_Comm graph;
+
+    MPI_Comm_size(MPI_COMM_WORLD, &size);
+    index = malloc(size * sizeof(int));
+    edges = malloc(3 * size * sizeof(int));
+    for (v = 0; v < size; v++) {
+        nedges += graph_neighbors(v, size, edges + nedges);
+        index[v] = nedges;
+    }
+    MPI_Graph_create(MPI_COMM_WORLD, size, index, edges, 1, &graph);
+    free(index);
+    free(edges);
+    if (MPI_COMM_NULL == graph) {
+        return 1;
+    }
+
+    errors += check_members(graph);
+    MPI_Comm_rank(graph, &rank);
+    MPI_Graph_neighbors_count(graph, rank, &nneighbors);
+    errors += (nneighbors != graph_neighbors(rank, size, expected));
+    nneighbors = (nneighbors < 3) ? nneighbors : 3;
+    MPI_Graph_neighbors(graph, rank, nneighbors, neighbors);
+    for (i = 0; i < nneighbors; i++) {
+        errors += (neighbors[i] != expected[i]);
+    }
+
+    /* every neighbour must see this process as the same vertex */
+    for (i = 0; i < nneighbors; i++) {
+        got[i] = -1;
+        MPI_Irecv(got + i, 1, MPI_INT, neighbors[i], 0, graph, reqs + i);
+        MPI_Isend(&rank, 1, MPI_INT, neighbors[i], 0, graph, reqs + nneighbors + i);
+    }
+    MPI_Waitall(2 * nneighbors, reqs, MPI_STATUSES_IGNORE);
+    for (i = 0; i < nneighbors; i++) {
+        errors += (got[i] != neighbors[i]);
+    }
+
+    MPI_Comm_free(&graph);
+    return errors;
+}
+
+int main(int argc, char *argv[])
+{
+    int rank, ndims, e, errors = 0, all_errors = 0;
+
+    MPI_Init(&argc, &argv);
+    MPI_Comm_rank(MPI_COMM_WORLD, &rank);
+
+    for (ndims = 1; ndims <= MAX_DIMS; ndims++) {
+        e = check_cart(ndims);
+        if (0 != e) {
+            fprintf(stderr, "[%d] cart_create with %d dimensions: %d errors\n", rank, ndims, e);
+        }
+        errors += e;
+    }
+    e = check_graph();
+    if (0 != e) {
+        fprintf(stderr, "[%d] graph_create: %d errors\n", rank, e);
+    }
+    errors += e;
+
+    MPI_Allreduce(&errors, &all_errors, 1, MPI_INT, MPI_SUM, MPI_COMM_WORLD);
+    if (0 == rank) {
+        printf("topo reorder: %s\n", (0 == all_errors) ? "passed" : "FAILED");
+    }
+
+    MPI_Finalize();
+    return (0 == all_errors) ? 0 : 1;
+}
@@ -0,0 +1,147 @@
+/*
+ * $COPYRIGHT$
+ *
+ * Additional copyrights may follow
+ *
+ * $HEADER$
+ */
+
+/*
+ * Multi-threaded benchmark of registration cache lookups. A vma module is
+ * filled with registrations of (fake) address ranges and every thread then
+ * looks up random buffers inside them with mca_rcache_base_vma_find(). The
+ * run is done once with the page index disabled (every lookup goes through
+ * the interval tree) and once with it enabled.
+ *
+ * usage: opal_rcache_vma_thread_bench [thread count]
+ */
+
+#include "opal_config.h"
+
+#include <pthread.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <sys/time.h>
+
+#include "opal/constants.h"
+#include "opal/mca/rcache/base/rcache_base_vma.h"
+#include "opal/mca/rcache/rcache.h"
+#include "opal/runtime/opal.h"
+#include "opal/sys/atomic.h"
+
+#define OPAL_TEST_THREAD_COUNT 16
+#define ITERATIONS             1000000
+#define REG_COUNT              256
+#define REG_PAGES              64
+#define TEST_PAGE_SIZE         4096
+#define INDEX_MAX_PAGES        1024
+
+static mca_rcache_base_vma_module_t *vma_module;
+static mca_rcache_base_registration_t regs[REG_COUNT];
+static opal_atomic_int32_t failures = 0;
+static pthread_barrier_t barrier;
+
+static unsigned char *reg_base(int i)
+{
+    /* leave a gap after every registration so lookups must find the right one */
+    return (unsigned char *) (uintptr_t) (0x10000000
+                                          + (uintptr_t) i * 2 * REG_PAGES * TEST_PAGE_SIZE);
+}
+
+static void *thread_test(void *arg)
+{
+    unsigned int seed = (unsigned int) (uintptr_t) arg;
+
+    pthread_barrier_wait(&barrier);
+
+    for (int i = 0; i < ITERATIONS; ++i) {
+        int idx = rand_r(&seed) % REG_COUNT;
+        size_t offset = (size_t) (rand_r(&seed) % (REG_PAGES * TEST_PAGE_SIZE / 2));
+        size_t size = 1 + (size_t) (rand_r(&seed) % (REG_PAGES * TEST_PAGE_SIZE / 2));
+        mca_rcache_base_registration_t *reg = NULL;
+
+        (void) mca_rcache_base_vma_find(vma_module, reg_base(idx) + offset, size, &reg);
+        if (reg != regs + idx) {
+            opal_atomic_fetch_add_32(&failures, 1);
+        }
+    }
+
+    pthread_barrier_wait(&barrier);
+
+    return NULL;
+}
+
+static double run_test(int thread_count, bool use_index)
+{
+    pthread_t *ts = malloc(thread_count * sizeof(pthread_t));
+    struct timeval start, stop;
+
+    vma_module = mca_rcache_base_vma_module_alloc();
+    if (use_index) {
+        mca_rcache_base_vma_enable_index(vma_module, INDEX_MAX_PAGES);
+    }
+
+    for (int i = 0; i < REG_COUNT; ++i) {
+        OBJ_CONSTRUCT(regs + i, mca_rcache_base_registration_t);
+        regs[i].base = reg_base(i);
+        regs[i].bound = regs[i].base + REG_PAGES * TEST_PAGE_SIZE - 1;
+        mca_rcache_base_vma_insert(vma_module, regs + i, 0);
+    }
+
+    pthread_barrier_init(&barrier, NULL, thread_count + 1);
+
+    for (int i = 0; i < thread_count; i++) {
+        pthread_create(&ts[i], NULL, &thread_test, (void *) (uintptr_t) (i + 1));
+    }
+
+    pthread_barrier_wait(&barrier);
+    gettimeofday(&start, NULL);
+    pthread_barrier_wait(&barrier);
+    gettimeofday(&stop, NULL);
+
+    for (int i = 0; i < thread_count; i++) {
+        pthread_join(ts[i], NULL);
+    }
+
+    pthread_barrier_destroy(&barrier);
+
+    for (int i = 0; i < REG_COUNT; ++i) {
+        mca_rcache_base_vma_delete(vma_module, regs + i);
+        OBJ_DESTRUCT(regs + i);
+    }
+
+    OBJ_RELEASE(vma_module);
+    free(ts);
+
+    return ((double) (stop.tv_sec - start.tv_sec) + (double) (stop.tv_usec - start.tv_usec) * 1e-6)
+           / (double) ITERATIONS;
+}
+
+int main(int argc, char *argv[])
+{
+    int thread_count = OPAL_TEST_THREAD_COUNT;
+    double tree_time, index_time;
+
+    if (argc > 1) {
+        thread_count = atoi(argv[1]);
+        if (thread_count < 1) {
+            thread_count = 1;
+        }
+    }
+
+    opal_init_util(&argc, &argv);
+
+    tree_time = run_test(thread_count, false);
+    index_time = run_test(thread_count, true);
+
+    printf("%d threads: tree lookup %d nsec/per, page index lookup %d nsec/per\n", thread_count,
+           (int) (tree_time / 1e-9), (int) (index_time / 1e-9));
+
+    if (failures) {
+        fprintf(stderr, "%d lookups returned the wrong registration\n", (int) failures);
+    }
+
+    opal_finalize_util();
+
+    return failures ? 1 : 0;
+}